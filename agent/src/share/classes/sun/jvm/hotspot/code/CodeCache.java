@@ -32,11 +32,12 @@ import sun.jvm.hotspot.types.*;
 import sun.jvm.hotspot.utilities.*;
 
 public class CodeCache {
-  private static AddressField       heapField;
+  private static Address            heapsAddress;
+  private static CIntegerField      numberOfHeapsField;
   private static AddressField       scavengeRootNMethodsField;
   private static VirtualConstructor virtualConstructor;
 
-  private CodeHeap heap;
+  private CodeHeap[] heaps;
 
   static {
     VM.registerVMInitializedObserver(new Observer() {
@@ -49,7 +50,8 @@ public class CodeCache {
   private static synchronized void initialize(TypeDataBase db) {
     Type type = db.lookupType("CodeCache");
 
-    heapField = type.getAddressField("_heap");
+    heapsAddress = type.getAddressField("_heaps[0]").getStaticFieldAddress();
+    numberOfHeapsField = type.getCIntegerField("_number_of_heaps");
     scavengeRootNMethodsField = type.getAddressField("_scavenge_root_nmethods");
 
     virtualConstructor = new VirtualConstructor(db);
@@ -68,7 +70,12 @@ public class CodeCache {
   }
 
   public CodeCache() {
-    heap = (CodeHeap) VMObjectFactory.newObject(CodeHeap.class, heapField.getValue());
+    int numberOfHeaps = (int) numberOfHeapsField.getValue();
+    heaps = new CodeHeap[numberOfHeaps];
+    for (int i = 0; i < numberOfHeaps; i++) {
+      Address heapAddr = heapsAddress.getAddressAt(i * VM.getVM().getAddressSize());
+      heaps[i] = (CodeHeap) VMObjectFactory.newObject(CodeHeap.class, heapAddr);
+    }
   }
 
   public NMethod scavengeRootMethods() {
@@ -76,7 +83,7 @@ public class CodeCache {
   }
 
   public boolean contains(Address p) {
-    return getHeap().contains(p);
+    return getHeap(p) != null;
   }
 
   /** When VM.getVM().isDebugging() returns true, this behaves like
@@ -97,14 +104,16 @@ public class CodeCache {
 
   public CodeBlob findBlobUnsafe(Address start) {
     CodeBlob result = null;
+    CodeHeap heap = getHeap(start);
+    if (heap == null) return null;
 
     try {
-      result = (CodeBlob) virtualConstructor.instantiateWrapperFor(getHeap().findStart(start));
+      result = (CodeBlob) virtualConstructor.instantiateWrapperFor(heap.findStart(start));
     }
     catch (WrongTypeException wte) {
       Address cbAddr = null;
       try {
-        cbAddr = getHeap().findStart(start);
+        cbAddr = heap.findStart(start);
       }
       catch (Exception findEx) {
         findEx.printStackTrace();
@@ -167,31 +176,33 @@ public class CodeCache {
   }
 
   public void iterate(CodeCacheVisitor visitor) {
-    CodeHeap heap = getHeap();
-    Address ptr = heap.begin();
-    Address end = heap.end();
-
-    visitor.prologue(ptr, end);
+    // The heaps are laid out in order of increasing addresses
+    visitor.prologue(heaps[0].begin(), heaps[heaps.length - 1].end());
     CodeBlob lastBlob = null;
-    while (ptr != null && ptr.lessThan(end)) {
-      try {
-        // Use findStart to get a pointer inside blob other findBlob asserts
-        CodeBlob blob = findBlobUnsafe(heap.findStart(ptr));
-        if (blob != null) {
-          visitor.visit(blob);
-          if (blob == lastBlob) {
-            throw new InternalError("saw same blob twice");
+    for (int i = 0; i < heaps.length; i++) {
+      CodeHeap heap = heaps[i];
+      Address ptr = heap.begin();
+      Address end = heap.end();
+      while (ptr != null && ptr.lessThan(end)) {
+        try {
+          // Use findStart to get a pointer inside blob other findBlob asserts
+          CodeBlob blob = findBlobUnsafe(heap.findStart(ptr));
+          if (blob != null) {
+            visitor.visit(blob);
+            if (blob == lastBlob) {
+              throw new InternalError("saw same blob twice");
+            }
+            lastBlob = blob;
           }
-          lastBlob = blob;
+        } catch (RuntimeException e) {
+          e.printStackTrace();
         }
-      } catch (RuntimeException e) {
-        e.printStackTrace();
-      }
-      Address next = heap.nextBlock(ptr);
-      if (next != null && next.lessThan(ptr)) {
-        throw new InternalError("pointer moved backwards");
+        Address next = heap.nextBlock(ptr);
+        if (next != null && next.lessThan(ptr)) {
+          throw new InternalError("pointer moved backwards");
+        }
+        ptr = next;
       }
-      ptr = next;
     }
     visitor.epilogue();
   }
@@ -200,7 +211,12 @@ public class CodeCache {
   // Internals only below this point
   //
 
-  private CodeHeap getHeap() {
-    return heap;
+  private CodeHeap getHeap(Address p) {
+    for (int i = 0; i < heaps.length; i++) {
+      if (heaps[i].contains(p)) {
+        return heaps[i];
+      }
+    }
+    return null;
   }
 }
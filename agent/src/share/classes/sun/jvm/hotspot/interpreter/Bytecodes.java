@@ -267,16 +267,17 @@ public class Bytecodes {
   public static final int _fast_iload           = 224;
   public static final int _fast_iload2          = 225;
   public static final int _fast_icaload         = 226;
-  public static final int _fast_invokevfinal    = 227;
-  public static final int _fast_linearswitch    = 228;
-  public static final int _fast_binaryswitch    = 229;
-  public static final int _fast_aldc            = 230;
-  public static final int _fast_aldc_w          = 231;
-  public static final int _return_register_finalizer = 232;
-  public static final int _invokehandle         = 233;
-  public static final int _shouldnotreachhere   = 234; // For debugging
-
-  public static final int number_of_codes       = 235;
+  public static final int _fast_iload2_iadd     = 227;
+  public static final int _fast_invokevfinal    = 228;
+  public static final int _fast_linearswitch    = 229;
+  public static final int _fast_binaryswitch    = 230;
+  public static final int _fast_aldc            = 231;
+  public static final int _fast_aldc_w          = 232;
+  public static final int _return_register_finalizer = 233;
+  public static final int _invokehandle         = 234;
+  public static final int _shouldnotreachhere   = 235; // For debugging
+
+  public static final int number_of_codes       = 236;
 
   // Flag bits derived from format strings, can_trap, can_rewrite, etc.:
   // semantic flags:
@@ -793,6 +794,7 @@ public class Bytecodes {
     def(_fast_iload          , "fast_iload"          , "bi"   , null    , BasicType.getTInt()    ,  1, false, _iload          );
     def(_fast_iload2         , "fast_iload2"         , "bi_i" , null    , BasicType.getTInt()    ,  2, false, _iload          );
     def(_fast_icaload        , "fast_icaload"        , "bi_"  , null    , BasicType.getTInt()    ,  0, false, _iload          );
+    def(_fast_iload2_iadd    , "fast_iload2_iadd"    , "bi_i_", null    , BasicType.getTInt()    ,  1, false, _iload          );
 
     // Faster method invocation.
     def(_fast_invokevfinal   , "fast_invokevfinal"   , "bJJ"  , null    , BasicType.getTIllegal(), -1, true, _invokevirtual   );
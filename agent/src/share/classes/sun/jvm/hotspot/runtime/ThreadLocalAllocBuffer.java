@@ -40,6 +40,7 @@ public class ThreadLocalAllocBuffer extends VMObject {
   private static AddressField  startField;
   private static AddressField  topField;
   private static AddressField  endField;
+  private static AddressField  allocationEndField;
   private static CIntegerField desired_sizeField;
 
   static {
@@ -56,6 +57,7 @@ public class ThreadLocalAllocBuffer extends VMObject {
     startField         = type.getAddressField("_start");
     topField           = type.getAddressField("_top");
     endField           = type.getAddressField("_end");
+    allocationEndField = type.getAddressField("_allocation_end");
     desired_sizeField          = type.getCIntegerField("_desired_size");
   }
 
@@ -66,7 +68,10 @@ public class ThreadLocalAllocBuffer extends VMObject {
   public Address start()    { return startField.getValue(addr); }
   public Address end()      { return   endField.getValue(addr); }
   public Address top()      { return   topField.getValue(addr); }
-  public Address hardEnd()  { return end().addOffsetTo(alignmentReserve()); }
+  // The end may have been lowered for heap sampling; the space up to
+  // the allocation end belongs to the TLAB all the same.
+  public Address allocationEnd() { return allocationEndField.getValue(addr); }
+  public Address hardEnd()  { return allocationEnd().addOffsetTo(alignmentReserve()); }
 
   private long alignmentReserve() {
     return Oop.alignObjectSize(endReserve());
@@ -471,6 +471,8 @@ class Assembler : public AbstractAssembler {
     // Vector-Scalar (VSX) instruction support.
     MTVSRD_OPCODE  = (31u << OPCODE_SHIFT |  179u << 1),
     MFVSRD_OPCODE  = (31u << OPCODE_SHIFT |   51u << 1),
+    LXVD2X_OPCODE  = (31u << OPCODE_SHIFT |  844u << 1),
+    STXVD2X_OPCODE = (31u << OPCODE_SHIFT |  972u << 1),
 
     // Vector Permute and Formatting
     VPKPX_OPCODE   = (4u  << OPCODE_SHIFT |  782u     ),
@@ -1944,6 +1946,8 @@ class Assembler : public AbstractAssembler {
 
   // Vector-Scalar (VSX) instructions.
   inline void mtvrd(    VectorRegister  d, Register a);
+  inline void lxvd2x(   VectorRegister  d, Register s1, Register s2);
+  inline void stxvd2x(  VectorRegister  d, Register s1, Register s2);
   inline void mfvrd(    Register        a, VectorRegister d);
 
   // AES (introduced with Power 8)
@@ -2046,6 +2050,8 @@ class Assembler : public AbstractAssembler {
   inline void stvxl( VectorRegister d, Register s2);
   inline void lvsl(  VectorRegister d, Register s2);
   inline void lvsr(  VectorRegister d, Register s2);
+  inline void lxvd2x( VectorRegister d, Register s2);
+  inline void stxvd2x(VectorRegister d, Register s2);
 
   // RegisterOrConstant versions.
   // These emitters choose between the versions using two registers and
@@ -625,6 +625,8 @@ inline void Assembler::lvsr(  VectorRegister d, Register s1, Register s2) { emit
 
 // Vector-Scalar (VSX) instructions.
 inline void Assembler::mtvrd(  VectorRegister  d, Register a)               { emit_int32( MTVSRD_OPCODE  | vrt(d)  | ra(a)  | 1u); } // 1u: d is treated as Vector (VMX/Altivec).
+inline void Assembler::lxvd2x( VectorRegister  d, Register s1, Register s2) { emit_int32( LXVD2X_OPCODE  | vrt(d)  | ra0mem(s1) | rb(s2) | 1u); } // 1u: d is treated as Vector (VMX/Altivec).
+inline void Assembler::stxvd2x(VectorRegister  d, Register s1, Register s2) { emit_int32( STXVD2X_OPCODE | vrt(d)  | ra0mem(s1) | rb(s2) | 1u); } // 1u: d is treated as Vector (VMX/Altivec).
 inline void Assembler::mfvrd(  Register        a, VectorRegister d)         { emit_int32( MFVSRD_OPCODE  | vrt(d)  | ra(a)  | 1u); } // 1u: d is treated as Vector (VMX/Altivec).
 
 inline void Assembler::vpkpx(   VectorRegister d, VectorRegister a, VectorRegister b) { emit_int32( VPKPX_OPCODE   | vrt(d) | vra(a) | vrb(b)); }
@@ -863,6 +865,8 @@ inline void Assembler::stvx(  VectorRegister d, Register s2) { emit_int32( STVX_
 inline void Assembler::stvxl( VectorRegister d, Register s2) { emit_int32( STVXL_OPCODE  | vrt(d) | rb(s2)); }
 inline void Assembler::lvsl(  VectorRegister d, Register s2) { emit_int32( LVSL_OPCODE   | vrt(d) | rb(s2)); }
 inline void Assembler::lvsr(  VectorRegister d, Register s2) { emit_int32( LVSR_OPCODE   | vrt(d) | rb(s2)); }
+inline void Assembler::lxvd2x( VectorRegister d, Register s2) { emit_int32( LXVD2X_OPCODE  | vrt(d) | rb(s2) | 1u); }
+inline void Assembler::stxvd2x(VectorRegister d, Register s2) { emit_int32( STXVD2X_OPCODE | vrt(d) | rb(s2) | 1u); }
 
 inline void Assembler::load_const(Register d, void* x, Register tmp) {
    load_const(d, (long)x, tmp);
@@ -1514,6 +1514,34 @@ class StubGenerator: public StubCodeGenerator {
     return start;
   }
 
+  // Copy 32 bytes per iteration with VSX loads and stores, CTR holds the
+  // number of iterations. If "backward" is true, from and to point just
+  // past the chunk to copy and are decremented first, otherwise they are
+  // incremented after each chunk. VR0/VR1 are volatile and do not alias
+  // the floating point registers.
+  //
+  // Kills: tmp, VR0, VR1
+  //
+  void generate_vsx_copy_loop(Register tmp, bool backward) {
+    Label l_loop;
+    __ li(tmp, 16);
+    __ align(32);
+    __ bind(l_loop);
+    if (backward) {
+      __ addi(R3_ARG1, R3_ARG1, -32);
+      __ addi(R4_ARG2, R4_ARG2, -32);
+    }
+    __ lxvd2x(VR0, R3_ARG1);
+    __ lxvd2x(VR1, tmp, R3_ARG1);
+    __ stxvd2x(VR0, R4_ARG2);
+    __ stxvd2x(VR1, tmp, R4_ARG2);
+    if (!backward) {
+      __ addi(R3_ARG1, R3_ARG1, 32);
+      __ addi(R4_ARG2, R4_ARG2, 32);
+    }
+    __ bdnz(l_loop);
+  }
+
   // Generate core code for disjoint int copy (and oop copy on 32-bit).  If "aligned"
   // is true, the "from" and "to" addresses are assumed to be heapword aligned.
   //
@@ -1563,21 +1591,25 @@ class StubGenerator: public StubCodeGenerator {
       __ andi_(R5_ARG3, R5_ARG3, 7);
       __ mtctr(tmp1);
 
-      __ bind(l_6);
-      // Use unrolled version for mass copying (copy 8 elements a time).
-      // Load feeding store gets zero latency on power6, however not on power 5.
-      // Therefore, the following sequence is made for the good of both.
-      __ ld(tmp1, 0, R3_ARG1);
-      __ ld(tmp2, 8, R3_ARG1);
-      __ ld(tmp3, 16, R3_ARG1);
-      __ ld(tmp4, 24, R3_ARG1);
-      __ std(tmp1, 0, R4_ARG2);
-      __ std(tmp2, 8, R4_ARG2);
-      __ std(tmp3, 16, R4_ARG2);
-      __ std(tmp4, 24, R4_ARG2);
-      __ addi(R3_ARG1, R3_ARG1, 32);
-      __ addi(R4_ARG2, R4_ARG2, 32);
-      __ bdnz(l_6);
+      if (VM_Version::has_vsx()) {
+        generate_vsx_copy_loop(tmp1, false);
+      } else {
+        __ bind(l_6);
+        // Use unrolled version for mass copying (copy 8 elements a time).
+        // Load feeding store gets zero latency on power6, however not on power 5.
+        // Therefore, the following sequence is made for the good of both.
+        __ ld(tmp1, 0, R3_ARG1);
+        __ ld(tmp2, 8, R3_ARG1);
+        __ ld(tmp3, 16, R3_ARG1);
+        __ ld(tmp4, 24, R3_ARG1);
+        __ std(tmp1, 0, R4_ARG2);
+        __ std(tmp2, 8, R4_ARG2);
+        __ std(tmp3, 16, R4_ARG2);
+        __ std(tmp4, 24, R4_ARG2);
+        __ addi(R3_ARG1, R3_ARG1, 32);
+        __ addi(R4_ARG2, R4_ARG2, 32);
+        __ bdnz(l_6);
+      }
     }
 
     // copy 1 element at a time
@@ -1652,21 +1684,25 @@ class StubGenerator: public StubCodeGenerator {
       __ andi(R5_ARG3, R5_ARG3, 7);
       __ mtctr(tmp1);
 
-      __ bind(l_4);
-      // Use unrolled version for mass copying (copy 4 elements a time).
-      // Load feeding store gets zero latency on Power6, however not on Power5.
-      // Therefore, the following sequence is made for the good of both.
-      __ addi(R3_ARG1, R3_ARG1, -32);
-      __ addi(R4_ARG2, R4_ARG2, -32);
-      __ ld(tmp4, 24, R3_ARG1);
-      __ ld(tmp3, 16, R3_ARG1);
-      __ ld(tmp2, 8, R3_ARG1);
-      __ ld(tmp1, 0, R3_ARG1);
-      __ std(tmp4, 24, R4_ARG2);
-      __ std(tmp3, 16, R4_ARG2);
-      __ std(tmp2, 8, R4_ARG2);
-      __ std(tmp1, 0, R4_ARG2);
-      __ bdnz(l_4);
+      if (VM_Version::has_vsx()) {
+        generate_vsx_copy_loop(tmp1, true);
+      } else {
+        __ bind(l_4);
+        // Use unrolled version for mass copying (copy 4 elements a time).
+        // Load feeding store gets zero latency on Power6, however not on Power5.
+        // Therefore, the following sequence is made for the good of both.
+        __ addi(R3_ARG1, R3_ARG1, -32);
+        __ addi(R4_ARG2, R4_ARG2, -32);
+        __ ld(tmp4, 24, R3_ARG1);
+        __ ld(tmp3, 16, R3_ARG1);
+        __ ld(tmp2, 8, R3_ARG1);
+        __ ld(tmp1, 0, R3_ARG1);
+        __ std(tmp4, 24, R4_ARG2);
+        __ std(tmp3, 16, R4_ARG2);
+        __ std(tmp2, 8, R4_ARG2);
+        __ std(tmp1, 0, R4_ARG2);
+        __ bdnz(l_4);
+      }
 
       __ cmpwi(CCR0, R5_ARG3, 0);
       __ beq(CCR0, l_6);
@@ -1740,21 +1776,25 @@ class StubGenerator: public StubCodeGenerator {
       __ andi_(R5_ARG3, R5_ARG3, 3);
       __ mtctr(tmp1);
 
-      __ bind(l_4);
-      // Use unrolled version for mass copying (copy 4 elements a time).
-      // Load feeding store gets zero latency on Power6, however not on Power5.
-      // Therefore, the following sequence is made for the good of both.
-      __ ld(tmp1, 0, R3_ARG1);
-      __ ld(tmp2, 8, R3_ARG1);
-      __ ld(tmp3, 16, R3_ARG1);
-      __ ld(tmp4, 24, R3_ARG1);
-      __ std(tmp1, 0, R4_ARG2);
-      __ std(tmp2, 8, R4_ARG2);
-      __ std(tmp3, 16, R4_ARG2);
-      __ std(tmp4, 24, R4_ARG2);
-      __ addi(R3_ARG1, R3_ARG1, 32);
-      __ addi(R4_ARG2, R4_ARG2, 32);
-      __ bdnz(l_4);
+      if (VM_Version::has_vsx()) {
+        generate_vsx_copy_loop(tmp1, false);
+      } else {
+        __ bind(l_4);
+        // Use unrolled version for mass copying (copy 4 elements a time).
+        // Load feeding store gets zero latency on Power6, however not on Power5.
+        // Therefore, the following sequence is made for the good of both.
+        __ ld(tmp1, 0, R3_ARG1);
+        __ ld(tmp2, 8, R3_ARG1);
+        __ ld(tmp3, 16, R3_ARG1);
+        __ ld(tmp4, 24, R3_ARG1);
+        __ std(tmp1, 0, R4_ARG2);
+        __ std(tmp2, 8, R4_ARG2);
+        __ std(tmp3, 16, R4_ARG2);
+        __ std(tmp4, 24, R4_ARG2);
+        __ addi(R3_ARG1, R3_ARG1, 32);
+        __ addi(R4_ARG2, R4_ARG2, 32);
+        __ bdnz(l_4);
+      }
     }
 
     // copy 1 element at a time
@@ -1826,21 +1866,25 @@ class StubGenerator: public StubCodeGenerator {
       __ andi(R5_ARG3, R5_ARG3, 3);
       __ mtctr(tmp1);
 
-      __ bind(l_4);
-      // Use unrolled version for mass copying (copy 4 elements a time).
-      // Load feeding store gets zero latency on Power6, however not on Power5.
-      // Therefore, the following sequence is made for the good of both.
-      __ addi(R3_ARG1, R3_ARG1, -32);
-      __ addi(R4_ARG2, R4_ARG2, -32);
-      __ ld(tmp4, 24, R3_ARG1);
-      __ ld(tmp3, 16, R3_ARG1);
-      __ ld(tmp2, 8, R3_ARG1);
-      __ ld(tmp1, 0, R3_ARG1);
-      __ std(tmp4, 24, R4_ARG2);
-      __ std(tmp3, 16, R4_ARG2);
-      __ std(tmp2, 8, R4_ARG2);
-      __ std(tmp1, 0, R4_ARG2);
-      __ bdnz(l_4);
+      if (VM_Version::has_vsx()) {
+        generate_vsx_copy_loop(tmp1, true);
+      } else {
+        __ bind(l_4);
+        // Use unrolled version for mass copying (copy 4 elements a time).
+        // Load feeding store gets zero latency on Power6, however not on Power5.
+        // Therefore, the following sequence is made for the good of both.
+        __ addi(R3_ARG1, R3_ARG1, -32);
+        __ addi(R4_ARG2, R4_ARG2, -32);
+        __ ld(tmp4, 24, R3_ARG1);
+        __ ld(tmp3, 16, R3_ARG1);
+        __ ld(tmp2, 8, R3_ARG1);
+        __ ld(tmp1, 0, R3_ARG1);
+        __ std(tmp4, 24, R4_ARG2);
+        __ std(tmp3, 16, R4_ARG2);
+        __ std(tmp2, 8, R4_ARG2);
+        __ std(tmp1, 0, R4_ARG2);
+        __ bdnz(l_4);
+      }
 
       __ cmpwi(CCR0, R5_ARG3, 0);
       __ beq(CCR0, l_1);
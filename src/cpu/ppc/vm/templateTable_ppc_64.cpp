@@ -446,9 +446,10 @@ void TemplateTable::iload() {
   locals_index(Rindex);
 
   // Rewrite iload,iload  pair into fast_iload2
+  //         iload,iload,iadd into fast_iload2_iadd
   //         iload,caload pair into fast_icaload
   if (RewriteFrequentPairs) {
-    Label Lrewrite, Ldone;
+    Label Lrewrite, Lpair, Ldone;
     Register Rnext_byte  = R3_ARG1,
              Rrewrite_to = R6_ARG4,
              Rscratch    = R11_scratch1;
@@ -465,13 +466,21 @@ void TemplateTable::iload() {
 
     __ cmpwi(CCR1, Rnext_byte, (unsigned int)(unsigned char)Bytecodes::_fast_iload);
     __ li(Rrewrite_to, (unsigned int)(unsigned char)Bytecodes::_fast_iload2);
-    __ beq(CCR1, Lrewrite);
+    __ beq(CCR1, Lpair);
 
     __ cmpwi(CCR0, Rnext_byte, (unsigned int)(unsigned char)Bytecodes::_caload);
     __ li(Rrewrite_to, (unsigned int)(unsigned char)Bytecodes::_fast_icaload);
     __ beq(CCR0, Lrewrite);
 
     __ li(Rrewrite_to, (unsigned int)(unsigned char)Bytecodes::_fast_iload);
+    __ b(Lrewrite);
+
+    // if the pair is followed by _iadd, rewrite to fast_iload2_iadd
+    __ bind(Lpair);
+    __ lbz(Rnext_byte, 2 * Bytecodes::length_for(Bytecodes::_iload), R14_bcp);
+    __ cmpwi(CCR0, Rnext_byte, (unsigned int)(unsigned char)Bytecodes::_iadd);
+    __ bne(CCR0, Lrewrite);
+    __ li(Rrewrite_to, (unsigned int)(unsigned char)Bytecodes::_fast_iload2_iadd);
 
     __ bind(Lrewrite);
     patch_bytecode(Bytecodes::_iload, Rrewrite_to, Rscratch, false);
@@ -493,6 +502,18 @@ void TemplateTable::fast_iload2() {
   __ push_i(R3_ARG1);
 }
 
+// Load 2 integers and add them without dispatching
+void TemplateTable::fast_iload2_iadd() {
+  transition(vtos, itos);
+
+  __ lbz(R3_ARG1, 1, R14_bcp);
+  __ lbz(R17_tos, Bytecodes::length_for(Bytecodes::_iload) + 1, R14_bcp);
+
+  __ load_local_int(R3_ARG1, R11_scratch1, R3_ARG1);
+  __ load_local_int(R17_tos, R12_scratch2, R17_tos);
+  __ add(R17_tos, R3_ARG1, R17_tos);
+}
+
 void TemplateTable::fast_iload() {
   transition(vtos, itos);
   // Get the local value into tos
@@ -3599,7 +3620,10 @@ void TemplateTable::_new() {
                  Rtags            = R3_ARG1,
                  Rindex           = R5_ARG3;
 
-  const bool allow_shared_alloc = Universe::heap()->supports_inline_contig_alloc() && !CMSIncrementalMode;
+  // With heap sampling the end of the TLAB may have been lowered; the
+  // allocation crossing it must reach the runtime rather than eden.
+  const bool allow_shared_alloc = Universe::heap()->supports_inline_contig_alloc() && !CMSIncrementalMode &&
+                                  !ThreadHeapSampler::enabled();
 
   // --------------------------------------------------------------------------
   // Check if fast case is possible.
@@ -44,6 +44,7 @@ protected:
     dcba,
     vcipher,
     vpmsumb,
+    vsx,
     num_features // last entry to count features
   };
   enum Feature_Flag_Set {
@@ -60,6 +61,7 @@ protected:
     dcba_m                = (1 << dcba   ),
     vcipher_m             = (1 << vcipher),
     vpmsumb_m             = (1 << vpmsumb),
+    vsx_m                 = (1 << vsx),
     all_features_m        = -1
   };
   static int  _features;
@@ -89,6 +91,7 @@ public:
   static bool has_dcba()    { return (_features & dcba_m) != 0; }
   static bool has_vcipher() { return (_features & vcipher_m) != 0; }
   static bool has_vpmsumb() { return (_features & vpmsumb_m) != 0; }
+  static bool has_vsx()     { return (_features & vsx_m) != 0; }
 
   static const char* cpu_features() { return _features_str; }
 
@@ -446,9 +446,10 @@ void TemplateTable::locals_index_wide(Register reg) {
 void TemplateTable::iload() {
   transition(vtos, itos);
   // Rewrite iload,iload  pair into fast_iload2
+  //         iload,iload,iadd into fast_iload2_iadd
   //         iload,caload pair into fast_icaload
   if (RewriteFrequentPairs) {
-    Label rewrite, done;
+    Label rewrite, pair, done;
 
     // get next byte
     __ ldub(at_bcp(Bytecodes::length_for(Bytecodes::_iload)), G3_scratch);
@@ -460,7 +461,7 @@ void TemplateTable::iload() {
     __ cmp_and_br_short(G3_scratch, (int)Bytecodes::_iload, Assembler::equal, Assembler::pn, done);
 
     __ cmp(G3_scratch, (int)Bytecodes::_fast_iload);
-    __ br(Assembler::equal, false, Assembler::pn, rewrite);
+    __ br(Assembler::equal, false, Assembler::pn, pair);
     __ delayed()->set(Bytecodes::_fast_iload2, G4_scratch);
 
     __ cmp(G3_scratch, (int)Bytecodes::_caload);
@@ -468,6 +469,14 @@ void TemplateTable::iload() {
     __ delayed()->set(Bytecodes::_fast_icaload, G4_scratch);
 
     __ set(Bytecodes::_fast_iload, G4_scratch);  // don't check again
+    __ ba_short(rewrite);
+
+    // if the pair is followed by _iadd, rewrite to fast_iload2_iadd
+    __ bind(pair);
+    __ ldub(at_bcp(2 * Bytecodes::length_for(Bytecodes::_iload)), G3_scratch);
+    __ cmp_and_br_short(G3_scratch, (int)Bytecodes::_iadd, Assembler::notEqual, Assembler::pt, rewrite);
+    __ set(Bytecodes::_fast_iload2_iadd, G4_scratch);
+
     // rewrite
     // G4_scratch: fast bytecode
     __ bind(rewrite);
@@ -489,6 +498,15 @@ void TemplateTable::fast_iload2() {
   __ access_local_int( G3_scratch, Otos_i );
 }
 
+void TemplateTable::fast_iload2_iadd() {
+  transition(vtos, itos);
+  locals_index(G3_scratch);
+  __ access_local_int( G3_scratch, O1 );
+  locals_index(G3_scratch, 3);  // get next bytecode's local index.
+  __ access_local_int( G3_scratch, Otos_i );
+  __ add(O1, Otos_i, Otos_i);
+}
+
 void TemplateTable::fast_iload() {
   transition(vtos, itos);
   locals_index(G3_scratch);
@@ -3367,8 +3385,11 @@ void TemplateTable::_new() {
   // 3) if the above fails (or is not applicable), go to a slow case
   // (creates a new TLAB, etc.)
 
+  // With heap sampling the end of the TLAB may have been lowered; the
+  // allocation crossing it must reach the runtime rather than eden.
   const bool allow_shared_alloc =
-    Universe::heap()->supports_inline_contig_alloc() && !CMSIncrementalMode;
+    Universe::heap()->supports_inline_contig_alloc() && !CMSIncrementalMode &&
+    !ThreadHeapSampler::enabled();
 
   if(UseTLAB) {
     Register RoldTopValue = RallocatedObject;
@@ -285,6 +285,14 @@ void Assembler::emit_operand(Register reg, Register base, Register index,
   int indexenc = index->is_valid() ? encode(index) << 3 : 0;
   int baseenc = base->is_valid() ? encode(base) : 0;
 
+  // EVEX instructions scale an 8-bit displacement by the operand size
+  bool disp_is8bit = is8bit(disp);
+  int  disp8 = disp;
+  if (_evex_disp8_scale > 0) {
+    disp_is8bit = (disp % _evex_disp8_scale) == 0 && is8bit(disp / _evex_disp8_scale);
+    disp8 = disp / _evex_disp8_scale;
+  }
+
   if (base->is_valid()) {
     if (index->is_valid()) {
       assert(scale != Address::no_scale, "inconsistent address");
@@ -296,13 +304,13 @@ void Assembler::emit_operand(Register reg, Register base, Register index,
         assert(index != rsp, "illegal addressing mode");
         emit_int8(0x04 | regenc);
         emit_int8(scale << 6 | indexenc | baseenc);
-      } else if (is8bit(disp) && rtype == relocInfo::none) {
+      } else if (disp_is8bit && rtype == relocInfo::none) {
         // [base + index*scale + imm8]
         // [01 reg 100][ss index base] imm8
         assert(index != rsp, "illegal addressing mode");
         emit_int8(0x44 | regenc);
         emit_int8(scale << 6 | indexenc | baseenc);
-        emit_int8(disp & 0xFF);
+        emit_int8(disp8 & 0xFF);
       } else {
         // [base + index*scale + disp32]
         // [10 reg 100][ss index base] disp32
@@ -318,12 +326,12 @@ void Assembler::emit_operand(Register reg, Register base, Register index,
         // [00 reg 100][00 100 100]
         emit_int8(0x04 | regenc);
         emit_int8(0x24);
-      } else if (is8bit(disp) && rtype == relocInfo::none) {
+      } else if (disp_is8bit && rtype == relocInfo::none) {
         // [rsp + imm8]
         // [01 reg 100][00 100 100] disp8
         emit_int8(0x44 | regenc);
         emit_int8(0x24);
-        emit_int8(disp & 0xFF);
+        emit_int8(disp8 & 0xFF);
       } else {
         // [rsp + imm32]
         // [10 reg 100][00 100 100] disp32
@@ -339,11 +347,11 @@ void Assembler::emit_operand(Register reg, Register base, Register index,
         // [base]
         // [00 reg base]
         emit_int8(0x00 | regenc | baseenc);
-      } else if (is8bit(disp) && rtype == relocInfo::none) {
+      } else if (disp_is8bit && rtype == relocInfo::none) {
         // [base + disp8]
         // [01 reg base] disp8
         emit_int8(0x40 | regenc | baseenc);
-        emit_int8(disp & 0xFF);
+        emit_int8(disp8 & 0xFF);
       } else {
         // [base + disp32]
         // [10 reg base] disp32
@@ -860,6 +868,13 @@ void Assembler::emit_operand(XMMRegister reg, Address adr) {
                adr._rspec);
 }
 
+void Assembler::emit_evex_operand(XMMRegister reg, Address adr) {
+  assert(_evex_disp8_scale == 0, "not nested");
+  _evex_disp8_scale = 64;
+  emit_operand(reg, adr);
+  _evex_disp8_scale = 0;
+}
+
 // MMX operations
 void Assembler::emit_operand(MMXRegister reg, Address adr) {
   assert(!adr.base_needs_rex() && !adr.index_needs_rex(), "no extended registers");
@@ -1334,6 +1349,13 @@ void Assembler::cvtdq2ps(XMMRegister dst, XMMRegister src) {
   emit_simd_arith_nonds(0x5B, dst, src, VEX_SIMD_NONE);
 }
 
+void Assembler::vcvtdq2ps(XMMRegister dst, XMMRegister src, bool vector256) {
+  assert(VM_Version::supports_avx(), "");
+  int encode = vex_prefix_and_encode(dst, xnoreg, src, VEX_SIMD_NONE, vector256);
+  emit_int8(0x5B);
+  emit_int8((unsigned char)(0xC0 | encode));
+}
+
 void Assembler::cvtsd2ss(XMMRegister dst, XMMRegister src) {
   NOT_LP64(assert(VM_Version::supports_sse2(), ""));
   emit_simd_arith(0x5A, dst, src, VEX_SIMD_F2);
@@ -1793,6 +1815,36 @@ void Assembler::vmovdqu(Address dst, XMMRegister src) {
   emit_operand(src, dst);
 }
 
+void Assembler::vmovntdq(Address dst, XMMRegister src) {
+  assert(UseAVX > 0, "");
+  InstructionMark im(this);
+  bool vector256 = true;
+  // swap src<->dst for encoding
+  assert(src != xnoreg, "sanity");
+  vex_prefix(src, xnoreg, dst, VEX_SIMD_66, vector256);
+  emit_int8((unsigned char)0xE7);
+  emit_operand(src, dst);
+}
+
+// Move Unaligned 512bit Vector (vmovdqu32)
+void Assembler::evmovdqul(XMMRegister dst, Address src) {
+  assert(VM_Version::supports_evex(), "");
+  InstructionMark im(this);
+  evex_prefix(src, 0, dst->encoding(), VEX_SIMD_F3, VEX_OPCODE_0F, false);
+  emit_int8(0x6F);
+  emit_evex_operand(dst, src);
+}
+
+void Assembler::evmovdqul(Address dst, XMMRegister src) {
+  assert(VM_Version::supports_evex(), "");
+  InstructionMark im(this);
+  // swap src<->dst for encoding
+  assert(src != xnoreg, "sanity");
+  evex_prefix(dst, 0, src->encoding(), VEX_SIMD_F3, VEX_OPCODE_0F, false);
+  emit_int8(0x7F);
+  emit_evex_operand(src, dst);
+}
+
 // Uses zero extension on 64bit
 
 void Assembler::movl(Register dst, int32_t imm32) {
@@ -2349,6 +2401,22 @@ void Assembler::vpermq(XMMRegister dst, XMMRegister src, int imm8, bool vector25
   emit_int8(imm8);
 }
 
+void Assembler::palignr(XMMRegister dst, XMMRegister src, int imm8) {
+  assert(VM_Version::supports_ssse3(), "");
+  int encode = simd_prefix_and_encode(dst, dst, src, VEX_SIMD_66, VEX_OPCODE_0F_3A);
+  emit_int8(0x0F);
+  emit_int8((unsigned char)(0xC0 | encode));
+  emit_int8(imm8);
+}
+
+void Assembler::pblendw(XMMRegister dst, XMMRegister src, int imm8) {
+  assert(VM_Version::supports_sse4_1(), "");
+  int encode = simd_prefix_and_encode(dst, dst, src, VEX_SIMD_66, VEX_OPCODE_0F_3A);
+  emit_int8(0x0E);
+  emit_int8((unsigned char)(0xC0 | encode));
+  emit_int8(imm8);
+}
+
 void Assembler::pause() {
   emit_int8((unsigned char)0xF3);
   emit_int8((unsigned char)0x90);
@@ -2575,6 +2643,15 @@ void Assembler::psrldq(XMMRegister dst, int shift) {
   emit_int8(shift);
 }
 
+void Assembler::pslldq(XMMRegister dst, int shift) {
+  // Shift left 128 bit value in xmm register by number of bytes.
+  NOT_LP64(assert(VM_Version::supports_sse2(), ""));
+  int encode = simd_prefix_and_encode(xmm7, dst, dst, VEX_SIMD_66);
+  emit_int8(0x73);
+  emit_int8((unsigned char)(0xC0 | encode));
+  emit_int8(shift);
+}
+
 void Assembler::ptest(XMMRegister dst, Address src) {
   assert(VM_Version::supports_sse4_1(), "");
   assert((UseAVX > 0), "SSE mode requires address alignment 16 bytes");
@@ -2794,6 +2871,64 @@ void Assembler::setb(Condition cc, Register dst) {
   emit_int8((unsigned char)(0xC0 | encode));
 }
 
+void Assembler::sfence() {
+  NOT_LP64(assert(VM_Version::supports_sse(), "unsupported");)
+  emit_int8(0x0F);
+  emit_int8((unsigned char)0xAE);
+  emit_int8((unsigned char)0xF8);
+}
+
+// The SHA extensions have no VEX encoding, so always use the legacy form.
+void Assembler::sha1rnds4(XMMRegister dst, XMMRegister src, int imm8) {
+  assert(VM_Version::supports_sha(), "");
+  int encode = rex_prefix_and_encode(dst->encoding(), src->encoding(), VEX_SIMD_NONE, VEX_OPCODE_0F_3A, false);
+  emit_int8((unsigned char)0xCC);
+  emit_int8((unsigned char)(0xC0 | encode));
+  emit_int8((unsigned char)imm8);
+}
+
+void Assembler::sha1nexte(XMMRegister dst, XMMRegister src) {
+  assert(VM_Version::supports_sha(), "");
+  int encode = rex_prefix_and_encode(dst->encoding(), src->encoding(), VEX_SIMD_NONE, VEX_OPCODE_0F_38, false);
+  emit_int8((unsigned char)0xC8);
+  emit_int8((unsigned char)(0xC0 | encode));
+}
+
+void Assembler::sha1msg1(XMMRegister dst, XMMRegister src) {
+  assert(VM_Version::supports_sha(), "");
+  int encode = rex_prefix_and_encode(dst->encoding(), src->encoding(), VEX_SIMD_NONE, VEX_OPCODE_0F_38, false);
+  emit_int8((unsigned char)0xC9);
+  emit_int8((unsigned char)(0xC0 | encode));
+}
+
+void Assembler::sha1msg2(XMMRegister dst, XMMRegister src) {
+  assert(VM_Version::supports_sha(), "");
+  int encode = rex_prefix_and_encode(dst->encoding(), src->encoding(), VEX_SIMD_NONE, VEX_OPCODE_0F_38, false);
+  emit_int8((unsigned char)0xCA);
+  emit_int8((unsigned char)(0xC0 | encode));
+}
+
+void Assembler::sha256rnds2(XMMRegister dst, XMMRegister src) {
+  assert(VM_Version::supports_sha(), "");
+  int encode = rex_prefix_and_encode(dst->encoding(), src->encoding(), VEX_SIMD_NONE, VEX_OPCODE_0F_38, false);
+  emit_int8((unsigned char)0xCB);
+  emit_int8((unsigned char)(0xC0 | encode));
+}
+
+void Assembler::sha256msg1(XMMRegister dst, XMMRegister src) {
+  assert(VM_Version::supports_sha(), "");
+  int encode = rex_prefix_and_encode(dst->encoding(), src->encoding(), VEX_SIMD_NONE, VEX_OPCODE_0F_38, false);
+  emit_int8((unsigned char)0xCC);
+  emit_int8((unsigned char)(0xC0 | encode));
+}
+
+void Assembler::sha256msg2(XMMRegister dst, XMMRegister src) {
+  assert(VM_Version::supports_sha(), "");
+  int encode = rex_prefix_and_encode(dst->encoding(), src->encoding(), VEX_SIMD_NONE, VEX_OPCODE_0F_38, false);
+  emit_int8((unsigned char)0xCD);
+  emit_int8((unsigned char)(0xC0 | encode));
+}
+
 void Assembler::shll(Register dst, int imm8) {
   assert(isShiftCount(imm8), "illegal shift count");
   int encode = prefix_and_encode(dst->encoding());
@@ -3851,6 +3986,28 @@ void Assembler::vextracti128h(Address dst, XMMRegister src) {
   emit_int8(0x01);
 }
 
+void Assembler::vextractf128h(XMMRegister dst, XMMRegister src) {
+  assert(VM_Version::supports_avx(), "");
+  bool vector256 = true;
+  // swap src<->dst for encoding
+  int encode = vex_prefix_and_encode(src, xnoreg, dst, VEX_SIMD_66, vector256, VEX_OPCODE_0F_3A);
+  emit_int8(0x19);
+  emit_int8((unsigned char)(0xC0 | encode));
+  // 0x01 - extract from upper 128 bits
+  emit_int8(0x01);
+}
+
+void Assembler::vextracti128h(XMMRegister dst, XMMRegister src) {
+  assert(VM_Version::supports_avx2(), "");
+  bool vector256 = true;
+  // swap src<->dst for encoding
+  int encode = vex_prefix_and_encode(src, xnoreg, dst, VEX_SIMD_66, vector256, VEX_OPCODE_0F_3A);
+  emit_int8(0x39);
+  emit_int8((unsigned char)(0xC0 | encode));
+  // 0x01 - extract from upper 128 bits
+  emit_int8(0x01);
+}
+
 // duplicate 4-bytes integer data from src into 8 locations in dest
 void Assembler::vpbroadcastd(XMMRegister dst, XMMRegister src) {
   assert(VM_Version::supports_avx2(), "");
@@ -3860,6 +4017,36 @@ void Assembler::vpbroadcastd(XMMRegister dst, XMMRegister src) {
   emit_int8((unsigned char)(0xC0 | encode));
 }
 
+// sign extend 8 bytes at src into 8 dwords in dest
+void Assembler::vpmovsxbd(XMMRegister dst, Address src) {
+  assert(VM_Version::supports_avx2(), "");
+  InstructionMark im(this);
+  bool vector256 = true;
+  assert(dst != xnoreg, "sanity");
+  vex_prefix(src, 0, dst->encoding(), VEX_SIMD_66, VEX_OPCODE_0F_38, false, vector256);
+  emit_int8(0x21);
+  emit_operand(dst, src);
+}
+
+// zero extend 8 words at src into 8 dwords in dest
+void Assembler::vpmovzxwd(XMMRegister dst, Address src) {
+  assert(VM_Version::supports_avx2(), "");
+  InstructionMark im(this);
+  bool vector256 = true;
+  assert(dst != xnoreg, "sanity");
+  vex_prefix(src, 0, dst->encoding(), VEX_SIMD_66, VEX_OPCODE_0F_38, false, vector256);
+  emit_int8(0x33);
+  emit_operand(dst, src);
+}
+
+// duplicate 4-bytes integer data from src into 16 locations in dest
+void Assembler::evpbroadcastd(XMMRegister dst, XMMRegister src) {
+  assert(VM_Version::supports_evex(), "");
+  int encode = evex_prefix_and_encode(dst->encoding(), 0, src->encoding(), VEX_SIMD_66, VEX_OPCODE_0F_38, false);
+  emit_int8(0x58);
+  emit_int8((unsigned char)(0xC0 | encode));
+}
+
 // Carry-Less Multiplication Quadword
 void Assembler::pclmulqdq(XMMRegister dst, XMMRegister src, int mask) {
   assert(VM_Version::supports_clmul(), "");
@@ -4422,6 +4609,43 @@ void Assembler::vex_prefix(bool vex_r, bool vex_b, bool vex_x, bool vex_w, int n
   }
 }
 
+void Assembler::evex_prefix(bool vex_r, bool vex_b, bool vex_x, bool vex_w, int nds_enc, VexSimdPrefix pre, VexOpcode opc) {
+  assert(nds_enc < 16, "xmm16-xmm31 are not supported");
+  prefix(EVEX_4bytes);
+
+  // P0: [R X B R' 0 0 m m], R' is set to encode a register below 16
+  int byte1 = (vex_r ? VEX_R : 0) | (vex_x ? VEX_X : 0) | (vex_b ? VEX_B : 0);
+  byte1 = (~byte1) & 0xE0;
+  byte1 |= 0x10 | opc;
+  emit_int8(byte1);
+
+  // P1: [W v v v v 1 p p]
+  int byte2 = ((~nds_enc) & 0xf) << 3;
+  byte2 |= (vex_w ? VEX_W : 0) | 0x04 | pre;
+  emit_int8(byte2);
+
+  // P2: [z L' L b V' a a a], L'L = 10 selects 512bit vectors, V' is set
+  // for nds below 16, no zeroing, broadcast or opmask.
+  emit_int8(0x48);
+}
+
+void Assembler::evex_prefix(Address adr, int nds_enc, int xreg_enc, VexSimdPrefix pre, VexOpcode opc, bool vex_w) {
+  assert(xreg_enc < 16, "xmm16-xmm31 are not supported");
+  bool vex_r = (xreg_enc >= 8);
+  bool vex_b = adr.base_needs_rex();
+  bool vex_x = adr.index_needs_rex();
+  evex_prefix(vex_r, vex_b, vex_x, vex_w, nds_enc, pre, opc);
+}
+
+int Assembler::evex_prefix_and_encode(int dst_enc, int nds_enc, int src_enc, VexSimdPrefix pre, VexOpcode opc, bool vex_w) {
+  assert(dst_enc < 16 && src_enc < 16, "xmm16-xmm31 are not supported");
+  bool vex_r = (dst_enc >= 8);
+  bool vex_b = (src_enc >= 8);
+  bool vex_x = false;
+  evex_prefix(vex_r, vex_b, vex_x, vex_w, nds_enc, pre, opc);
+  return (((dst_enc & 7) << 3) | (src_enc & 7));
+}
+
 void Assembler::vex_prefix(Address adr, int nds_enc, int xreg_enc, VexSimdPrefix pre, VexOpcode opc, bool vex_w, bool vector256){
   bool vex_r = (xreg_enc >= 8);
   bool vex_b = adr.base_needs_rex();
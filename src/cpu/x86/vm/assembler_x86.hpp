@@ -502,7 +502,8 @@ class Assembler : public AbstractAssembler  {
     REX_WRXB   = 0x4F,
 
     VEX_3bytes = 0xC4,
-    VEX_2bytes = 0xC5
+    VEX_2bytes = 0xC5,
+    EVEX_4bytes = 0x62
   };
 
   enum VexPrefix {
@@ -609,6 +610,16 @@ private:
                              VexSimdPrefix pre, VexOpcode opc,
                              bool vex_w, bool vector256);
 
+  // EVEX prefix for unmasked 512bit operations on xmm0-xmm15
+  void evex_prefix(bool vex_r, bool vex_b, bool vex_x, bool vex_w,
+                   int nds_enc, VexSimdPrefix pre, VexOpcode opc);
+
+  void evex_prefix(Address adr, int nds_enc, int xreg_enc,
+                   VexSimdPrefix pre, VexOpcode opc, bool vex_w);
+
+  int  evex_prefix_and_encode(int dst_enc, int nds_enc, int src_enc,
+                              VexSimdPrefix pre, VexOpcode opc, bool vex_w);
+
   int  vex_prefix_0F38_and_encode(Register dst, Register nds, Register src) {
     bool vex_w = false;
     bool vector256 = false;
@@ -718,6 +729,10 @@ private:
 
   void emit_operand(XMMRegister reg, Address adr);
 
+  // EVEX memory operand: an 8-bit displacement is scaled by the 64 byte
+  // size of the operand.
+  void emit_evex_operand(XMMRegister reg, Address adr);
+
   void emit_operand(MMXRegister reg, Address adr);
 
   // workaround gcc (3.2.1-7) bug
@@ -821,10 +836,14 @@ private:
   // Instruction prefixes
   void prefix(Prefix p);
 
+  // Size of the memory operand of the EVEX instruction being emitted,
+  // 0 otherwise.  EVEX instructions scale an 8-bit displacement by it.
+  int _evex_disp8_scale;
+
   public:
 
   // Creation
-  Assembler(CodeBuffer* code) : AbstractAssembler(code) {}
+  Assembler(CodeBuffer* code) : AbstractAssembler(code), _evex_disp8_scale(0) {}
 
   // Decoding
   static address locate_operand(address inst, WhichOperand which);
@@ -1043,6 +1062,7 @@ private:
 
   // Convert Packed Signed Doubleword Integers to Packed Single-Precision Floating-Point Value
   void cvtdq2ps(XMMRegister dst, XMMRegister src);
+  void vcvtdq2ps(XMMRegister dst, XMMRegister src, bool vector256);
 
   // Convert Scalar Single-Precision Floating-Point Value to Scalar Double-Precision Floating-Point Value
   void cvtss2sd(XMMRegister dst, XMMRegister src);
@@ -1339,6 +1359,13 @@ private:
   void vmovdqu(XMMRegister dst, Address src);
   void vmovdqu(XMMRegister dst, XMMRegister src);
 
+  // Store Aligned 256bit Vector with a Non-Temporal Hint
+  void vmovntdq(Address dst, XMMRegister src);
+
+  // Move Unaligned 512bit Vector of doublewords
+  void evmovdqul(Address dst, XMMRegister src);
+  void evmovdqul(XMMRegister dst, Address src);
+
   // Move lower 64bit to high 64bit in 128bit register
   void movlhps(XMMRegister dst, XMMRegister src);
 
@@ -1472,6 +1499,12 @@ private:
 
   void pause();
 
+  // Concatenate and right shift bytes
+  void palignr(XMMRegister dst, XMMRegister src, int imm8);
+
+  // Blend packed words
+  void pblendw(XMMRegister dst, XMMRegister src, int imm8);
+
   // SSE4.2 string instructions
   void pcmpestri(XMMRegister xmm1, XMMRegister xmm2, int imm8);
   void pcmpestri(XMMRegister xmm1, Address src, int imm8);
@@ -1527,6 +1560,8 @@ private:
 
   // Shift Right by bytes Logical DoubleQuadword Immediate
   void psrldq(XMMRegister dst, int shift);
+  // Shift Left by bytes Logical DoubleQuadword Immediate
+  void pslldq(XMMRegister dst, int shift);
 
   // Logical Compare 128bit
   void ptest(XMMRegister dst, XMMRegister src);
@@ -1587,6 +1622,18 @@ private:
 
   void setb(Condition cc, Register dst);
 
+  void sfence();
+
+  // SHA-1 and SHA-256 extensions
+  void sha1rnds4(XMMRegister dst, XMMRegister src, int imm8);
+  void sha1nexte(XMMRegister dst, XMMRegister src);
+  void sha1msg1(XMMRegister dst, XMMRegister src);
+  void sha1msg2(XMMRegister dst, XMMRegister src);
+  // xmm0 is an implicit argument
+  void sha256rnds2(XMMRegister dst, XMMRegister src);
+  void sha256msg1(XMMRegister dst, XMMRegister src);
+  void sha256msg2(XMMRegister dst, XMMRegister src);
+
   void shldl(Register dst, Register src);
 
   void shll(Register dst, int imm8);
@@ -1859,9 +1906,20 @@ private:
   void vextractf128h(Address dst, XMMRegister src);
   void vextracti128h(Address dst, XMMRegister src);
 
+  // Copy high 128bit of YMM registers into low 128bit of XMM registers.
+  void vextractf128h(XMMRegister dst, XMMRegister src);
+  void vextracti128h(XMMRegister dst, XMMRegister src);
+
   // duplicate 4-bytes integer data from src into 8 locations in dest
   void vpbroadcastd(XMMRegister dst, XMMRegister src);
 
+  // Sign/zero extend packed bytes/words into 8 dwords (AVX2)
+  void vpmovsxbd(XMMRegister dst, Address src);
+  void vpmovzxwd(XMMRegister dst, Address src);
+
+  // duplicate 4-bytes integer data from src into 16 locations in dest
+  void evpbroadcastd(XMMRegister dst, XMMRegister src);
+
   // Carry-Less Multiplication Quadword
   void pclmulqdq(XMMRegister dst, XMMRegister src, int mask);
   void vpclmulqdq(XMMRegister dst, XMMRegister nds, XMMRegister src, int mask);
@@ -128,6 +128,11 @@ define_pd_global(bool, PreserveFramePointer, false);
   product(bool, UseUnalignedLoadStores, false,                              \
           "Use SSE2 MOVDQU instruction for Arraycopy")                      \
                                                                             \
+  product(uintx, ArrayCopyNonTemporalThreshold, 8*M,                        \
+          "Disjoint arraycopy stubs copy arrays of at least this many "     \
+          "bytes with non-temporal stores, with UseUnalignedLoadStores "    \
+          "and AVX2; 0 disables them")                                      \
+                                                                            \
   product(bool, UseFastStosb, false,                                        \
           "Use fast-string operation for zeroing: rep stosb")               \
                                                                             \
@@ -1208,10 +1208,10 @@ public:
                       Register cnt1, Register cnt2, Register result,
                       XMMRegister vec1);
 
-  // Compare char[] arrays.
-  void char_arrays_equals(bool is_array_equ, Register ary1, Register ary2,
-                          Register limit, Register result, Register chr,
-                          XMMRegister vec1, XMMRegister vec2);
+  // Compare char[] or byte[] arrays.
+  void arrays_equals(bool is_array_equ, Register ary1, Register ary2,
+                     Register limit, Register result, Register chr,
+                     XMMRegister vec1, XMMRegister vec2, bool is_char);
 
   // Fill primitive arrays
   void generate_fill(BasicType t, bool aligned,
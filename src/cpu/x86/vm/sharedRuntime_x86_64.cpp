@@ -4034,10 +4034,67 @@ do {                                                                \
            : "r"(A), "a"(B) : "cc");                                \
  } while(0)
 
+// Multiply A by B and C by D, accumulating both double-length results
+// into T0, T1, T2.  MULX leaves the flags alone and ADCX/ADOX carry
+// through CF and OF respectively, so the two accumulations run as
+// independent carry chains.  Requires BMI2 and ADX.
+#define MACCX(A, B, C, D, T0, T1, T2)                                   \
+do {                                                                    \
+  unsigned long lo1, hi1, lo2, hi2, z;                                  \
+  asm volatile("xor %4, %4; "                                           \
+               "mov %8, %%rdx; mulx %9, %0, %1; "                       \
+               "mov %10, %%rdx; mulx %11, %2, %%rdx; "                  \
+               "adcx %0, %5; adox %2, %5; "                             \
+               "adcx %1, %6; adox %3, %6; "                             \
+               "adcx %4, %7; adox %4, %7"                               \
+           : "=&r"(lo1), "=&r"(hi1), "=&r"(lo2), "=&d"(hi2), "=&r"(z),  \
+             "+r"(T0), "+r"(T1), "+r"(T2)                               \
+           : "m"(A), "m"(B), "m"(C), "m"(D) : "cc");                    \
+ } while(0)
+
+// As above, but add twice the product of A and B.
+#define MACC2X(A, B, C, D, T0, T1, T2)                                  \
+do {                                                                    \
+  unsigned long lo1, hi1, lo2, hi2, z;                                  \
+  asm volatile("xor %4, %4; "                                           \
+               "mov %8, %%rdx; mulx %9, %0, %1; "                       \
+               "mov %10, %%rdx; mulx %11, %2, %%rdx; "                  \
+               "adcx %0, %5; adox %2, %5; "                             \
+               "adcx %1, %6; adox %3, %6; "                             \
+               "adcx %4, %7; adox %4, %7; "                             \
+               "adcx %0, %5; adcx %1, %6; adcx %4, %7"                  \
+           : "=&r"(lo1), "=&r"(hi1), "=&r"(lo2), "=&d"(hi2), "=&r"(z),  \
+             "+r"(T0), "+r"(T1), "+r"(T2)                               \
+           : "m"(A), "m"(B), "m"(C), "m"(D) : "cc");                    \
+ } while(0)
+
+// Accumulate A*B + C*D, or 2*A*B + C*D, using MULX/ADCX/ADOX when the
+// template parameter ADX says the CPU has them.
+#define MACC_PAIR(ADX, A, B, C, D, T0, T1, T2)                          \
+do {                                                                    \
+  if (ADX) {                                                            \
+    MACCX(A, B, C, D, T0, T1, T2);                                      \
+  } else {                                                              \
+    MACC(A, B, T0, T1, T2);                                             \
+    MACC(C, D, T0, T1, T2);                                             \
+  }                                                                     \
+ } while(0)
+
+#define MACC2_PAIR(ADX, A, B, C, D, T0, T1, T2)                         \
+do {                                                                    \
+  if (ADX) {                                                            \
+    MACC2X(A, B, C, D, T0, T1, T2);                                     \
+  } else {                                                              \
+    MACC2(A, B, T0, T1, T2);                                            \
+    MACC(C, D, T0, T1, T2);                                             \
+  }                                                                     \
+ } while(0)
+
 // Fast Montgomery multiplication.  The derivation of the algorithm is
 // in  A Cryptographic Library for the Motorola DSP56000,
 // Dusse and Kaliski, Proc. EUROCRYPT 90, pp. 230-237.
 
+template <bool adx>
 static void __attribute__((noinline))
 montgomery_multiply(unsigned long a[], unsigned long b[], unsigned long n[],
                     unsigned long m[], unsigned long inv, int len) {
@@ -4049,8 +4106,7 @@ montgomery_multiply(unsigned long a[], unsigned long b[], unsigned long n[],
   for (i = 0; i < len; i++) {
     int j;
     for (j = 0; j < i; j++) {
-      MACC(a[j], b[i-j], t0, t1, t2);
-      MACC(m[j], n[i-j], t0, t1, t2);
+      MACC_PAIR(adx, a[j], b[i-j], m[j], n[i-j], t0, t1, t2);
     }
     MACC(a[i], b[0], t0, t1, t2);
     m[i] = t0 * inv;
@@ -4064,8 +4120,7 @@ montgomery_multiply(unsigned long a[], unsigned long b[], unsigned long n[],
   for (i = len; i < 2*len; i++) {
     int j;
     for (j = i-len+1; j < len; j++) {
-      MACC(a[j], b[i-j], t0, t1, t2);
-      MACC(m[j], n[i-j], t0, t1, t2);
+      MACC_PAIR(adx, a[j], b[i-j], m[j], n[i-j], t0, t1, t2);
     }
     m[i-len] = t0;
     t0 = t1; t1 = t2; t2 = 0;
@@ -4080,6 +4135,7 @@ montgomery_multiply(unsigned long a[], unsigned long b[], unsigned long n[],
 // multiplication.  However, its loop control is more complex and it
 // may actually run slower on some machines.
 
+template <bool adx>
 static void __attribute__((noinline))
 montgomery_square(unsigned long a[], unsigned long n[],
                   unsigned long m[], unsigned long inv, int len) {
@@ -4092,8 +4148,7 @@ montgomery_square(unsigned long a[], unsigned long n[],
     int j;
     int end = (i+1)/2;
     for (j = 0; j < end; j++) {
-      MACC2(a[j], a[i-j], t0, t1, t2);
-      MACC(m[j], n[i-j], t0, t1, t2);
+      MACC2_PAIR(adx, a[j], a[i-j], m[j], n[i-j], t0, t1, t2);
     }
     if ((i & 1) == 0) {
       MACC(a[j], a[j], t0, t1, t2);
@@ -4114,8 +4169,7 @@ montgomery_square(unsigned long a[], unsigned long n[],
     int end = start + (len - start)/2;
     int j;
     for (j = start; j < end; j++) {
-      MACC2(a[j], a[i-j], t0, t1, t2);
-      MACC(m[j], n[i-j], t0, t1, t2);
+      MACC2_PAIR(adx, a[j], a[i-j], m[j], n[i-j], t0, t1, t2);
     }
     if ((i & 1) == 0) {
       MACC(a[j], a[j], t0, t1, t2);
@@ -4175,7 +4229,11 @@ void SharedRuntime::montgomery_multiply(jint *a_ints, jint *b_ints, jint *n_ints
   reverse_words((unsigned long *)b_ints, b, longwords);
   reverse_words((unsigned long *)n_ints, n, longwords);
 
-  ::montgomery_multiply(a, b, n, m, (unsigned long)inv, longwords);
+  if (VM_Version::supports_bmi2() && VM_Version::supports_adx()) {
+    ::montgomery_multiply<true>(a, b, n, m, (unsigned long)inv, longwords);
+  } else {
+    ::montgomery_multiply<false>(a, b, n, m, (unsigned long)inv, longwords);
+  }
 
   reverse_words(m, (unsigned long *)m_ints, longwords);
 }
@@ -4205,13 +4263,23 @@ void SharedRuntime::montgomery_square(jint *a_ints, jint *n_ints,
   //montgomery_square fails to pass BigIntegerTest on solaris amd64
   //on jdk7 and jdk8.
 #ifndef SOLARIS
-  if (len >= MONTGOMERY_SQUARING_THRESHOLD) {
+  bool use_square = len >= MONTGOMERY_SQUARING_THRESHOLD;
 #else
-  if (0) {
+  bool use_square = false;
 #endif
-    ::montgomery_square(a, n, m, (unsigned long)inv, longwords);
+  bool adx = VM_Version::supports_bmi2() && VM_Version::supports_adx();
+  if (use_square) {
+    if (adx) {
+      ::montgomery_square<true>(a, n, m, (unsigned long)inv, longwords);
+    } else {
+      ::montgomery_square<false>(a, n, m, (unsigned long)inv, longwords);
+    }
   } else {
-    ::montgomery_multiply(a, a, n, m, (unsigned long)inv, longwords);
+    if (adx) {
+      ::montgomery_multiply<true>(a, a, n, m, (unsigned long)inv, longwords);
+    } else {
+      ::montgomery_multiply<false>(a, a, n, m, (unsigned long)inv, longwords);
+    }
   }
 
   reverse_words(m, (unsigned long *)m_ints, longwords);
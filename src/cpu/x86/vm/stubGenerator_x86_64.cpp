@@ -1289,12 +1289,50 @@ class StubGenerator: public StubCodeGenerator {
                              Label& L_copy_bytes, Label& L_copy_8_bytes) {
     DEBUG_ONLY(__ stop("enter at entry label, not here"));
     Label L_loop;
-    __ align(OptoLoopAlignment);
     if (UseUnalignedLoadStores) {
-      Label L_end;
+      Label L_end, L_copy_loop, L_copy_tail;
+      bool non_temporal = UseAVX >= 2 && ArrayCopyNonTemporalThreshold > 0;
+      if (non_temporal) {
+        // Huge copies with an 8-byte aligned destination use non-temporal
+        // stores, so that they do not evict the whole cache hierarchy.
+        Label L_nt_loop, L_nt_next;
+        intx nt_qwords = MAX2((intx)(ArrayCopyNonTemporalThreshold / BytesPerLong), (intx)16);
+        __ BIND(L_copy_bytes);
+        __ cmpptr(qword_count, -(int32_t)MIN2(nt_qwords, (intx)max_jint));
+        __ jcc(Assembler::greater, L_copy_loop);
+        __ lea(to, Address(end_to, qword_count, Address::times_8, 8));
+        __ testptr(to, 7);
+        __ jcc(Assembler::notZero, L_copy_loop);
+        // Copy the first 32 bytes, then skip the qwords that precede the
+        // first 32-byte aligned destination address
+        __ vmovdqu(xmm0, Address(end_from, qword_count, Address::times_8, 8));
+        __ vmovdqu(Address(end_to, qword_count, Address::times_8, 8), xmm0);
+        __ negptr(to);
+        __ andptr(to, 31);
+        __ shrptr(to, 3);
+        __ addptr(qword_count, to);
+        __ jmp(L_nt_next);
+
+        __ align(OptoLoopAlignment);
+        __ BIND(L_nt_loop);
+        __ vmovdqu(xmm0, Address(end_from, qword_count, Address::times_8, -56));
+        __ vmovntdq(Address(end_to, qword_count, Address::times_8, -56), xmm0);
+        __ vmovdqu(xmm1, Address(end_from, qword_count, Address::times_8, -24));
+        __ vmovntdq(Address(end_to, qword_count, Address::times_8, -24), xmm1);
+        __ BIND(L_nt_next);
+        __ addptr(qword_count, 8);
+        __ jcc(Assembler::lessEqual, L_nt_loop);
+        // Order the non-temporal stores before any later store
+        __ sfence();
+        __ jmp(L_copy_tail);
+      }
+      __ align(OptoLoopAlignment);
       // Copy 64-bytes per iteration
       __ BIND(L_loop);
-      if (UseAVX >= 2) {
+      if (UseAVX > 2) {
+        __ evmovdqul(xmm0, Address(end_from, qword_count, Address::times_8, -56));
+        __ evmovdqul(Address(end_to, qword_count, Address::times_8, -56), xmm0);
+      } else if (UseAVX >= 2) {
         __ vmovdqu(xmm0, Address(end_from, qword_count, Address::times_8, -56));
         __ vmovdqu(Address(end_to, qword_count, Address::times_8, -56), xmm0);
         __ vmovdqu(xmm1, Address(end_from, qword_count, Address::times_8, -24));
@@ -1309,9 +1347,10 @@ class StubGenerator: public StubCodeGenerator {
         __ movdqu(xmm3, Address(end_from, qword_count, Address::times_8, - 8));
         __ movdqu(Address(end_to, qword_count, Address::times_8, - 8), xmm3);
       }
-      __ BIND(L_copy_bytes);
+      __ BIND(non_temporal ? L_copy_loop : L_copy_bytes);
       __ addptr(qword_count, 8);
       __ jcc(Assembler::lessEqual, L_loop);
+      __ BIND(L_copy_tail);
       __ subptr(qword_count, 4);  // sub(8) and add(4)
       __ jccb(Assembler::greater, L_end);
       // Copy trailing 32 bytes
@@ -1327,11 +1366,12 @@ class StubGenerator: public StubCodeGenerator {
       __ addptr(qword_count, 4);
       __ BIND(L_end);
       if (UseAVX >= 2) {
-        // clean upper bits of YMM registers
+        // clean upper bits of YMM registers (VEX encoding clears the ZMM part too)
         __ vpxor(xmm0, xmm0);
         __ vpxor(xmm1, xmm1);
       }
     } else {
+      __ align(OptoLoopAlignment);
       // Copy 32-bytes per iteration
       __ BIND(L_loop);
       __ movq(to, Address(end_from, qword_count, Address::times_8, -24));
@@ -1371,7 +1411,10 @@ class StubGenerator: public StubCodeGenerator {
       Label L_end;
       // Copy 64-bytes per iteration
       __ BIND(L_loop);
-      if (UseAVX >= 2) {
+      if (UseAVX > 2) {
+        __ evmovdqul(xmm0, Address(from, qword_count, Address::times_8, 0));
+        __ evmovdqul(Address(dest, qword_count, Address::times_8, 0), xmm0);
+      } else if (UseAVX >= 2) {
         __ vmovdqu(xmm0, Address(from, qword_count, Address::times_8, 32));
         __ vmovdqu(Address(dest, qword_count, Address::times_8, 32), xmm0);
         __ vmovdqu(xmm1, Address(from, qword_count, Address::times_8,  0));
@@ -1405,7 +1448,7 @@ class StubGenerator: public StubCodeGenerator {
       __ subptr(qword_count, 4);
       __ BIND(L_end);
       if (UseAVX >= 2) {
-        // clean upper bits of YMM registers
+        // clean upper bits of YMM registers (VEX encoding clears the ZMM part too)
         __ vpxor(xmm0, xmm0);
         __ vpxor(xmm1, xmm1);
       }
@@ -3639,6 +3682,452 @@ class StubGenerator: public StubCodeGenerator {
     return start;
   }
 
+  // byte swap x86 long
+  address generate_ghash_long_swap_mask() {
+    __ align(CodeEntryAlignment);
+    StubCodeMark mark(this, "StubRoutines", "ghash_long_swap_mask");
+    address start = __ pc();
+    __ emit_data64(0x0f0e0d0c0b0a0908, relocInfo::none);
+    __ emit_data64(0x0706050403020100, relocInfo::none);
+    return start;
+  }
+
+  // byte swap x86 byte array
+  address generate_ghash_byte_swap_mask() {
+    __ align(CodeEntryAlignment);
+    StubCodeMark mark(this, "StubRoutines", "ghash_byte_swap_mask");
+    address start = __ pc();
+    __ emit_data64(0x08090a0b0c0d0e0f, relocInfo::none);
+    __ emit_data64(0x0001020304050607, relocInfo::none);
+    return start;
+  }
+
+  // Single and multi-block ghash operations
+  //
+  // Arguments:
+  //
+  // Inputs:
+  //   c_rarg0   - long[] state, two longs, updated in place
+  //   c_rarg1   - long[] subkeyH, two longs
+  //   c_rarg2   - byte[] data address
+  //   c_rarg3   - number of 16-byte blocks, at least one
+  //
+  address generate_ghash_processBlocks() {
+    assert(UseGHASHIntrinsics, "need CLMUL instructions");
+    __ align(CodeEntryAlignment);
+    Label L_ghash_loop, L_exit;
+    StubCodeMark mark(this, "StubRoutines", "ghash_processBlocks");
+    address start = __ pc();
+
+    const Register state        = c_rarg0;
+    const Register subkeyH      = c_rarg1;
+    const Register data         = c_rarg2;
+    const Register blocks       = c_rarg3;
+
+#ifdef _WIN64
+    const int XMM_REG_LAST  = 10;
+#endif
+
+    const XMMRegister xmm_temp0 = xmm0;
+    const XMMRegister xmm_temp1 = xmm1;
+    const XMMRegister xmm_temp2 = xmm2;
+    const XMMRegister xmm_temp3 = xmm3;
+    const XMMRegister xmm_temp4 = xmm4;
+    const XMMRegister xmm_temp5 = xmm5;
+    const XMMRegister xmm_temp6 = xmm6;
+    const XMMRegister xmm_temp7 = xmm7;
+    const XMMRegister xmm_temp8 = xmm8;
+    const XMMRegister xmm_temp9 = xmm9;
+    const XMMRegister xmm_temp10 = xmm10;
+
+    __ enter(); // required for proper stackwalking of RuntimeStub frame
+
+#ifdef _WIN64
+    // save the xmm registers which must be preserved 6-10
+    __ subptr(rsp, -rsp_after_call_off * wordSize);
+    for (int i = 6; i <= XMM_REG_LAST; i++) {
+      __ movdqu(xmm_save(i), as_XMMRegister(i));
+    }
+#endif
+
+    __ movdqu(xmm_temp10, ExternalAddress(StubRoutines::x86::ghash_long_swap_mask_addr()));
+
+    __ movdqu(xmm_temp0, Address(state, 0));
+    __ pshufb(xmm_temp0, xmm_temp10);
+
+    // The subkey does not change across blocks, keep it in xmm1.
+    __ movdqu(xmm_temp1, Address(subkeyH, 0));
+    __ pshufb(xmm_temp1, xmm_temp10);
+
+    __ BIND(L_ghash_loop);
+    __ movdqu(xmm_temp2, Address(data, 0));
+    __ pshufb(xmm_temp2, ExternalAddress(StubRoutines::x86::ghash_byte_swap_mask_addr()));
+
+    __ pxor(xmm_temp0, xmm_temp2);
+
+    //
+    // Multiply with the hash key
+    //
+    __ movdqu(xmm_temp3, xmm_temp0);
+    __ pclmulqdq(xmm_temp3, xmm_temp1, 0);      // xmm3 holds a0*b0
+    __ movdqu(xmm_temp4, xmm_temp0);
+    __ pclmulqdq(xmm_temp4, xmm_temp1, 16);     // xmm4 holds a0*b1
+
+    __ movdqu(xmm_temp5, xmm_temp0);
+    __ pclmulqdq(xmm_temp5, xmm_temp1, 1);      // xmm5 holds a1*b0
+    __ movdqu(xmm_temp6, xmm_temp0);
+    __ pclmulqdq(xmm_temp6, xmm_temp1, 17);     // xmm6 holds a1*b1
+
+    __ pxor(xmm_temp4, xmm_temp5);      // xmm4 holds a0*b1 + a1*b0
+
+    __ movdqu(xmm_temp5, xmm_temp4);    // move the contents of xmm4 to xmm5
+    __ psrldq(xmm_temp4, 8);    // shift by xmm4 64 bits to the right
+    __ pslldq(xmm_temp5, 8);    // shift by xmm5 64 bits to the left
+    __ pxor(xmm_temp3, xmm_temp5);
+    __ pxor(xmm_temp6, xmm_temp4);      // Register pair <xmm6:xmm3> holds the result
+                                        // of the carry-less multiplication of
+                                        // xmm0 by xmm1.
+
+    // We shift the result of the multiplication by one bit position
+    // to the left to cope for the fact that the bits are reversed.
+    __ movdqu(xmm_temp7, xmm_temp3);
+    __ movdqu(xmm_temp8, xmm_temp6);
+    __ pslld(xmm_temp3, 1);
+    __ pslld(xmm_temp6, 1);
+    __ psrld(xmm_temp7, 31);
+    __ psrld(xmm_temp8, 31);
+    __ movdqu(xmm_temp9, xmm_temp7);
+    __ pslldq(xmm_temp8, 4);
+    __ pslldq(xmm_temp7, 4);
+    __ psrldq(xmm_temp9, 12);
+    __ por(xmm_temp3, xmm_temp7);
+    __ por(xmm_temp6, xmm_temp8);
+    __ por(xmm_temp6, xmm_temp9);
+
+    //
+    // First phase of the reduction
+    //
+    // Move xmm3 into xmm7, xmm8, xmm9 in order to perform the shifts
+    // independently.
+    __ movdqu(xmm_temp7, xmm_temp3);
+    __ movdqu(xmm_temp8, xmm_temp3);
+    __ movdqu(xmm_temp9, xmm_temp3);
+    __ pslld(xmm_temp7, 31);    // packed right shift shifting << 31
+    __ pslld(xmm_temp8, 30);    // packed right shift shifting << 30
+    __ pslld(xmm_temp9, 25);    // packed right shift shifting << 25
+    __ pxor(xmm_temp7, xmm_temp8);      // xor the shifted versions
+    __ pxor(xmm_temp7, xmm_temp9);
+    __ movdqu(xmm_temp8, xmm_temp7);
+    __ pslldq(xmm_temp7, 12);
+    __ psrldq(xmm_temp8, 4);
+    __ pxor(xmm_temp3, xmm_temp7);      // first phase of the reduction complete
+
+    //
+    // Second phase of the reduction
+    //
+    // Make 3 copies of xmm3 in xmm2, xmm4, xmm5 for doing these
+    // shift operations.
+    __ movdqu(xmm_temp2, xmm_temp3);
+    __ movdqu(xmm_temp4, xmm_temp3);
+    __ movdqu(xmm_temp5, xmm_temp3);
+    __ psrld(xmm_temp2, 1);     // packed left shifting >> 1
+    __ psrld(xmm_temp4, 2);     // packed left shifting >> 2
+    __ psrld(xmm_temp5, 7);     // packed left shifting >> 7
+    __ pxor(xmm_temp2, xmm_temp4);      // xor the shifted versions
+    __ pxor(xmm_temp2, xmm_temp5);
+    __ pxor(xmm_temp2, xmm_temp8);
+    __ pxor(xmm_temp3, xmm_temp2);
+    __ pxor(xmm_temp6, xmm_temp3);      // the result is in xmm6
+
+    __ decrement(blocks);
+    __ jcc(Assembler::zero, L_exit);
+    __ movdqu(xmm_temp0, xmm_temp6);
+    __ addptr(data, 16);
+    __ jmp(L_ghash_loop);
+
+    __ BIND(L_exit);
+    __ pshufb(xmm_temp6, xmm_temp10);          // Byte swap 16-byte result
+    __ movdqu(Address(state, 0), xmm_temp6);   // store the result
+
+#ifdef _WIN64
+    // restore xmm regs belonging to calling function
+    for (int i = 6; i <= XMM_REG_LAST; i++) {
+      __ movdqu(as_XMMRegister(i), xmm_save(i));
+    }
+#endif
+    __ leave();
+    __ ret(0);
+    return start;
+  }
+
+  // reverse the bytes of a 128-bit word, for SHA-1 message words
+  address generate_sha1_byte_flip_mask() {
+    __ align(CodeEntryAlignment);
+    StubCodeMark mark(this, "StubRoutines", "sha1_byte_flip_mask");
+    address start = __ pc();
+    __ emit_data64(0x08090a0b0c0d0e0f, relocInfo::none);
+    __ emit_data64(0x0001020304050607, relocInfo::none);
+    return start;
+  }
+
+  // reverse the bytes of each 32-bit word, for SHA-256 message words
+  address generate_sha256_byte_flip_mask() {
+    __ align(CodeEntryAlignment);
+    StubCodeMark mark(this, "StubRoutines", "sha256_byte_flip_mask");
+    address start = __ pc();
+    __ emit_data64(0x0405060700010203, relocInfo::none);
+    __ emit_data64(0x0c0d0e0f08090a0b, relocInfo::none);
+    return start;
+  }
+
+  // SHA-1 using the SHA extensions.
+  //
+  // Arguments:
+  //
+  // Inputs:
+  //   c_rarg0   - byte[]  source+offset
+  //   c_rarg1   - int[]   SHA.state
+  //   c_rarg2   - int     offset
+  //   c_rarg3   - int     limit
+  //
+  // Output:
+  //   rax       - offset after the last block, multi_block only
+  //
+  address generate_sha1_implCompress(bool multi_block, const char *name) {
+    assert(UseSHA1Intrinsics, "need SHA instructions");
+    __ align(CodeEntryAlignment);
+    StubCodeMark mark(this, "StubRoutines", name);
+    address start = __ pc();
+
+    Label L_loop;
+
+    const Register buf   = c_rarg0;
+    const Register state = c_rarg1;
+    const Register ofs   = c_rarg2;
+    const Register limit = c_rarg3;
+
+    const XMMRegister abcd      = xmm0;
+    const XMMRegister e0        = xmm1;  // the E values ping-pong between e0 and e1
+    const XMMRegister e1        = xmm2;
+    const XMMRegister shuf_mask = xmm7;
+    const XMMRegister e_save    = xmm8;
+    const XMMRegister abcd_save = xmm9;
+    // msg[i] holds message words 4*i .. 4*i+3 (mod 16)
+    const XMMRegister msg[4] = { xmm3, xmm4, xmm5, xmm6 };
+
+#ifdef _WIN64
+    const int XMM_REG_LAST = 9;
+#endif
+
+    __ enter(); // required for proper stackwalking of RuntimeStub frame
+
+#ifdef _WIN64
+    // save the xmm registers which must be preserved 6-9
+    __ subptr(rsp, -rsp_after_call_off * wordSize);
+    for (int i = 6; i <= XMM_REG_LAST; i++) {
+      __ movdqu(xmm_save(i), as_XMMRegister(i));
+    }
+#endif
+
+    // load the state: A in the highest lane of abcd and E in the highest
+    // lane of e0, with the other lanes of e0 cleared
+    __ movdqu(abcd, Address(state, 0));
+    __ pshufd(abcd, abcd, 0x1B);
+    __ movdl(e0, Address(state, 16));
+    __ pslldq(e0, 12);
+
+    __ movdqu(shuf_mask, ExternalAddress(StubRoutines::x86::sha1_byte_flip_mask_addr()));
+
+    __ BIND(L_loop);
+    __ movdqa(e_save, e0);
+    __ movdqa(abcd_save, abcd);
+
+    // 20 groups of 4 rounds. Message schedule for group j is produced
+    // over the three previous groups: sha1msg1 in j-3, pxor in j-2 and
+    // sha1msg2 in j-1.
+    for (int k = 0; k < 20; k++) {
+      XMMRegister cur    = msg[k & 3];
+      XMMRegister e_in   = (k & 1) == 0 ? e0 : e1;
+      XMMRegister e_next = (k & 1) == 0 ? e1 : e0;
+      if (k < 4) {
+        __ movdqu(cur, Address(buf, k * 16));
+        __ pshufb(cur, shuf_mask);
+      }
+      if (k == 0) {
+        __ paddd(e0, cur);
+      } else {
+        __ sha1nexte(e_in, cur);
+      }
+      __ movdqa(e_next, abcd);
+      if (k >= 3 && k <= 18) {
+        __ sha1msg2(msg[(k + 1) & 3], cur);
+      }
+      __ sha1rnds4(abcd, e_in, k / 5);
+      if (k >= 1 && k <= 16) {
+        __ sha1msg1(msg[(k - 1) & 3], cur);
+      }
+      if (k >= 2 && k <= 17) {
+        __ pxor(msg[(k - 2) & 3], cur);
+      }
+    }
+
+    // add the saved state
+    __ sha1nexte(e0, e_save);
+    __ paddd(abcd, abcd_save);
+
+    if (multi_block) {
+      __ addptr(buf, 64);
+      __ addl(ofs, 64);
+      __ cmpl(ofs, limit);
+      __ jcc(Assembler::lessEqual, L_loop);
+      __ movl(rax, ofs); // return ofs
+    }
+
+    // store the state back
+    __ pshufd(abcd, abcd, 0x1B);
+    __ movdqu(Address(state, 0), abcd);
+    __ pshufd(e0, e0, 0x03);
+    __ movdl(Address(state, 16), e0);
+
+#ifdef _WIN64
+    // restore xmm regs belonging to calling function
+    for (int i = 6; i <= XMM_REG_LAST; i++) {
+      __ movdqu(as_XMMRegister(i), xmm_save(i));
+    }
+#endif
+    __ leave();
+    __ ret(0);
+    return start;
+  }
+
+  // SHA-256 using the SHA extensions.
+  //
+  // Arguments:
+  //
+  // Inputs:
+  //   c_rarg0   - byte[]  source+offset
+  //   c_rarg1   - int[]   SHA2.state
+  //   c_rarg2   - int     offset
+  //   c_rarg3   - int     limit
+  //
+  // Output:
+  //   rax       - offset after the last block, multi_block only
+  //
+  address generate_sha256_implCompress(bool multi_block, const char *name) {
+    assert(UseSHA256Intrinsics, "need SHA instructions");
+    __ align(CodeEntryAlignment);
+    StubCodeMark mark(this, "StubRoutines", name);
+    address start = __ pc();
+
+    Label L_loop;
+
+    const Register buf   = c_rarg0;
+    const Register state = c_rarg1;
+    const Register ofs   = c_rarg2;
+    const Register limit = c_rarg3;
+    const Register k256  = r11;
+
+    const XMMRegister msg       = xmm0;  // implicit operand of sha256rnds2
+    const XMMRegister state0    = xmm1;
+    const XMMRegister state1    = xmm2;
+    const XMMRegister msgtmp4   = xmm7;
+    const XMMRegister shuf_mask = xmm8;
+    const XMMRegister abef_save = xmm9;
+    const XMMRegister cdgh_save = xmm10;
+    // msgtmp[i] holds message words 4*i .. 4*i+3 (mod 16)
+    const XMMRegister msgtmp[4] = { xmm3, xmm4, xmm5, xmm6 };
+
+#ifdef _WIN64
+    const int XMM_REG_LAST = 10;
+#endif
+
+    __ enter(); // required for proper stackwalking of RuntimeStub frame
+
+#ifdef _WIN64
+    // save the xmm registers which must be preserved 6-10
+    __ subptr(rsp, -rsp_after_call_off * wordSize);
+    for (int i = 6; i <= XMM_REG_LAST; i++) {
+      __ movdqu(xmm_save(i), as_XMMRegister(i));
+    }
+#endif
+
+    // load the state and reorder DCBA, HGFE -> ABEF, CDGH
+    __ movdqu(state0, Address(state, 0));
+    __ movdqu(state1, Address(state, 16));
+    __ pshufd(state0, state0, 0xB1);      // CDAB
+    __ pshufd(state1, state1, 0x1B);      // EFGH
+    __ movdqa(msgtmp4, state0);
+    __ palignr(state0, state1, 8);        // ABEF
+    __ pblendw(state1, msgtmp4, 0xF0);    // CDGH
+
+    __ movdqu(shuf_mask, ExternalAddress(StubRoutines::x86::sha256_byte_flip_mask_addr()));
+    __ lea(k256, ExternalAddress(StubRoutines::x86::k256_addr()));
+
+    __ BIND(L_loop);
+    __ movdqa(abef_save, state0);
+    __ movdqa(cdgh_save, state1);
+
+    // 16 groups of 4 rounds. Message schedule for group j is produced
+    // over the three previous groups: sha256msg1 in j-3, the palignr/paddd
+    // and sha256msg2 in j-1.
+    for (int k = 0; k < 16; k++) {
+      XMMRegister cur = msgtmp[k & 3];
+      if (k < 4) {
+        __ movdqu(msg, Address(buf, k * 16));
+        __ pshufb(msg, shuf_mask);
+        __ movdqa(cur, msg);
+      } else {
+        __ movdqa(msg, cur);
+      }
+      __ movdqu(msgtmp4, Address(k256, k * 16));
+      __ paddd(msg, msgtmp4);
+      __ sha256rnds2(state1, state0);
+      if (k >= 3 && k <= 14) {
+        XMMRegister next = msgtmp[(k + 1) & 3];
+        __ movdqa(msgtmp4, cur);
+        __ palignr(msgtmp4, msgtmp[(k - 1) & 3], 4);
+        __ paddd(next, msgtmp4);
+        __ sha256msg2(next, cur);
+      }
+      __ pshufd(msg, msg, 0x0E);
+      __ sha256rnds2(state0, state1);
+      if (k >= 1 && k <= 12) {
+        __ sha256msg1(msgtmp[(k - 1) & 3], cur);
+      }
+    }
+
+    // add the saved state
+    __ paddd(state0, abef_save);
+    __ paddd(state1, cdgh_save);
+
+    if (multi_block) {
+      __ addptr(buf, 64);
+      __ addl(ofs, 64);
+      __ cmpl(ofs, limit);
+      __ jcc(Assembler::lessEqual, L_loop);
+      __ movl(rax, ofs); // return ofs
+    }
+
+    // reorder ABEF, CDGH -> DCBA, HGFE and store the state back
+    __ pshufd(state0, state0, 0x1B);      // FEBA
+    __ pshufd(state1, state1, 0xB1);      // DCHG
+    __ movdqa(msgtmp4, state0);
+    __ pblendw(state0, state1, 0xF0);     // DCBA
+    __ palignr(state1, msgtmp4, 8);       // HGFE
+    __ movdqu(Address(state, 0), state0);
+    __ movdqu(Address(state, 16), state1);
+
+#ifdef _WIN64
+    // restore xmm regs belonging to calling function
+    for (int i = 6; i <= XMM_REG_LAST; i++) {
+      __ movdqu(as_XMMRegister(i), xmm_save(i));
+    }
+#endif
+    __ leave();
+    __ ret(0);
+    return start;
+  }
+
   /**
    *  Arguments:
    *
@@ -3680,6 +4169,225 @@ class StubGenerator: public StubCodeGenerator {
   }
 
 
+  /**
+   *  Arguments:
+   *
+   * Inputs:
+   *   c_rarg0   - char* or byte* address of the first element
+   *   c_rarg1   - int length
+   *   c_rarg2   - int initial hash value
+   *
+   * Ouput:
+   *       rax   - int hash, i.e. init * 31^len + sum(a[i] * 31^(len-1-i))
+   *
+   * The main loop hashes 32 elements per iteration in four 8-lane
+   * accumulators which are scaled by 31^32 on every iteration.  The
+   * lanes are then weighted by 31^31 .. 31^0, summed horizontally and
+   * the remaining elements are hashed one at a time.
+   */
+  address generate_vectorizedHashCode(BasicType eltype) {
+    assert(UseVectorizedHashCodeIntrinsic, "need AVX2 instructions");
+    assert(eltype == T_CHAR || eltype == T_BYTE, "unexpected element type");
+    const int elsize = type2aelembytes(eltype);
+
+    __ align(CodeEntryAlignment);
+    StubCodeMark mark(this, "StubRoutines", eltype == T_CHAR ? "charArrayHashCode" : "byteArrayHashCode");
+
+    // Lane weights 31^31 .. 31^0, followed by the main loop multiplier 31^32.
+    address powers = __ pc();
+    juint weights[32];
+    juint power = 1;
+    for (int i = 31; i >= 0; i--) {
+      weights[i] = power;
+      power *= 31;
+    }
+    for (int i = 0; i < 32; i++) {
+      __ emit_int32(weights[i]);
+    }
+    const juint block_multiplier = power;
+
+    address start = __ pc();
+    // Win64: rcx, rdx, r8, r9 (c_rarg0, c_rarg1, ...)
+    // Unix:  rdi, rsi, rdx, rcx, r8, r9 (c_rarg0, c_rarg1, ...)
+    const Register ary    = c_rarg0;  // source array address
+    const Register cnt    = c_rarg1;  // element count
+    const Register result = c_rarg2;  // initial/running hash
+    const Register tmp    = r10;
+    const Register table  = r11;
+    assert_different_registers(ary, cnt, result, tmp, table, rax);
+
+    const XMMRegister vmul = xmm4;
+    const XMMRegister vtmp = xmm5;
+    const XMMRegister vacc[4] = { xmm0, xmm1, xmm2, xmm3 };
+
+    Label L_vector_loop, L_scalar, L_scalar_loop, L_done;
+
+    BLOCK_COMMENT("Entry:");
+    __ enter(); // required for proper stackwalking of RuntimeStub frame
+
+    __ cmpl(cnt, 32);
+    __ jcc(Assembler::less, L_scalar);
+
+    for (int j = 0; j < 4; j++) {
+      __ vpxor(vacc[j], vacc[j], vacc[j], true);
+    }
+    __ movl(tmp, (jint)block_multiplier);
+    __ movdl(vmul, tmp);
+    __ vpbroadcastd(vmul, vmul);
+
+    __ BIND(L_vector_loop);
+    for (int j = 0; j < 4; j++) {
+      if (eltype == T_CHAR) {
+        __ vpmovzxwd(vtmp, Address(ary, j * 8 * elsize));
+      } else {
+        __ vpmovsxbd(vtmp, Address(ary, j * 8 * elsize));
+      }
+      __ vpmulld(vacc[j], vacc[j], vmul, true);
+      __ vpaddd(vacc[j], vacc[j], vtmp, true);
+    }
+    __ imull(result, result, (jint)block_multiplier);
+    __ addptr(ary, 32 * elsize);
+    __ subl(cnt, 32);
+    __ cmpl(cnt, 32);
+    __ jcc(Assembler::greaterEqual, L_vector_loop);
+
+    // Weight each lane by its position in the block and reduce.
+    __ lea(table, InternalAddress(powers));
+    for (int j = 0; j < 4; j++) {
+      __ vpmulld(vacc[j], vacc[j], Address(table, j * 32), true);
+    }
+    __ vpaddd(xmm0, xmm0, xmm1, true);
+    __ vpaddd(xmm2, xmm2, xmm3, true);
+    __ vpaddd(xmm0, xmm0, xmm2, true);
+    __ vextracti128h(xmm1, xmm0);
+    __ vpaddd(xmm0, xmm0, xmm1, false);
+    __ pshufd(xmm1, xmm0, 0x0E);
+    __ paddd(xmm0, xmm1);
+    __ pshufd(xmm1, xmm0, 0x01);
+    __ paddd(xmm0, xmm1);
+    __ movdl(tmp, xmm0);
+    __ addl(result, tmp);
+    __ vzeroupper();
+
+    __ BIND(L_scalar);
+    __ testl(cnt, cnt);
+    __ jcc(Assembler::zero, L_done);
+
+    __ BIND(L_scalar_loop);
+    __ imull(result, result, 31);
+    if (eltype == T_CHAR) {
+      __ load_unsigned_short(tmp, Address(ary, 0));
+    } else {
+      __ load_signed_byte(tmp, Address(ary, 0));
+    }
+    __ addl(result, tmp);
+    __ addptr(ary, elsize);
+    __ decrementl(cnt);
+    __ jcc(Assembler::notZero, L_scalar_loop);
+
+    __ BIND(L_done);
+    __ movl(rax, result);
+    __ leave(); // required for proper stackwalking of RuntimeStub frame
+    __ ret(0);
+
+    return start;
+  }
+
+  /**
+   *  Arguments:
+   *
+   * Inputs:
+   *   c_rarg0   - address of the first byte of a
+   *   c_rarg1   - address of the first byte of b
+   *   c_rarg2   - size_t number of bytes to compare
+   *
+   * Ouput:
+   *       rax   - long offset of the first byte that differs, or -1
+   *
+   * Compares 32 bytes per iteration with AVX2.  The block that contains
+   * the difference, and the remaining tail, are then scanned a word at a
+   * time and the differing byte is located with bsf.
+   */
+  address generate_vectorizedMismatch() {
+    assert(UseVectorizedMismatchIntrinsic, "need AVX2 instructions");
+
+    __ align(CodeEntryAlignment);
+    StubCodeMark mark(this, "StubRoutines", "vectorizedMismatch");
+    address start = __ pc();
+
+    const Register a   = c_rarg0;
+    const Register b   = c_rarg1;
+    const Register len = c_rarg2;
+    const Register idx = r10;
+    const Register tmp = r11;
+    assert_different_registers(a, b, len, idx, tmp, rax);
+
+    Label L_vector_loop, L_words, L_word_loop, L_found_word, L_bytes, L_found_byte, L_none, L_done;
+
+    BLOCK_COMMENT("Entry:");
+    __ enter(); // required for proper stackwalking of RuntimeStub frame
+
+    __ xorq(idx, idx);
+
+    __ BIND(L_vector_loop);
+    __ movq(tmp, len);
+    __ subq(tmp, idx);
+    __ cmpq(tmp, 32);
+    __ jcc(Assembler::less, L_words);
+    __ vmovdqu(xmm0, Address(a, idx, Address::times_1));
+    __ vmovdqu(xmm1, Address(b, idx, Address::times_1));
+    __ vpxor(xmm0, xmm0, xmm1, true);
+    __ vptest(xmm0, xmm0);
+    // The difference is in this block; the word loop finds it.
+    __ jcc(Assembler::notZero, L_words);
+    __ addq(idx, 32);
+    __ jmp(L_vector_loop);
+
+    __ BIND(L_words);
+    __ vzeroupper();
+
+    __ BIND(L_word_loop);
+    __ movq(tmp, len);
+    __ subq(tmp, idx);
+    __ cmpq(tmp, 8);
+    __ jcc(Assembler::less, L_bytes);
+    __ movq(rax, Address(a, idx, Address::times_1));
+    __ xorq(rax, Address(b, idx, Address::times_1));
+    __ jcc(Assembler::notZero, L_found_word);
+    __ addq(idx, 8);
+    __ jmp(L_word_loop);
+
+    __ BIND(L_found_word);
+    // Little endian: the lowest set bit is in the first differing byte.
+    __ bsfq(rax, rax);
+    __ shrq(rax, LogBitsPerByte);
+    __ addq(rax, idx);
+    __ jmp(L_done);
+
+    __ BIND(L_bytes);
+    __ cmpq(idx, len);
+    __ jcc(Assembler::greaterEqual, L_none);
+    __ load_unsigned_byte(rax, Address(a, idx, Address::times_1));
+    __ load_unsigned_byte(tmp, Address(b, idx, Address::times_1));
+    __ cmpl(rax, tmp);
+    __ jcc(Assembler::notEqual, L_found_byte);
+    __ incrementq(idx);
+    __ jmp(L_bytes);
+
+    __ BIND(L_found_byte);
+    __ movq(rax, idx);
+    __ jmp(L_done);
+
+    __ BIND(L_none);
+    __ movptr(rax, -1);
+
+    __ BIND(L_done);
+    __ leave(); // required for proper stackwalking of RuntimeStub frame
+    __ ret(0);
+
+    return start;
+  }
+
   /**
    *  Arguments:
    *
@@ -4077,6 +4785,24 @@ class StubGenerator: public StubCodeGenerator {
       StubRoutines::_cipherBlockChaining_decryptAESCrypt = generate_cipherBlockChaining_decryptAESCrypt_Parallel();
     }
 
+    // Generate GHASH intrinsics code
+    if (UseGHASHIntrinsics) {
+      StubRoutines::x86::_ghash_long_swap_mask_addr = generate_ghash_long_swap_mask();
+      StubRoutines::x86::_ghash_byte_swap_mask_addr = generate_ghash_byte_swap_mask();
+      StubRoutines::_ghash_processBlocks = generate_ghash_processBlocks();
+    }
+
+    if (UseSHA1Intrinsics) {
+      StubRoutines::x86::_sha1_byte_flip_mask_addr = generate_sha1_byte_flip_mask();
+      StubRoutines::_sha1_implCompress     = generate_sha1_implCompress(false,   "sha1_implCompress");
+      StubRoutines::_sha1_implCompressMB   = generate_sha1_implCompress(true,    "sha1_implCompressMB");
+    }
+    if (UseSHA256Intrinsics) {
+      StubRoutines::x86::_sha256_byte_flip_mask_addr = generate_sha256_byte_flip_mask();
+      StubRoutines::_sha256_implCompress   = generate_sha256_implCompress(false, "sha256_implCompress");
+      StubRoutines::_sha256_implCompressMB = generate_sha256_implCompress(true,  "sha256_implCompressMB");
+    }
+
     // Safefetch stubs.
     generate_safefetch("SafeFetch32", sizeof(int),     &StubRoutines::_safefetch32_entry,
                                                        &StubRoutines::_safefetch32_fault_pc,
@@ -4085,6 +4811,13 @@ class StubGenerator: public StubCodeGenerator {
                                                        &StubRoutines::_safefetchN_fault_pc,
                                                        &StubRoutines::_safefetchN_continuation_pc);
 #ifdef COMPILER2
+    if (UseVectorizedHashCodeIntrinsic) {
+      StubRoutines::_charArrayHashCode = generate_vectorizedHashCode(T_CHAR);
+      StubRoutines::_byteArrayHashCode = generate_vectorizedHashCode(T_BYTE);
+    }
+    if (UseVectorizedMismatchIntrinsic) {
+      StubRoutines::_vectorizedMismatch = generate_vectorizedMismatch();
+    }
     if (UseMultiplyToLenIntrinsic) {
       StubRoutines::_multiplyToLen = generate_multiplyToLen();
     }
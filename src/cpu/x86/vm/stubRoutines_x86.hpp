@@ -33,13 +33,26 @@
   static address _verify_mxcsr_entry;
   // shuffle mask for fixing up 128-bit words consisting of big-endian 32-bit integers
   static address _key_shuffle_mask_addr;
+  // byte swap masks for GHASH
+  static address _ghash_long_swap_mask_addr;
+  static address _ghash_byte_swap_mask_addr;
   // masks and table for CRC32
   static uint64_t _crc_by128_masks[];
   static juint    _crc_table[];
+  // round constants for SHA-256
+  static juint    _k256[];
+  // byte flip masks for SHA-1 and SHA-256 message words
+  static address _sha1_byte_flip_mask_addr;
+  static address _sha256_byte_flip_mask_addr;
 
  public:
   static address verify_mxcsr_entry()    { return _verify_mxcsr_entry; }
   static address key_shuffle_mask_addr() { return _key_shuffle_mask_addr; }
+  static address ghash_long_swap_mask_addr() { return _ghash_long_swap_mask_addr; }
+  static address ghash_byte_swap_mask_addr() { return _ghash_byte_swap_mask_addr; }
   static address crc_by128_masks_addr()  { return (address)_crc_by128_masks; }
+  static address k256_addr()             { return (address)_k256; }
+  static address sha1_byte_flip_mask_addr()   { return _sha1_byte_flip_mask_addr; }
+  static address sha256_byte_flip_mask_addr() { return _sha256_byte_flip_mask_addr; }
 
 #endif // CPU_X86_VM_STUBROUTINES_X86_32_HPP
@@ -477,7 +477,7 @@ void TemplateTable::locals_index(Register reg, int offset) {
 void TemplateTable::iload() {
   transition(vtos, itos);
   if (RewriteFrequentPairs) {
-    Label rewrite, done;
+    Label rewrite, not_pair, done;
 
     // get next byte
     __ load_unsigned_byte(rbx, at_bcp(Bytecodes::length_for(Bytecodes::_iload)));
@@ -489,10 +489,17 @@ void TemplateTable::iload() {
     __ jcc(Assembler::equal, done);
 
     __ cmpl(rbx, Bytecodes::_fast_iload);
-    __ movl(rcx, Bytecodes::_fast_iload2);
+    __ jccb(Assembler::notEqual, not_pair);
+
+    // if the pair is followed by _iadd, rewrite to fast_iload2_iadd
+    __ movl(rcx, Bytecodes::_fast_iload2_iadd);
+    __ cmpb(at_bcp(2 * Bytecodes::length_for(Bytecodes::_iload)), Bytecodes::_iadd);
     __ jccb(Assembler::equal, rewrite);
+    __ movl(rcx, Bytecodes::_fast_iload2);
+    __ jmpb(rewrite);
 
     // if _caload, rewrite to fast_icaload
+    __ bind(not_pair);
     __ cmpl(rbx, Bytecodes::_caload);
     __ movl(rcx, Bytecodes::_fast_icaload);
     __ jccb(Assembler::equal, rewrite);
@@ -522,6 +529,14 @@ void TemplateTable::fast_iload2() {
   __ movl(rax, iaddress(rbx));
 }
 
+void TemplateTable::fast_iload2_iadd() {
+  transition(vtos, itos);
+  locals_index(rbx);
+  __ movl(rax, iaddress(rbx));
+  locals_index(rbx, 3);
+  __ addl(rax, iaddress(rbx));
+}
+
 void TemplateTable::fast_iload() {
   transition(vtos, itos);
   locals_index(rbx);
@@ -3125,7 +3140,16 @@ void TemplateTable::invokeinterface(int byte_no) {
   __ null_check(rcx, oopDesc::klass_offset_in_bytes());
   __ load_klass(rdx, rcx);
 
-  Label no_such_interface, no_such_method;
+  Label no_such_interface, no_such_method, subtype_checked;
+
+  // The receiver subtype check is redundant if REFC is the declaring
+  // interface of the method, which it almost always is: the itable scan
+  // for the method below then fails for exactly the same receivers.
+  __ movptr(rsi, Address(rbx, Method::const_offset()));
+  __ movptr(rsi, Address(rsi, ConstMethod::constants_offset()));
+  __ movptr(rsi, Address(rsi, ConstantPool::pool_holder_offset_in_bytes()));
+  __ cmpptr(rax, rsi);
+  __ jcc(Assembler::equal, subtype_checked);
 
   // Receiver subtype check against REFC.
   // Superklass in rax. Subklass in rdx. Blows rcx, rdi.
@@ -3135,6 +3159,7 @@ void TemplateTable::invokeinterface(int byte_no) {
                              rsi, rdi,
                              no_such_interface,
                              /*return_method=*/false);
+  __ bind(subtype_checked);
 
 
   // profile this call
@@ -3307,8 +3332,11 @@ void TemplateTable::_new() {
   // 3) if the above fails (or is not applicable), go to a slow case
   // (creates a new TLAB, etc.)
 
+  // With heap sampling the end of the TLAB may have been lowered; the
+  // allocation crossing it must reach the runtime rather than eden.
   const bool allow_shared_alloc =
-    Universe::heap()->supports_inline_contig_alloc() && !CMSIncrementalMode;
+    Universe::heap()->supports_inline_contig_alloc() && !CMSIncrementalMode &&
+    !ThreadHeapSampler::enabled();
 
   const Register thread = rcx;
   if (UseTLAB || allow_shared_alloc) {
@@ -491,7 +491,7 @@ void TemplateTable::locals_index(Register reg, int offset) {
 void TemplateTable::iload() {
   transition(vtos, itos);
   if (RewriteFrequentPairs) {
-    Label rewrite, done;
+    Label rewrite, not_pair, done;
     const Register bc = c_rarg3;
     assert(rbx != bc, "register damaged");
 
@@ -506,10 +506,17 @@ void TemplateTable::iload() {
     __ jcc(Assembler::equal, done);
 
     __ cmpl(rbx, Bytecodes::_fast_iload);
-    __ movl(bc, Bytecodes::_fast_iload2);
+    __ jccb(Assembler::notEqual, not_pair);
+
+    // if the pair is followed by _iadd, rewrite to fast_iload2_iadd
+    __ movl(bc, Bytecodes::_fast_iload2_iadd);
+    __ cmpb(at_bcp(2 * Bytecodes::length_for(Bytecodes::_iload)), Bytecodes::_iadd);
     __ jccb(Assembler::equal, rewrite);
+    __ movl(bc, Bytecodes::_fast_iload2);
+    __ jmpb(rewrite);
 
     // if _caload, rewrite to fast_icaload
+    __ bind(not_pair);
     __ cmpl(rbx, Bytecodes::_caload);
     __ movl(bc, Bytecodes::_fast_icaload);
     __ jccb(Assembler::equal, rewrite);
@@ -538,6 +545,14 @@ void TemplateTable::fast_iload2() {
   __ movl(rax, iaddress(rbx));
 }
 
+void TemplateTable::fast_iload2_iadd() {
+  transition(vtos, itos);
+  locals_index(rbx);
+  __ movl(rax, iaddress(rbx));
+  locals_index(rbx, 3);
+  __ addl(rax, iaddress(rbx));
+}
+
 void TemplateTable::fast_iload() {
   transition(vtos, itos);
   locals_index(rbx);
@@ -3176,7 +3191,16 @@ void TemplateTable::invokeinterface(int byte_no) {
   __ null_check(rcx, oopDesc::klass_offset_in_bytes());
   __ load_klass(rdx, rcx);
 
-  Label no_such_interface, no_such_method;
+  Label no_such_interface, no_such_method, subtype_checked;
+
+  // The receiver subtype check is redundant if REFC is the declaring
+  // interface of the method, which it almost always is: the itable scan
+  // for the method below then fails for exactly the same receivers.
+  __ movptr(r13, Address(rbx, Method::const_offset()));
+  __ movptr(r13, Address(r13, ConstMethod::constants_offset()));
+  __ movptr(r13, Address(r13, ConstantPool::pool_holder_offset_in_bytes()));
+  __ cmpptr(rax, r13);
+  __ jcc(Assembler::equal, subtype_checked);
 
   // Receiver subtype check against REFC.
   // Superklass in rax. Subklass in rdx. Blows rcx, rdi.
@@ -3186,6 +3210,7 @@ void TemplateTable::invokeinterface(int byte_no) {
                              r13, r14,
                              no_such_interface,
                              /*return_method=*/false);
+  __ bind(subtype_checked);
 
   // profile this call
   __ restore_bcp(); // rbcp was destroyed by receiver type check
@@ -3361,8 +3386,11 @@ void TemplateTable::_new() {
   // 3) if the above fails (or is not applicable), go to a slow case
   // (creates a new TLAB, etc.)
 
+  // With heap sampling the end of the TLAB may have been lowered; the
+  // allocation crossing it must reach the runtime rather than eden.
   const bool allow_shared_alloc =
-    Universe::heap()->supports_inline_contig_alloc() && !CMSIncrementalMode;
+    Universe::heap()->supports_inline_contig_alloc() && !CMSIncrementalMode &&
+    !ThreadHeapSampler::enabled();
 
   if (UseTLAB) {
     __ movptr(rax, Address(r15_thread, in_bytes(JavaThread::tlab_top_offset())));
@@ -481,6 +481,14 @@ void VM_Version::get_processor_features() {
   if (UseSSE < 1)
     _cpuFeatures &= ~CPU_SSE;
 
+  if (UseAVX < 3) {
+    _cpuFeatures &= ~CPU_AVX512F;
+    _cpuFeatures &= ~CPU_AVX512CD;
+    _cpuFeatures &= ~CPU_AVX512DQ;
+    _cpuFeatures &= ~CPU_AVX512BW;
+    _cpuFeatures &= ~CPU_AVX512VL;
+  }
+
   if (UseAVX < 2)
     _cpuFeatures &= ~CPU_AVX2;
 
@@ -495,8 +503,8 @@ void VM_Version::get_processor_features() {
     _cpuFeatures &= ~CPU_HT;
   }
 
-  char buf[256];
-  jio_snprintf(buf, sizeof(buf), "(%u cores per cpu, %u threads per core) family %d model %d stepping %d%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s",
+  char buf[512];
+  jio_snprintf(buf, sizeof(buf), "(%u cores per cpu, %u threads per core) family %d model %d stepping %d%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s%s",
                cores_per_cpu(), threads_per_core(),
                cpu_family(), _model, _stepping,
                (supports_cmov() ? ", cmov" : ""),
@@ -512,6 +520,11 @@ void VM_Version::get_processor_features() {
                (supports_popcnt() ? ", popcnt" : ""),
                (supports_avx()    ? ", avx" : ""),
                (supports_avx2()   ? ", avx2" : ""),
+               (supports_evex()   ? ", avx512f" : ""),
+               (supports_avx512cd() ? ", avx512cd" : ""),
+               (supports_avx512dq() ? ", avx512dq" : ""),
+               (supports_avx512bw() ? ", avx512bw" : ""),
+               (supports_avx512vl() ? ", avx512vl" : ""),
                (supports_aes()    ? ", aes" : ""),
                (supports_clmul()  ? ", clmul" : ""),
                (supports_erms()   ? ", erms" : ""),
@@ -526,7 +539,8 @@ void VM_Version::get_processor_features() {
                (supports_tscinv() ? ", tscinv": ""),
                (supports_bmi1() ? ", bmi1" : ""),
                (supports_bmi2() ? ", bmi2" : ""),
-               (supports_adx() ? ", adx" : ""));
+               (supports_adx() ? ", adx" : ""),
+               (supports_sha() ? ", sha" : ""));
   _features_str = strdup(buf);
 
   // UseSSE is set to the smaller of what hardware supports and what
@@ -543,8 +557,12 @@ void VM_Version::get_processor_features() {
   if (!supports_sse ()) // Drop to 0 if no SSE  support
     UseSSE = 0;
 
-  if (UseAVX > 2) UseAVX=2;
+  if (UseAVX > 3) UseAVX=3;
   if (UseAVX < 0) UseAVX=0;
+  // 512bit instructions lower the clock of the whole core on current
+  // parts, so they are only used when asked for explicitly.
+  if (FLAG_IS_DEFAULT(UseAVX) || !supports_evex()) // Drop to 2 if no AVX512 support
+    UseAVX = MIN2((intx)2,UseAVX);
   if (!supports_avx2()) // Drop to 1 if no AVX2 support
     UseAVX = MIN2((intx)1,UseAVX);
   if (!supports_avx ()) // Drop to 0 if no AVX  support
@@ -582,6 +600,35 @@ void VM_Version::get_processor_features() {
     FLAG_SET_DEFAULT(UseCRC32Intrinsics, false);
   }
 
+  // Adler32 is computed by a portable leaf routine, so it needs no
+  // particular CPU features.
+  if (FLAG_IS_DEFAULT(UseAdler32Intrinsics)) {
+    UseAdler32Intrinsics = true;
+  }
+
+  // The vectorized hashCode stubs use 256-bit integer multiplies and
+  // are only generated for x86_64.
+  if (LP64_ONLY(supports_avx2()) NOT_LP64(false)) {
+    if (FLAG_IS_DEFAULT(UseVectorizedHashCodeIntrinsic)) {
+      UseVectorizedHashCodeIntrinsic = true;
+    }
+  } else if (UseVectorizedHashCodeIntrinsic) {
+    if (!FLAG_IS_DEFAULT(UseVectorizedHashCodeIntrinsic))
+      warning("Vectorized hashCode intrinsic requires AVX2 instructions (not available on this CPU)");
+    FLAG_SET_DEFAULT(UseVectorizedHashCodeIntrinsic, false);
+  }
+
+  // Likewise the mismatch stub is only generated for x86_64.
+  if (LP64_ONLY(supports_avx2()) NOT_LP64(false)) {
+    if (FLAG_IS_DEFAULT(UseVectorizedMismatchIntrinsic)) {
+      UseVectorizedMismatchIntrinsic = true;
+    }
+  } else if (UseVectorizedMismatchIntrinsic) {
+    if (!FLAG_IS_DEFAULT(UseVectorizedMismatchIntrinsic))
+      warning("Vectorized mismatch intrinsic requires AVX2 instructions (not available on this CPU)");
+    FLAG_SET_DEFAULT(UseVectorizedMismatchIntrinsic, false);
+  }
+
   // The AES intrinsic stubs require AES instruction support (of course)
   // but also require sse3 mode for instructions it use.
   if (UseAES && (UseSSE > 2)) {
@@ -594,17 +641,54 @@ void VM_Version::get_processor_features() {
     FLAG_SET_DEFAULT(UseAESIntrinsics, false);
   }
 
-  if (UseSHA) {
+  // GHASH/GCM intrinsics; the stub is only generated on x86_64.
+  if (LP64_ONLY(UseCLMUL && (UseSSE > 2)) NOT_LP64(false)) {
+    if (FLAG_IS_DEFAULT(UseGHASHIntrinsics)) {
+      UseGHASHIntrinsics = true;
+    }
+  } else if (UseGHASHIntrinsics) {
+    if (!FLAG_IS_DEFAULT(UseGHASHIntrinsics))
+      warning("GHASH intrinsic requires CLMUL and SSE2 instructions on this CPU");
+    FLAG_SET_DEFAULT(UseGHASHIntrinsics, false);
+  }
+
+  // The SHA stubs use the SHA extensions together with SSE4.1 shuffles
+  // and are only generated on x86_64.
+  bool supports_sha_stubs = LP64_ONLY(supports_sha() && supports_sse4_1()) NOT_LP64(false);
+  if (supports_sha_stubs) {
+    if (FLAG_IS_DEFAULT(UseSHA)) {
+      UseSHA = true;
+    }
+  } else if (UseSHA) {
     warning("SHA instructions are not available on this CPU");
     FLAG_SET_DEFAULT(UseSHA, false);
   }
-  if (UseSHA1Intrinsics || UseSHA256Intrinsics || UseSHA512Intrinsics) {
-    warning("SHA intrinsics are not available on this CPU");
+
+  if (UseSHA) {
+    if (FLAG_IS_DEFAULT(UseSHA1Intrinsics)) {
+      FLAG_SET_DEFAULT(UseSHA1Intrinsics, true);
+    }
+    if (FLAG_IS_DEFAULT(UseSHA256Intrinsics)) {
+      FLAG_SET_DEFAULT(UseSHA256Intrinsics, true);
+    }
+  } else if (UseSHA1Intrinsics || UseSHA256Intrinsics) {
+    if (!supports_sha_stubs) {
+      warning("SHA intrinsics are not available on this CPU");
+    }
     FLAG_SET_DEFAULT(UseSHA1Intrinsics, false);
     FLAG_SET_DEFAULT(UseSHA256Intrinsics, false);
+  }
+
+  // There are no SHA-512 instructions on x86.
+  if (UseSHA512Intrinsics) {
+    warning("SHA intrinsics are not available on this CPU");
     FLAG_SET_DEFAULT(UseSHA512Intrinsics, false);
   }
 
+  if (!(UseSHA1Intrinsics || UseSHA256Intrinsics || UseSHA512Intrinsics)) {
+    FLAG_SET_DEFAULT(UseSHA, false);
+  }
+
   // Adjust RTM (Restricted Transactional Memory) flags
   if (!supports_rtm() && UseRTMLocking) {
     // Can't continue because UseRTMLocking affects UseBiasedLocking flag
@@ -530,14 +530,14 @@ int CppInterpreter::accessor_entry(Method* method, intptr_t UNUSED, TRAPS) {
 
   // Read the field index from the bytecode, which looks like this:
   //  0:  aload_0
-  //  1:  getfield
+  //  1:  getfield (or the _fast_Xgetfield it was quickened to)
   //  2:    index
   //  3:    index
   //  4:  ireturn/areturn
   // NB this is not raw bytecode: index is in machine order
   u1 *code = method->code_base();
   assert(code[0] == Bytecodes::_aload_0 &&
-         code[1] == Bytecodes::_getfield &&
+         Bytecodes::java_code((Bytecodes::Code) code[1]) == Bytecodes::_getfield &&
          (code[4] == Bytecodes::_ireturn ||
           code[4] == Bytecodes::_areturn), "should do");
   u2 index = Bytes::get_native_u2(&code[2]);
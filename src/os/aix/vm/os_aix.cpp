@@ -2213,6 +2213,11 @@ bool os::pd_uncommit_memory(char* addr, size_t size) {
   return rc;
 }
 
+bool os::resident_memory_size(char* addr, size_t bytes, size_t* resident) {
+  // Not implemented
+  return false;
+}
+
 bool os::pd_create_stack_guard_pages(char* addr, size_t size) {
   return os::guard_memory(addr, size);
 }
@@ -2759,6 +2764,10 @@ bool os::can_execute_large_page_memory() {
   return true;
 }
 
+size_t os::code_cache_large_page_size() {
+  return 0;
+}
+
 // Reserve memory at an arbitrary address, only if that area is
 // available (and not reserved for something else).
 char* os::pd_attempt_reserve_memory_at(size_t bytes, char* requested_addr) {
@@ -2263,6 +2263,11 @@ bool os::pd_uncommit_memory(char* addr, size_t size) {
 #endif
 }
 
+bool os::resident_memory_size(char* addr, size_t bytes, size_t* resident) {
+  // Not implemented
+  return false;
+}
+
 bool os::pd_create_stack_guard_pages(char* addr, size_t size) {
   return os::commit_memory(addr, size, !ExecMem);
 }
@@ -2471,6 +2476,10 @@ bool os::can_execute_large_page_memory() {
   return UseHugeTLBFS;
 }
 
+size_t os::code_cache_large_page_size() {
+  return 0;
+}
+
 // Reserve memory at an arbitrary address, only if that area is
 // available (and not reserved for something else).
 
@@ -43,6 +43,33 @@
   product(bool, UseTransparentHugePages, false,                         \
           "Use MADV_HUGEPAGE for large pages")                          \
                                                                         \
+  product(bool, UseTransparentHugePagesForCodeCache, false,             \
+          "Use MADV_HUGEPAGE for the code cache, independently of "     \
+          "UseLargePages and the Java heap")                            \
+                                                                        \
+  product(bool, TransparentHugePagesOnlyForLargeSpaces, false,          \
+          "With UseTransparentHugePages and transparent huge pages "    \
+          "enabled always, back only the spaces committed in huge "     \
+          "pages, like the heap and card table, with huge pages; "      \
+          "small or volatile data, like the metaspace, is advised "     \
+          "MADV_NOHUGEPAGE")                                            \
+                                                                        \
+  product(uintx, ThreadStackCacheSize, 0,                               \
+          "Number of stacks of exited Java threads kept for reuse by "  \
+          "new Java threads; 0 disables the cache")                     \
+                                                                        \
+  product(bool, UseFutexParker, false,                                  \
+          "Implement LockSupport.park/unpark with a futex and an "      \
+          "atomic permit word rather than a mutex and condvar")         \
+                                                                        \
+  product(intx, FutexParkerSpinLimit, 1000,                             \
+          "Maximum number of spins for a permit before a futex parker " \
+          "blocks; adapted per thread to how often spinning succeeds")  \
+                                                                        \
+  diagnostic(bool, PrintParkerStatistics, false,                        \
+          "Print the park/unpark counters of each thread in thread "    \
+          "dumps when UseFutexParker is on")                            \
+                                                                        \
   product(bool, LoadExecStackDllInVMThread, true,                       \
           "Load DLLs with executable-stack attribute in the VM Thread") \
                                                                         \
@@ -55,7 +82,12 @@
   product(bool, PreferContainerQuotaForCPUCount, true,                  \
           "Calculate the container CPU availability based on the value" \
           " of quotas (if set), when true. Otherwise, use the CPU"      \
-          " shares value, provided it is less than quota.")
+          " shares value, provided it is less than quota.")             \
+                                                                        \
+  product(uintx, ContainerLimitsCacheTimeout, 20,                       \
+          "Milliseconds the container CPU and memory limits are cached "\
+          "before they are read again, so that changes to the limits of"\
+          " a running container are seen")
 
 //
 // Defines Linux-specific default values. The flags are available on all
@@ -34,8 +34,16 @@
 
 bool  OSContainer::_is_initialized   = false;
 bool  OSContainer::_is_containerized = false;
+volatile int   OSContainer::_cached_cpu_count    = 0;
+volatile jlong OSContainer::_cpu_count_expiry    = 0;
+volatile jlong OSContainer::_cached_memory_limit = 0;
+volatile jlong OSContainer::_memory_limit_expiry = 0;
 julong _unlimited_memory;
 
+// With cgroup v2 all controllers share one hierarchy, and the memory,
+// cpuset, cpu and cpuacct subsystems below are the same object.
+static bool cgroup_v2 = false;
+
 class CgroupSubsystem: CHeapObj<mtInternal> {
  friend class OSContainer;
 
@@ -208,6 +216,44 @@ PRAGMA_DIAG_POP
     tty->print_cr(logstring, variable);                                   \
 }
 
+/* read_v2_limit
+ *
+ * Read a cgroup v2 file holding a number, or "max" for no limit,
+ * optionally as the n-th of the space separated fields on its line.
+ *
+ * return:
+ *    the number
+ *    -1 for "max"
+ *    OSCONTAINER_ERROR for not supported
+ */
+static jlong read_v2_limit(const char* filename, int field = 0) {
+  char line[1024];
+  if (subsystem_file_contents(memory, filename, "%1023[^\n]", line) != 0) {
+    return OSCONTAINER_ERROR;
+  }
+  char* value = line;
+  for (int i = 0; i < field && value != NULL; i++) {
+    value = strchr(value, ' ');
+    if (value != NULL) {
+      value++;
+    }
+  }
+  if (value == NULL) {
+    return OSCONTAINER_ERROR;
+  }
+  if (strncmp(value, "max", 3) == 0) {
+    return -1;
+  }
+  jlong result;
+  if (sscanf(value, JLONG_FORMAT, &result) != 1) {
+    return OSCONTAINER_ERROR;
+  }
+  if (PrintContainerInfo) {
+    tty->print_cr("%s is: " JLONG_FORMAT, filename, result);
+  }
+  return result;
+}
+
 /* init
  *
  * Initialize the container support and determine if
@@ -263,12 +309,30 @@ void OSContainer::init() {
       return;
   }
 
+  CgroupSubsystem* unified = NULL;
   while ( (p = fgets(buf, MAXPATHLEN, mntinfo)) != NULL) {
     // Look for the filesystem type and see if it's cgroup
     char fstype[MAXPATHLEN+1];
     fstype[0] = '\0';
     char *s =  strstr(p, " - ");
     if (s != NULL &&
+        sscanf(s, " - %s", fstype) == 1 &&
+        strcmp(fstype, "cgroup2") == 0) {
+      /*
+       * Example for cgroup v2:
+       * 33 25 0:28 / /sys/fs/cgroup rw,nosuid,nodev,noexec,relatime shared:9 - cgroup2 cgroup2 rw
+       */
+      int matched = sscanf(p, "%d %d %d:%d %s %s",
+                           &mountid,
+                           &parentid,
+                           &major,
+                           &minor,
+                           tmproot,
+                           tmpmount);
+      if (matched == 6 && unified == NULL) {
+        unified = new CgroupSubsystem(tmproot, tmpmount);
+      }
+    } else if (s != NULL &&
         sscanf(s, " - %s", fstype) == 1 &&
         strcmp(fstype, "cgroup") == 0) {
 
@@ -358,6 +422,15 @@ void OSContainer::init() {
 
   fclose(mntinfo);
 
+  // Hybrid hierarchies with the v1 memory controller are used as v1.
+  if (memory == NULL && unified != NULL) {
+    if (PrintContainerInfo) {
+      tty->print_cr("Using cgroup v2 unified hierarchy at %s", unified->_mount_point);
+    }
+    cgroup_v2 = true;
+    memory = cpuset = cpu = cpuacct = unified;
+  }
+
   if (memory == NULL) {
     if (PrintContainerInfo) {
       tty->print_cr("Required cgroup memory subsystem not found");
@@ -390,6 +463,9 @@ void OSContainer::init() {
    * Docker example:
    * 5:memory:/docker/6558aed8fc662b194323ceab5b964f69cf36b3e8af877a14b80256e93aecb044
    *
+   * cgroup v2 example, with no controller list:
+   * 0::/system.slice/docker-7208cebd00fa.scope
+   *
    * Host example:
    * 5:memory:/user.slice
    *
@@ -427,7 +503,11 @@ void OSContainer::init() {
     controller = strsep(&p, ":");
     base = strsep(&p, "\n");
 
-    if (controller != NULL) {
+    if (controller != NULL && cgroup_v2) {
+      if (controller[0] == '\0') {
+        memory->set_subsystem_path(base);
+      }
+    } else if (controller != NULL) {
       if (strstr(controller, "memory") != NULL) {
         memory->set_subsystem_path(base);
       } else if (strstr(controller, "cpuset") != NULL) {
@@ -457,7 +537,7 @@ void OSContainer::init() {
 
 const char * OSContainer::container_type() {
   if (is_containerized()) {
-    return "cgroupv1";
+    return cgroup_v2 ? "cgroupv2" : "cgroupv1";
   } else {
     return NULL;
   }
@@ -474,6 +554,23 @@ const char * OSContainer::container_type() {
  *    OSCONTAINER_ERROR for not supported
  */
 jlong OSContainer::memory_limit_in_bytes() {
+  jlong now = os::javaTimeNanos();
+  if (now - _memory_limit_expiry >= 0) {
+    jlong limit = read_memory_limit_in_bytes();
+    if (PrintContainerInfo && _memory_limit_expiry != 0 && limit != _cached_memory_limit) {
+      tty->print_cr("Memory Limit changed from " JLONG_FORMAT " to " JLONG_FORMAT,
+                    _cached_memory_limit, limit);
+    }
+    _cached_memory_limit = limit;
+    _memory_limit_expiry = now + (jlong)ContainerLimitsCacheTimeout * NANOSECS_PER_MILLISEC;
+  }
+  return _cached_memory_limit;
+}
+
+jlong OSContainer::read_memory_limit_in_bytes() {
+  if (cgroup_v2) {
+    return read_v2_limit("/memory.max");
+  }
   GET_CONTAINER_INFO(julong, memory, "/memory.limit_in_bytes",
                      "Memory Limit is: " JULONG_FORMAT, JULONG_FORMAT, memlimit);
 
@@ -489,6 +586,16 @@ jlong OSContainer::memory_limit_in_bytes() {
 }
 
 jlong OSContainer::memory_and_swap_limit_in_bytes() {
+  if (cgroup_v2) {
+    // memory.swap.max limits the swap alone; it is missing without
+    // swap accounting, in which case no swap can be used.
+    jlong mem_limit = read_v2_limit("/memory.max");
+    jlong swap_limit = read_v2_limit("/memory.swap.max");
+    if (mem_limit < 0 || swap_limit == -1) {
+      return mem_limit == OSCONTAINER_ERROR ? OSCONTAINER_ERROR : -1;
+    }
+    return swap_limit == OSCONTAINER_ERROR ? mem_limit : mem_limit + swap_limit;
+  }
   GET_CONTAINER_INFO(julong, memory, "/memory.memsw.limit_in_bytes",
                      "Memory and Swap Limit is: " JULONG_FORMAT, JULONG_FORMAT, memswlimit);
   if (memswlimit >= _unlimited_memory) {
@@ -502,6 +609,9 @@ jlong OSContainer::memory_and_swap_limit_in_bytes() {
 }
 
 jlong OSContainer::memory_soft_limit_in_bytes() {
+  if (cgroup_v2) {
+    return read_v2_limit("/memory.low");
+  }
   GET_CONTAINER_INFO(julong, memory, "/memory.soft_limit_in_bytes",
                      "Memory Soft Limit is: " JULONG_FORMAT, JULONG_FORMAT, memsoftlimit);
   if (memsoftlimit >= _unlimited_memory) {
@@ -524,6 +634,9 @@ jlong OSContainer::memory_soft_limit_in_bytes() {
  *    OSCONTAINER_ERROR for not supported
  */
 jlong OSContainer::memory_usage_in_bytes() {
+  if (cgroup_v2) {
+    return read_v2_limit("/memory.current");
+  }
   GET_CONTAINER_INFO(jlong, memory, "/memory.usage_in_bytes",
                      "Memory Usage is: " JLONG_FORMAT, JLONG_FORMAT, memusage);
   return memusage;
@@ -538,6 +651,10 @@ jlong OSContainer::memory_usage_in_bytes() {
  *    OSCONTAINER_ERROR for not supported
  */
 jlong OSContainer::memory_max_usage_in_bytes() {
+  if (cgroup_v2) {
+    // Only kernels from 5.19 have memory.peak.
+    return read_v2_limit("/memory.peak");
+  }
   GET_CONTAINER_INFO(jlong, memory, "/memory.max_usage_in_bytes",
                      "Maximum Memory Usage is: " JLONG_FORMAT, JLONG_FORMAT, memmaxusage);
   return memmaxusage;
@@ -580,6 +697,19 @@ jlong OSContainer::memory_max_usage_in_bytes() {
  *    number of CPUs
  */
 int OSContainer::active_processor_count() {
+  jlong now = os::javaTimeNanos();
+  if (now - _cpu_count_expiry >= 0) {
+    int count = read_active_processor_count();
+    if (PrintContainerInfo && _cpu_count_expiry != 0 && count != _cached_cpu_count) {
+      tty->print_cr("Active processor count changed from %d to %d", _cached_cpu_count, count);
+    }
+    _cached_cpu_count = count;
+    _cpu_count_expiry = now + (jlong)ContainerLimitsCacheTimeout * NANOSECS_PER_MILLISEC;
+  }
+  return _cached_cpu_count;
+}
+
+int OSContainer::read_active_processor_count() {
   int quota_count = 0, share_count = 0;
   int cpu_count, limit_count;
   int result;
@@ -626,13 +756,15 @@ int OSContainer::active_processor_count() {
 }
 
 char * OSContainer::cpu_cpuset_cpus() {
-  GET_CONTAINER_INFO_CPTR(cptr, cpuset, "/cpuset.cpus",
+  const char* filename = cgroup_v2 ? "/cpuset.cpus.effective" : "/cpuset.cpus";
+  GET_CONTAINER_INFO_CPTR(cptr, cpuset, filename,
                      "cpuset.cpus is: %s", "%1023s", cpus, 1024);
   return os::strdup(cpus);
 }
 
 char * OSContainer::cpu_cpuset_memory_nodes() {
-  GET_CONTAINER_INFO_CPTR(cptr, cpuset, "/cpuset.mems",
+  const char* filename = cgroup_v2 ? "/cpuset.mems.effective" : "/cpuset.mems";
+  GET_CONTAINER_INFO_CPTR(cptr, cpuset, filename,
                      "cpuset.mems is: %s", "%1023s", mems, 1024);
   return os::strdup(mems);
 }
@@ -648,12 +780,19 @@ char * OSContainer::cpu_cpuset_memory_nodes() {
  *    OSCONTAINER_ERROR for not supported
  */
 int OSContainer::cpu_quota() {
+  if (cgroup_v2) {
+    // cpu.max is "$MAX $PERIOD", with "max" for no quota
+    return (int)read_v2_limit("/cpu.max");
+  }
   GET_CONTAINER_INFO(int, cpu, "/cpu.cfs_quota_us",
                      "CPU Quota is: %d", "%d", quota);
   return quota;
 }
 
 int OSContainer::cpu_period() {
+  if (cgroup_v2) {
+    return (int)read_v2_limit("/cpu.max", 1);
+  }
   GET_CONTAINER_INFO(int, cpu, "/cpu.cfs_period_us",
                      "CPU Period is: %d", "%d", period);
   return period;
@@ -670,6 +809,17 @@ int OSContainer::cpu_period() {
  *    OSCONTAINER_ERROR for not supported
  */
 int OSContainer::cpu_shares() {
+  if (cgroup_v2) {
+    jlong weight = read_v2_limit("/cpu.weight");
+    if (weight < 0) {
+      return (int)weight;
+    }
+    // Convert 100, the default, to no shares setup
+    if (weight == 100) return -1;
+    // Invert the mapping of shares [2..262144] to weights [1..10000]
+    // used by container runtimes.
+    return (int)(2 + (262142 * (weight - 1)) / 9999);
+  }
   GET_CONTAINER_INFO(int, cpu, "/cpu.shares",
                      "CPU Shares is: %d", "%d", shares);
   // Convert 1024 to no shares setup
@@ -37,6 +37,16 @@ class OSContainer: AllStatic {
   static bool   _is_initialized;
   static bool   _is_containerized;
 
+  // The CPU count and memory limit are read at most once per
+  // ContainerLimitsCacheTimeout, as ergonomics query them at every GC.
+  static volatile int   _cached_cpu_count;
+  static volatile jlong _cpu_count_expiry;
+  static volatile jlong _cached_memory_limit;
+  static volatile jlong _memory_limit_expiry;
+
+  static int   read_active_processor_count();
+  static jlong read_memory_limit_in_bytes();
+
  public:
   static void init();
   static inline bool is_containerized();
@@ -36,6 +36,8 @@ void OSThread::pd_initialize() {
   _ucontext = NULL;
   _expanding_stack = 0;
   _alt_sig_stack = NULL;
+  _cached_stack = NULL;
+  _thread_cpu_clockid = 0;
 
   sigemptyset(&_caller_sigmask);
 
@@ -97,6 +97,8 @@ private:
   ucontext_t* _ucontext;
   int _expanding_stack;                 /* non zero if manually expanding stack */
   address _alt_sig_stack;               /* address of base of alternate signal stack */
+  void* _cached_stack;                  /* ThreadStackCache entry of the thread's stack */
+  clockid_t _thread_cpu_clockid;        /* CPU clock id of the thread, 0 if not looked up yet */
 
 public:
   void* siginfo() const                   { return _siginfo;  }
@@ -110,6 +112,12 @@ public:
   void set_alt_sig_stack(address val)     { _alt_sig_stack = val; }
   address alt_sig_stack(void)             { return _alt_sig_stack; }
 
+  void set_cached_stack(void* val)        { _cached_stack = val; }
+  void* cached_stack(void)                { return _cached_stack; }
+
+  void set_thread_cpu_clockid(clockid_t val) { _thread_cpu_clockid = val; }
+  clockid_t thread_cpu_clockid(void) const   { return _thread_cpu_clockid; }
+
 private:
   Monitor* _startThread_lock;     // sync parent and child in thread creation
 
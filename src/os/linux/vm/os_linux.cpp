@@ -786,6 +786,108 @@ static bool _thread_safety_check(Thread* thread) {
   }
 }
 
+#ifndef MAP_STACK
+#define MAP_STACK 0
+#endif
+
+// Keeps the stacks of exited Java threads for reuse by new Java threads
+// when ThreadStackCacheSize is set, so that thread creation does not have
+// to map a new stack. A stack may only be handed out again once the thread
+// that ran on it has terminated, so threads with a cached stack are
+// created joinable and are joined when their stack is reused or evicted.
+// The entries are managed with ::malloc and a pthread mutex because
+// release() runs after the Thread has been deleted.
+class ThreadStackCache : AllStatic {
+ public:
+  struct Entry {
+    address   _base;
+    size_t    _size;
+    pthread_t _tid;
+    Entry*    _next;
+  };
+
+ private:
+  static pthread_mutex_t _lock;
+  static Entry*          _head;
+  static uintx           _count;
+
+  // Wait for the previous owner of the stack to terminate, then unmap it.
+  static void reclaim(Entry* e) {
+    pthread_join(e->_tid, NULL);
+    destroy(e);
+  }
+
+ public:
+  // Return a stack of the given size, reusing a cached one when possible.
+  static Entry* allocate(size_t size) {
+    Entry* e = NULL;
+    pthread_mutex_lock(&_lock);
+    for (Entry** p = &_head; *p != NULL; p = &(*p)->_next) {
+      if ((*p)->_size == size) {
+        e = *p;
+        *p = e->_next;
+        _count--;
+        break;
+      }
+    }
+    pthread_mutex_unlock(&_lock);
+
+    if (e != NULL) {
+      pthread_join(e->_tid, NULL);
+      return e;
+    }
+
+    e = (Entry*)::malloc(sizeof(Entry));
+    if (e == NULL) {
+      return NULL;
+    }
+    void* base = ::mmap(NULL, size, PROT_READ|PROT_WRITE,
+                        MAP_PRIVATE|MAP_ANONYMOUS|MAP_STACK, -1, 0);
+    if (base == MAP_FAILED) {
+      ::free(e);
+      return NULL;
+    }
+    e->_base = (address)base;
+    e->_size = size;
+    e->_next = NULL;
+    return e;
+  }
+
+  // Unmap a stack that has no thread running on it.
+  static void destroy(Entry* e) {
+    ::munmap(e->_base, e->_size);
+    ::free(e);
+  }
+
+  // Called by the owning thread as the very last thing before it
+  // terminates. Evicts the oldest entry if the cache is full.
+  static void release(Entry* e) {
+    Entry* evicted = NULL;
+    e->_tid = pthread_self();
+    pthread_mutex_lock(&_lock);
+    e->_next = _head;
+    _head = e;
+    if (++_count > ThreadStackCacheSize) {
+      Entry** p = &_head->_next;
+      while ((*p)->_next != NULL) {
+        p = &(*p)->_next;
+      }
+      evicted = *p;
+      *p = NULL;
+      _count--;
+    }
+    pthread_mutex_unlock(&_lock);
+
+    if (evicted != NULL) {
+      reclaim(evicted);
+    }
+  }
+};
+
+pthread_mutex_t          ThreadStackCache::_lock  = PTHREAD_MUTEX_INITIALIZER;
+ThreadStackCache::Entry* ThreadStackCache::_head  = NULL;
+uintx                    ThreadStackCache::_count = 0;
+
 // Thread start routine for all newly created threads
 static void *java_start(Thread *thread) {
   // Try to randomize the cache line index of hot stack frames.
@@ -840,9 +942,16 @@ static void *java_start(Thread *thread) {
     }
   }
 
+  // The OSThread is gone once run() returns.
+  ThreadStackCache::Entry* cached_stack = (ThreadStackCache::Entry*)osthread->cached_stack();
+
   // call one more level start routine
   thread->run();
 
+  if (cached_stack != NULL) {
+    ThreadStackCache::release(cached_stack);
+  }
+
   return 0;
 }
 
@@ -897,7 +1006,20 @@ bool os::create_thread(Thread* thread, ThreadType thr_type, size_t stack_size) {
     }
 
     stack_size = MAX2(stack_size, os::Linux::min_stack_allowed);
-    pthread_attr_setstacksize(&attr, stack_size);
+
+    ThreadStackCache::Entry* cached_stack = NULL;
+    if (thr_type == os::java_thread && ThreadStackCacheSize > 0 &&
+        !os::Linux::is_LinuxThreads()) {
+      // Java threads need no glibc guard page, see default_guard_size().
+      cached_stack = ThreadStackCache::allocate(align_size_up(stack_size, os::vm_page_size()));
+    }
+    if (cached_stack != NULL) {
+      osthread->set_cached_stack(cached_stack);
+      pthread_attr_setdetachstate(&attr, PTHREAD_CREATE_JOINABLE);
+      pthread_attr_setstack(&attr, cached_stack->_base, cached_stack->_size);
+    } else {
+      pthread_attr_setstacksize(&attr, stack_size);
+    }
   } else {
     // let pthread_create() pick the default value.
   }
@@ -924,6 +1046,9 @@ bool os::create_thread(Thread* thread, ThreadType thr_type, size_t stack_size) {
         perror("pthread_create()");
       }
       // Need to clean up stuff we've allocated so far
+      if (osthread->cached_stack() != NULL) {
+        ThreadStackCache::destroy((ThreadStackCache::Entry*)osthread->cached_stack());
+      }
       thread->set_osthread(NULL);
       delete osthread;
       if (lock) os::Linux::createThread_lock()->unlock();
@@ -1377,6 +1502,22 @@ jlong os::javaTimeMillis() {
 #endif
 
 void os::Linux::clock_init() {
+  // Since glibc 2.17 clock_gettime lives in libc and is served by the vDSO
+  // without entering the kernel; prefer it over the librt version.
+  int (*libc_clock_getres)(clockid_t, struct timespec*) =
+         (int(*)(clockid_t, struct timespec*))dlsym(RTLD_DEFAULT, "clock_getres");
+  int (*libc_clock_gettime)(clockid_t, struct timespec*) =
+         (int(*)(clockid_t, struct timespec*))dlsym(RTLD_DEFAULT, "clock_gettime");
+  if (libc_clock_getres != NULL && libc_clock_gettime != NULL) {
+    struct timespec res;
+    struct timespec tp;
+    if (libc_clock_getres (CLOCK_MONOTONIC, &res) == 0 &&
+        libc_clock_gettime(CLOCK_MONOTONIC, &tp)  == 0) {
+      _clock_gettime = libc_clock_gettime;
+      return;
+    }
+  }
+
   // we do dlopen's in this particular order due to bug in linux
   // dynamical loader (see 6348968) leading to crash on exit
   void* handle = dlopen("librt.so.1", RTLD_LAZY);
@@ -1429,6 +1570,11 @@ void os::Linux::clock_init() {
 #define sys_clock_getres(x,y)  ::syscall(SYS_clock_getres, x, y)
 #endif
 
+// The kernel encodes the CPU clock of a thread in its clock id, see
+// MAKE_THREAD_CPUCLOCK in linux/posix-timers.h. This is also what glibc's
+// pthread_getcpuclockid() returns.
+#define THREAD_CPUCLOCK_SCHED(tid)  ((clockid_t)((~(unsigned int)(tid)) << 3) | 6)
+
 void os::Linux::fast_thread_clock_init() {
   if (!UseLinuxPosixThreadCPUClocks) {
     return;
@@ -1453,6 +1599,11 @@ void os::Linux::fast_thread_clock_init() {
 
     _supports_fast_thread_cpu_time = true;
     _pthread_getcpuclockid = pthread_getcpuclockid_func;
+  } else if (sys_clock_getres(THREAD_CPUCLOCK_SCHED(os::Linux::gettid()), &tp) == 0 &&
+             tp.tv_sec == 0) {
+    // No usable pthread_getcpuclockid(), but the kernel supports the
+    // per-thread CPU clocks; build the clock ids from the kernel thread ids.
+    _supports_fast_thread_cpu_time = true;
   }
 }
 
@@ -2239,6 +2390,10 @@ void os::Linux::print_full_memory_info(outputStream* st) {
    st->print("\n/proc/meminfo:\n");
    _print_ascii_file("/proc/meminfo", st);
    st->cr();
+   st->print("/sys/kernel/mm/transparent_hugepage/enabled: ");
+   if (!_print_ascii_file("/sys/kernel/mm/transparent_hugepage/enabled", st)) {
+     st->cr();
+   }
 }
 
 void os::Linux::print_container_info(outputStream* st) {
@@ -2731,6 +2886,27 @@ static void warn_fail_commit_memory(char* addr, size_t size,
           alignment_hint, exec, strerror(err), err);
 }
 
+// Define MAP_HUGETLB here so we can build HotSpot on old systems.
+#ifndef MAP_HUGETLB
+#define MAP_HUGETLB 0x40000
+#endif
+
+// Define MADV_HUGEPAGE here so we can build HotSpot on old systems.
+#ifndef MADV_HUGEPAGE
+#define MADV_HUGEPAGE 14
+#endif
+
+// Define MADV_NOHUGEPAGE here so we can build HotSpot on old systems.
+#ifndef MADV_NOHUGEPAGE
+#define MADV_NOHUGEPAGE 15
+#endif
+
+// Set by large_page_init() if UseTransparentHugePagesForCodeCache is usable.
+static size_t _code_cache_large_page_size = 0;
+
+// Set by large_page_init() if TransparentHugePagesOnlyForLargeSpaces applies.
+static bool _no_huge_pages_for_small_commits = false;
+
 // NOTE: Linux kernel does not really reserve the pages for us.
 //       All it does is to check if there are enough free pages
 //       left at the time of mmap(). This could be a potential
@@ -2743,6 +2919,16 @@ int os::Linux::commit_memory_impl(char* addr, size_t size, bool exec) {
     if (UseNUMAInterleaving) {
       numa_make_global(addr, size);
     }
+    if (exec && _code_cache_large_page_size > 0) {
+      // Only the code cache commits executable memory. As in
+      // pd_realign_memory() the return value is not checked.
+      ::madvise(addr, size, MADV_HUGEPAGE);
+    } else if (_no_huge_pages_for_small_commits) {
+      // Keep small or volatile data, say metaspace chunks, from being
+      // backed by huge pages. Commits with a huge page alignment hint
+      // advise the opposite in pd_realign_memory() right after.
+      ::madvise(addr, size, MADV_NOHUGEPAGE);
+    }
     return 0;
   }
 
@@ -2771,16 +2957,6 @@ void os::pd_commit_memory_or_exit(char* addr, size_t size, bool exec,
   }
 }
 
-// Define MAP_HUGETLB here so we can build HotSpot on old systems.
-#ifndef MAP_HUGETLB
-#define MAP_HUGETLB 0x40000
-#endif
-
-// Define MADV_HUGEPAGE here so we can build HotSpot on old systems.
-#ifndef MADV_HUGEPAGE
-#define MADV_HUGEPAGE 14
-#endif
-
 int os::Linux::commit_memory_impl(char* addr, size_t size,
                                   size_t alignment_hint, bool exec) {
   int err = os::Linux::commit_memory_impl(addr, size, exec);
@@ -2809,9 +2985,17 @@ void os::pd_commit_memory_or_exit(char* addr, size_t size,
 
 void os::pd_realign_memory(char *addr, size_t bytes, size_t alignment_hint) {
   if (UseTransparentHugePages && alignment_hint > (size_t)vm_page_size()) {
-    // We don't check the return value: madvise(MADV_HUGEPAGE) may not
-    // be supported or the memory may already be backed by huge pages.
-    ::madvise(addr, bytes, MADV_HUGEPAGE);
+    // Only advise the whole huge pages in the range: a partial one can
+    // never be backed by a huge page, and advising it would split the
+    // mapping where khugepaged cannot collapse it anyway.
+    size_t page_size = MIN2(alignment_hint, os::large_page_size());
+    char* start = (char*)align_ptr_up(addr, page_size);
+    char* end = (char*)align_ptr_down(addr + bytes, page_size);
+    if (start < end) {
+      // We don't check the return value: madvise(MADV_HUGEPAGE) may not
+      // be supported or the memory may already be backed by huge pages.
+      ::madvise(start, end - start, MADV_HUGEPAGE);
+    }
   }
 }
 
@@ -3107,6 +3291,36 @@ bool os::pd_uncommit_memory(char* addr, size_t size) {
   return res  != (uintptr_t) MAP_FAILED;
 }
 
+bool os::resident_memory_size(char* addr, size_t bytes, size_t* resident) {
+  assert(is_ptr_aligned(addr, os::vm_page_size()), "must be page aligned");
+  const size_t page_sz = os::vm_page_size();
+  const size_t chunk_pages = 1024;
+  unsigned char vec[chunk_pages];
+  size_t pages = align_size_up(bytes, page_sz) / page_sz;
+  size_t count = 0;
+  for (size_t done = 0; done < pages; done += chunk_pages) {
+    char* chunk = addr + done * page_sz;
+    size_t n = MIN2(chunk_pages, pages - done);
+    if (::mincore(chunk, n * page_sz, vec) == -1) {
+      if (errno != ENOMEM) {
+        return false;
+      }
+      // Part of the range is not mapped, e.g. the unused end of the
+      // primordial thread's stack. Look at the pages one by one.
+      for (size_t i = 0; i < n; i++) {
+        if (::mincore(chunk + i * page_sz, page_sz, &vec[i]) == -1) {
+          vec[i] = 0;
+        }
+      }
+    }
+    for (size_t i = 0; i < n; i++) {
+      count += vec[i] & 1;
+    }
+  }
+  *resident = count * page_sz;
+  return true;
+}
+
 static
 address get_stack_commited_bottom(address bottom, size_t size) {
   address nbot = bottom;
@@ -3381,6 +3595,20 @@ bool os::Linux::transparent_huge_pages_sanity_check(bool warn, size_t page_size)
   return result;
 }
 
+bool os::Linux::transparent_huge_pages_always() {
+  bool result = false;
+  FILE* fp = fopen("/sys/kernel/mm/transparent_hugepage/enabled", "r");
+  if (fp != NULL) {
+    // The selected mode is in brackets: "[always] madvise never"
+    char buf[64];
+    if (fgets(buf, sizeof(buf), fp) != NULL) {
+      result = strstr(buf, "[always]") != NULL;
+    }
+    fclose(fp);
+  }
+  return result;
+}
+
 bool os::Linux::hugetlbfs_sanity_check(bool warn, size_t page_size) {
   bool result = false;
   void *p = mmap(NULL, page_size, PROT_READ|PROT_WRITE,
@@ -3558,6 +3786,16 @@ bool os::Linux::setup_large_page_type(size_t page_size) {
 }
 
 void os::large_page_init() {
+  if (UseTransparentHugePagesForCodeCache) {
+    size_t page_size = Linux::find_large_page_size();
+    if (page_size > (size_t)Linux::page_size() &&
+        Linux::transparent_huge_pages_sanity_check(true, page_size)) {
+      _code_cache_large_page_size = page_size;
+    } else {
+      UseTransparentHugePagesForCodeCache = false;
+    }
+  }
+
   if (!UseLargePages &&
       !UseTransparentHugePages &&
       !UseHugeTLBFS &&
@@ -3578,6 +3816,11 @@ void os::large_page_init() {
   size_t large_page_size = Linux::setup_large_page_size();
   UseLargePages          = Linux::setup_large_page_type(large_page_size);
 
+  // In "madvise" mode only the advised memory gets huge pages anyway.
+  _no_huge_pages_for_small_commits = UseLargePages && UseTransparentHugePages &&
+                                     TransparentHugePagesOnlyForLargeSpaces &&
+                                     Linux::transparent_huge_pages_always();
+
   set_coredump_filter();
 }
 
@@ -3938,6 +4181,10 @@ bool os::can_execute_large_page_memory() {
   return UseTransparentHugePages || UseHugeTLBFS;
 }
 
+size_t os::code_cache_large_page_size() {
+  return _code_cache_large_page_size;
+}
+
 // Reserve memory at an arbitrary address, only if that area is
 // available (and not reserved for something else).
 
@@ -5688,12 +5935,19 @@ bool os::pd_unmap_memory(char* addr, size_t bytes) {
 static jlong slow_thread_cpu_time(Thread *thread, bool user_sys_cpu_time);
 
 static clockid_t thread_cpu_clockid(Thread* thread) {
-  pthread_t tid = thread->osthread()->pthread_id();
-  clockid_t clockid;
+  OSThread* osthread = thread->osthread();
+  clockid_t clockid = osthread->thread_cpu_clockid();
+  if (clockid != 0) {
+    return clockid;
+  }
 
-  // Get thread clockid
-  int rc = os::Linux::pthread_getcpuclockid(tid, &clockid);
-  assert(rc == 0, "pthread_getcpuclockid is expected to return 0 code");
+  // Get thread clockid and cache it; 0 is CLOCK_REALTIME and never a thread
+  // CPU clock. Racing threads store the same value.
+  if (os::Linux::pthread_getcpuclockid(osthread->pthread_id(), &clockid) != 0) {
+    assert(osthread->thread_id() != 0, "thread not started");
+    clockid = THREAD_CPUCLOCK_SCHED(osthread->thread_id());
+  }
+  osthread->set_thread_cpu_clockid(clockid);
   return clockid;
 }
 
@@ -5725,9 +5979,17 @@ jlong os::thread_cpu_time(Thread* thread) {
 jlong os::current_thread_cpu_time(bool user_sys_cpu_time) {
   if (user_sys_cpu_time && os::Linux::supports_fast_thread_cpu_time()) {
     return os::Linux::fast_thread_cpu_time(CLOCK_THREAD_CPUTIME_ID);
-  } else {
-    return slow_thread_cpu_time(Thread::current(), user_sys_cpu_time);
   }
+  if (!user_sys_cpu_time) {
+    // There is no clock for the user time alone, but for the current
+    // thread getrusage() is much cheaper than parsing /proc.
+    struct rusage usage;
+    if (getrusage(RUSAGE_THREAD, &usage) == 0) {
+      return jlong(usage.ru_utime.tv_sec) * NANOSECS_PER_SEC +
+             jlong(usage.ru_utime.tv_usec) * 1000;
+    }
+  }
+  return slow_thread_cpu_time(Thread::current(), user_sys_cpu_time);
 }
 
 jlong os::thread_cpu_time(Thread *thread, bool user_sys_cpu_time) {
@@ -6196,7 +6458,137 @@ static void unpackTime(timespec* absTime, bool isAbsolute, jlong time) {
   assert(absTime->tv_nsec < NANOSECS_PER_SEC, "tv_nsec >= nanos_per_sec");
 }
 
+// UseFutexParker
+//
+// The permit lives in _futex_state and is handed over with an atomic
+// exchange. The owner spins a little for the permit before it sets the
+// state to FUTEX_PARKED and waits on the word, and only an unpark that
+// finds FUTEX_PARKED issues FUTEX_WAKE. Both the uncontended unpark and
+// the park that is satisfied while spinning stay in user space.
+
+#ifndef FUTEX_WAIT_PRIVATE
+#define FUTEX_WAIT_PRIVATE 128
+#endif
+#ifndef FUTEX_WAKE_PRIVATE
+#define FUTEX_WAKE_PRIVATE 129
+#endif
+
+static int futex_wait(volatile int* addr, int val, const struct timespec* timeout) {
+  return syscall(SYS_futex, addr, FUTEX_WAIT_PRIVATE, val, timeout, NULL, 0);
+}
+
+static int futex_wake(volatile int* addr) {
+  return syscall(SYS_futex, addr, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+}
+
+void os::PlatformParker::futex_park(bool isAbsolute, jlong time) {
+  // Take an available permit; this is the xchg fast path of park()
+  if (Atomic::xchg(FUTEX_EMPTY, &_futex_state) == FUTEX_PERMIT) return;
+
+  Thread* thread = Thread::current();
+  assert(thread->is_Java_thread(), "Must be JavaThread");
+  JavaThread *jt = (JavaThread *)thread;
+
+  if (Thread::is_interrupted(thread, false)) {
+    return;
+  }
+
+  // The futex timeout is relative
+  struct timespec timeout;
+  if (time < 0 || (isAbsolute && time == 0)) { // don't wait at all
+    return;
+  }
+  if (time > 0) {
+    jlong nanos = time;
+    if (isAbsolute) {
+      jlong millis = time - os::javaTimeMillis();
+      if (millis <= 0) {
+        return;
+      }
+      nanos = millis * NANOSECS_PER_MILLISEC;
+    }
+    jlong secs = MIN2(nanos / NANOSECS_PER_SEC, (jlong)MAX_SECS);
+    timeout.tv_sec = (time_t)secs;
+    timeout.tv_nsec = secs == MAX_SECS ? 0 : (long)(nanos % NANOSECS_PER_SEC);
+  }
+
+  _parks++;
+
+  // Spin for a permit from an unpark that is about to happen. The limit
+  // grows when spinning pays off and shrinks when the spin is wasted.
+  if (os::is_MP()) {
+    for (int i = 0; i < _spin_limit; i++) {
+      if (_futex_state == FUTEX_PERMIT) {
+        if (Atomic::xchg(FUTEX_EMPTY, &_futex_state) == FUTEX_PERMIT) {
+          _spin_hits++;
+          _spin_limit = MIN2(_spin_limit * 2, (int)FutexParkerSpinLimit);
+          return;
+        }
+      }
+      SpinPause();
+    }
+    _spin_limit = MAX2(_spin_limit / 2, MIN2(16, (int)FutexParkerSpinLimit));
+  }
+
+  ThreadBlockInVM tbivm(jt);
+
+  if (Thread::is_interrupted(thread, false)) {
+    return;
+  }
+  if (Atomic::cmpxchg(FUTEX_PARKED, &_futex_state, FUTEX_EMPTY) != FUTEX_EMPTY) {
+    // A permit arrived, take it
+    Atomic::xchg(FUTEX_EMPTY, &_futex_state);
+    return;
+  }
+
+#ifdef ASSERT
+  // Don't catch signals while blocked; let the running threads have the signals.
+  // (This allows a debugger to break into the running thread.)
+  sigset_t oldsigs;
+  sigset_t* allowdebug_blocked = os::Linux::allowdebug_blocked_signals();
+  pthread_sigmask(SIG_BLOCK, allowdebug_blocked, &oldsigs);
+#endif
+
+  OSThreadWaitState osts(thread->osthread(), false /* not Object.wait() */);
+  jt->set_suspend_equivalent();
+  // cleared by handle_special_suspend_equivalent_condition() or java_suspend_self()
+
+  _blocks++;
+  // Returns when unparked, on a timeout, a signal or if the permit
+  // arrived before the wait; park is allowed to return spuriously.
+  futex_wait(&_futex_state, FUTEX_PARKED, time == 0 ? NULL : &timeout);
+
+#ifdef ASSERT
+  pthread_sigmask(SIG_SETMASK, &oldsigs, NULL);
+#endif
+
+  // Consume the permit, or withdraw FUTEX_PARKED
+  Atomic::xchg(FUTEX_EMPTY, &_futex_state);
+
+  // If externally suspended while waiting, re-suspend
+  if (jt->handle_special_suspend_equivalent_condition()) {
+    jt->java_suspend_self();
+  }
+}
+
+void os::PlatformParker::futex_unpark() {
+  if (Atomic::xchg(FUTEX_PERMIT, &_futex_state) == FUTEX_PARKED) {
+    Atomic::inc((volatile jint*)&_wakeups);
+    futex_wake(&_futex_state);
+  }
+}
+
+void os::PlatformParker::print_statistics_on(outputStream* st) const {
+  st->print_cr("   Parker: parks=%u spin hits=%u blocks=%u wakeups=%u spin limit=%d",
+               _parks, _spin_hits, _blocks, _wakeups, _spin_limit);
+}
+
 void Parker::park(bool isAbsolute, jlong time) {
+  if (UseFutexParker) {
+    futex_park(isAbsolute, time);
+    return;
+  }
+
   // Ideally we'd do something useful while spinning, such
   // as calling unpackTime().
 
@@ -6298,6 +6690,11 @@ void Parker::park(bool isAbsolute, jlong time) {
 }
 
 void Parker::unpark() {
+  if (UseFutexParker) {
+    futex_unpark();
+    return;
+  }
+
   int s, status ;
   status = pthread_mutex_lock(_mutex);
   assert (status == 0, "invariant") ;
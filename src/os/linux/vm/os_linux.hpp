@@ -108,6 +108,8 @@ class Linux {
 
   static bool setup_large_page_type(size_t page_size);
   static bool transparent_huge_pages_sanity_check(bool warn, size_t pages_size);
+  // True if /sys/kernel/mm/transparent_hugepage/enabled selects "always".
+  static bool transparent_huge_pages_always();
   static bool hugetlbfs_sanity_check(bool warn, size_t page_size);
 
   static char* reserve_memory_special_shm(size_t bytes, size_t alignment, char* req_addr, bool exec);
@@ -399,11 +401,32 @@ class PlatformParker : public CHeapObj<mtInternal> {
     pthread_mutex_t _mutex [1] ;
     pthread_cond_t  _cond  [2] ; // one for relative times and one for abs.
 
+    // UseFutexParker: the permit word is 1 with a permit, 0 without and
+    // -1 while the owner is blocked in the kernel, so that unpark only
+    // makes a system call when there is a thread to wake.
+    enum {
+        FUTEX_PARKED = -1,
+        FUTEX_EMPTY = 0,
+        FUTEX_PERMIT = 1
+    };
+    volatile int _futex_state;
+    int _spin_limit;             // adapted by the owner, see futex_park()
+    juint _parks;                // parks that found no permit
+    juint _spin_hits;            // of which got one while spinning
+    juint _blocks;               // of which blocked in the kernel
+    volatile juint _wakeups;     // unparks that woke a blocked owner
+
+    void futex_park(bool isAbsolute, jlong time);
+    void futex_unpark();
+
   public:       // TODO-FIXME: make dtor private
     ~PlatformParker() { guarantee (0, "invariant") ; }
 
+    void print_statistics_on(outputStream* st) const;
+
   public:
-    PlatformParker() {
+    PlatformParker() : _futex_state(FUTEX_EMPTY), _spin_limit(FutexParkerSpinLimit),
+                       _parks(0), _spin_hits(0), _blocks(0), _wakeups(0) {
       int status;
       status = pthread_cond_init (&_cond[REL_INDEX], os::Linux::condAttr());
       assert_status(status == 0, status, "cond_init rel");
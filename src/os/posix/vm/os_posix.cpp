@@ -33,6 +33,10 @@
 #include <sys/resource.h>
 #include <sys/utsname.h>
 #include <pthread.h>
+#include <sys/mman.h>
+#include <fcntl.h>
+#include <errno.h>
+#include <stdlib.h>
 #include <signal.h>
 
 PRAGMA_FORMAT_MUTE_WARNINGS_FOR_GCC
@@ -166,6 +170,53 @@ char* os::reserve_memory_aligned(size_t size, size_t alignment) {
   return aligned_base;
 }
 
+int os::create_file_for_heap(const char* dir) {
+  const char name_template[] = "/jvmheap.XXXXXX";
+  size_t len = strlen(dir) + sizeof(name_template);
+  char* fullname = NEW_C_HEAP_ARRAY(char, len, mtInternal);
+  jio_snprintf(fullname, len, "%s%s", dir, name_template);
+
+  int fd = mkstemp(fullname);
+  if (fd < 0) {
+    warning("Could not create file for heap with template %s (%s)",
+            fullname, strerror(errno));
+    FREE_C_HEAP_ARRAY(char, fullname, mtInternal);
+    return -1;
+  }
+  // Drop the name so the file goes away with the last mapping of it.
+  int ret = unlink(fullname);
+  assert(ret == 0, "unlink failed");
+  FREE_C_HEAP_ARRAY(char, fullname, mtInternal);
+  return fd;
+}
+
+char* os::replace_existing_mapping_with_file_mapping(char* base, size_t size, int fd) {
+  assert(fd != -1, "file descriptor is not valid");
+  assert(base != NULL, "base cannot be NULL");
+
+  // Allocate the file space up front: a sparse file on a full filesystem
+  // would otherwise fail with SIGBUS on first touch of a heap page.
+#if defined(__APPLE__) || defined(_ALLBSD_SOURCE)
+  int ret = ftruncate(fd, (off_t)size) == 0 ? 0 : errno;
+#else
+  int ret = posix_fallocate(fd, 0, (off_t)size);
+#endif
+  if (ret != 0) {
+    warning("Could not allocate " SIZE_FORMAT "K for the heap file (%s)",
+            size / K, strerror(ret));
+    return NULL;
+  }
+
+  char* addr = (char*)::mmap(base, size, PROT_READ | PROT_WRITE,
+                             MAP_SHARED | MAP_FIXED, fd, 0);
+  if (addr == MAP_FAILED) {
+    warning("Failed to map the heap file (%s)", strerror(errno));
+    return NULL;
+  }
+  assert(addr == base, "MAP_FIXED must map in place");
+  return addr;
+}
+
 int os::vsnprintf(char* buf, size_t len, const char* fmt, va_list args) {
   int result = ::vsnprintf(buf, len, fmt, args);
   // If an encoding error occurred (result < 0) then it's not clear
@@ -2843,6 +2843,11 @@ bool os::pd_uncommit_memory(char* addr, size_t bytes) {
                                 PROT_NONE);
 }
 
+bool os::resident_memory_size(char* addr, size_t bytes, size_t* resident) {
+  // Not implemented
+  return false;
+}
+
 char* os::Solaris::mmap_chunk(char *addr, size_t size, int flags, int prot) {
   char *b = (char *)mmap(addr, size, prot, flags, os::Solaris::_dev_zero_fd, 0);
 
@@ -3191,6 +3196,10 @@ bool os::can_execute_large_page_memory() {
   return true;
 }
 
+size_t os::code_cache_large_page_size() {
+  return 0;
+}
+
 static int os_sleep(jlong millis, bool interruptible) {
   const jlong limit = INT_MAX;
   jlong prevtime;
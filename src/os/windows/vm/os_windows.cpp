@@ -3150,6 +3150,16 @@ void os::pd_split_reserved_memory(char *base, size_t size, size_t split,
 // Multiple threads can race in this code but it's not possible to unmap small sections of
 // virtual space to get requested alignment, like posix-like os's.
 // Windows prevents multiple thread from remapping over each other so this loop is thread-safe.
+int os::create_file_for_heap(const char* dir) {
+  warning("AllocateHeapAt is not supported on this platform");
+  return -1;
+}
+
+char* os::replace_existing_mapping_with_file_mapping(char* base, size_t size, int fd) {
+  ShouldNotReachHere();
+  return NULL;
+}
+
 char* os::reserve_memory_aligned(size_t size, size_t alignment) {
   assert((alignment & (os::vm_allocation_granularity() - 1)) == 0,
       "Alignment must be a multiple of allocation granularity (page size)");
@@ -3231,6 +3241,10 @@ bool os::can_execute_large_page_memory() {
   return true;
 }
 
+size_t os::code_cache_large_page_size() {
+  return 0;
+}
+
 char* os::reserve_memory_special(size_t bytes, size_t alignment, char* addr, bool exec) {
   assert(UseLargePages, "only for large pages");
 
@@ -3389,6 +3403,11 @@ bool os::pd_uncommit_memory(char* addr, size_t bytes) {
   return (VirtualFree(addr, bytes, MEM_DECOMMIT) != 0);
 }
 
+bool os::resident_memory_size(char* addr, size_t bytes, size_t* resident) {
+  // Not implemented
+  return false;
+}
+
 bool os::pd_release_memory(char* addr, size_t bytes) {
   return VirtualFree(addr, 0, MEM_RELEASE) != 0;
 }
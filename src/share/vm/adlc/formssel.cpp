@@ -4136,6 +4136,10 @@ bool MatchRule::is_vector() const {
     "MulVS","MulVI","MulVF","MulVD",
     "DivVF","DivVD",
     "AndV" ,"XorV" ,"OrV",
+    "VectorCastI2F",
+    "AddReductionVI", "AddReductionVL", "AddReductionVF", "AddReductionVD",
+    "MulReductionVI", "MulReductionVF", "MulReductionVD",
+    "AndReductionV", "OrReductionV", "XorReductionV",
     "LShiftCntV","RShiftCntV",
     "LShiftVB","LShiftVS","LShiftVI","LShiftVL",
     "RShiftVB","RShiftVS","RShiftVI","RShiftVL",
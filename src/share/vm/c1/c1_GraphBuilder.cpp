@@ -2032,7 +2032,7 @@ void GraphBuilder::invoke(Bytecodes::Code code) {
         // Register dependence if JVMTI has either breakpoint
         // setting or hotswapping of methods capabilities since they may
         // cause deoptimization.
-        if (compilation()->env()->jvmti_can_hotswap_or_post_breakpoint()) {
+        if (compilation()->env()->should_record_evol_dependencies()) {
           dependency_recorder()->assert_evol_method(inline_target);
         }
         return;
@@ -934,7 +934,48 @@ LIR_Opr LIRGenerator::force_to_spill(LIR_Opr value, BasicType t) {
   return tmp;
 }
 
-void LIRGenerator::profile_branch(If* if_instr, If::Condition cond) {
+// Sampled profiling: with C1ProfileSamplingPeriod > 1 a per-thread
+// countdown decides whether a profiling site updates the MDO, and the
+// update is weighted by the period. This keeps the counts comparable to
+// full profiling while most executions do not write to the shared MDO.
+// Returns the label to bind after the update, or NULL if every execution
+// updates the profile.
+LabelObj* LIRGenerator::profile_sample_begin(int bci) {
+  if (C1ProfileSamplingPeriod <= 1) {
+    return NULL;
+  }
+  LIR_Address* countdown_addr = new LIR_Address(getThreadPointer(),
+                                                in_bytes(JavaThread::profile_sample_countdown_offset()), T_INT);
+  LIR_Opr countdown = new_register(T_INT);
+  __ move(countdown_addr, countdown);
+  __ sub(countdown, LIR_OprFact::intConst(1), countdown);
+  __ move(countdown, countdown_addr);
+  LabelObj* skip = new LabelObj();
+  __ cmp(lir_cond_greater, countdown, LIR_OprFact::intConst(0));
+  __ branch(lir_cond_greater, T_INT, skip->label());
+
+  // Restart the countdown. The restart value depends on the site (the
+  // average over sites is about the period), so that branches executed
+  // in a fixed pattern are not always sampled at the same site.
+  juint period = (juint)C1ProfileSamplingPeriod;
+  juint restart = period / 2 + ((juint)bci * 0x9E3779B1u) % period;
+  LIR_Opr restart_reg = new_register(T_INT);
+  __ move(LIR_OprFact::intConst((jint)MAX2(restart, (juint)1)), restart_reg);
+  __ move(restart_reg, new LIR_Address(getThreadPointer(),
+                                       in_bytes(JavaThread::profile_sample_countdown_offset()), T_INT));
+  return skip;
+}
+
+void LIRGenerator::profile_sample_end(LabelObj* skip) {
+  if (skip != NULL) {
+    __ branch_destination(skip->label());
+  }
+}
+
+// Called after the comparison of left and right. Without sampling the
+// profiling code keeps the condition codes; with sampling it clobbers
+// them and emits the comparison again.
+void LIRGenerator::profile_branch(If* if_instr, If::Condition cond, LIR_Opr left, LIR_Opr right) {
   if (if_instr->should_profile()) {
     ciMethod* method = if_instr->profiled_method();
     assert(method != NULL, "method should be set if branch is profiled");
@@ -951,6 +992,17 @@ void LIRGenerator::profile_branch(If* if_instr, If::Condition cond) {
       not_taken_count_offset = t;
     }
 
+    // The long compare on 32 bit x86 destroys its left operand, so it
+    // cannot be repeated.
+    LabelObj* skip = NULL;
+    if (LP64_ONLY(true) NOT_LP64(!if_instr->x()->type()->is_double_word())) {
+      skip = profile_sample_begin(if_instr->profiled_bci());
+    }
+    int increment = (skip != NULL) ? profile_sample_increment() : DataLayout::counter_increment;
+    if (skip != NULL) {
+      __ cmp(lir_cond(cond), left, right);
+    }
+
     LIR_Opr md_reg = new_register(T_METADATA);
     __ metadata2reg(md->constant_encoding(), md_reg);
 
@@ -965,9 +1017,14 @@ void LIRGenerator::profile_branch(If* if_instr, If::Condition cond) {
     LIR_Address* data_addr = new LIR_Address(md_reg, data_offset_reg, data_reg->type());
     __ move(data_addr, data_reg);
     // Use leal instead of add to avoid destroying condition codes on x86
-    LIR_Address* fake_incr_value = new LIR_Address(data_reg, DataLayout::counter_increment, T_INT);
+    LIR_Address* fake_incr_value = new LIR_Address(data_reg, increment, T_INT);
     __ leal(LIR_OprFact::address(fake_incr_value), data_reg);
     __ move(data_reg, data_addr);
+
+    if (skip != NULL) {
+      profile_sample_end(skip);
+      __ cmp(lir_cond(cond), left, right);
+    }
   }
 }
 
@@ -2595,11 +2652,14 @@ void LIRGenerator::do_Goto(Goto* x) {
       assert(data->is_JumpData(), "need JumpData for branches");
       offset = md->byte_offset_of_slot(data, JumpData::taken_offset());
     }
+    LabelObj* skip = profile_sample_begin(x->profiled_bci());
     LIR_Opr md_reg = new_register(T_METADATA);
     __ metadata2reg(md->constant_encoding(), md_reg);
 
     increment_counter(new LIR_Address(md_reg, offset,
-                                      NOT_LP64(T_INT) LP64_ONLY(T_LONG)), DataLayout::counter_increment);
+                                      NOT_LP64(T_INT) LP64_ONLY(T_LONG)),
+                      skip != NULL ? profile_sample_increment() : DataLayout::counter_increment);
+    profile_sample_end(skip);
   }
 
   // emit phi-instruction move after safepoint since this simplifies
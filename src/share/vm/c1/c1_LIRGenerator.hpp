@@ -362,7 +362,12 @@ class LIRGenerator: public InstructionVisitor, public BlockClosure {
 
   LIR_Opr safepoint_poll_register();
 
-  void profile_branch(If* if_instr, If::Condition cond);
+  void profile_branch(If* if_instr, If::Condition cond, LIR_Opr left, LIR_Opr right);
+  LabelObj* profile_sample_begin(int bci);
+  void profile_sample_end(LabelObj* skip);
+  int  profile_sample_increment() const {
+    return DataLayout::counter_increment * (int)MAX2(C1ProfileSamplingPeriod, (intx)1);
+  }
   void increment_event_counter_impl(CodeEmitInfo* info,
                                     ciMethod *method, int frequency,
                                     int bci, bool backedge, bool notify);
@@ -49,17 +49,17 @@
 #endif
 
 
+static LinearScanTimers _total_timer;
+
+// helper macro for short definition of timer
+#define TIME_LINEAR_SCAN(timer_name)  TraceTime _block_timer("", _total_timer.timer(LinearScanTimers::timer_name), TimeLinearScan || TimeEachLinearScan, Verbose);
+
 #ifndef PRODUCT
 
   static LinearScanStatistic _stat_before_alloc;
   static LinearScanStatistic _stat_after_asign;
   static LinearScanStatistic _stat_final;
 
-  static LinearScanTimers _total_timer;
-
-  // helper macro for short definition of timer
-  #define TIME_LINEAR_SCAN(timer_name)  TraceTime _block_timer("", _total_timer.timer(LinearScanTimers::timer_name), TimeLinearScan || TimeEachLinearScan, Verbose);
-
   // helper macro for short definition of trace-output inside code
   #define TRACE_LINEAR_SCAN(level, code)       \
     if (TraceLinearScanLevel >= level) {       \
@@ -68,7 +68,6 @@
 
 #else
 
-  #define TIME_LINEAR_SCAN(timer_name)
   #define TRACE_LINEAR_SCAN(level, code)
 
 #endif
@@ -3029,7 +3028,7 @@ void LinearScan::assign_reg_num() {
 
 
 void LinearScan::do_linear_scan() {
-  NOT_PRODUCT(_total_timer.begin_method());
+  _total_timer.begin_method();
 
   number_instructions();
 
@@ -3089,18 +3088,18 @@ void LinearScan::do_linear_scan() {
 
   NOT_PRODUCT(print_lir(1, "Before Code Generation", false));
   NOT_PRODUCT(LinearScanStatistic::compute(this, _stat_final));
-  NOT_PRODUCT(_total_timer.end_method(this));
+  _total_timer.end_method(this);
 }
 
 
 // ********** Printing functions
 
-#ifndef PRODUCT
-
 void LinearScan::print_timers(double total) {
   _total_timer.print(total);
 }
 
+#ifndef PRODUCT
+
 void LinearScan::print_statistics() {
   _stat_before_alloc.print("before allocation");
   _stat_after_asign.print("after assignment of register");
@@ -4078,6 +4077,7 @@ Interval::Interval(int reg_num) :
   _cached_opr(LIR_OprFact::illegalOpr),
   _cached_vm_reg(VMRegImpl::Bad()),
   _split_children(0),
+  _split_children_sorted(false),
   _canonical_spill_slot(-1),
   _insert_move_when_activated(false),
   _register_hint(NULL),
@@ -4158,6 +4158,10 @@ Interval* Interval::register_hint(bool search_split_child) const {
 }
 
 
+static int split_child_cmp(Interval** a, Interval** b) {
+  return (*a)->from() - (*b)->from();
+}
+
 Interval* Interval::split_child_at_op_id(int op_id, LIR_OpVisitState::OprMode mode) {
   assert(is_split_parent(), "can only be called for split parents");
   assert(op_id >= 0, "invalid op_id (method can not be called for spill moves)");
@@ -4173,7 +4177,38 @@ Interval* Interval::split_child_at_op_id(int op_id, LIR_OpVisitState::OprMode mo
     int to_offset = (mode == LIR_OpVisitState::outputMode ? 0 : 1);
 
     int i;
-    for (i = 0; i < len; i++) {
+    int linear_len = len;
+    if (len > 8) {
+      // Intervals of huge methods can be split very often, and this is
+      // called for every operand and block boundary: use a binary search
+      // over the children sorted by start. Sorting is redone after splits.
+      if (!_split_children_sorted) {
+        _split_children.sort(split_child_cmp);
+        _split_children_sorted = true;
+      }
+      int lo = 0;
+      int hi = len - 1;
+      while (lo < hi) {
+        int mid = (lo + hi + 1) / 2;
+        if (_split_children.at(mid)->from() <= op_id) {
+          lo = mid;
+        } else {
+          hi = mid - 1;
+        }
+      }
+      // the children do not overlap, so at most the child before the last
+      // one starting at or before op_id can cover op_id instead
+      for (i = lo; i >= 0 && i >= lo - 1; i--) {
+        Interval* cur = _split_children.at(i);
+        if (cur->from() <= op_id && op_id < cur->to() + to_offset) {
+          result = cur;
+          break;
+        }
+      }
+      linear_len = 0;
+    }
+
+    for (i = 0; i < linear_len; i++) {
       Interval* cur = _split_children.at(i);
       if (cur->from() <= op_id && op_id < cur->to() + to_offset) {
         if (i > 0) {
@@ -4364,6 +4399,8 @@ Interval* Interval::new_split_child() {
     parent->_split_children.append(this);
   }
   parent->_split_children.append(result);
+  // splitting changes the ranges of the children
+  parent->_split_children_sorted = false;
 
   return result;
 }
@@ -6641,6 +6678,8 @@ void LinearScanStatistic::compute(LinearScan* allocator, LinearScanStatistic &gl
   }
 }
 
+#endif // #ifndef PRODUCT
+
 
 // Implementation of LinearTimers
 
@@ -6720,5 +6759,3 @@ void LinearScanTimers::print(double total_time) {
     }
   }
 }
-
-#endif // #ifndef PRODUCT
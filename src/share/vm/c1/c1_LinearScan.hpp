@@ -407,8 +407,8 @@ class LinearScan : public CompilationResourceObj {
   // entry functions for printing
 #ifndef PRODUCT
   static void print_statistics();
-  static void print_timers(double total);
 #endif
+  static void print_timers(double total);
 };
 
 
@@ -534,6 +534,7 @@ class Interval : public CompilationResourceObj {
 
   Interval*        _split_parent;           // the original interval where this interval is derived from
   IntervalList     _split_children;         // list of all intervals that are split off from this interval (only available for split parents)
+  bool             _split_children_sorted;  // _split_children is sorted by from() (only valid for split parents)
   Interval*        _current_split_child;    // the current split child that has been active or inactive last (always stored in split parents)
 
   int              _canonical_spill_slot;   // the stack slot where all split parts of this interval are spilled to (always stored in split parents)
@@ -932,6 +933,8 @@ class LinearScanStatistic : public StackObj {
   static void compute(LinearScan* allocator, LinearScanStatistic &global_statistic);
 };
 
+#endif // ifndef PRODUCT
+
 
 // Helper class for collecting compilation time of LinearScan
 class LinearScanTimers : public StackObj {
@@ -969,9 +972,6 @@ class LinearScanTimers : public StackObj {
 };
 
 
-#endif // ifndef PRODUCT
-
-
 // Pick up platform-dependent implementation details
 #ifdef TARGET_ARCH_x86
 # include "c1_LinearScan_x86.hpp"
@@ -265,8 +265,9 @@ class ShortLoopOptimizer : public ValueNumberingVisitor {
   GlobalValueNumbering* _gvn;
   BlockList             _loop_blocks;
   bool                  _too_complicated_loop;
-  bool                  _has_field_store[T_ARRAY + 1];
+  bool                  _has_field_store[T_ARRAY + 1];   // store to a field with unknown offset
   bool                  _has_indexed_store[T_ARRAY + 1];
+  GrowableArray<int>    _field_store_offsets;            // offsets of other field stores
 
   // simplified access to methods of GlobalValueNumbering
   ValueMap* current_map()                        { return _gvn->current_map(); }
@@ -277,7 +278,11 @@ class ShortLoopOptimizer : public ValueNumberingVisitor {
   void      kill_field(ciField* field, bool all_offsets)  {
     current_map()->kill_field(field, all_offsets);
     assert(field->type()->basic_type() >= 0 && field->type()->basic_type() <= T_ARRAY, "Invalid type");
-    _has_field_store[field->type()->basic_type()] = true;
+    if (all_offsets) {
+      _has_field_store[field->type()->basic_type()] = true;
+    } else {
+      _field_store_offsets.append_if_missing(field->offset());
+    }
   }
   void      kill_array(ValueType* type)                   {
     current_map()->kill_array(type);
@@ -290,16 +295,26 @@ class ShortLoopOptimizer : public ValueNumberingVisitor {
     : _gvn(gvn)
     , _loop_blocks(ValueMapMaxLoopSize)
     , _too_complicated_loop(false)
+    , _field_store_offsets(ValueMapMaxLoopSize)
   {
+    clear_stores();
+  }
+
+  void clear_stores() {
     for (int i=0; i<= T_ARRAY; i++){
       _has_field_store[i] = false;
       _has_indexed_store[i] = false;
     }
+    _field_store_offsets.clear();
   }
 
-  bool has_field_store(BasicType type) {
+  // Can a store in the loop modify the given field? Resolved stores are
+  // only assumed to alias loads at the same offset, which is conservative
+  // with regard to the holder check done by ValueMap::kill_field.
+  bool has_field_store(ciField* field) {
+    BasicType type = field->type()->basic_type();
     assert(type >= 0 && type <= T_ARRAY, "Invalid type");
-    return _has_field_store[type];
+    return _has_field_store[type] || _field_store_offsets.contains(field->offset());
   }
 
   bool has_indexed_store(BasicType type) {
@@ -381,7 +396,7 @@ void LoopInvariantCodeMotion::process_block(BlockBegin* block) {
     } else if (cur->as_LoadField() != NULL) {
       LoadField* lf = (LoadField*)cur;
       // deoptimizes on NullPointerException
-      cur_invariant = !lf->needs_patching() && !lf->field()->is_volatile() && !_short_loop_optimizer->has_field_store(lf->field()->type()->basic_type()) && is_invariant(lf->obj()) && _insert_is_pred;
+      cur_invariant = !lf->needs_patching() && !lf->field()->is_volatile() && !_short_loop_optimizer->has_field_store(lf->field()) && is_invariant(lf->obj()) && _insert_is_pred;
     } else if (cur->as_ArrayLength() != NULL) {
       ArrayLength *length = cur->as_ArrayLength();
       cur_invariant = is_invariant(length->array());
@@ -434,6 +449,7 @@ bool ShortLoopOptimizer::process(BlockBegin* loop_header) {
 
   _too_complicated_loop = false;
   _loop_blocks.clear();
+  clear_stores();
   _loop_blocks.append(loop_header);
 
   for (int i = 0; i < _loop_blocks.length(); i++) {
@@ -323,6 +323,11 @@
   product(bool, C1ProfileBranches, true,                                    \
           "Profile branches when generating code for updating MDOs")        \
                                                                             \
+  product(intx, C1ProfileSamplingPeriod, 1,                                 \
+          "Update branch profiles only about every n-th time a thread "     \
+          "executes a profiled branch, weighting the update by n. "         \
+          "1 updates the profile on every execution")                       \
+                                                                            \
   product(bool, C1ProfileCheckcasts, true,                                  \
           "Profile checkcasts when generating code for updating MDOs")      \
                                                                             \
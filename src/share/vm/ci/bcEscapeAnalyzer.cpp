@@ -1278,10 +1278,18 @@ void BCEscapeAnalyzer::compute_escape_info() {
 
   vmIntrinsics::ID iid = known_intrinsic();
 
+  // The summary of a method analyzed on behalf of a compiled caller is
+  // cached in its MethodData and reused by every later caller, so a
+  // larger method is worth analyzing once at the top level.
+  int size_limit = MaxBCEAEstimateSize;
+  if (_level == 0 && !methodData()->is_empty()) {
+    size_limit = MAX2(size_limit, (int) MaxBCEASummarySize);
+  }
+
   // check if method can be analyzed
   if (iid ==  vmIntrinsics::_none && (method()->is_abstract() || method()->is_native() || !method()->holder()->is_initialized()
       || _level > MaxBCEAEstimateLevel
-      || method()->code_size() > MaxBCEAEstimateSize)) {
+      || method()->code_size() > size_limit)) {
     if (BCEATraceLevel >= 1) {
       tty->print("Skipping method because: ");
       if (method()->is_abstract())
@@ -1293,9 +1301,11 @@ void BCEscapeAnalyzer::compute_escape_info() {
       else if (_level > MaxBCEAEstimateLevel)
         tty->print_cr("level (%d) exceeds MaxBCEAEstimateLevel (%d).",
                       _level, (int) MaxBCEAEstimateLevel);
-      else if (method()->code_size() > MaxBCEAEstimateSize)
-        tty->print_cr("code size (%d) exceeds MaxBCEAEstimateSize (%d).",
-                      method()->code_size(), (int) MaxBCEAEstimateSize);
+      else if (method()->code_size() > size_limit)
+        tty->print_cr("code size (%d) exceeds %s (%d).",
+                      method()->code_size(),
+                      size_limit == MaxBCEAEstimateSize ? "MaxBCEAEstimateSize" : "MaxBCEASummarySize",
+                      size_limit);
       else
         ShouldNotReachHere();
     }
@@ -1475,7 +1485,7 @@ BCEscapeAnalyzer::BCEscapeAnalyzer(ciMethod* method, BCEscapeAnalyzer* parent)
 }
 
 void BCEscapeAnalyzer::copy_dependencies(Dependencies *deps) {
-  if (ciEnv::current()->jvmti_can_hotswap_or_post_breakpoint()) {
+  if (ciEnv::current()->should_record_evol_dependencies()) {
     // Also record evol dependencies so redefinition of the
     // callee will trigger recompilation.
     deps->assert_evol_method(method());
@@ -337,6 +337,11 @@ public:
   // Cache Jvmti state
   void  cache_jvmti_state();
   bool  jvmti_can_hotswap_or_post_breakpoint() const { return _jvmti_can_hotswap_or_post_breakpoint; }
+  // evol_method dependencies let RedefineClasses and breakpoints
+  // invalidate just the nmethods that inline the affected methods.
+  bool  should_record_evol_dependencies() const {
+    return _jvmti_can_hotswap_or_post_breakpoint || RecordEvolDependencies;
+  }
   bool  jvmti_can_access_local_variables()     const { return _jvmti_can_access_local_variables; }
   bool  jvmti_can_post_on_exceptions()         const { return _jvmti_can_post_on_exceptions; }
 
@@ -519,13 +519,14 @@ ciCallProfile ciMethod::call_profile_at_bci(int bci) {
           // we will set result._method also.
         }
         // Determine call site's morphism.
-        // The call site count is 0 with known morphism (onlt 1 or 2 receivers)
+        // The call site count is 0 with known morphism (all receivers recorded)
         // or < 0 in the case of a type check failured for checkcast, aastore, instanceof.
         // The call site count is > 0 in the case of a polymorphic virtual call.
+        int limit = MIN2((int)call->row_limit(), (int)ciCallProfile::MorphismLimit);
         if (morphism > 0 && morphism == result._limit) {
-           // The morphism <= MorphismLimit.
-           if ((morphism <  ciCallProfile::MorphismLimit) ||
-               (morphism == ciCallProfile::MorphismLimit && count == 0)) {
+           // The morphism <= limit.
+           if ((morphism <  limit) ||
+               (morphism == limit && count == 0)) {
 #ifdef ASSERT
              if (count > 0) {
                this->print_short_name(tty);
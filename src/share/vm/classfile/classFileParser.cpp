@@ -1390,7 +1390,7 @@ class Classfile_LVT_Element VALUE_OBJ_CLASS_SPEC {
 };
 
 
-class LVT_Hash: public CHeapObj<mtClass> {
+class LVT_Hash VALUE_OBJ_CLASS_SPEC {
  public:
   LocalVariableTableElement  *_elem;  // element
   LVT_Hash*                   _next;  // Next entry in hash table
@@ -1412,20 +1412,6 @@ void initialize_hashtable(LVT_Hash** table) {
   }
 }
 
-void clear_hashtable(LVT_Hash** table) {
-  for (int i = 0; i < HASH_ROW_SIZE; i++) {
-    LVT_Hash* current = table[i];
-    LVT_Hash* next;
-    while (current != NULL) {
-      next = current->_next;
-      current->_next = NULL;
-      delete(current);
-      current = next;
-    }
-    table[i] = NULL;
-  }
-}
-
 LVT_Hash* LVT_lookup(LocalVariableTableElement *elem, int index, LVT_Hash** table) {
   LVT_Hash* entry = table[index];
 
@@ -1449,19 +1435,15 @@ LVT_Hash* LVT_lookup(LocalVariableTableElement *elem, int index, LVT_Hash** tabl
 
 // Return false if the local variable is found in table.
 // Return true if no duplicate is found.
-// And local variable is added as a new entry in table.
-bool LVT_put_after_lookup(LocalVariableTableElement *elem, LVT_Hash** table) {
+// And local variable is added as a new entry in table, using the
+// caller-provided (resource allocated) entry.
+bool LVT_put_after_lookup(LocalVariableTableElement *elem, LVT_Hash** table,
+                          LVT_Hash* entry) {
   // First lookup for duplicates
   int index = hash(elem);
-  LVT_Hash* entry = LVT_lookup(elem, index, table);
-
-  if (entry != NULL) {
+  if (LVT_lookup(elem, index, table) != NULL) {
       return false;
   }
-  // No duplicate is found, allocate a new entry and fill it.
-  if ((entry = new LVT_Hash()) == NULL) {
-    return false;
-  }
   entry->_elem = elem;
 
   // Insert into hash table
@@ -1882,26 +1864,44 @@ void ClassFileParser::copy_localvariable_table(ConstMethod* cm,
                                                u2** localvariable_type_table_start,
                                                TRAPS) {
 
-  LVT_Hash** lvt_Hash = NEW_RESOURCE_ARRAY(LVT_Hash*, HASH_ROW_SIZE);
-  initialize_hashtable(lvt_Hash);
-
   // To fill LocalVariableTable in
   Classfile_LVT_Element*  cf_lvt;
   LocalVariableTableElement* lvt = cm->localvariable_table_start();
 
+  // Without a LocalVariableTypeTable to merge and without duplicate
+  // checking, the hashtable is not needed: just copy the elements.
+  bool check_duplicates = _need_verify && _major_version >= JAVA_1_5_VERSION;
+  if (lvtt_cnt == 0 && !check_duplicates) {
+    for (int tbl_no = 0; tbl_no < lvt_cnt; tbl_no++) {
+      cf_lvt = (Classfile_LVT_Element *) localvariable_table_start[tbl_no];
+      for (int idx = 0; idx < localvariable_table_length[tbl_no]; idx++, lvt++) {
+        copy_lvt_element(&cf_lvt[idx], lvt);
+      }
+    }
+    return;
+  }
+
+  LVT_Hash** lvt_Hash = NEW_RESOURCE_ARRAY(LVT_Hash*, HASH_ROW_SIZE);
+  initialize_hashtable(lvt_Hash);
+  // One entry per LVT element, allocated up front instead of one
+  // C heap allocation per element.
+  LVT_Hash* entries = NEW_RESOURCE_ARRAY(LVT_Hash, cm->localvariable_table_length());
+  int next_entry = 0;
+
   for (int tbl_no = 0; tbl_no < lvt_cnt; tbl_no++) {
     cf_lvt = (Classfile_LVT_Element *) localvariable_table_start[tbl_no];
     for (int idx = 0; idx < localvariable_table_length[tbl_no]; idx++, lvt++) {
       copy_lvt_element(&cf_lvt[idx], lvt);
       // If no duplicates, add LVT elem in hashtable lvt_Hash.
-      if (LVT_put_after_lookup(lvt, lvt_Hash) == false
-          && _need_verify
-          && _major_version >= JAVA_1_5_VERSION) {
-        clear_hashtable(lvt_Hash);
-        classfile_parse_error("Duplicated LocalVariableTable attribute "
-                              "entry for '%s' in class file %s",
-                               _cp->symbol_at(lvt->name_cp_index)->as_utf8(),
-                               CHECK);
+      if (LVT_put_after_lookup(lvt, lvt_Hash, &entries[next_entry]) == false) {
+        if (check_duplicates) {
+          classfile_parse_error("Duplicated LocalVariableTable attribute "
+                                "entry for '%s' in class file %s",
+                                 _cp->symbol_at(lvt->name_cp_index)->as_utf8(),
+                                 CHECK);
+        }
+      } else {
+        next_entry++;
       }
     }
   }
@@ -1918,14 +1918,12 @@ void ClassFileParser::copy_localvariable_table(ConstMethod* cm,
       LVT_Hash* entry = LVT_lookup(&lvtt_elem, index, lvt_Hash);
       if (entry == NULL) {
         if (_need_verify) {
-          clear_hashtable(lvt_Hash);
           classfile_parse_error("LVTT entry for '%s' in class file %s "
                                 "does not match any LVT entry",
                                  _cp->symbol_at(lvtt_elem.name_cp_index)->as_utf8(),
                                  CHECK);
         }
       } else if (entry->_elem->signature_cp_index != 0 && _need_verify) {
-        clear_hashtable(lvt_Hash);
         classfile_parse_error("Duplicated LocalVariableTypeTable attribute "
                               "entry for '%s' in class file %s",
                                _cp->symbol_at(lvtt_elem.name_cp_index)->as_utf8(),
@@ -1936,7 +1934,6 @@ void ClassFileParser::copy_localvariable_table(ConstMethod* cm,
       }
     }
   }
-  clear_hashtable(lvt_Hash);
 }
 
 
@@ -3201,6 +3198,31 @@ class FieldLayoutInfo : public StackObj {
 };
 
 // Layout fields and fill in FieldLayoutInfo.  Could use more refactoring!
+// Returns the offset just past the last nonstatic field of k, or of its
+// nearest superclass declaring nonstatic fields. Returns -1 if there are
+// none, or if @Contended padding may follow them.
+static int nonstatic_fields_end(InstanceKlass* k) {
+  for (; k != NULL; k = k->java_super()) {
+    if (k->is_contended()) {
+      return -1;
+    }
+    int end = -1;
+    for (AllFieldStream fs(k); !fs.done(); fs.next()) {
+      if (fs.access_flags().is_static()) continue;
+      if (fs.is_contended()) {
+        return -1;
+      }
+      BasicType type = FieldType::basic_type(fs.signature());
+      int size = (type == T_OBJECT || type == T_ARRAY) ? heapOopSize : type2aelembytes(type);
+      end = MAX2(end, fs.offset() + size);
+    }
+    if (end >= 0) {
+      return end;
+    }
+  }
+  return -1;
+}
+
 void ClassFileParser::layout_fields(Handle class_loader,
                                     FieldAllocationCount* fac,
                                     ClassAnnotationCollector* parsed_annotations,
@@ -3382,6 +3404,44 @@ void ClassFileParser::layout_fields(Handle class_loader,
   int nonstatic_word_space_offset  = 0;
   int nonstatic_short_space_offset = 0;
   int nonstatic_byte_space_offset  = 0;
+  int super_gap_word_count         = 0;
+  int super_gap_short_count        = 0;
+  int super_gap_byte_count         = 0;
+  int super_gap_word_offset        = 0;
+  int super_gap_short_offset       = 0;
+  int super_gap_byte_offset        = 0;
+
+  // Try to squeeze some of the fields into the gap between the last field
+  // of the superclass and nonstatic_fields_start, which is rounded up to
+  // heapOopSize. Contended classes keep their fields after the padding.
+  if (CompactFieldsIntoSuperclassGap && compact_fields &&
+      !is_contended_class && super_has_nonstatic_fields) {
+    int offset = nonstatic_fields_end(_super_klass());
+    if (offset > 0 && offset < nonstatic_fields_start) {
+      super_gap_word_offset = offset;
+      if (is_size_aligned(offset, BytesPerInt)) {
+        while (offset + BytesPerInt <= nonstatic_fields_start && nonstatic_word_count > 0) {
+          nonstatic_word_count  -= 1;
+          super_gap_word_count  += 1;
+          offset += BytesPerInt;
+        }
+      }
+      super_gap_short_offset = offset;
+      if (is_size_aligned(offset, BytesPerShort)) {
+        while (offset + BytesPerShort <= nonstatic_fields_start && nonstatic_short_count > 0) {
+          nonstatic_short_count -= 1;
+          super_gap_short_count += 1;
+          offset += BytesPerShort;
+        }
+      }
+      super_gap_byte_offset = offset;
+      while (offset < nonstatic_fields_start && nonstatic_byte_count > 0) {
+        nonstatic_byte_count  -= 1;
+        super_gap_byte_count  += 1;
+        offset += 1;
+      }
+    }
+  }
 
   // Try to squeeze some of the fields into the gaps due to
   // long/double alignment.
@@ -3508,7 +3568,11 @@ void ClassFileParser::layout_fields(Handle class_loader,
         }
         break;
       case NONSTATIC_BYTE:
-        if( nonstatic_byte_space_count > 0 ) {
+        if( super_gap_byte_count > 0 ) {
+          real_offset = super_gap_byte_offset;
+          super_gap_byte_offset += 1;
+          super_gap_byte_count  -= 1;
+        } else if( nonstatic_byte_space_count > 0 ) {
           real_offset = nonstatic_byte_space_offset;
           nonstatic_byte_space_offset += 1;
           nonstatic_byte_space_count  -= 1;
@@ -3518,7 +3582,11 @@ void ClassFileParser::layout_fields(Handle class_loader,
         }
         break;
       case NONSTATIC_SHORT:
-        if( nonstatic_short_space_count > 0 ) {
+        if( super_gap_short_count > 0 ) {
+          real_offset = super_gap_short_offset;
+          super_gap_short_offset += BytesPerShort;
+          super_gap_short_count  -= 1;
+        } else if( nonstatic_short_space_count > 0 ) {
           real_offset = nonstatic_short_space_offset;
           nonstatic_short_space_offset += BytesPerShort;
           nonstatic_short_space_count  -= 1;
@@ -3528,7 +3596,11 @@ void ClassFileParser::layout_fields(Handle class_loader,
         }
         break;
       case NONSTATIC_WORD:
-        if( nonstatic_word_space_count > 0 ) {
+        if( super_gap_word_count > 0 ) {
+          real_offset = super_gap_word_offset;
+          super_gap_word_offset += BytesPerInt;
+          super_gap_word_count  -= 1;
+        } else if( nonstatic_word_space_count > 0 ) {
           real_offset = nonstatic_word_space_offset;
           nonstatic_word_space_offset += BytesPerInt;
           nonstatic_word_space_count  -= 1;
@@ -3941,9 +4013,7 @@ instanceKlassHandle ClassFileParser::parseClassFile(Symbol* name,
       // Only dump the classes that can be stored into CDS archive
       if (SystemDictionaryShared::is_sharing_possible(loader_data)) {
         if (name != NULL) {
-          ResourceMark rm(THREAD);
-          classlist_file->print_cr("%s", name->as_C_string());
-          classlist_file->flush();
+          ClassLoader::record_loaded_class(name);
         }
       }
     }
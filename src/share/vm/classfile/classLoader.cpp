@@ -90,6 +90,7 @@ typedef jzentry* (JNICALL *FindEntry_t)(jzfile *zip, const char *name, jint *siz
 typedef jboolean (JNICALL *ReadEntry_t)(jzfile *zip, jzentry *entry, unsigned char *buf, char *namebuf);
 typedef jboolean (JNICALL *ReadMappedEntry_t)(jzfile *zip, jzentry *entry, unsigned char **buf, char *namebuf);
 typedef jzentry* (JNICALL *GetNextEntry_t)(jzfile *zip, jint n);
+typedef void     (JNICALL *FreeEntry_t)(jzfile *zip, jzentry *entry);
 typedef jint     (JNICALL *Crc32_t)(jint crc, const jbyte *buf, jint len);
 
 static ZipOpen_t         ZipOpen            = NULL;
@@ -98,6 +99,7 @@ static FindEntry_t       FindEntry          = NULL;
 static ReadEntry_t       ReadEntry          = NULL;
 static ReadMappedEntry_t ReadMappedEntry    = NULL;
 static GetNextEntry_t    GetNextEntry       = NULL;
+static FreeEntry_t       FreeEntry          = NULL;
 static canonicalize_fn_t CanonicalizeEntry  = NULL;
 static Crc32_t           Crc32              = NULL;
 
@@ -251,11 +253,52 @@ ClassFileStream* ClassPathDirEntry::open_stream(const char* name, TRAPS) {
 }
 
 
+ZipPackageIndex::ZipPackageIndex(char** packages, int num_packages) {
+  _packages = packages;
+  _num_packages = num_packages;
+}
+
+ZipPackageIndex::~ZipPackageIndex() {
+  for (int i = 0; i < _num_packages; i++) {
+    FREE_C_HEAP_ARRAY(char, _packages[i], mtClass);
+  }
+  FREE_C_HEAP_ARRAY(char*, _packages, mtClass);
+}
+
+bool ZipPackageIndex::may_contain(const char* name) const {
+  const char* last_slash = strrchr(name, '/');
+  size_t len = (last_slash == NULL) ? 0 : last_slash - name;
+  int low = 0;
+  int high = _num_packages - 1;
+  while (low <= high) {
+    int mid = (low + high) / 2;
+    const char* pkg = _packages[mid];
+    int cmp = strncmp(pkg, name, len);
+    if (cmp == 0 && pkg[len] != '\0') {
+      cmp = 1;  // pkg is longer, so it sorts after the package of name
+    }
+    if (cmp < 0) {
+      low = mid + 1;
+    } else if (cmp > 0) {
+      high = mid - 1;
+    } else {
+      return true;
+    }
+  }
+  return false;
+}
+
+static int compare_package_names(char** a, char** b) {
+  return strcmp(*a, *b);
+}
+
 ClassPathZipEntry::ClassPathZipEntry(jzfile* zip, const char* zip_name) : ClassPathEntry() {
   _zip = zip;
   char *copy = NEW_C_HEAP_ARRAY(char, strlen(zip_name)+1, mtClass);
   strcpy(copy, zip_name);
   _zip_name = copy;
+  _package_index = NULL;
+  _lookup_misses = 0;
 }
 
 ClassPathZipEntry::~ClassPathZipEntry() {
@@ -263,6 +306,52 @@ ClassPathZipEntry::~ClassPathZipEntry() {
     (*ZipClose)(_zip);
   }
   FREE_C_HEAP_ARRAY(char, _zip_name, mtClass);
+  delete _package_index;
+}
+
+// Called in native state after repeated lookup misses. A jar that keeps
+// missing sits in front of the jars that hold the classes, typically on a
+// long -Xbootclasspath/a, and every miss costs a directory search under
+// the zip lock.
+void ClassPathZipEntry::build_package_index() {
+  if (FreeEntry == NULL) {
+    return;
+  }
+  GrowableArray<char*>* packages = new (ResourceObj::C_HEAP, mtClass) GrowableArray<char*>(64, true, mtClass);
+  for (int n = 0; ; n++) {
+    jzentry* ze = (*GetNextEntry)(_zip, n);
+    if (ze == NULL) break;
+    const char* last_slash = strrchr(ze->name, '/');
+    size_t len = (last_slash == NULL) ? 0 : last_slash - ze->name;
+    // Entries are mostly grouped by directory, so this drops most duplicates
+    if (packages->is_empty() ||
+        strncmp(packages->top(), ze->name, len) != 0 || packages->top()[len] != '\0') {
+      char* pkg = NEW_C_HEAP_ARRAY(char, len + 1, mtClass);
+      strncpy(pkg, ze->name, len);
+      pkg[len] = '\0';
+      packages->append(pkg);
+    }
+    (*FreeEntry)(_zip, ze);
+  }
+  packages->sort(compare_package_names);
+  int num = 0;
+  for (int i = 0; i < packages->length(); i++) {
+    if (num > 0 && strcmp(packages->at(num - 1), packages->at(i)) == 0) {
+      FREE_C_HEAP_ARRAY(char, packages->at(i), mtClass);
+    } else {
+      packages->at_put(num++, packages->at(i));
+    }
+  }
+  char** names = NEW_C_HEAP_ARRAY(char*, MAX2(num, 1), mtClass);
+  for (int i = 0; i < num; i++) {
+    names[i] = packages->at(i);
+  }
+  delete packages;
+
+  ZipPackageIndex* index = new ZipPackageIndex(names, num);
+  if (Atomic::cmpxchg_ptr(index, &_package_index, NULL) != NULL) {
+    delete index;
+  }
 }
 
 u1* ClassPathZipEntry::open_entry(const char* name, jint* filesize, bool nul_terminate, TRAPS) {
@@ -300,9 +389,18 @@ u1* ClassPathZipEntry::open_entry(const char* name, jint* filesize, bool nul_ter
 }
 
 ClassFileStream* ClassPathZipEntry::open_stream(const char* name, TRAPS) {
+  ZipPackageIndex* index = (ZipPackageIndex*) OrderAccess::load_ptr_acquire(&_package_index);
+  if (index != NULL && !index->may_contain(name)) {
+    return NULL;
+  }
   jint filesize;
   u1* buffer = open_entry(name, &filesize, false, CHECK_NULL);
   if (buffer == NULL) {
+    if (index == NULL && BootClassPathIndexThreshold > 0 &&
+        Atomic::add(1, &_lookup_misses) == BootClassPathIndexThreshold) {
+      ThreadToNativeFromVM ttn(JavaThread::current());
+      build_package_index();
+    }
     return NULL;
   }
   if (UsePerfData) {
@@ -818,6 +916,7 @@ void ClassLoader::load_zip_library() {
   ReadEntry    = CAST_TO_FN_PTR(ReadEntry_t, os::dll_lookup(handle, "ZIP_ReadEntry"));
   ReadMappedEntry = CAST_TO_FN_PTR(ReadMappedEntry_t, os::dll_lookup(handle, "ZIP_ReadMappedEntry"));
   GetNextEntry = CAST_TO_FN_PTR(GetNextEntry_t, os::dll_lookup(handle, "ZIP_GetNextEntry"));
+  FreeEntry    = CAST_TO_FN_PTR(FreeEntry_t, os::dll_lookup(handle, "ZIP_FreeEntry"));
   Crc32        = CAST_TO_FN_PTR(Crc32_t, os::dll_lookup(handle, "ZIP_CRC32"));
 
   // ZIP_Close is not exported on Windows in JDK5.0 so don't abort if ZIP_Close is NULL
@@ -826,6 +925,8 @@ void ClassLoader::load_zip_library() {
     vm_exit_during_initialization("Corrupted ZIP library", path);
   }
 
+  // ZIP_FreeEntry is only needed for package indexes, see BootClassPathIndexThreshold
+
   // Lookup canonicalize entry in libjava.dll
   void *javalib_handle = os::native_java_library();
   CanonicalizeEntry = CAST_TO_FN_PTR(canonicalize_fn_t, os::dll_lookup(javalib_handle, "Canonicalize"));
@@ -1252,6 +1353,18 @@ void ClassLoader::initialize_shared_path() {
     _shared_paths_misc_info->write_jint(0); // see comments in SharedPathsMiscInfo::check()
   }
 }
+
+void ClassLoader::record_loaded_class(Symbol* name) {
+  assert(DumpLoadedClassList != NULL && classlist_file->is_open(), "sanity");
+  ResourceMark rm;
+  // Classes are loaded concurrently, so emit each line with a single
+  // write. Separate writes for the name and the line end can interleave
+  // between threads and leave a list that -Xshare:dump cannot parse.
+  stringStream ss;
+  ss.print_cr("%s", name->as_C_string());
+  classlist_file->write(ss.base(), ss.size());
+  classlist_file->flush();
+}
 #endif
 
 jlong ClassLoader::classloader_time_ms() {
@@ -98,10 +98,25 @@ typedef struct {
 } jzentry;
 
 
+// Sorted names of the packages that have entries in a zip file, so that
+// class lookups in other packages can fail without a directory search.
+class ZipPackageIndex: public CHeapObj<mtClass> {
+ private:
+  char** _packages;
+  int    _num_packages;
+ public:
+  ZipPackageIndex(char** packages, int num_packages);
+  ~ZipPackageIndex();
+  bool may_contain(const char* name) const;
+};
+
 class ClassPathZipEntry: public ClassPathEntry {
  private:
   jzfile* _zip;              // The zip archive
   const char*   _zip_name;   // Name of zip archive
+  ZipPackageIndex* volatile _package_index;  // see BootClassPathIndexThreshold
+  volatile jint _lookup_misses;
+  void build_package_index();
  public:
   bool is_jar_file()  { return true;  }
   const char* name()  { return _zip_name; }
@@ -343,6 +358,9 @@ class ClassLoader: AllStatic {
   static int   get_shared_paths_misc_info_size();
   static void* get_shared_paths_misc_info();
   static bool  check_shared_paths_misc_info(void* info, int size);
+
+  // Appends name to the -XX:DumpLoadedClassList file
+  static void  record_loaded_class(Symbol* name);
   static void  exit_with_path_failure(const char* error, const char* message);
 #endif
 
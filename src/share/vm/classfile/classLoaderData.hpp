@@ -97,6 +97,7 @@ class ClassLoaderDataGraph : public AllStatic {
   static GrowableArray<ClassLoaderData*>* new_clds();
 
   static void set_should_purge(bool b) { _should_purge = b; }
+  static bool should_purge() { return _should_purge; }
   static void purge_if_needed() {
     // Only purge the CLDG for CMS if concurrent sweep is complete.
     if (_should_purge) {
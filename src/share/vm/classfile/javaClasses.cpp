@@ -48,6 +48,7 @@
 #include "runtime/java.hpp"
 #include "runtime/javaCalls.hpp"
 #include "runtime/safepoint.hpp"
+#include "runtime/synchronizer.hpp"
 #include "runtime/thread.inline.hpp"
 #include "runtime/vframe.hpp"
 #include "utilities/preserveException.hpp"
@@ -153,6 +154,15 @@ void java_lang_String::compute_offsets() {
   assert(!initialized, "offsets should be initialized only once");
 
   Klass* k = SystemDictionary::String_klass();
+  // A class library with byte[] backed (compact) strings cannot run on
+  // this VM: the runtime, StringTable, G1 string deduplication and the
+  // compiler intrinsics all read String.value as a char[].
+  int coder_offset = 0;
+  compute_optional_offset(coder_offset,  k, vmSymbols::coder_name(),  vmSymbols::byte_signature());
+  if (coder_offset > 0) {
+    vm_exit_during_initialization("java.lang.String uses a byte[] (compact string) representation, "
+                                  "which this VM does not support");
+  }
   compute_offset(value_offset,           k, vmSymbols::value_name(),  vmSymbols::char_array_signature());
   compute_optional_offset(offset_offset, k, vmSymbols::offset_name(), vmSymbols::int_signature());
   compute_optional_offset(count_offset,  k, vmSymbols::count_name(),  vmSymbols::int_signature());
@@ -217,7 +227,8 @@ oop java_lang_String::create_oop_from_str(const char* utf8_str, TRAPS) {
 }
 
 Handle java_lang_String::create_from_symbol(Symbol* symbol, TRAPS) {
-  int length = UTF8::unicode_length((char*)symbol->bytes(), symbol->utf8_length());
+  int length = symbol->is_ascii() ? symbol->utf8_length() :
+               UTF8::unicode_length((char*)symbol->bytes(), symbol->utf8_length());
   Handle h_obj = basic_create(length, CHECK_NH);
   if (length > 0) {
     UTF8::convert_to_unicode((char*)symbol->bytes(), value(h_obj())->char_at_addr(0), length);
@@ -1324,6 +1335,7 @@ class BacktraceBuilder: public StackObj {
   objArrayOop     _mirrors;
   typeArrayOop    _cprefs; // needed to insulate method name against redefinition
   int             _index;
+  int             _chunk_size;
   No_Safepoint_Verifier _nsv;
 
  public:
@@ -1360,8 +1372,9 @@ class BacktraceBuilder: public StackObj {
     return cprefs;
   }
 
-  // constructor for new backtrace
-  BacktraceBuilder(TRAPS): _methods(NULL), _bcis(NULL), _head(NULL), _mirrors(NULL), _cprefs(NULL) {
+  // constructor for new backtrace, the first chunk holds chunk_size frames
+  BacktraceBuilder(int chunk_size, TRAPS): _methods(NULL), _bcis(NULL), _head(NULL), _mirrors(NULL), _cprefs(NULL),
+                                           _chunk_size(chunk_size) {
     expand(CHECK);
     _backtrace = _head;
     _index = 0;
@@ -1372,6 +1385,7 @@ class BacktraceBuilder: public StackObj {
     _bcis = get_bcis(backtrace);
     _mirrors = get_mirrors(backtrace);
     _cprefs = get_cprefs(backtrace);
+    _chunk_size = _methods->length();
     assert(_methods->length() == _bcis->length() &&
            _methods->length() == _mirrors->length(),
            "method and source information arrays should match");
@@ -1388,16 +1402,16 @@ class BacktraceBuilder: public StackObj {
     objArrayOop head = oopFactory::new_objectArray(trace_size, CHECK);
     objArrayHandle new_head(THREAD, head);
 
-    typeArrayOop methods = oopFactory::new_shortArray(trace_chunk_size, CHECK);
+    typeArrayOop methods = oopFactory::new_shortArray(_chunk_size, CHECK);
     typeArrayHandle new_methods(THREAD, methods);
 
-    typeArrayOop bcis = oopFactory::new_intArray(trace_chunk_size, CHECK);
+    typeArrayOop bcis = oopFactory::new_intArray(_chunk_size, CHECK);
     typeArrayHandle new_bcis(THREAD, bcis);
 
-    objArrayOop mirrors = oopFactory::new_objectArray(trace_chunk_size, CHECK);
+    objArrayOop mirrors = oopFactory::new_objectArray(_chunk_size, CHECK);
     objArrayHandle new_mirrors(THREAD, mirrors);
 
-    typeArrayOop cprefs = oopFactory::new_shortArray(trace_chunk_size, CHECK);
+    typeArrayOop cprefs = oopFactory::new_shortArray(_chunk_size, CHECK);
     typeArrayHandle new_cprefs(THREAD, cprefs);
 
     if (!old_head.is_null()) {
@@ -1426,8 +1440,9 @@ class BacktraceBuilder: public StackObj {
     // to a 0 even if it could be recorded.
     if (bci == SynchronizationEntryBCI) bci = 0;
 
-    if (_index >= trace_chunk_size) {
+    if (_index >= _chunk_size) {
       methodHandle mhandle(THREAD, method);
+      _chunk_size = trace_chunk_size;
       expand(CHECK);
       method = mhandle();
     }
@@ -1601,18 +1616,27 @@ void java_lang_Throwable::fill_in_stack_trace(Handle throwable, methodHandle met
 
   int max_depth = MaxJavaStackTraceDepth;
   JavaThread* thread = (JavaThread*)THREAD;
-  BacktraceBuilder bt(CHECK);
 
   // If there is no Java frame just return the method that was being called
   // with bci 0
   if (!thread->has_last_Java_frame()) {
     if (max_depth >= 1 && method() != NULL) {
+      BacktraceBuilder bt(1, CHECK);
       bt.push(method(), 0, CHECK);
       set_backtrace(throwable(), bt.backtrace());
     }
     return;
   }
 
+  // The frames are collected into a resource array first, so that the
+  // backtrace is a single chunk of exactly the stack depth rather than a
+  // list of fixed size chunks. The Method*s stay valid across the
+  // allocation: they belong to frames of this thread that are still on
+  // the stack, which keeps them alive through class unloading and
+  // redefinition.
+  GrowableArray<Method*> methods(trace_chunk_size);
+  GrowableArray<int> bcis(trace_chunk_size);
+
   // Instead of using vframe directly, this version of fill_in_stack_trace
   // basically handles everything by hand. This significantly improved the
   // speed of this method call up to 28.5% on Solaris sparc. 27.1% on Windows.
@@ -1712,10 +1736,16 @@ void java_lang_Throwable::fill_in_stack_trace(Handle throwable, methodHandle met
     if (method->is_hidden()) {
       if (skip_hidden)  continue;
     }
-    bt.push(method, bci, CHECK);
+    methods.append(method);
+    bcis.append(bci);
     total_count++;
   }
 
+  BacktraceBuilder bt(total_count, CHECK);
+  for (int i = 0; i < total_count; i++) {
+    bt.push(methods.at(i), bcis.at(i), CHECK);
+  }
+
   // Put completed stack trace into throwable object
   set_backtrace(throwable(), bt.backtrace());
 }
@@ -1744,7 +1774,7 @@ void java_lang_Throwable::allocate_backtrace(Handle throwable, TRAPS) {
 
   // No-op if stack trace is disabled
   if (!StackTraceInThrowable) return;
-  BacktraceBuilder bt(CHECK);   // creates a backtrace
+  BacktraceBuilder bt(trace_chunk_size, CHECK);   // creates a backtrace
   set_backtrace(throwable(), bt.backtrace());
 }
 
@@ -1804,7 +1834,7 @@ int java_lang_Throwable::get_stack_trace_depth(oop throwable, TRAPS) {
     while (true) {
       objArrayOop next = objArrayOop(chunk->obj_at(trace_next_offset));
       if (next == NULL) break;
-      depth += trace_chunk_size;
+      depth += BacktraceBuilder::get_mirrors(chunk)->length();
       chunk = next;
     }
     assert(chunk != NULL && chunk->obj_at(trace_next_offset) == NULL, "sanity check");
@@ -1828,13 +1858,13 @@ oop java_lang_Throwable::get_stack_trace_element(oop throwable, int index, TRAPS
   if (index < 0) {
     THROW_(vmSymbols::java_lang_IndexOutOfBoundsException(), NULL);
   }
-  // Compute how many chunks to skip and index into actual chunk
+  // Skip the chunks before the one holding index; they need not all
+  // be of the same length
   objArrayOop chunk = objArrayOop(backtrace(throwable));
-  int skip_chunks = index / trace_chunk_size;
-  int chunk_index = index % trace_chunk_size;
-  while (chunk != NULL && skip_chunks > 0) {
+  int chunk_index = index;
+  while (chunk != NULL && chunk_index >= BacktraceBuilder::get_mirrors(chunk)->length()) {
+    chunk_index -= BacktraceBuilder::get_mirrors(chunk)->length();
     chunk = objArrayOop(chunk->obj_at(trace_next_offset));
-        skip_chunks--;
   }
   if (chunk == NULL) {
     THROW_(vmSymbols::java_lang_IndexOutOfBoundsException(), NULL);
@@ -2705,6 +2735,42 @@ void java_lang_ref_ReferenceQueue::compute_offsets() {
                  vmSymbols::referencequeue_signature());
 }
 
+// Support for java_lang_ref_Finalizer
+
+void java_lang_ref_Finalizer::register_finalizee(Handle finalizee, TRAPS) {
+  assert(is_supported(), "must be");
+  InstanceKlass* ik = InstanceKlass::cast(SystemDictionary::Finalizer_klass());
+  instanceHandle f = ik->allocate_instance_handle(CHECK);
+  // As the Reference(referent, queue) constructor, with a non-null queue
+  java_lang_ref_Reference::set_referent(f(), finalizee());
+  f->obj_field_put(java_lang_ref_Reference::queue_offset,
+                   ik->java_mirror()->obj_field(_static_queue_offset));
+
+  Handle lock(THREAD, ik->java_mirror()->obj_field(_static_lock_offset));
+  ObjectLocker ol(lock, THREAD);
+  oop mirror = ik->java_mirror();
+  oop head = mirror->obj_field(_static_unfinalized_offset);
+  if (head != NULL) {
+    f->obj_field_put(_next_offset, head);
+    head->obj_field_put(_prev_offset, f());
+  }
+  mirror->obj_field_put(_static_unfinalized_offset, f());
+}
+
+void java_lang_ref_Finalizer::compute_offsets() {
+  Klass* k = SystemDictionary::Finalizer_klass();
+  compute_optional_offset(_next_offset, k,
+                          vmSymbols::finalizer_next_name(), vmSymbols::finalizer_signature());
+  compute_optional_offset(_prev_offset, k,
+                          vmSymbols::finalizer_prev_name(), vmSymbols::finalizer_signature());
+  compute_optional_offset(_static_queue_offset, k,
+                          vmSymbols::finalizer_queue_name(), vmSymbols::referencequeue_signature());
+  compute_optional_offset(_static_unfinalized_offset, k,
+                          vmSymbols::finalizer_unfinalized_name(), vmSymbols::finalizer_signature());
+  compute_optional_offset(_static_lock_offset, k,
+                          vmSymbols::reference_lock_name(), vmSymbols::object_signature());
+}
+
 // Support for java_lang_invoke_DirectMethodHandle
 
 int java_lang_invoke_DirectMethodHandle::_member_offset;
@@ -3225,6 +3291,11 @@ int java_lang_ref_Reference::static_pending_offset;
 int java_lang_ref_Reference::number_of_fake_oop_fields;
 int java_lang_ref_ReferenceQueue::static_NULL_queue_offset;
 int java_lang_ref_ReferenceQueue::static_ENQUEUED_queue_offset;
+int java_lang_ref_Finalizer::_next_offset;
+int java_lang_ref_Finalizer::_prev_offset;
+int java_lang_ref_Finalizer::_static_queue_offset;
+int java_lang_ref_Finalizer::_static_unfinalized_offset;
+int java_lang_ref_Finalizer::_static_lock_offset;
 int java_lang_ref_SoftReference::timestamp_offset;
 int java_lang_ref_SoftReference::static_clock_offset;
 int java_lang_ClassLoader::parent_offset;
@@ -3407,6 +3478,7 @@ void JavaClasses::compute_offsets() {
     java_lang_reflect_Parameter::compute_offsets();
 
   java_lang_ref_ReferenceQueue::compute_offsets();
+  java_lang_ref_Finalizer::compute_offsets();
 
   // generated interpreter code wants to know about the offsets we just computed:
   AbstractAssembler::update_delayed_values();
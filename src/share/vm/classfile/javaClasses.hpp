@@ -982,6 +982,31 @@ public:
   static void compute_offsets();
 };
 
+// Interface to java.lang.ref.Finalizer objects
+
+class java_lang_ref_Finalizer: public AllStatic {
+ private:
+  static int _next_offset;
+  static int _prev_offset;
+  static int _static_queue_offset;
+  static int _static_unfinalized_offset;
+  static int _static_lock_offset;
+
+ public:
+  // The fields are optional; without them finalizable objects are
+  // registered by calling Finalizer.register
+  static bool is_supported() {
+    return _next_offset != 0 && _prev_offset != 0 && _static_queue_offset != 0 &&
+           _static_unfinalized_offset != 0 && _static_lock_offset != 0;
+  }
+
+  // Does what Finalizer.register does: link a new Finalizer for
+  // finalizee at the head of the unfinalized list, under Finalizer.lock
+  static void register_finalizee(Handle finalizee, TRAPS);
+
+  static void compute_offsets();
+};
+
 // Interface to java.lang.invoke.MethodHandle objects
 
 class MethodHandleEntry;
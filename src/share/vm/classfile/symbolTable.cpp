@@ -51,6 +51,7 @@ SymbolTable* SymbolTable::_the_table = NULL;
 // Static arena for symbols that are not deallocated
 Arena* SymbolTable::_arena = NULL;
 bool SymbolTable::_needs_rehashing = false;
+bool SymbolTable::_needs_resizing = false;
 
 Symbol* SymbolTable::allocate_symbol(const u1* name, int len, bool c_heap, TRAPS) {
   assert (len <= Symbol::max_length(), "should be checked by caller");
@@ -198,6 +199,20 @@ void SymbolTable::rehash_table() {
   _the_table = new_table;
 }
 
+void SymbolTable::resize_table() {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
+  // The archived symbol table is written with its original size.
+  if (DumpSharedSpaces) return;
+  SymbolTable* new_table = new SymbolTable(the_table()->resized_table_size());
+
+  the_table()->resize_to(new_table);
+
+  // Delete the table and buckets (entries are reused in new table).
+  delete _the_table;
+  _needs_resizing = false;
+  _the_table = new_table;
+}
+
 // Lookup a symbol in a bucket.
 
 Symbol* SymbolTable::lookup(int index, const char* name,
@@ -428,6 +443,7 @@ Symbol* SymbolTable::basic_add(int index_arg, u1 *name, int len,
 
   HashtableEntry<Symbol*, mtSymbol>* entry = new_entry(hashValue, sym);
   add_entry(index, entry);
+  check_resize();
   return sym;
 }
 
@@ -479,6 +495,7 @@ bool SymbolTable::basic_add(ClassLoaderData* loader_data, constantPoolHandle cp,
       cp->symbol_at_put(cp_indices[i], sym);
     }
   }
+  check_resize();
   return true;
 }
 
@@ -645,6 +662,7 @@ class StableMemoryChecker : public StackObj {
 StringTable* StringTable::_the_table = NULL;
 
 bool StringTable::_needs_rehashing = false;
+bool StringTable::_needs_resizing = false;
 
 volatile int StringTable::_parallel_claimed_idx = 0;
 
@@ -704,6 +722,9 @@ oop StringTable::basic_add(int index_arg, Handle string, jchar* name,
 
   HashtableEntry<oop, mtSymbol>* entry = new_entry(hashValue, string());
   add_entry(index, entry);
+  if (ResizeSymbolAndStringTables && !_needs_resizing && check_resize_table()) {
+    _needs_resizing = true;
+  }
   return string();
 }
 
@@ -1121,3 +1142,16 @@ void StringTable::rehash_table() {
   _needs_rehashing = false;
   _the_table = new_table;
 }
+
+void StringTable::resize_table() {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
+  if (DumpSharedSpaces) return;
+  StringTable* new_table = new StringTable(the_table()->resized_table_size());
+
+  the_table()->resize_to(new_table);
+
+  // Delete the table and buckets (entries are reused in new table).
+  delete _the_table;
+  _needs_resizing = false;
+  _the_table = new_table;
+}
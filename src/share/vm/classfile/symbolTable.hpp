@@ -85,6 +85,9 @@ private:
   // Set if one bucket is out of balance due to hash algorithm deficiency
   static bool _needs_rehashing;
 
+  // Set if the table has too many entries for its size
+  static bool _needs_resizing;
+
   // For statistics
   static int _symbols_removed;
   static int _symbols_counted;
@@ -116,6 +119,15 @@ private:
     : RehashableHashtable<Symbol*, mtSymbol>(SymbolTableSize, sizeof (HashtableEntry<Symbol*, mtSymbol>), t,
                 number_of_entries) {}
 
+  SymbolTable(int table_size)
+    : RehashableHashtable<Symbol*, mtSymbol>(table_size, sizeof (HashtableEntry<Symbol*, mtSymbol>)) {}
+
+  void check_resize() {
+    if (ResizeSymbolAndStringTables && !_needs_resizing && check_resize_table()) {
+      _needs_resizing = true;
+    }
+  }
+
   // Arena for permanent symbols (null class loader) that are never unloaded
   static Arena*  _arena;
   static Arena* arena() { return _arena; }  // called for statistics
@@ -250,6 +262,10 @@ public:
   // Rehash the symbol table if it gets out of balance
   static void rehash_table();
   static bool needs_rehashing()         { return _needs_rehashing; }
+
+  // Grow the symbol table if it gets too full
+  static void resize_table();
+  static bool needs_resizing()          { return _needs_resizing; }
   // Parallel chunked scanning
   static void clear_parallel_claimed_index() { _parallel_claimed_idx = 0; }
   static int parallel_claimed_index()        { return _parallel_claimed_idx; }
@@ -265,6 +281,9 @@ private:
   // Set if one bucket is out of balance due to hash algorithm deficiency
   static bool _needs_rehashing;
 
+  // Set if the table has too many entries for its size
+  static bool _needs_resizing;
+
   // Claimed high water mark for parallel chunked scanning
   static volatile int _parallel_claimed_idx;
 
@@ -291,6 +310,9 @@ private:
   StringTable(HashtableBucket<mtSymbol>* t, int number_of_entries)
     : RehashableHashtable<oop, mtSymbol>((int)StringTableSize, sizeof (HashtableEntry<oop, mtSymbol>), t,
                      number_of_entries) {}
+
+  StringTable(int table_size)
+    : RehashableHashtable<oop, mtSymbol>(table_size, sizeof (HashtableEntry<oop, mtSymbol>)) {}
 public:
   // The string table
   static StringTable* the_table() { return _the_table; }
@@ -385,6 +407,10 @@ public:
   static void rehash_table();
   static bool needs_rehashing() { return _needs_rehashing; }
 
+  // Grow the string table if it gets too full
+  static void resize_table();
+  static bool needs_resizing() { return _needs_resizing; }
+
   // Parallel chunked scanning
   static void clear_parallel_claimed_index() { _parallel_claimed_idx = 0; }
   static int parallel_claimed_index() { return _parallel_claimed_idx; }
@@ -1238,12 +1238,20 @@ instanceKlassHandle SystemDictionary::load_shared_class(instanceKlassHandle ik,
     // Shared classes are all currently loaded by either the bootstrap or
     // internal parallel class loaders, so this will never cause a deadlock
     // on a custom class loader lock.
+    //
+    // For the bootstrap loader the LOAD_INSTANCE placeholder held by our
+    // caller already guarantees that only one thread restores a given
+    // class. Taking _system_loader_lock_obj as well would serialize all
+    // concurrent loads of unrelated shared boot classes.
 
     ClassLoaderData* loader_data = ClassLoaderData::class_loader_data(class_loader());
     {
+      bool do_object_lock = !class_loader.is_null();
       Handle lockObject = compute_loader_lock_object(class_loader, THREAD);
-      check_loader_lock_contention(lockObject, THREAD);
-      ObjectLocker ol(lockObject, THREAD, true);
+      if (do_object_lock) {
+        check_loader_lock_contention(lockObject, THREAD);
+      }
+      ObjectLocker ol(lockObject, THREAD, do_object_lock);
       ik->restore_unshareable_info(loader_data, protection_domain, CHECK_(nh));
     }
 
@@ -1260,9 +1268,7 @@ instanceKlassHandle SystemDictionary::load_shared_class(instanceKlassHandle ik,
     if (DumpLoadedClassList != NULL && classlist_file->is_open()) {
       // Only dump the classes that can be stored into CDS archive
       if (SystemDictionaryShared::is_sharing_possible(loader_data)) {
-        ResourceMark rm(THREAD);
-        classlist_file->print_cr("%s", ik->name()->as_C_string());
-        classlist_file->flush();
+        ClassLoader::record_loaded_class(ik->name());
       }
     }
 
@@ -2070,7 +2076,21 @@ void SystemDictionary::update_dictionary(int d_index, unsigned int d_hash,
     // NOTE that we must only do this when the class is initally
     // defined, not each time it is referenced from a new class loader
     if (k->class_loader() == class_loader()) {
-      k->set_prototype_header(markOopDesc::biased_locking_prototype());
+      Klass* super = k->super();
+      if (BiasedLockingInheritRevocation &&
+          super != NULL && super != SystemDictionary::Object_klass() &&
+          !super->prototype_header()->has_bias_pattern()) {
+        // Biasing of the superclass was revoked in bulk. Instances of
+        // subclasses are most likely shared between threads the same
+        // way, so do not pay for their revocations again.
+        if (TraceBiasedLocking) {
+          ResourceMark rm;
+          tty->print_cr("Not biasing %s, biasing of its superclass %s was revoked",
+                        k->external_name(), super->external_name());
+        }
+      } else {
+        k->set_prototype_header(markOopDesc::biased_locking_prototype());
+      }
     }
   }
 
@@ -29,6 +29,22 @@
 #include "classfile/dictionary.hpp"
 #include "classfile/systemDictionary.hpp"
 
+// Only the boot class loader can load classes from the shared archive.
+// This class holds the hooks an application class sharing implementation
+// would need to fill in:
+//  - find_or_load_shared_class() is called by JVM_FindLoadedClass for
+//    non-boot loaders before they try to define the class themselves;
+//  - is_sharing_possible() decides which loaders' classes are written to
+//    a DumpLoadedClassList and may be archived;
+//  - dictionary_entry_size() and init_shared_dictionary_entry() allow
+//    per-entry loader information in the shared dictionary;
+//  - the verification dependency functions record assignability checks
+//    made at dump time, which must be checked again at run time once the
+//    loaders involved are not known in advance.
+// Sharing for application loaders also needs the application class path
+// recorded in SharedPathsMiscInfo and validated when the archive is
+// mapped, and protection domains and packages defined for classes that
+// are loaded from the archive.
 class SystemDictionaryShared: public SystemDictionary {
 public:
   static void initialize(TRAPS) {}
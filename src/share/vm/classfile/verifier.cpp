@@ -527,6 +527,10 @@ ClassVerifier::ClassVerifier(
   _this_type = VerificationType::reference_type(klass->name());
   // Create list to hold symbols in reference area.
   _symbols = new GrowableArray<Symbol*>(100, 0, NULL);
+  // The verifier resolves classes under nested ResourceMarks, so the
+  // resolved class lists must not live in the resource area.
+  _loaded_names = new (ResourceObj::C_HEAP, mtClass) GrowableArray<Symbol*>(16, true, mtClass);
+  _loaded_klasses = new (ResourceObj::C_HEAP, mtClass) GrowableArray<Klass*>(16, true, mtClass);
 }
 
 ClassVerifier::~ClassVerifier() {
@@ -535,6 +539,8 @@ ClassVerifier::~ClassVerifier() {
     Symbol* s = _symbols->at(i);
     s->decrement_refcount();
   }
+  delete _loaded_names;
+  delete _loaded_klasses;
 }
 
 VerificationType ClassVerifier::object_type() const {
@@ -1945,6 +1951,13 @@ void ClassVerifier::class_format_error(const char* msg, ...) {
 }
 
 Klass* ClassVerifier::load_class(Symbol* name, TRAPS) {
+  // The dependency on a class found here has already been recorded and
+  // keeps it alive for as long as the class being verified.
+  int i = _loaded_names->find(name);
+  if (i >= 0) {
+    return _loaded_klasses->at(i);
+  }
+
   // Get current loader and protection domain first.
   oop loader = current_class()->class_loader();
   oop protection_domain = current_class()->protection_domain();
@@ -1953,6 +1966,8 @@ Klass* ClassVerifier::load_class(Symbol* name, TRAPS) {
     name, Handle(THREAD, loader), Handle(THREAD, protection_domain),
     true, CHECK_NULL);
   current_class()->class_loader_data()->record_dependency(kls, CHECK_NULL);
+  _loaded_names->append(name);
+  _loaded_klasses->append(kls);
   return kls;
 }
 
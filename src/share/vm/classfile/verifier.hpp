@@ -254,6 +254,12 @@ class ClassVerifier : public StackObj {
   Thread* _thread;
   GrowableArray<Symbol*>* _symbols;  // keep a list of symbols created
 
+  // Classes already resolved on behalf of this class, so that repeated
+  // assignability checks against the same name need not go through the
+  // system dictionary and dependency recording again.
+  GrowableArray<Symbol*>* _loaded_names;
+  GrowableArray<Klass*>*  _loaded_klasses;
+
   Symbol* _exception_type;
   char* _message;
 
@@ -398,6 +404,7 @@ class ClassVerifier : public StackObj {
   void verify_error(ErrorContext ctx, const char* fmt, ...) ATTRIBUTE_PRINTF(3, 4);
   void class_format_error(const char* fmt, ...) ATTRIBUTE_PRINTF(2, 3);
 
+  // Resolves name in the context of the class being verified.
   Klass* load_class(Symbol* name, TRAPS);
 
   int change_sig_to_verificationType(
@@ -45,6 +45,7 @@
 #include "runtime/icache.hpp"
 #include "runtime/java.hpp"
 #include "runtime/mutexLocker.hpp"
+#include "runtime/sweeper.hpp"
 #include "services/memoryService.hpp"
 #include "trace/tracing.hpp"
 #include "utilities/xmlstream.hpp"
@@ -118,7 +119,10 @@ class CodeBlob_sizes {
 
 // CodeCache implementation
 
-CodeHeap * CodeCache::_heap = new CodeHeap();
+CodeHeap* CodeCache::_heaps[CodeBlobType::All] = { NULL, NULL, NULL };
+int CodeCache::_number_of_heaps = 0;
+address CodeCache::_low_bound = NULL;
+address CodeCache::_high_bound = NULL;
 int CodeCache::_number_of_blobs = 0;
 int CodeCache::_number_of_adapters = 0;
 int CodeCache::_number_of_nmethods = 0;
@@ -128,15 +132,42 @@ nmethod* CodeCache::_scavenge_root_nmethods = NULL;
 
 int CodeCache::_codemem_full_count = 0;
 
+#define FOR_ALL_HEAPS(index) for (int index = 0; index < _number_of_heaps; index++)
+
+// Heaps of this type never hold nmethods, see allocate().
+static bool skip_heap(CodeHeap* heap, bool nmethods_only) {
+  return nmethods_only && heap->code_blob_type() == CodeBlobType::NonNMethod;
+}
+
+CodeBlob* CodeCache::first_blob(int heap_index, bool nmethods_only) {
+  for (int i = heap_index; i < _number_of_heaps; i++) {
+    if (skip_heap(_heaps[i], nmethods_only)) continue;
+    CodeBlob* cb = (CodeBlob*)_heaps[i]->first();
+    if (cb != NULL) return cb;
+  }
+  return NULL;
+}
+
+CodeBlob* CodeCache::next_blob(CodeBlob* cb, bool nmethods_only) {
+  FOR_ALL_HEAPS(i) {
+    if (_heaps[i]->contains(cb)) {
+      CodeBlob* next = (CodeBlob*)_heaps[i]->next(cb);
+      return next != NULL ? next : first_blob(i + 1, nmethods_only);
+    }
+  }
+  ShouldNotReachHere();
+  return NULL;
+}
+
 CodeBlob* CodeCache::first() {
   assert_locked_or_safepoint(CodeCache_lock);
-  return (CodeBlob*)_heap->first();
+  return first_blob(0, false);
 }
 
 
 CodeBlob* CodeCache::next(CodeBlob* cb) {
   assert_locked_or_safepoint(CodeCache_lock);
-  return (CodeBlob*)_heap->next(cb);
+  return next_blob(cb, false);
 }
 
 
@@ -155,25 +186,73 @@ nmethod* CodeCache::alive_nmethod(CodeBlob* cb) {
 
 nmethod* CodeCache::first_nmethod() {
   assert_locked_or_safepoint(CodeCache_lock);
-  CodeBlob* cb = first();
+  CodeBlob* cb = first_blob(0, true);
   while (cb != NULL && !cb->is_nmethod()) {
-    cb = next(cb);
+    cb = next_blob(cb, true);
   }
   return (nmethod*)cb;
 }
 
 nmethod* CodeCache::next_nmethod (CodeBlob* cb) {
   assert_locked_or_safepoint(CodeCache_lock);
-  cb = next(cb);
+  cb = next_blob(cb, true);
   while (cb != NULL && !cb->is_nmethod()) {
-    cb = next(cb);
+    cb = next_blob(cb, true);
   }
   return (nmethod*)cb;
 }
 
+CodeHeap* CodeCache::get_code_heap(CodeBlob* cb) {
+  FOR_ALL_HEAPS(i) {
+    if (_heaps[i]->contains(cb)) {
+      return _heaps[i];
+    }
+  }
+  ShouldNotReachHere();
+  return NULL;
+}
+
+CodeHeap* CodeCache::get_code_heap(int code_blob_type) {
+  FOR_ALL_HEAPS(i) {
+    if (_heaps[i]->code_blob_type() == CodeBlobType::All ||
+        _heaps[i]->code_blob_type() == code_blob_type) {
+      return _heaps[i];
+    }
+  }
+  return NULL;
+}
+
+int CodeCache::get_code_blob_type(int comp_level) {
+  if (!SegmentedCodeCache) {
+    return CodeBlobType::All;
+  }
+  if (comp_level == CompLevel_limited_profile ||
+      comp_level == CompLevel_full_profile) {
+    return CodeBlobType::MethodProfiled;
+  }
+  // Native wrappers, C1 code without profiling and C2 code
+  return CodeBlobType::MethodNonProfiled;
+}
+
+// Heap to try when the heap for code_blob_type is full:
+// NonNMethod -> MethodNonProfiled -> MethodProfiled and
+// MethodProfiled -> MethodNonProfiled. Returns -1 when there is none left.
+static int fallback_code_blob_type(int code_blob_type, int orig_code_blob_type) {
+  switch (code_blob_type) {
+  case CodeBlobType::NonNMethod:
+    return CodeBlobType::MethodNonProfiled;
+  case CodeBlobType::MethodNonProfiled:
+    return orig_code_blob_type == CodeBlobType::MethodProfiled ? -1 : CodeBlobType::MethodProfiled;
+  case CodeBlobType::MethodProfiled:
+    return orig_code_blob_type == CodeBlobType::MethodProfiled ? CodeBlobType::MethodNonProfiled : -1;
+  default:
+    return -1;
+  }
+}
+
 static size_t maxCodeCacheUsed = 0;
 
-CodeBlob* CodeCache::allocate(int size, bool is_critical) {
+CodeBlob* CodeCache::allocate(int size, int code_blob_type, bool is_critical) {
   // Do not seize the CodeCache lock here--if the caller has not
   // already done so, we are going to lose bigtime, since the code
   // cache will contain a garbage CodeBlob until the caller can
@@ -182,23 +261,32 @@ CodeBlob* CodeCache::allocate(int size, bool is_critical) {
   guarantee(size >= 0, "allocation request must be reasonable");
   assert_locked_or_safepoint(CodeCache_lock);
   CodeBlob* cb = NULL;
+  CodeHeap* heap = get_code_heap(code_blob_type);
+  assert(heap != NULL, "no code heap for this CodeBlobType");
   _number_of_blobs++;
   while (true) {
-    cb = (CodeBlob*)_heap->allocate(size, is_critical);
+    cb = (CodeBlob*)heap->allocate(size, is_critical);
     if (cb != NULL) break;
-    if (!_heap->expand_by(CodeCacheExpansionSize)) {
+    if (!heap->expand_by(CodeCacheExpansionSize)) {
       // Expansion failed
+      if (SegmentedCodeCache) {
+        // Fallback solution: store the code in another code heap.
+        int type = fallback_code_blob_type(heap->code_blob_type(), code_blob_type);
+        if (type >= 0) {
+          heap = get_code_heap(type);
+          continue;
+        }
+      }
       return NULL;
     }
     if (PrintCodeCacheExtension) {
       ResourceMark rm;
-      tty->print_cr("code cache extended to [" INTPTR_FORMAT ", " INTPTR_FORMAT "] (" SSIZE_FORMAT " bytes)",
-                    (intptr_t)_heap->low_boundary(), (intptr_t)_heap->high(),
-                    (address)_heap->high() - (address)_heap->low_boundary());
+      tty->print_cr("%s extended to [" INTPTR_FORMAT ", " INTPTR_FORMAT "] (" SSIZE_FORMAT " bytes)",
+                    heap->name(), (intptr_t)heap->low_boundary(), (intptr_t)heap->high(),
+                    (address)heap->high() - (address)heap->low_boundary());
     }
   }
-  maxCodeCacheUsed = MAX2(maxCodeCacheUsed, ((address)_heap->high_boundary() -
-                          (address)_heap->low_boundary()) - unallocated_capacity());
+  maxCodeCacheUsed = MAX2(maxCodeCacheUsed, (size_t)(high_bound() - low_bound()) - unallocated_capacity());
   verify_if_often();
   print_trace("allocation", cb, size);
   return cb;
@@ -220,7 +308,7 @@ void CodeCache::free(CodeBlob* cb) {
   }
   _number_of_blobs--;
 
-  _heap->deallocate(cb);
+  get_code_heap(cb)->deallocate(cb);
 
   verify_if_often();
   assert(_number_of_blobs >= 0, "sanity check");
@@ -260,7 +348,12 @@ void CodeCache::flush() {
 
 bool CodeCache::contains(void *p) {
   // It should be ok to call contains without holding a lock
-  return _heap->contains(p);
+  FOR_ALL_HEAPS(i) {
+    if (_heaps[i]->contains(p)) {
+      return true;
+    }
+  }
+  return false;
 }
 
 
@@ -305,12 +398,12 @@ void CodeCache::alive_nmethods_do(void f(nmethod* nm)) {
 }
 
 int CodeCache::alignment_unit() {
-  return (int)_heap->alignment_unit();
+  return (int)_heaps[0]->alignment_unit();
 }
 
 
 int CodeCache::alignment_offset() {
-  return (int)_heap->alignment_offset();
+  return (int)_heaps[0]->alignment_offset();
 }
 
 
@@ -556,23 +649,60 @@ void CodeCache::verify_oops() {
 
 address CodeCache::first_address() {
   assert_locked_or_safepoint(CodeCache_lock);
-  return (address)_heap->low_boundary();
+  return low_bound();
 }
 
 
 address CodeCache::last_address() {
   assert_locked_or_safepoint(CodeCache_lock);
-  return (address)_heap->high();
+  return high();
+}
+
+size_t CodeCache::capacity() {
+  size_t cap = 0;
+  FOR_ALL_HEAPS(i) {
+    cap += _heaps[i]->capacity();
+  }
+  return cap;
+}
+
+size_t CodeCache::max_capacity() {
+  size_t max_cap = 0;
+  FOR_ALL_HEAPS(i) {
+    max_cap += _heaps[i]->max_capacity();
+  }
+  return max_cap;
+}
+
+size_t CodeCache::unallocated_capacity() {
+  size_t unallocated_cap = 0;
+  FOR_ALL_HEAPS(i) {
+    unallocated_cap += _heaps[i]->unallocated_capacity();
+  }
+  return unallocated_cap;
+}
+
+size_t CodeCache::unallocated_capacity(int code_blob_type) {
+  CodeHeap* heap = get_code_heap(code_blob_type);
+  return (heap != NULL) ? heap->unallocated_capacity() : 0;
 }
 
 /**
  * Returns the reverse free ratio. E.g., if 25% (1/4) of the code cache
- * is free, reverse_free_ratio() returns 4.
+ * is free, reverse_free_ratio() returns 4. With a segmented code cache
+ * the fullest heap holding nmethods decides, since that is where the
+ * sweeper can make room.
  */
 double CodeCache::reverse_free_ratio() {
-  double unallocated_capacity = (double)(CodeCache::unallocated_capacity() - CodeCacheMinimumFreeSpace);
-  double max_capacity = (double)CodeCache::max_capacity();
-  return max_capacity / unallocated_capacity;
+  double ratio = 0.0;
+  FOR_ALL_HEAPS(i) {
+    CodeHeap* heap = _heaps[i];
+    if (skip_heap(heap, true)) continue;
+    double unallocated_capacity = (double)(heap->unallocated_capacity() - CodeCacheMinimumFreeSpace);
+    double max_capacity = (double)heap->max_capacity();
+    ratio = MAX2(ratio, max_capacity / unallocated_capacity);
+  }
+  return ratio;
 }
 
 void icache_init();
@@ -589,11 +719,15 @@ void CodeCache::initialize() {
   CodeCacheExpansionSize = round_to(CodeCacheExpansionSize, os::vm_page_size());
   InitialCodeCacheSize = round_to(InitialCodeCacheSize, os::vm_page_size());
   ReservedCodeCacheSize = round_to(ReservedCodeCacheSize, os::vm_page_size());
-  if (!_heap->reserve(ReservedCodeCacheSize, InitialCodeCacheSize, CodeCacheSegmentSize)) {
-    vm_exit_during_initialization("Could not reserve enough space for code cache");
+  const size_t code_page_size = os::code_cache_large_page_size();
+  if (code_page_size > 0 && ReservedCodeCacheSize >= code_page_size) {
+    // Commit in whole huge pages so that the expanded code heap can be
+    // backed by them right away.
+    CodeCacheExpansionSize = round_to(CodeCacheExpansionSize, code_page_size);
+    InitialCodeCacheSize = round_to(InitialCodeCacheSize, code_page_size);
+    ReservedCodeCacheSize = round_to(ReservedCodeCacheSize, code_page_size);
   }
-
-  MemoryService::add_code_heap_memory_pool(_heap);
+  initialize_heaps();
 
   // Initialize ICache flush mechanism
   // This service is needed for os::register_code_area
@@ -602,7 +736,86 @@ void CodeCache::initialize() {
   // Give OS a chance to register generated code area.
   // This is used on Windows 64 bit platforms to register
   // Structured Exception Handlers for our generated code.
-  os::register_code_area(_heap->low_boundary(), _heap->high_boundary());
+  os::register_code_area((char*)low_bound(), (char*)high_bound());
+}
+
+void CodeCache::initialize_heaps() {
+  // Reserve the whole code cache at once so that all code stays within
+  // the branch range assumed by low_bound() and high_bound().
+  size_t page_size = os::vm_page_size();
+  if (os::can_execute_large_page_memory()) {
+    page_size = os::page_size_for_region_unaligned(ReservedCodeCacheSize, 8);
+  }
+  const bool large = page_size != (size_t) os::vm_page_size();
+  const size_t granularity = os::vm_allocation_granularity();
+  size_t r_align = MAX2(page_size, granularity);
+  // Huge pages for the code cache only: the space is reserved and committed
+  // as normal memory, but aligned so that every code heap starts and ends
+  // on a huge page boundary.
+  bool huge_aligned = false;
+  const size_t code_page_size = os::code_cache_large_page_size();
+  if (code_page_size > r_align && ReservedCodeCacheSize >= code_page_size) {
+    r_align = code_page_size;
+    huge_aligned = true;
+  }
+  const size_t r_size = align_size_up(ReservedCodeCacheSize, r_align);
+  const size_t rs_align = (large || huge_aligned) ? r_align : 0;
+  ReservedCodeSpace rs(r_size, rs_align, large);
+  if (!rs.is_reserved()) {
+    vm_exit_during_initialization("Could not reserve enough space for code cache");
+  }
+  _low_bound  = (address)rs.base();
+  _high_bound = _low_bound + rs.size();
+
+  if (!SegmentedCodeCache) {
+    add_heap(rs, "Code Cache", InitialCodeCacheSize, CodeBlobType::All);
+    return;
+  }
+
+  // Size the segments. Unset sizes share what the others leave.
+  const size_t total_size = rs.size();
+  size_t non_nmethod_size  = align_size_up(NonNMethodCodeHeapSize, r_align);
+  size_t profiled_size     = ProfiledCodeHeapSize;
+  size_t non_profiled_size = NonProfiledCodeHeapSize;
+  if (non_nmethod_size + 2 * r_align > total_size) {
+    vm_exit_during_initialization("Invalid code heap sizes",
+                                  "NonNMethodCodeHeapSize leaves no space for nmethods in ReservedCodeCacheSize");
+  }
+  size_t method_size = total_size - non_nmethod_size;
+  if (FLAG_IS_DEFAULT(ProfiledCodeHeapSize) && FLAG_IS_DEFAULT(NonProfiledCodeHeapSize)) {
+    profiled_size = method_size / 2;
+  } else if (FLAG_IS_DEFAULT(ProfiledCodeHeapSize)) {
+    profiled_size = method_size - MIN2(non_profiled_size, method_size - r_align);
+  } else if (!FLAG_IS_DEFAULT(NonProfiledCodeHeapSize) &&
+             NonNMethodCodeHeapSize + profiled_size + non_profiled_size != ReservedCodeCacheSize) {
+    vm_exit_during_initialization("Invalid code heap sizes",
+                                  "NonNMethodCodeHeapSize + ProfiledCodeHeapSize + NonProfiledCodeHeapSize must equal ReservedCodeCacheSize");
+  }
+  profiled_size = MIN2((size_t)align_size_up(MAX2(profiled_size, r_align), r_align), method_size - r_align);
+  non_profiled_size = method_size - profiled_size;
+
+  // Layout: non-nmethods | profiled nmethods | non-profiled nmethods
+  ReservedSpace non_nmethod_space  = rs.first_part(non_nmethod_size);
+  ReservedSpace method_space       = rs.last_part(non_nmethod_size);
+  ReservedSpace profiled_space     = method_space.first_part(profiled_size);
+  ReservedSpace non_profiled_space = method_space.last_part(profiled_size);
+
+  add_heap(non_nmethod_space,  "CodeHeap 'non-nmethods'",         InitialCodeCacheSize, CodeBlobType::NonNMethod);
+  add_heap(profiled_space,     "CodeHeap 'profiled nmethods'",    InitialCodeCacheSize, CodeBlobType::MethodProfiled);
+  add_heap(non_profiled_space, "CodeHeap 'non-profiled nmethods'", InitialCodeCacheSize, CodeBlobType::MethodNonProfiled);
+}
+
+void CodeCache::add_heap(ReservedSpace rs, const char* name, size_t size_initial, int code_blob_type) {
+  assert(_number_of_heaps < CodeBlobType::All, "too many code heaps");
+  CodeHeap* heap = new CodeHeap(name, code_blob_type);
+  size_initial = round_to(MIN2(size_initial, rs.size()), os::vm_page_size());
+  if (!heap->reserve(rs, size_initial, CodeCacheSegmentSize)) {
+    vm_exit_during_initialization("Could not reserve enough space for code cache");
+  }
+  _heaps[_number_of_heaps++] = heap;
+
+  // Register the CodeHeap
+  MemoryService::add_code_heap_memory_pool(heap, name);
 }
 
 
@@ -747,7 +960,9 @@ void CodeCache::make_marked_nmethods_not_entrant() {
 }
 
 void CodeCache::verify() {
-  _heap->verify();
+  FOR_ALL_HEAPS(i) {
+    _heaps[i]->verify();
+  }
   FOR_ALL_ALIVE_BLOBS(p) {
     p->verify();
   }
@@ -776,7 +991,9 @@ void CodeCache::report_codemem_full() {
 
 void CodeCache::verify_if_often() {
   if (VerifyCodeCacheOften) {
-    _heap->verify();
+    FOR_ALL_HEAPS(i) {
+      _heaps[i]->verify();
+    }
   }
 }
 
@@ -948,17 +1165,27 @@ void CodeCache::print() {
 }
 
 void CodeCache::print_summary(outputStream* st, bool detailed) {
-  size_t total = (_heap->high_boundary() - _heap->low_boundary());
+  size_t total = (high_bound() - low_bound());
   st->print_cr("CodeCache: size=" SIZE_FORMAT "Kb used=" SIZE_FORMAT
                "Kb max_used=" SIZE_FORMAT "Kb free=" SIZE_FORMAT "Kb",
                total/K, (total - unallocated_capacity())/K,
                maxCodeCacheUsed/K, unallocated_capacity()/K);
 
   if (detailed) {
-    st->print_cr(" bounds [" INTPTR_FORMAT ", " INTPTR_FORMAT ", " INTPTR_FORMAT "]",
-                 p2i(_heap->low_boundary()),
-                 p2i(_heap->high()),
-                 p2i(_heap->high_boundary()));
+    FOR_ALL_HEAPS(i) {
+      CodeHeap* heap = _heaps[i];
+      if (SegmentedCodeCache) {
+        st->print_cr(" %s: size=" SIZE_FORMAT "Kb used=" SIZE_FORMAT
+                     "Kb max_used=" SIZE_FORMAT "Kb free=" SIZE_FORMAT "Kb",
+                     heap->name(), heap->max_capacity()/K,
+                     (heap->max_capacity() - heap->unallocated_capacity())/K,
+                     heap->max_allocated_capacity()/K, heap->unallocated_capacity()/K);
+      }
+      st->print_cr(" bounds [" INTPTR_FORMAT ", " INTPTR_FORMAT ", " INTPTR_FORMAT "]",
+                   p2i(heap->low_boundary()),
+                   p2i(heap->high()),
+                   p2i(heap->high_boundary()));
+    }
     st->print_cr(" total_blobs=" UINT32_FORMAT " nmethods=" UINT32_FORMAT
                  " adapters=" UINT32_FORMAT,
                  nof_blobs(), nof_nmethods(), nof_adapters());
@@ -969,6 +1196,126 @@ void CodeCache::print_summary(outputStream* st, bool detailed) {
   }
 }
 
+void CodeCache::print_analytics(outputStream* st, int top) {
+  ResourceMark rm;
+  // Holding the lock without safepoint checks keeps the blobs from being
+  // flushed and the methods of the nmethods from being unloaded.
+  MutexLockerEx mu(CodeCache_lock, Mutex::_no_safepoint_check_flag);
+
+  print_summary(st);
+
+  st->print_cr("Free space:");
+  FOR_ALL_HEAPS(i) {
+    _heaps[i]->print_free_blocks(st);
+  }
+
+  // By tier, level 0 being the native wrappers
+  const int levels = CompLevel_full_optimization + 1;
+  int    in_use[levels];
+  size_t in_use_bytes[levels];
+  memset(in_use, 0, sizeof(in_use));
+  memset(in_use_bytes, 0, sizeof(in_use_bytes));
+  int    not_entrant = 0;
+  size_t not_entrant_bytes = 0;
+  int    dead = 0;
+  size_t dead_bytes = 0;
+  int    stubs = 0;
+  size_t stubs_bytes = 0;
+
+  // By the sweeps since the nmethod was last seen on a stack, as told by
+  // its hotness counter, in quarters of the counter's reset value.
+  const int reset = NMethodSweeper::hotness_counter_reset_val();
+  const int quarters = 4;
+  int    hotness[quarters + 1];
+  size_t hotness_bytes[quarters + 1];
+  memset(hotness, 0, sizeof(hotness));
+  memset(hotness_bytes, 0, sizeof(hotness_bytes));
+
+  CodeBlob** largest = NEW_RESOURCE_ARRAY(CodeBlob*, MAX2(top, 1));
+  int num_largest = 0;
+
+  FOR_ALL_BLOBS(cb) {
+    size_t size = cb->size();
+    if (!cb->is_nmethod()) {
+      stubs++;
+      stubs_bytes += size;
+    } else {
+      nmethod* nm = (nmethod*)cb;
+      if (nm->is_in_use()) {
+        int level = MIN2(MAX2(nm->comp_level(), 0), levels - 1);
+        in_use[level]++;
+        in_use_bytes[level] += size;
+        if (nm->is_java_method()) {
+          int swept = reset - nm->hotness_counter();
+          int q = swept <= 0 ? 0 : MIN2((swept - 1) * quarters / MAX2(reset, 1) + 1, quarters);
+          hotness[q]++;
+          hotness_bytes[q] += size;
+        }
+      } else if (nm->is_not_entrant()) {
+        not_entrant++;
+        not_entrant_bytes += size;
+      } else {
+        dead++;
+        dead_bytes += size;
+      }
+    }
+
+    if (top > 0 && cb->is_alive()) {
+      // Insertion into the blobs sorted by decreasing size
+      int i = num_largest < top ? num_largest++ : top;
+      while (i > 0 && (size_t)largest[i - 1]->size() < size) {
+        if (i < top) {
+          largest[i] = largest[i - 1];
+        }
+        i--;
+      }
+      if (i < top) {
+        largest[i] = cb;
+      }
+    }
+  }
+
+  st->print_cr("NMethods in use by tier:");
+  for (int level = 0; level < levels; level++) {
+    if (in_use[level] > 0) {
+      st->print_cr(" %s: %6d, " SIZE_FORMAT_W(7) "Kb",
+                   level == 0 ? "native" : err_msg("tier %d", level).buffer(),
+                   in_use[level], in_use_bytes[level] / K);
+    }
+  }
+  st->print_cr(" not entrant: %6d, " SIZE_FORMAT_W(7) "Kb", not_entrant, not_entrant_bytes / K);
+  st->print_cr(" zombie or unloaded: %6d, " SIZE_FORMAT_W(7) "Kb", dead, dead_bytes / K);
+  st->print_cr(" other blobs: %6d, " SIZE_FORMAT_W(7) "Kb", stubs, stubs_bytes / K);
+
+  st->print_cr("Java nmethods in use by sweeps since last seen active, "
+               "in %% of the hotness counter reset value %d:", reset);
+  for (int q = 0; q <= quarters; q++) {
+    if (q == 0) {
+      st->print(" active at the last sweep:");
+    } else if (q < quarters) {
+      st->print(" up to %d%%:", q * 100 / quarters);
+    } else {
+      st->print(" over %d%%:", (q - 1) * 100 / quarters);
+    }
+    st->print_cr(" %6d, " SIZE_FORMAT_W(7) "Kb", hotness[q], hotness_bytes[q] / K);
+  }
+
+  if (num_largest > 0) {
+    st->print_cr("Largest %d blobs:", num_largest);
+    for (int i = 0; i < num_largest; i++) {
+      CodeBlob* cb = largest[i];
+      st->print(" " SIZE_FORMAT_W(7) "Kb " INTPTR_FORMAT " ", (size_t)cb->size() / K, p2i(cb));
+      if (cb->is_nmethod()) {
+        nmethod* nm = (nmethod*)cb;
+        st->print_cr("%s [tier %d%s]", nm->method()->name_and_sig_as_C_string(), nm->comp_level(),
+                     nm->is_not_entrant() ? ", not entrant" : "");
+      } else {
+        st->print_cr("%s", cb->name());
+      }
+    }
+  }
+}
+
 void CodeCache::log_state(outputStream* st) {
   st->print(" total_blobs='" UINT32_FORMAT "' nmethods='" UINT32_FORMAT "'"
             " adapters='" UINT32_FORMAT "' free_code_cache='" SIZE_FORMAT "'",
@@ -39,6 +39,13 @@
 //   - Each CodeBlob occupies one chunk of memory.
 //   - Like the offset table in oldspace the zone has at table for
 //     locating a method given a addess of an instruction.
+//
+// With -XX:+SegmentedCodeCache the reserved space is split into one
+// CodeHeap per CodeBlobType:
+//   - Non-nmethods: stubs, adapters, buffers and other non-nmethod code
+//   - Profiled nmethods: tier 2 and 3 code, which is short lived
+//   - Non-profiled nmethods: tier 1 and 4 code and native wrappers
+// Otherwise a single CodeHeap of type CodeBlobType::All holds everything.
 
 class OopClosure;
 class DepChange;
@@ -50,7 +57,10 @@ class CodeCache : AllStatic {
   // so that the generated assembly code is always there when it's needed.
   // This may cause memory leak, but is necessary, for now. See 4423824,
   // 4422213 or 4436291 for details.
-  static CodeHeap * _heap;
+  static CodeHeap* _heaps[CodeBlobType::All];   // one per segment, or a single heap of type All
+  static int _number_of_heaps;
+  static address _low_bound;                     // lower bound of the reserved space
+  static address _high_bound;                    // upper bound of the reserved space
   static int _number_of_blobs;
   static int _number_of_adapters;
   static int _number_of_nmethods;
@@ -65,15 +75,26 @@ class CodeCache : AllStatic {
 
   static int _codemem_full_count;
 
+  // CodeHeap management
+  static void initialize_heaps();                             // Initializes the CodeHeaps
+  static void add_heap(ReservedSpace rs, const char* name, size_t size_initial, int code_blob_type);
+  static CodeHeap* get_code_heap(CodeBlob* cb);               // Returns the CodeHeap for the given CodeBlob
+  static CodeHeap* get_code_heap(int code_blob_type);         // Returns the CodeHeap for the given CodeBlobType
+  static CodeBlob* first_blob(int heap_index, bool nmethods_only); // First CodeBlob of the heaps starting at heap_index
+  static CodeBlob* next_blob(CodeBlob* cb, bool nmethods_only);    // CodeBlob following cb, possibly in a later heap
+
  public:
 
   // Initialization
   static void initialize();
 
+  // Returns the CodeBlobType for nmethods of the given compilation level
+  static int get_code_blob_type(int comp_level);
+
   static void report_codemem_full();
 
   // Allocation/administration
-  static CodeBlob* allocate(int size, bool is_critical = false); // allocates a new CodeBlob
+  static CodeBlob* allocate(int size, int code_blob_type, bool is_critical = false); // allocates a new CodeBlob
   static void commit(CodeBlob* cb);                 // called when the allocated CodeBlob has been filled
   static int alignment_unit();                      // guaranteed alignment of all CodeBlobs
   static int alignment_offset();                    // guaranteed offset of first CodeBlob byte within alignment unit (i.e., allocation header)
@@ -93,9 +114,13 @@ class CodeCache : AllStatic {
   // what you are doing)
   static CodeBlob* find_blob_unsafe(void* start) {
     // NMT can walk the stack before code cache is created
-    if (_heap == NULL) return NULL;
-
-    CodeBlob* result = (CodeBlob*)_heap->find_start(start);
+    CodeBlob* result = NULL;
+    for (int i = 0; i < _number_of_heaps; i++) {
+      if (_heaps[i]->contains(start)) {
+        result = (CodeBlob*)_heaps[i]->find_start(start);
+        break;
+      }
+    }
     // this assert is too strong because the heap code will return the
     // heapblock containing start. That block can often be larger than
     // the codeBlob itself. If you look up an address that is within
@@ -149,19 +174,23 @@ class CodeCache : AllStatic {
   static void verify();                          // verifies the code cache
   static void print_trace(const char* event, CodeBlob* cb, int size = 0) PRODUCT_RETURN;
   static void print_summary(outputStream* st, bool detailed = true); // Prints a summary of the code cache usage
+  // Prints the free space by block size, the nmethods by tier and hotness
+  // and the top largest blobs, for Compiler.codecache
+  static void print_analytics(outputStream* st, int top);
   static void log_state(outputStream* st);
 
   // The full limits of the codeCache
-  static address  low_bound()                    { return (address) _heap->low_boundary(); }
-  static address  high_bound()                   { return (address) _heap->high_boundary(); }
-  static address  high()                         { return (address) _heap->high(); }
+  static address  low_bound()                    { return _low_bound; }
+  static address  high_bound()                   { return _high_bound; }
+  static address  high()                         { return (address) _heaps[_number_of_heaps - 1]->high(); }
 
   // Profiling
   static address first_address();                // first address used for CodeBlobs
   static address last_address();                 // last  address used for CodeBlobs
-  static size_t  capacity()                      { return _heap->capacity(); }
-  static size_t  max_capacity()                  { return _heap->max_capacity(); }
-  static size_t  unallocated_capacity()          { return _heap->unallocated_capacity(); }
+  static size_t  capacity();
+  static size_t  max_capacity();
+  static size_t  unallocated_capacity();
+  static size_t  unallocated_capacity(int code_blob_type);
   static double  reverse_free_ratio();
 
   static bool needs_cache_clean()                { return _needs_cache_clean; }
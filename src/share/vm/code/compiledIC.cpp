@@ -109,8 +109,9 @@ void CompiledIC::internal_set_ic_destination(address entry_point, bool is_icstub
 
   if (is_optimized() || is_icstub) {
     // Optimized call sites don't have a cache value and ICStub call
-    // sites only change the entry point.  Changing the value in that
-    // case could lead to MT safety issues.
+    // sites (as well as direct megamorphic vtable transitions) only
+    // change the entry point.  Changing the value in that case could
+    // lead to MT safety issues.
     assert(cache == NULL, "must be null");
     return;
   }
@@ -244,7 +245,15 @@ bool CompiledIC::set_to_megamorphic(CallInfo* call_info, Bytecodes::Code bytecod
     if (entry == NULL) {
       return false;
     }
-    InlineCacheBuffer::create_transition_stub(this, NULL, entry);
+    if (!is_in_transition_state() && is_call_to_compiled()) {
+      // Vtable stubs never read the cached value, so a monomorphic call to
+      // compiled code can go megamorphic by patching the call alone, without
+      // a transition stub. The receiver klass left in the cached value is
+      // still a valid klass and is cleaned with the IC when it gets unloaded.
+      set_ic_destination_keep_value(entry);
+    } else {
+      InlineCacheBuffer::create_transition_stub(this, NULL, entry);
+    }
   }
 
   if (TraceICs) {
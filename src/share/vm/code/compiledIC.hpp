@@ -165,6 +165,11 @@ class CompiledIC: public ResourceObj {
     assert(_is_optimized, "use set_ic_destination_and_value instead");
     internal_set_ic_destination(entry_point, false, NULL, false);
   }
+  // Only patches the call; the cached value is left as it is
+  void set_ic_destination_keep_value(address entry_point) {
+    assert(!_is_optimized, "use set_ic_destination instead");
+    internal_set_ic_destination(entry_point, true, NULL, false);
+  }
   // This only for use by ICStubs where the type of the value isn't known
   void set_ic_destination_and_value(address entry_point, void* value) {
     internal_set_ic_destination(entry_point, false, value, is_icholder_entry(entry_point));
@@ -235,9 +235,10 @@ struct dir_stats_struct {
 
 
 int DebugInformationRecorder::find_sharable_decode_offset(int stream_offset) {
-  // Only pull this trick if non-safepoint recording
-  // is enabled, for now.
-  if (!recording_non_safepoints())
+  // Safepoint debug info is shared as well unless ShareScopeDebugInfo is
+  // off. Equal bytes decode the same way at every PcDesc: object values are
+  // written relative to the PcDesc's own object pool.
+  if (!recording_non_safepoints() && !ShareScopeDebugInfo)
     return serialized_null;
 
   NOT_PRODUCT(++dir_stats.chunks_queried);
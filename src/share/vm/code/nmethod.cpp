@@ -27,6 +27,7 @@
 #include "code/compiledIC.hpp"
 #include "code/dependencies.hpp"
 #include "code/nmethod.hpp"
+#include "code/perfMap.hpp"
 #include "code/scopeDesc.hpp"
 #include "compiler/abstractCompiler.hpp"
 #include "compiler/compileBroker.hpp"
@@ -233,10 +234,10 @@ ExceptionCache::ExceptionCache(Handle exception, address pc, address handler) {
 }
 
 
-address ExceptionCache::match(Handle exception, address pc) {
+address ExceptionCache::match(Klass* exception_klass, address pc) {
   assert(pc != NULL,"Must be non null");
-  assert(exception.not_null(),"Must be non null");
-  if (exception->klass() == exception_type()) {
+  assert(exception_klass != NULL,"Must be non null");
+  if (exception_klass == exception_type()) {
     return (test_address(pc));
   }
 
@@ -420,10 +421,12 @@ address nmethod::handler_for_exception_and_pc(Handle exception, address pc) {
   // We never grab a lock to read the exception cache, so we may
   // have false negatives. This is okay, as it can only happen during
   // the first few exception lookups for a given nmethod.
+  // The klass is loaded once rather than from the handle for every entry.
+  Klass* exception_klass = exception->klass();
   ExceptionCache* ec = exception_cache();
   while (ec != NULL) {
     address ret_val;
-    if ((ret_val = ec->match(exception,pc)) != NULL) {
+    if ((ret_val = ec->match(exception_klass,pc)) != NULL) {
       return ret_val;
     }
     ec = ec->next();
@@ -439,6 +442,13 @@ void nmethod::add_handler_for_exception_and_pc(Handle exception, address pc, add
   // to update the cache with the same data. We need to check for already inserted
   // copies of the current data before adding it.
 
+  // Threads that throw the same exception at the same pc concurrently
+  // all miss the cache at first. Only the first of them has to insert
+  // the entry; the others find it without taking the lock.
+  if (handler_for_exception_and_pc(exception, pc) == handler) {
+    return;
+  }
+
   MutexLocker ml(ExceptionCache_lock);
   ExceptionCache* target_entry = exception_cache_entry_for_exception(exception);
 
@@ -491,11 +501,8 @@ void nmethod::init_defaults() {
   _oops_do_mark_link       = NULL;
   _jmethod_id              = NULL;
   _osr_link                = NULL;
-  if (UseG1GC) {
-    _unloading_next        = NULL;
-  } else {
-    _scavenge_root_link    = NULL;
-  }
+  _unloading_next          = NULL;
+  _scavenge_root_link      = NULL;
   _scavenge_root_state     = 0;
   _compiler                = NULL;
 #if INCLUDE_RTM_OPT
@@ -524,7 +531,7 @@ nmethod* nmethod::new_native_nmethod(methodHandle method,
     CodeOffsets offsets;
     offsets.set_value(CodeOffsets::Verified_Entry, vep_offset);
     offsets.set_value(CodeOffsets::Frame_Complete, frame_complete);
-    nm = new (native_nmethod_size) nmethod(method(), native_nmethod_size,
+    nm = new (native_nmethod_size, CompLevel_none) nmethod(method(), native_nmethod_size,
                                             compile_id, &offsets,
                                             code_buffer, frame_size,
                                             basic_lock_owner_sp_offset,
@@ -562,7 +569,7 @@ nmethod* nmethod::new_dtrace_nmethod(methodHandle method,
     offsets.set_value(CodeOffsets::Dtrace_trap, trap_offset);
     offsets.set_value(CodeOffsets::Frame_Complete, frame_complete);
 
-    nm = new (nmethod_size) nmethod(method(), nmethod_size,
+    nm = new (nmethod_size, CompLevel_none) nmethod(method(), nmethod_size,
                                     &offsets, code_buffer, frame_size);
 
     NOT_PRODUCT(if (nm != NULL)  nmethod_stats.note_nmethod(nm));
@@ -610,7 +617,7 @@ nmethod* nmethod::new_nmethod(methodHandle method,
       + round_to(nul_chk_table->size_in_bytes(), oopSize)
       + round_to(debug_info->data_size()       , oopSize);
 
-    nm = new (nmethod_size)
+    nm = new (nmethod_size, comp_level)
     nmethod(method(), nmethod_size, compile_id, entry_bci, offsets,
             orig_pc_offset, debug_info, dependencies, code_buffer, frame_size,
             oop_maps,
@@ -827,9 +834,9 @@ nmethod::nmethod(
 }
 #endif // def HAVE_DTRACE_H
 
-void* nmethod::operator new(size_t size, int nmethod_size) throw() {
+void* nmethod::operator new(size_t size, int nmethod_size, int comp_level) throw() {
   // Not critical, may return null if there is too little continuous memory
-  return CodeCache::allocate(nmethod_size);
+  return CodeCache::allocate(nmethod_size, CodeCache::get_code_blob_type(comp_level));
 }
 
 nmethod::nmethod(
@@ -1678,6 +1685,8 @@ void nmethod::post_compiled_method_load_event() {
       insts_begin(), insts_size());
 #endif /* USDT2 */
 
+  PerfMap::register_nmethod(this);
+
   if (JvmtiExport::should_post_compiled_method_load() ||
       JvmtiExport::should_post_compiled_method_unload()) {
     get_and_cache_jmethod_id();
@@ -2457,10 +2466,9 @@ PcDesc* nmethod::find_pc_desc_internal(address pc, bool approximate) {
     return res;
   }
 
-  // Fallback algorithm: quasi-linear search for the PcDesc
+  // Fallback algorithm: binary search for the PcDesc
   // Find the last pc_offset less than the given offset.
   // The successor must be the required match, if there is a match at all.
-  // (Use a fixed radix to avoid expensive affine pointer arithmetic.)
   PcDesc* lower = scopes_pcs_begin();
   PcDesc* upper = scopes_pcs_end();
   upper -= 1; // exclude final sentinel
@@ -2481,34 +2489,18 @@ PcDesc* nmethod::find_pc_desc_internal(address pc, bool approximate) {
     upper = mid;
   }
 
-  // Take giant steps at first (4096, then 256, then 16, then 1)
-  const int LOG2_RADIX = 4 /*smaller steps in debug mode:*/ debug_only(-1);
-  const int RADIX = (1 << LOG2_RADIX);
-  for (int step = (1 << (LOG2_RADIX*3)); step > 1; step >>= LOG2_RADIX) {
-    while ((mid = lower + step) < upper) {
-      assert_LU_OK;
-      NOT_PRODUCT(++nmethod_stats.pc_desc_searches);
-      if (mid->pc_offset() < pc_offset) {
-        lower = mid;
-      } else {
-        upper = mid;
-        break;
-      }
-    }
-    assert_LU_OK;
-  }
-
-  // Sneak up on the value with a linear search of length ~16.
-  while (true) {
-    assert_LU_OK;
-    mid = lower + 1;
+  // Halve the interval until upper is the successor of lower. The large
+  // PcDesc tables of big C2 methods need O(log n) probes instead of the
+  // up to 16 probes per radix digit a stepping search takes.
+  while (upper - lower > 1) {
+    mid = lower + ((upper - lower) >> 1);
     NOT_PRODUCT(++nmethod_stats.pc_desc_searches);
     if (mid->pc_offset() < pc_offset) {
       lower = mid;
     } else {
       upper = mid;
-      break;
     }
+    assert_LU_OK;
   }
 #undef assert_LU_OK
 
@@ -58,7 +58,7 @@ class ExceptionCache : public CHeapObj<mtCode> {
   ExceptionCache* next()                    { return _next; }
   void      set_next(ExceptionCache *ec)    { _next = ec; }
 
-  address match(Handle exception, address pc);
+  address match(Klass* exception_klass, address pc);
   bool    match_exception_with_space(Handle exception) ;
   address test_address(address addr);
   bool    add_address_and_handler(address addr, address handler) ;
@@ -130,12 +130,10 @@ class nmethod : public CodeBlob {
   // To support simple linked-list chaining of nmethods:
   nmethod*  _osr_link;         // from InstanceKlass::osr_nmethods_head
 
-  union {
-    // Used by G1 to chain nmethods.
-    nmethod* _unloading_next;
-    // Used by non-G1 GCs to chain nmethods.
-    nmethod* _scavenge_root_link; // from CodeCache::scavenge_root_nmethods
-  };
+  // Used by parallel code cache unloading to chain postponed nmethods.
+  nmethod* _unloading_next;
+  // Used by non-G1 GCs to chain nmethods.
+  nmethod* _scavenge_root_link; // from CodeCache::scavenge_root_nmethods
 
   static nmethod* volatile _oops_do_mark_nmethods;
   nmethod*        volatile _oops_do_mark_link;
@@ -234,8 +232,9 @@ class nmethod : public CodeBlob {
   // The _hotness_counter indicates the hotness of a method. The higher
   // the value the hotter the method. The hotness counter of a nmethod is
   // set to [(ReservedCodeCacheSize / (1024 * 1024)) * 2] each time the method
-  // is active while stack scanning (mark_active_nmethods()). The hotness
-  // counter is decreased (by 1) while sweeping.
+  // is active while stack scanning (mark_active_nmethods()), which happens
+  // once at the start of each sweep. The hotness counter is decreased (by 1)
+  // while sweeping.
   int _hotness_counter;
 
   ExceptionCache * volatile _exception_cache;
@@ -296,7 +295,7 @@ class nmethod : public CodeBlob {
           int comp_level);
 
   // helper methods
-  void* operator new(size_t size, int nmethod_size) throw();
+  void* operator new(size_t size, int nmethod_size, int comp_level) throw();
 
   const char* reloc_string_for(u_char* begin, u_char* end);
   // Returns true if this thread changed the state of the nmethod or
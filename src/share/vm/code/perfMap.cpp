@@ -0,0 +1,128 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "code/codeCache.hpp"
+#include "code/nmethod.hpp"
+#include "code/perfMap.hpp"
+#include "memory/resourceArea.hpp"
+#include "oops/method.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/os.hpp"
+#include "utilities/ostream.hpp"
+
+int PerfMap::_fd = -1;
+
+static int _snapshot_fd = -1;   // protected by CodeCache_lock
+
+static void perf_map_path(char* buf, size_t len) {
+  jio_snprintf(buf, len, "%s/perf-%d.map", os::get_temp_directory(), os::current_process_id());
+}
+
+void PerfMap::initialize() {
+  if (!WritePerfMap) {
+    return;
+  }
+  char path[JVM_MAXPATHLEN];
+  perf_map_path(path, sizeof(path));
+  _fd = os::open(path, O_WRONLY | O_CREAT | O_TRUNC | O_APPEND, 0644);
+  if (_fd < 0) {
+    warning("Cannot create perf map file %s", path);
+  }
+}
+
+void PerfMap::write_line(int fd, address start, address end, const char* name) {
+  char line[1024];
+  // perf wants the numbers without a 0x prefix
+  int len = jio_snprintf(line, sizeof(line), "%" PRIxPTR " %" PRIxPTR " %s\n",
+                         p2i(start), (uintptr_t)pointer_delta(end, start, 1), name);
+  if (len < 0 || len >= (int)sizeof(line)) {
+    // Truncated; keep the line complete.
+    len = sizeof(line) - 1;
+    line[len - 1] = '\n';
+  }
+  os::write(fd, line, (unsigned int)len);
+}
+
+void PerfMap::write_nmethod_line(int fd, nmethod* nm) {
+  ResourceMark rm;
+  char name[1024];
+  if (nm->is_osr_method()) {
+    jio_snprintf(name, sizeof(name), "%s [tier %d, osr@%d]",
+                 nm->method()->name_and_sig_as_C_string(), nm->comp_level(), nm->osr_entry_bci());
+  } else if (nm->is_native_method()) {
+    jio_snprintf(name, sizeof(name), "%s [native wrapper]",
+                 nm->method()->name_and_sig_as_C_string());
+  } else {
+    jio_snprintf(name, sizeof(name), "%s [tier %d]",
+                 nm->method()->name_and_sig_as_C_string(), nm->comp_level());
+  }
+  write_line(fd, nm->code_begin(), nm->code_end(), name);
+}
+
+void PerfMap::write_blob(CodeBlob* cb) {
+  if (cb->is_nmethod()) {
+    nmethod* nm = (nmethod*)cb;
+    if (nm->is_alive()) {
+      write_nmethod_line(_snapshot_fd, nm);
+    }
+  } else {
+    // Stubs generated into one blob show under the name of the blob.
+    write_line(_snapshot_fd, cb->code_begin(), cb->code_end(), cb->name());
+  }
+}
+
+bool PerfMap::write_snapshot(outputStream* out) {
+  char path[JVM_MAXPATHLEN];
+  perf_map_path(path, sizeof(path));
+  int fd = _fd;
+  if (fd < 0) {
+    fd = os::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+      out->print_cr("Cannot create %s", path);
+      return false;
+    }
+  }
+
+  {
+    // Holding the lock keeps the code from being flushed and, since it
+    // does not check for safepoints, the methods from being unloaded.
+    MutexLockerEx ml(CodeCache_lock, Mutex::_no_safepoint_check_flag);
+    if (fd == _fd) {
+      // A line other threads append meanwhile is for code that is
+      // already in the code cache, so the snapshot covers it if the
+      // truncation drops it.
+      os::ftruncate(fd, 0);
+    }
+    _snapshot_fd = fd;
+    CodeCache::blobs_do(write_blob);
+    _snapshot_fd = -1;
+  }
+
+  if (fd != _fd) {
+    os::close(fd);
+  }
+  out->print_cr("Perf map written to %s", path);
+  return true;
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_CODE_PERFMAP_HPP
+#define SHARE_VM_CODE_PERFMAP_HPP
+
+#include "memory/allocation.hpp"
+
+class CodeBlob;
+class nmethod;
+class outputStream;
+
+// PerfMap writes the symbols of generated code in the format the Linux
+// perf tool reads from /tmp/perf-<pid>.map: one "start size name" line
+// per piece of code, with hexadecimal start and size.
+//
+// With -XX:+WritePerfMap a line is appended as each stub is registered
+// (see Forte::register_stub()) and each nmethod is installed. Each line
+// is a single write() to a file opened with O_APPEND, so concurrent
+// writers need no lock and nothing is done for JVMTI.
+//
+// The format has no way to remove an entry. Compiler.perfmap rewrites
+// the file from the code cache as it is now, which drops the code
+// flushed since.
+class PerfMap : AllStatic {
+ private:
+  static int _fd;
+
+  static void write_line(int fd, address start, address end, const char* name);
+  static void write_nmethod_line(int fd, nmethod* nm);
+  static void write_blob(CodeBlob* cb);
+
+ public:
+  static void initialize();
+
+  static void register_stub(const char* name, address start, address end) {
+    if (_fd >= 0) {
+      write_line(_fd, start, end, name);
+    }
+  }
+
+  static void register_nmethod(nmethod* nm) {
+    if (_fd >= 0) {
+      write_nmethod_line(_fd, nm);
+    }
+  }
+
+  // Replace the contents of the map file by the code in the code cache.
+  // Returns false, with the reason printed on out, if that fails.
+  static bool write_snapshot(outputStream* out);
+};
+
+#endif // SHARE_VM_CODE_PERFMAP_HPP
@@ -23,6 +23,7 @@
  */
 
 #include "precompiled.hpp"
+#include "code/perfMap.hpp"
 #include "code/vtableStubs.hpp"
 #include "compiler/disassembler.hpp"
 #include "memory/allocation.inline.hpp"
@@ -67,6 +68,7 @@ void* VtableStub::operator new(size_t size, int code_size) throw() {
     _chunk = blob->content_begin();
     _chunk_end = _chunk + bytes;
     Forte::register_stub("vtable stub", _chunk, _chunk_end);
+    PerfMap::register_stub("vtable stub", _chunk, _chunk_end);
     align_chunk();
   }
   assert(_chunk + real_size <= _chunk_end, "bad allocation");
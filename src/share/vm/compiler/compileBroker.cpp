@@ -29,6 +29,7 @@
 #include "compiler/compileBroker.hpp"
 #include "compiler/compileLog.hpp"
 #include "compiler/compilerOracle.hpp"
+#include "compiler/hotMethods.hpp"
 #include "interpreter/linkResolver.hpp"
 #include "memory/allocation.inline.hpp"
 #include "oops/methodData.hpp"
@@ -149,6 +150,7 @@ PerfCounter* CompileBroker::_perf_standard_compilation = NULL;
 PerfCounter* CompileBroker::_perf_total_bailout_count = NULL;
 PerfCounter* CompileBroker::_perf_total_invalidated_count = NULL;
 PerfCounter* CompileBroker::_perf_total_compile_count = NULL;
+PerfHistogram* CompileBroker::_perf_compile_time_histogram = NULL;
 PerfCounter* CompileBroker::_perf_total_osr_compile_count = NULL;
 PerfCounter* CompileBroker::_perf_total_standard_compile_count = NULL;
 
@@ -186,7 +188,12 @@ long CompileBroker::_peak_compilation_time       = 0;
 CompileQueue* CompileBroker::_c2_compile_queue   = NULL;
 CompileQueue* CompileBroker::_c1_compile_queue   = NULL;
 
-GrowableArray<CompilerThread*>* CompileBroker::_compiler_threads = NULL;
+int                CompileBroker::_c1_count           = 0;
+int                CompileBroker::_c2_count           = 0;
+jobject*           CompileBroker::_compiler1_objects  = NULL;
+jobject*           CompileBroker::_compiler2_objects  = NULL;
+CompilerCounters** CompileBroker::_compiler1_counters = NULL;
+CompilerCounters** CompileBroker::_compiler2_counters = NULL;
 
 
 class CompilationLog : public StringEventLog {
@@ -651,6 +658,11 @@ void CompileQueue::add(CompileTask* task) {
   }
   ++_size;
 
+  // Somebody waits for this task, do not let it queue up behind the batch.
+  if (task->is_blocking()) {
+    clear_batch();
+  }
+
   // Mark the method as being in the compile queue.
   task->method()->set_queued_for_compilation();
 
@@ -687,6 +699,7 @@ void CompileQueue::free_all() {
     CompileTask::free(current);
   }
   _first = NULL;
+  clear_batch();
 
   // Wake up all threads that block on the queue.
   lock()->notify_all();
@@ -739,6 +752,11 @@ CompileTask* CompileQueue::get() {
       // is disabled forever. We use 5 seconds wait time; the exiting of compiler threads
       // is not critical and we do not want idle compiler threads to wake up too often.
       lock()->wait(!Mutex::_no_safepoint_check_flag, 5*1000);
+
+      if (UseDynamicNumberOfCompilerThreads && _first == NULL) {
+        // Still nothing to compile. Give the caller a chance to stop this thread.
+        if (CompileBroker::can_remove(CompilerThread::current(), false)) return NULL;
+      }
     }
   }
 
@@ -797,6 +815,49 @@ void CompileQueue::remove(CompileTask* task) {
     _last = task->prev();
   }
   --_size;
+
+  for (int i = _batch_pos; i < _batch_length; i++) {
+    if (_batch[i] == task) {
+      _batch[i] = NULL;
+    }
+  }
+}
+
+// ------------------------------------------------------------------
+// CompileQueue::set_batch
+//
+// Remember tasks the compilation policy ranked at time t, so that the
+// following selections need not scan the whole queue again.
+void CompileQueue::set_batch(CompileTask** tasks, int length, jlong t) {
+  assert(lock()->owned_by_self(), "must own lock");
+  assert(length <= max_batch_size, "batch too long");
+  for (int i = 0; i < length; i++) {
+    _batch[i] = tasks[i];
+  }
+  _batch_length = length;
+  _batch_pos = 0;
+  _batch_time = t;
+}
+
+// ------------------------------------------------------------------
+// CompileQueue::next_batched_task
+//
+// Return the next task of the current batch, or NULL if the batch is
+// used up or its ranking is older than timeout milliseconds.
+CompileTask* CompileQueue::next_batched_task(jlong t, jlong timeout) {
+  assert(lock()->owned_by_self(), "must own lock");
+  if (t - _batch_time > timeout) {
+    clear_batch();
+    return NULL;
+  }
+  while (_batch_pos < _batch_length) {
+    CompileTask* task = _batch[_batch_pos++];
+    if (task != NULL) {
+      return task;
+    }
+  }
+  clear_batch();
+  return NULL;
 }
 
 void CompileQueue::remove_and_mark_stale(CompileTask* task) {
@@ -945,6 +1006,14 @@ void CompileBroker::compilation_init() {
     _perf_total_compile_count =
                  PerfDataManager::create_counter(SUN_CI, "totalCompiles",
                                                  PerfData::U_Events, CHECK);
+    if (PerfDataHistograms) {
+      // 100 us buckets, the last one from 26 s on
+      _perf_compile_time_histogram =
+                 PerfDataManager::create_histogram(SUN_CI, "compileTimeHistogram",
+                                                   PerfData::U_Ticks,
+                                                   PerfHistogram::ticks_unit(100),
+                                                   20, CHECK);
+    }
     _perf_total_osr_compile_count =
                  PerfDataManager::create_counter(SUN_CI, "osrCompiles",
                                                  PerfData::U_Events, CHECK);
@@ -1011,19 +1080,19 @@ void CompileBroker::compilation_init() {
   }
 
   _initialized = true;
-}
 
+  // Schedule the methods recorded by an earlier run
+  HotMethods::load();
+}
 
-CompilerThread* CompileBroker::make_compiler_thread(const char* name, CompileQueue* queue, CompilerCounters* counters,
-                                                    AbstractCompiler* comp, TRAPS) {
-  CompilerThread* compiler_thread = NULL;
 
+Handle CompileBroker::create_thread_oop(const char* name, TRAPS) {
   Klass* k =
     SystemDictionary::resolve_or_fail(vmSymbols::java_lang_Thread(),
-                                      true, CHECK_0);
+                                      true, CHECK_NH);
   instanceKlassHandle klass (THREAD, k);
-  instanceHandle thread_oop = klass->allocate_instance_handle(CHECK_0);
-  Handle string = java_lang_String::create_from_str(name, CHECK_0);
+  instanceHandle thread_oop = klass->allocate_instance_handle(CHECK_NH);
+  Handle string = java_lang_String::create_from_str(name, CHECK_NH);
 
   // Initialize thread_oop to put it into the system threadGroup
   Handle thread_group (THREAD,  Universe::system_thread_group());
@@ -1034,7 +1103,18 @@ CompilerThread* CompileBroker::make_compiler_thread(const char* name, CompileQue
                        vmSymbols::threadgroup_string_void_signature(),
                        thread_group,
                        string,
-                       CHECK_0);
+                       CHECK_NH);
+  return thread_oop;
+}
+
+
+// Start a CompilerThread for the pre-allocated thread object thread_obj.
+// A dynamically added thread may fail to start; NULL is returned in that
+// case and the VM keeps running with the threads it already has.
+CompilerThread* CompileBroker::make_compiler_thread(jobject thread_obj, CompileQueue* queue, CompilerCounters* counters,
+                                                    AbstractCompiler* comp, bool dynamic, TRAPS) {
+  CompilerThread* compiler_thread = NULL;
+  Handle thread_oop(THREAD, JNIHandles::resolve_non_null(thread_obj));
 
   {
     MutexLocker mu(Threads_lock, THREAD);
@@ -1049,9 +1129,16 @@ CompilerThread* CompileBroker::make_compiler_thread(const char* name, CompileQue
     // At this point it may be possible that no osthread was created for the
     // JavaThread due to lack of memory. We would have to throw an exception
     // in that case. However, since this must work and we do not allow
-    // exceptions anyway, check and abort if this fails.
+    // exceptions anyway, check and abort if this fails. Threads added on
+    // demand are optional, so their failure is not fatal.
 
     if (compiler_thread == NULL || compiler_thread->osthread() == NULL){
+      if (dynamic) {
+        if (compiler_thread != NULL) {
+          delete compiler_thread;
+        }
+        return NULL;
+      }
       vm_exit_during_initialization("java.lang.OutOfMemoryError",
                                     "unable to create new native thread");
     }
@@ -1069,7 +1156,7 @@ CompilerThread* CompileBroker::make_compiler_thread(const char* name, CompileQue
     // possible to set the compiler thread priority higher than any Java
     // thread.
 
-    int native_prio = CompilerThreadPriority;
+  int native_prio = CompilerThreadPriority;
     if (native_prio == -1) {
       if (UseCriticalCompilerThreadPriority) {
         native_prio = os::java_to_os_priority[CriticalPriority];
@@ -1094,6 +1181,108 @@ CompilerThread* CompileBroker::make_compiler_thread(const char* name, CompileQue
 }
 
 
+// ------------------------------------------------------------------
+// CompileBroker::possibly_add_compiler_threads
+//
+// Start additional compiler threads if the queues grow and there is
+// enough memory to run them. Called by compiler threads when they pick up
+// a task, so the number of threads follows the compile load.
+void CompileBroker::possibly_add_compiler_threads() {
+  EXCEPTION_MARK;
+
+  julong available_memory = os::available_memory();
+  size_t available_cc = CodeCache::unallocated_capacity();
+
+  // Only attempt to start additional threads if the lock is free.
+  if (!CompileThread_lock->try_lock()) return;
+
+  if (_c2_compile_queue != NULL) {
+    int old_c2_count = _compilers[1]->num_compiler_threads();
+    int new_c2_count = MIN4(_c2_count,
+                            _c2_compile_queue->size() / 2,
+                            (int)(available_memory / (200*M)),
+                            (int)(available_cc / (128*K)));
+
+    for (int i = old_c2_count; i < new_c2_count; i++) {
+      CompilerThread* ct = make_compiler_thread(_compiler2_objects[i], _c2_compile_queue, _compiler2_counters[i],
+                                                _compilers[1], true, THREAD);
+      if (HAS_PENDING_EXCEPTION || ct == NULL) {
+        CLEAR_PENDING_EXCEPTION;
+        break;
+      }
+      _compilers[1]->set_num_compiler_threads(i + 1);
+      if (TraceCompilerThreads) {
+        ResourceMark rm;
+        ttyLocker ttyl;
+        tty->print_cr("Added compiler thread %s (available memory: " JULONG_FORMAT "MB)",
+                      ct->get_thread_name(), available_memory / M);
+      }
+    }
+  }
+
+  if (_c1_compile_queue != NULL) {
+    int old_c1_count = _compilers[0]->num_compiler_threads();
+    int new_c1_count = MIN4(_c1_count,
+                            _c1_compile_queue->size() / 4,
+                            (int)(available_memory / (100*M)),
+                            (int)(available_cc / (128*K)));
+
+    for (int i = old_c1_count; i < new_c1_count; i++) {
+      CompilerThread* ct = make_compiler_thread(_compiler1_objects[i], _c1_compile_queue, _compiler1_counters[i],
+                                                _compilers[0], true, THREAD);
+      if (HAS_PENDING_EXCEPTION || ct == NULL) {
+        CLEAR_PENDING_EXCEPTION;
+        break;
+      }
+      _compilers[0]->set_num_compiler_threads(i + 1);
+      if (TraceCompilerThreads) {
+        ResourceMark rm;
+        ttyLocker ttyl;
+        tty->print_cr("Added compiler thread %s (available memory: " JULONG_FORMAT "MB)",
+                      ct->get_thread_name(), available_memory / M);
+      }
+    }
+  }
+
+  CompileThread_lock->unlock();
+}
+
+
+// ------------------------------------------------------------------
+// CompileBroker::can_remove
+//
+// An idle compiler thread may exit if it is the most recently started
+// thread of its kind; at least one thread of each kind is kept. Only
+// removing the last thread keeps the set of running threads a prefix of
+// the pre-allocated thread objects, so that they can be reused. With
+// do_it the thread count is updated, which requires CompileThread_lock.
+bool CompileBroker::can_remove(CompilerThread* ct, bool do_it) {
+  assert(UseDynamicNumberOfCompilerThreads, "or shouldn't be here");
+  if (!ReduceNumberOfCompilerThreads) return false;
+
+  AbstractCompiler* compiler = ct->compiler();
+  int compiler_count = compiler->num_compiler_threads();
+  bool c1 = compiler->is_c1();
+
+  // Keep at least 1 compiler thread of each type.
+  if (compiler_count < 2) return false;
+
+  // Keep thread alive for at least some time.
+  if (ct->idle_time_millis() < (c1 ? 500 : 100)) return false;
+
+  jobject last_compiler_obj = c1 ? _compiler1_objects[compiler_count - 1]
+                                 : _compiler2_objects[compiler_count - 1];
+  if (ct->threadObj() == JNIHandles::resolve_non_null(last_compiler_obj)) {
+    if (do_it) {
+      assert_locked_or_safepoint(CompileThread_lock); // Update must be consistent.
+      compiler->set_num_compiler_threads(compiler_count - 1);
+    }
+    return true;
+  }
+  return false;
+}
+
+
 void CompileBroker::init_compiler_threads(int c1_compiler_count, int c2_compiler_count) {
   EXCEPTION_MARK;
 #if !defined(ZERO) && !defined(SHARK)
@@ -1111,26 +1300,45 @@ void CompileBroker::init_compiler_threads(int c1_compiler_count, int c2_compiler
 
   int compiler_count = c1_compiler_count + c2_compiler_count;
 
-  _compiler_threads =
-    new (ResourceObj::C_HEAP, mtCompiler) GrowableArray<CompilerThread*>(compiler_count, true);
+  _c1_count = c1_compiler_count;
+  _c2_count = c2_compiler_count;
+  _compiler1_objects  = NEW_C_HEAP_ARRAY(jobject, MAX2(c1_compiler_count, 1), mtCompiler);
+  _compiler2_objects  = NEW_C_HEAP_ARRAY(jobject, MAX2(c2_compiler_count, 1), mtCompiler);
+  _compiler1_counters = NEW_C_HEAP_ARRAY(CompilerCounters*, MAX2(c1_compiler_count, 1), mtCompiler);
+  _compiler2_counters = NEW_C_HEAP_ARRAY(CompilerCounters*, MAX2(c2_compiler_count, 1), mtCompiler);
 
+  // The thread objects are created eagerly and kept alive by global handles,
+  // so that threads which are started later, or restarted after they retired,
+  // do not have to execute Java code.
   char name_buffer[256];
   for (int i = 0; i < c2_compiler_count; i++) {
     // Create a name for our thread.
     sprintf(name_buffer, "C2 CompilerThread%d", i);
-    CompilerCounters* counters = new CompilerCounters("compilerThread", i, CHECK);
+    Handle thread_oop = create_thread_oop(name_buffer, CHECK);
+    _compiler2_objects[i] = JNIHandles::make_global(thread_oop);
+    _compiler2_counters[i] = new CompilerCounters("compilerThread", i, CHECK);
     // Shark and C2
-    CompilerThread* new_thread = make_compiler_thread(name_buffer, _c2_compile_queue, counters, _compilers[1], CHECK);
-    _compiler_threads->append(new_thread);
+    if (i == 0 || !UseDynamicNumberOfCompilerThreads) {
+      make_compiler_thread(_compiler2_objects[i], _c2_compile_queue, _compiler2_counters[i], _compilers[1], false, CHECK);
+    }
   }
 
-  for (int i = c2_compiler_count; i < compiler_count; i++) {
+  for (int i = 0; i < c1_compiler_count; i++) {
     // Create a name for our thread.
-    sprintf(name_buffer, "C1 CompilerThread%d", i);
-    CompilerCounters* counters = new CompilerCounters("compilerThread", i, CHECK);
+    int id = c2_compiler_count + i;
+    sprintf(name_buffer, "C1 CompilerThread%d", id);
+    Handle thread_oop = create_thread_oop(name_buffer, CHECK);
+    _compiler1_objects[i] = JNIHandles::make_global(thread_oop);
+    _compiler1_counters[i] = new CompilerCounters("compilerThread", id, CHECK);
     // C1
-    CompilerThread* new_thread = make_compiler_thread(name_buffer, _c1_compile_queue, counters, _compilers[0], CHECK);
-    _compiler_threads->append(new_thread);
+    if (i == 0 || !UseDynamicNumberOfCompilerThreads) {
+      make_compiler_thread(_compiler1_objects[i], _c1_compile_queue, _compiler1_counters[i], _compilers[0], false, CHECK);
+    }
+  }
+
+  if (UseDynamicNumberOfCompilerThreads) {
+    if (c2_compiler_count > 0) _compilers[1]->set_num_compiler_threads(1);
+    if (c1_compiler_count > 0) _compilers[0]->set_num_compiler_threads(1);
   }
 
   if (UsePerfData) {
@@ -1773,6 +1981,8 @@ void CompileBroker::compiler_thread_loop() {
     return;
   }
 
+  thread->reset_idle_time();
+
   // Poll for new compilation tasks as long as the JVM runs. Compilation
   // should only be disabled if something went wrong while initializing the
   // compiler runtimes. This, in turn, should not happen. The only known case
@@ -1789,9 +1999,31 @@ void CompileBroker::compiler_thread_loop() {
 
     CompileTask* task = queue->get();
     if (task == NULL) {
+      if (UseDynamicNumberOfCompilerThreads && !is_compilation_disabled_forever()) {
+        // Access the thread count under the lock to keep it consistent.
+        MutexLocker only_one(CompileThread_lock, thread);
+        if (can_remove(thread, true)) {
+          if (TraceCompilerThreads) {
+            ttyLocker ttyl;
+            tty->print_cr("Removing compiler thread %s after " JLONG_FORMAT " ms idle time",
+                          thread->name(), thread->idle_time_millis());
+          }
+          // Free the buffer blob, if allocated
+          if (thread->get_buffer_blob() != NULL) {
+            MutexLockerEx mu(CodeCache_lock, Mutex::_no_safepoint_check_flag);
+            CodeCache::free(thread->get_buffer_blob());
+            thread->set_buffer_blob(NULL);
+          }
+          return; // Stop this thread.
+        }
+      }
       continue;
     }
 
+    if (UseDynamicNumberOfCompilerThreads) {
+      possibly_add_compiler_threads();
+    }
+
     // Give compiler threads an extra quanta.  They tend to be bursty and
     // this helps the compiler to finish up the job.
     if( CompilerThreadHintNoPreempt )
@@ -1819,6 +2051,7 @@ void CompileBroker::compiler_thread_loop() {
         task->set_failure_reason("compilation is disabled");
       }
     }
+    thread->reset_idle_time();
   }
 
   // Shut down compiler runtime
@@ -2334,6 +2567,9 @@ void CompileBroker::collect_statistics(CompilerThread* thread, elapsedTimer time
       _perf_sum_nmethod_size->inc(     code->total_size());
       _perf_sum_nmethod_code_size->inc(code->insts_size());
       _perf_total_compile_count->inc();
+      if (_perf_compile_time_histogram != NULL) {
+        _perf_compile_time_histogram->record(time.ticks());
+      }
     }
 
     if (is_osr) {
@@ -194,6 +194,9 @@ class CompilerCounters : public CHeapObj<mtCompiler> {
 //
 // A list of CompileTasks.
 class CompileQueue : public CHeapObj<mtCompiler> {
+ public:
+  enum { max_batch_size = 64 };
+
  private:
   const char* _name;
   Monitor*    _lock;
@@ -205,6 +208,13 @@ class CompileQueue : public CHeapObj<mtCompiler> {
 
   int _size;
 
+  // Tasks ranked by the last scan of the compilation policy, best first.
+  // Entries of tasks removed from the queue in the meantime are NULL.
+  CompileTask* _batch[max_batch_size];
+  int          _batch_length;
+  int          _batch_pos;
+  jlong        _batch_time;
+
   void purge_stale_tasks();
  public:
   CompileQueue(const char* name, Monitor* lock) {
@@ -214,6 +224,7 @@ class CompileQueue : public CHeapObj<mtCompiler> {
     _last = NULL;
     _size = 0;
     _first_stale = NULL;
+    clear_batch();
   }
 
   const char*  name() const                      { return _name; }
@@ -230,6 +241,11 @@ class CompileQueue : public CHeapObj<mtCompiler> {
   bool         is_empty() const                  { return _first == NULL; }
   int          size()     const                  { return _size;          }
 
+  // Support for selecting several tasks with one scan of the queue
+  void         clear_batch()                     { _batch_length = 0; _batch_pos = 0; _batch_time = 0; }
+  void         set_batch(CompileTask** tasks, int length, jlong t);
+  CompileTask* next_batched_task(jlong t, jlong timeout);
+
 
   // Redefine Classes support
   void mark_on_stack();
@@ -290,7 +306,14 @@ class CompileBroker: AllStatic {
   static CompileQueue* _c2_compile_queue;
   static CompileQueue* _c1_compile_queue;
 
-  static GrowableArray<CompilerThread*>* _compiler_threads;
+  // Thread objects and counters for all possible compiler threads. With
+  // UseDynamicNumberOfCompilerThreads only a prefix of them is backed by a
+  // running CompilerThread at any time.
+  static int _c1_count, _c2_count;
+  static jobject* _compiler1_objects;
+  static jobject* _compiler2_objects;
+  static CompilerCounters** _compiler1_counters;
+  static CompilerCounters** _compiler2_counters;
 
   // performance counters
   static PerfCounter* _perf_total_compilation;
@@ -301,6 +324,7 @@ class CompileBroker: AllStatic {
   static PerfCounter* _perf_total_bailout_count;
   static PerfCounter* _perf_total_invalidated_count;
   static PerfCounter* _perf_total_compile_count;
+  static PerfHistogram* _perf_compile_time_histogram;
   static PerfCounter* _perf_total_native_compile_count;
   static PerfCounter* _perf_total_osr_compile_count;
   static PerfCounter* _perf_total_standard_compile_count;
@@ -337,8 +361,11 @@ class CompileBroker: AllStatic {
 
   static volatile jint _print_compilation_warning;
 
-  static CompilerThread* make_compiler_thread(const char* name, CompileQueue* queue, CompilerCounters* counters, AbstractCompiler* comp, TRAPS);
+  static Handle create_thread_oop(const char* name, TRAPS);
+  static CompilerThread* make_compiler_thread(jobject thread_obj, CompileQueue* queue, CompilerCounters* counters,
+                                              AbstractCompiler* comp, bool dynamic, TRAPS);
   static void init_compiler_threads(int c1_compiler_count, int c2_compiler_count);
+  static void possibly_add_compiler_threads();
   static bool compilation_is_complete  (methodHandle method, int osr_bci, int comp_level);
   static bool compilation_is_prohibited(methodHandle method, int osr_bci, int comp_level);
   static bool is_compile_blocking      ();
@@ -404,6 +431,7 @@ class CompileBroker: AllStatic {
                                  const char* comment, Thread* thread);
 
   static void compiler_thread_loop();
+  static bool can_remove(CompilerThread* ct, bool do_it);
   static uint get_compilation_id() { return _compilation_id; }
 
   // Set _should_block.
@@ -0,0 +1,175 @@
+/*
+ * Copyright (c) 2014, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "classfile/symbolTable.hpp"
+#include "code/codeCache.hpp"
+#include "code/nmethod.hpp"
+#include "compiler/compileBroker.hpp"
+#include "compiler/hotMethods.hpp"
+#include "memory/resourceArea.hpp"
+#include "oops/method.hpp"
+#include "runtime/compilationPolicy.hpp"
+#include "runtime/handles.inline.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "utilities/ostream.hpp"
+
+class HotMethods::Entry : public CHeapObj<mtCompiler> {
+ public:
+  Symbol* _klass_name;
+  Symbol* _name;
+  Symbol* _signature;
+  int     _level;
+  Entry*  _next;
+};
+
+HotMethods::Entry** HotMethods::_table = NULL;
+int                 HotMethods::_count = 0;
+
+void HotMethods::parse_line(char* line, TRAPS) {
+  char klass_name[256];
+  char name[256];
+  char signature[1024];
+  int level = 0;
+  if (sscanf(line, "%d %255s %255s %1023s", &level, klass_name, name, signature) != 4) {
+    return;
+  }
+  if (level <= CompLevel_none || level > CompLevel_full_optimization) {
+    return;
+  }
+  Entry* e = new Entry();
+  e->_klass_name = SymbolTable::new_permanent_symbol(klass_name, CHECK);
+  e->_name       = SymbolTable::new_permanent_symbol(name, CHECK);
+  e->_signature  = SymbolTable::new_permanent_symbol(signature, CHECK);
+  e->_level      = level;
+  int index = e->_klass_name->identity_hash() & (table_size - 1);
+  e->_next = _table[index];
+  _table[index] = e;
+  _count++;
+}
+
+void HotMethods::load() {
+  if (HotMethodsFile == NULL || !UseCompiler) {
+    return;
+  }
+  FILE* stream = fopen(HotMethodsFile, "rt");
+  if (stream == NULL) {
+    // Nothing recorded yet, e.g. the first run with DumpHotMethodsAtExit
+    return;
+  }
+
+  EXCEPTION_MARK;
+  _table = NEW_C_HEAP_ARRAY(Entry*, table_size, mtCompiler);
+  for (int i = 0; i < table_size; i++) {
+    _table[i] = NULL;
+  }
+  char line[2048];
+  while (fgets(line, sizeof(line), stream) != NULL) {
+    parse_line(line, THREAD);
+    if (HAS_PENDING_EXCEPTION) {
+      CLEAR_PENDING_EXCEPTION;
+      break;
+    }
+  }
+  fclose(stream);
+
+  if (PrintCompilation) {
+    tty->print_cr("Read %d hot methods from %s", _count, HotMethodsFile);
+  }
+}
+
+void HotMethods::compile(instanceKlassHandle k, Entry* e, TRAPS) {
+  Method* m = k->find_method(e->_name, e->_signature);
+  if (m == NULL || m->is_abstract() || m->is_native()) {
+    return;
+  }
+  methodHandle mh(THREAD, m);
+  int level = e->_level;
+  if (!TieredCompilation) {
+    level = CompLevel_highest_tier;
+  } else {
+    // Without a profile C2 would compile worse code than it did in the
+    // recording run, so start with fully profiled C1 code instead and let
+    // the policy move on to C2 once the profile is mature. Short running
+    // VMs may prefer to skip the profiled compile and the recompilation.
+    if (level == CompLevel_full_optimization && !HotMethodsUseRecordedLevel) {
+      level = CompLevel_full_profile;
+    }
+    level = MIN2(level, (int)TieredStopAtLevel);
+    if (level == CompLevel_none) {
+      return;
+    }
+  }
+  if (!CompilationPolicy::can_be_compiled(mh, level) || mh->code() != NULL) {
+    return;
+  }
+  CompileBroker::compile_method(mh, InvocationEntryBci, level, mh, 0, "hot method", THREAD);
+  if (HAS_PENDING_EXCEPTION) {
+    CLEAR_PENDING_EXCEPTION;
+  }
+}
+
+void HotMethods::class_initialized(instanceKlassHandle k, TRAPS) {
+  assert(has_methods(), "check first");
+  if (!UseCompiler || !CompileBroker::should_compile_new_jobs()) {
+    return;
+  }
+  Symbol* klass_name = k->name();
+  int index = klass_name->identity_hash() & (table_size - 1);
+  for (Entry* e = _table[index]; e != NULL; e = e->_next) {
+    if (e->_klass_name == klass_name) {
+      compile(k, e, THREAD);
+    }
+  }
+}
+
+static fileStream* _hot_methods_stream = NULL;
+static int         _hot_methods_dumped = 0;
+
+static void dump_hot_method(nmethod* nm) {
+  if (!nm->is_in_use() || nm->is_osr_method() || nm->is_native_method() ||
+      nm->comp_level() <= CompLevel_none) {
+    return;
+  }
+  Method* m = nm->method();
+  ResourceMark rm;
+  _hot_methods_stream->print_cr("%d %s %s %s", nm->comp_level(),
+                                m->klass_name()->as_C_string(),
+                                m->name()->as_C_string(),
+                                m->signature()->as_C_string());
+  _hot_methods_dumped++;
+}
+
+int HotMethods::dump(const char* file_name) {
+  fileStream fs(file_name, "w");
+  if (!fs.is_open()) {
+    return -1;
+  }
+  MutexLockerEx mu(CodeCache_lock, Mutex::_no_safepoint_check_flag);
+  _hot_methods_stream = &fs;
+  _hot_methods_dumped = 0;
+  CodeCache::nmethods_do(dump_hot_method);
+  _hot_methods_stream = NULL;
+  return _hot_methods_dumped;
+}
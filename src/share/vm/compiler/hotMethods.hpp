@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2014, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_COMPILER_HOTMETHODS_HPP
+#define SHARE_VM_COMPILER_HOTMETHODS_HPP
+
+#include "memory/allocation.hpp"
+#include "oops/instanceKlass.hpp"
+
+// HotMethods records which methods had compiled code at the end of a run
+// and schedules them for compilation early in the next run, so that the
+// application reaches compiled code without waiting for the counters to
+// overflow again.
+//
+// The file format is one method per line:
+//   <comp level> <class name> <method name> <signature>
+// with class names and signatures in internal form, e.g.
+//   4 java/lang/String hashCode ()I
+
+class HotMethods : AllStatic {
+ private:
+  class Entry;
+  enum { table_size = 1024 };
+  static Entry** _table;
+  static int     _count;
+
+  static void parse_line(char* line, TRAPS);
+  static void compile(instanceKlassHandle k, Entry* e, TRAPS);
+
+ public:
+  // Read HotMethodsFile, if it is set and exists
+  static void load();
+
+  // Are there any recorded methods left to schedule?
+  static bool has_methods() { return _count > 0; }
+
+  // Schedule the recorded methods of a class which finished initialization
+  static void class_initialized(instanceKlassHandle k, TRAPS);
+
+  // Write all methods with compiled code in use to the given file.
+  // Returns the number of methods written, or -1 if the file cannot be created.
+  static int dump(const char* file_name);
+};
+
+#endif // SHARE_VM_COMPILER_HOTMETHODS_HPP
@@ -2584,7 +2584,7 @@ size_t CFLS_LAB::_global_num_blocks[]  = VECTOR_257(0);
 uint   CFLS_LAB::_global_num_workers[] = VECTOR_257(0);
 
 CFLS_LAB::CFLS_LAB(CompactibleFreeListSpace* cfls) :
-  _cfls(cfls)
+  _cfls(cfls), _large_buffer(NULL)
 {
   assert(CompactibleFreeListSpace::IndexSetSize == 257, "Modify VECTOR_257() macro above");
   for (size_t i = CompactibleFreeListSpace::IndexSetStart;
@@ -2611,11 +2611,14 @@ HeapWord* CFLS_LAB::alloc(size_t word_sz) {
   FreeChunk* res;
   assert(word_sz == _cfls->adjustObjectSize(word_sz), "Error");
   if (word_sz >=  CompactibleFreeListSpace::IndexSetSize) {
-    // This locking manages sync with other large object allocations.
-    MutexLockerEx x(_cfls->parDictionaryAllocLock(),
-                    Mutex::_no_safepoint_check_flag);
-    res = _cfls->getChunkFromDictionaryExact(word_sz);
-    if (res == NULL) return NULL;
+    res = alloc_from_large_buffer(word_sz);
+    if (res == NULL) {
+      // This locking manages sync with other large object allocations.
+      MutexLockerEx x(_cfls->parDictionaryAllocLock(),
+                      Mutex::_no_safepoint_check_flag);
+      res = _cfls->getChunkFromDictionaryExact(word_sz);
+      if (res == NULL) return NULL;
+    }
   } else {
     AdaptiveFreeList<FreeChunk>* fl = &_indexedFreeList[word_sz];
     if (fl->count() == 0) {
@@ -2635,6 +2638,69 @@ HeapWord* CFLS_LAB::alloc(size_t word_sz) {
   return (HeapWord*)res;
 }
 
+// Carve a block of word_sz words off the front of the large buffer,
+// refilling the buffer from the dictionary if it is too small. Blocks
+// larger than a quarter of the buffer go to the dictionary directly.
+FreeChunk* CFLS_LAB::alloc_from_large_buffer(size_t word_sz) {
+  if (word_sz > CMSParPromoteLargeBufferSize / 4) {
+    return NULL;
+  }
+  if (_large_buffer != NULL && _large_buffer->size() != word_sz &&
+      _large_buffer->size() < word_sz + MinChunkSize) {
+    retire_large_buffer();
+  }
+  if (_large_buffer == NULL) {
+    size_t buffer_sz = _cfls->adjustObjectSize(CMSParPromoteLargeBufferSize);
+    MutexLockerEx x(_cfls->parDictionaryAllocLock(),
+                    Mutex::_no_safepoint_check_flag);
+    _large_buffer = _cfls->getChunkFromDictionaryExact(buffer_sz);
+    if (_large_buffer == NULL) {
+      return NULL;
+    }
+  }
+
+  FreeChunk* fc = _large_buffer;
+  size_t size = fc->size();
+  assert(fc->is_free(), "Buffer should look like a free block");
+  if (size == word_sz) {
+    _large_buffer = NULL;
+    return fc;
+  }
+  assert(size >= word_sz + MinChunkSize, "Remainder too small");
+  // The remainder must look like a free block to the other GC threads
+  // before the BOT shows the split, as in splitChunkAndReturnRemainder().
+  FreeChunk* rem_fc = (FreeChunk*)((HeapWord*)fc + word_sz);
+  rem_fc->set_size(size - word_sz);
+  rem_fc->link_prev(NULL); // Mark as a free block for other (parallel) GC threads.
+  rem_fc->link_next(NULL);
+  OrderAccess::storestore();
+  _cfls->_bt.split_block((HeapWord*)fc, size, word_sz);
+  fc->set_size(word_sz);
+  _large_buffer = rem_fc;
+  return fc;
+}
+
+void CFLS_LAB::retire_large_buffer() {
+  FreeChunk* fc = _large_buffer;
+  if (fc == NULL) {
+    return;
+  }
+  _large_buffer = NULL;
+  size_t size = fc->size();
+  if (size >= CompactibleFreeListSpace::IndexSetSize) {
+    MutexLockerEx x(_cfls->parDictionaryAllocLock(),
+                    Mutex::_no_safepoint_check_flag);
+    _cfls->returnChunkToDictionary(fc);
+    _cfls->dictionary()->dict_census_update(size, true /*split*/, true /*birth*/);
+  } else {
+    MutexLockerEx x(_cfls->_indexedFreeListParLocks[size],
+                    Mutex::_no_safepoint_check_flag);
+    _cfls->_bt.verify_not_unallocated((HeapWord*)fc, size);
+    _cfls->_indexedFreeList[size].return_chunk_at_head(fc);
+    _cfls->smallSplitBirth(size);
+  }
+}
+
 // Get a chunk of blocks of the right size and update related
 // book-keeping stats
 void CFLS_LAB::get_from_global_pool(size_t word_sz, AdaptiveFreeList<FreeChunk>* fl) {
@@ -2700,6 +2766,7 @@ void CFLS_LAB::retire(int tid) {
   // so no need for locks and such.
   NOT_PRODUCT(Thread* t = Thread::current();)
   assert(Thread::current()->is_VM_thread(), "Error");
+  retire_large_buffer();
   for (size_t i =  CompactibleFreeListSpace::IndexSetStart;
        i < CompactibleFreeListSpace::IndexSetSize;
        i += CompactibleFreeListSpace::IndexSetStride) {
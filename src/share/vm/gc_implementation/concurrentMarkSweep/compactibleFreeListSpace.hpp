@@ -646,8 +646,16 @@ class CFLS_LAB : public CHeapObj<mtGC> {
   static uint   _global_num_workers[CompactibleFreeListSpace::IndexSetSize];
   size_t        _num_blocks        [CompactibleFreeListSpace::IndexSetSize];
 
-  // Internal work method
+  // A free block claimed from the dictionary that blocks of dictionary
+  // size are carved from, so that large promotions do not all serialize
+  // on the dictionary lock. Its unused part is returned when it can no
+  // longer satisfy a request and when the LAB is retired.
+  FreeChunk*    _large_buffer;
+
+  // Internal work methods
   void get_from_global_pool(size_t word_sz, AdaptiveFreeList<FreeChunk>* fl);
+  FreeChunk* alloc_from_large_buffer(size_t word_sz);
+  void retire_large_buffer();
 
 public:
   CFLS_LAB(CompactibleFreeListSpace* cfls);
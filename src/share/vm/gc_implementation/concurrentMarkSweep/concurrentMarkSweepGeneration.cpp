@@ -24,6 +24,7 @@
 
 #include "precompiled.hpp"
 #include "classfile/classLoaderData.hpp"
+#include "classfile/metadataOnStackMark.hpp"
 #include "classfile/symbolTable.hpp"
 #include "classfile/systemDictionary.hpp"
 #include "code/codeCache.hpp"
@@ -40,7 +41,10 @@
 #include "gc_implementation/shared/gcTimer.hpp"
 #include "gc_implementation/shared/gcTrace.hpp"
 #include "gc_implementation/shared/gcTraceTime.hpp"
+#include "gc_implementation/shared/gcUtil.hpp"
+#include "gc_implementation/shared/gcWorkerPhaseTimes.hpp"
 #include "gc_implementation/shared/isGCActiveMark.hpp"
+#include "gc_implementation/shared/parallelCleaning.hpp"
 #include "gc_interface/collectedHeap.inline.hpp"
 #include "memory/allocation.hpp"
 #include "memory/cardTableRS.hpp"
@@ -603,6 +607,8 @@ CMSCollector::CMSCollector(ConcurrentMarkSweepGeneration* cmsGen,
   _intra_sweep_estimate(CMS_SweepWeight, CMS_SweepPadding),
   _gc_tracer_cm(new (ResourceObj::C_HEAP, mtGC) CMSTracer()),
   _gc_timer_cm(new (ResourceObj::C_HEAP, mtGC) ConcurrentGCTimer()),
+  _initial_mark_phase_times(NULL),
+  _remark_phase_times(NULL),
   _cms_start_registered(false)
 {
   if (ExplicitGCInvokesConcurrentAndUnloadsClasses) {
@@ -3628,11 +3634,28 @@ class CMSParMarkTask : public AbstractGangTask {
 
 // Parallel initial mark task
 class CMSParInitialMarkTask: public CMSParMarkTask {
+  GCWorkerPhaseTimes* _times;
  public:
-  CMSParInitialMarkTask(CMSCollector* collector, int n_workers) :
+  enum Phase {
+    YoungGenRoots,
+    RemainingRoots,
+    PhaseNum
+  };
+
+  CMSParInitialMarkTask(CMSCollector* collector, int n_workers,
+                        GCWorkerPhaseTimes* times) :
       CMSParMarkTask("Scan roots and young gen for initial mark in parallel",
-                     collector, n_workers) {}
+                     collector, n_workers),
+      _times(times) {}
   void work(uint worker_id);
+
+  static GCWorkerPhaseTimes* create_phase_times() {
+    GCWorkerPhaseTimes* times = new GCWorkerPhaseTimes("CMS Initial Mark", ParallelGCThreads);
+    uint young = times->add_phase("Young Gen Roots");
+    uint remaining = times->add_phase("Remaining Roots");
+    assert(young == YoungGenRoots && remaining == RemainingRoots, "phases out of order");
+    return times;
+  }
 };
 
 // Checkpoint the roots into this generation from outside
@@ -3737,7 +3760,11 @@ void CMSCollector::checkpointRootsInitialWork(bool asynch) {
       FlexibleWorkGang* workers = gch->workers();
       assert(workers != NULL, "Need parallel worker threads.");
       int n_workers = workers->active_workers();
-      CMSParInitialMarkTask tsk(this, n_workers);
+      if (_initial_mark_phase_times == NULL) {
+        _initial_mark_phase_times = CMSParInitialMarkTask::create_phase_times();
+      }
+      _initial_mark_phase_times->note_gc_start();
+      CMSParInitialMarkTask tsk(this, n_workers, _initial_mark_phase_times);
       gch->set_par_threads(n_workers);
       initialize_sequential_subtasks_for_young_gen_rescan(n_workers);
       if (n_workers > 1) {
@@ -3748,6 +3775,7 @@ void CMSCollector::checkpointRootsInitialWork(bool asynch) {
         tsk.work(0);
       }
       gch->set_par_threads(0);
+      _initial_mark_phase_times->note_gc_end(_gc_tracer_cm);
     } else {
       // The serial version.
       CLDToOopClosure cld_closure(&notOlder, true);
@@ -3888,7 +3916,8 @@ class CMSConcMarkingTerminator: public ParallelTaskTerminator {
   // "collector" is the CMS collector associated with this task terminator.
   // "yield" indicates whether we need the gang as a whole to yield.
   CMSConcMarkingTerminator(int n_threads, TaskQueueSetSuper* queue_set, CMSCollector* collector) :
-    ParallelTaskTerminator(n_threads, queue_set),
+    // The CMS yield protocol needs every waiting thread to call yield().
+    ParallelTaskTerminator(n_threads, queue_set, false),
     _collector(collector) { }
 
   void set_task(CMSConcMarkingTask* task) {
@@ -4571,15 +4600,46 @@ void CMSCollector::abortable_preclean() {
     // (dirty cards).
     // One, admittedly dumb, strategy is to give up
     // after a certain number of abortable precleaning loops
-    // or after a certain maximum time. We want to make
-    // this smarter in the next iteration.
-    // XXX FIX ME!!! YSR
+    // or after a certain maximum time.
+    // In addition we estimate the rate at which the mutators
+    // dirty cards and the rate at which we clean them. The cards
+    // found by an iteration were, on average, dirtied between the
+    // middle of the previous iteration and the middle of this one,
+    // and were cleaned in the time this iteration took. Once the
+    // dirtying rate catches up with the cleaning rate further
+    // precleaning will not shorten the remark pause.
+    const unsigned min_rate_samples = 4;
+    AdaptiveWeightedAverage dirty_rate(CMSExpAvgFactor);
+    AdaptiveWeightedAverage clean_rate(CMSExpAvgFactor);
+    double last_mid = 0.0;
     size_t loops = 0, workdone = 0, cumworkdone = 0, waited = 0;
     while (!(should_abort_preclean() ||
              ConcurrentMarkSweepThread::should_terminate())) {
+      double start = os::elapsedTime();
       workdone = preclean_work(CMSPrecleanRefLists2, CMSPrecleanSurvivors2);
+      double end = os::elapsedTime();
+      double mid = (start + end) / 2.0;
       cumworkdone += workdone;
       loops++;
+      if (CMSAbortablePrecleanDirtyRatio != 0 && loops > 1 &&
+          workdone >= CMSAbortablePrecleanMinWorkPerIteration) {
+        // Rates in cards per millisecond.
+        double dirty_ms = MAX2((mid - last_mid) * MILLIUNITS, 1.0);
+        double clean_ms = MAX2((end - start) * MILLIUNITS, 1.0);
+        dirty_rate.sample((float)(workdone / dirty_ms));
+        clean_rate.sample((float)(workdone / clean_ms));
+        if (dirty_rate.count() >= min_rate_samples &&
+            dirty_rate.average() * 100.0 >=
+              clean_rate.average() * CMSAbortablePrecleanDirtyRatio) {
+          if (PrintGCDetails) {
+            gclog_or_tty->print(" CMS: abort preclean due to dirty card rate"
+                                " (%3.1f/%3.1f cards/ms) ",
+                                dirty_rate.average(), clean_rate.average());
+          }
+          break;
+        }
+      }
+      last_mid = mid;
       // Voluntarily terminate abortable preclean phase if we have
       // been at it for too long.
       if ((CMSMaxAbortablePrecleanLoops != 0) &&
@@ -5238,6 +5298,7 @@ void CMSParInitialMarkTask::work(uint worker_id) {
 
   // ---------- young gen roots --------------
   {
+    GCWorkerPhaseTimer t(_times, YoungGenRoots, worker_id);
     work_on_young_gen_roots(worker_id, &par_mri_cl);
     _timer.stop();
     if (PrintCMSStatistics != 0) {
@@ -5253,14 +5314,17 @@ void CMSParInitialMarkTask::work(uint worker_id) {
 
   CLDToOopClosure cld_closure(&par_mri_cl, true);
 
-  gch->gen_process_roots(_collector->_cmsGen->level(),
-                         false,     // yg was scanned above
-                         false,     // this is parallel code
-                         GenCollectedHeap::ScanningOption(_collector->CMSCollector::roots_scanning_options()),
-                         _collector->should_unload_classes(),
-                         &par_mri_cl,
-                         NULL,
-                         &cld_closure);
+  {
+    GCWorkerPhaseTimer t(_times, RemainingRoots, worker_id);
+    gch->gen_process_roots(_collector->_cmsGen->level(),
+                           false,     // yg was scanned above
+                           false,     // this is parallel code
+                           GenCollectedHeap::ScanningOption(_collector->CMSCollector::roots_scanning_options()),
+                           _collector->should_unload_classes(),
+                           &par_mri_cl,
+                           NULL,
+                           &cld_closure);
+  }
   assert(_collector->should_unload_classes()
          || (_collector->CMSCollector::roots_scanning_options() & GenCollectedHeap::SO_AllCodeCache),
          "if we didn't scan the code cache, we have to be ready to drop nmethods with expired weak oops");
@@ -5274,24 +5338,59 @@ void CMSParInitialMarkTask::work(uint worker_id) {
 
 // Parallel remark task
 class CMSParRemarkTask: public CMSParMarkTask {
+ public:
+  // The sub-phases of the parallel remark, timed per worker.
+  enum Phase {
+    YoungGenRescan,
+    RootRescan,
+    NewCLDScan,
+    DirtyKlassScan,
+    DirtyCardRescan,
+    WorkStealing,
+    PhaseNum
+  };
+
+ private:
   CompactibleFreeListSpace* _cms_space;
 
   // The per-thread work queues, available here for stealing.
   OopTaskQueueSet*       _task_queues;
   ParallelTaskTerminator _term;
 
+  // The class loader data created during concurrent marking, and all
+  // class loader data for the dirty klass scanning. The workers claim
+  // them in chunks of CLDClaimChunk.
+  GrowableArray<ClassLoaderData*>* _new_clds;
+  GrowableArray<ClassLoaderData*>* _all_clds;
+  volatile jint                    _new_clds_claimed;
+  volatile jint                    _all_clds_claimed;
+  static const jint                CLDClaimChunk = 8;
+
+  // Per-worker timings of the phases above
+  GCWorkerPhaseTimes*    _times;
+
  public:
   // A value of 0 passed to n_workers will cause the number of
   // workers to be taken from the active workers in the work gang.
   CMSParRemarkTask(CMSCollector* collector,
                    CompactibleFreeListSpace* cms_space,
                    int n_workers, FlexibleWorkGang* workers,
-                   OopTaskQueueSet* task_queues):
+                   OopTaskQueueSet* task_queues,
+                   GrowableArray<ClassLoaderData*>* new_clds,
+                   GrowableArray<ClassLoaderData*>* all_clds,
+                   GCWorkerPhaseTimes* times):
     CMSParMarkTask("Rescan roots and grey objects in parallel",
                    collector, n_workers),
     _cms_space(cms_space),
     _task_queues(task_queues),
-    _term(n_workers, task_queues) { }
+    _term(n_workers, task_queues),
+    _new_clds(new_clds), _all_clds(all_clds),
+    _new_clds_claimed(0), _all_clds_claimed(0),
+    _times(times) {
+  }
+
+  // The timings the workers record into, with the phases registered.
+  static GCWorkerPhaseTimes* create_phase_times();
 
   OopTaskQueueSet* task_queues() { return _task_queues; }
 
@@ -5309,6 +5408,17 @@ class CMSParRemarkTask: public CMSParMarkTask {
 
   // ... work stealing for the above
   void do_work_steal(int i, Par_MarkRefsIntoAndScanClosure* cl, int* seed);
+
+  // Claims the next chunk of "clds" and returns its start index, or -1
+  // if all have been claimed.
+  int claim_clds(GrowableArray<ClassLoaderData*>* clds, volatile jint* claimed);
+};
+
+class CollectCLDClosure : public CLDClosure {
+  GrowableArray<ClassLoaderData*>* _clds;
+ public:
+  CollectCLDClosure(GrowableArray<ClassLoaderData*>* clds) : _clds(clds) {}
+  void do_cld(ClassLoaderData* cld) { _clds->append(cld); }
 };
 
 class RemarkKlassClosure : public KlassClosure {
@@ -5377,6 +5487,7 @@ void CMSParRemarkTask::work(uint worker_id) {
   // work first.
   // ---------- young gen roots --------------
   {
+    GCWorkerPhaseTimer t(_times, YoungGenRescan, worker_id);
     work_on_young_gen_roots(worker_id, &par_mrias_cl);
     _timer.stop();
     if (PrintCMSStatistics != 0) {
@@ -5389,14 +5500,17 @@ void CMSParRemarkTask::work(uint worker_id) {
   // ---------- remaining roots --------------
   _timer.reset();
   _timer.start();
-  gch->gen_process_roots(_collector->_cmsGen->level(),
-                         false,     // yg was scanned above
-                         false,     // this is parallel code
-                         GenCollectedHeap::ScanningOption(_collector->CMSCollector::roots_scanning_options()),
-                         _collector->should_unload_classes(),
-                         &par_mrias_cl,
-                         NULL,
-                         NULL);     // The dirty klasses will be handled below
+  {
+    GCWorkerPhaseTimer t(_times, RootRescan, worker_id);
+    gch->gen_process_roots(_collector->_cmsGen->level(),
+                           false,     // yg was scanned above
+                           false,     // this is parallel code
+                           GenCollectedHeap::ScanningOption(_collector->CMSCollector::roots_scanning_options()),
+                           _collector->should_unload_classes(),
+                           &par_mrias_cl,
+                           NULL,
+                           NULL);     // The dirty klasses will be handled below
+  }
 
   assert(_collector->should_unload_classes()
          || (_collector->CMSCollector::roots_scanning_options() & GenCollectedHeap::SO_AllCodeCache),
@@ -5409,46 +5523,57 @@ void CMSParRemarkTask::work(uint worker_id) {
   }
 
   // ---------- unhandled CLD scanning ----------
-  if (worker_id == 0) { // Single threaded at the moment.
-    _timer.reset();
-    _timer.start();
+  _timer.reset();
+  _timer.start();
 
-    // Scan all new class loader data objects and new dependencies that were
-    // introduced during concurrent marking.
-    ResourceMark rm;
-    GrowableArray<ClassLoaderData*>* array = ClassLoaderDataGraph::new_clds();
-    for (int i = 0; i < array->length(); i++) {
-      par_mrias_cl.do_class_loader_data(array->at(i));
+  // Scan all new class loader data objects and new dependencies that were
+  // introduced during concurrent marking.
+  {
+    GCWorkerPhaseTimer t(_times, NewCLDScan, worker_id);
+    for (int start = claim_clds(_new_clds, &_new_clds_claimed);
+         start >= 0;
+         start = claim_clds(_new_clds, &_new_clds_claimed)) {
+      int end = MIN2(start + CLDClaimChunk, _new_clds->length());
+      for (int i = start; i < end; i++) {
+        par_mrias_cl.do_class_loader_data(_new_clds->at(i));
+      }
     }
+  }
 
-    // We don't need to keep track of new CLDs anymore.
-    ClassLoaderDataGraph::remember_new_clds(false);
-
-    _timer.stop();
-    if (PrintCMSStatistics != 0) {
-      gclog_or_tty->print_cr(
-          "Finished unhandled CLD scanning work in %dth thread: %3.3f sec",
-          worker_id, _timer.seconds());
-    }
+  _timer.stop();
+  if (PrintCMSStatistics != 0) {
+    gclog_or_tty->print_cr(
+        "Finished unhandled CLD scanning work in %dth thread: %3.3f sec",
+        worker_id, _timer.seconds());
   }
 
   // ---------- dirty klass scanning ----------
-  if (worker_id == 0) { // Single threaded at the moment.
-    _timer.reset();
-    _timer.start();
+  _timer.reset();
+  _timer.start();
 
-    // Scan all classes that was dirtied during the concurrent marking phase.
+  // Scan all classes that was dirtied during the concurrent marking phase.
+  // Every class loader data is claimed by exactly one worker, so the
+  // modified oops bits of its klasses are only touched by that worker.
+  {
+    GCWorkerPhaseTimer t(_times, DirtyKlassScan, worker_id);
     RemarkKlassClosure remark_klass_closure(&par_mrias_cl);
-    ClassLoaderDataGraph::classes_do(&remark_klass_closure);
-
-    _timer.stop();
-    if (PrintCMSStatistics != 0) {
-      gclog_or_tty->print_cr(
-          "Finished dirty klass scanning work in %dth thread: %3.3f sec",
-          worker_id, _timer.seconds());
+    for (int start = claim_clds(_all_clds, &_all_clds_claimed);
+         start >= 0;
+         start = claim_clds(_all_clds, &_all_clds_claimed)) {
+      int end = MIN2(start + CLDClaimChunk, _all_clds->length());
+      for (int i = start; i < end; i++) {
+        _all_clds->at(i)->classes_do(&remark_klass_closure);
+      }
     }
   }
 
+  _timer.stop();
+  if (PrintCMSStatistics != 0) {
+    gclog_or_tty->print_cr(
+        "Finished dirty klass scanning work in %dth thread: %3.3f sec",
+        worker_id, _timer.seconds());
+  }
+
   // We might have added oops to ClassLoaderData::_handles during the
   // concurrent marking phase. These oops point to newly allocated objects
   // that are guaranteed to be kept alive. Either by the direct allocation
@@ -5462,7 +5587,10 @@ void CMSParRemarkTask::work(uint worker_id) {
   // Do the rescan tasks for each of the two spaces
   // (cms_space) in turn.
   // "worker_id" is passed to select the task_queue for "worker_id"
-  do_dirty_card_rescan_tasks(_cms_space, worker_id, &par_mrias_cl);
+  {
+    GCWorkerPhaseTimer t(_times, DirtyCardRescan, worker_id);
+    do_dirty_card_rescan_tasks(_cms_space, worker_id, &par_mrias_cl);
+  }
   _timer.stop();
   if (PrintCMSStatistics != 0) {
     gclog_or_tty->print_cr(
@@ -5474,7 +5602,10 @@ void CMSParRemarkTask::work(uint worker_id) {
   // ---------- ... and drain overflow list.
   _timer.reset();
   _timer.start();
-  do_work_steal(worker_id, &par_mrias_cl, _collector->hash_seed(worker_id));
+  {
+    GCWorkerPhaseTimer t(_times, WorkStealing, worker_id);
+    do_work_steal(worker_id, &par_mrias_cl, _collector->hash_seed(worker_id));
+  }
   _timer.stop();
   if (PrintCMSStatistics != 0) {
     gclog_or_tty->print_cr(
@@ -5483,6 +5614,32 @@ void CMSParRemarkTask::work(uint worker_id) {
   }
 }
 
+int CMSParRemarkTask::claim_clds(GrowableArray<ClassLoaderData*>* clds,
+                                 volatile jint* claimed) {
+  if (*claimed >= clds->length()) {
+    return -1;
+  }
+  jint start = Atomic::add(CLDClaimChunk, claimed) - CLDClaimChunk;
+  return start < clds->length() ? start : -1;
+}
+
+GCWorkerPhaseTimes* CMSParRemarkTask::create_phase_times() {
+  static const char* const phase_names[PhaseNum] = {
+    "Young Gen Rescan",
+    "Root Rescan",
+    "New CLD Scan",
+    "Dirty Klass Scan",
+    "Dirty Card Rescan",
+    "Work Stealing"
+  };
+  GCWorkerPhaseTimes* times = new GCWorkerPhaseTimes("CMS Remark", ParallelGCThreads);
+  for (int phase = 0; phase < PhaseNum; phase++) {
+    uint index = times->add_phase(phase_names[phase]);
+    assert(index == (uint)phase, "phases out of order");
+  }
+  return times;
+}
+
 // Note that parameter "i" is not used.
 void
 CMSParMarkTask::do_young_space_rescan(uint worker_id,
@@ -5665,13 +5822,17 @@ CMSParRemarkTask::do_work_steal(int i, Par_MarkRefsIntoAndScanClosure* cl,
     // Try to steal from other queues that have work
     if (task_queues()->steal(i, seed, /* reference */ obj_to_scan)) {
       NOT_PRODUCT(num_steals++;)
+      _times->record_steal(i);
       assert(obj_to_scan->is_oop(), "Oops, not an oop!");
       assert(bm->isMarked((HeapWord*)obj_to_scan), "Stole an unmarked oop?");
       // Do scanning work
       obj_to_scan->oop_iterate(cl);
       // Loop around, finish this work, and try to steal some more
-    } else if (terminator()->offer_termination()) {
+    } else {
+      GCWorkerTerminationTimer tt(_times, i);
+      if (terminator()->offer_termination()) {
         break;  // nirvana from the infinite cycle
+      }
     }
   }
   NOT_PRODUCT(
@@ -5870,9 +6031,23 @@ void CMSCollector::do_remark_parallel() {
   }
   CompactibleFreeListSpace* cms_space  = _cmsGen->cmsSpace();
 
+  // Snapshot the class loader data for the workers to claim. We don't
+  // need to keep track of new CLDs after this remark.
+  ResourceMark rm;
+  GrowableArray<ClassLoaderData*>* new_clds = ClassLoaderDataGraph::new_clds();
+  ClassLoaderDataGraph::remember_new_clds(false);
+  GrowableArray<ClassLoaderData*>* all_clds = new GrowableArray<ClassLoaderData*>();
+  CollectCLDClosure collect_clds(all_clds);
+  ClassLoaderDataGraph::cld_do(&collect_clds);
+
+  if (_remark_phase_times == NULL) {
+    _remark_phase_times = CMSParRemarkTask::create_phase_times();
+  }
+  _remark_phase_times->note_gc_start(PrintCMSStatistics != 0);
   CMSParRemarkTask tsk(this,
     cms_space,
-    n_workers, workers, task_queues());
+    n_workers, workers, task_queues(),
+    new_clds, all_clds, _remark_phase_times);
 
   // Set up for parallel process_roots work.
   gch->set_par_threads(n_workers);
@@ -5916,6 +6091,10 @@ void CMSCollector::do_remark_parallel() {
   }
 
   gch->set_par_threads(0);  // 0 ==> non-parallel.
+  if (PrintCMSStatistics != 0 && !PrintGCWorkerPhaseTimes) {
+    _remark_phase_times->print_on(gclog_or_tty);
+  }
+  _remark_phase_times->note_gc_end(_gc_tracer_cm);
   // restore, single-threaded for now, any preserved marks
   // as a result of work_q overflow
   restore_preserved_marks_if_any();
@@ -6201,6 +6380,31 @@ void CMSRefProcTaskExecutor::execute(EnqueueTask& task)
   workers->run_task(&enq_task);
 }
 
+void CMSCollector::parallel_cleaning(FlexibleWorkGang* workers) {
+  GenCollectedHeap* gch = GenCollectedHeap::heap();
+  int n_workers = workers->active_workers();
+  if (n_workers == 0) {
+    n_workers = ParallelGCThreads;
+    workers->set_active_workers(n_workers);
+  }
+
+  // Cleaning of klasses depends on correct information from MetadataOnStackMark.
+  // The CodeCache part is done by the parallel code cache unloading,
+  // so defer the cleaning until we have complete on_stack data.
+  MetadataOnStackMark md_on_stack(false /* Don't visit the code cache at this point */);
+
+  bool purged_class = SystemDictionary::do_unloading(&_is_alive_closure, false /* Defer klass cleaning */);
+
+  {
+    ParallelCleaningTask unlink_task(&_is_alive_closure, true, true, n_workers, purged_class);
+    gch->set_par_threads(n_workers);
+    workers->run_task(&unlink_task);
+    gch->set_par_threads(0);
+  }
+
+  ClassLoaderDataGraph::free_deallocate_lists();
+}
+
 void CMSCollector::refProcessingWork(bool asynch, bool clear_all_soft_refs) {
 
   ResourceMark rm;
@@ -6262,29 +6466,36 @@ void CMSCollector::refProcessingWork(bool asynch, bool clear_all_soft_refs) {
   verify_work_stacks_empty();
 
   if (should_unload_classes()) {
-    {
-      GCTraceTime t("class unloading", PrintGCDetails, false, _gc_timer_cm, _gc_tracer_cm->gc_id());
+    GenCollectedHeap* gch = GenCollectedHeap::heap();
+    if (CMSParallelRemarkEnabled && gch->workers() != NULL &&
+        ParallelGCThreads > 1) {
+      GCTraceTime t("parallel class unloading", PrintGCDetails, false, _gc_timer_cm, _gc_tracer_cm->gc_id());
+      parallel_cleaning(gch->workers());
+    } else {
+      {
+        GCTraceTime t("class unloading", PrintGCDetails, false, _gc_timer_cm, _gc_tracer_cm->gc_id());
 
-      // Unload classes and purge the SystemDictionary.
-      bool purged_class = SystemDictionary::do_unloading(&_is_alive_closure);
+        // Unload classes and purge the SystemDictionary.
+        bool purged_class = SystemDictionary::do_unloading(&_is_alive_closure);
 
-      // Unload nmethods.
-      CodeCache::do_unloading(&_is_alive_closure, purged_class);
+        // Unload nmethods.
+        CodeCache::do_unloading(&_is_alive_closure, purged_class);
 
-      // Prune dead klasses from subklass/sibling/implementor lists.
-      Klass::clean_weak_klass_links(&_is_alive_closure);
-    }
+        // Prune dead klasses from subklass/sibling/implementor lists.
+        Klass::clean_weak_klass_links(&_is_alive_closure);
+      }
 
-    {
-      GCTraceTime t("scrub symbol table", PrintGCDetails, false, _gc_timer_cm, _gc_tracer_cm->gc_id());
-      // Clean up unreferenced symbols in symbol table.
-      SymbolTable::unlink();
-    }
+      {
+        GCTraceTime t("scrub symbol table", PrintGCDetails, false, _gc_timer_cm, _gc_tracer_cm->gc_id());
+        // Clean up unreferenced symbols in symbol table.
+        SymbolTable::unlink();
+      }
 
-    {
-      GCTraceTime t("scrub string table", PrintGCDetails, false, _gc_timer_cm, _gc_tracer_cm->gc_id());
-      // Delete entries for dead interned strings.
-      StringTable::unlink(&_is_alive_closure);
+      {
+        GCTraceTime t("scrub string table", PrintGCDetails, false, _gc_timer_cm, _gc_tracer_cm->gc_id());
+        // Delete entries for dead interned strings.
+        StringTable::unlink(&_is_alive_closure);
+      }
     }
   }
 
@@ -6534,9 +6745,23 @@ void CMSCollector::sweepWork(ConcurrentMarkSweepGeneration* gen,
                                       _intra_sweep_estimate.padded_average());
   gen->setNearLargestChunk();
 
+  // A fragmented free space can no longer supply the large blocks that
+  // promotion needs, which ends in a promotion failure and a compacting
+  // full collection. Give up on keeping blocks of the sizes the census
+  // asks for and coalesce everything we can in this sweep instead.
+  bool coalesce_all = false;
+  if (CMSReduceFragmentation) {
+    double frag = gen->cmsSpace()->flsFrag();
+    coalesce_all = frag * 100.0 > (double)CMSFragmentationThreshold;
+    if (PrintFLSStatistics != 0) {
+      gclog_or_tty->print_cr("CMS sweep: frag=%1.4f%s", frag,
+                             coalesce_all ? ", coalescing all free blocks" : "");
+    }
+  }
+
   {
     SweepClosure sweepClosure(this, gen, &_markBitMap,
-                            CMSYield && asynch);
+                            CMSYield && asynch, coalesce_all);
     gen->cmsSpace()->blk_iterate_careful(&sweepClosure);
     // We need to free-up/coalesce garbage/blocks from a
     // co-terminal free run. This is done in the SweepClosure
@@ -8158,7 +8383,8 @@ void MarkFromDirtyCardsClosure::do_MemRegion(MemRegion mr) {
 
 SweepClosure::SweepClosure(CMSCollector* collector,
                            ConcurrentMarkSweepGeneration* g,
-                           CMSBitMap* bitMap, bool should_yield) :
+                           CMSBitMap* bitMap, bool should_yield,
+                           bool coalesce_all) :
   _collector(collector),
   _g(g),
   _sp(g->cmsSpace()),
@@ -8166,6 +8392,7 @@ SweepClosure::SweepClosure(CMSCollector* collector,
   _freelistLock(_sp->freelistLock()),
   _bitMap(bitMap),
   _yield(should_yield),
+  _coalesceAll(coalesce_all),
   _inFreeRange(false),           // No free range at beginning of sweep
   _freeRangeInFreeLists(false),  // No free range at beginning of sweep
   _lastFreeRangeCoalesced(false),
@@ -8627,7 +8854,7 @@ void SweepClosure::do_post_free_or_garbage_chunk(FreeChunk* fc,
   bool coalesce = false;
   const size_t left  = pointer_delta(fc_addr, freeFinger());
   const size_t right = chunkSize;
-  switch (FLSCoalescePolicy) {
+  switch (_coalesceAll ? 4 : FLSCoalescePolicy) {
     // numeric value forms a coalition aggressiveness metric
     case 0:  { // never coalesce
       coalesce = false;
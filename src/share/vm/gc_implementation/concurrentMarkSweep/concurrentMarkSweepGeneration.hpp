@@ -63,6 +63,7 @@ class ConcurrentMarkSweepPolicy;
 class ConcurrentMarkSweepThread;
 class CompactibleFreeListSpace;
 class FreeChunk;
+class GCWorkerPhaseTimes;
 class PromotionInfo;
 class ScanMarkedObjectsAgainCarefullyClosure;
 class TenuredGeneration;
@@ -621,6 +622,11 @@ class CMSCollector: public CHeapObj<mtGC> {
   CMSTracer* _gc_tracer_cm;
   ConcurrentGCTimer* _gc_timer_cm;
 
+  // Per-worker timings of the parallel initial mark and remark,
+  // created when the parallel version first runs.
+  GCWorkerPhaseTimes* _initial_mark_phase_times;
+  GCWorkerPhaseTimes* _remark_phase_times;
+
   bool _cms_start_registered;
 
   GCHeapSummary _last_heap_summary;
@@ -825,6 +831,9 @@ class CMSCollector: public CHeapObj<mtGC> {
   void do_remark_non_parallel();
   // reference processing work routine (during second checkpoint)
   void refProcessingWork(bool asynch, bool clear_all_soft_refs);
+  // Unload classes and clean the code cache, the klass links and the
+  // string and symbol tables with the parallel GC worker threads.
+  void parallel_cleaning(FlexibleWorkGang* workers);
 
   // concurrent sweeping work
   void sweepWork(ConcurrentMarkSweepGeneration* gen, bool asynch);
@@ -1766,6 +1775,9 @@ class SweepClosure: public BlkClosureCareful {
                                         // done with yields. For instance
                                         // when done by the foreground
                                         // collector we shouldn't yield.
+  bool                           _coalesceAll;  // Coalesce all adjacent free
+                                                // blocks in this sweep, see
+                                                // CMSReduceFragmentation.
   HeapWord*                      _freeFinger;   // When _inFreeRange is set, the
                                                 // pointer to the "left hand
                                                 // chunk"
@@ -1823,7 +1835,7 @@ class SweepClosure: public BlkClosureCareful {
 
  public:
   SweepClosure(CMSCollector* collector, ConcurrentMarkSweepGeneration* g,
-               CMSBitMap* bitMap, bool should_yield);
+               CMSBitMap* bitMap, bool should_yield, bool coalesce_all);
   ~SweepClosure() PRODUCT_RETURN;
 
   size_t       do_blk_careful(HeapWord* addr);
@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_GC_IMPLEMENTATION_EPSILON_EPSILONCOLLECTORPOLICY_HPP
+#define SHARE_VM_GC_IMPLEMENTATION_EPSILON_EPSILONCOLLECTORPOLICY_HPP
+
+#include "memory/collectorPolicy.hpp"
+
+// The Epsilon heap sizes itself from the usual heap flags, but it has no
+// generations and allocates directly from EpsilonHeap, so the allocation
+// entry points of the policy are never used.
+class EpsilonCollectorPolicy: public CollectorPolicy {
+ protected:
+  virtual void initialize_alignments() {
+    size_t page_size = UseLargePages ? os::large_page_size() : os::vm_page_size();
+    _space_alignment = page_size;
+    _heap_alignment = MAX2(page_size, CollectorPolicy::compute_heap_alignment());
+  }
+
+ public:
+  EpsilonCollectorPolicy() : CollectorPolicy() {}
+
+  // The card table is kept only because the interpreter and the compilers
+  // emit its barriers; no card is ever read.
+  virtual BarrierSet::Name barrier_set_name() { return BarrierSet::CardTableModRef; }
+
+  virtual void post_heap_initialize() {}
+
+  virtual HeapWord* mem_allocate_work(size_t size,
+                                      bool is_tlab,
+                                      bool* gc_overhead_limit_was_exceeded) {
+    ShouldNotReachHere();
+    return NULL;
+  }
+
+  virtual HeapWord* satisfy_failed_allocation(size_t size, bool is_tlab) {
+    ShouldNotReachHere();
+    return NULL;
+  }
+};
+
+#endif // SHARE_VM_GC_IMPLEMENTATION_EPSILON_EPSILONCOLLECTORPOLICY_HPP
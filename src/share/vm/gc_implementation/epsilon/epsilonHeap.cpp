@@ -0,0 +1,192 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "gc_implementation/epsilon/epsilonHeap.hpp"
+#include "gc_implementation/shared/gcTimer.hpp"
+#include "gc_implementation/shared/gcTrace.hpp"
+#include "memory/cardTableModRefBS.hpp"
+#include "memory/metaspace.hpp"
+#include "memory/universe.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "services/memTracker.hpp"
+
+EpsilonHeap* EpsilonHeap::_heap = NULL;
+
+EpsilonHeap* EpsilonHeap::heap() {
+  assert(_heap != NULL, "Uninitialized access to EpsilonHeap::heap()");
+  assert(_heap->kind() == CollectedHeap::EpsilonHeap, "not an Epsilon heap");
+  return _heap;
+}
+
+jint EpsilonHeap::initialize() {
+  CollectedHeap::pre_initialize();
+
+  _policy->initialize_all();
+  size_t init_byte_size = _policy->initial_heap_byte_size();
+  size_t max_byte_size = _policy->max_heap_byte_size();
+
+  ReservedSpace heap_rs = Universe::reserve_heap(max_byte_size, _policy->heap_alignment());
+  MemTracker::record_virtual_memory_type((address)heap_rs.base(), mtJavaHeap);
+
+  os::trace_page_sizes("epsilon heap", init_byte_size, max_byte_size,
+                       _policy->space_alignment(),
+                       heap_rs.base(), heap_rs.size());
+  if (!heap_rs.is_reserved()) {
+    vm_shutdown_during_initialization(
+      "Could not reserve enough space for object heap");
+    return JNI_ENOMEM;
+  }
+  if (!_virtual_space.initialize(heap_rs, init_byte_size)) {
+    vm_shutdown_during_initialization(
+      "Could not commit the initial object heap");
+    return JNI_ENOMEM;
+  }
+
+  _reserved = MemRegion((HeapWord*)heap_rs.base(),
+                        (HeapWord*)(heap_rs.base() + heap_rs.size()));
+  MemRegion committed((HeapWord*)_virtual_space.low(),
+                      (HeapWord*)_virtual_space.high());
+
+  CardTableModRefBS* const barrier_set = new CardTableModRefBS(_reserved, 1);
+  barrier_set->initialize();
+  _barrier_set = barrier_set;
+  _barrier_set->resize_covered_region(committed);
+  oopDesc::set_bs(_barrier_set);
+
+  _space = new ContiguousSpace();
+  _space->initialize(committed, SpaceDecorator::Clear, SpaceDecorator::Mangle);
+
+  _heap = this;
+  _initialize_time_ms = os::javaTimeMillis();
+  return JNI_OK;
+}
+
+bool EpsilonHeap::expand(size_t size) {
+  assert(Heap_lock->owned_by_self(), "must hold the Heap_lock");
+  size_t space_left = _virtual_space.uncommitted_size();
+  if (size > space_left) {
+    return false;
+  }
+  size_t want = align_size_up(MAX2(size, (size_t)EpsilonMinHeapExpand),
+                              _policy->space_alignment());
+  if (!_virtual_space.expand_by(MIN2(want, space_left))) {
+    return false;
+  }
+  MemRegion committed((HeapWord*)_virtual_space.low(),
+                      (HeapWord*)_virtual_space.high());
+  // Cover the new memory with cards before any thread can allocate in it.
+  _barrier_set->resize_covered_region(committed);
+  OrderAccess::storestore();
+  _space->set_end(committed.end());
+  return true;
+}
+
+HeapWord* EpsilonHeap::allocate_work(size_t size) {
+  HeapWord* result = _space->par_allocate(size);
+  if (result == NULL) {
+    MutexLockerEx ml(Heap_lock);
+    // Another thread may have expanded the heap while we waited.
+    result = _space->par_allocate(size);
+    while (result == NULL && expand(size * HeapWordSize)) {
+      result = _space->par_allocate(size);
+    }
+  }
+  return result;
+}
+
+HeapWord* EpsilonHeap::mem_allocate(size_t size, bool* gc_overhead_limit_was_exceeded) {
+  *gc_overhead_limit_was_exceeded = false;
+  return allocate_work(size);
+}
+
+HeapWord* EpsilonHeap::allocate_new_tlab(size_t size) {
+  return allocate_work(size);
+}
+
+size_t EpsilonHeap::unsafe_max_tlab_alloc(Thread* thr) const {
+  // The committed space grows on demand, so offer what is left of the
+  // reserved space and let allocate_new_tlab() expand into it.
+  return max_capacity() - used();
+}
+
+void EpsilonHeap::collect(GCCause::Cause cause) {
+  STWGCTimer gc_timer;
+  EpsilonTracer gc_tracer;
+  gc_timer.register_gc_start();
+  gc_tracer.report_gc_start(cause, gc_timer.gc_start());
+  trace_heap_before_gc(&gc_tracer);
+
+  if (PrintGC) {
+    gclog_or_tty->print_cr("[GC request (%s) ignored, " SIZE_FORMAT "K used, "
+                           SIZE_FORMAT "K committed, " SIZE_FORMAT "K reserved]",
+                           GCCause::to_string(cause),
+                           used() / K, capacity() / K, max_capacity() / K);
+  }
+
+  trace_heap_after_gc(&gc_tracer);
+  gc_timer.register_gc_end();
+  gc_tracer.report_gc_end(gc_timer.gc_end(), gc_timer.time_partitions());
+}
+
+void EpsilonHeap::do_full_collection(bool clear_all_soft_refs) {
+  collect(gc_cause());
+}
+
+void EpsilonHeap::oop_iterate(ExtendedOopClosure* cl) {
+  _space->oop_iterate(cl);
+}
+
+void EpsilonHeap::object_iterate(ObjectClosure* cl) {
+  _space->object_iterate(cl);
+}
+
+HeapWord* EpsilonHeap::block_start(const void* addr) const {
+  return _space->block_start_const(addr);
+}
+
+size_t EpsilonHeap::block_size(const HeapWord* addr) const {
+  return _space->block_size(addr);
+}
+
+bool EpsilonHeap::block_is_obj(const HeapWord* addr) const {
+  return _space->block_is_obj(addr);
+}
+
+void EpsilonHeap::print_on(outputStream* st) const {
+  st->print_cr(" Epsilon Heap      total " SIZE_FORMAT "K, used " SIZE_FORMAT "K"
+               " [" INTPTR_FORMAT ", " INTPTR_FORMAT ", " INTPTR_FORMAT ")",
+               capacity() / K, used() / K,
+               p2i(_virtual_space.low_boundary()),
+               p2i(_virtual_space.high()),
+               p2i(_virtual_space.high_boundary()));
+  MetaspaceAux::print_on(st);
+}
+
+void EpsilonHeap::print_tracing_info() const {
+  if (PrintGCDetails) {
+    gclog_or_tty->print_cr("Epsilon Heap: " SIZE_FORMAT "K allocated, never collected",
+                           used() / K);
+  }
+}
@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_GC_IMPLEMENTATION_EPSILON_EPSILONHEAP_HPP
+#define SHARE_VM_GC_IMPLEMENTATION_EPSILON_EPSILONHEAP_HPP
+
+#include "gc_implementation/epsilon/epsilonCollectorPolicy.hpp"
+#include "gc_interface/collectedHeap.hpp"
+#include "memory/space.hpp"
+#include "runtime/virtualspace.hpp"
+
+class CardTableModRefBS;
+
+// A heap that only allocates. Objects and TLABs are bump-allocated from a
+// single contiguous space that is committed on demand; memory is never
+// reclaimed, and allocation fails with OutOfMemoryError once the reserved
+// space is used up. Collection requests are reported to the GC tracer but
+// otherwise ignored.
+class EpsilonHeap : public CollectedHeap {
+  friend class VMStructs;
+ private:
+  static EpsilonHeap* _heap;
+
+  EpsilonCollectorPolicy* _policy;
+  VirtualSpace            _virtual_space;
+  ContiguousSpace*        _space;
+  jlong                   _initialize_time_ms;
+
+  // Commits at least "size" more bytes of the reserved space and extends
+  // the space and the card table over them. Returns false if the reserved
+  // space cannot hold another "size" bytes.
+  bool expand(size_t size);
+
+  // Lock-free allocation, expanding the heap under the Heap_lock when the
+  // committed part is exhausted.
+  HeapWord* allocate_work(size_t size);
+
+ public:
+  EpsilonHeap(EpsilonCollectorPolicy* policy) :
+    CollectedHeap(), _policy(policy), _space(NULL),
+    _initialize_time_ms(0) { }
+
+  static EpsilonHeap* heap();
+
+  virtual CollectedHeap::Name kind() const { return CollectedHeap::EpsilonHeap; }
+
+  virtual jint initialize();
+  virtual void post_initialize() { CollectedHeap::post_initialize(); }
+
+  static size_t conservative_max_heap_alignment() {
+    return CollectorPolicy::compute_heap_alignment();
+  }
+
+  ContiguousSpace* space() const { return _space; }
+
+  virtual size_t capacity()     const { return _virtual_space.committed_size(); }
+  virtual size_t used()         const { return _space->used(); }
+  virtual size_t max_capacity() const { return _virtual_space.reserved_size(); }
+
+  virtual bool is_maximal_no_gc() const {
+    // No GC is going to happen, so the heap is either expandable or full.
+    return used() == max_capacity();
+  }
+
+  virtual bool is_in(const void* p) const { return _space->is_in(p); }
+
+  // Nothing is ever collected, let alone moved.
+  virtual bool is_scavengable(const void* p) { return false; }
+#ifdef ASSERT
+  virtual bool is_in_partial_collection(const void* p) { return false; }
+#endif
+
+  virtual HeapWord* mem_allocate(size_t size, bool* gc_overhead_limit_was_exceeded);
+  virtual HeapWord* allocate_new_tlab(size_t size);
+
+  virtual bool supports_tlab_allocation() const { return true; }
+  virtual size_t tlab_capacity(Thread* thr) const { return capacity(); }
+  virtual size_t tlab_used(Thread* thr) const     { return used(); }
+  virtual size_t unsafe_max_tlab_alloc(Thread* thr) const;
+
+  virtual bool can_elide_tlab_store_barriers() const { return true; }
+  virtual bool can_elide_initializing_store_barrier(oop new_obj) { return true; }
+  virtual bool card_mark_must_follow_store() const { return false; }
+
+  virtual bool supports_heap_inspection() const { return true; }
+
+  virtual void collect(GCCause::Cause cause);
+  virtual void do_full_collection(bool clear_all_soft_refs);
+
+  virtual AdaptiveSizePolicy* size_policy() { return NULL; }
+  virtual CollectorPolicy* collector_policy() const { return _policy; }
+
+  virtual void oop_iterate(ExtendedOopClosure* cl);
+  virtual void object_iterate(ObjectClosure* cl);
+  virtual void safe_object_iterate(ObjectClosure* cl) { object_iterate(cl); }
+
+  virtual HeapWord* block_start(const void* addr) const;
+  virtual size_t block_size(const HeapWord* addr) const;
+  virtual bool block_is_obj(const HeapWord* addr) const;
+
+  virtual jlong millis_since_last_gc() {
+    // No collection has ever happened; report the lifetime of the VM.
+    return os::javaTimeMillis() - _initialize_time_ms;
+  }
+
+  virtual void prepare_for_verify() {}
+  virtual void verify(bool silent, VerifyOption option) {}
+
+  virtual void print_on(outputStream* st) const;
+  virtual void print_gc_threads_on(outputStream* st) const {}
+  virtual void gc_threads_do(ThreadClosure* tc) const {}
+  virtual void print_tracing_info() const;
+};
+
+#endif // SHARE_VM_GC_IMPLEMENTATION_EPSILON_EPSILONHEAP_HPP
@@ -26,6 +26,7 @@
 #define SHARE_VM_GC_IMPLEMENTATION_G1_COLLECTIONSETCHOOSER_HPP
 
 #include "gc_implementation/g1/heapRegion.hpp"
+#include "gc_implementation/g1/heapRegionRemSet.hpp"
 #include "utilities/growableArray.hpp"
 
 class CollectionSetChooser: public CHeapObj<mtGC> {
@@ -110,6 +111,7 @@ public:
     assert(hr->is_marked(), "pre-condition");
     assert(!hr->is_young(), "should never consider young regions");
     return !hr->isHumongous() &&
+            hr->rem_set()->is_complete() &&
             hr->live_bytes() < _region_live_threshold_bytes;
   }
 
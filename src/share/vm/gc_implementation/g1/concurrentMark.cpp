@@ -549,7 +549,7 @@ ConcurrentMark::ConcurrentMark(G1CollectedHeap* g1h, G1RegionToSpaceMapper* prev
   // _active_tasks set in set_non_marking_state
   // _tasks set inside the constructor
   _task_queues(new CMTaskQueueSet((int) _max_worker_id)),
-  _terminator(ParallelTaskTerminator((int) _max_worker_id, _task_queues)),
+  _terminator((int) _max_worker_id, _task_queues),
 
   _has_overflown(false),
   _concurrent(false),
@@ -816,7 +816,7 @@ void ConcurrentMark::set_concurrency(uint active_tasks) {
   _active_tasks = active_tasks;
   // Need to update the three data structures below according to the
   // number of active threads for this phase.
-  _terminator   = ParallelTaskTerminator((int) active_tasks, _task_queues);
+  _terminator.reset_for_reuse((int) active_tasks);
   _first_overflow_barrier_sync.set_n_workers((int) active_tasks);
   _second_overflow_barrier_sync.set_n_workers((int) active_tasks);
 }
@@ -914,6 +914,12 @@ public:
   bool doHeapRegion(HeapRegion* r) {
     if (!r->continuesHumongous()) {
       r->note_start_of_marking();
+      if (!r->rem_set()->is_tracked()) {
+        // Marking will visit all live objects below NTAMS and add their
+        // references into this region; everything written from now on
+        // is recorded by refinement and evacuation.
+        r->rem_set()->set_state_rebuilding();
+      }
     }
     return false;
   }
@@ -1872,6 +1878,9 @@ public:
     double start = os::elapsedTime();
     _regions_claimed++;
     hr->note_end_of_marking();
+    if (hr->rem_set()->is_rebuilding()) {
+      hr->rem_set()->set_state_complete();
+    }
     _max_live_bytes += hr->max_live_bytes();
 
     if (hr->used() > 0 && hr->max_live_bytes() == 0 && !hr->is_young()) {
@@ -3513,11 +3522,16 @@ inline void CMTask::process_grey_object(oop obj) {
                            _worker_id, p2i((void*) obj));
   }
 
-  size_t obj_size = obj->size();
-  _words_scanned += obj_size;
+  if (scan && obj->is_objArray() &&
+      objArrayOop(obj)->length() > 2 * (int) ObjArrayMarkingStride) {
+    scan_obj_array_slice(objArrayOop(obj), 0);
+  } else {
+    size_t obj_size = obj->size();
+    _words_scanned += obj_size;
 
-  if (scan) {
-    obj->oop_iterate(_cm_oop_closure);
+    if (scan) {
+      obj->oop_iterate(_cm_oop_closure);
+    }
   }
   statsOnly( ++_objs_scanned );
   check_limits();
@@ -3526,6 +3540,43 @@ inline void CMTask::process_grey_object(oop obj) {
 template void CMTask::process_grey_object<true>(oop);
 template void CMTask::process_grey_object<false>(oop);
 
+void CMTask::scan_obj_array_slice(objArrayOop array, int start) {
+  assert(_nextMarkBitMap->isMarked((HeapWord*) array), "invariant");
+  int len = array->length();
+  int end = MIN2(len, start + (int) ObjArrayMarkingStride);
+
+  if (end < len) {
+    // Push the rest first, so that it can be stolen while we are busy.
+    address next = (address) array->base() + (size_t) end * heapOopSize;
+    push(oop((HeapWord*) ((uintptr_t) next | ArraySliceBit)));
+  }
+
+  array->oop_iterate_range(_cm_oop_closure, start, end);
+  _words_scanned += ((size_t) (end - start) * heapOopSize) / HeapWordSize;
+}
+
+void CMTask::process_array_slice(oop entry) {
+  assert(is_array_slice(entry), "invariant");
+  HeapWord* addr = (HeapWord*) ((uintptr_t) (void*) entry & ~ArraySliceBit);
+  // Only objects below NTAMS in old or humongous regions are ever pushed,
+  // so the BOT is precise enough to find the start of the array.
+  HeapRegion* hr = _g1h->heap_region_containing_raw(addr);
+  HeapWord* array_start = hr->isHumongous() ? hr->humongous_start_region()->bottom()
+                                            : hr->block_start(addr);
+  objArrayOop array = objArrayOop(array_start);
+  assert(array->is_objArray(), "slices must point into object arrays");
+  int start = (int) (pointer_delta(addr, array->base(), 1) / heapOopSize);
+
+  if (_cm->verbose_high()) {
+    gclog_or_tty->print_cr("[%u] processing array slice " PTR_FORMAT
+                           " [%d, %d)", _worker_id, p2i((void*) array),
+                           start, array->length());
+  }
+
+  scan_obj_array_slice(array, start);
+  check_limits();
+}
+
 // Closure for iteration over bitmaps
 class CMBitMapClosure : public BitMapClosure {
 private:
@@ -3927,7 +3978,7 @@ void CMTask::drain_local_queue(bool partially) {
       assert(!_g1h->is_on_master_free_list(
                   _g1h->heap_region_containing((HeapWord*) obj)), "invariant");
 
-      scan_object(obj);
+      scan_task_entry(obj);
 
       if (_task_queue->size() <= target_size || has_aborted()) {
         ret = false;
@@ -4427,9 +4478,10 @@ void CMTask::do_marking_step(double time_target_ms,
 
         statsOnly( ++_steals );
 
-        assert(_nextMarkBitMap->isMarked((HeapWord*) obj),
+        assert(is_array_slice(obj) ||
+               _nextMarkBitMap->isMarked((HeapWord*) obj),
                "any stolen object should be marked");
-        scan_object(obj);
+        scan_task_entry(obj);
 
         // And since we're towards the end, let's totally drain the
         // local queue and global stack.
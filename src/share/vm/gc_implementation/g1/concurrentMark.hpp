@@ -1109,6 +1109,22 @@ private:
 
   template<bool scan> void process_grey_object(oop obj);
 
+  // Object arrays longer than twice ObjArrayMarkingStride are scanned in
+  // slices of ObjArrayMarkingStride elements. The unscanned rest of such
+  // an array is pushed on the task queue as the address of its first
+  // element, tagged with ArraySliceBit, so that other tasks can steal it.
+  static const uintptr_t ArraySliceBit = 1;
+
+  static bool is_array_slice(oop entry) {
+    return ((uintptr_t) (void*) entry & ArraySliceBit) != 0;
+  }
+
+  // Scans the elements [start, start + ObjArrayMarkingStride) of the
+  // array and pushes the slice for the remaining elements, if any.
+  void scan_obj_array_slice(objArrayOop array, int start);
+  // Scans a slice entry popped or stolen from a task queue.
+  void process_array_slice(oop entry);
+
 public:
   // It resets the task; it should be called right at the beginning of
   // a marking phase.
@@ -1173,6 +1189,16 @@ public:
   // It scans an object and visits its children.
   void scan_object(oop obj) { process_grey_object<true>(obj); }
 
+  // It scans an entry taken from a task queue or the global stack, which
+  // is either an object or an array slice.
+  void scan_task_entry(oop entry) {
+    if (is_array_slice(entry)) {
+      process_array_slice(entry);
+    } else {
+      scan_object(entry);
+    }
+  }
+
   // It pushes an object on the local queue.
   inline void push(oop obj);
 
@@ -45,6 +45,8 @@ ConcurrentMarkThread::ConcurrentMarkThread(ConcurrentMark* cm) :
   _cm(cm),
   _started(false),
   _in_progress(false),
+  _shrink_requested(false),
+  _shrink_after_cycle(false),
   _vtime_accum(0.0),
   _vtime_mark_accum(0.0) {
   create_and_start();
@@ -294,6 +296,11 @@ void ConcurrentMarkThread::run() {
       g1h->increment_old_marking_cycles_completed(true /* concurrent */);
       g1h->register_concurrent_cycle_end();
     }
+
+    if (_shrink_after_cycle) {
+      _shrink_after_cycle = false;
+      g1h->shrink_after_periodic_collection();
+    }
   }
   assert(_should_terminate, "just checking");
 
@@ -336,7 +343,24 @@ void ConcurrentMarkThread::sleepBeforeNextCycle() {
 
   MutexLockerEx x(CGC_lock, Mutex::_no_safepoint_check_flag);
   while (!started() && !_should_terminate) {
-    CGC_lock->wait(Mutex::_no_safepoint_check_flag);
+    if (_shrink_requested) {
+      _shrink_requested = false;
+      MutexUnlockerEx ux(CGC_lock, Mutex::_no_safepoint_check_flag);
+      G1CollectedHeap::heap()->shrink_to_soft_max_capacity();
+    } else if (G1PeriodicUncommitInterval > 0) {
+      // While idle, periodically give back memory of regions that have
+      // stayed free for a while. This must not be done while holding the
+      // CGC_lock or while joined to the suspendible thread set, since it
+      // takes the Heap_lock.
+      bool timed_out = CGC_lock->wait(Mutex::_no_safepoint_check_flag,
+                                      (long) G1PeriodicUncommitInterval);
+      if (timed_out && !started() && !_should_terminate) {
+        MutexUnlockerEx ux(CGC_lock, Mutex::_no_safepoint_check_flag);
+        G1CollectedHeap::heap()->uncommit_idle_regions();
+      }
+    } else {
+      CGC_lock->wait(Mutex::_no_safepoint_check_flag);
+    }
   }
 
   if (started()) {
@@ -48,6 +48,8 @@ class ConcurrentMarkThread: public ConcurrentGCThread {
   ConcurrentMark*                  _cm;
   volatile bool                    _started;
   volatile bool                    _in_progress;
+  volatile bool                    _shrink_requested;
+  volatile bool                    _shrink_after_cycle;
 
   void sleepBeforeNextCycle();
 
@@ -79,6 +81,14 @@ class ConcurrentMarkThread: public ConcurrentGCThread {
   void clear_in_progress() { assert(!_started, "must not be starting a new cycle"); _in_progress = false; }
   bool in_progress()       { return _in_progress;  }
 
+  // Set at the end of a pause, with CGC_lock held, when the heap is
+  // above SoftMaxHeapSize. Served while waiting for the next cycle.
+  void set_shrink_requested() { _shrink_requested = true; }
+
+  // Set by the initial-mark pause of a cycle started by a periodic
+  // collection, so that the heap is shrunk when the cycle is done.
+  void set_shrink_after_cycle() { _shrink_after_cycle = true; }
+
   // This flag returns true from the moment a marking cycle is
   // initiated (during the initial-mark pause when started() is set)
   // to the moment when the cycle completes (just after the next
@@ -228,6 +228,64 @@ void DirtyCardQueueSet::apply_closure_to_all_completed_buffers(CardTableEntryClo
   }
 }
 
+bool DirtyCardQueueSet::par_apply_closure_to_completed_buffer(CardTableEntryClosure* cl,
+                                                              uint worker_i) {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
+  BufferNode* nd = _cur_par_buffer_node;
+  while (nd != NULL) {
+    BufferNode* next = (BufferNode*)nd->next();
+    BufferNode* actual = (BufferNode*)Atomic::cmpxchg_ptr((void*)next, (volatile void*)&_cur_par_buffer_node, (void*)nd);
+    if (actual == nd) {
+      bool b =
+        DirtyCardQueue::apply_closure_to_buffer(cl,
+                                                BufferNode::make_buffer_from_node(nd),
+                                                nd->index(), _sz,
+                                                true, worker_i);
+      guarantee(b, "Should not stop early.");
+      // Mark the buffer as empty.
+      nd->set_index(_sz);
+      Atomic::inc(&_processed_buffers_rs_thread);
+      return true;
+    }
+    nd = actual;
+  }
+  return false;
+}
+
+void DirtyCardQueueSet::remove_processed_completed_buffers() {
+  BufferNode* buffers_to_delete = NULL;
+  {
+    MutexLockerEx x(_cbl_mon, Mutex::_no_safepoint_check_flag);
+    BufferNode* prev = NULL;
+    BufferNode* nd = _completed_buffers_head;
+    while (nd != NULL) {
+      BufferNode* next = nd->next();
+      if (nd->index() == _sz) {
+        if (prev == NULL) {
+          _completed_buffers_head = next;
+        } else {
+          prev->set_next(next);
+        }
+        nd->set_next(buffers_to_delete);
+        buffers_to_delete = nd;
+        _n_completed_buffers--;
+        assert(_n_completed_buffers >= 0, "Invariant");
+      } else {
+        prev = nd;
+      }
+      nd = next;
+    }
+    _completed_buffers_tail = prev;
+    _cur_par_buffer_node = NULL;
+    debug_only(assert_completed_buffer_list_len_correct_locked());
+  }
+  while (buffers_to_delete != NULL) {
+    BufferNode* nd = buffers_to_delete;
+    buffers_to_delete = nd->next();
+    deallocate_buffer(BufferNode::make_buffer_from_node(nd));
+  }
+}
+
 void DirtyCardQueueSet::par_apply_closure_to_all_completed_buffers(CardTableEntryClosure* cl) {
   BufferNode* nd = _cur_par_buffer_node;
   while (nd != NULL) {
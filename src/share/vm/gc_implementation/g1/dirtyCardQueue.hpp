@@ -148,6 +148,19 @@ public:
   // Parallel version.
   void par_apply_closure_to_all_completed_buffers(CardTableEntryClosure* cl);
 
+  // Claims the next completed buffer, starting at the one set by
+  // reset_for_par_iteration(), and applies the closure to all its
+  // elements. Claiming does not take _cbl_mon, so this must only be used
+  // at a safepoint. Processed buffers are left on the completed list,
+  // emptied, until remove_processed_completed_buffers() is called.
+  // Returns false if there was no buffer left to claim.
+  bool par_apply_closure_to_completed_buffer(CardTableEntryClosure* cl,
+                                             uint worker_i);
+
+  // Removes and deallocates the buffers emptied by
+  // par_apply_closure_to_completed_buffer().
+  void remove_processed_completed_buffers();
+
   DirtyCardQueue* shared_dirty_card_queue() {
     return &_shared_dirty_card_queue;
   }
@@ -66,6 +66,7 @@ class CodeRootSetTable : public Hashtable<nmethod*, mtGC> {
 
   void copy_to(CodeRootSetTable* new_table);
   void nmethods_do(CodeBlobClosure* blk);
+  void nmethods_do(CodeBlobClosure* blk, int from_bucket, int to_bucket);
 
   template<typename CB>
   int remove_if(CB& should_remove);
@@ -169,7 +170,12 @@ void CodeRootSetTable::copy_to(CodeRootSetTable* new_table) {
 }
 
 void CodeRootSetTable::nmethods_do(CodeBlobClosure* blk) {
-  for (int index = 0; index < table_size(); ++index) {
+  nmethods_do(blk, 0, table_size());
+}
+
+void CodeRootSetTable::nmethods_do(CodeBlobClosure* blk, int from_bucket, int to_bucket) {
+  assert(0 <= from_bucket && from_bucket <= to_bucket && to_bucket <= table_size(), "invalid range");
+  for (int index = from_bucket; index < to_bucket; ++index) {
     for (Entry* e = bucket(index); e != NULL; e = e->next()) {
       blk->do_code_blob(e->literal());
     }
@@ -301,6 +307,21 @@ void G1CodeRootSet::nmethods_do(CodeBlobClosure* blk) const {
   }
 }
 
+void G1CodeRootSet::nmethods_do_par(CodeBlobClosure* blk, volatile jint* next_bucket) const {
+  CodeRootSetTable* table = _table;
+  if (table == NULL) {
+    return;
+  }
+  int size = table->table_size();
+  while (true) {
+    int start = Atomic::add(BucketsPerClaim, next_bucket) - BucketsPerClaim;
+    if (start >= size) {
+      return;
+    }
+    table->nmethods_do(blk, start, MIN2(start + BucketsPerClaim, size));
+  }
+}
+
 class CleanCallback : public StackObj {
   class PointsIntoHRDetectionClosure : public OopClosure {
     HeapRegion* _hr;
@@ -42,6 +42,9 @@ class G1CodeRootSet VALUE_OBJ_CLASS_SPEC {
   const static size_t Threshold = 24;
   const static size_t LargeSize = 512;
 
+  // Number of hash buckets claimed at a time by nmethods_do_par().
+  const static jint BucketsPerClaim = 16;
+
   CodeRootSetTable* _table;
   CodeRootSetTable* load_acquire_table();
 
@@ -69,6 +72,11 @@ class G1CodeRootSet VALUE_OBJ_CLASS_SPEC {
 
   void nmethods_do(CodeBlobClosure* blk) const;
 
+  // Apply blk to the nmethods in the buckets claimed by the caller, using
+  // next_bucket to coordinate with the other callers. The set must not
+  // change while this is going on.
+  void nmethods_do_par(CodeBlobClosure* blk, volatile jint* next_bucket) const;
+
   // Remove all nmethods which no longer contain pointers into our "owner" region
   void clean(HeapRegion* owner);
 
@@ -50,6 +50,7 @@
 #include "gc_implementation/g1/g1StringDedup.hpp"
 #include "gc_implementation/g1/g1YCTypes.hpp"
 #include "gc_implementation/g1/heapRegion.inline.hpp"
+#include "gc_implementation/g1/heapRegionBounds.inline.hpp"
 #include "gc_implementation/g1/heapRegionRemSet.hpp"
 #include "gc_implementation/g1/heapRegionSet.inline.hpp"
 #include "gc_implementation/g1/vm_operations_g1.hpp"
@@ -58,6 +59,7 @@
 #include "gc_implementation/shared/gcTrace.hpp"
 #include "gc_implementation/shared/gcTraceTime.hpp"
 #include "gc_implementation/shared/isGCActiveMark.hpp"
+#include "gc_implementation/shared/parallelCleaning.hpp"
 #include "memory/allocation.hpp"
 #include "memory/gcLocker.inline.hpp"
 #include "memory/generationSpec.hpp"
@@ -1612,6 +1614,11 @@ resize_if_necessary_after_full_collection(size_t word_size) {
   // with respect to the heap max size as it's an upper bound (i.e.,
   // we'll try to make the capacity smaller than it, not greater).
   maximum_desired_capacity =  MAX2(maximum_desired_capacity, min_heap_size);
+  // Try to get back below SoftMaxHeapSize, but not at the expense of
+  // the free space MinHeapFreeRatio asks for.
+  maximum_desired_capacity = MAX2(MIN2(maximum_desired_capacity,
+                                       collector_policy()->soft_max_heap_byte_size()),
+                                  minimum_desired_capacity);
 
   if (capacity_after_gc < minimum_desired_capacity) {
     // Don't expand unless it's significant
@@ -1830,6 +1837,75 @@ void G1CollectedHeap::shrink(size_t shrink_bytes) {
   verify_region_sets_optional();
 }
 
+uint G1CollectedHeap::uncommit_free_regions(size_t target_capacity,
+                                            jlong min_free_ms) {
+  assert(!SafepointSynchronize::is_at_safepoint(), "should not be at a safepoint");
+
+  MutexLockerEx x(Heap_lock);
+
+  // Free regions might still be waiting on the secondary free list;
+  // move them over so that all of them are candidates.
+  append_secondary_free_list_if_not_empty_with_lock();
+
+  uint min_regions =
+    (uint) (align_size_up(MAX2(target_capacity,
+                               collector_policy()->min_heap_byte_size()),
+                          HeapRegion::GrainBytes) / HeapRegion::GrainBytes);
+  min_regions = MAX2(min_regions, 1u);
+  if (num_regions() <= min_regions) {
+    return 0;
+  }
+
+  jlong free_before_ms = os::javaTimeMillis() - min_free_ms;
+  uint num_regions_removed =
+    _hrm.uncommit_idle_regions(num_regions() - min_regions, free_before_ms);
+
+  if (num_regions_removed > 0) {
+    g1_policy()->record_new_heap_size(num_regions());
+  }
+  return num_regions_removed;
+}
+
+void G1CollectedHeap::uncommit_idle_regions() {
+  assert(G1PeriodicUncommitInterval > 0, "should only be called if enabled");
+
+  uint num_regions_removed =
+    uncommit_free_regions(collector_policy()->min_heap_byte_size(),
+                          (jlong) G1UncommitDelay);
+  if (num_regions_removed > 0) {
+    ergo_verbose2(ErgoHeapSizing,
+                  "uncommit idle regions",
+                  ergo_format_byte("uncommitted amount")
+                  ergo_format_byte("capacity"),
+                  (size_t) num_regions_removed * HeapRegion::GrainBytes,
+                  capacity());
+  }
+}
+
+void G1CollectedHeap::shrink_to_soft_max_capacity() {
+  size_t soft_max_capacity = collector_policy()->soft_max_heap_byte_size();
+  uint num_regions_removed = uncommit_free_regions(soft_max_capacity, 0);
+  if (num_regions_removed > 0) {
+    ergo_verbose3(ErgoHeapSizing,
+                  "shrink the heap",
+                  ergo_format_reason("capacity higher than SoftMaxHeapSize")
+                  ergo_format_byte("uncommitted amount")
+                  ergo_format_byte("capacity")
+                  ergo_format_byte("soft max heap size"),
+                  (size_t) num_regions_removed * HeapRegion::GrainBytes,
+                  capacity(), soft_max_capacity);
+  }
+}
+
+void G1CollectedHeap::request_shrink_to_soft_max_capacity() {
+  if (capacity() <= collector_policy()->soft_max_heap_byte_size()) {
+    return;
+  }
+  MutexLockerEx x(CGC_lock, Mutex::_no_safepoint_check_flag);
+  _cmThread->set_shrink_requested();
+  CGC_lock->notify();
+}
+
 // Public methods.
 
 #ifdef _MSC_VER // the use of 'this' below gets a warning, make it go away
@@ -1869,6 +1945,8 @@ G1CollectedHeap::G1CollectedHeap(G1CollectorPolicy* policy_) :
   _old_marking_cycles_completed(0),
   _concurrent_cycle_started(false),
   _heap_summary_sent(false),
+  _last_gc_end_ms(os::javaTimeNanos() / NANOSECS_PER_MILLISEC),
+  _last_periodic_gc_check_ms(os::javaTimeNanos() / NANOSECS_PER_MILLISEC),
   _in_cset_fast_test(),
   _dirty_cards_region_list(NULL),
   _worker_cset_start_region(NULL),
@@ -1892,12 +1970,14 @@ G1CollectedHeap::G1CollectedHeap(G1CollectorPolicy* policy_) :
   _worker_cset_start_region = NEW_C_HEAP_ARRAY(HeapRegion*, n_queues, mtGC);
   _worker_cset_start_region_time_stamp = NEW_C_HEAP_ARRAY(uint, n_queues, mtGC);
   _evacuation_failed_info_array = NEW_C_HEAP_ARRAY(EvacuationFailedInfo, n_queues, mtGC);
+  _preserved_marks_set = NEW_C_HEAP_ARRAY(G1PreservedMarks*, n_queues, mtGC);
 
   for (int i = 0; i < n_queues; i++) {
     RefToScanQueue* q = new RefToScanQueue();
     q->initialize();
     _task_queues->register_queue(i, q);
     ::new (&_evacuation_failed_info_array[i]) EvacuationFailedInfo();
+    _preserved_marks_set[i] = new G1PreservedMarks();
   }
   clear_cset_start_regions();
 
@@ -2031,6 +2111,11 @@ jint G1CollectedHeap::initialize() {
     create_aux_memory_mapper("Next Bitmap", bitmap_size, CMBitMap::mark_distance());
 
   _hrm.initialize(heap_storage, prev_bitmap_storage, next_bitmap_storage, bot_storage, cardtable_storage, card_counts_storage);
+
+  _evac_failure_objs = NEW_C_HEAP_ARRAY(GrowableArray<juint>*, max_regions(), mtGC);
+  for (uint i = 0; i < max_regions(); i++) {
+    _evac_failure_objs[i] = NULL;
+  }
   g1_barrier_set()->initialize(cardtable_storage);
    // Do later initialization work for concurrent refinement.
   _cg1r->init(card_counts_storage);
@@ -2151,7 +2236,15 @@ void G1CollectedHeap::stop() {
 }
 
 size_t G1CollectedHeap::conservative_max_heap_alignment() {
-  return HeapRegion::max_region_size();
+  // Regions above the ergonomic maximum are only used when explicitly
+  // requested, so do not make every heap pay for their alignment.
+  size_t max_region_size = HeapRegionBounds::max_ergonomics_size();
+  if (G1HeapRegionSize > max_region_size) {
+    size_t region_size = (size_t) 1 << log2_long((jlong) G1HeapRegionSize);
+    max_region_size = MAX2(max_region_size,
+                           MIN2(region_size, HeapRegion::max_region_size()));
+  }
+  return max_region_size;
 }
 
 void G1CollectedHeap::ref_processing_init() {
@@ -2287,12 +2380,21 @@ void G1CollectedHeap::iterate_dirty_card_closure(CardTableEntryClosure* cl,
 
   DirtyCardQueueSet& dcqs = JavaThread::dirty_card_queue_set();
   size_t n_completed_buffers = 0;
-  while (dcqs.apply_closure_to_completed_buffer(cl, worker_i, 0, true)) {
-    n_completed_buffers++;
+  if (SafepointSynchronize::is_at_safepoint()) {
+    // Nobody else takes buffers off the completed list during a safepoint,
+    // so the workers can claim them without contending on _cbl_mon. The
+    // caller removes the processed buffers afterwards.
+    while (dcqs.par_apply_closure_to_completed_buffer(cl, worker_i)) {
+      n_completed_buffers++;
+    }
+  } else {
+    while (dcqs.apply_closure_to_completed_buffer(cl, worker_i, 0, true)) {
+      n_completed_buffers++;
+    }
+    dcqs.clear_n_completed_buffers();
+    assert(!dcqs.completed_buffers_exist_dirty(), "Completed buffers exist!");
   }
   g1_policy()->phase_times()->record_thread_work_item(G1GCPhaseTimes::UpdateRS, worker_i, n_completed_buffers);
-  dcqs.clear_n_completed_buffers();
-  assert(!dcqs.completed_buffers_exist_dirty(), "Completed buffers exist!");
 }
 
 
@@ -2333,6 +2435,7 @@ bool G1CollectedHeap::should_do_concurrent_full_gc(GCCause::Cause cause) {
     case GCCause::_gc_locker:               return GCLockerInvokesConcurrent;
     case GCCause::_java_lang_system_gc:     return ExplicitGCInvokesConcurrent;
     case GCCause::_g1_humongous_allocation: return true;
+    case GCCause::_g1_periodic_collection:  return G1PeriodicGCInvokesConcurrent;
     case GCCause::_update_allocation_context_stats_inc: return true;
     case GCCause::_wb_conc_mark:            return true;
     default:                                return false;
@@ -2605,6 +2708,12 @@ void G1CollectedHeap::object_iterate(ObjectClosure* cl) {
   heap_region_iterate(&blk);
 }
 
+void G1CollectedHeap::object_par_iterate(ObjectClosure* cl, uint worker_id, uint num_workers) {
+  IterateObjectClosureRegionClosure blk(cl);
+  heap_region_par_iterate_chunked(&blk, worker_id, num_workers,
+                                  HeapRegion::ParObjectIterateClaimValue);
+}
+
 // Calls a SpaceClosure on a HeapRegion.
 
 class SpaceClosureRegionClosure: public HeapRegionClosure {
@@ -2877,6 +2986,16 @@ bool G1CollectedHeap::block_is_obj(const HeapWord* addr) const {
   return sp->block_is_obj(addr);
 }
 
+void G1CollectedHeap::pin_object(oop obj) {
+  assert(supports_object_pinning(), "pinning not enabled");
+  heap_region_containing(obj)->increment_pinned_object_count();
+}
+
+void G1CollectedHeap::unpin_object(oop obj) {
+  assert(supports_object_pinning(), "pinning not enabled");
+  heap_region_containing(obj)->decrement_pinned_object_count();
+}
+
 bool G1CollectedHeap::supports_tlab_allocation() const {
   return true;
 }
@@ -2917,8 +3036,76 @@ size_t G1CollectedHeap::max_capacity() const {
 }
 
 jlong G1CollectedHeap::millis_since_last_gc() {
-  // assert(false, "NYI");
-  return 0;
+  jlong now_ms = os::javaTimeNanos() / NANOSECS_PER_MILLISEC;
+  return MAX2(now_ms - _last_gc_end_ms, (jlong) 0);
+}
+
+bool G1CollectedHeap::needs_periodic_collection() {
+  if (G1PeriodicGCInterval == 0) {
+    return false;
+  }
+  jlong now_ms = os::javaTimeNanos() / NANOSECS_PER_MILLISEC;
+  return now_ms - _last_periodic_gc_check_ms >= (jlong) G1PeriodicGCInterval;
+}
+
+bool G1CollectedHeap::should_start_periodic_collection() {
+  // A running cycle gives memory back by itself.
+  if (_cmThread->during_cycle()) {
+    ergo_verbose0(ErgoHeapSizing,
+                  "do not start periodic collection",
+                  ergo_format_reason("concurrent cycle already in progress"));
+    return false;
+  }
+  jlong idle_ms = millis_since_last_gc();
+  if (idle_ms < (jlong) G1PeriodicGCInterval) {
+    return false;
+  }
+  if (G1PeriodicGCSystemLoadThreshold > 0.0) {
+    double recent_load;
+    if (os::loadavg(&recent_load, 1) == -1) {
+      ergo_verbose0(ErgoHeapSizing,
+                    "do not start periodic collection",
+                    ergo_format_reason("system load not available"));
+      return false;
+    }
+    if (recent_load > G1PeriodicGCSystemLoadThreshold) {
+      ergo_verbose2(ErgoHeapSizing,
+                    "do not start periodic collection",
+                    ergo_format_reason("system load too high")
+                    ergo_format_double("recent load")
+                    ergo_format_double("threshold"),
+                    recent_load, G1PeriodicGCSystemLoadThreshold);
+      return false;
+    }
+  }
+  ergo_verbose1(ErgoHeapSizing,
+                "start periodic collection",
+                ergo_format_reason("no GC for G1PeriodicGCInterval")
+                ergo_format_ms("time since last GC"),
+                (double) idle_ms);
+  return true;
+}
+
+void G1CollectedHeap::do_periodic_collection() {
+  assert(Thread::current()->is_Java_thread(), "GC requests need the pending list lock");
+  _last_periodic_gc_check_ms = os::javaTimeNanos() / NANOSECS_PER_MILLISEC;
+  if (should_start_periodic_collection()) {
+    collect(GCCause::_g1_periodic_collection);
+  }
+}
+
+void G1CollectedHeap::shrink_after_periodic_collection() {
+  const double minimum_used_percentage = 1.0 - (double) MaxHeapFreeRatio / 100.0;
+  double target_capacity_d = (double) used_unlocked() / minimum_used_percentage;
+  size_t target_capacity = (size_t) MIN2(target_capacity_d, (double) max_capacity());
+  uint num_regions_removed = uncommit_free_regions(target_capacity, 0);
+  ergo_verbose3(ErgoHeapSizing,
+                "shrink the heap after periodic collection",
+                ergo_format_byte("uncommitted amount")
+                ergo_format_byte("capacity")
+                ergo_format_byte("target capacity"),
+                (size_t) num_regions_removed * HeapRegion::GrainBytes,
+                capacity(), target_capacity);
 }
 
 void G1CollectedHeap::prepare_for_verify() {
@@ -3415,6 +3602,31 @@ public:
   }
 };
 
+// The space between the end of a humongous object and the end of its
+// last region cannot be used for anything else. The "starts humongous"
+// region spans the whole series, so its top and end bound that space.
+class HumongousWasteClosure: public HeapRegionClosure {
+  uint   _objects;
+  size_t _waste_words;
+public:
+  HumongousWasteClosure() : _objects(0), _waste_words(0) {}
+  bool doHeapRegion(HeapRegion* r) {
+    if (r->startsHumongous()) {
+      _objects++;
+      _waste_words += pointer_delta(r->end(), r->top());
+    }
+    return false;
+  }
+  uint objects() const        { return _objects; }
+  size_t waste_bytes() const  { return _waste_words * HeapWordSize; }
+};
+
+size_t G1CollectedHeap::humongous_waste_bytes() const {
+  HumongousWasteClosure cl;
+  heap_region_iterate(&cl);
+  return cl.waste_bytes();
+}
+
 bool G1CollectedHeap::is_obj_dead_cond(const oop obj,
                                        const HeapRegion* hr,
                                        const VerifyOption vo) const {
@@ -3455,6 +3667,13 @@ void G1CollectedHeap::print_on(outputStream* st) const {
   st->print("%u survivors (" SIZE_FORMAT "K)", survivor_regions,
             (size_t) survivor_regions * HeapRegion::GrainBytes / K);
   st->cr();
+  HumongousWasteClosure humongous_cl;
+  heap_region_iterate(&humongous_cl);
+  if (humongous_cl.objects() > 0) {
+    st->print_cr("  %u humongous objects in %u regions, " SIZE_FORMAT "K unused in their last regions",
+                 humongous_cl.objects(), _humongous_set.length(),
+                 humongous_cl.waste_bytes() / K);
+  }
   MetaspaceAux::print_on(st);
 }
 
@@ -3610,6 +3829,8 @@ void G1CollectedHeap::gc_epilogue(bool full) {
   resize_all_tlabs();
   allocation_context_stats().update(full);
 
+  _last_gc_end_ms = os::javaTimeNanos() / NANOSECS_PER_MILLISEC;
+
   // We have just completed a GC. Update the soft reference
   // policy with the new heap occupancy
   Universe::update_heap_info_at_gc();
@@ -3691,6 +3912,10 @@ class RegisterHumongousWithInCSetFastTestClosure : public HeapRegionClosure {
     return oop(region->bottom())->is_typeArray();
   }
 
+  bool is_objArray_region(HeapRegion* region) const {
+    return oop(region->bottom())->is_objArray();
+  }
+
   bool humongous_region_is_candidate(G1CollectedHeap* heap, HeapRegion* region) const {
     assert(region->startsHumongous(), "Must start a humongous object");
 
@@ -3715,10 +3940,14 @@ class RegisterHumongousWithInCSetFastTestClosure : public HeapRegionClosure {
     // structures don't support efficiently performing the needed
     // additional tests or scrubbing of the mark stack.
     //
-    // However, we presently only nominate is_typeArray() objects.
     // A humongous object containing references induces remembered
-    // set entries on other regions.  In order to reclaim such an
-    // object, those remembered sets would need to be cleaned up.
+    // set entries on other regions.  These entries do not need to be
+    // cleaned up when the object is reclaimed: like the stale entries
+    // left behind by evacuated collection set regions, they are
+    // filtered by the region type and scan_top() of the region the
+    // card now belongs to.  So with G1EagerReclaimHumongousObjArrays
+    // we also nominate is_objArray() objects, but only those that
+    // satisfy the marking constraints above.
     //
     // We also treat is_typeArray() objects specially, allowing them
     // to be reclaimed even if allocated before the start of
@@ -3730,7 +3959,21 @@ class RegisterHumongousWithInCSetFastTestClosure : public HeapRegionClosure {
     // important use case for eager reclaim, and this special handling
     // may reduce needed headroom.
 
-    return is_typeArray_region(region) && is_remset_small(region);
+    // A humongous object pinned by a JNI critical section is live
+    // regardless of what the remembered set says.
+    if (region->is_pinned()) {
+      return false;
+    }
+
+    if (is_typeArray_region(region)) {
+      return is_remset_small(region);
+    }
+    if (G1EagerReclaimHumongousObjArrays && is_objArray_region(region)) {
+      return (!heap->mark_in_progress() ||
+              region->obj_allocated_since_next_marking(oop(region->bottom()))) &&
+             is_remset_small(region);
+    }
+    return false;
   }
 
  public:
@@ -3945,7 +4188,9 @@ G1CollectedHeap::do_collection_pause_at_safepoint(double target_pause_time_ms) {
   assert_at_safepoint(true /* should_be_vm_thread */);
   guarantee(!is_gc_active(), "collection is not reentrant");
 
-  if (GC_locker::check_active_before_gc()) {
+  // With region pinning, JNI critical sections do not hold off
+  // evacuation pauses: pinned regions simply fail to evacuate.
+  if (!supports_object_pinning() && GC_locker::check_active_before_gc()) {
     return false;
   }
 
@@ -4344,9 +4589,16 @@ G1CollectedHeap::do_collection_pause_at_safepoint(double target_pause_time_ms) {
     // running. Note: of course, the actual marking work will
     // not start until the safepoint itself is released in
     // SuspendibleThreadSet::desynchronize().
+    if (gc_cause() == GCCause::_g1_periodic_collection) {
+      _cmThread->set_shrink_after_cycle();
+    }
     doConcurrentMark();
   }
 
+  // Any free regions beyond SoftMaxHeapSize are given back by the
+  // concurrent mark thread once it is idle.
+  request_shrink_to_soft_max_capacity();
+
   return true;
 }
 
@@ -4371,13 +4623,18 @@ void G1CollectedHeap::remove_self_forwarding_pointers() {
   double remove_self_forwards_start = os::elapsedTime();
 
   G1ParRemoveSelfForwardPtrsTask rsfp_task(this);
+  // The marks can only be restored after the self-forwarding pointers
+  // have been removed, which resets the marks of all failed objects.
+  G1ParRestorePreservedMarksTask rpm_task(this, MAX2((uint) ParallelGCThreads, 1u));
 
   if (G1CollectedHeap::use_parallel_gc_threads()) {
     set_par_threads();
     workers()->run_task(&rsfp_task);
+    workers()->run_task(&rpm_task);
     set_par_threads(0);
   } else {
     rsfp_task.work(0);
+    rpm_task.work(0);
   }
 
   assert(check_cset_heap_region_claim_values(HeapRegion::ParEvacFailureClaimValue), "sanity");
@@ -4387,17 +4644,6 @@ void G1CollectedHeap::remove_self_forwarding_pointers() {
 
   assert(check_cset_heap_region_claim_values(HeapRegion::InitialClaimValue), "sanity");
 
-  // Now restore saved marks, if any.
-  assert(_objs_with_preserved_marks.size() ==
-            _preserved_marks_of_objs.size(), "Both or none.");
-  while (!_objs_with_preserved_marks.is_empty()) {
-    oop obj = _objs_with_preserved_marks.pop();
-    markOop m = _preserved_marks_of_objs.pop();
-    obj->set_mark(m);
-  }
-  _objs_with_preserved_marks.clear(true);
-  _preserved_marks_of_objs.clear(true);
-
   g1_policy()->phase_times()->record_evac_fail_remove_self_forwards((os::elapsedTime() - remove_self_forwards_start) * 1000.0);
 }
 
@@ -4439,13 +4685,13 @@ G1CollectedHeap::handle_evacuation_failure_par(G1ParScanThreadState* _par_scan_s
       assert(_evac_failure_closure == NULL, "Or locking has failed.");
       set_evac_failure_closure(cl);
       // Now do the common part.
-      handle_evacuation_failure_common(old, m);
+      handle_evacuation_failure_common(queue_num, old, m);
       // Reset to NULL.
       set_evac_failure_closure(NULL);
     } else {
       // The lock is already held, and this is recursive.
       assert(_drain_in_progress, "This should only be the recursive case.");
-      handle_evacuation_failure_common(old, m);
+      handle_evacuation_failure_common(queue_num, old, m);
     }
     return old;
   } else {
@@ -4460,14 +4706,15 @@ G1CollectedHeap::handle_evacuation_failure_par(G1ParScanThreadState* _par_scan_s
   }
 }
 
-void G1CollectedHeap::handle_evacuation_failure_common(oop old, markOop m) {
-  preserve_mark_if_necessary(old, m);
+void G1CollectedHeap::handle_evacuation_failure_common(uint queue_num, oop old, markOop m) {
+  preserve_mark_if_necessary(queue_num, old, m);
 
   HeapRegion* r = heap_region_containing(old);
   if (!r->evacuation_failed()) {
     r->set_evacuation_failed(true);
     _hr_printer.evac_failure(r);
   }
+  record_evac_failure_obj(r, old);
 
   push_on_evac_failure_scan_stack(old);
 
@@ -4479,16 +4726,41 @@ void G1CollectedHeap::handle_evacuation_failure_common(oop old, markOop m) {
   }
 }
 
-void G1CollectedHeap::preserve_mark_if_necessary(oop obj, markOop m) {
+void G1CollectedHeap::preserve_mark_if_necessary(uint queue_num, oop obj, markOop m) {
   assert(evacuation_failed(), "Oversaving!");
   // We want to call the "for_promotion_failure" version only in the
   // case of a promotion failure.
   if (m->must_be_preserved_for_promotion_failure(obj)) {
-    _objs_with_preserved_marks.push(obj);
-    _preserved_marks_of_objs.push(m);
+    _preserved_marks_set[queue_num]->push(obj, m);
   }
 }
 
+void G1CollectedHeap::record_evac_failure_obj(HeapRegion* r, oop obj) {
+  assert_lock_strong(EvacFailureStack_lock);
+  GrowableArray<juint>* objs = _evac_failure_objs[r->hrm_index()];
+  if (objs == NULL) {
+    objs = new (ResourceObj::C_HEAP, mtGC) GrowableArray<juint>(64, true);
+    _evac_failure_objs[r->hrm_index()] = objs;
+  }
+  objs->append((juint) pointer_delta((HeapWord*) obj, r->bottom()));
+}
+
+void G1CollectedHeap::clear_evac_failure_objs(HeapRegion* r) {
+  delete _evac_failure_objs[r->hrm_index()];
+  _evac_failure_objs[r->hrm_index()] = NULL;
+}
+
+void G1PreservedMarks::restore() {
+  assert(_objs.size() == _marks.size(), "Both or none.");
+  while (!_objs.is_empty()) {
+    oop obj = _objs.pop();
+    markOop m = _marks.pop();
+    obj->set_mark(m);
+  }
+  _objs.clear(true);
+  _marks.clear(true);
+}
+
 void G1ParCopyHelper::mark_object(oop obj) {
   assert(!_g1->heap_region_containing(obj)->in_collection_set(), "should not mark objects in the CSet");
 
@@ -4706,6 +4978,8 @@ public:
 
     _g1h->g1_policy()->phase_times()->record_time_secs(G1GCPhaseTimes::GCWorkerStart, worker_id, os::elapsedTime());
 
+    work_queue(worker_id)->numa_make_local();
+
     {
       ResourceMark rm;
       HandleMark   hm;
@@ -4805,370 +5079,6 @@ public:
   }
 };
 
-class G1StringSymbolTableUnlinkTask : public AbstractGangTask {
-private:
-  BoolObjectClosure* _is_alive;
-  int _initial_string_table_size;
-  int _initial_symbol_table_size;
-
-  bool  _process_strings;
-  int _strings_processed;
-  int _strings_removed;
-
-  bool  _process_symbols;
-  int _symbols_processed;
-  int _symbols_removed;
-
-  bool _do_in_parallel;
-public:
-  G1StringSymbolTableUnlinkTask(BoolObjectClosure* is_alive, bool process_strings, bool process_symbols) :
-    AbstractGangTask("String/Symbol Unlinking"),
-    _is_alive(is_alive),
-    _do_in_parallel(G1CollectedHeap::use_parallel_gc_threads()),
-    _process_strings(process_strings), _strings_processed(0), _strings_removed(0),
-    _process_symbols(process_symbols), _symbols_processed(0), _symbols_removed(0) {
-
-    _initial_string_table_size = StringTable::the_table()->table_size();
-    _initial_symbol_table_size = SymbolTable::the_table()->table_size();
-    if (process_strings) {
-      StringTable::clear_parallel_claimed_index();
-    }
-    if (process_symbols) {
-      SymbolTable::clear_parallel_claimed_index();
-    }
-  }
-
-  ~G1StringSymbolTableUnlinkTask() {
-    guarantee(!_process_strings || !_do_in_parallel || StringTable::parallel_claimed_index() >= _initial_string_table_size,
-              err_msg("claim value " INT32_FORMAT " after unlink less than initial string table size " INT32_FORMAT,
-                      StringTable::parallel_claimed_index(), _initial_string_table_size));
-    guarantee(!_process_symbols || !_do_in_parallel || SymbolTable::parallel_claimed_index() >= _initial_symbol_table_size,
-              err_msg("claim value " INT32_FORMAT " after unlink less than initial symbol table size " INT32_FORMAT,
-                      SymbolTable::parallel_claimed_index(), _initial_symbol_table_size));
-
-    if (G1TraceStringSymbolTableScrubbing) {
-      gclog_or_tty->print_cr("Cleaned string and symbol table, "
-                             "strings: " SIZE_FORMAT " processed, " SIZE_FORMAT " removed, "
-                             "symbols: " SIZE_FORMAT " processed, " SIZE_FORMAT " removed",
-                             strings_processed(), strings_removed(),
-                             symbols_processed(), symbols_removed());
-    }
-  }
-
-  void work(uint worker_id) {
-    if (_do_in_parallel) {
-      int strings_processed = 0;
-      int strings_removed = 0;
-      int symbols_processed = 0;
-      int symbols_removed = 0;
-      if (_process_strings) {
-        StringTable::possibly_parallel_unlink(_is_alive, &strings_processed, &strings_removed);
-        Atomic::add(strings_processed, &_strings_processed);
-        Atomic::add(strings_removed, &_strings_removed);
-      }
-      if (_process_symbols) {
-        SymbolTable::possibly_parallel_unlink(&symbols_processed, &symbols_removed);
-        Atomic::add(symbols_processed, &_symbols_processed);
-        Atomic::add(symbols_removed, &_symbols_removed);
-      }
-    } else {
-      if (_process_strings) {
-        StringTable::unlink(_is_alive, &_strings_processed, &_strings_removed);
-      }
-      if (_process_symbols) {
-        SymbolTable::unlink(&_symbols_processed, &_symbols_removed);
-      }
-    }
-  }
-
-  size_t strings_processed() const { return (size_t)_strings_processed; }
-  size_t strings_removed()   const { return (size_t)_strings_removed; }
-
-  size_t symbols_processed() const { return (size_t)_symbols_processed; }
-  size_t symbols_removed()   const { return (size_t)_symbols_removed; }
-};
-
-class G1CodeCacheUnloadingTask VALUE_OBJ_CLASS_SPEC {
-private:
-  static Monitor* _lock;
-
-  BoolObjectClosure* const _is_alive;
-  const bool               _unloading_occurred;
-  const uint               _num_workers;
-
-  // Variables used to claim nmethods.
-  nmethod* _first_nmethod;
-  volatile nmethod* _claimed_nmethod;
-
-  // The list of nmethods that need to be processed by the second pass.
-  volatile nmethod* _postponed_list;
-  volatile uint     _num_entered_barrier;
-
- public:
-  G1CodeCacheUnloadingTask(uint num_workers, BoolObjectClosure* is_alive, bool unloading_occurred) :
-      _is_alive(is_alive),
-      _unloading_occurred(unloading_occurred),
-      _num_workers(num_workers),
-      _first_nmethod(NULL),
-      _claimed_nmethod(NULL),
-      _postponed_list(NULL),
-      _num_entered_barrier(0)
-  {
-    nmethod::increase_unloading_clock();
-    _first_nmethod = CodeCache::alive_nmethod(CodeCache::first());
-    _claimed_nmethod = (volatile nmethod*)_first_nmethod;
-  }
-
-  ~G1CodeCacheUnloadingTask() {
-    CodeCache::verify_clean_inline_caches();
-
-    CodeCache::set_needs_cache_clean(false);
-    guarantee(CodeCache::scavenge_root_nmethods() == NULL, "Must be");
-
-    CodeCache::verify_icholder_relocations();
-  }
-
- private:
-  void add_to_postponed_list(nmethod* nm) {
-      nmethod* old;
-      do {
-        old = (nmethod*)_postponed_list;
-        nm->set_unloading_next(old);
-      } while ((nmethod*)Atomic::cmpxchg_ptr(nm, &_postponed_list, old) != old);
-  }
-
-  void clean_nmethod(nmethod* nm) {
-    bool postponed = nm->do_unloading_parallel(_is_alive, _unloading_occurred);
-
-    if (postponed) {
-      // This nmethod referred to an nmethod that has not been cleaned/unloaded yet.
-      add_to_postponed_list(nm);
-    }
-
-    // Mark that this thread has been cleaned/unloaded.
-    // After this call, it will be safe to ask if this nmethod was unloaded or not.
-    nm->set_unloading_clock(nmethod::global_unloading_clock());
-  }
-
-  void clean_nmethod_postponed(nmethod* nm) {
-    nm->do_unloading_parallel_postponed(_is_alive, _unloading_occurred);
-  }
-
-  static const int MaxClaimNmethods = 16;
-
-  void claim_nmethods(nmethod** claimed_nmethods, int *num_claimed_nmethods) {
-    nmethod* first;
-    nmethod* last;
-
-    do {
-      *num_claimed_nmethods = 0;
-
-      first = last = (nmethod*)_claimed_nmethod;
-
-      if (first != NULL) {
-        for (int i = 0; i < MaxClaimNmethods; i++) {
-          last = CodeCache::alive_nmethod(CodeCache::next(last));
-
-          if (last == NULL) {
-            break;
-          }
-
-          claimed_nmethods[i] = last;
-          (*num_claimed_nmethods)++;
-        }
-      }
-
-    } while ((nmethod*)Atomic::cmpxchg_ptr(last, &_claimed_nmethod, first) != first);
-  }
-
-  nmethod* claim_postponed_nmethod() {
-    nmethod* claim;
-    nmethod* next;
-
-    do {
-      claim = (nmethod*)_postponed_list;
-      if (claim == NULL) {
-        return NULL;
-      }
-
-      next = claim->unloading_next();
-
-    } while ((nmethod*)Atomic::cmpxchg_ptr(next, &_postponed_list, claim) != claim);
-
-    return claim;
-  }
-
- public:
-  // Mark that we're done with the first pass of nmethod cleaning.
-  void barrier_mark(uint worker_id) {
-    MonitorLockerEx ml(_lock, Mutex::_no_safepoint_check_flag);
-    _num_entered_barrier++;
-    if (_num_entered_barrier == _num_workers) {
-      ml.notify_all();
-    }
-  }
-
-  // See if we have to wait for the other workers to
-  // finish their first-pass nmethod cleaning work.
-  void barrier_wait(uint worker_id) {
-    if (_num_entered_barrier < _num_workers) {
-      MonitorLockerEx ml(_lock, Mutex::_no_safepoint_check_flag);
-      while (_num_entered_barrier < _num_workers) {
-          ml.wait(Mutex::_no_safepoint_check_flag, 0, false);
-      }
-    }
-  }
-
-  // Cleaning and unloading of nmethods. Some work has to be postponed
-  // to the second pass, when we know which nmethods survive.
-  void work_first_pass(uint worker_id) {
-    // The first nmethods is claimed by the first worker.
-    if (worker_id == 0 && _first_nmethod != NULL) {
-      clean_nmethod(_first_nmethod);
-      _first_nmethod = NULL;
-    }
-
-    int num_claimed_nmethods;
-    nmethod* claimed_nmethods[MaxClaimNmethods];
-
-    while (true) {
-      claim_nmethods(claimed_nmethods, &num_claimed_nmethods);
-
-      if (num_claimed_nmethods == 0) {
-        break;
-      }
-
-      for (int i = 0; i < num_claimed_nmethods; i++) {
-        clean_nmethod(claimed_nmethods[i]);
-      }
-    }
-
-    // The nmethod cleaning helps out and does the CodeCache part of MetadataOnStackMark.
-    // Need to retire the buffers now that this thread has stopped cleaning nmethods.
-    MetadataOnStackMark::retire_buffer_for_thread(Thread::current());
-  }
-
-  void work_second_pass(uint worker_id) {
-    nmethod* nm;
-    // Take care of postponed nmethods.
-    while ((nm = claim_postponed_nmethod()) != NULL) {
-      clean_nmethod_postponed(nm);
-    }
-  }
-};
-
-Monitor* G1CodeCacheUnloadingTask::_lock = new Monitor(Mutex::leaf, "Code Cache Unload lock");
-
-class G1KlassCleaningTask : public StackObj {
-  BoolObjectClosure*                      _is_alive;
-  volatile jint                           _clean_klass_tree_claimed;
-  ClassLoaderDataGraphKlassIteratorAtomic _klass_iterator;
-
- public:
-  G1KlassCleaningTask(BoolObjectClosure* is_alive) :
-      _is_alive(is_alive),
-      _clean_klass_tree_claimed(0),
-      _klass_iterator() {
-  }
-
- private:
-  bool claim_clean_klass_tree_task() {
-    if (_clean_klass_tree_claimed) {
-      return false;
-    }
-
-    return Atomic::cmpxchg(1, (jint*)&_clean_klass_tree_claimed, 0) == 0;
-  }
-
-  InstanceKlass* claim_next_klass() {
-    Klass* klass;
-    do {
-      klass =_klass_iterator.next_klass();
-    } while (klass != NULL && !klass->oop_is_instance());
-
-    return (InstanceKlass*)klass;
-  }
-
-public:
-
-  void clean_klass(InstanceKlass* ik) {
-    ik->clean_weak_instanceklass_links(_is_alive);
-
-    if (JvmtiExport::has_redefined_a_class()) {
-      InstanceKlass::purge_previous_versions(ik);
-    }
-  }
-
-  void work() {
-    ResourceMark rm;
-
-    // One worker will clean the subklass/sibling klass tree.
-    if (claim_clean_klass_tree_task()) {
-      Klass::clean_subklass_tree(_is_alive);
-    }
-
-    // All workers will help cleaning the classes,
-    InstanceKlass* klass;
-    while ((klass = claim_next_klass()) != NULL) {
-      clean_klass(klass);
-    }
-  }
-};
-
-// To minimize the remark pause times, the tasks below are done in parallel.
-class G1ParallelCleaningTask : public AbstractGangTask {
-private:
-  G1StringSymbolTableUnlinkTask _string_symbol_task;
-  G1CodeCacheUnloadingTask      _code_cache_task;
-  G1KlassCleaningTask           _klass_cleaning_task;
-
-public:
-  // The constructor is run in the VMThread.
-  G1ParallelCleaningTask(BoolObjectClosure* is_alive, bool process_strings, bool process_symbols, uint num_workers, bool unloading_occurred) :
-      AbstractGangTask("Parallel Cleaning"),
-      _string_symbol_task(is_alive, process_strings, process_symbols),
-      _code_cache_task(num_workers, is_alive, unloading_occurred),
-      _klass_cleaning_task(is_alive) {
-  }
-
-  void pre_work_verification() {
-    // The VM Thread will have registered Metadata during the single-threaded phase of MetadataStackOnMark.
-    assert(Thread::current()->is_VM_thread()
-           || !MetadataOnStackMark::has_buffer_for_thread(Thread::current()), "Should be empty");
-  }
-
-  void post_work_verification() {
-    assert(!MetadataOnStackMark::has_buffer_for_thread(Thread::current()), "Should be empty");
-  }
-
-  // The parallel work done by all worker threads.
-  void work(uint worker_id) {
-    pre_work_verification();
-
-    // Do first pass of code cache cleaning.
-    _code_cache_task.work_first_pass(worker_id);
-
-    // Let the threads mark that the first pass is done.
-    _code_cache_task.barrier_mark(worker_id);
-
-    // Clean the Strings and Symbols.
-    _string_symbol_task.work(worker_id);
-
-    // Wait for all workers to finish the first code cache cleaning pass.
-    _code_cache_task.barrier_wait(worker_id);
-
-    // Do the second code cache cleaning work, which realize on
-    // the liveness information gathered during the first pass.
-    _code_cache_task.work_second_pass(worker_id);
-
-    // Clean all klasses that were not unloaded.
-    _klass_cleaning_task.work();
-
-    post_work_verification();
-  }
-};
-
-
 void G1CollectedHeap::parallel_cleaning(BoolObjectClosure* is_alive,
                                         bool process_strings,
                                         bool process_symbols,
@@ -5176,8 +5086,8 @@ void G1CollectedHeap::parallel_cleaning(BoolObjectClosure* is_alive,
   uint n_workers = (G1CollectedHeap::use_parallel_gc_threads() ?
                     workers()->active_workers() : 1);
 
-  G1ParallelCleaningTask g1_unlink_task(is_alive, process_strings, process_symbols,
-                                        n_workers, class_unloading_occurred);
+  ParallelCleaningTask g1_unlink_task(is_alive, process_strings, process_symbols,
+                                      n_workers, class_unloading_occurred);
   if (G1CollectedHeap::use_parallel_gc_threads()) {
     set_par_threads(n_workers);
     workers()->run_task(&g1_unlink_task);
@@ -5185,6 +5095,10 @@ void G1CollectedHeap::parallel_cleaning(BoolObjectClosure* is_alive,
   } else {
     g1_unlink_task.work(0);
   }
+
+  if (G1TraceStringSymbolTableScrubbing) {
+    g1_unlink_task.string_symbol_task()->print_statistics(gclog_or_tty);
+  }
 }
 
 void G1CollectedHeap::unlink_string_and_symbol_table(BoolObjectClosure* is_alive,
@@ -5192,7 +5106,8 @@ void G1CollectedHeap::unlink_string_and_symbol_table(BoolObjectClosure* is_alive
   {
     uint n_workers = (G1CollectedHeap::use_parallel_gc_threads() ?
                      _g1h->workers()->active_workers() : 1);
-    G1StringSymbolTableUnlinkTask g1_unlink_task(is_alive, process_strings, process_symbols);
+    StringSymbolTableUnlinkTask g1_unlink_task(is_alive, process_strings, process_symbols,
+                                               G1CollectedHeap::use_parallel_gc_threads());
     if (G1CollectedHeap::use_parallel_gc_threads()) {
       set_par_threads(n_workers);
       workers()->run_task(&g1_unlink_task);
@@ -5200,6 +5115,10 @@ void G1CollectedHeap::unlink_string_and_symbol_table(BoolObjectClosure* is_alive
     } else {
       g1_unlink_task.work(0);
     }
+
+    if (G1TraceStringSymbolTableScrubbing) {
+      g1_unlink_task.print_statistics(gclog_or_tty);
+    }
   }
 
   if (G1StringDedup::is_enabled()) {
@@ -5837,7 +5756,8 @@ void G1CollectedHeap::evacuate_collection_set(EvacuationInfo& evacuation_info) {
 
     G1STWIsAliveClosure is_alive(this);
     G1KeepAliveClosure keep_alive(this);
-    G1StringDedup::unlink_or_oops_do(&is_alive, &keep_alive, true, phase_times);
+    G1StringDedup::unlink_or_oops_do(&is_alive, &keep_alive, true, phase_times,
+                                     g1_policy()->gcs_are_young());
 
     double fixup_time_ms = (os::elapsedTime() - fixup_start) * 1000.0;
     phase_times->record_string_dedup_fixup_time(fixup_time_ms);
@@ -6367,10 +6287,10 @@ class G1FreeHumongousRegionClosure : public HeapRegionClosure {
     // are completely up-to-date wrt to references to the humongous object.
     //
     // Other implementation considerations:
-    // - never consider object arrays at this time because they would pose
-    // considerable effort for cleaning up the the remembered sets. This is
-    // required because stale remembered sets might reference locations that
-    // are currently allocated into.
+    // - object arrays are only nominated if they cannot be on the mark
+    // stack (see humongous_region_is_candidate()). The remembered set entries
+    // they induced on other regions become stale, and are filtered like any
+    // other stale entry when those regions are scanned.
     uint region_idx = r->hrm_index();
     if (!g1h->is_humongous_reclaim_candidate(region_idx) ||
         !r->rem_set()->is_empty()) {
@@ -6392,8 +6312,8 @@ class G1FreeHumongousRegionClosure : public HeapRegionClosure {
       return false;
     }
 
-    guarantee(obj->is_typeArray(),
-              err_msg("Only eagerly reclaiming type arrays is supported, but the object "
+    guarantee(obj->is_typeArray() || (G1EagerReclaimHumongousObjArrays && obj->is_objArray()),
+              err_msg("Only eagerly reclaiming type and object arrays is supported, but the object "
                       PTR_FORMAT " is not.",
                       r->bottom()));
 
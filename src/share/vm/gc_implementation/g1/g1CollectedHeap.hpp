@@ -167,6 +167,22 @@ public:
   bool do_object_b(oop p);
 };
 
+// The marks of self-forwarded objects that one worker had to preserve
+// during an evacuation failure. Each worker has its own so that the
+// marks can be restored in parallel.
+class G1PreservedMarks : public CHeapObj<mtGC> {
+  Stack<oop, mtGC>     _objs;
+  Stack<markOop, mtGC> _marks;
+public:
+  void push(oop obj, markOop m) {
+    _objs.push(obj);
+    _marks.push(m);
+  }
+  bool is_empty() const { return _objs.is_empty(); }
+  // Restore all marks and release the memory used by the stacks.
+  void restore();
+};
+
 class RefineCardTableEntryClosure;
 
 class G1RegionMappingChangedListener : public G1MappingChangedListener {
@@ -342,6 +358,7 @@ private:
   // (a) cause == _gc_locker and +GCLockerInvokesConcurrent, or
   // (b) cause == _java_lang_system_gc and +ExplicitGCInvokesConcurrent.
   // (c) cause == _g1_humongous_allocation
+  // (d) cause == _g1_periodic_collection and +G1PeriodicGCInvokesConcurrent.
   bool should_do_concurrent_full_gc(GCCause::Cause cause);
 
   // Keeps track of how many "old marking cycles" (i.e., Full GCs or
@@ -752,6 +769,50 @@ protected:
   virtual void shrink(size_t expand_bytes);
   void shrink_helper(size_t expand_bytes);
 
+  // Uncommit free regions that have been free for at least min_free_ms
+  // milliseconds, keeping at least target_capacity (and never less than
+  // the minimum heap size) committed. Returns the number of regions
+  // uncommitted.
+  uint uncommit_free_regions(size_t target_capacity, jlong min_free_ms);
+
+public:
+  // Uncommit regions that have been free for at least G1UncommitDelay
+  // milliseconds, without going below the minimum heap size. This is
+  // called by the concurrent mark thread outside a safepoint while no
+  // marking cycle is in progress.
+  void uncommit_idle_regions();
+
+  // Uncommit free regions until the capacity is at most SoftMaxHeapSize,
+  // or no free regions are left. Same calling context as above.
+  void shrink_to_soft_max_capacity();
+
+  // Called at the end of a pause to have the concurrent mark thread
+  // call shrink_to_soft_max_capacity() if the heap is above
+  // SoftMaxHeapSize.
+  void request_shrink_to_soft_max_capacity();
+
+  // Uncommit free regions so that at most MaxHeapFreeRatio percent of
+  // the capacity is free, as after a full GC. Called by the concurrent
+  // mark thread when a cycle started by a periodic collection is done.
+  void shrink_after_periodic_collection();
+
+private:
+  // End of the last GC pause, and last check for a periodic collection,
+  // in milliseconds of os::javaTimeNanos().
+  jlong _last_gc_end_ms;
+  jlong _last_periodic_gc_check_ms;
+
+  // No GC for G1PeriodicGCInterval, no cycle running and the system
+  // load below G1PeriodicGCSystemLoadThreshold.
+  bool should_start_periodic_collection();
+
+public:
+  virtual jlong periodic_collection_interval_ms() const { return (jlong) G1PeriodicGCInterval; }
+  virtual bool needs_periodic_collection();
+  virtual void do_periodic_collection();
+
+protected:
+
   #if TASKQUEUE_STATS
   static void print_taskqueue_stats_hdr(outputStream* const st = gclog_or_tty);
   void print_taskqueue_stats(outputStream* const st = gclog_or_tty) const;
@@ -828,13 +889,34 @@ protected:
   // forwarding pointers to themselves.  Reset them.
   void remove_self_forwarding_pointers();
 
-  // Together, these store an object with a preserved mark, and its mark value.
-  Stack<oop, mtGC>     _objs_with_preserved_marks;
-  Stack<markOop, mtGC> _preserved_marks_of_objs;
+public:
+  // The offsets of the objects that failed evacuation in the region, or
+  // NULL if there are none.
+  GrowableArray<juint>* evac_failure_objs(HeapRegion* r) const {
+    return _evac_failure_objs[r->hrm_index()];
+  }
+  void clear_evac_failure_objs(HeapRegion* r);
+
+  G1PreservedMarks* preserved_marks(uint queue_num) const {
+    return _preserved_marks_set[queue_num];
+  }
+
+protected:
+
+  // The preserved marks of self-forwarded objects, one set per worker.
+  G1PreservedMarks**   _preserved_marks_set;
 
   // Preserve the mark of "obj", if necessary, in preparation for its mark
   // word being overwritten with a self-forwarding-pointer.
-  void preserve_mark_if_necessary(oop obj, markOop m);
+  void preserve_mark_if_necessary(uint queue_num, oop obj, markOop m);
+
+  // The word offsets of the self-forwarded objects in each region, indexed
+  // by region index and allocated when a region first fails evacuation.
+  // Recovery only visits these objects instead of walking the regions.
+  // Only added to while holding the EvacFailureStack_lock.
+  GrowableArray<juint>** _evac_failure_objs;
+
+  void record_evac_failure_obj(HeapRegion* r, oop obj);
 
   // The stack of evac-failure objects left to be scanned.
   GrowableArray<oop>*    _evac_failure_scan_stack;
@@ -865,7 +947,7 @@ protected:
 
   // An attempt to evacuate "obj" has failed; take necessary steps.
   oop handle_evacuation_failure_par(G1ParScanThreadState* _par_scan_state, oop obj);
-  void handle_evacuation_failure_common(oop obj, markOop m);
+  void handle_evacuation_failure_common(uint queue_num, oop obj, markOop m);
 
 #ifndef PRODUCT
   // Support for forcing evacuation failures. Analogous to
@@ -1288,6 +1370,12 @@ public:
     object_iterate(cl);
   }
 
+  // Iterate over the objects of the regions claimed by worker_id, one of
+  // num_workers workers doing the same, using
+  // HeapRegion::ParObjectIterateClaimValue.  The caller resets the claim
+  // values once all workers are done.
+  void object_par_iterate(ObjectClosure* cl, uint worker_id, uint num_workers);
+
   // Iterate over all spaces in use in the heap, in ascending address order.
   virtual void space_iterate(SpaceClosure* cl);
 
@@ -1393,6 +1481,14 @@ public:
   // Does this heap support heap inspection? (+PrintClassHistogram)
   virtual bool supports_heap_inspection() const { return true; }
 
+  // JNI critical sections pin the region of the object instead of
+  // locking out collections (see G1PinRegionsForJNICritical).
+  virtual bool supports_object_pinning() const {
+    return G1PinRegionsForJNICritical;
+  }
+  virtual void pin_object(oop obj);
+  virtual void unpin_object(oop obj);
+
   // Section on thread-local allocation buffers (TLABs)
   // See CollectedHeap for semantics.
 
@@ -1622,6 +1718,12 @@ public:
   bool is_obj_dead_cond(const oop obj,
                         const VerifyOption vo) const;
 
+  // The number of bytes between the end of each humongous object and
+  // the end of its last region, summed over all humongous objects.
+  // That space is unavailable for other allocations. Iterates over all
+  // regions.
+  size_t humongous_waste_bytes() const;
+
   // Printing
 
   virtual void print_on(outputStream* st) const;
@@ -92,6 +92,12 @@ G1CollectorPolicy::G1CollectorPolicy() :
   _concurrent_mark_remark_times_ms(new TruncatedSeq(NumPrevPausesForHeuristics)),
   _concurrent_mark_cleanup_times_ms(new TruncatedSeq(NumPrevPausesForHeuristics)),
 
+  _marking_times_s(new TruncatedSeq(NumPrevPausesForHeuristics)),
+  _old_gen_alloc_rate_seq(new TruncatedSeq(TruncatedSeqLength)),
+  _initial_mark_end_sec(-1.0),
+  _last_old_gen_occupancy(0),
+  _last_old_gen_occupancy_sec(0.0),
+
   _alloc_rate_ms_seq(new TruncatedSeq(TruncatedSeqLength)),
   _prev_collection_pause_end_ms(0.0),
   _rs_length_diff_seq(new TruncatedSeq(TruncatedSeqLength)),
@@ -223,6 +229,13 @@ G1CollectorPolicy::G1CollectorPolicy() :
   _non_young_other_cost_per_region_ms_seq->add(
                            non_young_other_cost_per_region_ms_defaults[index]);
 
+  _old_cost_per_byte_ms_seq = new TruncatedSeq(TruncatedSeqLength);
+  _old_cset_predicted_bytes_to_copy = 0;
+  for (uint i = 0; i < RSetSizeBucketNum; i++) {
+    _old_cost_per_entry_ms_seq[i] = new TruncatedSeq(TruncatedSeqLength);
+    _old_cset_predicted_card_num[i] = 0;
+  }
+
   // Below, we might need to calculate the pause time target based on
   // the pause interval. When we do so we are going to give G1 maximum
   // flexibility and allow it to do pauses when it needs to. So, we'll
@@ -822,6 +835,10 @@ void G1CollectorPolicy::record_full_collection_end() {
   clear_during_initial_mark_pause();
   _in_marking_window = false;
   _in_marking_window_im = false;
+  // A marking cycle aborted by the Full GC says nothing about how long
+  // marking takes.
+  _initial_mark_end_sec = -1.0;
+  update_old_gen_alloc_rate(end_sec, false /* sample */);
 
   _short_lived_surv_rate_group->start_adding_regions();
   // also call this on any additional surv rate groups
@@ -861,6 +878,11 @@ void G1CollectorPolicy::record_collection_pause_start(double start_time_sec) {
   _collection_set_bytes_used_before = 0;
   _bytes_copied_during_gc = 0;
 
+  _old_cset_predicted_bytes_to_copy = 0;
+  for (uint i = 0; i < RSetSizeBucketNum; i++) {
+    _old_cset_predicted_card_num[i] = 0;
+  }
+
   _last_gc_was_young = false;
 
   // do that for any other surv rate groups
@@ -909,15 +931,51 @@ void G1CollectorPolicy::record_concurrent_pause() {
   }
 }
 
+void G1CollectorPolicy::update_old_gen_alloc_rate(double end_time_sec, bool sample) {
+  size_t cur_old_gen_occupancy = _g1->non_young_capacity_bytes();
+  double interval_sec = end_time_sec - _last_old_gen_occupancy_sec;
+  if (sample && interval_sec > 0.0 && _last_old_gen_occupancy_sec > 0.0) {
+    // Young-only pauses do not reclaim old regions, other than eagerly
+    // reclaimed humongous ones, so any growth is due to promotion and
+    // humongous allocation.
+    size_t allocated = cur_old_gen_occupancy > _last_old_gen_occupancy ?
+                       cur_old_gen_occupancy - _last_old_gen_occupancy : 0;
+    _old_gen_alloc_rate_seq->add((double) allocated / interval_sec);
+  }
+  _last_old_gen_occupancy = cur_old_gen_occupancy;
+  _last_old_gen_occupancy_sec = end_time_sec;
+}
+
+size_t G1CollectorPolicy::marking_initiating_used_threshold() {
+  size_t static_threshold = (_g1->capacity() / 100) * InitiatingHeapOccupancyPercent;
+  if (!G1UseAdaptiveIHOP ||
+      _marking_times_s->num() < (int) G1AdaptiveIHOPNumInitialSamples ||
+      _old_gen_alloc_rate_seq->num() < (int) G1AdaptiveIHOPNumInitialSamples) {
+    return static_threshold;
+  }
+  // Start marking early enough that, at the predicted rate, the old
+  // generation plus a young generation of the current target size still
+  // fit into the heap minus the reserve once marking has finished.
+  double safe_occupancy = (double) _g1->capacity() * (1.0 - _reserve_factor);
+  double needed_during_marking =
+    get_new_prediction(_old_gen_alloc_rate_seq) * get_new_prediction(_marking_times_s) +
+    (double) young_list_target_length() * HeapRegion::GrainBytes;
+  if (needed_during_marking >= safe_occupancy) {
+    return 0;
+  }
+  return (size_t) (safe_occupancy - needed_during_marking);
+}
+
 bool G1CollectorPolicy::need_to_start_conc_mark(const char* source, size_t alloc_word_size) {
   if (_g1->concurrent_mark()->cmThread()->during_cycle()) {
     return false;
   }
 
-  size_t marking_initiating_used_threshold =
-    (_g1->capacity() / 100) * InitiatingHeapOccupancyPercent;
+  size_t marking_initiating_used_threshold = this->marking_initiating_used_threshold();
   size_t cur_used_bytes = _g1->non_young_capacity_bytes();
   size_t alloc_byte_size = alloc_word_size * HeapWordSize;
+  double threshold_percent = _g1->capacity() > 0 ?
+    (double) marking_initiating_used_threshold * 100.0 / (double) _g1->capacity() : 0.0;
 
   if ((cur_used_bytes + alloc_byte_size) > marking_initiating_used_threshold) {
     if (gcs_are_young() && !_last_young_gc) {
@@ -931,7 +989,7 @@ bool G1CollectorPolicy::need_to_start_conc_mark(const char* source, size_t alloc
         cur_used_bytes,
         alloc_byte_size,
         marking_initiating_used_threshold,
-        (double) InitiatingHeapOccupancyPercent,
+        threshold_percent,
         source);
       return true;
     } else {
@@ -945,7 +1003,7 @@ bool G1CollectorPolicy::need_to_start_conc_mark(const char* source, size_t alloc
         cur_used_bytes,
         alloc_byte_size,
         marking_initiating_used_threshold,
-        (double) InitiatingHeapOccupancyPercent,
+        threshold_percent,
         source);
     }
   }
@@ -976,7 +1034,9 @@ void G1CollectorPolicy::record_collection_pause_end(double pause_time_ms, Evacua
 #endif // PRODUCT
 
   last_pause_included_initial_mark = during_initial_mark_pause();
+  update_old_gen_alloc_rate(end_time_sec, update_stats && gcs_are_young());
   if (last_pause_included_initial_mark) {
+    _initial_mark_end_sec = end_time_sec;
     record_concurrent_mark_init_end(0.0);
   } else if (need_to_start_conc_mark("end of GC")) {
     // Note: this might have already been set, if during the last
@@ -1137,11 +1197,18 @@ void G1CollectorPolicy::record_collection_pause_end(double pause_time_ms, Evacua
       cost_per_byte_ms = phase_times()->average_time_ms(G1GCPhaseTimes::ObjCopy) / (double) copied_bytes;
       if (_in_marking_window) {
         _cost_per_byte_ms_during_cm_seq->add(cost_per_byte_ms);
-      } else {
+      } else if (_last_gc_was_young || _old_cset_predicted_bytes_to_copy == 0) {
         _cost_per_byte_ms_seq->add(cost_per_byte_ms);
       }
     }
 
+    if (!_last_gc_was_young && !_in_marking_window) {
+      update_old_region_cost_models(phase_times()->average_time_ms(G1GCPhaseTimes::ObjCopy),
+                                    copied_bytes,
+                                    phase_times()->average_time_ms(G1GCPhaseTimes::ScanRS),
+                                    cards_scanned);
+    }
+
     double all_other_time_ms = pause_time_ms -
       (phase_times()->average_time_ms(G1GCPhaseTimes::UpdateRS) + phase_times()->average_time_ms(G1GCPhaseTimes::ScanRS) +
           phase_times()->average_time_ms(G1GCPhaseTimes::ObjCopy) + phase_times()->average_time_ms(G1GCPhaseTimes::Termination));
@@ -1263,18 +1330,31 @@ void G1CollectorPolicy::adjust_concurrent_refinement(double update_rs_time,
     const int k_gy = 3, k_gr = 6;
     const double inc_k = 1.1, dec_k = 0.9;
 
+    // The number of buffers that the pause is predicted to be able to
+    // process within the Update RS time goal. Buffers above the green
+    // zone are processed concurrently, so the green zone never needs to
+    // grow beyond this: refinement threads are only kept busy when the
+    // pause budget requires it.
+    double cost_per_buffer_ms = predict_cost_per_card_ms() * (double) G1UpdateBufferSize;
+    double budget_g = (cost_per_buffer_ms > 0.0) ? goal_ms / cost_per_buffer_ms
+                                                 : (double) (max_jint / k_gr);
+    budget_g = MIN2(budget_g, (double) (max_jint / k_gr));
+
     int g = cg1r->green_zone();
     if (update_rs_time > goal_ms) {
-      g = (int)(g * dec_k);  // Can become 0, that's OK. That would mean a mutator-only processing.
+      // Can become 0, that's OK. That would mean a mutator-only processing.
+      g = (int)MIN2(g * dec_k, budget_g);
     } else {
       if (update_rs_time < goal_ms && update_rs_processed_buffers > g) {
-        g = (int)MAX2(g * inc_k, g + 1.0);
+        g = (int)MIN2(MAX2(g * inc_k, g + 1.0), MAX2(budget_g, (double) g));
       }
     }
     // Change the refinement threads params
     cg1r->set_green_zone(g);
     cg1r->set_yellow_zone(g * k_gy);
-    cg1r->set_red_zone(g * k_gr);
+    // Mutators only start processing buffers themselves once the queue
+    // would no longer fit in the pause budget, which absorbs write bursts.
+    cg1r->set_red_zone(MAX2(g * k_gr, (int) budget_g));
     cg1r->reinitialize_threads();
 
     int processing_threshold_delta = MAX2((int)(cg1r->green_zone() * sigma()), 1);
@@ -1328,6 +1408,75 @@ size_t G1CollectorPolicy::predict_bytes_to_copy(HeapRegion* hr) {
   return bytes_to_copy;
 }
 
+uint G1CollectorPolicy::rset_size_bucket(size_t rs_length) {
+  if (rs_length < HeapRegion::CardsPerRegion / 64) {
+    return RSetSizeSmall;
+  } else if (rs_length < HeapRegion::CardsPerRegion * 4) {
+    return RSetSizeMedium;
+  } else {
+    return RSetSizeLarge;
+  }
+}
+
+void G1CollectorPolicy::update_old_region_cost_models(double obj_copy_time_ms,
+                                                      size_t copied_bytes,
+                                                      double scan_rs_time_ms,
+                                                      size_t cards_scanned) {
+  // The phase times cover young and old regions alike. Take out the
+  // expected share of the young regions, using the average young cost,
+  // and attribute the rest to the old regions.
+  bool updated = false;
+
+  size_t old_bytes = MIN2(_old_cset_predicted_bytes_to_copy, copied_bytes);
+  if (old_bytes > 0) {
+    double young_time_ms = (double) (copied_bytes - old_bytes) *
+                           _cost_per_byte_ms_seq->davg();
+    double old_time_ms = obj_copy_time_ms - young_time_ms;
+    if (old_time_ms > 0.0) {
+      _old_cost_per_byte_ms_seq->add(old_time_ms / (double) old_bytes);
+      updated = true;
+    } else {
+      _cost_per_byte_ms_seq->add(obj_copy_time_ms / (double) copied_bytes);
+    }
+  }
+
+  // The RS scan time of a single pause is attributed to the bucket
+  // holding most of the old cards.
+  uint bucket = RSetSizeSmall;
+  size_t old_cards = 0;
+  for (uint i = 0; i < RSetSizeBucketNum; i++) {
+    old_cards += _old_cset_predicted_card_num[i];
+    if (_old_cset_predicted_card_num[i] > _old_cset_predicted_card_num[bucket]) {
+      bucket = i;
+    }
+  }
+  old_cards = MIN2(old_cards, cards_scanned);
+  if (old_cards > 10) {
+    double young_time_ms = (double) (cards_scanned - old_cards) *
+                           _cost_per_entry_ms_seq->davg();
+    double old_time_ms = scan_rs_time_ms - young_time_ms;
+    if (old_time_ms > 0.0) {
+      _old_cost_per_entry_ms_seq[bucket]->add(old_time_ms / (double) old_cards);
+      updated = true;
+    }
+  }
+
+  if (updated) {
+    ergo_verbose5(ErgoMixedGCs | ErgoHigh,
+                  "update old region cost model",
+                  ergo_format_ms("young copy cost per MB")
+                  ergo_format_ms("old copy cost per MB")
+                  ergo_format_size("remembered set bucket")
+                  ergo_format_ms("old scan cost per 1K cards")
+                  ergo_format_size("samples"),
+                  _cost_per_byte_ms_seq->davg() * M,
+                  _old_cost_per_byte_ms_seq->num() > 0 ? _old_cost_per_byte_ms_seq->davg() * M : 0.0,
+                  (size_t) bucket,
+                  _old_cost_per_entry_ms_seq[bucket]->num() > 0 ? _old_cost_per_entry_ms_seq[bucket]->davg() * K : 0.0,
+                  (size_t) _old_cost_per_entry_ms_seq[bucket]->num());
+  }
+}
+
 double
 G1CollectorPolicy::predict_region_elapsed_time_ms(HeapRegion* hr,
                                                   bool for_young_gc) {
@@ -1343,9 +1492,16 @@ G1CollectorPolicy::predict_region_elapsed_time_ms(HeapRegion* hr,
   }
   size_t bytes_to_copy = predict_bytes_to_copy(hr);
 
-  double region_elapsed_time_ms =
-    predict_rs_scan_time_ms(card_num) +
-    predict_object_copy_time_ms(bytes_to_copy);
+  double region_elapsed_time_ms;
+  if (hr->is_young()) {
+    region_elapsed_time_ms =
+      predict_rs_scan_time_ms(card_num) +
+      predict_object_copy_time_ms(bytes_to_copy);
+  } else {
+    region_elapsed_time_ms =
+      predict_old_rs_scan_time_ms(card_num, rset_size_bucket(rs_length)) +
+      predict_old_object_copy_time_ms(bytes_to_copy);
+  }
 
   // The prediction of the "other" time for this region is based
   // upon the region type and NOT the GC type.
@@ -1395,6 +1551,25 @@ size_t G1CollectorPolicy::expansion_amount() {
     expand_bytes = MAX2(expand_bytes, min_expand_bytes);
     expand_bytes = MIN2(expand_bytes, uncommitted_bytes);
 
+    // Do not grow past SoftMaxHeapSize to improve throughput; only
+    // allocation failures may take the heap beyond it.
+    size_t soft_max_bytes = soft_max_heap_byte_size();
+    if (committed_bytes + expand_bytes > soft_max_bytes) {
+      size_t limited_bytes = committed_bytes < soft_max_bytes ?
+                             soft_max_bytes - committed_bytes : 0;
+      ergo_verbose3(ErgoHeapSizing,
+                    "limit heap expansion",
+                    ergo_format_reason("expansion would exceed SoftMaxHeapSize")
+                    ergo_format_byte("committed")
+                    ergo_format_byte("soft max heap size")
+                    ergo_format_byte("limited expansion amount"),
+                    committed_bytes, soft_max_bytes, limited_bytes);
+      if (limited_bytes == 0) {
+        return 0;
+      }
+      expand_bytes = limited_bytes;
+    }
+
     ergo_verbose5(ErgoHeapSizing,
                   "attempt heap expansion",
                   ergo_format_reason("recent GC overhead higher than "
@@ -1563,6 +1738,10 @@ public:
       // before we fill them up).
       if (_hrSorted->should_add(r) && !_g1h->is_old_gc_alloc_region(r)) {
         _hrSorted->add_region(r);
+      } else if (G1RebuildRemSetsForCandidatesOnly && r->is_old()) {
+        // Not a candidate for the upcoming mixed GCs, so there is no
+        // need to maintain its remembered set until the next marking.
+        r->rem_set()->set_state_untracked();
       }
     }
     return false;
@@ -1587,6 +1766,10 @@ public:
       // before we fill them up).
       if (_cset_updater.should_add(r) && !_g1h->is_old_gc_alloc_region(r)) {
         _cset_updater.add_region(r);
+      } else if (G1RebuildRemSetsForCandidatesOnly && r->is_old()) {
+        // Not a candidate for the upcoming mixed GCs, so there is no
+        // need to maintain its remembered set until the next marking.
+        r->rem_set()->set_state_untracked();
       }
     }
     return false;
@@ -1656,6 +1839,10 @@ G1CollectorPolicy::record_concurrent_mark_cleanup_end(int no_of_gc_threads) {
   double end_sec = os::elapsedTime();
   double elapsed_time_ms = (end_sec - _mark_cleanup_start_sec) * 1000.0;
   _concurrent_mark_cleanup_times_ms->add(elapsed_time_ms);
+  if (_initial_mark_end_sec >= 0.0) {
+    _marking_times_s->add(end_sec - _initial_mark_end_sec);
+    _initial_mark_end_sec = -1.0;
+  }
   _cur_mark_stop_world_time_ms += elapsed_time_ms;
   _prev_collection_pause_end_ms += elapsed_time_ms;
   _mmu_tracker->add_pause(_mark_cleanup_start_sec, end_sec, true);
@@ -1675,6 +1862,10 @@ void G1CollectorPolicy::add_old_region_to_cset(HeapRegion* hr) {
   size_t rs_length = hr->rem_set()->occupied();
   _recorded_rs_lengths += rs_length;
   _old_cset_region_length += 1;
+
+  _old_cset_predicted_bytes_to_copy += predict_bytes_to_copy(hr);
+  _old_cset_predicted_card_num[rset_size_bucket(rs_length)] +=
+    predict_non_young_card_num(rs_length);
 }
 
 // Initialize the per-collection-set information
@@ -188,6 +188,24 @@ private:
   TruncatedSeq* _concurrent_mark_remark_times_ms;
   TruncatedSeq* _concurrent_mark_cleanup_times_ms;
 
+  // Support for G1UseAdaptiveIHOP.
+  // Recent lengths of marking cycles in seconds, measured from the end
+  // of the initial-mark pause to the end of the Cleanup pause.
+  TruncatedSeq* _marking_times_s;
+  // Recent rates, in bytes per second, at which the old generation grew
+  // between young-only pauses.
+  TruncatedSeq* _old_gen_alloc_rate_seq;
+  // End of the last initial-mark pause, or a negative value if there is
+  // no marking cycle in progress whose length we can measure.
+  double _initial_mark_end_sec;
+  // Old generation occupancy and time at the end of the last pause.
+  size_t _last_old_gen_occupancy;
+  double _last_old_gen_occupancy_sec;
+
+  void update_old_gen_alloc_rate(double end_time_sec, bool sample);
+  // The non-young occupancy above which a marking cycle should be started.
+  size_t marking_initiating_used_threshold();
+
   TraceGen0TimeData _trace_gen0_time_data;
   TraceGen1TimeData _trace_gen1_time_data;
 
@@ -245,6 +263,32 @@ private:
 
   TruncatedSeq* _cost_per_byte_ms_during_cm_seq;
 
+  // Old regions differ a lot from young ones in live density and
+  // remembered set size, so their copy and RS scan costs are learned
+  // separately from mixed GCs. RS scan costs are further split by the
+  // size of the remembered set of the region.
+  enum {
+    RSetSizeSmall,
+    RSetSizeMedium,
+    RSetSizeLarge,
+    RSetSizeBucketNum
+  };
+  TruncatedSeq* _old_cost_per_byte_ms_seq;
+  TruncatedSeq* _old_cost_per_entry_ms_seq[RSetSizeBucketNum];
+
+  // The predicted bytes to copy and cards to scan of the old regions
+  // in the current collection set, used to learn the models above.
+  size_t _old_cset_predicted_bytes_to_copy;
+  size_t _old_cset_predicted_card_num[RSetSizeBucketNum];
+
+  static uint rset_size_bucket(size_t rs_length);
+
+  // Learns the old region cost models from the last mixed GC.
+  void update_old_region_cost_models(double obj_copy_time_ms,
+                                     size_t copied_bytes,
+                                     double scan_rs_time_ms,
+                                     size_t cards_scanned);
+
   G1YoungGenSizer* _young_gen_sizer;
 
   uint _eden_cset_region_length;
@@ -398,6 +442,24 @@ public:
     }
   }
 
+  double predict_old_rs_scan_time_ms(size_t card_num, uint bucket) {
+    if (_old_cost_per_entry_ms_seq[bucket]->num() < 3) {
+      return predict_mixed_rs_scan_time_ms(card_num);
+    } else {
+      return (double) card_num *
+             get_new_prediction(_old_cost_per_entry_ms_seq[bucket]);
+    }
+  }
+
+  double predict_old_object_copy_time_ms(size_t bytes_to_copy) {
+    if (_old_cost_per_byte_ms_seq->num() < 3) {
+      return predict_object_copy_time_ms(bytes_to_copy);
+    } else {
+      return (double) bytes_to_copy *
+             get_new_prediction(_old_cost_per_byte_ms_seq);
+    }
+  }
+
   double predict_constant_other_time_ms() {
     return get_new_prediction(_constant_other_time_ms_seq);
   }
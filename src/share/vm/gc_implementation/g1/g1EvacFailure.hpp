@@ -61,7 +61,7 @@ public:
   }
 };
 
-class RemoveSelfForwardPtrObjClosure: public ObjectClosure {
+class RemoveSelfForwardPtrObjClosure: public StackObj {
 private:
   G1CollectedHeap* _g1;
   ConcurrentMark* _cm;
@@ -71,9 +71,75 @@ private:
   bool _during_initial_mark;
   bool _during_conc_mark;
   uint _worker_id;
-  HeapWord* _end_of_last_gap;
-  HeapWord* _last_gap_threshold;
-  HeapWord* _last_obj_threshold;
+  HeapWord* _end_of_last_obj;
+
+  static int compare_offsets(juint* a, juint* b) {
+    return (*a < *b) ? -1 : ((*a == *b) ? 0 : 1);
+  }
+
+  // Everything in [start, end) has been either evacuated or is dead.
+  // Turn it into a single dummy object. The BOT has been reset for the
+  // region, so coalescing those objects is fine as long as the BOT is
+  // refined for the filler.
+  void fill_gap(HeapWord* start, HeapWord* end) {
+    if (start == end) {
+      return;
+    }
+    MemRegion mr(start, end);
+    CollectedHeap::fill_with_object(mr);
+    _hr->cross_threshold(start, end);
+
+    // must nuke all dead objects which we skip over
+    _cm->clearRangePrevBitmap(mr);
+  }
+
+  void do_failed_object(oop obj) {
+    HeapWord* obj_addr = (HeapWord*) obj;
+    assert(_hr->is_in(obj_addr), "sanity");
+    assert(obj->is_forwarded() && obj->forwardee() == obj,
+           "only self-forwarded objects are recorded");
+    size_t obj_size = obj->size();
+    HeapWord* obj_end = obj_addr + obj_size;
+
+    // We consider all objects that we find self-forwarded to be
+    // live. What we'll do is that we'll update the prev marking
+    // info so that they are all under PTAMS and explicitly marked.
+    if (!_cm->isPrevMarked(obj)) {
+      _cm->markPrev(obj);
+    }
+    if (_during_initial_mark) {
+      // For the next marking info we'll only mark the
+      // self-forwarded objects explicitly if we are during
+      // initial-mark (since, normally, we only mark objects pointed
+      // to by roots if we succeed in copying them). By marking all
+      // self-forwarded objects we ensure that we mark any that are
+      // still pointed to be roots. During concurrent marking, and
+      // after initial-mark, we don't need to mark any objects
+      // explicitly and all objects in the CSet are considered
+      // (implicitly) live. So, we won't mark them explicitly and
+      // we'll leave them over NTAMS.
+      _cm->grayRoot(obj, obj_size, _worker_id, _hr);
+    }
+    _marked_bytes += (obj_size * HeapWordSize);
+    obj->set_mark(markOopDesc::prototype());
+
+    // While we were processing RSet buffers during the collection,
+    // we actually didn't scan any cards on the collection set,
+    // since we didn't want to update remembered sets with entries
+    // that point into the collection set, given that live objects
+    // from the collection set are about to move and such entries
+    // will be stale very soon.
+    // This change also dealt with a reliability issue which
+    // involved scanning a card in the collection set and coming
+    // across an array that was being chunked and looking malformed.
+    // The problem is that, if evacuation fails, we might have
+    // remembered set entries missing given that we skipped cards on
+    // the collection set. So, we'll recreate such entries now.
+    obj->oop_iterate(_update_rset_cl);
+
+    _hr->cross_threshold(obj_addr, obj_end);
+    _end_of_last_obj = obj_end;
+  }
 
 public:
   RemoveSelfForwardPtrObjClosure(G1CollectedHeap* g1, ConcurrentMark* cm,
@@ -87,89 +153,22 @@ public:
     _during_initial_mark(during_initial_mark),
     _during_conc_mark(during_conc_mark),
     _worker_id(worker_id),
-    _end_of_last_gap(hr->bottom()),
-    _last_gap_threshold(hr->bottom()),
-    _last_obj_threshold(hr->bottom()) { }
+    _end_of_last_obj(hr->bottom()) { }
 
   size_t marked_bytes() { return _marked_bytes; }
 
-  // <original comment>
-  // The original idea here was to coalesce evacuated and dead objects.
-  // However that caused complications with the block offset table (BOT).
-  // In particular if there were two TLABs, one of them partially refined.
-  // |----- TLAB_1--------|----TLAB_2-~~~(partially refined part)~~~|
-  // The BOT entries of the unrefined part of TLAB_2 point to the start
-  // of TLAB_2. If the last object of the TLAB_1 and the first object
-  // of TLAB_2 are coalesced, then the cards of the unrefined part
-  // would point into middle of the filler object.
-  // The current approach is to not coalesce and leave the BOT contents intact.
-  // </original comment>
-  //
-  // We now reset the BOT when we start the object iteration over the
-  // region and refine its entries for every object we come across. So
-  // the above comment is not really relevant and we should be able
-  // to coalesce dead objects if we want to.
-  void do_object(oop obj) {
-    HeapWord* obj_addr = (HeapWord*) obj;
-    assert(_hr->is_in(obj_addr), "sanity");
-    size_t obj_size = obj->size();
-    HeapWord* obj_end = obj_addr + obj_size;
-
-    if (_end_of_last_gap != obj_addr) {
-      // there was a gap before obj_addr
-      _last_gap_threshold = _hr->cross_threshold(_end_of_last_gap, obj_addr);
+  // Visit the self-forwarded objects, given as word offsets from the
+  // bottom of the region, in address order and replace everything
+  // between them with dummy objects. Unlike walking the region, this
+  // never reads the headers of the evacuated or dead objects.
+  void remove_self_forwards(GrowableArray<juint>* offsets) {
+    offsets->sort(compare_offsets);
+    for (int i = 0; i < offsets->length(); i++) {
+      HeapWord* obj_addr = _hr->bottom() + offsets->at(i);
+      fill_gap(_end_of_last_obj, obj_addr);
+      do_failed_object(oop(obj_addr));
     }
-
-    if (obj->is_forwarded() && obj->forwardee() == obj) {
-      // The object failed to move.
-
-      // We consider all objects that we find self-forwarded to be
-      // live. What we'll do is that we'll update the prev marking
-      // info so that they are all under PTAMS and explicitly marked.
-      if (!_cm->isPrevMarked(obj)) {
-        _cm->markPrev(obj);
-      }
-      if (_during_initial_mark) {
-        // For the next marking info we'll only mark the
-        // self-forwarded objects explicitly if we are during
-        // initial-mark (since, normally, we only mark objects pointed
-        // to by roots if we succeed in copying them). By marking all
-        // self-forwarded objects we ensure that we mark any that are
-        // still pointed to be roots. During concurrent marking, and
-        // after initial-mark, we don't need to mark any objects
-        // explicitly and all objects in the CSet are considered
-        // (implicitly) live. So, we won't mark them explicitly and
-        // we'll leave them over NTAMS.
-        _cm->grayRoot(obj, obj_size, _worker_id, _hr);
-      }
-      _marked_bytes += (obj_size * HeapWordSize);
-      obj->set_mark(markOopDesc::prototype());
-
-      // While we were processing RSet buffers during the collection,
-      // we actually didn't scan any cards on the collection set,
-      // since we didn't want to update remembered sets with entries
-      // that point into the collection set, given that live objects
-      // from the collection set are about to move and such entries
-      // will be stale very soon.
-      // This change also dealt with a reliability issue which
-      // involved scanning a card in the collection set and coming
-      // across an array that was being chunked and looking malformed.
-      // The problem is that, if evacuation fails, we might have
-      // remembered set entries missing given that we skipped cards on
-      // the collection set. So, we'll recreate such entries now.
-      obj->oop_iterate(_update_rset_cl);
-    } else {
-
-      // The object has been either evacuated or is dead. Fill it with a
-      // dummy object.
-      MemRegion mr(obj_addr, obj_size);
-      CollectedHeap::fill_with_object(mr);
-
-      // must nuke all dead objects which we skipped when iterating over the region
-      _cm->clearRangePrevBitmap(MemRegion(_end_of_last_gap, obj_end));
-    }
-    _end_of_last_gap = obj_end;
-    _last_obj_threshold = _hr->cross_threshold(obj_addr, obj_end);
+    fill_gap(_end_of_last_obj, _hr->top());
   }
 };
 
@@ -217,7 +216,10 @@ public:
         hr->rem_set()->reset_for_par_iteration();
         hr->reset_bot();
         _update_rset_cl.set_region(hr);
-        hr->object_iterate(&rspc);
+        GrowableArray<juint>* failed_objs = _g1h->evac_failure_objs(hr);
+        assert(failed_objs != NULL, "a region that failed evacuation has failed objects");
+        rspc.remove_self_forwards(failed_objs);
+        _g1h->clear_evac_failure_objs(hr);
 
         hr->rem_set()->clean_strong_code_roots(hr);
 
@@ -247,4 +249,25 @@ public:
   }
 };
 
+class G1ParRestorePreservedMarksTask: public AbstractGangTask {
+protected:
+  G1CollectedHeap* _g1h;
+  uint _num_sets;
+  volatile jint _next_set;
+
+public:
+  G1ParRestorePreservedMarksTask(G1CollectedHeap* g1h, uint num_sets) :
+    AbstractGangTask("G1 Restore Preserved Marks"),
+    _g1h(g1h), _num_sets(num_sets), _next_set(0) { }
+
+  void work(uint worker_id) {
+    // The sets are claimed dynamically since only the workers that hit
+    // an evacuation failure have marks to restore.
+    uint set;
+    while ((set = (uint) (Atomic::add(1, &_next_set) - 1)) < _num_sets) {
+      _g1h->preserved_marks(set)->restore();
+    }
+  }
+};
+
 #endif // SHARE_VM_GC_IMPLEMENTATION_G1_G1EVACFAILURE_HPP
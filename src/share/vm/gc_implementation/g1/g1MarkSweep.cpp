@@ -237,6 +237,25 @@ class G1AdjustPointersClosure: public HeapRegionClosure {
   }
 };
 
+// Adjusting the pointers of the objects in a region only reads the
+// forwarding information computed in phase 2 and only writes to the
+// fields of the objects in that region, so the regions can be
+// processed by the GC worker threads in parallel.
+class G1ParAdjustPointersTask: public AbstractGangTask {
+  G1CollectedHeap* _g1h;
+public:
+  G1ParAdjustPointersTask(G1CollectedHeap* g1h)
+    : AbstractGangTask("G1 Par Adjust Pointers"),
+      _g1h(g1h) { }
+
+  void work(uint worker_id) {
+    G1AdjustPointersClosure blk;
+    _g1h->heap_region_par_iterate_chunked(&blk, worker_id,
+                                          _g1h->workers()->active_workers(),
+                                          HeapRegion::ParAdjustPointersClaimValue);
+  }
+};
+
 class G1AlwaysTrueClosure: public BoolObjectClosure {
 public:
   bool do_object_b(oop p) { return true; }
@@ -274,8 +293,21 @@ void G1MarkSweep::mark_sweep_phase3() {
 
   GenMarkSweep::adjust_marks();
 
-  G1AdjustPointersClosure blk;
-  g1h->heap_region_iterate(&blk);
+  if (G1CollectedHeap::use_parallel_gc_threads() &&
+      G1ParallelFullGCAdjustPointers) {
+    assert(g1h->check_heap_region_claim_values(HeapRegion::InitialClaimValue),
+           "sanity check");
+    G1ParAdjustPointersTask task(g1h);
+    g1h->set_par_threads(g1h->workers()->active_workers());
+    g1h->workers()->run_task(&task);
+    g1h->set_par_threads(0);
+    assert(g1h->check_heap_region_claim_values(HeapRegion::ParAdjustPointersClaimValue),
+           "sanity check");
+    g1h->reset_heap_region_claim_values();
+  } else {
+    G1AdjustPointersClosure blk;
+    g1h->heap_region_iterate(&blk);
+  }
 }
 
 class G1SpaceCompactClosure: public HeapRegionClosure {
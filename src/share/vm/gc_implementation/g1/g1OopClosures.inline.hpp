@@ -121,6 +121,13 @@ inline void G1CMOopClosure::do_oop_nv(T* p) {
                            "*" PTR_FORMAT " = " PTR_FORMAT,
                            _task->worker_id(), p2i(p), p2i((void*) obj));
   }
+  if (G1RebuildRemSetsForCandidatesOnly && obj != NULL) {
+    HeapRegion* to = _g1h->heap_region_containing_raw(obj);
+    if (to->rem_set()->is_rebuilding() &&
+        _g1h->is_in_g1_reserved(p) && !to->is_in_reserved(p)) {
+      to->rem_set()->add_reference(p, _task->worker_id());
+    }
+  }
   _task->deal_with_reference(obj);
 }
 
@@ -24,6 +24,7 @@
 
 #include "precompiled.hpp"
 #include "gc_implementation/g1/g1PageBasedVirtualSpace.hpp"
+#include "memory/pretouchTask.hpp"
 #include "oops/markOop.hpp"
 #include "oops/oop.inline.hpp"
 #include "services/memTracker.hpp"
@@ -197,7 +198,7 @@ void G1PageBasedVirtualSpace::pretouch_internal(size_t start_page, size_t end_pa
   guarantee(start_page < end_page,
             err_msg("Given start page " SIZE_FORMAT " is larger or equal to end page " SIZE_FORMAT, start_page, end_page));
 
-  os::pretouch_memory(page_start(start_page), bounded_end_addr(end_page));
+  PretouchTask::pretouch(page_start(start_page), bounded_end_addr(end_page), _page_size);
 }
 
 bool G1PageBasedVirtualSpace::commit(size_t start_page, size_t size_in_pages) {
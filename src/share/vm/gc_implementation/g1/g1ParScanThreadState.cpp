@@ -209,6 +209,12 @@ oop G1ParScanThreadState::copy_to_survivor_space(InCSetState const state,
          (!from_region->is_young() && young_index == 0), "invariant" );
   const AllocationContext_t context = from_region->allocation_context();
 
+  if (from_region->is_pinned()) {
+    // Objects in regions pinned by JNI critical sections must stay where
+    // they are; treat them exactly like a failed evacuation.
+    return _g1h->handle_evacuation_failure_par(this, old);
+  }
+
   uint age = 0;
   InCSetState dest_state = next_state(state, old_mark, age);
   HeapWord* obj_ptr = _g1_par_allocator->plab_allocate(dest_state, word_sz, context);
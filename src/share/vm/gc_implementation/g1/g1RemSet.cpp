@@ -170,7 +170,9 @@ public:
 
   void scan_strong_code_roots(HeapRegion* r) {
     double scan_start = os::elapsedTime();
-    r->strong_code_roots_do(_code_root_cl);
+    // A region may be referenced from many nmethods, so all workers
+    // that come across it help scanning its code roots.
+    r->rem_set()->strong_code_roots_do_par(_code_root_cl);
     _strong_code_root_scan_time_sec += (os::elapsedTime() - scan_start);
   }
 
@@ -218,10 +220,10 @@ public:
         scanCard(card_index, card_region);
       }
     }
-    if (!_try_claimed) {
-      // Scan the strong code root list attached to the current region
-      scan_strong_code_roots(r);
+    // Scan the strong code root list attached to the current region
+    scan_strong_code_roots(r);
 
+    if (!_try_claimed) {
       hrrs->set_iter_complete();
     }
     return false;
@@ -338,6 +340,7 @@ void G1RemSet::prepare_for_oops_into_collection_set_do() {
   _g1->set_refine_cte_cl_concurrency(false);
   DirtyCardQueueSet& dcqs = JavaThread::dirty_card_queue_set();
   dcqs.concatenate_logs();
+  dcqs.reset_for_par_iteration();
 
   guarantee( _cards_scanned == NULL, "invariant" );
   _cards_scanned = NEW_C_HEAP_ARRAY(size_t, n_workers(), mtGC);
@@ -355,6 +358,8 @@ void G1RemSet::cleanup_after_oops_into_collection_set_do() {
   }
   FREE_C_HEAP_ARRAY(size_t, _cards_scanned, mtGC);
   _cards_scanned = NULL;
+  // Free the buffers processed during the Update RS phase.
+  JavaThread::dirty_card_queue_set().remove_processed_completed_buffers();
   // Cleanup after copy
   _g1->set_refine_cte_cl_concurrency(true);
   // Set all cards back to clean.
@@ -651,6 +656,7 @@ void G1RemSet::prepare_for_verify() {
     if (SafepointSynchronize::is_at_safepoint()) {
       DirtyCardQueueSet& dcqs = JavaThread::dirty_card_queue_set();
       dcqs.concatenate_logs();
+      dcqs.reset_for_par_iteration();
     }
 
     G1HotCardCache* hot_card_cache = _cg1r->hot_card_cache();
@@ -659,6 +665,9 @@ void G1RemSet::prepare_for_verify() {
 
     DirtyCardQueue into_cset_dcq(&_g1->into_cset_dirty_card_queue_set());
     updateRS(&into_cset_dcq, 0);
+    if (SafepointSynchronize::is_at_safepoint()) {
+      JavaThread::dirty_card_queue_set().remove_processed_completed_buffers();
+    }
     _g1->into_cset_dirty_card_queue_set().clear();
 
     hot_card_cache->set_use_cache(use_hot_card_cache);
@@ -105,14 +105,14 @@ void G1StringDedup::deduplicate(oop java_string) {
 
 void G1StringDedup::oops_do(OopClosure* keep_alive) {
   assert(is_enabled(), "String deduplication not enabled");
-  unlink_or_oops_do(NULL, keep_alive, true /* allow_resize_and_rehash */);
+  unlink_or_oops_do(NULL, keep_alive, true /* allow_resize */);
 }
 
 void G1StringDedup::unlink(BoolObjectClosure* is_alive) {
   assert(is_enabled(), "String deduplication not enabled");
-  // Don't allow a potential resize or rehash during unlink, as the unlink
-  // operation itself might remove enough entries to invalidate such a decision.
-  unlink_or_oops_do(is_alive, NULL, false /* allow_resize_and_rehash */);
+  // Don't allow a potential resize during unlink, as the unlink operation
+  // itself might remove enough entries to invalidate such a decision.
+  unlink_or_oops_do(is_alive, NULL, false /* allow_resize */);
 }
 
 //
@@ -127,10 +127,11 @@ private:
 public:
   G1StringDedupUnlinkOrOopsDoTask(BoolObjectClosure* is_alive,
                                   OopClosure* keep_alive,
-                                  bool allow_resize_and_rehash,
+                                  bool allow_resize,
+                                  bool young_only,
                                   G1GCPhaseTimes* phase_times) :
     AbstractGangTask("G1StringDedupUnlinkOrOopsDoTask"),
-    _cl(is_alive, keep_alive, allow_resize_and_rehash), _phase_times(phase_times) { }
+    _cl(is_alive, keep_alive, allow_resize, young_only), _phase_times(phase_times) { }
 
   virtual void work(uint worker_id) {
     {
@@ -146,11 +147,12 @@ public:
 
 void G1StringDedup::unlink_or_oops_do(BoolObjectClosure* is_alive,
                                       OopClosure* keep_alive,
-                                      bool allow_resize_and_rehash,
-                                      G1GCPhaseTimes* phase_times) {
+                                      bool allow_resize,
+                                      G1GCPhaseTimes* phase_times,
+                                      bool young_only) {
   assert(is_enabled(), "String deduplication not enabled");
 
-  G1StringDedupUnlinkOrOopsDoTask task(is_alive, keep_alive, allow_resize_and_rehash, phase_times);
+  G1StringDedupUnlinkOrOopsDoTask task(is_alive, keep_alive, allow_resize, young_only, phase_times);
   if (G1CollectedHeap::use_parallel_gc_threads()) {
     G1CollectedHeap* g1h = G1CollectedHeap::heap();
     g1h->set_par_threads();
@@ -180,28 +182,24 @@ void G1StringDedup::verify() {
 
 G1StringDedupUnlinkOrOopsDoClosure::G1StringDedupUnlinkOrOopsDoClosure(BoolObjectClosure* is_alive,
                                                                        OopClosure* keep_alive,
-                                                                       bool allow_resize_and_rehash) :
+                                                                       bool allow_resize,
+                                                                       bool young_only) :
   _is_alive(is_alive),
   _keep_alive(keep_alive),
   _resized_table(NULL),
-  _rehashed_table(NULL),
+  _young_only(young_only),
   _next_queue(0),
   _next_bucket(0) {
-  if (allow_resize_and_rehash) {
-    // If both resize and rehash is needed, only do resize. Rehash of
-    // the table will eventually happen if the situation persists.
+  // Install a completely rehashed table, if any, before the scan.
+  // The rehash itself is done concurrently by the deduplication thread.
+  G1StringDedupTable::finish_rehash();
+  if (allow_resize) {
     _resized_table = G1StringDedupTable::prepare_resize();
-    if (!is_resizing()) {
-      _rehashed_table = G1StringDedupTable::prepare_rehash();
-    }
   }
 }
 
 G1StringDedupUnlinkOrOopsDoClosure::~G1StringDedupUnlinkOrOopsDoClosure() {
-  assert(!is_resizing() || !is_rehashing(), "Can not both resize and rehash");
   if (is_resizing()) {
     G1StringDedupTable::finish_resize(_resized_table);
-  } else if (is_rehashing()) {
-    G1StringDedupTable::finish_rehash(_rehashed_table);
   }
 }
@@ -131,7 +131,8 @@ public:
   static void oops_do(OopClosure* keep_alive);
   static void unlink(BoolObjectClosure* is_alive);
   static void unlink_or_oops_do(BoolObjectClosure* is_alive, OopClosure* keep_alive,
-                                bool allow_resize_and_rehash, G1GCPhaseTimes* phase_times = NULL);
+                                bool allow_resize, G1GCPhaseTimes* phase_times = NULL,
+                                bool young_only = false);
 
   static void threads_do(ThreadClosure* tc);
   static void print_worker_threads_on(outputStream* st);
@@ -151,14 +152,15 @@ private:
   BoolObjectClosure*  _is_alive;
   OopClosure*         _keep_alive;
   G1StringDedupTable* _resized_table;
-  G1StringDedupTable* _rehashed_table;
+  bool                _young_only;
   size_t              _next_queue;
   size_t              _next_bucket;
 
 public:
   G1StringDedupUnlinkOrOopsDoClosure(BoolObjectClosure* is_alive,
                                      OopClosure* keep_alive,
-                                     bool allow_resize_and_rehash);
+                                     bool allow_resize,
+                                     bool young_only);
   ~G1StringDedupUnlinkOrOopsDoClosure();
 
   bool is_resizing() {
@@ -169,8 +171,10 @@ public:
     return _resized_table;
   }
 
-  bool is_rehashing() {
-    return _rehashed_table != NULL;
+  // True if only young regions are being collected, in which case
+  // table partitions referring only to old regions can be skipped.
+  bool is_young_only() {
+    return _young_only;
   }
 
   // Atomically claims the next available queue for exclusive access by
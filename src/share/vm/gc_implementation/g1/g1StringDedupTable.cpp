@@ -200,6 +200,8 @@ void G1StringDedupEntryCache::delete_overflowed() {
 }
 
 G1StringDedupTable*      G1StringDedupTable::_table = NULL;
+G1StringDedupTable*      G1StringDedupTable::_rehashed_table = NULL;
+size_t                   G1StringDedupTable::_rehash_next_bucket = 0;
 G1StringDedupEntryCache* G1StringDedupTable::_entry_cache = NULL;
 
 const size_t             G1StringDedupTable::_min_size = (1 << 10);   // 1024
@@ -225,10 +227,14 @@ G1StringDedupTable::G1StringDedupTable(size_t size, jint hash_seed) :
   assert(is_power_of_2(size), "Table size must be a power of 2");
   _buckets = NEW_C_HEAP_ARRAY(G1StringDedupEntry*, _size, mtGC);
   memset(_buckets, 0, _size * sizeof(G1StringDedupEntry*));
+  size_t partitions = _size / 2 / partition_size();
+  _partition_is_old = NEW_C_HEAP_ARRAY(bool, partitions, mtGC);
+  memset(_partition_is_old, 0, partitions * sizeof(bool));
 }
 
 G1StringDedupTable::~G1StringDedupTable() {
   FREE_C_HEAP_ARRAY(G1StringDedupEntry*, _buckets, mtGC);
+  FREE_C_HEAP_ARRAY(bool, _partition_is_old, mtGC);
 }
 
 void G1StringDedupTable::create() {
@@ -244,6 +250,7 @@ void G1StringDedupTable::add(typeArrayOop value, unsigned int hash, G1StringDedu
   entry->set_next(*list);
   *list = entry;
   _entries++;
+  _partition_is_old[partition_index(list - _buckets)] = false;
 }
 
 void G1StringDedupTable::remove(G1StringDedupEntry** pentry, uint worker_id) {
@@ -260,6 +267,7 @@ void G1StringDedupTable::transfer(G1StringDedupEntry** pentry, G1StringDedupTabl
   G1StringDedupEntry** list = dest->bucket(index);
   entry->set_next(*list);
   *list = entry;
+  dest->_partition_is_old[dest->partition_index(index)] = false;
 }
 
 bool G1StringDedupTable::equals(typeArrayOop value1, typeArrayOop value2) {
@@ -311,15 +319,35 @@ typeArrayOop G1StringDedupTable::lookup_or_add_inner(typeArrayOop value, unsigne
   return existing_value;
 }
 
-unsigned int G1StringDedupTable::hash_code(typeArrayOop value) {
+typeArrayOop G1StringDedupTable::lookup_or_add_rehashing(typeArrayOop value, unsigned int hash) {
+  assert_lock_strong(StringDedupTable_lock);
+  assert(_rehashed_table != NULL, "No rehash in progress");
+
+  // The given hash was computed for the active table. Buckets below
+  // _rehash_next_bucket have already been transferred, so they are empty.
+  size_t index = _table->hash_to_index(hash);
+  if (index >= _rehash_next_bucket) {
+    uintx count = 0;
+    typeArrayOop existing_value = _table->lookup(value, hash, _table->bucket(index), count);
+    if (existing_value != NULL) {
+      return existing_value;
+    }
+  }
+
+  // Not in the active table, lookup or add using the new hash seed
+  unsigned int rehash = hash_code(value, _rehashed_table->_hash_seed);
+  return _rehashed_table->lookup_or_add_inner(value, rehash);
+}
+
+unsigned int G1StringDedupTable::hash_code(typeArrayOop value, jint hash_seed) {
   unsigned int hash;
   int length = value->length();
   const jchar* data = (jchar*)value->base(T_CHAR);
 
-  if (use_java_hash()) {
+  if (hash_seed == 0) {
     hash = java_lang_String::hash_code(data, length);
   } else {
-    hash = AltHashing::murmur3_32(_table->_hash_seed, data, length);
+    hash = AltHashing::murmur3_32(hash_seed, data, length);
   }
 
   return hash;
@@ -384,6 +412,11 @@ void G1StringDedupTable::deduplicate(oop java_string, G1StringDedupStat& stat) {
 }
 
 G1StringDedupTable* G1StringDedupTable::prepare_resize() {
+  if (_rehashed_table != NULL) {
+    // Don't resize while a rehash is in progress
+    return NULL;
+  }
+
   size_t size = _table->_size;
 
   // Check if the hashtable needs to be resized
@@ -448,61 +481,91 @@ void G1StringDedupTable::unlink_or_oops_do(G1StringDedupUnlinkOrOopsDoClosure* c
   // other partition is always the sibling partition in the second half of the table.
   // For example, if the table is divided into 8 partitions, the sibling of partition 0
   // is partition 4, the sibling of partition 1 is partition 5, etc.
+  //
+  // While a rehash is in progress the live entries are split between the active
+  // table and the rehashed table. Both have the same size and the table is never
+  // resized at the same time, so the same partitions are processed in both tables.
+  G1StringDedupTable* rehashed_table = _rehashed_table;
+  assert(rehashed_table == NULL ||
+         (!cl->is_resizing() && rehashed_table->_size == _table->_size),
+         "Invalid rehash state");
   size_t table_half = _table->_size / 2;
 
   // Let each partition be one page worth of buckets
-  size_t partition_size = MIN2(table_half, os::vm_page_size() / sizeof(G1StringDedupEntry*));
+  size_t partition_size = _table->partition_size();
   assert(table_half % partition_size == 0, "Invalid partition size");
 
   // Number of entries removed during the scan
   uintx removed = 0;
+  uintx removed_rehashed = 0;
 
   for (;;) {
     // Grab next partition to scan
     size_t partition_begin = cl->claim_table_partition(partition_size);
-    size_t partition_end = partition_begin + partition_size;
     if (partition_begin >= table_half) {
       // End of table
       break;
     }
 
     // Scan the partition followed by the sibling partition in the second half of the table
-    removed += unlink_or_oops_do(cl, partition_begin, partition_end, worker_id);
-    removed += unlink_or_oops_do(cl, table_half + partition_begin, table_half + partition_end, worker_id);
+    removed += _table->unlink_or_oops_do_partition(cl, partition_begin, worker_id);
+    if (rehashed_table != NULL) {
+      removed_rehashed += rehashed_table->unlink_or_oops_do_partition(cl, partition_begin, worker_id);
+    }
   }
 
   // Delayed update to avoid contention on the table lock
-  if (removed > 0) {
+  if (removed + removed_rehashed > 0) {
     MutexLockerEx ml(StringDedupTable_lock, Mutex::_no_safepoint_check_flag);
     _table->_entries -= removed;
-    _entries_removed += removed;
+    if (rehashed_table != NULL) {
+      rehashed_table->_entries -= removed_rehashed;
+    }
+    _entries_removed += removed + removed_rehashed;
   }
 }
 
-uintx G1StringDedupTable::unlink_or_oops_do(G1StringDedupUnlinkOrOopsDoClosure* cl,
-                                            size_t partition_begin,
-                                            size_t partition_end,
-                                            uint worker_id) {
+uintx G1StringDedupTable::unlink_or_oops_do_partition(G1StringDedupUnlinkOrOopsDoClosure* cl,
+                                                      size_t partition_begin,
+                                                      uint worker_id) {
+  size_t index = partition_index(partition_begin);
+  if (cl->is_young_only() && !cl->is_resizing() && _partition_is_old[index]) {
+    // Fast path, all entries were found to refer to old regions before
+    // and none have been added since. Young-only collections never move
+    // or free objects in old regions, so there is nothing to do.
+    return 0;
+  }
+
+  size_t table_half = _size / 2;
+  size_t partition_end = partition_begin + partition_size();
+  bool all_old = true;
+  uintx removed = unlink_or_oops_do_buckets(cl, partition_begin, partition_end, worker_id, all_old);
+  removed += unlink_or_oops_do_buckets(cl, table_half + partition_begin, table_half + partition_end, worker_id, all_old);
+  _partition_is_old[index] = all_old;
+  return removed;
+}
+
+uintx G1StringDedupTable::unlink_or_oops_do_buckets(G1StringDedupUnlinkOrOopsDoClosure* cl,
+                                                    size_t begin,
+                                                    size_t end,
+                                                    uint worker_id,
+                                                    bool& all_old) {
+  G1CollectedHeap* g1h = G1CollectedHeap::heap();
   uintx removed = 0;
-  for (size_t bucket = partition_begin; bucket < partition_end; bucket++) {
-    G1StringDedupEntry** entry = _table->bucket(bucket);
+  for (size_t bucket = begin; bucket < end; bucket++) {
+    G1StringDedupEntry** entry = this->bucket(bucket);
     while (*entry != NULL) {
       oop* p = (oop*)(*entry)->obj_addr();
       if (cl->is_alive(*p)) {
         cl->keep_alive(p);
         if (cl->is_resizing()) {
           // We are resizing the table, transfer entry to the new table
-          _table->transfer(entry, cl->resized_table());
+          transfer(entry, cl->resized_table());
         } else {
-          if (cl->is_rehashing()) {
-            // We are rehashing the table, rehash the entry but keep it
-            // in the table. We can't transfer entries into the new table
-            // at this point since we don't have exclusive access to all
-            // destination partitions. finish_rehash() will do a single
-            // threaded transfer of all entries.
-            typeArrayOop value = (typeArrayOop)*p;
-            unsigned int hash = hash_code(value);
-            (*entry)->set_hash(hash);
+          // Humongous regions are not old, eager reclaim relies on the
+          // keep_alive closure seeing their entries at every collection.
+          if (all_old && !g1h->heap_region_containing(*p)->is_old()) {
+            all_old = false;
           }
 
           // Move to next entry
@@ -510,7 +573,7 @@ uintx G1StringDedupTable::unlink_or_oops_do(G1StringDedupUnlinkOrOopsDoClosure*
         }
       } else {
         // Not alive, remove entry from table
-        _table->remove(entry, worker_id);
+        remove(entry, worker_id);
         removed++;
       }
     }
@@ -519,55 +582,89 @@ uintx G1StringDedupTable::unlink_or_oops_do(G1StringDedupUnlinkOrOopsDoClosure*
   return removed;
 }
 
-G1StringDedupTable* G1StringDedupTable::prepare_rehash() {
-  if (!_table->_rehash_needed && !StringDeduplicationRehashALot) {
-    // Rehash not needed
-    return NULL;
-  }
+bool G1StringDedupTable::rehash_partition() {
+  MutexLockerEx ml(StringDedupTable_lock, Mutex::_no_safepoint_check_flag);
 
-  // Update statistics
-  _rehash_count++;
+  if (_rehashed_table == NULL) {
+    if (!_table->_rehash_needed && !StringDeduplicationRehashALot) {
+      // Rehash not needed
+      return false;
+    }
 
-  // Compute new hash seed
-  _table->_hash_seed = AltHashing::compute_seed();
+    // Update statistics
+    _rehash_count++;
 
-  // Allocate the new table, same size and hash seed
-  return new G1StringDedupTable(_table->_size, _table->_hash_seed);
-}
+    // Allocate the new table, same size but new hash seed
+    _rehashed_table = new G1StringDedupTable(_table->_size, AltHashing::compute_seed());
+    _rehash_next_bucket = 0;
+  }
 
-void G1StringDedupTable::finish_rehash(G1StringDedupTable* rehashed_table) {
-  assert(rehashed_table != NULL, "Invalid table");
+  if (_rehash_next_bucket == _table->_size) {
+    // All entries transferred, waiting for finish_rehash()
+    return false;
+  }
 
-  // Move all newly rehashed entries into the correct buckets in the new table
-  for (size_t bucket = 0; bucket < _table->_size; bucket++) {
+  // Move the entries of the next partition into the correct buckets in the new table
+  size_t partition_end = _rehash_next_bucket + _table->partition_size();
+  uintx transferred = 0;
+  for (size_t bucket = _rehash_next_bucket; bucket < partition_end; bucket++) {
     G1StringDedupEntry** entry = _table->bucket(bucket);
     while (*entry != NULL) {
-      _table->transfer(entry, rehashed_table);
+      typeArrayOop value = (*entry)->obj();
+      (*entry)->set_hash(hash_code(value, _rehashed_table->_hash_seed));
+      _table->transfer(entry, _rehashed_table);
+      transferred++;
     }
   }
 
-  rehashed_table->_entries = _table->_entries;
+  _table->_entries -= transferred;
+  _rehashed_table->_entries += transferred;
+  _rehash_next_bucket = partition_end;
+  return _rehash_next_bucket < _table->_size;
+}
+
+void G1StringDedupTable::finish_rehash() {
+  assert(SafepointSynchronize::is_at_safepoint(), "Must be at safepoint");
+
+  if (_rehashed_table == NULL || _rehash_next_bucket < _table->_size) {
+    // No rehash in progress, or not all entries transferred yet
+    return;
+  }
+
+  assert(_table->_entries == 0, "All entries should have been transferred");
 
   // Free old table
   delete _table;
 
   // Install new table
-  _table = rehashed_table;
+  _table = _rehashed_table;
+  _rehashed_table = NULL;
+  _rehash_next_bucket = 0;
 }
 
 void G1StringDedupTable::verify() {
-  for (size_t bucket = 0; bucket < _table->_size; bucket++) {
+  verify(_table);
+  if (_rehashed_table != NULL) {
+    verify(_rehashed_table);
+  }
+}
+
+void G1StringDedupTable::verify(G1StringDedupTable* table) {
+  for (size_t bucket = 0; bucket < table->_size; bucket++) {
     // Verify entries
-    G1StringDedupEntry** entry = _table->bucket(bucket);
+    G1StringDedupEntry** entry = table->bucket(bucket);
     while (*entry != NULL) {
       typeArrayOop value = (*entry)->obj();
       guarantee(value != NULL, "Object must not be NULL");
       guarantee(Universe::heap()->is_in_reserved(value), "Object must be on the heap");
       guarantee(!value->is_forwarded(), "Object must not be forwarded");
       guarantee(value->is_typeArray(), "Object must be a typeArrayOop");
-      unsigned int hash = hash_code(value);
+      unsigned int hash = hash_code(value, table->_hash_seed);
       guarantee((*entry)->hash() == hash, "Table entry has inorrect hash");
-      guarantee(_table->hash_to_index(hash) == bucket, "Table entry has incorrect index");
+      guarantee(table->hash_to_index(hash) == bucket, "Table entry has incorrect index");
+      guarantee(!table->_partition_is_old[table->partition_index(bucket)] ||
+                G1CollectedHeap::heap()->heap_region_containing(value)->is_old(),
+                "Table entry in old partition must refer to old region");
       entry = (*entry)->next_addr();
     }
 
@@ -575,7 +672,7 @@ void G1StringDedupTable::verify() {
     // We only need to compare entries in the same bucket. If the same oop or an
     // identical array has been inserted more than once into different/incorrect
     // buckets the verification step above will catch that.
-    G1StringDedupEntry** entry1 = _table->bucket(bucket);
+    G1StringDedupEntry** entry1 = table->bucket(bucket);
     while (*entry1 != NULL) {
       typeArrayOop value1 = (*entry1)->obj();
       G1StringDedupEntry** entry2 = (*entry1)->next_addr();
@@ -594,6 +691,17 @@ void G1StringDedupTable::clean_entry_cache() {
 }
 
 void G1StringDedupTable::print_statistics(outputStream* st) {
+  // While a rehash is in progress, entries are split between both tables
+  // and new entries are hashed using the seed of the rehashed table.
+  uintx entries = _table->_entries;
+  jint hash_seed = _table->_hash_seed;
+  size_t buckets_size = _table->_size * sizeof(G1StringDedupEntry*);
+  if (_rehashed_table != NULL) {
+    entries += _rehashed_table->_entries;
+    hash_seed = _rehashed_table->_hash_seed;
+    buckets_size *= 2;
+  }
+
   st->print_cr(
     "   [Table]\n"
     "      [Memory Usage: " G1_STRDEDUP_BYTES_FORMAT_NS "]\n"
@@ -602,10 +710,10 @@ void G1StringDedupTable::print_statistics(outputStream* st) {
     "      [Resize Count: " UINTX_FORMAT ", Shrink Threshold: " UINTX_FORMAT "(" G1_STRDEDUP_PERCENT_FORMAT_NS "), Grow Threshold: " UINTX_FORMAT "(" G1_STRDEDUP_PERCENT_FORMAT_NS ")]\n"
     "      [Rehash Count: " UINTX_FORMAT ", Rehash Threshold: " UINTX_FORMAT ", Hash Seed: 0x%x]\n"
     "      [Age Threshold: " UINTX_FORMAT "]",
-    G1_STRDEDUP_BYTES_PARAM(_table->_size * sizeof(G1StringDedupEntry*) + (_table->_entries + _entry_cache->size()) * sizeof(G1StringDedupEntry)),
+    G1_STRDEDUP_BYTES_PARAM(buckets_size + (entries + _entry_cache->size()) * sizeof(G1StringDedupEntry)),
     _table->_size, _min_size, _max_size,
-    _table->_entries, (double)_table->_entries / (double)_table->_size * 100.0, _entry_cache->size(), _entries_added, _entries_removed,
+    entries, (double)entries / (double)_table->_size * 100.0, _entry_cache->size(), _entries_added, _entries_removed,
     _resize_count, _table->_shrink_threshold, _shrink_load_factor * 100.0, _table->_grow_threshold, _grow_load_factor * 100.0,
-    _rehash_count, _rehash_threshold, _table->_hash_seed,
+    _rehash_count, _rehash_threshold, hash_seed,
     StringDeduplicationAgeThreshold);
 }
@@ -92,7 +92,10 @@ public:
 // length goes above or below given thresholds the table grows or shrinks accordingly.
 //
 // The table is also dynamically rehashed (using a new hash seed) if it becomes severely
-// unbalanced, i.e., a hash chain is significantly longer than average.
+// unbalanced, i.e., a hash chain is significantly longer than average. Rehashing is done
+// incrementally by the deduplication thread, one partition at a time, into a new table
+// which is installed at the next safepoint once all entries have been transferred.
+// Until then both tables are live and GC workers process both.
 //
 // All access to the table is protected by the StringDedupTable_lock, except under
 // safepoints in which case GC workers are allowed to access a table partitions they
@@ -106,6 +109,12 @@ private:
   // the table is resizes or rehashed.
   static G1StringDedupTable*      _table;
 
+  // The table being rehashed into, or NULL if no rehash is in
+  // progress, and the first bucket of the active table that has not
+  // yet been transferred into it.
+  static G1StringDedupTable*      _rehashed_table;
+  static size_t                   _rehash_next_bucket;
+
   // Cache for reuse and fast alloc/free of table entries.
   static G1StringDedupEntryCache* _entry_cache;
 
@@ -116,6 +125,12 @@ private:
   uintx                           _grow_threshold;
   bool                            _rehash_needed;
 
+  // One flag per partition (and its sibling, see unlink_or_oops_do()),
+  // set if all entries pointed to old regions when the partition was
+  // last scanned and no entry has been added to it since. Young-only
+  // collections can skip such partitions.
+  bool*                           _partition_is_old;
+
   // The hash seed also dictates which hash function to use. A
   // zero hash seed means we will use the Java compatible hash
   // function (which doesn't use a seed), and a non-zero hash
@@ -150,6 +165,17 @@ private:
     return (size_t)hash & (_size - 1);
   }
 
+  // The table is divided into partitions of one page worth of buckets,
+  // see unlink_or_oops_do().
+  size_t partition_size() const {
+    return MIN2(_size / 2, os::vm_page_size() / sizeof(G1StringDedupEntry*));
+  }
+
+  // Returns the index of the partition pair the given bucket belongs to.
+  size_t partition_index(size_t index) const {
+    return (index & (_size / 2 - 1)) / partition_size();
+  }
+
   // Adds a new table entry to the given hash bucket.
   void add(typeArrayOop value, unsigned int hash, G1StringDedupEntry** list);
 
@@ -174,6 +200,9 @@ private:
     // acts as a fence for _table, which could have been replaced by a new
     // instance if the table was resized or rehashed.
     MutexLockerEx ml(StringDedupTable_lock, Mutex::_no_safepoint_check_flag);
+    if (_rehashed_table != NULL) {
+      return lookup_or_add_rehashing(value, hash);
+    }
     return _table->lookup_or_add_inner(value, hash);
   }
 
@@ -185,14 +214,34 @@ private:
 
   static bool equals(typeArrayOop value1, typeArrayOop value2);
 
+  // Lookup or add of table entry while a rehash is in progress.
+  static typeArrayOop lookup_or_add_rehashing(typeArrayOop value, unsigned int hash);
+
   // Computes the hash code for the given character array, using the
   // currently active hash function and hash seed.
-  static unsigned int hash_code(typeArrayOop value);
+  static unsigned int hash_code(typeArrayOop value) {
+    return hash_code(value, _table->_hash_seed);
+  }
+
+  // Computes the hash code for the given character array, using the
+  // hash function and hash seed given by hash_seed.
+  static unsigned int hash_code(typeArrayOop value, jint hash_seed);
+
+  // Scans the partition starting at partition_begin and its sibling
+  // partition in this table, unless the closure allows them to be skipped.
+  uintx unlink_or_oops_do_partition(G1StringDedupUnlinkOrOopsDoClosure* cl,
+                                    size_t partition_begin,
+                                    uint worker_id);
 
-  static uintx unlink_or_oops_do(G1StringDedupUnlinkOrOopsDoClosure* cl,
-                                 size_t partition_begin,
-                                 size_t partition_end,
-                                 uint worker_id);
+  // Scans the buckets in [begin, end). Clears all_old if a live entry
+  // refers to a region that is not old.
+  uintx unlink_or_oops_do_buckets(G1StringDedupUnlinkOrOopsDoClosure* cl,
+                                  size_t begin,
+                                  size_t end,
+                                  uint worker_id,
+                                  bool& all_old);
+
+  static void verify(G1StringDedupTable* table);
 
 public:
   static void create();
@@ -209,14 +258,17 @@ public:
   // and deletes the previously active table.
   static void finish_resize(G1StringDedupTable* resized_table);
 
-  // If a table rehash is needed, returns a newly allocated empty
-  // hashtable and updates the hash seed.
-  static G1StringDedupTable* prepare_rehash();
-
-  // Transfers rehashed entries from the currently active table into
-  // the new table. Installs the new table as the currently active table
-  // and deletes the previously active table.
-  static void finish_rehash(G1StringDedupTable* rehashed_table);
+  // If a table rehash is needed or in progress, transfers the next
+  // partition of the currently active table into the rehashed table,
+  // using a new hash seed. Called by the deduplication thread, which
+  // may yield to safepoints between calls. Returns true if more
+  // partitions remain to be transferred.
+  static bool rehash_partition();
+
+  // If all entries have been transferred into the rehashed table,
+  // installs it as the currently active table and deletes the
+  // previously active one. Must be called at a safepoint.
+  static void finish_rehash();
 
   // If the table entry cache has grown too large, delete overflowed entries.
   static void clean_entry_cache();
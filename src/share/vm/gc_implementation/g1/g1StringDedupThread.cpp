@@ -100,6 +100,15 @@ void G1StringDedupThread::run() {
         }
       }
 
+      // Rehash the table, if needed, one partition at a time
+      while (G1StringDedupTable::rehash_partition()) {
+        if (sts.should_yield()) {
+          stat.mark_block();
+          sts.yield();
+          stat.mark_unblock();
+        }
+      }
+
       stat.mark_done();
 
       // Print statistics
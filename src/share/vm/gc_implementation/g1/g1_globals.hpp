@@ -215,7 +215,9 @@
           "so as to allow debugging")                                       \
                                                                             \
   product(uintx, G1HeapRegionSize, 0,                                       \
-          "Size of the G1 regions.")                                        \
+          "Size of the G1 regions, rounded down to a power of 2 between 1M "\
+          "and 512M. If not set, a size of at most 32M is chosen based on " \
+          "the heap size.")                                                 \
                                                                             \
   product(uintx, G1ConcRefinementThreads, 0,                                \
           "If non-0 is the number of parallel rem set update threads, "     \
@@ -274,6 +276,16 @@
   product(uintx, G1MixedGCCountTarget, 8,                                   \
           "The target number of mixed GCs after a marking cycle.")          \
                                                                             \
+  product(bool, G1UseAdaptiveIHOP, false,                                   \
+          "Adaptively determine the heap occupancy at which a marking "     \
+          "cycle is started from the predicted old generation allocation "  \
+          "rate and marking duration. InitiatingHeapOccupancyPercent is "   \
+          "used until enough samples are available.")                       \
+                                                                            \
+  product(uintx, G1AdaptiveIHOPNumInitialSamples, 3,                        \
+          "The number of completed marking cycles and young-only pauses "   \
+          "needed before G1UseAdaptiveIHOP takes effect.")                  \
+                                                                            \
   experimental(bool, G1EagerReclaimHumongousObjects, true,                  \
           "Try to reclaim dead large objects at every young GC.")           \
                                                                             \
@@ -281,6 +293,13 @@
           "Try to reclaim dead large objects that have a few stale "        \
           "references at every young GC.")                                  \
                                                                             \
+  experimental(bool, G1EagerReclaimHumongousObjArrays, true,                \
+          "Try to reclaim dead large object arrays at every young GC.")     \
+                                                                            \
+  experimental(bool, G1PinRegionsForJNICritical, false,                     \
+          "Pin the region of an object used in a JNI critical section "     \
+          "instead of holding off evacuation pauses with the GC locker")    \
+                                                                            \
   experimental(bool, G1TraceEagerReclaimHumongousObjects, false,            \
           "Print some information about large object liveness "             \
           "at every young GC.")                                             \
@@ -289,6 +308,39 @@
           "An upper bound for the number of old CSet regions expressed "    \
           "as a percentage of the heap size.")                              \
                                                                             \
+  product(uintx, G1PeriodicUncommitInterval, 0,                             \
+          "Number of milliseconds between attempts to uncommit regions "    \
+          "that have been free for at least G1UncommitDelay "               \
+          "milliseconds, while concurrent marking is idle. "                \
+          "0 disables uncommitting outside of full GCs.")                   \
+                                                                            \
+  product(uintx, G1UncommitDelay, 60000,                                    \
+          "Minimum number of milliseconds a region has to stay free "       \
+          "before it may be uncommitted by G1PeriodicUncommitInterval.")    \
+                                                                            \
+  product(uintx, G1PeriodicGCInterval, 0,                                   \
+          "Number of milliseconds without any GC after which G1 starts "    \
+          "a periodic collection to give memory back from an idle heap. "   \
+          "0 disables periodic collections.")                               \
+                                                                            \
+  product(bool, G1PeriodicGCInvokesConcurrent, true,                        \
+          "Start a concurrent cycle as the periodic collection, instead "   \
+          "of a full GC.")                                                  \
+                                                                            \
+  product(double, G1PeriodicGCSystemLoadThreshold, 0.0,                     \
+          "Do not start a periodic collection while the one minute "        \
+          "system load average is above this value. 0 disables the "        \
+          "check.")                                                         \
+                                                                            \
+  experimental(bool, G1ParallelFullGCAdjustPointers, true,                  \
+          "Use the parallel GC worker threads to adjust the pointers in "   \
+          "the heap regions during a full GC.")                             \
+                                                                            \
+  experimental(bool, G1RebuildRemSetsForCandidatesOnly, false,              \
+          "Drop the remembered sets of old regions that are not "           \
+          "collection set candidates after marking, and rebuild them "      \
+          "during the next marking cycle.")                                 \
+                                                                            \
   experimental(ccstr, G1LogLevel, NULL,                                     \
           "Log level for G1 logging: fine, finer, finest")                  \
                                                                             \
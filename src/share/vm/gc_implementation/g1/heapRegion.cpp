@@ -36,6 +36,7 @@
 #include "memory/iterator.hpp"
 #include "memory/space.inline.hpp"
 #include "oops/oop.inline.hpp"
+#include "runtime/atomic.inline.hpp"
 #include "runtime/orderAccess.inline.hpp"
 
 PRAGMA_FORMAT_MUTE_WARNINGS_FOR_GCC
@@ -110,6 +111,7 @@ void HeapRegion::setup_heap_region_size(size_t initial_heap_size, size_t max_hea
     size_t average_heap_size = (initial_heap_size + max_heap_size) / 2;
     region_size = MAX2(average_heap_size / HeapRegionBounds::target_number(),
                        (uintx) HeapRegionBounds::min_size());
+    region_size = MIN2(region_size, (uintx) HeapRegionBounds::max_ergonomics_size());
   }
 
   int region_size_log = log2_long((jlong) region_size);
@@ -136,8 +138,6 @@ void HeapRegion::setup_heap_region_size(size_t initial_heap_size, size_t max_hea
   LogOfHRGrainWords = LogOfHRGrainBytes - LogHeapWordSize;
 
   guarantee(GrainBytes == 0, "we should only set it once");
-  // The cast to int is safe, given that we've bounded region_size by
-  // MIN_REGION_SIZE and MAX_REGION_SIZE.
   GrainBytes = (size_t)region_size;
 
   guarantee(GrainWords == 0, "we should only set it once");
@@ -146,6 +146,9 @@ void HeapRegion::setup_heap_region_size(size_t initial_heap_size, size_t max_hea
 
   guarantee(CardsPerRegion == 0, "we should only set it once");
   CardsPerRegion = GrainBytes >> CardTableModRefBS::card_shift;
+  // Card indices within a region are stored as CardIdx_t in the
+  // remembered sets.
+  guarantee(CardsPerRegion <= (size_t) max_jint, "CardIdx_t too small");
 }
 
 void HeapRegion::reset_after_compaction() {
@@ -156,6 +159,11 @@ void HeapRegion::reset_after_compaction() {
   init_top_at_mark_start();
 }
 
+void HeapRegion::set_free() {
+  _type.set_free();
+  _free_since_ms = os::javaTimeMillis();
+}
+
 void HeapRegion::hr_clear(bool par, bool clear_space, bool locked) {
   assert(_humongous_start_region == NULL,
          "we should have already filtered out humongous regions");
@@ -163,6 +171,7 @@ void HeapRegion::hr_clear(bool par, bool clear_space, bool locked) {
          "we should have already filtered out humongous regions");
 
   _in_collection_set = false;
+  assert(!is_pinned(), "a pinned region holds live objects");
 
   set_allocation_context(AllocationContext::system());
   set_young_index_in_cset(-1);
@@ -225,6 +234,15 @@ void HeapRegion::set_startsHumongous(HeapWord* new_top, HeapWord* new_end) {
   _offsets.set_for_starts_humongous(new_top);
 }
 
+void HeapRegion::increment_pinned_object_count() {
+  Atomic::inc(&_pinned_object_count);
+}
+
+void HeapRegion::decrement_pinned_object_count() {
+  assert(_pinned_object_count > 0, "unbalanced unpin");
+  Atomic::dec(&_pinned_object_count);
+}
+
 void HeapRegion::set_continuesHumongous(HeapRegion* first_hr) {
   assert(!isHumongous(), "sanity / pre-condition");
   assert(end() == _orig_end,
@@ -284,7 +302,8 @@ HeapRegion::HeapRegion(uint hrm_index,
 #endif // ASSERT
      _young_index_in_cset(-1), _surv_rate_group(NULL), _age_index(-1),
     _rem_set(NULL), _recorded_rs_length(0), _predicted_elapsed_time_ms(0),
-    _predicted_bytes_to_copy(0)
+    _predicted_bytes_to_copy(0), _free_since_ms(0), _node_index(0),
+    _pinned_object_count(0)
 {
   _rem_set = new HeapRegionRemSet(sharedOffsetArray, this);
   assert(HeapRegionRemSet::num_par_rem_sets() > 0, "Invariant.");
@@ -770,6 +789,7 @@ public:
         const jbyte dirty = CardTableModRefBS::dirty_card_val();
 
         bool is_bad = !(from->is_young()
+                        || !to->rem_set()->is_complete()
                         || to->rem_set()->contains_reference(p)
                         || !G1HRRSFlushLogBuffersOnVerify && // buffers were not flushed
                             (_containing_obj->is_objArray() ?
@@ -298,6 +298,20 @@ class HeapRegion: public G1OffsetTableContigSpace {
   // the total value for the collection set.
   size_t _predicted_bytes_to_copy;
 
+  // The time (in ms, see os::javaTimeMillis()) at which this region
+  // was last freed. Used to find regions that have stayed free long
+  // enough to be uncommitted.
+  jlong _free_since_ms;
+
+  // The index of the NUMA node the memory of this region is bound to,
+  // see HeapRegionManager. Zero if the heap is not NUMA-aware.
+  uint _node_index;
+
+  // The number of objects in this region currently pinned by JNI critical
+  // sections, see G1PinRegionsForJNICritical. Objects in a pinned region
+  // are never moved: evacuating them always fails and they stay in place.
+  volatile jint _pinned_object_count;
+
  public:
   HeapRegion(uint hrm_index,
              G1BlockOffsetSharedArray* sharedOffsetArray,
@@ -341,7 +355,9 @@ class HeapRegion: public G1OffsetTableContigSpace {
     ParEvacFailureClaimValue   = 6,
     AggregateCountClaimValue   = 7,
     VerifyCountClaimValue      = 8,
-    ParMarkRootClaimValue      = 9
+    ParMarkRootClaimValue      = 9,
+    ParAdjustPointersClaimValue = 10,
+    ParObjectIterateClaimValue = 11
   };
 
   // All allocated blocks are occupied by objects in a HeapRegion
@@ -667,7 +683,16 @@ class HeapRegion: public G1OffsetTableContigSpace {
     }
   }
 
-  void set_free() { _type.set_free(); }
+  void set_free();
+  jlong free_since_ms() const { return _free_since_ms; }
+
+  uint node_index() const { return _node_index; }
+  void set_node_index(uint node_index) { _node_index = node_index; }
+
+  bool is_pinned() const { return _pinned_object_count > 0; }
+  jint pinned_object_count() const { return _pinned_object_count; }
+  void increment_pinned_object_count();
+  void decrement_pinned_object_count();
 
   void set_eden()        { _type.set_eden();        }
   void set_eden_pre_gc() { _type.set_eden_pre_gc(); }
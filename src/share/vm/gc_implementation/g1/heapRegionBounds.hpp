@@ -36,8 +36,13 @@ private:
   // reason for having an upper bound. We don't want regions to get too
   // large, otherwise cleanup's effectiveness would decrease as there
   // will be fewer opportunities to find totally empty regions after
-  // marking.
-  static const size_t MAX_REGION_SIZE = 32 * 1024 * 1024;
+  // marking. Very large heaps may still want regions this big to keep
+  // the region count, and with it remembered set and region iteration
+  // overhead, down; they have to ask for them with G1HeapRegionSize.
+  static const size_t MAX_REGION_SIZE = 512 * 1024 * 1024;
+
+  // Maximum region size picked by the automatic region size calculation.
+  static const size_t MAX_ERGONOMICS_SIZE = 32 * 1024 * 1024;
 
   // The automatic region size calculation will try to have around this
   // many regions in the heap (based on the min heap size).
@@ -46,6 +51,7 @@ private:
 public:
   static inline size_t min_size();
   static inline size_t max_size();
+  static inline size_t max_ergonomics_size();
   static inline size_t target_number();
 };
 
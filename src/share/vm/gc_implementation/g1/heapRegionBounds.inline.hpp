@@ -32,6 +32,10 @@ size_t HeapRegionBounds::max_size() {
   return MAX_REGION_SIZE;
 }
 
+size_t HeapRegionBounds::max_ergonomics_size() {
+  return MAX_ERGONOMICS_SIZE;
+}
+
 size_t HeapRegionBounds::target_number() {
   return TARGET_REGION_NUMBER;
 }
@@ -53,6 +53,50 @@ void HeapRegionManager::initialize(G1RegionToSpaceMapper* heap_storage,
 
   _available_map.resize(_regions.length(), false);
   _available_map.clear();
+
+  initialize_numa();
+}
+
+void HeapRegionManager::initialize_numa() {
+  if (!UseNUMA) {
+    return;
+  }
+  // Binding only works at page granularity.
+  size_t page_size = UseLargePages ? os::large_page_size() : os::vm_page_size();
+  if (HeapRegion::GrainBytes % page_size != 0) {
+    return;
+  }
+  size_t num_groups = os::numa_get_groups_num();
+  if (num_groups <= 1) {
+    return;
+  }
+  _numa_node_ids = NEW_C_HEAP_ARRAY(int, num_groups, mtGC);
+  _num_numa_nodes = (uint) os::numa_get_leaf_groups(_numa_node_ids, num_groups);
+  if (_num_numa_nodes <= 1) {
+    FREE_C_HEAP_ARRAY(int, _numa_node_ids, mtGC);
+    _numa_node_ids = NULL;
+    _num_numa_nodes = 1;
+  }
+}
+
+uint HeapRegionManager::numa_node_index_of_current_thread() const {
+  int lgrp_id = os::numa_get_group_id();
+  for (uint i = 0; i < _num_numa_nodes; i++) {
+    if (_numa_node_ids[i] == lgrp_id) {
+      return i;
+    }
+  }
+  return _num_numa_nodes;
+}
+
+HeapRegion* HeapRegionManager::allocate_free_region_on_current_node() {
+  uint node_index = numa_node_index_of_current_thread();
+  if (node_index == _num_numa_nodes) {
+    return NULL;
+  }
+  // Regions are spread round-robin over the nodes, so a short search
+  // from the head of the (ordered) free list usually finds one.
+  return _free_list.remove_region_with_node_index(node_index, 4 * _num_numa_nodes);
 }
 
 bool HeapRegionManager::is_available(uint region) const {
@@ -140,6 +184,12 @@ void HeapRegionManager::make_regions_available(uint start, uint num_regions) {
     HeapWord* bottom = G1CollectedHeap::heap()->bottom_addr_for_region(i);
     MemRegion mr(bottom, bottom + HeapRegion::GrainWords);
 
+    if (is_numa_aware()) {
+      // Bind before anything touches the memory of the region.
+      uint node_index = numa_node_index_for_region(i);
+      os::numa_make_local((char*) bottom, HeapRegion::GrainBytes, _numa_node_ids[node_index]);
+      hr->set_node_index(node_index);
+    }
     hr->initialize(mr);
     insert_into_free_list(at(i));
   }
@@ -383,6 +433,47 @@ uint HeapRegionManager::shrink_by(uint num_regions_to_remove) {
   return removed;
 }
 
+uint HeapRegionManager::uncommit_idle_regions(uint max_regions, jlong free_before_ms) {
+  assert_heap_locked_and_not_at_safepoint();
+
+  uint removed = 0;
+  uint cur = _allocated_heapregions_length;
+  while (cur > 0 && removed < max_regions) {
+    // Find the next run of idle regions below cur, walking down.
+    uint end = cur;
+    while (end > 0 && !is_idle_free_region(end - 1, free_before_ms)) {
+      end--;
+    }
+    uint start = end;
+    while (start > 0 && (end - start) < (max_regions - removed) &&
+           is_idle_free_region(start - 1, free_before_ms)) {
+      start--;
+    }
+    uint num = end - start;
+    if (num == 0) {
+      break;
+    }
+    // The master free list is kept sorted by region index, so the
+    // regions of the run are adjacent in the list too.
+    _free_list.remove_starting_at(at(start), num);
+    uncommit_regions(start, num);
+    removed += num;
+    cur = start;
+  }
+
+  verify_optional();
+
+  return removed;
+}
+
+bool HeapRegionManager::is_idle_free_region(uint index, jlong free_before_ms) const {
+  if (!is_available(index)) {
+    return false;
+  }
+  HeapRegion* hr = at(index);
+  return hr->is_free() && hr->free_since_ms() <= free_before_ms;
+}
+
 uint HeapRegionManager::find_empty_from_idx_reverse(uint start_idx, uint* res_idx) const {
   guarantee(start_idx < _allocated_heapregions_length, "checking");
   guarantee(res_idx != NULL, "checking");
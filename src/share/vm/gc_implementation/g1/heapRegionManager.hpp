@@ -89,6 +89,21 @@ class HeapRegionManager: public CHeapObj<mtGC> {
   // Internal only. The highest heap region +1 we allocated a HeapRegion instance for.
   uint _allocated_heapregions_length;
 
+  // With UseNUMA, the memory of each region is bound to one of the leaf
+  // locality groups in _numa_node_ids, round-robin by region index, and
+  // young regions are preferably handed out from the node of the
+  // allocating thread. _num_numa_nodes is 1 if the heap is not NUMA-aware.
+  int* _numa_node_ids;
+  uint _num_numa_nodes;
+
+  void initialize_numa();
+  bool is_numa_aware() const { return _num_numa_nodes > 1; }
+  uint numa_node_index_for_region(uint index) const { return index % _num_numa_nodes; }
+  // Returns the node index of the locality group the current thread
+  // runs on, or _num_numa_nodes if it is unknown.
+  uint numa_node_index_of_current_thread() const;
+  HeapRegion* allocate_free_region_on_current_node();
+
    HeapWord* heap_bottom() const { return _regions.bottom_address_mapped(); }
    HeapWord* heap_end() const {return _regions.end_address_mapped(); }
 
@@ -117,6 +132,9 @@ class HeapRegionManager: public CHeapObj<mtGC> {
   // the heap. Returns the length of the sequence found. If this value is zero, no
   // sequence could be found, otherwise res_idx contains the start index of this range.
   uint find_empty_from_idx_reverse(uint start_idx, uint* res_idx) const;
+  // Returns whether the region at index is committed, on the free list and
+  // has been free since before free_before_ms.
+  bool is_idle_free_region(uint index, jlong free_before_ms) const;
   // Allocate a new HeapRegion for the given index.
   HeapRegion* new_heap_region(uint hrm_index);
 #ifdef ASSERT
@@ -131,6 +149,7 @@ public:
   HeapRegionManager() : _regions(), _heap_mapper(NULL), _num_committed(0),
                     _next_bitmap_mapper(NULL), _prev_bitmap_mapper(NULL), _bot_mapper(NULL),
                     _allocated_heapregions_length(0), _available_map(),
+                    _numa_node_ids(NULL), _num_numa_nodes(1),
                     _free_list("Free list", new MasterFreeRegionListMtSafeChecker())
   { }
 
@@ -164,7 +183,13 @@ public:
   }
 
   HeapRegion* allocate_free_region(bool is_old) {
-    HeapRegion* hr = _free_list.remove_region(is_old);
+    HeapRegion* hr = NULL;
+    if (!is_old && is_numa_aware()) {
+      hr = allocate_free_region_on_current_node();
+    }
+    if (hr == NULL) {
+      hr = _free_list.remove_region(is_old);
+    }
 
     if (hr != NULL) {
       assert(hr->next() == NULL, "Single region should not have next");
@@ -232,6 +257,12 @@ public:
   // Return the actual number of uncommitted regions.
   uint shrink_by(uint num_regions_to_remove);
 
+  // Uncommit up to max_regions regions from the master free list that
+  // have been free since before free_before_ms, starting from the top of
+  // the heap. Must be called with the Heap_lock held outside a safepoint.
+  // Return the actual number of uncommitted regions.
+  uint uncommit_idle_regions(uint max_regions, jlong free_before_ms);
+
   void verify();
 
   // Do some sanity checking.
@@ -38,13 +38,193 @@
 
 PRAGMA_FORMAT_MUTE_WARNINGS_FOR_GCC
 
+// A bitmap with one bit per card of a heap region whose backing storage is
+// allocated lazily in fixed-size chunks of cards. The memory used by a
+// fine-grain table then grows with the number of parts of the region that
+// actually contain references into the owning region, instead of with the
+// region size.
+//
+// Chunks may be installed concurrently, so they are published with a CAS.
+// Since readers and writers may access a table while it is concurrently
+// reused (see the comment above OtherRegionsTable), chunks are only cleared,
+// never freed, while the table is in use. Chunk memory of tables on the
+// global free list is released at safepoints.
+class ChunkedCardBitMap VALUE_OBJ_CLASS_SPEC {
+  typedef BitMap::bm_word_t bm_word_t;
+
+  // These are static after init.
+  static size_t _chunk_cards;
+  static size_t _log_chunk_cards;
+  static size_t _num_chunks;
+
+  bm_word_t* volatile* _chunks;
+
+  static size_t chunk_index(size_t card) { return card >> _log_chunk_cards; }
+  static size_t card_in_chunk(size_t card) { return card & (_chunk_cards - 1); }
+  static size_t chunk_size_in_words() { return _chunk_cards / BitsPerWord; }
+
+  bm_word_t* chunk_at(size_t i) const {
+    return (bm_word_t*) OrderAccess::load_ptr_acquire((volatile void*) &_chunks[i]);
+  }
+
+  // Return the chunk at index i, installing a new, cleared one if necessary.
+  bm_word_t* chunk_at_create(size_t i) {
+    bm_word_t* chunk = chunk_at(i);
+    if (chunk != NULL) {
+      return chunk;
+    }
+    bm_word_t* new_chunk = NEW_C_HEAP_ARRAY(bm_word_t, chunk_size_in_words(), mtGC);
+    memset(new_chunk, 0, chunk_size_in_words() * sizeof(bm_word_t));
+    bm_word_t* res = (bm_word_t*) Atomic::cmpxchg_ptr(new_chunk, &_chunks[i], NULL);
+    if (res != NULL) {
+      // Somebody else installed a chunk first.
+      FREE_C_HEAP_ARRAY(bm_word_t, new_chunk, mtGC);
+      return res;
+    }
+    return new_chunk;
+  }
+
+public:
+  static void initialize() {
+    if (_num_chunks != 0) {
+      return;
+    }
+    // Use at most 16 chunks per region, but keep chunks at least 64 bytes.
+    size_t min_chunk_cards = 64 * BitsPerByte;
+    _chunk_cards = MAX2(HeapRegion::CardsPerRegion / 16, min_chunk_cards);
+    _chunk_cards = MIN2(_chunk_cards, HeapRegion::CardsPerRegion);
+    assert(is_power_of_2(_chunk_cards), "must be");
+    _log_chunk_cards = log2_intptr(_chunk_cards);
+    _num_chunks = HeapRegion::CardsPerRegion / _chunk_cards;
+  }
+
+  ChunkedCardBitMap() {
+    initialize();
+    _chunks = NEW_C_HEAP_ARRAY(bm_word_t*, _num_chunks, mtGC);
+    for (size_t i = 0; i < _num_chunks; i++) {
+      _chunks[i] = NULL;
+    }
+  }
+
+  ~ChunkedCardBitMap() {
+    release_chunks();
+    FREE_C_HEAP_ARRAY(bm_word_t*, _chunks, mtGC);
+  }
+
+  bool at(size_t card) const {
+    bm_word_t* chunk = chunk_at(chunk_index(card));
+    if (chunk == NULL) {
+      return false;
+    }
+    return BitMap(chunk, _chunk_cards).at(card_in_chunk(card));
+  }
+
+  // Set the bit for the given card. Returns true if this call changed the bit.
+  bool par_set_bit(size_t card) {
+    BitMap chunk(chunk_at_create(chunk_index(card)), _chunk_cards);
+    return chunk.par_at_put(card_in_chunk(card), 1);
+  }
+
+  void set_bit(size_t card) {
+    BitMap chunk(chunk_at_create(chunk_index(card)), _chunk_cards);
+    chunk.at_put(card_in_chunk(card), 1);
+  }
+
+  // Clear all bits, keeping the chunks allocated.
+  void clear() {
+    for (size_t i = 0; i < _num_chunks; i++) {
+      bm_word_t* chunk = chunk_at(i);
+      if (chunk != NULL) {
+        memset(chunk, 0, chunk_size_in_words() * sizeof(bm_word_t));
+      }
+    }
+  }
+
+  // Free all chunks. Requires that nobody else accesses this bitmap.
+  void release_chunks() {
+    for (size_t i = 0; i < _num_chunks; i++) {
+      bm_word_t* chunk = chunk_at(i);
+      if (chunk != NULL) {
+        _chunks[i] = NULL;
+        FREE_C_HEAP_ARRAY(bm_word_t, chunk, mtGC);
+      }
+    }
+  }
+
+  size_t count_one_bits() const {
+    size_t sum = 0;
+    for (size_t i = 0; i < _num_chunks; i++) {
+      bm_word_t* chunk = chunk_at(i);
+      if (chunk != NULL) {
+        sum += BitMap(chunk, _chunk_cards).count_one_bits();
+      }
+    }
+    return sum;
+  }
+
+  // Returns the index of the first set bit at or after card, or
+  // HeapRegion::CardsPerRegion if there is none.
+  size_t get_next_one_offset(size_t card) const {
+    for (size_t i = chunk_index(card); i < _num_chunks; i++) {
+      bm_word_t* chunk = chunk_at(i);
+      size_t start = (i == chunk_index(card)) ? card_in_chunk(card) : 0;
+      if (chunk != NULL) {
+        size_t res = BitMap(chunk, _chunk_cards).get_next_one_offset(start);
+        if (res < _chunk_cards) {
+          return (i << _log_chunk_cards) + res;
+        }
+      }
+    }
+    return HeapRegion::CardsPerRegion;
+  }
+
+  // Intersect with the part of "other" starting at bit "offset".
+  void set_intersection_at_offset(BitMap* other, size_t offset) {
+    for (size_t i = 0; i < _num_chunks; i++) {
+      bm_word_t* chunk = chunk_at(i);
+      if (chunk != NULL) {
+        BitMap(chunk, _chunk_cards).set_intersection_at_offset(*other, offset + (i << _log_chunk_cards));
+      }
+    }
+  }
+
+  // (Destructively) union this bitmap into "bm", which must be of size
+  // HeapRegion::CardsPerRegion.
+  void union_into(BitMap* bm) const {
+    for (size_t i = 0; i < _num_chunks; i++) {
+      bm_word_t* chunk = chunk_at(i);
+      if (chunk != NULL) {
+        BitMap src(chunk, _chunk_cards);
+        for (size_t j = src.get_next_one_offset(0); j < _chunk_cards; j = src.get_next_one_offset(j + 1)) {
+          bm->set_bit((i << _log_chunk_cards) + j);
+        }
+      }
+    }
+  }
+
+  // Mem size in bytes.
+  size_t mem_size() const {
+    size_t sum = _num_chunks * sizeof(bm_word_t*);
+    for (size_t i = 0; i < _num_chunks; i++) {
+      if (chunk_at(i) != NULL) {
+        sum += chunk_size_in_words() * sizeof(bm_word_t);
+      }
+    }
+    return sum;
+  }
+};
+
+size_t ChunkedCardBitMap::_chunk_cards = 0;
+size_t ChunkedCardBitMap::_log_chunk_cards = 0;
+size_t ChunkedCardBitMap::_num_chunks = 0;
+
 class PerRegionTable: public CHeapObj<mtGC> {
   friend class OtherRegionsTable;
   friend class HeapRegionRemSetIterator;
 
-  HeapRegion*     _hr;
-  BitMap          _bm;
-  jint            _occupied;
+  HeapRegion*       _hr;
+  ChunkedCardBitMap _bm;
+  jint              _occupied;
 
   // next pointer for free/allocated 'all' list
   PerRegionTable* _next;
@@ -59,28 +239,25 @@ class PerRegionTable: public CHeapObj<mtGC> {
   static PerRegionTable* _free_list;
 
 protected:
-  // We need access in order to union things into the base table.
-  BitMap* bm() { return &_bm; }
-
   void recount_occupied() {
-    _occupied = (jint) bm()->count_one_bits();
+    _occupied = (jint) _bm.count_one_bits();
   }
 
   PerRegionTable(HeapRegion* hr) :
     _hr(hr),
     _occupied(0),
-    _bm(HeapRegion::CardsPerRegion, false /* in-resource-area */),
+    _bm(),
     _collision_list_next(NULL), _next(NULL), _prev(NULL)
   {}
 
   void add_card_work(CardIdx_t from_card, bool par) {
     if (!_bm.at(from_card)) {
       if (par) {
-        if (_bm.par_at_put(from_card, 1)) {
+        if (_bm.par_set_bit(from_card)) {
           Atomic::inc(&_occupied);
         }
       } else {
-        _bm.at_put(from_card, 1);
+        _bm.set_bit(from_card);
         _occupied++;
       }
     }
@@ -153,7 +330,7 @@ public:
   void scrub(CardTableModRefBS* ctbs, BitMap* card_bm) {
     HeapWord* hr_bot = hr()->bottom();
     size_t hr_first_card_index = ctbs->index_for(hr_bot);
-    bm()->set_intersection_at_offset(*card_bm, hr_first_card_index);
+    _bm.set_intersection_at_offset(card_bm, hr_first_card_index);
     recount_occupied();
   }
 
@@ -168,12 +345,12 @@ public:
   // (Destructively) union the bitmap of the current table into the given
   // bitmap (which is assumed to be of the same size.)
   void union_bitmap_into(BitMap* bm) {
-    bm->set_union(_bm);
+    _bm.union_into(bm);
   }
 
   // Mem size in bytes.
   size_t mem_size() const {
-    return sizeof(PerRegionTable) + _bm.size_in_words() * HeapWordSize;
+    return sizeof(PerRegionTable) + _bm.mem_size();
   }
 
   // Requires "from" to be in "hr()".
@@ -256,6 +433,17 @@ public:
     return res;
   }
 
+  // Give back the bitmap chunks of all PRTs on the free list. Must be
+  // called at a safepoint while no other thread allocates PRTs.
+  static void release_fl_chunks() {
+    assert_at_safepoint(true /* should_be_vm_thread */);
+    PerRegionTable* cur = _free_list;
+    while (cur != NULL) {
+      cur->_bm.release_chunks();
+      cur = cur->next();
+    }
+  }
+
   static void test_fl_mem_size();
 };
 
@@ -754,11 +942,11 @@ size_t OtherRegionsTable::occ_sparse() const {
 
 size_t OtherRegionsTable::mem_size() const {
   size_t sum = 0;
-  // all PRTs are of the same size so it is sufficient to query only one of them.
-  if (_first_all_fine_prts != NULL) {
-    assert(_last_all_fine_prts != NULL &&
-      _first_all_fine_prts->mem_size() == _last_all_fine_prts->mem_size(), "check that mem_size() is constant");
-    sum += _first_all_fine_prts->mem_size() * _n_fine_entries;
+  // PRTs allocate their bitmaps lazily, so we need to ask each of them.
+  PerRegionTable* cur = _first_all_fine_prts;
+  while (cur != NULL) {
+    sum += cur->mem_size();
+    cur = cur->next();
   }
   sum += (sizeof(PerRegionTable*) * _max_fine_entries);
   sum += (_coarse_map.size_in_words() * HeapWordSize);
@@ -865,7 +1053,9 @@ HeapRegionRemSet::HeapRegionRemSet(G1BlockOffsetSharedArray* bosa,
                                    HeapRegion* hr)
   : _bosa(bosa),
     _m(Mutex::leaf, FormatBuffer<128>("HeapRegionRemSet lock #%u", hr->hrm_index()), true),
-    _code_roots(), _other_regions(hr, &_m), _iter_state(Unclaimed), _iter_claimed(0) {
+    _code_roots(), _other_regions(hr, &_m), _iter_state(Unclaimed), _iter_claimed(0),
+    _code_roots_iter_claimed(0),
+    _state(Completed) {
   reset_for_par_iteration();
 }
 
@@ -921,6 +1111,9 @@ void HeapRegionRemSet::print() {
 
 void HeapRegionRemSet::cleanup() {
   SparsePRT::cleanup_all();
+  if (SafepointSynchronize::is_at_safepoint()) {
+    PerRegionTable::release_fl_chunks();
+  }
 }
 
 void HeapRegionRemSet::clear() {
@@ -933,11 +1126,32 @@ void HeapRegionRemSet::clear_locked() {
   _other_regions.clear();
   assert(occupied_locked() == 0, "Should be clear.");
   reset_for_par_iteration();
+  _state = Completed;
+}
+
+void HeapRegionRemSet::set_state_untracked() {
+  assert_at_safepoint(false /* should_be_vm_thread */);
+  MutexLockerEx x(&_m, Mutex::_no_safepoint_check_flag);
+  _other_regions.clear();
+  reset_for_par_iteration();
+  _state = Untracked;
+}
+
+void HeapRegionRemSet::set_state_rebuilding() {
+  assert_at_safepoint(true /* should_be_vm_thread */);
+  assert(_state == Untracked, "only untracked remembered sets need a rebuild");
+  _state = Rebuilding;
+}
+
+void HeapRegionRemSet::set_state_complete() {
+  assert_at_safepoint(false /* should_be_vm_thread */);
+  _state = Completed;
 }
 
 void HeapRegionRemSet::reset_for_par_iteration() {
   _iter_state = Unclaimed;
   _iter_claimed = 0;
+  _code_roots_iter_claimed = 0;
   // It's good to check this to make sure that the two methods are in sync.
   assert(verify_ready_for_par_iteration(), "post-condition");
 }
@@ -994,6 +1208,10 @@ void HeapRegionRemSet::strong_code_roots_do(CodeBlobClosure* blk) const {
   _code_roots.nmethods_do(blk);
 }
 
+void HeapRegionRemSet::strong_code_roots_do_par(CodeBlobClosure* blk) {
+  _code_roots.nmethods_do_par(blk, &_code_roots_iter_claimed);
+}
+
 void HeapRegionRemSet::clean_strong_code_roots(HeapRegion* hr) {
   _code_roots.clean(hr);
 }
@@ -1228,7 +1446,7 @@ HeapRegionRemSet::finish_cleanup_task(HRRSCleanupTask* hrrs_cleanup_task) {
 void PerRegionTable::test_fl_mem_size() {
   PerRegionTable* dummy = alloc(NULL);
 
-  size_t min_prt_size = sizeof(void*) + dummy->bm()->size_in_words() * HeapWordSize;
+  size_t min_prt_size = sizeof(void*) + dummy->_bm.mem_size();
   assert(dummy->mem_size() > min_prt_size,
          err_msg("PerRegionTable memory usage is suspiciously small, only has " SIZE_FORMAT " bytes. "
                  "Should be at least " SIZE_FORMAT " bytes.", dummy->mem_size(), min_prt_size));
@@ -250,6 +250,19 @@ private:
   enum ParIterState { Unclaimed, Claimed, Complete };
   volatile ParIterState _iter_state;
   volatile jlong _iter_claimed;
+  // The next bucket of _code_roots to claim during parallel iteration.
+  volatile jint _code_roots_iter_claimed;
+
+  // With G1RebuildRemSetsForCandidatesOnly the remembered set of an old
+  // region that has not been picked as a collection set candidate is
+  // dropped after marking, and rebuilt during the next marking cycle.
+  //   Untracked:  no references into the region are recorded.
+  //   Rebuilding: references are recorded, but the set is not complete
+  //               until the end of marking.
+  //   Complete:   the set records all references into the region.
+  // State changes only happen at safepoints.
+  enum RemSetState { Untracked, Rebuilding, Completed };
+  RemSetState _state;
 
   // Unused unless G1RecordHRRSOops is true.
 
@@ -303,14 +316,30 @@ public:
 
   static jint n_coarsenings() { return OtherRegionsTable::n_coarsenings(); }
 
+  bool is_tracked() const  { return _state != Untracked; }
+  bool is_rebuilding() const { return _state == Rebuilding; }
+  bool is_complete() const { return _state == Completed; }
+
+  // Drop the references recorded into this region and stop recording new
+  // ones. The strong code roots are kept.
+  void set_state_untracked();
+  // Start recording references into this region again. Requires that
+  // somebody else supplies the references that already exist.
+  void set_state_rebuilding();
+  void set_state_complete();
+
   // Used in the sequential case.
   void add_reference(OopOrNarrowOopStar from) {
-    _other_regions.add_reference(from, 0);
+    if (is_tracked()) {
+      _other_regions.add_reference(from, 0);
+    }
   }
 
   // Used in the parallel case.
   void add_reference(OopOrNarrowOopStar from, int tid) {
-    _other_regions.add_reference(from, tid);
+    if (is_tracked()) {
+      _other_regions.add_reference(from, tid);
+    }
   }
 
   // Removes any entries shown by the given bitmaps to contain only dead
@@ -344,7 +373,8 @@ public:
   void reset_for_par_iteration();
 
   bool verify_ready_for_par_iteration() {
-    return (_iter_state == Unclaimed) && (_iter_claimed == 0);
+    return (_iter_state == Unclaimed) && (_iter_claimed == 0) &&
+           (_code_roots_iter_claimed == 0);
   }
 
   // The actual # of bytes this hr_remset takes up.
@@ -383,6 +413,10 @@ public:
   // Applies blk->do_code_blob() to each of the entries in
   // the strong code roots list
   void strong_code_roots_do(CodeBlobClosure* blk) const;
+  // Applies blk to part of the strong code roots. All workers calling
+  // this together between two reset_for_par_iteration() calls cover
+  // every nmethod once.
+  void strong_code_roots_do_par(CodeBlobClosure* blk);
 
   void clean_strong_code_roots(HeapRegion* hr);
 
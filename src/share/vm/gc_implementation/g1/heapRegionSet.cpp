@@ -197,6 +197,20 @@ void FreeRegionList::add_ordered(FreeRegionList* from_list) {
   from_list->verify_optional();
 }
 
+HeapRegion* FreeRegionList::remove_region_with_node_index(uint node_index, uint max_search) {
+  check_mt_safety();
+
+  HeapRegion* cur = _head;
+  for (uint i = 0; cur != NULL && i < max_search; i++) {
+    if (cur->node_index() == node_index) {
+      remove_starting_at(cur, 1);
+      return cur;
+    }
+    cur = cur->next();
+  }
+  return NULL;
+}
+
 void FreeRegionList::remove_starting_at(HeapRegion* first, uint num_regions) {
   check_mt_safety();
   assert(num_regions >= 1, hrs_ext_msg(this, "pre-condition"));
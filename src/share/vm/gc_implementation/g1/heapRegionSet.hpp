@@ -244,6 +244,10 @@ public:
   // Removes from head or tail based on the given argument.
   HeapRegion* remove_region(bool from_head);
 
+  // Removes the first region with the given node index among the first
+  // max_search regions from the head. Returns NULL if there is none.
+  HeapRegion* remove_region_with_node_index(uint node_index, uint max_search);
+
   // Merge two ordered lists. The result is also ordered. The order is
   // determined by hrm_index.
   void add_ordered(FreeRegionList* from_list);
@@ -26,6 +26,7 @@
 #include "gc_implementation/g1/ptrQueue.hpp"
 #include "memory/allocation.hpp"
 #include "memory/allocation.inline.hpp"
+#include "runtime/atomic.inline.hpp"
 #include "runtime/mutex.hpp"
 #include "runtime/mutexLocker.hpp"
 #include "runtime/thread.inline.hpp"
@@ -102,41 +103,83 @@ PtrQueueSet::PtrQueueSet(bool notify_when_complete) :
 
 void** PtrQueueSet::allocate_buffer() {
   assert(_sz > 0, "Didn't set a buffer size.");
-  MutexLockerEx x(_fl_owner->_fl_lock, Mutex::_no_safepoint_check_flag);
-  if (_fl_owner->_buf_free_list != NULL) {
-    void** res = BufferNode::make_buffer_from_node(_fl_owner->_buf_free_list);
-    _fl_owner->_buf_free_list = _fl_owner->_buf_free_list->next();
-    _fl_owner->_buf_free_list_sz--;
-    return res;
-  } else {
-    // Allocate space for the BufferNode in front of the buffer.
-    char *b =  NEW_C_HEAP_ARRAY(char, _sz + BufferNode::aligned_size(), mtGC);
-    return BufferNode::make_buffer_from_block(b);
+  PtrQueueSet* owner = _fl_owner;
+  // Buffers are pushed onto the free list without any locking, but pops
+  // are serialized by _fl_lock so that the CAS below cannot suffer from
+  // ABA.  A barrier slow path never waits for the lock: if it is
+  // contended we simply allocate a fresh buffer instead.
+  if (owner->_buf_free_list != NULL && owner->_fl_lock->try_lock()) {
+    BufferNode* node = owner->_buf_free_list;
+    while (node != NULL) {
+      BufferNode* next = node->next();
+      BufferNode* res = (BufferNode*)
+        Atomic::cmpxchg_ptr(next, &owner->_buf_free_list, node);
+      if (res == node) {
+        break;
+      }
+      node = res;
+    }
+    owner->_fl_lock->unlock();
+    if (node != NULL) {
+      Atomic::dec_ptr((volatile intptr_t*)&owner->_buf_free_list_sz);
+      return BufferNode::make_buffer_from_node(node);
+    }
   }
+  // Allocate space for the BufferNode in front of the buffer.
+  char *b =  NEW_C_HEAP_ARRAY(char, _sz + BufferNode::aligned_size(), mtGC);
+  return BufferNode::make_buffer_from_block(b);
+}
+
+void PtrQueueSet::push_free_list(BufferNode* first, BufferNode* last,
+                                 size_t n) {
+  BufferNode* head = _fl_owner->_buf_free_list;
+  while (true) {
+    last->set_next(head);
+    BufferNode* res = (BufferNode*)
+      Atomic::cmpxchg_ptr(first, &_fl_owner->_buf_free_list, head);
+    if (res == head) {
+      break;
+    }
+    head = res;
+  }
+  Atomic::add_ptr((intptr_t)n,
+                  (volatile intptr_t*)&_fl_owner->_buf_free_list_sz);
 }
 
 void PtrQueueSet::deallocate_buffer(void** buf) {
   assert(_sz > 0, "Didn't set a buffer size.");
-  MutexLockerEx x(_fl_owner->_fl_lock, Mutex::_no_safepoint_check_flag);
   BufferNode *node = BufferNode::make_node_from_buffer(buf);
-  node->set_next(_fl_owner->_buf_free_list);
-  _fl_owner->_buf_free_list = node;
-  _fl_owner->_buf_free_list_sz++;
+  push_free_list(node, node, 1);
 }
 
 void PtrQueueSet::reduce_free_list() {
   assert(_fl_owner == this, "Free list reduction is allowed only for the owner");
   // For now we'll adopt the strategy of deleting half.
   MutexLockerEx x(_fl_lock, Mutex::_no_safepoint_check_flag);
-  size_t n = _buf_free_list_sz / 2;
+  // Detach the whole list; holding the lock keeps allocators away, and any
+  // concurrent deallocations simply start a new list that we push onto.
+  BufferNode* list = (BufferNode*)Atomic::xchg_ptr(NULL, &_buf_free_list);
+  size_t len = 0;
+  for (BufferNode* cur = list; cur != NULL; cur = cur->next()) {
+    len++;
+  }
+  Atomic::add_ptr(-(intptr_t)len, (volatile intptr_t*)&_buf_free_list_sz);
+  size_t n = len / 2;
   while (n > 0) {
-    assert(_buf_free_list != NULL, "_buf_free_list_sz must be wrong.");
-    void* b = BufferNode::make_block_from_node(_buf_free_list);
-    _buf_free_list = _buf_free_list->next();
+    assert(list != NULL, "list length must be wrong.");
+    void* b = BufferNode::make_block_from_node(list);
+    list = list->next();
     FREE_C_HEAP_ARRAY(char, b, mtGC);
-    _buf_free_list_sz --;
+    len--;
     n--;
   }
+  if (list != NULL) {
+    BufferNode* last = list;
+    while (last->next() != NULL) {
+      last = last->next();
+    }
+    push_free_list(list, last, len);
+  }
 }
 
 void PtrQueue::handle_zero_index() {
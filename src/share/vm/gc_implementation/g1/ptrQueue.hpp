@@ -211,11 +211,12 @@ protected:
   int _process_completed_threshold;
   volatile bool _process_completed;
 
-  // This (and the interpretation of the first element as a "next"
-  // pointer) are protected by the TLOQ_FL_lock.
+  // The buffer free list is a lock-free stack: buffers are pushed with a
+  // CAS, while pops (and reduce_free_list) are serialized by _fl_lock to
+  // avoid ABA.  The size is maintained atomically and is approximate.
   Mutex* _fl_lock;
-  BufferNode* _buf_free_list;
-  size_t _buf_free_list_sz;
+  BufferNode* volatile _buf_free_list;
+  volatile size_t _buf_free_list_sz;
   // Queue set can share a freelist. The _fl_owner variable
   // specifies the owner. It is set to "this" by default.
   PtrQueueSet* _fl_owner;
@@ -233,6 +234,9 @@ protected:
   int _max_completed_queue;
   int _completed_queue_padding;
 
+  // Push the chain [first, last] of n nodes onto the owner's free list.
+  void push_free_list(BufferNode* first, BufferNode* last, size_t n);
+
   int completed_buffers_list_length();
   void assert_completed_buffer_list_len_correct_locked();
   void assert_completed_buffer_list_len_correct();
@@ -33,6 +33,7 @@
 #include "gc_implementation/shared/gcTimer.hpp"
 #include "gc_implementation/shared/gcTrace.hpp"
 #include "gc_implementation/shared/gcTraceTime.hpp"
+#include "gc_implementation/shared/gcWorkerPhaseTimes.hpp"
 #include "gc_implementation/shared/parGCAllocBuffer.inline.hpp"
 #include "gc_implementation/shared/spaceDecorator.hpp"
 #include "memory/defNewGeneration.inline.hpp"
@@ -285,6 +286,25 @@ void ParScanThreadState::undo_alloc_in_to_space(HeapWord* obj,
   }
 }
 
+void ParScanThreadState::preserve_mark_if_necessary(oop obj, markOop m) {
+  if (m->must_be_preserved_for_promotion_failure(obj)) {
+    _objs_with_preserved_marks.push(obj);
+    _preserved_marks_of_objs.push(m);
+  }
+}
+
+void ParScanThreadState::restore_preserved_marks() {
+  assert(_objs_with_preserved_marks.size() == _preserved_marks_of_objs.size(),
+         "should be the same");
+  while (!_objs_with_preserved_marks.is_empty()) {
+    oop obj   = _objs_with_preserved_marks.pop();
+    markOop m = _preserved_marks_of_objs.pop();
+    obj->set_mark(m);
+  }
+  _objs_with_preserved_marks.clear(true);
+  _preserved_marks_of_objs.clear(true);
+}
+
 void ParScanThreadState::print_promotion_failure_size() {
   if (_promotion_failed_info.has_failed() && PrintPromotionFailure) {
     gclog_or_tty->print(" (%d: promotion failure size = " SIZE_FORMAT ") ",
@@ -542,6 +562,8 @@ ParEvacuateFollowersClosure::ParEvacuateFollowersClosure(
 
 void ParEvacuateFollowersClosure::do_void() {
   ObjToScanQueue* work_q = par_scan_state()->work_queue();
+  GCWorkerPhaseTimes* times = par_gen()->worker_phase_times();
+  uint worker_id = par_scan_state()->thread_num();
 
   while (true) {
 
@@ -555,6 +577,7 @@ void ParEvacuateFollowersClosure::do_void() {
     if (task_queues()->steal(par_scan_state()->thread_num(),
                              par_scan_state()->hash_seed(),
                              obj_to_scan)) {
+      times->record_steal(worker_id);
       bool res = work_q->push(obj_to_scan);
       assert(res, "Empty queue should have room for a push.");
 
@@ -568,7 +591,12 @@ void ParEvacuateFollowersClosure::do_void() {
 
     // Otherwise, offer termination.
     par_scan_state()->start_term_time();
-    if (terminator()->offer_termination()) break;
+    bool terminated;
+    {
+      GCWorkerTerminationTimer tt(times, worker_id);
+      terminated = terminator()->offer_termination();
+    }
+    if (terminated) break;
     par_scan_state()->end_term_time();
   }
   assert(par_gen()->_overflow_list == NULL && par_gen()->_num_par_pushes == 0,
@@ -617,20 +645,25 @@ void ParNewGenTask::work(uint worker_id) {
                                            &par_scan_state.to_space_root_closure(),
                                            false);
 
+  GCWorkerPhaseTimes* times = _gen->worker_phase_times();
   par_scan_state.start_strong_roots();
-  gch->gen_process_roots(_gen->level(),
-                         true,  // Process younger gens, if any,
-                                // as strong roots.
-                         false, // no scope; this is parallel code
-                         GenCollectedHeap::SO_ScavengeCodeCache,
-                         GenCollectedHeap::StrongAndWeakRoots,
-                         &par_scan_state.to_space_root_closure(),
-                         &par_scan_state.older_gen_closure(),
-                         &cld_scan_closure);
+  {
+    GCWorkerPhaseTimer t(times, ParNewGeneration::RootsPhase, worker_id);
+    gch->gen_process_roots(_gen->level(),
+                           true,  // Process younger gens, if any,
+                                  // as strong roots.
+                           false, // no scope; this is parallel code
+                           GenCollectedHeap::SO_ScavengeCodeCache,
+                           GenCollectedHeap::StrongAndWeakRoots,
+                           &par_scan_state.to_space_root_closure(),
+                           &par_scan_state.older_gen_closure(),
+                           &cld_scan_closure);
+  }
 
   par_scan_state.end_strong_roots();
 
   // "evacuate followers".
+  GCWorkerPhaseTimer t(times, ParNewGeneration::EvacuatePhase, worker_id);
   par_scan_state.evacuate_followers_closure().do_void();
 }
 
@@ -659,6 +692,11 @@ ParNewGeneration(ReservedSpace rs, size_t initial_byte_size, int level)
   for (uint i2 = 0; i2 < ParallelGCThreads; i2++)
     _task_queues->queue(i2)->initialize();
 
+  _worker_phase_times = new GCWorkerPhaseTimes("ParNew", ParallelGCThreads);
+  uint p0 = _worker_phase_times->add_phase("Roots");
+  uint p1 = _worker_phase_times->add_phase("Evacuate");
+  assert(p0 == RootsPhase && p1 == EvacuatePhase, "phases out of order");
+
   _overflow_stacks = NULL;
   if (ParGCUseLocalOverflow) {
 
@@ -885,11 +923,80 @@ void EvacuateFollowersClosureGeneral::do_void() {
 
 bool ParNewGeneration::_avoid_promotion_undo = false;
 
+// Removes the forwarding pointers left in eden and from-space by a
+// failed scavenge.  Neither space has a block offset table that would
+// let us split it further, so each is walked by the first worker to
+// claim it.
+class ParNewRemoveForwardPtrsTask: public AbstractGangTask {
+  ParNewGeneration* _gen;
+  volatile jint     _claimed;
+
+ public:
+  ParNewRemoveForwardPtrsTask(ParNewGeneration* gen) :
+    AbstractGangTask("ParNewGeneration remove forwarding pointers"),
+    _gen(gen), _claimed(0) { }
+
+  virtual void work(uint worker_id) {
+    RemoveForwardPointerClosure rspc;
+    jint i;
+    while ((i = Atomic::add(1, &_claimed) - 1) < 2) {
+      Space* sp = (i == 0) ? (Space*)_gen->eden() : (Space*)_gen->from();
+      sp->object_iterate(&rspc);
+    }
+  }
+};
+
+// Restores the marks each worker preserved for the objects it
+// forwarded to themselves.
+class ParNewRestorePreservedMarksTask: public AbstractGangTask {
+  ParScanThreadStateSet* _state_set;
+
+ public:
+  ParNewRestorePreservedMarksTask(ParScanThreadStateSet* state_set) :
+    AbstractGangTask("ParNewGeneration restore preserved marks"),
+    _state_set(state_set) { }
+
+  virtual void work(uint worker_id) {
+    assert(_state_set->is_valid(worker_id), "Should not have been called");
+    _state_set->thread_state(worker_id).restore_preserved_marks();
+  }
+};
+
+void ParNewGeneration::remove_forwarding_pointers(ParScanThreadStateSet& thread_state_set,
+                                                  GCId gc_id) {
+  GenCollectedHeap* gch = GenCollectedHeap::heap();
+  FlexibleWorkGang* workers = gch->workers();
+  int n_workers = workers->active_workers();
+  {
+    GCTraceTime tm("Remove Forwarding Pointers", PrintPromotionFailure,
+                   false, _gc_timer, gc_id);
+    ParNewRemoveForwardPtrsTask tsk(this);
+    if (n_workers > 1) {
+      workers->run_task(&tsk);
+    } else {
+      tsk.work(0);
+    }
+  }
+  {
+    GCTraceTime tm("Restore Preserved Marks", PrintPromotionFailure,
+                   false, _gc_timer, gc_id);
+    ParNewRestorePreservedMarksTask tsk(&thread_state_set);
+    if (n_workers > 1) {
+      workers->run_task(&tsk);
+    } else {
+      tsk.work(0);
+    }
+    // Marks preserved by the serial parts of the collection, such as
+    // serial reference processing, are kept by the generation itself.
+    restore_preserved_marks();
+  }
+}
+
 void ParNewGeneration::handle_promotion_failed(GenCollectedHeap* gch, ParScanThreadStateSet& thread_state_set, ParNewTracer& gc_tracer) {
   assert(_promo_failure_scan_stack.is_empty(), "post condition");
   _promo_failure_scan_stack.clear(true); // Clear cached segments.
 
-  remove_forwarding_pointers();
+  remove_forwarding_pointers(thread_state_set, gc_tracer.gc_id());
   if (PrintGCDetails) {
     gclog_or_tty->print(" (promotion failed)");
   }
@@ -984,6 +1091,7 @@ void ParNewGeneration::collect(bool   full,
   ParNewGenTask tsk(this, _next_gen, reserved().end(), &thread_state_set);
   gch->set_par_threads(n_workers);
   gch->rem_set()->prepare_for_younger_refs_iterate(true);
+  _worker_phase_times->note_gc_start();
   // It turns out that even when we're using 1 thread, doing the work in a
   // separate thread causes wide variance in run times.  We can't help this
   // in the multi-threaded case, but we special-case n=1 here to get
@@ -1094,6 +1202,8 @@ void ParNewGeneration::collect(bool   full,
   gch->trace_heap_after_gc(&gc_tracer);
   gc_tracer.report_tenuring_threshold(tenuring_threshold());
 
+  _worker_phase_times->note_gc_end(&gc_tracer);
+
   _gc_timer->register_gc_end();
 
   gc_tracer.report_gc_end(_gc_timer->gc_end(), _gc_timer->time_partitions());
@@ -1142,15 +1252,6 @@ bool ParNewGeneration::is_legal_forward_ptr(oop p) {
 }
 #endif
 
-void ParNewGeneration::preserve_mark_if_necessary(oop obj, markOop m) {
-  if (m->must_be_preserved_for_promotion_failure(obj)) {
-    // We should really have separate per-worker stacks, rather
-    // than use locking of a common pair of stacks.
-    MutexLocker ml(ParGCRareEvent_lock);
-    preserve_mark(obj, m);
-  }
-}
-
 // Multiple GC threads may try to promote an object.  If the object
 // is successfully promoted, a forwarding pointer will be installed in
 // the object in the young generation.  This method claims the right
@@ -1178,7 +1279,8 @@ oop ParNewGeneration::copy_to_survivor_space_avoiding_promotion_undo(
   oop forward_ptr;
 
   // Try allocating obj in to-space (unless too old)
-  if (dummyOld.age() < tenuring_threshold()) {
+  uint age = dummyOld.age();
+  if (age < tenuring_threshold_for(old, age, sz)) {
     new_obj = (oop)par_scan_state->alloc_in_to_space(sz);
     if (new_obj == NULL) {
       set_survivor_overflow(true);
@@ -1207,7 +1309,7 @@ oop ParNewGeneration::copy_to_survivor_space_avoiding_promotion_undo(
       _promotion_failed = true;
       new_obj = old;
 
-      preserve_mark_if_necessary(old, m);
+      par_scan_state->preserve_mark_if_necessary(old, m);
       par_scan_state->register_promotion_failure(sz);
     }
 
@@ -1307,7 +1409,8 @@ oop ParNewGeneration::copy_to_survivor_space_with_undo(
   oop forward_ptr;
 
   // Try allocating obj in to-space (unless too old)
-  if (dummyOld.age() < tenuring_threshold()) {
+  uint age = dummyOld.age();
+  if (age < tenuring_threshold_for(old, age, sz)) {
     new_obj = (oop)par_scan_state->alloc_in_to_space(sz);
     if (new_obj == NULL) {
       set_survivor_overflow(true);
@@ -1332,7 +1435,7 @@ oop ParNewGeneration::copy_to_survivor_space_with_undo(
       _promotion_failed = true;
       failed_to_promote = true;
 
-      preserve_mark_if_necessary(old, m);
+      par_scan_state->preserve_mark_if_necessary(old, m);
       par_scan_state->register_promotion_failure(sz);
     }
   } else {
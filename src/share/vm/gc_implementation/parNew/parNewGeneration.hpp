@@ -33,6 +33,7 @@
 #include "utilities/taskqueue.hpp"
 
 class ChunkArray;
+class GCWorkerPhaseTimes;
 class ParScanWithoutBarrierClosure;
 class ParScanWithBarrierClosure;
 class ParRootScanWithoutBarrierClosure;
@@ -110,6 +111,13 @@ class ParScanThreadState {
   // Stats for promotion failure
   PromotionFailedInfo _promotion_failed_info;
 
+  // <object, mark> pairs preserved by this thread for the objects it
+  // forwarded to themselves after a promotion failure.  Kept per
+  // thread so that preserving needs no lock and restoring can be
+  // done in parallel.
+  Stack<oop, mtGC>     _objs_with_preserved_marks;
+  Stack<markOop, mtGC> _preserved_marks_of_objs;
+
   // Timing numbers.
   double _start;
   double _start_strong_roots;
@@ -194,6 +202,12 @@ class ParScanThreadState {
   }
   void print_promotion_failure_size();
 
+  // Preserve the mark of "obj", if necessary, in preparation for its mark
+  // word being overwritten with a self-forwarding-pointer.
+  void preserve_mark_if_necessary(oop obj, markOop m);
+  // Restore the marks preserved above and release the stacks.
+  void restore_preserved_marks();
+
 #if TASKQUEUE_STATS
   TaskQueueStats & taskqueue_stats() const { return _work_queue->stats; }
 
@@ -336,12 +350,16 @@ class ParNewGeneration: public DefNewGeneration {
   // references to live referent.
   DefNewGeneration::IsAliveClosure _is_alive_closure;
 
+  // Per-worker timings of ParNewGenTask
+  GCWorkerPhaseTimes* _worker_phase_times;
+
   static oop real_forwardee_slow(oop obj);
   static void waste_some_time();
 
-  // Preserve the mark of "obj", if necessary, in preparation for its mark
-  // word being overwritten with a self-forwarding-pointer.
-  void preserve_mark_if_necessary(oop obj, markOop m);
+  // Remove the forwarding pointers from eden and from-space and restore
+  // the preserved marks, using the work gang where possible.
+  void remove_forwarding_pointers(ParScanThreadStateSet& thread_state_set,
+                                  GCId gc_id);
 
   void handle_promotion_failed(GenCollectedHeap* gch, ParScanThreadStateSet& thread_state_set, ParNewTracer& gc_tracer);
 
@@ -356,6 +374,12 @@ class ParNewGeneration: public DefNewGeneration {
   void set_survivor_overflow(bool v) { _survivor_overflow = v; }
 
  public:
+  // Phases of ParNewGenTask in worker_phase_times()
+  enum WorkerPhase {
+    RootsPhase,
+    EvacuatePhase
+  };
+
   ParNewGeneration(ReservedSpace rs, size_t initial_byte_size, int level);
 
   ~ParNewGeneration() {
@@ -370,6 +394,8 @@ class ParNewGeneration: public DefNewGeneration {
   virtual const char* name() const;
   virtual const char* short_name() const { return "ParNew"; }
 
+  GCWorkerPhaseTimes* worker_phase_times() const { return _worker_phase_times; }
+
   // override
   virtual bool refs_discovery_is_mt()     const {
     assert(UseParNewGC, "ParNewGeneration only when UseParNewGC");
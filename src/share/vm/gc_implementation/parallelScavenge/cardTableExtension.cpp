@@ -129,6 +129,30 @@ class CheckForPreciseMarks : public OopClosure {
 // when the space is empty, fix the calculation of
 // end_card to allow sp_top == sp->bottom().
 
+jbyte* CardTableExtension::find_first_unclean_card(jbyte* start, jbyte* end) {
+  // A word of clean cards has every byte set to clean_card.
+  STATIC_ASSERT(clean_card == -1);
+  const intptr_t clean_word = ~(intptr_t)0;
+
+  jbyte* cur = start;
+  // Go card by card until the cards are word aligned.
+  while (cur < end && !is_ptr_aligned(cur, BytesPerWord)) {
+    if (!card_is_clean(*cur)) {
+      return cur;
+    }
+    cur++;
+  }
+  // Skip whole words of clean cards.
+  while (cur + BytesPerWord <= end && *(intptr_t*)cur == clean_word) {
+    cur += BytesPerWord;
+  }
+  // Find the unclean card in the word, or check the tail.
+  while (cur < end && card_is_clean(*cur)) {
+    cur++;
+  }
+  return cur;
+}
+
 void CardTableExtension::scavenge_contents_parallel(ObjectStartArray* start_array,
                                                     MutableSpace* sp,
                                                     HeapWord* space_top,
@@ -176,6 +200,26 @@ void CardTableExtension::scavenge_contents_parallel(ObjectStartArray* start_arra
     }
 #endif
 
+    // Most stripes of a large old generation have no dirty cards.  Such
+    // a stripe can be skipped without looking at the start array unless
+    // the last object starting in it extends onto unclean cards of the
+    // following stripes, which are only scanned by this stripe's owner.
+    if (cards_are_clean(worker_start_card, worker_end_card)) {
+      if (slice_end >= (HeapWord*)sp_top) {
+        continue;
+      }
+      HeapWord* last_object = start_array->object_start(slice_end - 1);
+      if (last_object < slice_start) {
+        // No object starts within the stripe.
+        continue;
+      }
+      HeapWord* last_object_end = last_object + oop(last_object)->size();
+      jbyte* last_object_end_card = MIN2(byte_for(last_object_end) + 1, end_card);
+      if (cards_are_clean(worker_end_card, last_object_end_card)) {
+        continue;
+      }
+    }
+
     // If there are not objects starting within the chunk, skip it.
     if (!start_array->object_starts_in_range(slice_start, slice_end)) {
       continue;
@@ -213,9 +257,7 @@ void CardTableExtension::scavenge_contents_parallel(ObjectStartArray* start_arra
     jbyte* current_card = worker_start_card;
     while (current_card < worker_end_card) {
       // Find an unclean card.
-      while (current_card < worker_end_card && card_is_clean(*current_card)) {
-        current_card++;
-      }
+      current_card = find_first_unclean_card(current_card, worker_end_card);
       jbyte* first_unclean_card = current_card;
 
       // Find the end of a run of contiguous unclean cards
@@ -47,6 +47,15 @@ class CardTableExtension : public CardTableModRefBS {
 
   static void verify_all_young_refs_precise_helper(MemRegion mr);
 
+  // Returns the first card in [start, end) that is not clean, or end
+  // if they are all clean.  Whole words of cards are examined at a
+  // time so that scanning the clean parts of a large old generation
+  // is cheap.
+  static jbyte* find_first_unclean_card(jbyte* start, jbyte* end);
+  static bool cards_are_clean(jbyte* start, jbyte* end) {
+    return find_first_unclean_card(start, end) >= end;
+  }
+
  public:
   enum ExtendedCardValue {
     youngergen_card   = CardTableModRefBS::CT_MR_BS_last_reserved + 1,
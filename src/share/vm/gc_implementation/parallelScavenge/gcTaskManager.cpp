@@ -28,6 +28,7 @@
 #include "gc_implementation/shared/adaptiveSizePolicy.hpp"
 #include "memory/allocation.hpp"
 #include "memory/allocation.inline.hpp"
+#include "runtime/atomic.inline.hpp"
 #include "runtime/mutex.hpp"
 #include "runtime/mutexLocker.hpp"
 #include "runtime/orderAccess.inline.hpp"
@@ -381,6 +382,8 @@ GCTaskManager::GCTaskManager(uint workers) :
   _workers(workers),
   _active_workers(0),
   _idle_workers(0),
+  _task_deques(NULL),
+  _steal_seeds(NULL),
   _ndc(NULL) {
   initialize();
 }
@@ -389,6 +392,8 @@ GCTaskManager::GCTaskManager(uint workers, NotifyDoneClosure* ndc) :
   _workers(workers),
   _active_workers(0),
   _idle_workers(0),
+  _task_deques(NULL),
+  _steal_seeds(NULL),
   _ndc(ndc) {
   initialize();
 }
@@ -407,6 +412,16 @@ void GCTaskManager::initialize() {
   _noop_task = NoopGCTask::create_on_c_heap();
   _idle_inactive_task = WaitForBarrierGCTask::create_on_c_heap();
   _resource_flag = NEW_C_HEAP_ARRAY(bool, workers(), mtGC);
+  if (UseGCTaskStealing) {
+    _task_deques = new GCTaskDequeSet(workers());
+    _steal_seeds = NEW_C_HEAP_ARRAY(int, workers(), mtGC);
+    for (uint i = 0; i < workers(); i += 1) {
+      GCTaskDeque* q = new GCTaskDeque();
+      q->initialize();
+      _task_deques->register_queue(i, q);
+      _steal_seeds[i] = 17;
+    }
+  }
   {
     // Set up worker threads.
     //     Distribute the workers among the available processors,
@@ -465,6 +480,15 @@ GCTaskManager::~GCTaskManager() {
     FREE_C_HEAP_ARRAY(bool, _resource_flag, mtGC);
     _resource_flag = NULL;
   }
+  if (_task_deques != NULL) {
+    for (uint i = 0; i < workers(); i += 1) {
+      delete task_deque(i);
+    }
+    delete _task_deques;
+    _task_deques = NULL;
+    FREE_C_HEAP_ARRAY(int, _steal_seeds, mtGC);
+    _steal_seeds = NULL;
+  }
   if (queue() != NULL) {
     GCTaskQueue* unsynchronized_queue = queue()->unsynchronized_queue();
     GCTaskQueue::destroy(unsynchronized_queue);
@@ -634,61 +658,151 @@ void GCTaskManager::add_list(GCTaskQueue* list) {
 
 GCTask* GCTaskManager::get_task(uint which) {
   GCTask* result = NULL;
-  // Grab the queue lock.
-  MutexLockerEx ml(monitor(), Mutex::_no_safepoint_check_flag);
-  // Wait while the queue is block or
-  // there is nothing to do, except maybe release resources.
-  while (is_blocked() ||
-         (queue()->is_empty() && !should_release_resources(which))) {
-    if (TraceGCTaskManager) {
-      tty->print_cr("GCTaskManager::get_task(%u)"
-                    "  blocked: %s"
-                    "  empty: %s"
-                    "  release: %s",
-                    which,
-                    is_blocked() ? "true" : "false",
-                    queue()->is_empty() ? "true" : "false",
-                    should_release_resources(which) ? "true" : "false");
-      tty->print_cr("    => (%s)->wait()",
-                    monitor()->name());
+  for (;;) {
+    if (UseGCTaskStealing) {
+      // Tasks on the deques have already been counted as busy
+      // and delivered when they were taken from the queue.
+      result = get_local_task(which);
+      if (result != NULL) {
+        if (TraceGCTaskManager) {
+          tty->print_cr("GCTaskManager::get_task(%u) => " INTPTR_FORMAT " [%s] (local)",
+                        which, result, GCTask::Kind::to_string(result->kind()));
+          tty->print_cr("     %s", result->name());
+        }
+        return result;
+      }
     }
-    monitor()->wait(Mutex::_no_safepoint_check_flag, 0);
-  }
-  // We've reacquired the queue lock here.
-  // Figure out which condition caused us to exit the loop above.
-  if (!queue()->is_empty()) {
-    if (UseGCTaskAffinity) {
-      result = queue()->dequeue(which);
+    // Grab the queue lock.
+    MutexLockerEx ml(monitor(), Mutex::_no_safepoint_check_flag);
+    // Wait while the queue is block or
+    // there is nothing to do, except maybe release resources.
+    while (is_blocked() ||
+           (queue()->is_empty() && !should_release_resources(which))) {
+      if (UseGCTaskStealing && _task_deques->peek()) {
+        // Help with the tasks on the deques of the other workers.
+        break;
+      }
+      if (TraceGCTaskManager) {
+        tty->print_cr("GCTaskManager::get_task(%u)"
+                      "  blocked: %s"
+                      "  empty: %s"
+                      "  release: %s",
+                      which,
+                      is_blocked() ? "true" : "false",
+                      queue()->is_empty() ? "true" : "false",
+                      should_release_resources(which) ? "true" : "false");
+        tty->print_cr("    => (%s)->wait()",
+                      monitor()->name());
+      }
+      monitor()->wait(Mutex::_no_safepoint_check_flag, 0);
+    }
+    if (UseGCTaskStealing &&
+        (is_blocked() ||
+         (queue()->is_empty() && !should_release_resources(which)))) {
+      // There is nothing in the queue for us, go back to stealing.
+      continue;
+    }
+    // We've reacquired the queue lock here.
+    // Figure out which condition caused us to exit the loop above.
+    uint deque_tasks = 0;
+    if (!queue()->is_empty()) {
+      if (UseGCTaskAffinity) {
+        result = queue()->dequeue(which);
+      } else {
+        result = queue()->dequeue();
+      }
+      if (result->is_barrier_task()) {
+        assert(which != sentinel_worker(),
+               "blocker shouldn't be bogus");
+        set_blocking_worker(which);
+      } else if (UseGCTaskStealing && !UseGCTaskAffinity &&
+                 result->is_ordinary_task()) {
+        deque_tasks = fill_task_deque(which);
+      }
     } else {
-      result = queue()->dequeue();
+      // The queue is empty, but we were woken up.
+      // Just hand back a Noop task,
+      // in case someone wanted us to release resources, or whatever.
+      result = noop_task();
+      increment_noop_tasks();
+    }
+    assert(result != NULL, "shouldn't have null task");
+    if (TraceGCTaskManager) {
+      tty->print_cr("GCTaskManager::get_task(%u) => " INTPTR_FORMAT " [%s]",
+                    which, result, GCTask::Kind::to_string(result->kind()));
+      tty->print_cr("     %s", result->name());
     }
-    if (result->is_barrier_task()) {
-      assert(which != sentinel_worker(),
-             "blocker shouldn't be bogus");
-      set_blocking_worker(which);
+    if (!result->is_idle_task()) {
+      increment_busy_workers();
+      increment_delivered_tasks();
     }
-  } else {
-    // The queue is empty, but we were woken up.
-    // Just hand back a Noop task,
-    // in case someone wanted us to release resources, or whatever.
-    result = noop_task();
-    increment_noop_tasks();
+    if (deque_tasks > 0) {
+      for (uint i = 0; i < deque_tasks; i += 1) {
+        increment_busy_workers();
+        increment_delivered_tasks();
+      }
+      // Let the waiting workers steal from our deque.
+      (void) monitor()->notify_all();
+    }
+    return result;
+    // Release monitor().
   }
-  assert(result != NULL, "shouldn't have null task");
-  if (TraceGCTaskManager) {
-    tty->print_cr("GCTaskManager::get_task(%u) => " INTPTR_FORMAT " [%s]",
-                  which, result, GCTask::Kind::to_string(result->kind()));
-    tty->print_cr("     %s", result->name());
+}
+
+GCTask* GCTaskManager::get_local_task(uint which) {
+  assert(UseGCTaskStealing, "only used with work stealing");
+  GCTask* result = NULL;
+  if (task_deque(which)->pop_local(result)) {
+    return result;
   }
-  if (!result->is_idle_task()) {
-    increment_busy_workers();
-    increment_delivered_tasks();
+  if (_task_deques->steal(which, &_steal_seeds[which], result)) {
+    return result;
   }
-  return result;
-  // Release monitor().
+  return NULL;
+}
+
+uint GCTaskManager::fill_task_deque(uint which) {
+  assert(queue()->own_lock(), "don't own the lock");
+  assert(UseGCTaskStealing && !UseGCTaskAffinity, "only used with work stealing");
+  GCTaskDeque* const deque = task_deque(which);
+  // The deque is only filled by its owner once it has been emptied,
+  // so this and the pushes below cannot fail.
+  assert(deque->is_empty(), "should only fill an empty deque");
+  // Leave enough tasks on the queue for the other active workers.
+  uint share = queue()->length() / MAX2(active_workers(), 1U);
+  share = MIN2(share, deque->max_elems());
+  uint moved = 0;
+  while (moved < share &&
+         !queue()->is_empty() &&
+         queue()->peek()->is_ordinary_task()) {
+    GCTask* task = queue()->dequeue();
+    bool pushed = deque->push(task);
+    assert(pushed, "deque should have room");
+    moved += 1;
+  }
+  if (TraceGCTaskManager && moved > 0) {
+    tty->print_cr("GCTaskManager::fill_task_deque(%u) moved %u tasks", which, moved);
+  }
+  return moved;
 }
 
 void GCTaskManager::note_completion(uint which) {
+  bool decremented = false;
+  uint active = 0;
+  if (UseGCTaskStealing && blocking_worker() != which &&
+      busy_workers() > 2) {
+    // Unless this completes the blocking task or leaves at most
+    // one busy task, nobody waiting on the monitor can make
+    // progress, so don't take it.
+    active = (uint) Atomic::add(-1, (volatile jint*)&_busy_workers);
+    if (active > 1) {
+      increment_completed_tasks();
+      return;
+    }
+    // Raced with other completing workers, so do the
+    // notifications below.
+    decremented = true;
+  }
   MutexLockerEx ml(monitor(), Mutex::_no_safepoint_check_flag);
   if (TraceGCTaskManager) {
     tty->print_cr("GCTaskManager::note_completion(%u)", which);
@@ -701,7 +815,9 @@ void GCTaskManager::note_completion(uint which) {
     set_unblocked();
   }
   increment_completed_tasks();
-  uint active = decrement_busy_workers();
+  if (!decremented) {
+    active = decrement_busy_workers();
+  }
   if ((active == 0) && (queue()->is_empty())) {
     increment_emptied_queue();
     if (TraceGCTaskManager) {
@@ -738,17 +854,22 @@ void GCTaskManager::note_completion(uint which) {
   // Release monitor().
 }
 
+void GCTaskManager::increment_completed_tasks() {
+  // Not always done under the lock with UseGCTaskStealing.
+  Atomic::inc((volatile jint*)&_completed_tasks);
+}
+
 uint GCTaskManager::increment_busy_workers() {
   assert(queue()->own_lock(), "don't own the lock");
-  _busy_workers += 1;
-  return _busy_workers;
+  // With UseGCTaskStealing completions may decrement the count
+  // without holding the lock.
+  return (uint) Atomic::add(1, (volatile jint*)&_busy_workers);
 }
 
 uint GCTaskManager::decrement_busy_workers() {
   assert(queue()->own_lock(), "don't own the lock");
   assert(_busy_workers > 0, "About to make a mistake");
-  _busy_workers -= 1;
-  return _busy_workers;
+  return (uint) Atomic::add(-1, (volatile jint*)&_busy_workers);
 }
 
 void GCTaskManager::release_all_resources() {
@@ -27,6 +27,7 @@
 
 #include "runtime/mutex.hpp"
 #include "utilities/growableArray.hpp"
+#include "utilities/taskqueue.hpp"
 
 //
 // The GCTaskManager is a queue of GCTasks, and accessors
@@ -173,6 +174,10 @@ public:
   GCTask* dequeue();
   //     Dequeue one task, preferring one with affinity.
   GCTask* dequeue(uint affinity);
+  //     The task the next dequeue() will return, without removing it.
+  GCTask* peek() const {
+    return remove_end();
+  }
 protected:
   // Constructor. Clients use factory, but there might be subclasses.
   GCTaskQueue(bool on_c_heap);
@@ -261,6 +266,10 @@ public:
     guarantee(own_lock(), "don't own the lock");
     return unsynchronized_queue()->dequeue(affinity);
   }
+  GCTask* peek() const {
+    guarantee(own_lock(), "don't own the lock");
+    return unsynchronized_queue()->peek();
+  }
   uint length() const {
     guarantee(own_lock(), "don't own the lock");
     return unsynchronized_queue()->length();
@@ -353,6 +362,22 @@ protected:
 //
 // For PSScavenge and ParCompactionManager the GC threads are
 // held in the GCTaskThread** _thread array in GCTaskManager.
+//
+// Work stealing (UseGCTaskStealing)
+//
+//  Handing out the tasks one at a time under the monitor makes the
+// workers contend for it at the start of a job when there are many
+// short tasks.  With UseGCTaskStealing a worker that takes an ordinary
+// task from the queue also takes its share of the ordinary tasks that
+// follow it and pushes them on its own deque.  Workers pop tasks from
+// their own deque and steal from the deques of the other workers
+// without taking the monitor.  The tasks on the deques are counted
+// as busy when they are taken from the queue, so a barrier task still
+// waits for them to complete.  Workers do not wait on the monitor
+// while there are tasks on any deque.
+
+typedef GenericTaskQueue<GCTask*, mtGC, 256>   GCTaskDeque;
+typedef GenericTaskQueueSet<GCTaskDeque, mtGC> GCTaskDequeSet;
 
 
 class GCTaskManager : public CHeapObj<mtGC> {
@@ -371,17 +396,19 @@ private:
   SynchronizedGCTaskQueue*  _queue;             // Queue of tasks.
   GCTaskThread**            _thread;            // Array of worker threads.
   uint                      _active_workers;    // Number of active workers.
-  uint                      _busy_workers;      // Number of busy workers.
+  volatile uint             _busy_workers;      // Number of busy workers.
   uint                      _blocking_worker;   // The worker that's blocking.
   bool*                     _resource_flag;     // Array of flag per threads.
   uint                      _delivered_tasks;   // Count of delivered tasks.
-  uint                      _completed_tasks;   // Count of completed tasks.
+  volatile uint             _completed_tasks;   // Count of completed tasks.
   uint                      _barriers;          // Count of barrier tasks.
   uint                      _emptied_queue;     // Times we emptied the queue.
   NoopGCTask*               _noop_task;         // The NoopGCTask instance.
   uint                      _noop_tasks;        // Count of noop tasks.
   WaitForBarrierGCTask*     _idle_inactive_task;// Task for inactive workers
   volatile uint             _idle_workers;      // Number of idled workers
+  GCTaskDequeSet*           _task_deques;       // Per worker deques for stealing.
+  int*                      _steal_seeds;       // Per worker seeds for stealing.
 public:
   // Factory create and destroy methods.
   static GCTaskManager* create(uint workers) {
@@ -482,6 +509,16 @@ protected:
   GCTaskThread* thread(uint which);
   void set_thread(uint which, GCTaskThread* value);
   bool resource_flag(uint which);
+  //     Work stealing support.
+  GCTaskDeque* task_deque(uint which) const {
+    return _task_deques->queue(which);
+  }
+  //     Pop a task from the worker's deque or steal one from another
+  //     worker.  Returns NULL if there was none.
+  GCTask* get_local_task(uint which);
+  //     Move the worker's share of the ordinary tasks at the head of
+  //     the queue to its deque.  Returns the number of tasks moved.
+  uint fill_task_deque(uint which);
   void set_resource_flag(uint which, bool value);
   // Modifier methods with some semantics.
   //     Is any worker blocking handing out new tasks?
@@ -514,9 +551,7 @@ protected:
   uint completed_tasks() const {
     return _completed_tasks;
   }
-  void increment_completed_tasks() {
-    _completed_tasks += 1;
-  }
+  void increment_completed_tasks();
   void reset_completed_tasks() {
     _completed_tasks = 0;
   }
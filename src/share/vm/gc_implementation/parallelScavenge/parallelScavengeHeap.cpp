@@ -683,6 +683,21 @@ ParallelScavengeHeap* ParallelScavengeHeap::heap() {
 // may be changed to accomodate the desired resize.
 void ParallelScavengeHeap::resize_young_gen(size_t eden_size,
     size_t survivor_size) {
+  // Leave room for the old generation below SoftMaxHeapSize. The
+  // generation itself keeps the result within its minimum size.
+  size_t soft_max_young = soft_max_gen_size(_old_gen->virtual_space()->committed_size());
+  if (eden_size + 2 * survivor_size > soft_max_young) {
+    size_t limited_eden_size = soft_max_young > 2 * survivor_size ?
+                               soft_max_young - 2 * survivor_size : 0;
+    limited_eden_size = MAX2(limited_eden_size, space_alignment());
+    if (PrintAdaptiveSizePolicy && Verbose) {
+      gclog_or_tty->print_cr("Limiting eden size to stay below SoftMaxHeapSize: "
+                             SIZE_FORMAT " -> " SIZE_FORMAT,
+                             eden_size, limited_eden_size);
+    }
+    eden_size = limited_eden_size;
+  }
+
   if (UseAdaptiveGCBoundary) {
     if (size_policy()->bytes_absorbed_from_eden() != 0) {
       size_policy()->reset_bytes_absorbed_from_eden();
@@ -699,6 +714,21 @@ void ParallelScavengeHeap::resize_young_gen(size_t eden_size,
 // the reserved space for the young and old generations
 // may be changed to accomodate the desired resize.
 void ParallelScavengeHeap::resize_old_gen(size_t desired_free_space) {
+  // Promotions still expand the old generation on demand, so only the
+  // free space kept after a full collection is limited here.
+  size_t soft_max_old = soft_max_gen_size(_young_gen->virtual_space()->committed_size());
+  size_t old_used = _old_gen->used_in_bytes();
+  if (old_used + desired_free_space > soft_max_old) {
+    size_t limited_free_space = soft_max_old > old_used ?
+                                soft_max_old - old_used : 0;
+    if (PrintAdaptiveSizePolicy && Verbose) {
+      gclog_or_tty->print_cr("Limiting old generation free space to stay below "
+                             "SoftMaxHeapSize: " SIZE_FORMAT " -> " SIZE_FORMAT,
+                             desired_free_space, limited_free_space);
+    }
+    desired_free_space = limited_free_space;
+  }
+
   if (UseAdaptiveGCBoundary) {
     if (size_policy()->bytes_absorbed_from_eden() != 0) {
       size_policy()->reset_bytes_absorbed_from_eden();
@@ -711,6 +741,11 @@ void ParallelScavengeHeap::resize_old_gen(size_t desired_free_space) {
   _old_gen->resize(desired_free_space);
 }
 
+size_t ParallelScavengeHeap::soft_max_gen_size(size_t other_gen_committed) {
+  size_t soft_max = _collector_policy->soft_max_heap_byte_size();
+  return soft_max > other_gen_committed ? soft_max - other_gen_committed : 0;
+}
+
 ParallelScavengeHeap::ParStrongRootsScope::ParStrongRootsScope() {
   // nothing particular
 }
@@ -227,8 +227,13 @@ class ParallelScavengeHeap : public CollectedHeap {
 
   void print_heap_change(size_t prev_used);
 
+  // The part of SoftMaxHeapSize left for one generation when the other
+  // one has other_gen_committed bytes committed.
+  size_t soft_max_gen_size(size_t other_gen_committed);
+
   // Resize the young generation.  The reserved space for the
   // generation may be expanded in preparation for the resize.
+  // Both resize methods try to keep the heap below SoftMaxHeapSize.
   void resize_young_gen(size_t eden_size, size_t survivor_size);
 
   // Resize the old generation.  The reserved space for the
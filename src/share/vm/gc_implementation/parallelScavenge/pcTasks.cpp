@@ -29,6 +29,7 @@
 #include "gc_implementation/parallelScavenge/psParallelCompact.hpp"
 #include "gc_implementation/shared/gcTimer.hpp"
 #include "gc_implementation/shared/gcTraceTime.hpp"
+#include "gc_implementation/shared/gcWorkerPhaseTimes.hpp"
 #include "gc_interface/collectedHeap.hpp"
 #include "memory/universe.hpp"
 #include "oops/objArrayKlass.inline.hpp"
@@ -54,6 +55,7 @@ void ThreadRootsMarkingTask::do_it(GCTaskManager* manager, uint which) {
 
   NOT_PRODUCT(GCTraceTime tm("ThreadRootsMarkingTask",
     PrintGCDetails && TraceParallelOldGCTasks, true, NULL, PSParallelCompact::gc_tracer()->gc_id()));
+  GCWorkerPhaseTimer t(PSParallelCompact::worker_phase_times(), PSParallelCompact::MarkRootsPhase, which);
   ParCompactionManager* cm =
     ParCompactionManager::gc_thread_compaction_manager(which);
 
@@ -83,6 +85,7 @@ void MarkFromRootsTask::do_it(GCTaskManager* manager, uint which) {
 
   NOT_PRODUCT(GCTraceTime tm("MarkFromRootsTask",
     PrintGCDetails && TraceParallelOldGCTasks, true, NULL, PSParallelCompact::gc_tracer()->gc_id()));
+  GCWorkerPhaseTimer t(PSParallelCompact::worker_phase_times(), PSParallelCompact::MarkRootsPhase, which);
   ParCompactionManager* cm =
     ParCompactionManager::gc_thread_compaction_manager(which);
   PSParallelCompact::MarkAndPushClosure mark_and_push_closure(cm);
@@ -210,6 +213,8 @@ void StealMarkingTask::do_it(GCTaskManager* manager, uint which) {
 
   NOT_PRODUCT(GCTraceTime tm("StealMarkingTask",
     PrintGCDetails && TraceParallelOldGCTasks, true, NULL, PSParallelCompact::gc_tracer()->gc_id()));
+  GCWorkerPhaseTimes* times = PSParallelCompact::worker_phase_times();
+  GCWorkerPhaseTimer t(times, PSParallelCompact::MarkStealPhase, which);
 
   ParCompactionManager* cm =
     ParCompactionManager::gc_thread_compaction_manager(which);
@@ -218,17 +223,23 @@ void StealMarkingTask::do_it(GCTaskManager* manager, uint which) {
   oop obj = NULL;
   ObjArrayTask task;
   int random_seed = 17;
-  do {
+  for (;;) {
     while (ParCompactionManager::steal_objarray(which, &random_seed, task)) {
+      times->record_steal(which);
       ObjArrayKlass* k = (ObjArrayKlass*)task.obj()->klass();
       k->oop_follow_contents(cm, task.obj(), task.index());
       cm->follow_marking_stacks();
     }
     while (ParCompactionManager::steal(which, &random_seed, obj)) {
+      times->record_steal(which);
       obj->follow_contents(cm);
       cm->follow_marking_stacks();
     }
-  } while (!terminator()->offer_termination());
+    GCWorkerTerminationTimer tt(times, which);
+    if (terminator()->offer_termination()) {
+      break;
+    }
+  }
 }
 
 //
@@ -243,6 +254,8 @@ void StealRegionCompactionTask::do_it(GCTaskManager* manager, uint which) {
 
   NOT_PRODUCT(GCTraceTime tm("StealRegionCompactionTask",
     PrintGCDetails && TraceParallelOldGCTasks, true, NULL, PSParallelCompact::gc_tracer()->gc_id()));
+  GCWorkerPhaseTimes* times = PSParallelCompact::worker_phase_times();
+  GCWorkerPhaseTimer t(times, PSParallelCompact::CompactionPhase, which);
 
   ParCompactionManager* cm =
     ParCompactionManager::gc_thread_compaction_manager(which);
@@ -285,11 +298,16 @@ void StealRegionCompactionTask::do_it(GCTaskManager* manager, uint which) {
   // If we're the termination task, try 10 rounds of stealing before
   // setting the termination flag
 
+  // Steal on behalf of the region stack in use rather than the worker id.
+  // With dynamic GC threads the two differ, and excluding the wrong queue
+  // hides the regions preloaded onto the stack numbered like this worker.
   while(true) {
-    if (ParCompactionManager::steal(which, &random_seed, region_index)) {
+    if (ParCompactionManager::steal(which_stack_index, &random_seed, region_index)) {
+      times->record_steal(which);
       PSParallelCompact::fill_and_update_region(cm, region_index);
       cm->drain_region_stacks();
     } else {
+      GCWorkerTerminationTimer tt(times, which);
       if (terminator()->offer_termination()) {
         break;
       }
@@ -310,6 +328,7 @@ void UpdateDensePrefixTask::do_it(GCTaskManager* manager, uint which) {
 
   NOT_PRODUCT(GCTraceTime tm("UpdateDensePrefixTask",
     PrintGCDetails && TraceParallelOldGCTasks, true, NULL, PSParallelCompact::gc_tracer()->gc_id()));
+  GCWorkerPhaseTimer t(PSParallelCompact::worker_phase_times(), PSParallelCompact::DensePrefixPhase, which);
 
   ParCompactionManager* cm =
     ParCompactionManager::gc_thread_compaction_manager(which);
@@ -325,6 +344,7 @@ void DrainStacksCompactionTask::do_it(GCTaskManager* manager, uint which) {
 
   NOT_PRODUCT(GCTraceTime tm("DrainStacksCompactionTask",
     PrintGCDetails && TraceParallelOldGCTasks, true, NULL, PSParallelCompact::gc_tracer()->gc_id()));
+  GCWorkerPhaseTimer t(PSParallelCompact::worker_phase_times(), PSParallelCompact::CompactionPhase, which);
 
   ParCompactionManager* cm =
     ParCompactionManager::gc_thread_compaction_manager(which);
@@ -376,3 +396,33 @@ void DrainStacksCompactionTask::do_it(GCTaskManager* manager, uint which) {
     cm->set_region_stack_index((uint)max_uintx);
   }
 }
+
+//
+// CodeCacheCleaningTask
+//
+
+void CodeCacheCleaningTask::do_it(GCTaskManager* manager, uint which) {
+  assert(Universe::heap()->is_gc_active(), "called outside gc");
+
+  NOT_PRODUCT(GCTraceTime tm("CodeCacheCleaningTask",
+    PrintGCDetails && TraceParallelOldGCTasks, true, NULL, PSParallelCompact::gc_tracer()->gc_id()));
+
+  // The task id, not the worker, decides which task claims the first
+  // nmethod since a worker may execute several of these tasks.
+  _code_cache_task->work_first_pass(_task_id);
+  _string_symbol_task->work(_task_id);
+}
+
+//
+// KlassCleaningGCTask
+//
+
+void KlassCleaningGCTask::do_it(GCTaskManager* manager, uint which) {
+  assert(Universe::heap()->is_gc_active(), "called outside gc");
+
+  NOT_PRODUCT(GCTraceTime tm("KlassCleaningGCTask",
+    PrintGCDetails && TraceParallelOldGCTasks, true, NULL, PSParallelCompact::gc_tracer()->gc_id()));
+
+  _code_cache_task->work_second_pass(_task_id);
+  _klass_cleaning_task->work();
+}
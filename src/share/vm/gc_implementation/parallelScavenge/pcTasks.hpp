@@ -28,6 +28,7 @@
 #include "gc_implementation/parallelScavenge/gcTaskManager.hpp"
 #include "gc_implementation/parallelScavenge/psParallelCompact.hpp"
 #include "gc_implementation/parallelScavenge/psTasks.hpp"
+#include "gc_implementation/shared/parallelCleaning.hpp"
 
 
 // Tasks for parallel compaction of the old generation
@@ -257,4 +258,57 @@ class DrainStacksCompactionTask : public GCTask {
   virtual void do_it(GCTaskManager* manager, uint which);
 };
 
+//
+// CodeCacheCleaningTask
+//
+// This task does the first pass of the parallel code cache unloading
+// and, since that pass does not depend on it, the unlinking of the
+// string and symbol tables.  All CodeCacheCleaningTasks must have
+// completed before the KlassCleaningGCTasks are executed.
+//
+
+class CodeCacheCleaningTask : public GCTask {
+ private:
+  CodeCacheUnloadingTask*      _code_cache_task;
+  StringSymbolTableUnlinkTask* _string_symbol_task;
+  uint                         _task_id;
+ public:
+  char* name() { return (char *)"code-cache-cleaning-task"; }
+
+  CodeCacheCleaningTask(CodeCacheUnloadingTask* code_cache_task,
+                        StringSymbolTableUnlinkTask* string_symbol_task,
+                        uint task_id) :
+    _code_cache_task(code_cache_task),
+    _string_symbol_task(string_symbol_task),
+    _task_id(task_id) { }
+
+  virtual void do_it(GCTaskManager* manager, uint which);
+};
+
+//
+// KlassCleaningGCTask
+//
+// This task does the second pass of the parallel code cache unloading,
+// which relies on the liveness information of the first pass, and
+// then helps cleaning the weak links of the klasses that survived.
+//
+
+class KlassCleaningGCTask : public GCTask {
+ private:
+  CodeCacheUnloadingTask* _code_cache_task;
+  KlassCleaningTask*      _klass_cleaning_task;
+  uint                    _task_id;
+ public:
+  char* name() { return (char *)"klass-cleaning-task"; }
+
+  KlassCleaningGCTask(CodeCacheUnloadingTask* code_cache_task,
+                      KlassCleaningTask* klass_cleaning_task,
+                      uint task_id) :
+    _code_cache_task(code_cache_task),
+    _klass_cleaning_task(klass_cleaning_task),
+    _task_id(task_id) { }
+
+  virtual void do_it(GCTaskManager* manager, uint which);
+};
+
 #endif // SHARE_VM_GC_IMPLEMENTATION_PARALLELSCAVENGE_PCTASKS_HPP
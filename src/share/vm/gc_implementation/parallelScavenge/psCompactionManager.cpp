@@ -171,7 +171,11 @@ ParCompactionManager*
 ParCompactionManager::gc_thread_compaction_manager(int index) {
   assert(index >= 0 && index < (int)ParallelGCThreads, "index out of range");
   assert(_manager_array != NULL, "Sanity");
-  return _manager_array[index];
+  ParCompactionManager* manager = _manager_array[index];
+  // Only the GC worker owning the manager gets it here.
+  manager->marking_stack()->numa_make_local();
+  manager->_objarray_stack.numa_make_local();
+  return manager;
 }
 
 void ParCompactionManager::follow_marking_stacks() {
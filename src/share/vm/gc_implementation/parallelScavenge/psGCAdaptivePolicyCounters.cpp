@@ -148,6 +148,14 @@ PSGCAdaptivePolicyCounters::PSGCAdaptivePolicyCounters(const char* name_arg,
     _full_follows_scavenge = PerfDataManager::create_variable(SUN_GC, cname,
       PerfData::U_Bytes, (jlong) 0, CHECK);
 
+    cname = PerfDataManager::counter_name(name_space(), "avgYoungPLABSize");
+    _avg_young_plab_size = PerfDataManager::create_variable(SUN_GC, cname,
+      PerfData::U_Bytes, (jlong) YoungPLABSize * HeapWordSize, CHECK);
+
+    cname = PerfDataManager::counter_name(name_space(), "avgOldPLABSize");
+    _avg_old_plab_size = PerfDataManager::create_variable(SUN_GC, cname,
+      PerfData::U_Bytes, (jlong) OldPLABSize * HeapWordSize, CHECK);
+
     _counter_time_stamp.update();
   }
 
@@ -66,6 +66,10 @@ class PSGCAdaptivePolicyCounters : public GCAdaptivePolicyCounters {
   PerfVariable* _scavenge_skipped;
   PerfVariable* _full_follows_scavenge;
 
+  // promotion lab sizes averaged over the promotion managers
+  PerfVariable* _avg_young_plab_size;
+  PerfVariable* _avg_old_plab_size;
+
   // Use this time stamp if the gc time stamp is not available.
   TimeStamp     _counter_time_stamp;
 
@@ -193,6 +197,12 @@ class PSGCAdaptivePolicyCounters : public GCAdaptivePolicyCounters {
     _full_follows_scavenge->set_value(event);
   }
 
+  inline void update_plab_sizes(size_t young_size_in_bytes,
+                                size_t old_size_in_bytes) {
+    _avg_young_plab_size->set_value(young_size_in_bytes);
+    _avg_old_plab_size->set_value(old_size_in_bytes);
+  }
+
   // Update all the counters that can be updated from the size policy.
   // This should be called after all policy changes have been made
   // and reflected internall in the size policy.
@@ -32,6 +32,7 @@
 #include "memory/gcLocker.inline.hpp"
 #include "oops/oop.inline.hpp"
 #include "runtime/java.hpp"
+#include "runtime/mutexLocker.hpp"
 
 PRAGMA_FORMAT_MUTE_WARNINGS_FOR_GCC
 
@@ -43,7 +44,7 @@ PSOldGen::PSOldGen(ReservedSpace rs, size_t alignment,
                    size_t initial_size, size_t min_size, size_t max_size,
                    const char* perf_data_name, int level):
   _name(select_name()), _init_gen_size(initial_size), _min_gen_size(min_size),
-  _max_gen_size(max_size)
+  _max_gen_size(max_size), _numa_chunks(NULL), _numa_chunks_num(0)
 {
   initialize(rs, alignment, perf_data_name, level);
 }
@@ -52,7 +53,7 @@ PSOldGen::PSOldGen(size_t initial_size,
                    size_t min_size, size_t max_size,
                    const char* perf_data_name, int level):
   _name(select_name()), _init_gen_size(initial_size), _min_gen_size(min_size),
-  _max_gen_size(max_size)
+  _max_gen_size(max_size), _numa_chunks(NULL), _numa_chunks_num(0)
 {}
 
 void PSOldGen::initialize(ReservedSpace rs, size_t alignment,
@@ -145,6 +146,26 @@ void PSOldGen::initialize_work(const char* perf_data_name, int level) {
 
   // Update the start_array
   start_array()->set_covered_region(cmr);
+
+  initialize_numa_promotion();
+}
+
+void PSOldGen::initialize_numa_promotion() {
+  if (!UseNUMA || !UseNUMAPromotion) {
+    return;
+  }
+  int groups = os::numa_get_groups_num();
+  if (groups <= 1 && !ForceNUMA) {
+    return;
+  }
+  groups = MAX2(groups, 1);
+  _numa_chunks = NEW_C_HEAP_ARRAY(NUMAPromotionChunk, groups, mtGC);
+  for (int i = 0; i < groups; i++) {
+    _numa_chunks[i]._lock = new Mutex(Mutex::leaf, "NUMAPromotionChunk_lock", true);
+    _numa_chunks[i]._top = NULL;
+    _numa_chunks[i]._end = NULL;
+  }
+  _numa_chunks_num = groups;
 }
 
 void PSOldGen::initialize_performance_counters(const char* perf_data_name, int level) {
@@ -222,6 +243,69 @@ HeapWord* PSOldGen::expand_and_cas_allocate(size_t word_size) {
   return cas_allocate_noexpand(word_size);
 }
 
+HeapWord* PSOldGen::numa_cas_allocate_lab(size_t word_size) {
+  assert(SafepointSynchronize::is_at_safepoint(), "Must only be called at safepoint");
+  assert(use_numa_promotion(), "Sanity");
+
+  int lgrp_id = os::numa_get_group_id();
+  NUMAPromotionChunk* chunk = &_numa_chunks[(uint)lgrp_id % (uint)_numa_chunks_num];
+
+  MutexLockerEx ml(chunk->_lock, Mutex::_no_safepoint_check_flag);
+  // The remainder of a chunk is either empty or large enough for a
+  // filler object, so that a retired chunk can always be made parsable.
+  size_t remaining = pointer_delta(chunk->_end, chunk->_top);
+  if (remaining != word_size &&
+      remaining < word_size + CollectedHeap::min_fill_size()) {
+    retire_numa_chunk(chunk);
+
+    size_t chunk_words = align_object_size(MAX2((size_t)NUMAPromotionChunkSize, word_size));
+    if (chunk_words - word_size < CollectedHeap::min_fill_size()) {
+      chunk_words = word_size;
+    }
+    HeapWord* base = cas_allocate(chunk_words);
+    if (base == NULL) {
+      return NULL;
+    }
+
+    // Bind the pages that lie entirely within the chunk to this node.
+    // Pages that are already touched keep their placement, pages shared
+    // with a neighbouring chunk stay interleaved.
+    size_t page_size = UseLargePages ? virtual_space()->alignment() : os::vm_page_size();
+    char* start = (char*)round_to((intptr_t)base, page_size);
+    char* end = (char*)round_down((intptr_t)(base + chunk_words), page_size);
+    if (end > start) {
+      os::numa_make_local(start, pointer_delta(end, start, sizeof(char)), lgrp_id);
+    }
+
+    chunk->_top = base;
+    chunk->_end = base + chunk_words;
+  }
+
+  HeapWord* res = chunk->_top;
+  chunk->_top += word_size;
+  return res;
+}
+
+void PSOldGen::retire_numa_chunk(NUMAPromotionChunk* chunk) {
+  if (chunk->_top < chunk->_end) {
+    size_t remaining = pointer_delta(chunk->_end, chunk->_top);
+    if (!object_space()->cas_deallocate(chunk->_top, remaining)) {
+      assert(remaining >= CollectedHeap::min_fill_size(), "Chunk remainder too small");
+      CollectedHeap::fill_with_object(chunk->_top, remaining);
+      _start_array.allocate_block(chunk->_top);
+    }
+  }
+  chunk->_top = NULL;
+  chunk->_end = NULL;
+}
+
+void PSOldGen::retire_numa_promotion_chunks() {
+  assert(SafepointSynchronize::is_at_safepoint(), "Must only be called at safepoint");
+  for (int i = 0; i < _numa_chunks_num; i++) {
+    retire_numa_chunk(&_numa_chunks[i]);
+  }
+}
+
 void PSOldGen::expand(size_t bytes) {
   if (bytes == 0) {
     return;
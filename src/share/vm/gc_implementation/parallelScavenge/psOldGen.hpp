@@ -57,9 +57,25 @@ class PSOldGen : public CHeapObj<mtGC> {
   const size_t _min_gen_size;
   const size_t _max_gen_size;
 
+  // NUMA-aware promotion. With UseNUMA the old gen is interleaved across
+  // the nodes; when UseNUMAPromotion is also set the promotion labs are
+  // carved out of one chunk per locality group instead, and each chunk is
+  // bound to the node of the GC worker that claimed it.
+  struct NUMAPromotionChunk {
+    Mutex*    _lock;
+    HeapWord* _top;
+    HeapWord* _end;
+  };
+  NUMAPromotionChunk* _numa_chunks;
+  int                 _numa_chunks_num;
+
   // Used when initializing the _name field.
   static inline const char* select_name();
 
+  void initialize_numa_promotion();
+  bool use_numa_promotion() const { return _numa_chunks != NULL; }
+  void retire_numa_chunk(NUMAPromotionChunk* chunk);
+
   HeapWord* allocate_noexpand(size_t word_size) {
     // We assume the heap lock is held here.
     assert_locked_or_safepoint(Heap_lock);
@@ -88,6 +104,11 @@ class PSOldGen : public CHeapObj<mtGC> {
     return (res == NULL) ? expand_and_cas_allocate(word_size) : res;
   }
 
+  // Allocates a promotion lab of word_size words from the chunk of the
+  // calling thread's locality group, refilling the chunk if it is
+  // exhausted. Returns NULL if no chunk could be carved.
+  HeapWord* numa_cas_allocate_lab(size_t word_size);
+
   HeapWord* expand_and_allocate(size_t word_size);
   HeapWord* expand_and_cas_allocate(size_t word_size);
   void expand(size_t bytes);
@@ -187,6 +208,11 @@ class PSOldGen : public CHeapObj<mtGC> {
 
   void space_invariants() PRODUCT_RETURN;
 
+  // Makes the unused parts of the NUMA promotion chunks parsable again.
+  // Called at the end of every scavenge, after the promotion labs have
+  // been flushed.
+  void retire_numa_promotion_chunks();
+
   // Performace Counter support
   void update_counters();
 
@@ -23,6 +23,7 @@
  */
 
 #include "precompiled.hpp"
+#include "classfile/metadataOnStackMark.hpp"
 #include "classfile/symbolTable.hpp"
 #include "classfile/systemDictionary.hpp"
 #include "code/codeCache.hpp"
@@ -42,6 +43,7 @@
 #include "gc_implementation/shared/gcTimer.hpp"
 #include "gc_implementation/shared/gcTrace.hpp"
 #include "gc_implementation/shared/gcTraceTime.hpp"
+#include "gc_implementation/shared/gcWorkerPhaseTimes.hpp"
 #include "gc_implementation/shared/isGCActiveMark.hpp"
 #include "gc_interface/gcCause.hpp"
 #include "memory/gcLocker.inline.hpp"
@@ -806,6 +808,7 @@ void ParallelCompactData::verify_clear()
 
 STWGCTimer          PSParallelCompact::_gc_timer;
 ParallelOldTracer   PSParallelCompact::_gc_tracer;
+GCWorkerPhaseTimes* PSParallelCompact::_worker_phase_times = NULL;
 elapsedTimer        PSParallelCompact::_accumulated_time;
 unsigned int        PSParallelCompact::_total_invocations = 0;
 unsigned int        PSParallelCompact::_maximum_compaction_gc_num = 0;
@@ -856,6 +859,14 @@ void PSParallelCompact::post_initialize() {
                            &_is_alive_closure); // non-header is alive closure
   _counters = new CollectorCounters("PSParallelCompact", 1);
 
+  _worker_phase_times = new GCWorkerPhaseTimes("PSParallelCompact", ParallelGCThreads);
+  uint p0 = _worker_phase_times->add_phase("Mark Roots");
+  uint p1 = _worker_phase_times->add_phase("Mark Steal");
+  uint p2 = _worker_phase_times->add_phase("Dense Prefix");
+  uint p3 = _worker_phase_times->add_phase("Compaction");
+  assert(p0 == MarkRootsPhase && p1 == MarkStealPhase &&
+         p2 == DensePrefixPhase && p3 == CompactionPhase, "phases out of order");
+
   // Initialize static fields in ParCompactionManager.
   ParCompactionManager::initialize(mark_bitmap());
 }
@@ -2053,6 +2064,7 @@ bool PSParallelCompact::invoke_no_policy(bool maximum_heap_compaction) {
     gc_task_manager()->set_active_gang();
     gc_task_manager()->task_idle_workers();
     heap->set_par_threads(gc_task_manager()->active_workers());
+    _worker_phase_times->note_gc_start();
 
     TraceCPUTime tcpu(PrintGCDetails, true, gclog_or_tty);
     GCTraceTime t1(GCCauseString("Full GC", gc_cause), PrintGC, !PrintGCDetails, NULL, _gc_tracer.gc_id());
@@ -2244,6 +2256,8 @@ bool PSParallelCompact::invoke_no_policy(bool maximum_heap_compaction) {
   ParallelTaskTerminator::print_termination_counts();
 #endif
 
+  _worker_phase_times->note_gc_end(&_gc_tracer);
+
   _gc_timer.register_gc_end();
 
   _gc_tracer.report_dense_prefix(dense_prefix(old_space_id));
@@ -2416,23 +2430,60 @@ void PSParallelCompact::marking_phase(ParCompactionManager* cm,
   // This is the point where the entire marking should have completed.
   assert(cm->marking_stacks_empty(), "Marking should have completed");
 
-  // Follow system dictionary roots and unload classes.
-  bool purged_class = SystemDictionary::do_unloading(is_alive_closure());
+  if (active_gc_threads > 1) {
+    parallel_cleaning(is_alive_closure(), active_gc_threads);
+  } else {
+    // Follow system dictionary roots and unload classes.
+    bool purged_class = SystemDictionary::do_unloading(is_alive_closure());
 
-  // Unload nmethods.
-  CodeCache::do_unloading(is_alive_closure(), purged_class);
+    // Unload nmethods.
+    CodeCache::do_unloading(is_alive_closure(), purged_class);
 
-  // Prune dead klasses from subklass/sibling/implementor lists.
-  Klass::clean_weak_klass_links(is_alive_closure());
+    // Prune dead klasses from subklass/sibling/implementor lists.
+    Klass::clean_weak_klass_links(is_alive_closure());
 
-  // Delete entries for dead interned strings.
-  StringTable::unlink(is_alive_closure());
+    // Delete entries for dead interned strings.
+    StringTable::unlink(is_alive_closure());
 
-  // Clean up unreferenced symbols in symbol table.
-  SymbolTable::unlink();
+    // Clean up unreferenced symbols in symbol table.
+    SymbolTable::unlink();
+  }
   _gc_tracer.report_object_count_after_gc(is_alive_closure());
 }
 
+void PSParallelCompact::parallel_cleaning(BoolObjectClosure* is_alive,
+                                          uint active_gc_threads) {
+  // Cleaning of klasses depends on correct information from MetadataOnStackMark.
+  // The CodeCache part is done by the parallel code cache unloading below,
+  // so defer the cleaning until we have complete on_stack data.
+  MetadataOnStackMark md_on_stack(false /* Don't visit the code cache at this point */);
+
+  bool purged_class = SystemDictionary::do_unloading(is_alive, false /* Defer klass cleaning */);
+
+  {
+    CodeCacheUnloadingTask code_cache_task(active_gc_threads, is_alive, purged_class);
+    StringSymbolTableUnlinkTask string_symbol_task(is_alive, true, true, true);
+    KlassCleaningTask klass_cleaning_task(is_alive);
+
+    // A GC thread may execute more than one task, so the first and the
+    // second pass of the code cache unloading are separated by running
+    // them as two batches instead of waiting on a barrier.
+    GCTaskQueue* q = GCTaskQueue::create();
+    for (uint i = 0; i < active_gc_threads; i++) {
+      q->enqueue(new CodeCacheCleaningTask(&code_cache_task, &string_symbol_task, i));
+    }
+    gc_task_manager()->execute_and_wait(q);
+
+    q = GCTaskQueue::create();
+    for (uint i = 0; i < active_gc_threads; i++) {
+      q->enqueue(new KlassCleaningGCTask(&code_cache_task, &klass_cleaning_task, i));
+    }
+    gc_task_manager()->execute_and_wait(q);
+  }
+
+  ClassLoaderDataGraph::free_deallocate_lists();
+}
+
 void PSParallelCompact::follow_class_loader(ParCompactionManager* cm,
                                             ClassLoaderData* cld) {
   PSParallelCompact::MarkAndPushClosure mark_and_push_closure(cm);
@@ -2608,24 +2659,44 @@ void PSParallelCompact::enqueue_dense_prefix_tasks(GCTaskQueue* q,
         tasks_for_dense_prefix = parallel_gc_threads *
           PAR_OLD_DENSE_PREFIX_OVER_PARTITIONING;
       }
-      size_t regions_per_thread = total_dense_prefix_regions /
-        tasks_for_dense_prefix;
-      // Give each thread at least 1 region.
-      if (regions_per_thread == 0) {
-        regions_per_thread = 1;
+
+      // Split the dense prefix by the amount of live data rather than by
+      // the number of regions.  The cost of updating a region is dominated
+      // by the objects it contains, so a split by region count leaves the
+      // tasks covering the densest part of the prefix much longer than the
+      // others.  Every region also costs a scan of its part of the mark
+      // bitmap, so count each region as at least one word.
+      size_t total_live_words = 0;
+      for (size_t cur = region_index_start;
+           cur < region_index_end_dense_prefix;
+           ++cur) {
+        total_live_words += MAX2(sd.region(cur)->data_size(), (size_t)1);
+      }
+      size_t live_words_per_task = total_live_words / tasks_for_dense_prefix;
+      // Give each task at least 1 region.
+      if (live_words_per_task == 0) {
+        live_words_per_task = 1;
       }
 
-      for (uint k = 0; k < tasks_for_dense_prefix; k++) {
-        if (region_index_start >= region_index_end_dense_prefix) {
-          break;
+      size_t task_live_words = 0;
+      for (size_t cur = region_index_start;
+           cur < region_index_end_dense_prefix;
+           ++cur) {
+        task_live_words += MAX2(sd.region(cur)->data_size(), (size_t)1);
+        if (task_live_words >= live_words_per_task) {
+          // region_index_end is not processed
+          size_t region_index_end = cur + 1;
+          q->enqueue(new UpdateDensePrefixTask(SpaceId(space_id),
+                                               region_index_start,
+                                               region_index_end));
+          if (TraceParallelOldGCDensePrefix) {
+            tty->print_cr("dense prefix task " SIZE_FORMAT " - " SIZE_FORMAT
+                          " live words " SIZE_FORMAT,
+                          region_index_start, region_index_end, task_live_words);
+          }
+          region_index_start = region_index_end;
+          task_live_words = 0;
         }
-        // region_index_end is not processed
-        size_t region_index_end = MIN2(region_index_start + regions_per_thread,
-                                       region_index_end_dense_prefix);
-        q->enqueue(new UpdateDensePrefixTask(SpaceId(space_id),
-                                             region_index_start,
-                                             region_index_end));
-        region_index_start = region_index_end;
       }
     }
     // This gets any part of the dense prefix that did not
@@ -34,6 +34,7 @@
 #include "memory/sharedHeap.hpp"
 #include "oops/oop.hpp"
 
+class GCWorkerPhaseTimes;
 class ParallelScavengeHeap;
 class PSAdaptiveSizePolicy;
 class PSYoungGen;
@@ -979,6 +980,7 @@ class PSParallelCompact : AllStatic {
  private:
   static STWGCTimer           _gc_timer;
   static ParallelOldTracer    _gc_tracer;
+  static GCWorkerPhaseTimes*  _worker_phase_times;
   static elapsedTimer         _accumulated_time;
   static unsigned int         _total_invocations;
   static unsigned int         _maximum_compaction_gc_num;
@@ -1011,6 +1013,15 @@ class PSParallelCompact : AllStatic {
  public:
   static ParallelOldTracer* gc_tracer() { return &_gc_tracer; }
 
+  // Phases of the marking and compaction tasks in worker_phase_times()
+  enum WorkerPhase {
+    MarkRootsPhase,
+    MarkStealPhase,
+    DensePrefixPhase,
+    CompactionPhase
+  };
+  static GCWorkerPhaseTimes* worker_phase_times() { return _worker_phase_times; }
+
  private:
 
   static void initialize_space_info();
@@ -1029,6 +1040,10 @@ class PSParallelCompact : AllStatic {
                             bool maximum_heap_compaction,
                             ParallelOldTracer *gc_tracer);
 
+  // Unload classes and clean the code cache, the klass links and the
+  // string and symbol tables with the GC task threads.
+  static void parallel_cleaning(BoolObjectClosure* is_alive, uint active_gc_threads);
+
   template <class T>
   static inline void follow_root(ParCompactionManager* cm, T* p);
 
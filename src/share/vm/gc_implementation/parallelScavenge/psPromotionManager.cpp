@@ -29,6 +29,7 @@
 #include "gc_implementation/parallelScavenge/psScavenge.inline.hpp"
 #include "gc_implementation/shared/gcTrace.hpp"
 #include "gc_implementation/shared/mutableSpace.hpp"
+#include "gc_implementation/shared/parGCAllocBuffer.hpp"
 #include "memory/allocation.inline.hpp"
 #include "memory/memRegion.hpp"
 #include "memory/padded.inline.hpp"
@@ -69,7 +70,10 @@ void PSPromotionManager::initialize() {
 PSPromotionManager* PSPromotionManager::gc_thread_promotion_manager(int index) {
   assert(index >= 0 && index < (int)ParallelGCThreads, "index out of range");
   assert(_manager_array != NULL, "Sanity");
-  return &_manager_array[index];
+  PSPromotionManager* manager = &_manager_array[index];
+  // Only the GC worker owning the manager gets it here.
+  manager->claimed_stack_depth()->numa_make_local();
+  return manager;
 }
 
 PSPromotionManager* PSPromotionManager::vm_thread_promotion_manager() {
@@ -101,6 +105,29 @@ bool PSPromotionManager::post_scavenge(YoungGCTracer& gc_tracer) {
     }
     manager->flush_labs();
   }
+  ParallelScavengeHeap* heap = (ParallelScavengeHeap*)Universe::heap();
+  heap->old_gen()->retire_numa_promotion_chunks();
+
+  if (ResizePLAB) {
+    size_t young_plab_words = 0;
+    size_t old_plab_words = 0;
+    for (uint i = 0; i < ParallelGCThreads + 1; i++) {
+      PSPromotionManager* manager = manager_array(i);
+      manager->adjust_plab_sizes();
+      if (PrintPLAB) {
+        gclog_or_tty->print_cr(" (promotion manager %u: young plab " SIZE_FORMAT
+                               " old plab " SIZE_FORMAT ")",
+                               i, manager->young_plab_size(), manager->old_plab_size());
+      }
+      young_plab_words += manager->young_plab_size();
+      old_plab_words += manager->old_plab_size();
+    }
+    if (UsePerfData) {
+      heap->gc_policy_counters()->update_plab_sizes(
+        young_plab_words / (ParallelGCThreads + 1) * HeapWordSize,
+        old_plab_words / (ParallelGCThreads + 1) * HeapWordSize);
+    }
+  }
   return promotion_failure_occurred;
 }
 
@@ -152,7 +179,11 @@ PSPromotionManager::reset_stats() {
 }
 #endif // TASKQUEUE_STATS
 
-PSPromotionManager::PSPromotionManager() {
+PSPromotionManager::PSPromotionManager() :
+  _young_plab_size(YoungPLABSize), _old_plab_size(OldPLABSize),
+  _young_promoted_words(0), _old_promoted_words(0),
+  _young_plab_avg(PLABWeight, (float)YoungPLABSize),
+  _old_plab_avg(PLABWeight, (float)OldPLABSize) {
   ParallelScavengeHeap* heap = (ParallelScavengeHeap*)Universe::heap();
   assert(heap->kind() == CollectedHeap::ParallelScavengeHeap, "Sanity");
 
@@ -196,6 +227,9 @@ void PSPromotionManager::reset() {
   _old_lab.initialize(MemRegion(lab_base, (size_t)0));
   _old_gen_is_full = false;
 
+  _young_promoted_words = 0;
+  _old_promoted_words = 0;
+
   _promotion_failed_info.reset();
 
   TASKQUEUE_STATS_ONLY(reset_stats());
@@ -244,12 +278,16 @@ void PSPromotionManager::flush_labs() {
   // If either promotion lab fills up, we can flush the
   // lab but not refill it, so check first.
   assert(!_young_lab.is_flushed() || _young_gen_is_full, "Sanity");
-  if (!_young_lab.is_flushed())
+  if (!_young_lab.is_flushed()) {
+    _young_promoted_words += pointer_delta(_young_lab.top(), _young_lab.bottom());
     _young_lab.flush();
+  }
 
   assert(!_old_lab.is_flushed() || _old_gen_is_full, "Sanity");
-  if (!_old_lab.is_flushed())
+  if (!_old_lab.is_flushed()) {
+    _old_promoted_words += pointer_delta(_old_lab.top(), _old_lab.bottom());
     _old_lab.flush();
+  }
 
   // Let PSScavenge know if we overflowed
   if (_young_gen_is_full) {
@@ -257,6 +295,26 @@ void PSPromotionManager::flush_labs() {
   }
 }
 
+// The last lab of a scavenge is on average half used, so aim for labs
+// that are TargetPLABWastePct of twice the volume this manager promoted.
+// Managers that promote little get small labs and waste little of the
+// survivor space; busy managers get large labs and refill less often.
+void PSPromotionManager::adjust_plab_sizes() {
+  assert(ResizePLAB, "Not set");
+
+  _young_plab_avg.sample((float)(_young_promoted_words * 2 * TargetPLABWastePct / 100));
+  _old_plab_avg.sample((float)(_old_promoted_words * 2 * TargetPLABWastePct / 100));
+
+  // Keep a young lab below this manager's share of the to-space.
+  size_t young_max = MIN2(ParGCAllocBuffer::max_size(),
+                          young_space()->capacity_in_words() / (ParallelGCThreads + 1));
+  size_t young_size = MIN2(young_max, (size_t)_young_plab_avg.average());
+  _young_plab_size = align_object_size(MAX2(ParGCAllocBuffer::min_size(), young_size));
+
+  size_t old_size = MIN2(ParGCAllocBuffer::max_size(), (size_t)_old_plab_avg.average());
+  _old_plab_size = align_object_size(MAX2(ParGCAllocBuffer::min_size(), old_size));
+}
+
 template <class T> void PSPromotionManager::process_array_chunk_work(
                                                  oop obj,
                                                  int start, int end) {
@@ -28,6 +28,7 @@
 #include "gc_implementation/parallelScavenge/psPromotionLAB.hpp"
 #include "gc_implementation/shared/gcTrace.hpp"
 #include "gc_implementation/shared/copyFailedInfo.hpp"
+#include "gc_implementation/shared/gcUtil.hpp"
 #include "memory/allocation.hpp"
 #include "memory/padded.hpp"
 #include "utilities/globalDefinitions.hpp"
@@ -80,6 +81,16 @@ class PSPromotionManager VALUE_OBJ_CLASS_SPEC {
   bool                                _young_gen_is_full;
   bool                                _old_gen_is_full;
 
+  // Promotion lab sizes in words. With ResizePLAB they follow the
+  // volume this manager promoted into each generation in earlier
+  // scavenges, otherwise they are YoungPLABSize and OldPLABSize.
+  size_t                              _young_plab_size;
+  size_t                              _old_plab_size;
+  size_t                              _young_promoted_words;
+  size_t                              _old_promoted_words;
+  AdaptiveWeightedAverage             _young_plab_avg;
+  AdaptiveWeightedAverage             _old_plab_avg;
+
   OopStarTaskQueue                    _claimed_stack_depth;
   OverflowTaskQueue<oop, mtGC>        _claimed_stack_breadth;
 
@@ -183,6 +194,11 @@ class PSPromotionManager VALUE_OBJ_CLASS_SPEC {
   void reset();
 
   void flush_labs();
+  void adjust_plab_sizes();
+
+  size_t young_plab_size() const       { return _young_plab_size; }
+  size_t old_plab_size() const         { return _old_plab_size; }
+
   void drain_stacks(bool totally_drain) {
     drain_stacks_depth(totally_drain);
   }
@@ -95,16 +95,20 @@ oop PSPromotionManager::copy_to_survivor_space(oop o) {
         new_obj = (oop) _young_lab.allocate(new_obj_size);
         if (new_obj == NULL && !_young_gen_is_full) {
           // Do we allocate directly, or flush and refill?
-          if (new_obj_size > (YoungPLABSize / 2)) {
+          if (new_obj_size > (_young_plab_size / 2)) {
             // Allocate this object directly
             new_obj = (oop)young_space()->cas_allocate(new_obj_size);
+            if (new_obj != NULL) {
+              _young_promoted_words += new_obj_size;
+            }
           } else {
             // Flush and fill
+            _young_promoted_words += pointer_delta(_young_lab.top(), _young_lab.bottom());
             _young_lab.flush();
 
-            HeapWord* lab_base = young_space()->cas_allocate(YoungPLABSize);
+            HeapWord* lab_base = young_space()->cas_allocate(_young_plab_size);
             if (lab_base != NULL) {
-              _young_lab.initialize(MemRegion(lab_base, YoungPLABSize));
+              _young_lab.initialize(MemRegion(lab_base, _young_plab_size));
               // Try the young lab allocation again.
               new_obj = (oop) _young_lab.allocate(new_obj_size);
             } else {
@@ -129,14 +133,24 @@ oop PSPromotionManager::copy_to_survivor_space(oop o) {
       if (new_obj == NULL) {
         if (!_old_gen_is_full) {
           // Do we allocate directly, or flush and refill?
-          if (new_obj_size > (OldPLABSize / 2)) {
+          if (new_obj_size > (_old_plab_size / 2)) {
             // Allocate this object directly
             new_obj = (oop)old_gen()->cas_allocate(new_obj_size);
+            if (new_obj != NULL) {
+              _old_promoted_words += new_obj_size;
+            }
           } else {
             // Flush and fill
+            _old_promoted_words += pointer_delta(_old_lab.top(), _old_lab.bottom());
             _old_lab.flush();
 
-            HeapWord* lab_base = old_gen()->cas_allocate(OldPLABSize);
+            HeapWord* lab_base = NULL;
+            if (old_gen()->use_numa_promotion()) {
+              lab_base = old_gen()->numa_cas_allocate_lab(_old_plab_size);
+            }
+            if (lab_base == NULL) {
+              lab_base = old_gen()->cas_allocate(_old_plab_size);
+            }
             if(lab_base != NULL) {
 #ifdef ASSERT
               // Delay the initialization of the promotion lab (plab).
@@ -145,7 +159,7 @@ oop PSPromotionManager::copy_to_survivor_space(oop o) {
                 os::sleep(Thread::current(), GCWorkerDelayMillis, false);
               }
 #endif
-              _old_lab.initialize(MemRegion(lab_base, OldPLABSize));
+              _old_lab.initialize(MemRegion(lab_base, _old_plab_size));
               // Try the old lab allocation again.
               new_obj = (oop) _old_lab.allocate(new_obj_size);
             }
@@ -37,6 +37,7 @@
 #include "gc_implementation/shared/gcTimer.hpp"
 #include "gc_implementation/shared/gcTrace.hpp"
 #include "gc_implementation/shared/gcTraceTime.hpp"
+#include "gc_implementation/shared/gcWorkerPhaseTimes.hpp"
 #include "gc_implementation/shared/isGCActiveMark.hpp"
 #include "gc_implementation/shared/spaceDecorator.hpp"
 #include "gc_interface/gcCause.hpp"
@@ -69,6 +70,7 @@ uintptr_t                  PSScavenge::_young_generation_boundary_compressed = 0
 elapsedTimer               PSScavenge::_accumulated_time;
 STWGCTimer                 PSScavenge::_gc_timer;
 ParallelScavengeTracer     PSScavenge::_gc_tracer;
+GCWorkerPhaseTimes*        PSScavenge::_worker_phase_times = NULL;
 Stack<markOop, mtGC>       PSScavenge::_preserved_mark_stack;
 Stack<oop, mtGC>           PSScavenge::_preserved_oop_stack;
 CollectorCounters*         PSScavenge::_counters = NULL;
@@ -390,6 +392,7 @@ bool PSScavenge::invoke_no_policy() {
     // throughout the methods.
     uint active_workers = gc_task_manager()->active_workers();
     heap->set_par_threads(active_workers);
+    _worker_phase_times->note_gc_start();
 
     PSPromotionManager::pre_scavenge();
 
@@ -702,6 +705,7 @@ bool PSScavenge::invoke_no_policy() {
   ParallelTaskTerminator::print_termination_counts();
 #endif
 
+  _worker_phase_times->note_gc_end(&_gc_tracer);
 
   _gc_timer.register_gc_end();
 
@@ -868,4 +872,11 @@ void PSScavenge::initialize() {
   _card_table = (CardTableExtension*)bs;
 
   _counters = new CollectorCounters("PSScavenge", 0);
+
+  _worker_phase_times = new GCWorkerPhaseTimes("PSScavenge", ParallelGCThreads);
+  uint p0 = _worker_phase_times->add_phase("Old-to-Young Roots");
+  uint p1 = _worker_phase_times->add_phase("Roots");
+  uint p2 = _worker_phase_times->add_phase("Steal");
+  assert(p0 == OldToYoungRootsPhase && p1 == RootsPhase && p2 == StealPhase,
+         "phases out of order");
 }
@@ -35,6 +35,7 @@
 
 class GCTaskManager;
 class GCTaskQueue;
+class GCWorkerPhaseTimes;
 class OopStack;
 class ReferenceProcessor;
 class ParallelScavengeHeap;
@@ -73,6 +74,7 @@ class PSScavenge: AllStatic {
   static elapsedTimer         _accumulated_time;     // total time spent on scavenge
   static STWGCTimer           _gc_timer;             // GC time book keeper
   static ParallelScavengeTracer _gc_tracer;          // GC tracing
+  static GCWorkerPhaseTimes*  _worker_phase_times;   // per-worker timings of the scavenge tasks
   // The lowest address possible for the young_gen.
   // This is used to decide if an oop should be scavenged,
   // cards should be marked, etc.
@@ -103,6 +105,14 @@ class PSScavenge: AllStatic {
   // Performance Counters
   static CollectorCounters* counters()           { return _counters; }
 
+  // Phases of the scavenge tasks in worker_phase_times()
+  enum WorkerPhase {
+    OldToYoungRootsPhase,
+    RootsPhase,
+    StealPhase
+  };
+  static GCWorkerPhaseTimes* worker_phase_times() { return _worker_phase_times; }
+
   // Used by scavenge_contents && psMarkSweep
   static ReferenceProcessor* const reference_processor() {
     assert(_ref_processor != NULL, "Sanity");
@@ -32,6 +32,7 @@
 #include "gc_implementation/parallelScavenge/psPromotionManager.inline.hpp"
 #include "gc_implementation/parallelScavenge/psScavenge.inline.hpp"
 #include "gc_implementation/parallelScavenge/psTasks.hpp"
+#include "gc_implementation/shared/gcWorkerPhaseTimes.hpp"
 #include "memory/iterator.hpp"
 #include "memory/universe.hpp"
 #include "oops/oop.inline.hpp"
@@ -48,6 +49,7 @@
 
 void ScavengeRootsTask::do_it(GCTaskManager* manager, uint which) {
   assert(Universe::heap()->is_gc_active(), "called outside gc");
+  GCWorkerPhaseTimer t(PSScavenge::worker_phase_times(), PSScavenge::RootsPhase, which);
 
   PSPromotionManager* pm = PSPromotionManager::gc_thread_promotion_manager(which);
   PSScavengeRootsClosure roots_closure(pm);
@@ -119,6 +121,7 @@ void ScavengeRootsTask::do_it(GCTaskManager* manager, uint which) {
 
 void ThreadRootsTask::do_it(GCTaskManager* manager, uint which) {
   assert(Universe::heap()->is_gc_active(), "called outside gc");
+  GCWorkerPhaseTimer t(PSScavenge::worker_phase_times(), PSScavenge::RootsPhase, which);
 
   PSPromotionManager* pm = PSPromotionManager::gc_thread_promotion_manager(which);
   PSScavengeRootsClosure roots_closure(pm);
@@ -144,6 +147,8 @@ StealTask::StealTask(ParallelTaskTerminator* t) :
 
 void StealTask::do_it(GCTaskManager* manager, uint which) {
   assert(Universe::heap()->is_gc_active(), "called outside gc");
+  GCWorkerPhaseTimes* times = PSScavenge::worker_phase_times();
+  GCWorkerPhaseTimer t(times, PSScavenge::StealPhase, which);
 
   PSPromotionManager* pm =
     PSPromotionManager::gc_thread_promotion_manager(which);
@@ -156,9 +161,11 @@ void StealTask::do_it(GCTaskManager* manager, uint which) {
     StarTask p;
     if (PSPromotionManager::steal_depth(which, &random_seed, p)) {
       TASKQUEUE_STATS_ONLY(pm->record_steal(p));
+      times->record_steal(which);
       pm->process_popped_location_depth(p);
       pm->drain_stacks_depth(true);
     } else {
+      GCWorkerTerminationTimer tt(times, which);
       if (terminator()->offer_termination()) {
         break;
       }
@@ -178,6 +185,7 @@ void OldToYoungRootsTask::do_it(GCTaskManager* manager, uint which) {
   assert(_gen != NULL, "Sanity");
   assert(_gen->object_space()->contains(_gen_top) || _gen_top == _gen->object_space()->top(), "Sanity");
   assert(_stripe_number < ParallelGCThreads, "Sanity");
+  GCWorkerPhaseTimer t(PSScavenge::worker_phase_times(), PSScavenge::OldToYoungRootsPhase, which);
 
   {
     PSPromotionManager* pm = PSPromotionManager::gc_thread_promotion_manager(which);
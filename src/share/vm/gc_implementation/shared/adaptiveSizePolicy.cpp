@@ -26,6 +26,7 @@
 #include "gc_implementation/shared/adaptiveSizePolicy.hpp"
 #include "gc_interface/gcCause.hpp"
 #include "memory/collectorPolicy.hpp"
+#include "runtime/os.hpp"
 #include "runtime/timer.hpp"
 #include "utilities/ostream.hpp"
 #include "utilities/workgroup.hpp"
@@ -178,6 +179,22 @@ int AdaptiveSizePolicy::calc_default_active_workers(uintx total_workers,
   return new_active_workers;
 }
 
+uintx AdaptiveSizePolicy::limit_by_active_processors(uintx workers, uintx min_workers) {
+  uintx initial_cpus = (uintx)os::initial_active_processor_count();
+  uintx active_cpus = (uintx)os::active_processor_count();
+  if (active_cpus >= initial_cpus) {
+    return workers;
+  }
+  uintx limit = MAX2(min_workers, (workers * active_cpus + initial_cpus - 1) / initial_cpus);
+  if (TraceDynamicGCThreads && limit < workers) {
+    gclog_or_tty->print_cr("AdaptiveSizePolicy::limit_by_active_processors() : "
+      "workers: " UINTX_FORMAT " limited to " UINTX_FORMAT
+      " for " UINTX_FORMAT " of " UINTX_FORMAT " processors",
+      workers, limit, active_cpus, initial_cpus);
+  }
+  return MIN2(workers, limit);
+}
+
 int AdaptiveSizePolicy::calc_active_workers(uintx total_workers,
                                             uintx active_workers,
                                             uintx application_workers) {
@@ -189,16 +206,21 @@ int AdaptiveSizePolicy::calc_active_workers(uintx total_workers,
   // number of workers to all the workers.
 
   int new_active_workers;
+  uintx min_workers = (total_workers == 1) ? 1 : 2;
   if (!UseDynamicNumberOfGCThreads ||
      (!FLAG_IS_DEFAULT(ParallelGCThreads) && !ForceDynamicNumberOfGCThreads)) {
     new_active_workers = total_workers;
   } else {
-    uintx min_workers = (total_workers == 1) ? 1 : 2;
     new_active_workers = calc_default_active_workers(total_workers,
                                                      min_workers,
                                                      active_workers,
                                                      application_workers);
   }
+  // The ergonomic number of workers follows the processors available.
+  if (FLAG_IS_DEFAULT(ParallelGCThreads)) {
+    new_active_workers = (int)MIN2((uintx)new_active_workers,
+                                   limit_by_active_processors(total_workers, min_workers));
+  }
   assert(new_active_workers > 0, "Always need at least 1");
   return new_active_workers;
 }
@@ -208,6 +230,10 @@ int AdaptiveSizePolicy::calc_active_conc_workers(uintx total_workers,
                                                  uintx application_workers) {
   if (!UseDynamicNumberOfGCThreads ||
      (!FLAG_IS_DEFAULT(ConcGCThreads) && !ForceDynamicNumberOfGCThreads)) {
+    // ConcGCThreads is set ergonomically when not on the command line.
+    if (!FLAG_IS_CMDLINE(ConcGCThreads)) {
+      return (int)limit_by_active_processors(ConcGCThreads, 1);
+    }
     return ConcGCThreads;
   } else {
     int no_of_gc_threads = calc_default_active_workers(
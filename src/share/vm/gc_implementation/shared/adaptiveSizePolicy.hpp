@@ -342,6 +342,11 @@ class AdaptiveSizePolicy : public CHeapObj<mtGC> {
                      double gc_pause_goal_sec,
                      uint gc_cost_ratio);
 
+  // Scale the number of workers created for the processors available at
+  // startup down to the processors available now, which can be fewer if
+  // the CPU quota of the container was lowered, but not below min_workers.
+  static uintx limit_by_active_processors(uintx workers, uintx min_workers);
+
   // Return number default  GC threads to use in the next GC.
   static int calc_default_active_workers(uintx total_workers,
                                          const uintx min_workers,
@@ -26,7 +26,8 @@
 #include "gc_implementation/shared/collectorCounters.hpp"
 #include "memory/resourceArea.hpp"
 
-CollectorCounters::CollectorCounters(const char* name, int ordinal) {
+CollectorCounters::CollectorCounters(const char* name, int ordinal)
+  : _pause_histogram(NULL) {
 
   if (UsePerfData) {
     EXCEPTION_MARK;
@@ -57,5 +58,14 @@ CollectorCounters::CollectorCounters(const char* name, int ordinal) {
     _last_exit_time = PerfDataManager::create_variable(SUN_GC, cname,
                                                        PerfData::U_Ticks,
                                                        CHECK);
+
+    if (PerfDataHistograms) {
+      // 100 us buckets, the last one from 26 s on
+      cname = PerfDataManager::counter_name(_name_space, "pauseHistogram");
+      _pause_histogram = PerfDataManager::create_histogram(SUN_GC, cname,
+                                                           PerfData::U_Ticks,
+                                                           PerfHistogram::ticks_unit(100),
+                                                           20, CHECK);
+    }
   }
 }
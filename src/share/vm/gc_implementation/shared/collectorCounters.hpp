@@ -38,6 +38,7 @@ class CollectorCounters: public CHeapObj<mtGC> {
     PerfCounter*      _time;
     PerfVariable*     _last_entry_time;
     PerfVariable*     _last_exit_time;
+    PerfHistogram*    _pause_histogram;
 
     // Constant PerfData types don't need to retain a reference.
     // However, it's a good idea to document them here.
@@ -61,6 +62,8 @@ class CollectorCounters: public CHeapObj<mtGC> {
 
     inline PerfVariable* last_exit_counter() const  { return _last_exit_time; }
 
+    inline PerfHistogram* pause_histogram() const   { return _pause_histogram; }
+
     const char* name_space() const                  { return _name_space; }
 };
 
@@ -80,7 +83,13 @@ class TraceCollectorStats: public PerfTraceTimedEvent {
     }
 
     inline ~TraceCollectorStats() {
-      if (UsePerfData) _c->last_exit_counter()->set_value(os::elapsed_counter());
+      if (UsePerfData) {
+        jlong exit_time = os::elapsed_counter();
+        _c->last_exit_counter()->set_value(exit_time);
+        if (_c->pause_histogram() != NULL) {
+          _c->pause_histogram()->record(exit_time - _c->last_entry_counter()->get_value());
+        }
+      }
     }
 };
 
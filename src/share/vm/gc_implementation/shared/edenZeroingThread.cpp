@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "gc_implementation/shared/edenZeroingThread.hpp"
+#include "memory/space.inline.hpp"
+#include "runtime/atomic.inline.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/orderAccess.inline.hpp"
+#include "runtime/safepoint.hpp"
+#include "utilities/copy.hpp"
+
+EdenZeroingThread::EdenZeroingThread(ContiguousSpace* eden, MemRegion reserved) :
+  ConcurrentGCThread(),
+  _eden(eden),
+  _base(eden->bottom()),
+  _num_chunks(0),
+  _states(NULL),
+  _monitor(new Monitor(Mutex::leaf, "EdenZeroing_lock", true)),
+  _next_chunk(0),
+  _suspended(false),
+  _in_progress(false)
+{
+  assert(_base == reserved.start(), "eden starts the young generation");
+  _num_chunks = align_size_up(reserved.word_size(), ChunkSizeInWords) / ChunkSizeInWords;
+  jbyte* states = NEW_C_HEAP_ARRAY(jbyte, _num_chunks, mtGC);
+  for (size_t i = 0; i < _num_chunks; i++) {
+    states[i] = dirty;
+  }
+  _states = states;
+  // Anything below the initial top was allocated before we got here.
+  if (_eden->top() > _base) {
+    for (size_t i = 0; i <= chunk_index(_eden->top() - 1); i++) {
+      states[i] = taken;
+    }
+    _next_chunk = chunk_index(_eden->top() - 1) + 1;
+  }
+
+  set_name("Eden Zeroing Thread");
+  create_and_start();
+}
+
+bool EdenZeroingThread::claim_next_chunk(size_t* index) {
+  assert_lock_strong(_monitor);
+  HeapWord* end = _eden->end();
+  while (_next_chunk < _num_chunks && chunk_start(_next_chunk) < end) {
+    size_t i = _next_chunk++;
+    if (_states[i] == dirty &&
+        Atomic::cmpxchg((jbyte)zeroing, &_states[i], (jbyte)dirty) == dirty) {
+      *index = i;
+      return true;
+    }
+  }
+  return false;
+}
+
+void EdenZeroingThread::zero_chunk(size_t index) {
+  assert(_states[index] == zeroing, "must have claimed the chunk");
+  HeapWord* start = chunk_start(index);
+  HeapWord* end = MIN2(start + ChunkSizeInWords, _eden->end());
+  Copy::zero_to_words(start, pointer_delta(end, start));
+  OrderAccess::release_store(&_states[index], (jbyte)zeroed);
+}
+
+void EdenZeroingThread::run() {
+  initialize_in_thread();
+  wait_for_universe_init();
+
+  while (!_should_terminate) {
+    size_t index;
+    {
+      MutexLockerEx x(_monitor, Mutex::_no_safepoint_check_flag);
+      while (!_should_terminate &&
+             (_suspended || !claim_next_chunk(&index))) {
+        _monitor->wait(Mutex::_no_safepoint_check_flag);
+      }
+      if (_should_terminate) {
+        break;
+      }
+      _in_progress = true;
+    }
+
+    zero_chunk(index);
+
+    {
+      MutexLockerEx x(_monitor, Mutex::_no_safepoint_check_flag);
+      _in_progress = false;
+      _monitor->notify_all();
+    }
+  }
+  terminate();
+}
+
+void EdenZeroingThread::stop() {
+  // it is ok to take late safepoints here, if needed
+  {
+    MutexLockerEx mu(Terminator_lock);
+    _should_terminate = true;
+  }
+
+  {
+    MutexLockerEx x(_monitor, Mutex::_no_safepoint_check_flag);
+    _monitor->notify_all();
+  }
+
+  {
+    MutexLockerEx mu(Terminator_lock);
+    while (!_has_terminated) {
+      Terminator_lock->wait();
+    }
+  }
+}
+
+void EdenZeroingThread::claim(HeapWord* start, size_t word_size, bool zero) {
+  HeapWord* end = start + word_size;
+  assert(_base <= start && end <= _eden->end(), "must be in eden");
+  for (size_t i = chunk_index(start); i < _num_chunks && chunk_start(i) < end; i++) {
+    jbyte state = OrderAccess::load_acquire(&_states[i]);
+    while (state == dirty || state == zeroing) {
+      if (state == dirty) {
+        state = Atomic::cmpxchg((jbyte)taken, &_states[i], (jbyte)dirty);
+        if (state == dirty) {
+          state = taken;
+        }
+      } else {
+        // The zeroing thread is working on this chunk, it will be done
+        // shortly.
+        SpinPause();
+        state = OrderAccess::load_acquire(&_states[i]);
+      }
+    }
+    if (state == taken && zero) {
+      HeapWord* from = MAX2(start, chunk_start(i));
+      HeapWord* to = MIN2(end, chunk_start(i) + ChunkSizeInWords);
+      Copy::zero_to_words(from, pointer_delta(to, from));
+    }
+  }
+}
+
+void EdenZeroingThread::suspend() {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
+  MutexLockerEx x(_monitor, Mutex::_no_safepoint_check_flag);
+  _suspended = true;
+  while (_in_progress) {
+    _monitor->wait(Mutex::_no_safepoint_check_flag);
+  }
+}
+
+void EdenZeroingThread::resume() {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
+  MutexLockerEx x(_monitor, Mutex::_no_safepoint_check_flag);
+  assert(_suspended && !_in_progress, "must be suspended");
+  // The collection may have left objects in eden, or compacted
+  // objects into it. Whatever is above the top is garbage.
+  HeapWord* top = _eden->top();
+  size_t first_free = top > _base ? chunk_index(top - 1) + 1 : 0;
+  for (size_t i = 0; i < _num_chunks; i++) {
+    _states[i] = i < first_free ? (jbyte)taken : (jbyte)dirty;
+  }
+  _next_chunk = first_free;
+  _suspended = false;
+  _monitor->notify_all();
+}
+
+void EdenZeroingThread::print() const {
+  print_on(tty);
+}
+
+void EdenZeroingThread::print_on(outputStream* st) const {
+  st->print("\"%s\" ", name());
+  Thread::print_on(st);
+  st->cr();
+}
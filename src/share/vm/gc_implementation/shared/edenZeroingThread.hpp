@@ -0,0 +1,106 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_GC_IMPLEMENTATION_SHARED_EDENZEROINGTHREAD_HPP
+#define SHARE_VM_GC_IMPLEMENTATION_SHARED_EDENZEROINGTHREAD_HPP
+
+#include "gc_implementation/shared/concurrentGCThread.hpp"
+
+class ContiguousSpace;
+class Monitor;
+
+// The EdenZeroingThread zeroes the free part of a contiguous eden in the
+// background (ZeroEdenConcurrently), so that TLABs carved out of it are
+// already zeroed when they are handed out.
+//
+// Eden is divided into chunks, each with a state:
+//
+//   dirty   - nobody has claimed the chunk yet
+//   zeroing - the zeroing thread is zeroing the chunk
+//   zeroed  - the chunk was zeroed before anything was allocated in it
+//   taken   - allocating threads claimed the chunk first; each of them
+//             zeroes its own part of the chunk if it needs zeroed memory
+//
+// Every allocation in eden must be announced with claim() before the
+// allocating thread writes into it. The zeroing thread only ever claims
+// dirty chunks, so it can never clear memory that was already written.
+// Collections suspend the thread in the young generation's gc_prologue()
+// and let it continue from the new eden top in gc_epilogue().
+class EdenZeroingThread: public ConcurrentGCThread {
+  friend class VMStructs;
+
+  enum ChunkState {
+    dirty   = 0,
+    zeroing = 1,
+    zeroed  = 2,
+    taken   = 3
+  };
+
+  static const size_t ChunkSizeInWords = 64 * K / HeapWordSize;
+
+  ContiguousSpace* _eden;
+  HeapWord*        _base;         // Address of the first chunk
+  size_t           _num_chunks;   // Chunks covering the reserved young generation
+  volatile jbyte*  _states;       // One ChunkState per chunk
+
+  Monitor*         _monitor;      // Protects the fields below
+  size_t           _next_chunk;   // Next chunk the thread looks at
+  bool             _suspended;    // A collection is in progress
+  bool             _in_progress;  // The thread is zeroing a chunk
+
+  size_t chunk_index(HeapWord* addr) const {
+    return pointer_delta(addr, _base) / ChunkSizeInWords;
+  }
+  HeapWord* chunk_start(size_t index) const {
+    return _base + index * ChunkSizeInWords;
+  }
+
+  // Claims the next dirty chunk below the eden end, or returns false
+  // if there is none. Called with _monitor held.
+  bool claim_next_chunk(size_t* index);
+  void zero_chunk(size_t index);
+
+ public:
+  EdenZeroingThread(ContiguousSpace* eden, MemRegion reserved);
+
+  virtual void run();
+  void stop();
+
+  // Called by allocating threads for [start, start + word_size), freshly
+  // allocated in eden. If zero is true the memory is zeroed on return.
+  void claim(HeapWord* start, size_t word_size, bool zero);
+
+  // Stop zeroing for the duration of a collection. Called by the VM
+  // thread at a safepoint.
+  void suspend();
+  // Restart zeroing after a collection, everything below the eden top
+  // is considered in use.
+  void resume();
+
+  // Printing
+  void print() const;
+  void print_on(outputStream* st) const;
+};
+
+#endif // SHARE_VM_GC_IMPLEMENTATION_SHARED_EDENZEROINGTHREAD_HPP
@@ -83,10 +83,16 @@ void GCTracer::report_gc_end(const Ticks& timestamp, TimePartitions* time_partit
 void GCTracer::report_gc_reference_stats(const ReferenceProcessorStats& rps) const {
   assert_set_gc_id();
 
-  send_reference_stats_event(REF_SOFT, rps.soft_count());
-  send_reference_stats_event(REF_WEAK, rps.weak_count());
-  send_reference_stats_event(REF_FINAL, rps.final_count());
-  send_reference_stats_event(REF_PHANTOM, rps.phantom_count());
+  send_reference_stats_event(REF_SOFT, rps.soft_count(), rps.soft_time());
+  send_reference_stats_event(REF_WEAK, rps.weak_count(), rps.weak_time());
+  send_reference_stats_event(REF_FINAL, rps.final_count(), rps.final_time());
+  send_reference_stats_event(REF_PHANTOM, rps.phantom_count(), rps.phantom_time());
+}
+
+void GCTracer::report_worker_phase_times(const GCWorkerPhaseTimes* times) const {
+  assert_set_gc_id();
+
+  send_worker_phase_events(times);
 }
 
 #if INCLUDE_SERVICES
@@ -116,6 +116,8 @@ class G1YoungGCInfo VALUE_OBJ_CLASS_SPEC {
 
 #endif // INCLUDE_ALL_GCS
 
+class GCWorkerPhaseTimes;
+
 class GCTracer : public ResourceObj {
  protected:
   SharedGCInfo _shared_gc_info;
@@ -127,6 +129,8 @@ class GCTracer : public ResourceObj {
   void report_metaspace_summary(GCWhen::Type when, const MetaspaceSummary& metaspace_summary) const;
   void report_gc_reference_stats(const ReferenceProcessorStats& rp) const;
   void report_object_count_after_gc(BoolObjectClosure* object_filter) NOT_SERVICES_RETURN;
+  void report_worker_phase_times(const GCWorkerPhaseTimes* times) const;
+  static bool should_send_worker_phase_events();
   bool has_reported_gc_start() const;
   const GCId& gc_id() { return _shared_gc_info.gc_id(); }
 
@@ -140,8 +144,9 @@ class GCTracer : public ResourceObj {
   void send_gc_heap_summary_event(GCWhen::Type when, const GCHeapSummary& heap_summary) const;
   void send_meta_space_summary_event(GCWhen::Type when, const MetaspaceSummary& meta_space_summary) const;
   void send_metaspace_chunk_free_list_summary(GCWhen::Type when, Metaspace::MetadataType mdtype, const MetaspaceChunkFreeListSummary& summary) const;
-  void send_reference_stats_event(ReferenceType type, size_t count) const;
+  void send_reference_stats_event(ReferenceType type, size_t count, const Tickspan& time) const;
   void send_phase_events(TimePartitions* time_partitions) const;
+  void send_worker_phase_events(const GCWorkerPhaseTimes* times) const;
 };
 
 class YoungGCTracer : public GCTracer {
@@ -238,4 +243,10 @@ class G1OldTracer : public OldGCTracer {
   G1OldTracer() : OldGCTracer(G1Old) {}
 };
 
+// Epsilon never collects; it reports the collection requests it ignores.
+class EpsilonTracer : public GCTracer {
+ public:
+  EpsilonTracer() : GCTracer(Epsilon) {}
+};
+
 #endif // SHARE_VM_GC_IMPLEMENTATION_SHARED_GCTRACE_HPP
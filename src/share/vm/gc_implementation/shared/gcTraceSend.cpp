@@ -27,6 +27,7 @@
 #include "gc_implementation/shared/gcTimer.hpp"
 #include "gc_implementation/shared/gcTrace.hpp"
 #include "gc_implementation/shared/gcWhen.hpp"
+#include "gc_implementation/shared/gcWorkerPhaseTimes.hpp"
 #include "gc_implementation/shared/copyFailedInfo.hpp"
 #include "runtime/os.hpp"
 #include "trace/tracing.hpp"
@@ -54,16 +55,62 @@ void GCTracer::send_garbage_collection_event() const {
   }
 }
 
-void GCTracer::send_reference_stats_event(ReferenceType type, size_t count) const {
+void GCTracer::send_reference_stats_event(ReferenceType type, size_t count, const Tickspan& time) const {
   EventGCReferenceStatistics e;
   if (e.should_commit()) {
       e.set_gcId(_shared_gc_info.gc_id().id());
       e.set_type((u1)type);
       e.set_count(count);
+      e.set_processingTime(time);
       e.commit();
   }
 }
 
+bool GCTracer::should_send_worker_phase_events() {
+#if INCLUDE_TRACE
+  return EventGCWorkerPhase::is_enabled() || EventGCWorkerStatistics::is_enabled();
+#else
+  return false;
+#endif
+}
+
+static jlong secs_to_nanos(double secs) {
+  return (jlong)(secs * NANOSECS_PER_SEC);
+}
+
+void GCTracer::send_worker_phase_events(const GCWorkerPhaseTimes* times) const {
+  for (uint p = 0; p < times->num_phases(); p++) {
+    EventGCWorkerPhase e;
+    if (e.should_commit()) {
+      GCWorkerPhaseTimes::Summary s = times->phase_summary(p);
+      e.set_gcId(_shared_gc_info.gc_id().id());
+      e.set_name(times->phase_name(p));
+      e.set_workers(s.workers());
+      e.set_minimum(secs_to_nanos(s.minimum()));
+      e.set_average(secs_to_nanos(s.average()));
+      e.set_maximum(secs_to_nanos(s.maximum()));
+      e.set_sum(secs_to_nanos(s.sum()));
+      e.commit();
+    }
+  }
+
+  for (uint i = 0; i < times->max_workers(); i++) {
+    if (!times->participated(i)) {
+      continue;
+    }
+    EventGCWorkerStatistics e;
+    if (e.should_commit()) {
+      e.set_gcId(_shared_gc_info.gc_id().id());
+      e.set_worker(i);
+      e.set_cpuTime(secs_to_nanos(times->cpu_time(i)));
+      e.set_terminationTime(secs_to_nanos(times->termination_time(i)));
+      e.set_steals(times->steals(i));
+      e.set_terminationAttempts(times->termination_attempts(i));
+      e.commit();
+    }
+  }
+}
+
 void GCTracer::send_metaspace_chunk_free_list_summary(GCWhen::Type when, Metaspace::MetadataType mdtype,
                                                       const MetaspaceChunkFreeListSummary& summary) const {
   EventMetaspaceChunkFreeListSummary e;
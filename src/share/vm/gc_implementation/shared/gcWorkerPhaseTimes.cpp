@@ -0,0 +1,179 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "gc_implementation/shared/gcTrace.hpp"
+#include "gc_implementation/shared/gcWorkerPhaseTimes.hpp"
+#include "memory/padded.inline.hpp"
+#include "runtime/os.hpp"
+#include "utilities/ostream.hpp"
+
+void GCWorkerPhaseTimes::Summary::add(double value) {
+  if (_workers == 0) {
+    _min = value;
+    _max = value;
+  } else {
+    _min = MIN2(_min, value);
+    _max = MAX2(_max, value);
+  }
+  _sum += value;
+  _workers++;
+}
+
+GCWorkerPhaseTimes::GCWorkerPhaseTimes(const char* title, uint max_workers) :
+  _title(title),
+  _num_phases(0),
+  _max_workers(MAX2(max_workers, 1U)),
+  _enabled(false) {
+  _data = PaddedArray<WorkerData, mtGC>::create_unfreeable(_max_workers);
+}
+
+uint GCWorkerPhaseTimes::add_phase(const char* name) {
+  assert(_num_phases < max_phases, "too many phases");
+  _names[_num_phases] = name;
+  return _num_phases++;
+}
+
+void GCWorkerPhaseTimes::note_gc_start(bool force) {
+  _enabled = force || PrintGCWorkerPhaseTimes || GCTracer::should_send_worker_phase_events();
+  if (_enabled) {
+    for (uint i = 0; i < _max_workers; i++) {
+      WorkerData* d = row(i);
+      for (uint p = 0; p < max_phases; p++) {
+        d->_times[p] = 0.0;
+      }
+      d->_cpu_time = 0.0;
+      d->_termination_time = 0.0;
+      d->_steals = 0;
+      d->_termination_attempts = 0;
+      d->_participated = false;
+    }
+  }
+}
+
+void GCWorkerPhaseTimes::note_gc_end(GCTracer* tracer) {
+  if (!_enabled) {
+    return;
+  }
+  if (PrintGCWorkerPhaseTimes) {
+    print_on(gclog_or_tty);
+  }
+  if (tracer != NULL) {
+    tracer->report_worker_phase_times(this);
+  }
+  _enabled = false;
+}
+
+void GCWorkerPhaseTimes::add_time(uint phase, uint worker, double secs, double cpu_secs) {
+  assert(phase < _num_phases, "invalid phase");
+  WorkerData* d = row(worker);
+  d->_times[phase] += secs;
+  d->_cpu_time += cpu_secs;
+  d->_participated = true;
+}
+
+void GCWorkerPhaseTimes::add_termination(uint worker, double secs) {
+  WorkerData* d = row(worker);
+  d->_termination_time += secs;
+  d->_termination_attempts++;
+  d->_participated = true;
+}
+
+GCWorkerPhaseTimes::Summary GCWorkerPhaseTimes::phase_summary(uint phase) const {
+  Summary s;
+  for (uint i = 0; i < _max_workers; i++) {
+    if (participated(i)) {
+      s.add(row(i)->_times[phase]);
+    }
+  }
+  return s;
+}
+
+void GCWorkerPhaseTimes::print_summary(outputStream* st, int indent, const char* name,
+                                       const Summary& s, bool in_ms) const {
+  st->sp(indent);
+  if (in_ms) {
+    st->print_cr("[%s (ms): Min: %.1lf, Avg: %.1lf, Max: %.1lf, Diff: %.1lf, Sum: %.1lf]",
+                 name, s.minimum() * MILLIUNITS, s.average() * MILLIUNITS,
+                 s.maximum() * MILLIUNITS, (s.maximum() - s.minimum()) * MILLIUNITS,
+                 s.sum() * MILLIUNITS);
+  } else {
+    st->print_cr("[%s: Min: %.0lf, Avg: %.1lf, Max: %.0lf, Diff: %.0lf, Sum: %.0lf]",
+                 name, s.minimum(), s.average(), s.maximum(),
+                 s.maximum() - s.minimum(), s.sum());
+  }
+}
+
+void GCWorkerPhaseTimes::print_on(outputStream* st) const {
+  Summary cpu, term_time, term_attempts, steal_count;
+  for (uint i = 0; i < _max_workers; i++) {
+    if (participated(i)) {
+      cpu.add(cpu_time(i));
+      term_time.add(termination_time(i));
+      term_attempts.add((double)termination_attempts(i));
+      steal_count.add((double)steals(i));
+    }
+  }
+
+  // ParNew and CMS report from inside the pause's own log line.
+  if (st->position() > 0) {
+    st->cr();
+  }
+  st->print_cr("  [%s Worker Phases, Workers: %u]", _title, cpu.workers());
+  for (uint p = 0; p < _num_phases; p++) {
+    print_summary(st, 4, phase_name(p), phase_summary(p), true);
+  }
+  print_summary(st, 4, "Termination", term_time, true);
+  print_summary(st, 6, "Termination Attempts", term_attempts, false);
+  print_summary(st, 4, "Steals", steal_count, false);
+  print_summary(st, 4, "GC Worker CPU", cpu, true);
+}
+
+GCWorkerPhaseTimer::GCWorkerPhaseTimer(GCWorkerPhaseTimes* times, uint phase, uint worker) :
+  _times(times), _phase(phase), _worker(worker), _start(0.0), _start_cpu(0.0) {
+  if (_times->is_enabled()) {
+    _start = os::elapsedTime();
+    _start_cpu = (double)os::current_thread_cpu_time() / NANOSECS_PER_SEC;
+  }
+}
+
+GCWorkerPhaseTimer::~GCWorkerPhaseTimer() {
+  if (_times->is_enabled()) {
+    double cpu = (double)os::current_thread_cpu_time() / NANOSECS_PER_SEC;
+    _times->add_time(_phase, _worker, os::elapsedTime() - _start, cpu - _start_cpu);
+  }
+}
+
+GCWorkerTerminationTimer::GCWorkerTerminationTimer(GCWorkerPhaseTimes* times, uint worker) :
+  _times(times), _worker(worker), _start(0.0) {
+  if (_times->is_enabled()) {
+    _start = os::elapsedTime();
+  }
+}
+
+GCWorkerTerminationTimer::~GCWorkerTerminationTimer() {
+  if (_times->is_enabled()) {
+    _times->add_termination(_worker, os::elapsedTime() - _start);
+  }
+}
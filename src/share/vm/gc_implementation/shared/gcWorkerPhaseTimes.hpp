@@ -0,0 +1,152 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_GC_IMPLEMENTATION_SHARED_GCWORKERPHASETIMES_HPP
+#define SHARE_VM_GC_IMPLEMENTATION_SHARED_GCWORKERPHASETIMES_HPP
+
+#include "memory/allocation.hpp"
+#include "memory/padded.hpp"
+
+class GCTracer;
+class outputStream;
+
+// Per-worker timings for the parallel phases of a pause, for the
+// collectors that have no G1GCPhaseTimes of their own: ParallelGC, ParNew
+// and CMS.
+//
+// A collector creates one instance per kind of pause, adds the phases it
+// reports, and calls note_gc_start() at the beginning of each pause. Its
+// workers record into their own row with GCWorkerPhaseTimer,
+// GCWorkerTerminationTimer and record_steal(). note_gc_end() prints the
+// summary with PrintGCWorkerPhaseTimes and sends the GCWorkerPhase and
+// GCWorkerStatistics events. When neither is enabled nothing is measured.
+class GCWorkerPhaseTimes : public CHeapObj<mtGC> {
+ public:
+  enum {
+    max_phases = 8
+  };
+
+  // Min/avg/max/sum of one value over the workers that took part.
+  class Summary VALUE_OBJ_CLASS_SPEC {
+    double _min;
+    double _max;
+    double _sum;
+    uint   _workers;
+   public:
+    Summary() : _min(0.0), _max(0.0), _sum(0.0), _workers(0) {}
+    void add(double value);
+    double minimum() const { return _min; }
+    double maximum() const { return _max; }
+    double sum() const     { return _sum; }
+    double average() const { return _workers == 0 ? 0.0 : _sum / _workers; }
+    uint workers() const   { return _workers; }
+  };
+
+ private:
+  struct WorkerData {
+    double _times[max_phases];         // seconds
+    double _cpu_time;                  // thread CPU seconds in the timed phases
+    double _termination_time;          // seconds
+    size_t _steals;
+    size_t _termination_attempts;
+    bool   _participated;
+  };
+
+  const char*            _title;
+  PaddedEnd<WorkerData>* _data;
+  const char*            _names[max_phases];
+  uint                   _num_phases;
+  uint                   _max_workers;
+  bool                   _enabled;
+
+  WorkerData* row(uint worker) const {
+    assert(worker < _max_workers, err_msg("worker %u out of range", worker));
+    return &_data[worker];
+  }
+
+  void print_summary(outputStream* st, int indent, const char* name,
+                     const Summary& s, bool in_ms) const;
+
+ public:
+  GCWorkerPhaseTimes(const char* title, uint max_workers);
+
+  // Called while setting up the collector. Returns the phase index.
+  uint add_phase(const char* name);
+
+  // Recording is on if the times will be printed or sent as events;
+  // force turns it on for callers that print the times themselves.
+  void note_gc_start(bool force = false);
+  void note_gc_end(GCTracer* tracer);
+
+  bool is_enabled() const { return _enabled; }
+
+  void add_time(uint phase, uint worker, double secs, double cpu_secs);
+  void add_termination(uint worker, double secs);
+  void record_steal(uint worker) {
+    if (_enabled) {
+      row(worker)->_steals++;
+    }
+  }
+
+  uint num_phases() const              { return _num_phases; }
+  const char* phase_name(uint phase) const {
+    assert(phase < _num_phases, "invalid phase");
+    return _names[phase];
+  }
+  uint max_workers() const             { return _max_workers; }
+  bool participated(uint worker) const { return row(worker)->_participated; }
+  double cpu_time(uint worker) const   { return row(worker)->_cpu_time; }
+  double termination_time(uint worker) const { return row(worker)->_termination_time; }
+  size_t steals(uint worker) const     { return row(worker)->_steals; }
+  size_t termination_attempts(uint worker) const { return row(worker)->_termination_attempts; }
+
+  Summary phase_summary(uint phase) const;
+
+  void print_on(outputStream* st) const;
+};
+
+// Adds the wall and CPU time of a scope to a worker's phase.
+class GCWorkerPhaseTimer : public StackObj {
+  GCWorkerPhaseTimes* const _times;
+  const uint _phase;
+  const uint _worker;
+  double _start;
+  double _start_cpu;
+ public:
+  GCWorkerPhaseTimer(GCWorkerPhaseTimes* times, uint phase, uint worker);
+  ~GCWorkerPhaseTimer();
+};
+
+// Wraps one call to offer_termination(): counts the attempt and adds the
+// time waited to the worker's termination time.
+class GCWorkerTerminationTimer : public StackObj {
+  GCWorkerPhaseTimes* const _times;
+  const uint _worker;
+  double _start;
+ public:
+  GCWorkerTerminationTimer(GCWorkerPhaseTimes* times, uint worker);
+  ~GCWorkerTerminationTimer();
+};
+
+#endif // SHARE_VM_GC_IMPLEMENTATION_SHARED_GCWORKERPHASETIMES_HPP
@@ -27,6 +27,7 @@
 #if INCLUDE_ALL_GCS
 #include "gc_implementation/shared/mutableSpace.hpp"
 #include "gc_implementation/shared/spaceDecorator.hpp"
+#include "memory/pretouchTask.hpp"
 #include "oops/oop.inline.hpp"
 #include "runtime/safepoint.hpp"
 #include "runtime/thread.hpp"
@@ -62,7 +63,7 @@ void MutableSpace::numa_setup_pages(MemRegion mr, bool clear_space) {
 }
 
 void MutableSpace::pretouch_pages(MemRegion mr) {
-  os::pretouch_memory((char*)mr.start(), (char*)mr.end());
+  PretouchTask::pretouch((char*)mr.start(), (char*)mr.end(), os::vm_page_size());
 }
 
 void MutableSpace::initialize(MemRegion mr,
@@ -0,0 +1,161 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_GC_IMPLEMENTATION_SHARED_PARALLELCLEANING_HPP
+#define SHARE_VM_GC_IMPLEMENTATION_SHARED_PARALLELCLEANING_HPP
+
+#include "classfile/classLoaderData.hpp"
+#include "memory/iterator.hpp"
+#include "utilities/workgroup.hpp"
+
+class InstanceKlass;
+class Monitor;
+class nmethod;
+
+// Cleaning of the weak VM data structures (string and symbol tables,
+// the code cache and the klass subklass/implementor links) after a
+// marking phase. The tasks below are shared by the collectors that
+// unload classes with several GC worker threads.
+
+class StringSymbolTableUnlinkTask : public AbstractGangTask {
+private:
+  BoolObjectClosure* _is_alive;
+  int _initial_string_table_size;
+  int _initial_symbol_table_size;
+
+  bool  _process_strings;
+  int _strings_processed;
+  int _strings_removed;
+
+  bool  _process_symbols;
+  int _symbols_processed;
+  int _symbols_removed;
+
+  bool _do_in_parallel;
+public:
+  StringSymbolTableUnlinkTask(BoolObjectClosure* is_alive, bool process_strings,
+                              bool process_symbols, bool do_in_parallel);
+  ~StringSymbolTableUnlinkTask();
+
+  void work(uint worker_id);
+
+  size_t strings_processed() const { return (size_t)_strings_processed; }
+  size_t strings_removed()   const { return (size_t)_strings_removed; }
+
+  size_t symbols_processed() const { return (size_t)_symbols_processed; }
+  size_t symbols_removed()   const { return (size_t)_symbols_removed; }
+
+  void print_statistics(outputStream* st) const;
+};
+
+class CodeCacheUnloadingTask VALUE_OBJ_CLASS_SPEC {
+private:
+  static Monitor* _lock;
+
+  BoolObjectClosure* const _is_alive;
+  const bool               _unloading_occurred;
+  const uint               _num_workers;
+
+  // Variables used to claim nmethods.
+  nmethod* _first_nmethod;
+  volatile nmethod* _claimed_nmethod;
+
+  // The list of nmethods that need to be processed by the second pass.
+  volatile nmethod* _postponed_list;
+  volatile uint     _num_entered_barrier;
+
+ public:
+  CodeCacheUnloadingTask(uint num_workers, BoolObjectClosure* is_alive, bool unloading_occurred);
+  ~CodeCacheUnloadingTask();
+
+ private:
+  void add_to_postponed_list(nmethod* nm);
+  void clean_nmethod(nmethod* nm);
+  void clean_nmethod_postponed(nmethod* nm);
+
+  static const int MaxClaimNmethods = 16;
+
+  void claim_nmethods(nmethod** claimed_nmethods, int *num_claimed_nmethods);
+  nmethod* claim_postponed_nmethod();
+
+ public:
+  // Mark that we're done with the first pass of nmethod cleaning.
+  void barrier_mark(uint worker_id);
+
+  // See if we have to wait for the other workers to
+  // finish their first-pass nmethod cleaning work.
+  void barrier_wait(uint worker_id);
+
+  // Cleaning and unloading of nmethods. Some work has to be postponed
+  // to the second pass, when we know which nmethods survive.
+  // The first nmethod is cleaned by the worker with id 0. Collectors
+  // that do not run the two passes in the same gang task must make
+  // sure that all first passes are complete before any second pass starts.
+  void work_first_pass(uint worker_id);
+  void work_second_pass(uint worker_id);
+};
+
+class KlassCleaningTask : public StackObj {
+  BoolObjectClosure*                      _is_alive;
+  volatile jint                           _clean_klass_tree_claimed;
+  ClassLoaderDataGraphKlassIteratorAtomic _klass_iterator;
+
+ public:
+  KlassCleaningTask(BoolObjectClosure* is_alive) :
+      _is_alive(is_alive),
+      _clean_klass_tree_claimed(0),
+      _klass_iterator() {
+  }
+
+ private:
+  bool claim_clean_klass_tree_task();
+  InstanceKlass* claim_next_klass();
+
+public:
+  void clean_klass(InstanceKlass* ik);
+  void work();
+};
+
+// To minimize the pause times, the tasks below are done in parallel.
+class ParallelCleaningTask : public AbstractGangTask {
+private:
+  StringSymbolTableUnlinkTask _string_symbol_task;
+  CodeCacheUnloadingTask      _code_cache_task;
+  KlassCleaningTask           _klass_cleaning_task;
+
+public:
+  // The constructor is run in the VMThread.
+  ParallelCleaningTask(BoolObjectClosure* is_alive, bool process_strings, bool process_symbols,
+                       uint num_workers, bool unloading_occurred);
+
+  StringSymbolTableUnlinkTask* string_symbol_task() { return &_string_symbol_task; }
+
+  void pre_work_verification();
+  void post_work_verification();
+
+  // The parallel work done by all worker threads.
+  void work(uint worker_id);
+};
+
+#endif // SHARE_VM_GC_IMPLEMENTATION_SHARED_PARALLELCLEANING_HPP
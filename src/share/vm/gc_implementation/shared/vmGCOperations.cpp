@@ -183,7 +183,7 @@ void VM_GC_HeapInspection::doit() {
     }
   }
   HeapInspection inspect(_csv_format, _print_help, _print_class_stats,
-                         _columns);
+                         _columns, _parallel_thread_num);
   inspect.heap_inspection(_out);
 }
 
@@ -48,6 +48,16 @@ void AllocTracer::send_allocation_in_new_tlab_event(KlassHandle klass, size_t tl
   }
 }
 
+void AllocTracer::send_allocation_sample_event(KlassHandle klass, size_t alloc_size, size_t weight) {
+  EventAllocObjectSample event;
+  if (event.should_commit()) {
+    event.set_class(klass());
+    event.set_allocationSize(alloc_size);
+    event.set_weight(weight);
+    event.commit();
+  }
+}
+
 void AllocTracer::send_allocation_requiring_gc_event(size_t size, const GCId& gcId) {
   EventAllocationRequiringGC event;
   if (event.should_commit()) {
@@ -263,6 +263,16 @@ void CollectedHeap::check_for_valid_allocation_state() {
 
 HeapWord* CollectedHeap::allocate_from_tlab_slow(KlassHandle klass, Thread* thread, size_t size) {
 
+  // The end of the tlab may only have been lowered to catch the next
+  // sampled allocation; see sample_allocation_slow().
+  if (thread->tlab().end() < thread->tlab().allocation_end()) {
+    thread->tlab().set_back_allocation_end();
+    HeapWord* obj = thread->tlab().allocate(size);
+    if (obj != NULL) {
+      return obj;
+    }
+  }
+
   // Retain tlab and allocate object in shared space if
   // the amount free in the tlab is too large to discard.
   if (thread->tlab().free() > thread->tlab().refill_waste_limit()) {
@@ -289,8 +299,10 @@ HeapWord* CollectedHeap::allocate_from_tlab_slow(KlassHandle klass, Thread* thre
   AllocTracer::send_allocation_in_new_tlab_event(klass, new_tlab_size * HeapWordSize, size * HeapWordSize);
 
   if (ZeroTLAB) {
-    // ..and clear it.
-    Copy::zero_to_words(obj, new_tlab_size);
+    // ..and clear it, unless the young generation has done that already.
+    if (!ZeroEdenConcurrently) {
+      Copy::zero_to_words(obj, new_tlab_size);
+    }
   } else {
     // ...and zap just allocated object.
 #ifdef ASSERT
@@ -305,6 +317,29 @@ HeapWord* CollectedHeap::allocate_from_tlab_slow(KlassHandle klass, Thread* thre
   return obj;
 }
 
+oop CollectedHeap::sample_allocation_slow(oop obj, int size, Thread* thread) {
+  ThreadHeapSampler& sampler = thread->heap_sampler();
+  if (sampler.is_posting()) {
+    return obj;
+  }
+  jlong weight = sampler.check_for_sampling(thread->cooked_allocated_bytes());
+  if (weight > 0 && ThreadHeapSampler::is_safe_to_sample(thread)) {
+    KlassHandle klass(thread, obj->klass());
+    AllocTracer::send_allocation_sample_event(klass, size * HeapWordSize, (size_t)weight);
+    if (JvmtiExport::should_post_sampled_object_alloc()) {
+      Handle h(thread, obj);
+      sampler.set_posting(true);
+      JvmtiExport::post_sampled_object_alloc((JavaThread*)thread, h());
+      sampler.set_posting(false);
+      obj = h();
+    }
+  }
+  if (UseTLAB) {
+    thread->tlab().set_sample_end(sampler.bytes_until_sample(thread->cooked_allocated_bytes()));
+  }
+  return obj;
+}
+
 void CollectedHeap::flush_deferred_store_barrier(JavaThread* thread) {
   MemRegion deferred = thread->deferred_card_mark();
   if (!deferred.is_empty()) {
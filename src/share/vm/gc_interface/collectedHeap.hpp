@@ -159,6 +159,13 @@ class CollectedHeap : public CHeapObj<mtInternal> {
   // Clears an allocated object.
   inline static void init_obj(HeapWord* obj, size_t size);
 
+  // Reports a newly allocated object to the heap sampler, which takes a
+  // sample if the allocation made the thread cross its next sampling point
+  // (-XX:HeapSamplingInterval). Reporting may safepoint, so the possibly
+  // moved object is returned.
+  inline static oop sample_allocation(oop obj, int size, Thread* thread);
+  static oop sample_allocation_slow(oop obj, int size, Thread* thread);
+
   // Filler object utilities.
   static inline size_t filler_array_hdr_size();
   static inline size_t filler_array_min_size();
@@ -188,7 +195,8 @@ class CollectedHeap : public CHeapObj<mtInternal> {
     SharedHeap,
     GenCollectedHeap,
     ParallelScavengeHeap,
-    G1CollectedHeap
+    G1CollectedHeap,
+    EpsilonHeap
   };
 
   static inline size_t filler_array_max_size() {
@@ -460,6 +468,12 @@ class CollectedHeap : public CHeapObj<mtInternal> {
   // Does this heap support heap inspection (+PrintClassHistogram?)
   virtual bool supports_heap_inspection() const = 0;
 
+  // Can individual objects be pinned in place, so that JNI critical
+  // sections need not hold off collections through the GC_locker?
+  virtual bool supports_object_pinning() const { return false; }
+  virtual void pin_object(oop obj)   { ShouldNotReachHere(); }
+  virtual void unpin_object(oop obj) { ShouldNotReachHere(); }
+
   // Perform a collection of the heap; intended for use in implementing
   // "System.gc".  This probably implies as full a collection as the
   // "CollectedHeap" supports.
@@ -547,6 +561,14 @@ class CollectedHeap : public CHeapObj<mtInternal> {
   // time that any part of the heap was examined by a garbage collection.
   virtual jlong millis_since_last_gc() = 0;
 
+  // Collections of an otherwise idle heap, polled by the ServiceThread
+  // every periodic_collection_interval_ms(), which is 0 if unused.
+  // needs_periodic_collection() must be cheap, it is called with the
+  // Service_lock held.
+  virtual jlong periodic_collection_interval_ms() const { return 0; }
+  virtual bool needs_periodic_collection()             { return false; }
+  virtual void do_periodic_collection()                { }
+
   // Perform any cleanup actions necessary before allowing a verification.
   virtual void prepare_for_verify() = 0;
 
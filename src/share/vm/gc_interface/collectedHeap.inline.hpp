@@ -188,6 +188,13 @@ HeapWord* CollectedHeap::allocate_from_tlab(KlassHandle klass, Thread* thread, s
   return allocate_from_tlab_slow(klass, thread, size);
 }
 
+inline oop CollectedHeap::sample_allocation(oop obj, int size, Thread* thread) {
+  if (ThreadHeapSampler::enabled()) {
+    return sample_allocation_slow(obj, size, thread);
+  }
+  return obj;
+}
+
 void CollectedHeap::init_obj(HeapWord* obj, size_t size) {
   assert(obj != NULL, "cannot initialize NULL object");
   const size_t hs = oopDesc::header_size();
@@ -203,7 +210,7 @@ oop CollectedHeap::obj_allocate(KlassHandle klass, int size, TRAPS) {
   HeapWord* obj = common_mem_allocate_init(klass, size, CHECK_NULL);
   post_allocation_setup_obj(klass, obj, size);
   NOT_PRODUCT(Universe::heap()->check_for_bad_heap_word_value(obj, size));
-  return (oop)obj;
+  return sample_allocation((oop)obj, size, THREAD);
 }
 
 oop CollectedHeap::array_allocate(KlassHandle klass,
@@ -216,7 +223,7 @@ oop CollectedHeap::array_allocate(KlassHandle klass,
   HeapWord* obj = common_mem_allocate_init(klass, size, CHECK_NULL);
   post_allocation_setup_array(klass, obj, length);
   NOT_PRODUCT(Universe::heap()->check_for_bad_heap_word_value(obj, size));
-  return (oop)obj;
+  return sample_allocation((oop)obj, size, THREAD);
 }
 
 oop CollectedHeap::array_allocate_nozero(KlassHandle klass,
@@ -233,7 +240,7 @@ oop CollectedHeap::array_allocate_nozero(KlassHandle klass,
   const size_t hs = oopDesc::header_size()+1;
   Universe::heap()->check_for_non_bad_heap_word_value(obj+hs, size-hs);
 #endif
-  return (oop)obj;
+  return sample_allocation((oop)obj, size, THREAD);
 }
 
 inline void CollectedHeap::oop_iterate_no_header(OopClosure* cl) {
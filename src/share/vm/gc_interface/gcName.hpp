@@ -37,6 +37,7 @@ enum GCName {
   G1New,
   ConcurrentMarkSweep,
   G1Old,
+  Epsilon,
   GCNameEndSentinel
 };
 
@@ -53,6 +54,7 @@ class GCNameHelper {
       case G1New: return "G1New";
       case ConcurrentMarkSweep: return "ConcurrentMarkSweep";
       case G1Old: return "G1Old";
+      case Epsilon: return "Epsilon";
       default: ShouldNotReachHere(); return NULL;
     }
   }
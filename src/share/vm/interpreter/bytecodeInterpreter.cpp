@@ -388,6 +388,13 @@
         }                                                                                        \
         VERIFY_OOP(obj_)
 
+/*
+ * REWRITE_AT_PC - Quicken the bytecode at pc. Callers check RewriteBytecodes
+ * (off when the bytecodes live in the read-only shared archive) and that pc
+ * does not hold a breakpoint.
+ */
+#define REWRITE_AT_PC(val) *pc = (jubyte) (val);
+
 #define VMdoubleConstZero() 0.0
 #define VMdoubleConstOne() 1.0
 #define VMlongConstZero() (max_jlong-max_jlong)
@@ -434,6 +441,38 @@
           if (THREAD->has_pending_exception()) goto label;         \
         }
 
+// Quickened forms of non-volatile getfield/putfield, the same ones
+// TemplateTable::patch_bytecode produces for the template interpreter.
+static Bytecodes::Code fast_get_code(TosState tos_type) {
+  switch (tos_type) {
+    case btos:
+    case ztos: return Bytecodes::_fast_bgetfield;
+    case ctos: return Bytecodes::_fast_cgetfield;
+    case stos: return Bytecodes::_fast_sgetfield;
+    case itos: return Bytecodes::_fast_igetfield;
+    case ltos: return Bytecodes::_fast_lgetfield;
+    case ftos: return Bytecodes::_fast_fgetfield;
+    case dtos: return Bytecodes::_fast_dgetfield;
+    case atos: return Bytecodes::_fast_agetfield;
+    default:   ShouldNotReachHere(); return Bytecodes::_illegal;
+  }
+}
+
+static Bytecodes::Code fast_put_code(TosState tos_type) {
+  switch (tos_type) {
+    case btos: return Bytecodes::_fast_bputfield;
+    case ztos: return Bytecodes::_fast_zputfield;
+    case ctos: return Bytecodes::_fast_cputfield;
+    case stos: return Bytecodes::_fast_sputfield;
+    case itos: return Bytecodes::_fast_iputfield;
+    case ltos: return Bytecodes::_fast_lputfield;
+    case ftos: return Bytecodes::_fast_fputfield;
+    case dtos: return Bytecodes::_fast_dputfield;
+    case atos: return Bytecodes::_fast_aputfield;
+    default:   ShouldNotReachHere(); return Bytecodes::_illegal;
+  }
+}
+
 /*
  * BytecodeInterpreter::run(interpreterState istate)
  * BytecodeInterpreter::runWithChecks(interpreterState istate)
@@ -584,18 +623,26 @@ BytecodeInterpreter::run(interpreterState istate) {
 
 /* 0xC0 */ &&opc_checkcast,   &&opc_instanceof,     &&opc_monitorenter, &&opc_monitorexit,
 /* 0xC4 */ &&opc_wide,        &&opc_multianewarray, &&opc_ifnull,       &&opc_ifnonnull,
-/* 0xC8 */ &&opc_goto_w,      &&opc_jsr_w,          &&opc_breakpoint,   &&opc_default,
-/* 0xCC */ &&opc_default,     &&opc_default,        &&opc_default,      &&opc_default,
-
-/* 0xD0 */ &&opc_default,     &&opc_default,        &&opc_default,      &&opc_default,
-/* 0xD4 */ &&opc_default,     &&opc_default,        &&opc_default,      &&opc_default,
-/* 0xD8 */ &&opc_default,     &&opc_default,        &&opc_default,      &&opc_default,
+/* 0xC8 */ &&opc_goto_w,      &&opc_jsr_w,          &&opc_breakpoint,   &&opc_fast_agetfield,
+/* 0xCC */ &&opc_fast_bgetfield,
+                              &&opc_fast_cgetfield, &&opc_fast_dgetfield,
+                                                                        &&opc_fast_fgetfield,
+
+/* 0xD0 */ &&opc_fast_igetfield,
+                              &&opc_fast_lgetfield, &&opc_fast_sgetfield,
+                                                                        &&opc_fast_aputfield,
+/* 0xD4 */ &&opc_fast_bputfield,
+                              &&opc_fast_zputfield, &&opc_fast_cputfield,
+                                                                        &&opc_fast_dputfield,
+/* 0xD8 */ &&opc_fast_fputfield,
+                              &&opc_fast_iputfield, &&opc_fast_lputfield,
+                                                                        &&opc_fast_sputfield,
 /* 0xDC */ &&opc_default,     &&opc_default,        &&opc_default,      &&opc_default,
 
 /* 0xE0 */ &&opc_default,     &&opc_default,        &&opc_default,      &&opc_default,
-/* 0xE4 */ &&opc_default,     &&opc_default,        &&opc_fast_aldc,    &&opc_fast_aldc_w,
-/* 0xE8 */ &&opc_return_register_finalizer,
-                              &&opc_invokehandle,   &&opc_default,      &&opc_default,
+/* 0xE4 */ &&opc_default,     &&opc_default,        &&opc_default,      &&opc_fast_aldc,
+/* 0xE8 */ &&opc_fast_aldc_w, &&opc_return_register_finalizer,
+                                                    &&opc_invokehandle, &&opc_default,
 /* 0xEC */ &&opc_default,     &&opc_default,        &&opc_default,      &&opc_default,
 
 /* 0xF0 */ &&opc_default,     &&opc_default,        &&opc_default,      &&opc_default,
@@ -2005,6 +2052,9 @@ run:
           } else {
             obj = (oop) STACK_OBJECT(-1);
             CHECK_NULL(obj);
+            if (RewriteBytecodes && !cache->is_volatile() && *pc == Bytecodes::_getfield) {
+              REWRITE_AT_PC(fast_get_code(cache->flag_state()));
+            }
           }
 
           //
@@ -2120,6 +2170,9 @@ run:
             --count;
             obj = (oop) STACK_OBJECT(count);
             CHECK_NULL(obj);
+            if (RewriteBytecodes && !cache->is_volatile() && *pc == Bytecodes::_putfield) {
+              REWRITE_AT_PC(fast_put_code(tos_type));
+            }
           }
 
           //
@@ -2176,6 +2229,71 @@ run:
           UPDATE_PC_AND_TOS_AND_CONTINUE(3, count);
         }
 
+      /* Quickened non-volatile instance field accesses. The cp cache entry
+       * was resolved by the getfield/putfield that rewrote the bytecode.
+       */
+#ifdef VM_JVMTI
+#define POST_FAST_FIELD_ACCESS(cache)                                           \
+          if (_jvmti_interp_events &&                                           \
+              *(int*)JvmtiExport::get_field_access_count_addr() > 0) {          \
+            CALL_VM(InterpreterRuntime::post_field_access(THREAD,               \
+                                        STACK_OBJECT(-1), cache),               \
+                                        handle_exception);                      \
+          }
+#define POST_FAST_FIELD_MODIFICATION(cache, obj_offset)                         \
+          if (_jvmti_interp_events &&                                           \
+              *(int*)JvmtiExport::get_field_modification_count_addr() > 0) {    \
+            CALL_VM(InterpreterRuntime::post_field_modification(THREAD,         \
+                                        STACK_OBJECT(obj_offset), cache,        \
+                                        (jvalue *)STACK_SLOT(-1)),              \
+                                        handle_exception);                      \
+          }
+#else
+#define POST_FAST_FIELD_ACCESS(cache)
+#define POST_FAST_FIELD_MODIFICATION(cache, obj_offset)
+#endif /* VM_JVMTI */
+
+#undef  OPC_FAST_GETFIELD
+#define OPC_FAST_GETFIELD(opcname, field, set_stack, offset, stack)             \
+      CASE(opcname): {                                                          \
+          ConstantPoolCacheEntry* cache = cp->entry_at(Bytes::get_native_u2(pc+1)); \
+          POST_FAST_FIELD_ACCESS(cache);                                        \
+          oop obj = STACK_OBJECT(-1);                                           \
+          CHECK_NULL(obj);                                                      \
+          set_stack(obj->field(cache->f2_as_index()), offset);                  \
+          UPDATE_PC_AND_TOS_AND_CONTINUE(3, stack);                             \
+      }
+
+      OPC_FAST_GETFIELD(_fast_agetfield, obj_field,    SET_STACK_OBJECT, -1, 0);
+      OPC_FAST_GETFIELD(_fast_bgetfield, byte_field,   SET_STACK_INT,    -1, 0);
+      OPC_FAST_GETFIELD(_fast_cgetfield, char_field,   SET_STACK_INT,    -1, 0);
+      OPC_FAST_GETFIELD(_fast_sgetfield, short_field,  SET_STACK_INT,    -1, 0);
+      OPC_FAST_GETFIELD(_fast_igetfield, int_field,    SET_STACK_INT,    -1, 0);
+      OPC_FAST_GETFIELD(_fast_fgetfield, float_field,  SET_STACK_FLOAT,  -1, 0);
+      OPC_FAST_GETFIELD(_fast_lgetfield, long_field,   SET_STACK_LONG,    0, 1);
+      OPC_FAST_GETFIELD(_fast_dgetfield, double_field, SET_STACK_DOUBLE,  0, 1);
+
+#undef  OPC_FAST_PUTFIELD
+#define OPC_FAST_PUTFIELD(opcname, field_put, value, slots)                     \
+      CASE(opcname): {                                                          \
+          ConstantPoolCacheEntry* cache = cp->entry_at(Bytes::get_native_u2(pc+1)); \
+          POST_FAST_FIELD_MODIFICATION(cache, -(slots) - 1);                    \
+          oop obj = STACK_OBJECT(-(slots) - 1);                                 \
+          CHECK_NULL(obj);                                                      \
+          obj->field_put(cache->f2_as_index(), value);                          \
+          UPDATE_PC_AND_TOS_AND_CONTINUE(3, -(slots) - 1);                      \
+      }
+
+      OPC_FAST_PUTFIELD(_fast_aputfield, obj_field_put,    STACK_OBJECT(-1),    1);
+      OPC_FAST_PUTFIELD(_fast_bputfield, byte_field_put,   STACK_INT(-1),       1);
+      OPC_FAST_PUTFIELD(_fast_zputfield, byte_field_put,   (STACK_INT(-1) & 1), 1);
+      OPC_FAST_PUTFIELD(_fast_cputfield, char_field_put,   STACK_INT(-1),       1);
+      OPC_FAST_PUTFIELD(_fast_sputfield, short_field_put,  STACK_INT(-1),       1);
+      OPC_FAST_PUTFIELD(_fast_iputfield, int_field_put,    STACK_INT(-1),       1);
+      OPC_FAST_PUTFIELD(_fast_fputfield, float_field_put,  STACK_FLOAT(-1),     1);
+      OPC_FAST_PUTFIELD(_fast_lputfield, long_field_put,   STACK_LONG(-1),      2);
+      OPC_FAST_PUTFIELD(_fast_dputfield, double_field_put, STACK_DOUBLE(-1),    2);
+
       CASE(_new): {
         u2 index = Bytes::get_Java_u2(pc+1);
         ConstantPool* constants = istate->method()->constants();
@@ -2196,9 +2314,10 @@ run:
             }
             // Disable non-TLAB-based fast-path, because profiling requires that all
             // allocations go through InterpreterRuntime::_new() if THREAD->tlab().allocate
-            // returns NULL.
+            // returns NULL. The same holds for heap sampling, which lowers the end
+            // of the TLAB to catch the allocation crossing the next sampling point.
 #ifndef CC_INTERP_PROFILE
-            if (result == NULL) {
+            if (result == NULL && !ThreadHeapSampler::enabled()) {
               need_zero = true;
               // Try allocate in shared eden
             retry:
@@ -1620,6 +1620,41 @@ static void wrap_invokedynamic_exception(TRAPS) {
   }
 }
 
+// True if the bootstrap method is LambdaMetafactory.metafactory, whose call
+// sites for the same constant pool entry all link to equivalent targets.
+static bool is_lambda_metafactory(Handle bootstrap_specifier) {
+  oop bsm = bootstrap_specifier();
+  if (bsm->is_objArray()) {
+    bsm = objArrayOop(bsm)->obj_at(0);
+  }
+  if (!java_lang_invoke_DirectMethodHandle::is_instance(bsm)) {
+    return false;
+  }
+  Metadata* target = java_lang_invoke_MemberName::vmtarget(java_lang_invoke_DirectMethodHandle::member(bsm));
+  if (target == NULL || !target->is_method()) {
+    return false;
+  }
+  Method* m = (Method*)target;
+  return m->name() == vmSymbols::metafactory_name() &&
+         m->method_holder()->name() == vmSymbols::java_lang_invoke_LambdaMetafactory() &&
+         m->method_holder()->class_loader() == NULL;
+}
+
+// Returns another linked call site of the same CONSTANT_InvokeDynamic
+static ConstantPoolCacheEntry* find_linked_call_site(constantPoolHandle pool,
+                                                     ConstantPoolCacheEntry* cpce) {
+  ConstantPoolCache* cache = pool->cache();
+  int pool_index = cpce->constant_pool_index();
+  for (int i = 0; i < cache->length(); i++) {
+    ConstantPoolCacheEntry* e = cache->entry_at(i);
+    if (e != cpce && e->constant_pool_index() == pool_index &&
+        e->is_resolved(Bytecodes::_invokedynamic) && !e->is_f1_null()) {
+      return e;
+    }
+  }
+  return NULL;
+}
+
 void LinkResolver::resolve_invokedynamic(CallInfo& result, constantPoolHandle pool, int index, TRAPS) {
   assert(EnableInvokeDynamic, "");
 
@@ -1657,6 +1692,21 @@ void LinkResolver::resolve_invokedynamic(CallInfo& result, constantPoolHandle po
     tty->print("  BSM info: "); bootstrap_specifier->print();
   }
 
+  if (ShareLambdaCallSites && is_lambda_metafactory(bootstrap_specifier)) {
+    ConstantPoolCacheEntry* linked = find_linked_call_site(pool, cpce);
+    if (linked != NULL) {
+      if (TraceMethodHandles) {
+        tty->print_cr("  shared with a linked call site");
+      }
+      methodHandle method(     THREAD, linked->f1_as_method());
+      Handle       appendix(   THREAD, linked->appendix_if_resolved(pool));
+      Handle       method_type(THREAD, linked->method_type_if_resolved(pool));
+      result.set_handle(method, appendix, method_type, THREAD);
+      wrap_invokedynamic_exception(CHECK);
+      return;
+    }
+  }
+
   resolve_dynamic_call(result, bootstrap_specifier, method_name, method_signature, current_klass, CHECK);
 }
 
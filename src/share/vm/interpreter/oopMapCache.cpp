@@ -466,9 +466,14 @@ void InterpreterOopMap::resource_copy(OopMapCacheEntry* from) {
 }
 
 inline unsigned int OopMapCache::hash_value_for(methodHandle method, int bci) const {
-  // We use method->code_size() rather than method->identity_hash() below since
-  // the mark may not be present if a pointer to the method is already reversed.
+  // Methods live in metaspace and are never moved, so their address is a
+  // stable discriminator. Without it, methods of the same shape (accessors
+  // and other small methods are common) all hash to the same bucket and
+  // keep evicting each other's entries during stack scanning.
+  uintptr_t m = (uintptr_t) method();
   return   ((unsigned int) bci)
+         ^ ((unsigned int) (m >> LogBytesPerWord))
+         ^ ((unsigned int) (m >> (LogBytesPerWord + 8)))
          ^ ((unsigned int) method->max_locals()         << 2)
          ^ ((unsigned int) method->code_size()          << 4)
          ^ ((unsigned int) method->size_of_parameters() << 6);
@@ -476,6 +481,7 @@ inline unsigned int OopMapCache::hash_value_for(methodHandle method, int bci) co
 
 
 OopMapCache::OopMapCache() :
+  _size((int) OopMapCacheSize),
   _mut(Mutex::leaf, "An OopMapCache lock", true)
 {
   _array  = NEW_C_HEAP_ARRAY(OopMapCacheEntry, _size, mtClass);
@@ -496,7 +502,7 @@ OopMapCache::~OopMapCache() {
 }
 
 OopMapCacheEntry* OopMapCache::entry_at(int i) const {
-  return &_array[i % _size];
+  return &_array[(unsigned int) i % _size];
 }
 
 void OopMapCache::flush() {
@@ -148,11 +148,11 @@ class InterpreterOopMap: ResourceObj {
 
 class OopMapCache : public CHeapObj<mtClass> {
  private:
-  enum { _size        = 32,     // Use fixed size for now
-         _probe_depth = 3       // probe depth in case of collisions
+  enum { _probe_depth = 3       // probe depth in case of collisions
   };
 
   OopMapCacheEntry* _array;
+  const int         _size;      // number of entries, see OopMapCacheSize
 
   unsigned int hash_value_for(methodHandle method, int bci) const;
   OopMapCacheEntry* entry_at(int i) const;
@@ -148,6 +148,7 @@ class TemplateTable: AllStatic {
   static void fast_iload();
   static void fast_iload2();
   static void fast_icaload();
+  static void fast_iload2_iadd();
   static void lload();
   static void fload();
   static void dload();
@@ -29,10 +29,11 @@
 #include "memory/metaspaceShared.hpp"
 #include "memory/resourceArea.hpp"
 #include "memory/universe.hpp"
-#include "runtime/atomic.hpp"
+#include "runtime/atomic.inline.hpp"
 #include "runtime/os.hpp"
 #include "runtime/task.hpp"
-#include "runtime/threadCritical.hpp"
+#include "runtime/thread.hpp"
+#include "runtime/threadLocalStorage.hpp"
 #include "services/memTracker.hpp"
 #include "utilities/ostream.hpp"
 
@@ -231,42 +232,59 @@ void trace_heap_free(void* p) {
 
 // MT-safe pool of chunks to reduce malloc/free thrashing
 // NB: not using Mutex because pools are used before Threads are initialized
+//
+// Chunks are pushed with a CAS and popped under a per-pool spin lock. With a
+// single remover at a time a popped chunk cannot be pushed back while
+// another pop is in progress, so the list has no ABA problem. Compiler and
+// GC threads additionally keep one chunk of each small size for themselves.
 class ChunkPool: public CHeapObj<mtInternal> {
-  Chunk*       _first;        // first cached Chunk; its first word points to next chunk
-  size_t       _num_chunks;   // number of unused chunks in pool
-  size_t       _num_used;     // number of chunks currently checked out
-  const size_t _size;         // size of each chunk (must be uniform)
+  Chunk* volatile   _first;      // first cached Chunk; its first word points to next chunk
+  volatile intptr_t _num_chunks; // number of unused chunks in pool
+  intptr_t          _low_water;  // fewest unused chunks since the last clean()
+  volatile int      _pop_lock;   // serializes removals from the list
+  const size_t      _size;       // size of each chunk (must be uniform)
 
-  // Our four static pools
-  static ChunkPool* _large_pool;
-  static ChunkPool* _medium_pool;
-  static ChunkPool* _small_pool;
-  static ChunkPool* _tiny_pool;
+  // Our static pools, one per pooled Chunk length
+  static ChunkPool* _pools[Chunk::pool_sizes];
 
   // return first element or null
-  void* get_first() {
-    Chunk* c = _first;
-    if (_first) {
-      _first = _first->next();
-      _num_chunks--;
+  Chunk* get_first() {
+    Thread::SpinAcquire(&_pop_lock, "ChunkPool");
+    Chunk* c;
+    do {
+      c = _first;
+    } while (c != NULL && Atomic::cmpxchg_ptr(c->next(), &_first, c) != c);
+    if (c != NULL) {
+      intptr_t n = Atomic::add_ptr(-1, &_num_chunks);
+      if (n < _low_water) {
+        _low_water = n;
+      }
     }
+    Thread::SpinRelease(&_pop_lock);
     return c;
   }
 
+  // The calling thread's cache slot for chunks of the given pool, or NULL
+  // if the thread does not cache chunks of that size.
+  static Chunk** thread_cache_slot(int index) {
+    if (index >= Chunk::thread_cached_sizes || !ThreadLocalStorage::is_initialized()) {
+      return NULL;
+    }
+    Thread* thread = ThreadLocalStorage::thread();
+    if (thread == NULL || !(thread->is_Compiler_thread() || thread->is_Named_thread())) {
+      return NULL;
+    }
+    return thread->chunk_cache_slot(index);
+  }
+
  public:
   // All chunks in a ChunkPool has the same size
-   ChunkPool(size_t size) : _size(size) { _first = NULL; _num_chunks = _num_used = 0; }
+   ChunkPool(size_t size) : _first(NULL), _num_chunks(0), _low_water(0), _pop_lock(0), _size(size) {}
 
   // Allocate a new chunk from the pool (might expand the pool)
   _NOINLINE_ void* allocate(size_t bytes, AllocFailType alloc_failmode) {
     assert(bytes == _size, "bad size");
-    void* p = NULL;
-    // No VM lock can be taken inside ThreadCritical lock, so os::malloc
-    // should be done outside ThreadCritical lock due to NMT
-    { ThreadCritical tc;
-      _num_used++;
-      p = get_first();
-    }
+    void* p = get_first();
     if (p == NULL) p = os::malloc(bytes, mtChunk, CURRENT_PC);
     if (p == NULL && alloc_failmode == AllocFailStrategy::EXIT_OOM) {
       vm_exit_out_of_memory(bytes, OOM_MALLOC_ERROR, "ChunkPool::allocate");
@@ -277,72 +295,114 @@ class ChunkPool: public CHeapObj<mtInternal> {
   // Return a chunk to the pool
   void free(Chunk* chunk) {
     assert(chunk->length() + Chunk::aligned_overhead_size() == _size, "bad size");
-    ThreadCritical tc;
-    _num_used--;
-
-    // Add chunk to list
-    chunk->set_next(_first);
-    _first = chunk;
-    _num_chunks++;
+    Chunk* old;
+    do {
+      old = _first;
+      chunk->set_next(old);
+    } while (Atomic::cmpxchg_ptr(chunk, &_first, old) != old);
+    Atomic::add_ptr(1, &_num_chunks);
   }
 
-  // Prune the pool
-  void free_all_but(size_t n) {
+  // Prune the pool. Chunks that stayed unused since the last call are not
+  // needed by the current workload, release half of them but keep at
+  // least n chunks.
+  void trim(intptr_t n) {
     Chunk* cur = NULL;
-    Chunk* next;
     {
-    // if we have more than n chunks, free all of them
-    ThreadCritical tc;
-    if (_num_chunks > n) {
-      // free chunks at end of queue, for better locality
-        cur = _first;
-      for (size_t i = 0; i < (n - 1) && cur != NULL; i++) cur = cur->next();
-
-      if (cur != NULL) {
-          next = cur->next();
-        cur->set_next(NULL);
-        cur = next;
-
-          _num_chunks = n;
-        }
+      Thread::SpinAcquire(&_pop_lock, "ChunkPool");
+      intptr_t surplus = MIN2(_low_water - _low_water / 2, _num_chunks - n);
+      while (surplus-- > 0) {
+        // pops are ours while holding the lock
+        Chunk* c;
+        do {
+          c = _first;
+        } while (c != NULL && Atomic::cmpxchg_ptr(c->next(), &_first, c) != c);
+        if (c == NULL) break;
+        Atomic::add_ptr(-1, &_num_chunks);
+        c->set_next(cur);
+        cur = c;
       }
+      _low_water = _num_chunks;
+      Thread::SpinRelease(&_pop_lock);
     }
 
-    // Free all remaining chunks, outside of ThreadCritical
-    // to avoid deadlock with NMT
-        while(cur != NULL) {
-          next = cur->next();
+    // Free the removed chunks outside of the lock
+    while (cur != NULL) {
+      Chunk* next = cur->next();
       os::free(cur, mtChunk);
-          cur = next;
-        }
-      }
+      cur = next;
+    }
+  }
+
+  // Index of the pool for chunks of the given length, -1 if not pooled
+  static int index_for(size_t length) {
+    switch (length) {
+     case Chunk::tiny_size:   return 0;
+     case Chunk::init_size:   return 1;
+     case Chunk::medium_size: return 2;
+     case Chunk::size:        return 3;
+     case Chunk::size_x2:     return 4;
+     case Chunk::size_x4:     return 5;
+     case Chunk::size_x8:     return 6;
+     default:                 return -1;
+    }
+  }
+
+  static ChunkPool* pool(int index) {
+    assert(_pools[index] != NULL, "must be initialized");
+    return _pools[index];
+  }
 
-  // Accessors to preallocated pool's
-  static ChunkPool* large_pool()  { assert(_large_pool  != NULL, "must be initialized"); return _large_pool;  }
-  static ChunkPool* medium_pool() { assert(_medium_pool != NULL, "must be initialized"); return _medium_pool; }
-  static ChunkPool* small_pool()  { assert(_small_pool  != NULL, "must be initialized"); return _small_pool;  }
-  static ChunkPool* tiny_pool()   { assert(_tiny_pool   != NULL, "must be initialized"); return _tiny_pool;   }
+  // Allocate a chunk of a pooled length, from the calling thread's cache if possible
+  static void* allocate_chunk(int index, size_t bytes, AllocFailType alloc_failmode) {
+    Chunk** slot = thread_cache_slot(index);
+    if (slot != NULL && *slot != NULL) {
+      Chunk* c = *slot;
+      *slot = NULL;
+      return c;
+    }
+    return pool(index)->allocate(bytes, alloc_failmode);
+  }
+
+  static void free_chunk(int index, Chunk* chunk) {
+    Chunk** slot = thread_cache_slot(index);
+    if (slot != NULL && *slot == NULL) {
+      *slot = chunk;
+      return;
+    }
+    pool(index)->free(chunk);
+  }
+
+  static void flush_thread_cache(Thread* thread) {
+    for (int i = 0; i < Chunk::thread_cached_sizes; i++) {
+      Chunk** slot = thread->chunk_cache_slot(i);
+      if (*slot != NULL) {
+        pool(i)->free(*slot);
+        *slot = NULL;
+      }
+    }
+  }
 
   static void initialize() {
-    _large_pool  = new ChunkPool(Chunk::size        + Chunk::aligned_overhead_size());
-    _medium_pool = new ChunkPool(Chunk::medium_size + Chunk::aligned_overhead_size());
-    _small_pool  = new ChunkPool(Chunk::init_size   + Chunk::aligned_overhead_size());
-    _tiny_pool   = new ChunkPool(Chunk::tiny_size   + Chunk::aligned_overhead_size());
+    const size_t lengths[Chunk::pool_sizes] = {
+      Chunk::tiny_size, Chunk::init_size, Chunk::medium_size, Chunk::size,
+      Chunk::size_x2, Chunk::size_x4, Chunk::size_x8
+    };
+    for (int i = 0; i < Chunk::pool_sizes; i++) {
+      assert(index_for(lengths[i]) == i, "pool order");
+      _pools[i] = new ChunkPool(lengths[i] + Chunk::aligned_overhead_size());
+    }
   }
 
   static void clean() {
     enum { BlocksToKeep = 5 };
-     _tiny_pool->free_all_but(BlocksToKeep);
-     _small_pool->free_all_but(BlocksToKeep);
-     _medium_pool->free_all_but(BlocksToKeep);
-     _large_pool->free_all_but(BlocksToKeep);
+    for (int i = 0; i < Chunk::pool_sizes; i++) {
+      _pools[i]->trim(BlocksToKeep);
+    }
   }
 };
 
-ChunkPool* ChunkPool::_large_pool  = NULL;
-ChunkPool* ChunkPool::_medium_pool = NULL;
-ChunkPool* ChunkPool::_small_pool  = NULL;
-ChunkPool* ChunkPool::_tiny_pool   = NULL;
+ChunkPool* ChunkPool::_pools[Chunk::pool_sizes] = { NULL };
 
 void chunkpool_init() {
   ChunkPool::initialize();
@@ -353,6 +413,10 @@ Chunk::clean_chunk_pool() {
   ChunkPool::clean();
 }
 
+void Chunk::flush_thread_cache(Thread* thread) {
+  ChunkPool::flush_thread_cache(thread);
+}
+
 
 //--------------------------------------------------------------------------------------
 // ChunkPoolCleaner implementation
@@ -378,29 +442,24 @@ void* Chunk::operator new (size_t requested_size, AllocFailType alloc_failmode,
   // expect requested_size but if sizeof(Chunk) doesn't match isn't proper size we must align it.
   assert(ARENA_ALIGN(requested_size) == aligned_overhead_size(), "Bad alignment");
   size_t bytes = ARENA_ALIGN(requested_size) + length;
-  switch (length) {
-   case Chunk::size:        return ChunkPool::large_pool()->allocate(bytes, alloc_failmode);
-   case Chunk::medium_size: return ChunkPool::medium_pool()->allocate(bytes, alloc_failmode);
-   case Chunk::init_size:   return ChunkPool::small_pool()->allocate(bytes, alloc_failmode);
-   case Chunk::tiny_size:   return ChunkPool::tiny_pool()->allocate(bytes, alloc_failmode);
-   default: {
-     void* p = os::malloc(bytes, mtChunk, CALLER_PC);
-     if (p == NULL && alloc_failmode == AllocFailStrategy::EXIT_OOM) {
-       vm_exit_out_of_memory(bytes, OOM_MALLOC_ERROR, "Chunk::new");
-     }
-     return p;
-   }
+  int index = ChunkPool::index_for(length);
+  if (index >= 0) {
+    return ChunkPool::allocate_chunk(index, bytes, alloc_failmode);
   }
+  void* p = os::malloc(bytes, mtChunk, CALLER_PC);
+  if (p == NULL && alloc_failmode == AllocFailStrategy::EXIT_OOM) {
+    vm_exit_out_of_memory(bytes, OOM_MALLOC_ERROR, "Chunk::new");
+  }
+  return p;
 }
 
 void Chunk::operator delete(void* p) {
   Chunk* c = (Chunk*)p;
-  switch (c->length()) {
-   case Chunk::size:        ChunkPool::large_pool()->free(c); break;
-   case Chunk::medium_size: ChunkPool::medium_pool()->free(c); break;
-   case Chunk::init_size:   ChunkPool::small_pool()->free(c); break;
-   case Chunk::tiny_size:   ChunkPool::tiny_pool()->free(c); break;
-   default:                 os::free(c, mtChunk);
+  int index = ChunkPool::index_for(c->length());
+  if (index >= 0) {
+    ChunkPool::free_chunk(index, c);
+  } else {
+    os::free(c, mtChunk);
   }
 }
 
@@ -552,8 +611,13 @@ void Arena::signal_out_of_memory(size_t sz, const char* whence) const {
 
 // Grow a new Chunk
 void* Arena::grow(size_t x, AllocFailType alloc_failmode) {
-  // Get minimal required size.  Either real big, or even bigger for giant objs
+  // Get minimal required size.  Either real big, or even bigger for giant objs.
+  // Sizes up to size_x8 are rounded up to a pooled chunk size.
   size_t len = MAX2(x, (size_t) Chunk::size);
+  if (len > Chunk::size && len <= Chunk::size_x8) {
+    len = len <= Chunk::size_x2 ? Chunk::size_x2 :
+          len <= Chunk::size_x4 ? Chunk::size_x4 : Chunk::size_x8;
+  }
 
   Chunk *k = _chunk;            // Get filled-up chunk address
   _chunk = new (alloc_failmode, len) Chunk(len);
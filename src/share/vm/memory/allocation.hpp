@@ -340,9 +340,17 @@ class Chunk: CHeapObj<mtChunk> {
     init_size  =  1*K  - slack, // Size of first chunk (normal aka small)
     medium_size= 10*K  - slack, // Size of medium-sized chunk
     size       = 32*K  - slack, // Default size of an Arena chunk (following the first)
+    size_x2    = 64*K  - slack, // Pooled sizes for chunks grown past the default size
+    size_x4    = 128*K - slack,
+    size_x8    = 256*K - slack,
     non_pool_size = init_size + 32 // An initial size which is not one of above
   };
 
+  enum {
+    pool_sizes          = 7,    // Number of pooled chunk sizes, tiny_size to size_x8
+    thread_cached_sizes = 4     // Chunk sizes up to size are also cached per thread
+  };
+
   void chop();                  // Chop this chunk
   void next_chop();             // Chop next chunk
   static size_t aligned_overhead_size(void) { return ARENA_ALIGN(sizeof(Chunk)); }
@@ -360,6 +368,9 @@ class Chunk: CHeapObj<mtChunk> {
   static void start_chunk_pool_cleaner_task();
 
   static void clean_chunk_pool();
+
+  // Return the chunks cached by a terminating thread to the pools
+  static void flush_thread_cache(Thread* thread);
 };
 
 //------------------------------Arena------------------------------------------
@@ -161,6 +161,14 @@ GenRemSet* CollectorPolicy::create_rem_set(MemRegion whole_heap,
   return new CardTableRS(whole_heap, max_covered_regions);
 }
 
+size_t CollectorPolicy::soft_max_heap_byte_size() {
+  size_t soft_max = SoftMaxHeapSize;
+  if (soft_max == 0) {
+    return _max_heap_byte_size;
+  }
+  return MAX2(MIN2(soft_max, _max_heap_byte_size), _min_heap_byte_size);
+}
+
 void CollectorPolicy::cleared_all_soft_refs() {
   // If near gc overhear limit, continue to clear SoftRefs.  SoftRefs may
   // have been cleared in the last collection but if the gc overhear
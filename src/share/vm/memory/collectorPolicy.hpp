@@ -112,6 +112,10 @@ class CollectorPolicy : public CHeapObj<mtGC> {
   size_t max_heap_byte_size()     { return _max_heap_byte_size; }
   size_t min_heap_byte_size()     { return _min_heap_byte_size; }
 
+  // The current SoftMaxHeapSize, bounded by the minimum and maximum heap
+  // sizes. The flag is manageable, so this may change between collections.
+  size_t soft_max_heap_byte_size();
+
   enum Name {
     CollectorPolicyKind,
     TwoGenerationCollectorPolicyKind,
@@ -46,6 +46,10 @@
 #include "runtime/thread.inline.hpp"
 #include "utilities/copy.hpp"
 #include "utilities/stack.inline.hpp"
+#include "utilities/workgroup.hpp"
+#if INCLUDE_ALL_GCS
+#include "gc_implementation/shared/edenZeroingThread.hpp"
+#endif // INCLUDE_ALL_GCS
 
 PRAGMA_FORMAT_MUTE_WARNINGS_FOR_GCC
 
@@ -187,6 +191,7 @@ DefNewGeneration::DefNewGeneration(ReservedSpace rs,
                                    const char* policy)
   : Generation(rs, initial_size, level),
     _promo_failure_drain_in_progress(false),
+    _eden_zeroer(NULL),
     _should_allocate_from_space(false)
 {
   MemRegion cmr((HeapWord*)_virtual_space.low(),
@@ -232,6 +237,12 @@ DefNewGeneration::DefNewGeneration(ReservedSpace rs,
   _pretenure_size_threshold_words = PretenureSizeThreshold >> LogHeapWordSize;
 
   _gc_timer = new (ResourceObj::C_HEAP, mtGC) STWGCTimer();
+
+#if INCLUDE_ALL_GCS
+  if (ZeroEdenConcurrently) {
+    _eden_zeroer = new EdenZeroingThread(eden(), _reserved);
+  }
+#endif // INCLUDE_ALL_GCS
 }
 
 void DefNewGeneration::compute_space_boundaries(uintx minimum_eden_size,
@@ -557,6 +568,113 @@ void DefNewGeneration::adjust_desired_tenuring_threshold() {
     age_table()->compute_tenuring_threshold(to()->capacity()/HeapWordSize);
 }
 
+// The fields of older generation objects that point into the young
+// generation, as found by one card scanning worker.
+class DefNewYoungRefsBuffer {
+  Stack<oop*, mtGC>       _oop_fields;
+  Stack<narrowOop*, mtGC> _narrow_oop_fields;
+
+ public:
+  void record(oop* p)       { _oop_fields.push(p); }
+  void record(narrowOop* p) { _narrow_oop_fields.push(p); }
+
+  // Apply "cl" to the recorded fields and release the stacks.
+  void apply_recorded(OopsInGenClosure* cl) {
+    while (!_oop_fields.is_empty()) {
+      cl->do_oop(_oop_fields.pop());
+    }
+    while (!_narrow_oop_fields.is_empty()) {
+      cl->do_oop(_narrow_oop_fields.pop());
+    }
+    _oop_fields.clear(true);
+    _narrow_oop_fields.clear(true);
+  }
+};
+
+class DefNewRecordYoungRefsClosure: public OopsInGenClosure {
+  HeapWord*              _boundary;
+  DefNewYoungRefsBuffer* _buffer;
+
+  template <class T> void do_oop_work(T* p) {
+    T heap_oop = oopDesc::load_heap_oop(p);
+    if (!oopDesc::is_null(heap_oop) &&
+        (HeapWord*)oopDesc::decode_heap_oop_not_null(heap_oop) < _boundary) {
+      _buffer->record(p);
+    }
+  }
+
+ public:
+  DefNewRecordYoungRefsClosure(DefNewGeneration* g,
+                               DefNewYoungRefsBuffer* buffer) :
+    OopsInGenClosure(g), _boundary(g->reserved().end()), _buffer(buffer) { }
+
+  virtual void do_oop(oop* p)       { do_oop_work(p); }
+  virtual void do_oop(narrowOop* p) { do_oop_work(p); }
+};
+
+class DefNewCardScanTask: public AbstractGangTask {
+  DefNewGeneration*      _gen;
+  Generation*            _old_gen;
+  DefNewYoungRefsBuffer* _buffers;
+
+ public:
+  DefNewCardScanTask(DefNewGeneration* gen, Generation* old_gen,
+                     DefNewYoungRefsBuffer* buffers) :
+    AbstractGangTask("DefNewGeneration card scanning"),
+    _gen(gen), _old_gen(old_gen), _buffers(buffers) { }
+
+  virtual void work(uint worker_id) {
+    DefNewRecordYoungRefsClosure cl(_gen, &_buffers[worker_id]);
+    cl.set_generation(_old_gen);
+    GenCollectedHeap::heap()->rem_set()->younger_refs_iterate(_old_gen, &cl);
+    cl.reset_generation();
+  }
+};
+
+bool DefNewGeneration::use_par_card_scanning() const {
+#if INCLUDE_ALL_GCS
+  GenCollectedHeap* gch = GenCollectedHeap::heap();
+  return DefNewParallelScanThreads > 1 &&
+         gch->workers() != NULL &&
+         gch->n_gens() == 2 &&
+         _next_gen->kind() == Generation::MarkSweepCompact;
+#else  // INCLUDE_ALL_GCS
+  return false;
+#endif // INCLUDE_ALL_GCS
+}
+
+void DefNewGeneration::par_younger_refs_iterate(OopsInGenClosure* cl) {
+  GenCollectedHeap* gch = GenCollectedHeap::heap();
+  FlexibleWorkGang* workers = gch->workers();
+  // The gang was sized from DefNewParallelScanThreads, unless
+  // ParallelGCThreads was given explicitly.
+  uint n_workers = workers->active_workers();
+
+  ResourceMark rm;
+  DefNewYoungRefsBuffer* buffers =
+    NEW_RESOURCE_ARRAY(DefNewYoungRefsBuffer, n_workers);
+  for (uint i = 0; i < n_workers; i++) {
+    new (buffers + i) DefNewYoungRefsBuffer();
+  }
+
+  // The workers clean the cards with the parallel protocol, so use a
+  // parallel youngergen value while they run.  Nothing dirties cards
+  // until the recorded fields are processed below, which happens
+  // serially and therefore with the sequential value.
+  gch->rem_set()->prepare_for_younger_refs_iterate(true);
+  DefNewCardScanTask tsk(this, _next_gen, buffers);
+  gch->set_par_threads(n_workers);
+  workers->run_task(&tsk);
+  gch->set_par_threads(0);
+  gch->rem_set()->prepare_for_younger_refs_iterate(false);
+
+  cl->set_generation(_next_gen);
+  for (uint i = 0; i < n_workers; i++) {
+    buffers[i].apply_recorded(cl);
+  }
+  cl->reset_generation();
+}
+
 void DefNewGeneration::collect(bool   full,
                                bool   clear_all_soft_refs,
                                size_t size,
@@ -625,6 +743,11 @@ void DefNewGeneration::collect(bool   full,
   assert(gch->no_allocs_since_save_marks(0),
          "save marks have not been newly set.");
 
+  bool par_card_scanning = use_par_card_scanning();
+  if (par_card_scanning) {
+    par_younger_refs_iterate(&fsc_with_gc_barrier);
+  }
+
   gch->gen_process_roots(_level,
                          true,  // Process younger gens, if any,
                                 // as strong roots.
@@ -632,7 +755,7 @@ void DefNewGeneration::collect(bool   full,
                          GenCollectedHeap::SO_ScavengeCodeCache,
                          GenCollectedHeap::StrongAndWeakRoots,
                          &fsc_with_no_gc_barrier,
-                         &fsc_with_gc_barrier,
+                         par_card_scanning ? NULL : &fsc_with_gc_barrier,
                          &cld_scan_closure);
 
   // "evacuate followers".
@@ -717,13 +840,6 @@ void DefNewGeneration::collect(bool   full,
   gc_tracer.report_gc_end(_gc_timer->gc_end(), _gc_timer->time_partitions());
 }
 
-class RemoveForwardPointerClosure: public ObjectClosure {
-public:
-  void do_object(oop obj) {
-    obj->init_mark();
-  }
-};
-
 void DefNewGeneration::init_assuming_no_promotion_failure() {
   _promotion_failed = false;
   _promotion_failed_info.reset();
@@ -735,6 +851,10 @@ void DefNewGeneration::remove_forwarding_pointers() {
   eden()->object_iterate(&rspc);
   from()->object_iterate(&rspc);
 
+  restore_preserved_marks();
+}
+
+void DefNewGeneration::restore_preserved_marks() {
   // Now restore saved marks, if any.
   assert(_objs_with_preserved_marks.size() == _preserved_marks_of_objs.size(),
          "should be the same");
@@ -788,7 +908,8 @@ oop DefNewGeneration::copy_to_survivor_space(oop old) {
   oop obj = NULL;
 
   // Try allocating obj in to-space (unless too old)
-  if (old->age() < tenuring_threshold()) {
+  uint age = old->age();
+  if (age < tenuring_threshold_for(old, age, s)) {
     obj = (oop) to()->allocate_aligned(s);
   }
 
@@ -974,6 +1095,12 @@ void DefNewGeneration::gc_epilogue(bool full) {
   // update the generation and space performance counters
   update_counters();
   gch->collector_policy()->counters()->update_counters();
+
+#if INCLUDE_ALL_GCS
+  if (_eden_zeroer != NULL) {
+    _eden_zeroer->resume();
+  }
+#endif // INCLUDE_ALL_GCS
 }
 
 void DefNewGeneration::record_spaces_top() {
@@ -1035,6 +1162,7 @@ HeapWord* DefNewGeneration::allocate(size_t word_size,
     if (CMSEdenChunksRecordAlways && _next_gen != NULL) {
       _next_gen->sample_eden_chunk();
     }
+    claim_allocation(result, word_size, is_tlab);
     return result;
   }
   do {
@@ -1068,6 +1196,7 @@ HeapWord* DefNewGeneration::allocate(size_t word_size,
   } else if (CMSEdenChunksRecordAlways && _next_gen != NULL) {
     _next_gen->sample_eden_chunk();
   }
+  claim_allocation(result, word_size, is_tlab);
   return result;
 }
 
@@ -1077,12 +1206,32 @@ HeapWord* DefNewGeneration::par_allocate(size_t word_size,
   if (CMSEdenChunksRecordAlways && _next_gen != NULL) {
     _next_gen->sample_eden_chunk();
   }
+  claim_allocation(res, word_size, is_tlab);
   return res;
 }
 
+void DefNewGeneration::claim_allocation(HeapWord* obj, size_t word_size,
+                                        bool is_tlab) {
+#if INCLUDE_ALL_GCS
+  if (_eden_zeroer != NULL && obj != NULL) {
+    if (eden()->is_in_reserved(obj)) {
+      _eden_zeroer->claim(obj, word_size, is_tlab);
+    } else if (is_tlab) {
+      // From the from-space, see allocate_from_space().
+      Copy::zero_to_words(obj, word_size);
+    }
+  }
+#endif // INCLUDE_ALL_GCS
+}
+
 void DefNewGeneration::gc_prologue(bool full) {
   // Ensure that _end and _soft_end are the same in eden space.
   eden()->set_soft_end(eden()->end());
+#if INCLUDE_ALL_GCS
+  if (_eden_zeroer != NULL) {
+    _eden_zeroer->suspend();
+  }
+#endif // INCLUDE_ALL_GCS
 }
 
 size_t DefNewGeneration::tlab_capacity() const {
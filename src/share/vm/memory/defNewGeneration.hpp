@@ -33,10 +33,20 @@
 #include "utilities/stack.hpp"
 
 class EdenSpace;
+class EdenZeroingThread;
 class ContiguousSpace;
 class ScanClosure;
 class STWGCTimer;
 
+// Resets the mark word of every object in a young space, removing
+// the forwarding pointers left behind by a failed scavenge.
+class RemoveForwardPointerClosure: public ObjectClosure {
+public:
+  void do_object(oop obj) {
+    obj->init_mark();
+  }
+};
+
 // DefNewGeneration is a young generation containing eden, from- and
 // to-space.
 
@@ -85,6 +95,8 @@ protected:
   // the subsequent full collection will look at from-space objects:
   // therefore we must remove their forwarding pointers.
   void remove_forwarding_pointers();
+  // Restores the marks saved by preserve_mark() below.
+  void restore_preserved_marks();
 
   // Preserve the mark of "obj", if necessary, in preparation for its mark
   // word being overwritten with a self-forwarding-pointer.
@@ -96,6 +108,13 @@ protected:
   Stack<oop, mtGC>     _objs_with_preserved_marks;
   Stack<markOop, mtGC> _preserved_marks_of_objs;
 
+  // Parallel card scanning.  With DefNewParallelScanThreads > 1 the
+  // work gang scans the older generation's dirty cards and records the
+  // fields pointing into this generation; the VM thread then applies
+  // "cl" to them, since copying is not thread-safe.
+  bool use_par_card_scanning() const;
+  void par_younger_refs_iterate(OopsInGenClosure* cl);
+
   // Promotion failure handling
   ExtendedOopClosure *_promo_failure_scan_stack_closure;
   void set_promo_failure_scan_stack_closure(ExtendedOopClosure *scan_stack_closure) {
@@ -117,6 +136,11 @@ protected:
   size_t               _max_survivor_size;
 
   // Allocation support
+  EdenZeroingThread* _eden_zeroer;        // NULL unless ZeroEdenConcurrently
+  // Announce an allocation to the eden zeroing thread, and make sure
+  // that TLABs are handed out zeroed.
+  void claim_allocation(HeapWord* obj, size_t word_size, bool is_tlab);
+
   bool _should_allocate_from_space;
   bool should_allocate_from_space() const {
     return _should_allocate_from_space;
@@ -218,6 +242,8 @@ protected:
   ContiguousSpace* from() const           { return _from_space;  }
   ContiguousSpace* to()   const           { return _to_space;    }
 
+  EdenZeroingThread* eden_zeroer() const  { return _eden_zeroer; }
+
   virtual CompactibleSpace* first_compaction_space() const;
 
   // Space enquiries
@@ -232,7 +258,9 @@ protected:
   size_t max_eden_size() const              { return _max_eden_size; }
   size_t max_survivor_size() const          { return _max_survivor_size; }
 
-  bool supports_inline_contig_alloc() const { return true; }
+  // Compiled code must not allocate in eden behind the back of the
+  // eden zeroing thread.
+  bool supports_inline_contig_alloc() const { return !ZeroEdenConcurrently; }
   HeapWord** top_addr() const;
   HeapWord** end_addr() const;
 
@@ -335,6 +363,11 @@ protected:
 
   oop copy_to_survivor_space(oop old);
   uint tenuring_threshold() { return _tenuring_threshold; }
+  // The age from which an object is promoted rather than copied to the
+  // survivor space; lower than tenuring_threshold() for the instances of
+  // classes chosen by PretenureLongLivedClasses. "age" is the age of old
+  // before this collection.
+  inline uint tenuring_threshold_for(oop old, uint age, size_t size);
 
   // Performance Counter support
   void update_counters();
@@ -29,6 +29,17 @@
 #include "memory/defNewGeneration.hpp"
 #include "memory/space.hpp"
 
+inline uint DefNewGeneration::tenuring_threshold_for(oop old, uint age, size_t size) {
+  if (PretenureLongLivedClasses) {
+    Klass* k = old->klass();
+    if (k->should_pretenure()) {
+      return 0;
+    }
+    k->record_survivor_copy(age, size);
+  }
+  return tenuring_threshold();
+}
+
 // Methods of protected closure types
 
 template <class T>
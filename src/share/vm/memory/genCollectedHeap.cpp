@@ -58,6 +58,7 @@
 #if INCLUDE_ALL_GCS
 #include "gc_implementation/concurrentMarkSweep/concurrentMarkSweepThread.hpp"
 #include "gc_implementation/concurrentMarkSweep/vmCMSOperations.hpp"
+#include "gc_implementation/shared/edenZeroingThread.hpp"
 #endif // INCLUDE_ALL_GCS
 
 GenCollectedHeap* GenCollectedHeap::_gch;
@@ -354,6 +355,10 @@ bool GenCollectedHeap::should_do_concurrent_full_gc(GCCause::Cause cause) {
           (cause == GCCause::_java_lang_system_gc && ExplicitGCInvokesConcurrent));
 }
 
+static void clear_pretenure_info(Klass* const k) {
+  k->clear_pretenure_info();
+}
+
 void GenCollectedHeap::do_collection(bool  full,
                                      bool   clear_all_soft_refs,
                                      size_t size,
@@ -561,6 +566,10 @@ void GenCollectedHeap::do_collection(bool  full,
     }
 
     if (complete) {
+      if (PretenureLongLivedClasses) {
+        // Let the young collections re-learn which classes live long.
+        ClassLoaderDataGraph::classes_do(clear_pretenure_info);
+      }
       // Delete metaspaces for unloaded class loaders and clean up loader_data graph
       ClassLoaderDataGraph::purge();
       MetaspaceAux::verify_metrics();
@@ -734,11 +743,14 @@ void GenCollectedHeap::gen_process_roots(int level,
     }
   }
   // When collection is parallel, all threads get to cooperate to do
-  // older-gen scanning.
-  for (int i = level+1; i < _n_gens; i++) {
-    older_gens->set_generation(_gens[i]);
-    rem_set()->younger_refs_iterate(_gens[i], older_gens);
-    older_gens->reset_generation();
+  // older-gen scanning.  A NULL "older_gens" means the caller has
+  // already scanned the older generations.
+  if (older_gens != NULL) {
+    for (int i = level+1; i < _n_gens; i++) {
+      older_gens->set_generation(_gens[i]);
+      rem_set()->younger_refs_iterate(_gens[i], older_gens);
+      older_gens->reset_generation();
+    }
   }
 
   _process_strong_tasks->all_tasks_completed();
@@ -1226,6 +1238,10 @@ void GenCollectedHeap::gc_threads_do(ThreadClosure* tc) const {
   if (UseConcMarkSweepGC) {
     ConcurrentMarkSweepThread::threads_do(tc);
   }
+  EdenZeroingThread* zeroer = ((DefNewGeneration*)_gens[0])->eden_zeroer();
+  if (zeroer != NULL) {
+    tc->do_thread(zeroer);
+  }
 #endif // INCLUDE_ALL_GCS
 }
 
@@ -1237,6 +1253,19 @@ void GenCollectedHeap::print_gc_threads_on(outputStream* st) const {
   if (UseConcMarkSweepGC) {
     ConcurrentMarkSweepThread::print_all_on(st);
   }
+  EdenZeroingThread* zeroer = ((DefNewGeneration*)_gens[0])->eden_zeroer();
+  if (zeroer != NULL) {
+    zeroer->print_on(st);
+  }
+#endif // INCLUDE_ALL_GCS
+}
+
+void GenCollectedHeap::stop() {
+#if INCLUDE_ALL_GCS
+  EdenZeroingThread* zeroer = ((DefNewGeneration*)_gens[0])->eden_zeroer();
+  if (zeroer != NULL) {
+    zeroer->stop();
+  }
 #endif // INCLUDE_ALL_GCS
 }
 
@@ -334,6 +334,8 @@ public:
   virtual void print_on(outputStream* st) const;
   virtual void print_gc_threads_on(outputStream* st) const;
   virtual void gc_threads_do(ThreadClosure* tc) const;
+  // Stop the eden zeroing thread, if any.
+  virtual void stop();
   virtual void print_tracing_info() const;
   virtual void print_on_error(outputStream* st) const;
 
@@ -35,7 +35,8 @@ size_t CodeHeap::header_size() {
 
 // Implementation of Heap
 
-CodeHeap::CodeHeap() {
+CodeHeap::CodeHeap(const char* name, const int code_blob_type)
+  : _name(name), _code_blob_type(code_blob_type) {
   _number_of_committed_segments = 0;
   _number_of_reserved_segments  = 0;
   _segment_size                 = 0;
@@ -43,6 +44,7 @@ CodeHeap::CodeHeap() {
   _next_segment                 = 0;
   _freelist                     = NULL;
   _freelist_segments            = 0;
+  _max_allocated_capacity       = 0;
 }
 
 
@@ -87,30 +89,25 @@ void CodeHeap::on_code_mapping(char* base, size_t size) {
 }
 
 
-bool CodeHeap::reserve(size_t reserved_size, size_t committed_size,
+bool CodeHeap::reserve(ReservedSpace rs, size_t committed_size,
                        size_t segment_size) {
-  assert(reserved_size >= committed_size, "reserved < committed");
+  assert(rs.size() >= committed_size, "reserved < committed");
   assert(segment_size >= sizeof(FreeBlock), "segment size is too small");
   assert(is_power_of_2(segment_size), "segment_size must be a power of 2");
 
   _segment_size      = segment_size;
   _log2_segment_size = exact_log2(segment_size);
 
-  // Reserve and initialize space for _memory.
+  // Initialize space for _memory within the space reserved by the CodeCache.
   size_t page_size = os::vm_page_size();
   if (os::can_execute_large_page_memory()) {
-    page_size = os::page_size_for_region_unaligned(reserved_size, 8);
+    page_size = os::page_size_for_region_unaligned(rs.size(), 8);
   }
 
   const size_t granularity = os::vm_allocation_granularity();
-  const size_t r_align = MAX2(page_size, granularity);
-  const size_t r_size = align_size_up(reserved_size, r_align);
   const size_t c_size = align_size_up(committed_size, page_size);
 
-  const size_t rs_align = page_size == (size_t) os::vm_page_size() ? 0 :
-    MAX2(page_size, granularity);
-  ReservedCodeSpace rs(r_size, rs_align, rs_align > 0);
-  os::trace_page_sizes("code heap", committed_size, reserved_size, page_size,
+  os::trace_page_sizes(_name, committed_size, rs.size(), page_size,
                        rs.base(), rs.size());
   if (!_memory.initialize(rs, c_size)) {
     return false;
@@ -195,6 +192,7 @@ void* CodeHeap::allocate(size_t instance_size, bool is_critical) {
 #ifdef ASSERT
     memset((void *)block->allocated_space(), badCodeHeapNewVal, instance_size);
 #endif
+    _max_allocated_capacity = MAX2(_max_allocated_capacity, allocated_capacity());
     return block->allocated_space();
   }
 
@@ -220,6 +218,7 @@ void* CodeHeap::allocate(size_t instance_size, bool is_critical) {
 #ifdef ASSERT
     memset((void *)b->allocated_space(), badCodeHeapNewVal, instance_size);
 #endif
+    _max_allocated_capacity = MAX2(_max_allocated_capacity, allocated_capacity());
     return b->allocated_space();
   } else {
     return NULL;
@@ -325,6 +324,48 @@ size_t CodeHeap::heap_unallocated_capacity() const {
   return segments_to_size(_number_of_reserved_segments - _next_segment);
 }
 
+void CodeHeap::print_free_blocks(outputStream* st) const {
+  // Buckets of free blocks below 1K, 4K, ... 1M, and above
+  const int buckets = 7;
+  size_t count[buckets];
+  size_t bytes[buckets];
+  memset(count, 0, sizeof(count));
+  memset(bytes, 0, sizeof(bytes));
+  size_t free_count = 0;
+  size_t free_bytes = 0;
+  size_t largest = 0;
+  for (FreeBlock* b = _freelist; b != NULL; b = b->link()) {
+    size_t size = segments_to_size(b->length());
+    int i = 0;
+    while (i < buckets - 1 && size >= (K << (2 * i))) {
+      i++;
+    }
+    count[i]++;
+    bytes[i] += size;
+    free_count++;
+    free_bytes += size;
+    largest = MAX2(largest, size);
+  }
+
+  size_t tail = heap_unallocated_capacity();
+  size_t total = free_bytes + tail;
+  st->print_cr(" %s: " SIZE_FORMAT " free blocks of " SIZE_FORMAT "Kb, largest " SIZE_FORMAT
+               "Kb, never allocated " SIZE_FORMAT "Kb, fragmentation %.1f%%",
+               name(), free_count, free_bytes / K, largest / K, tail / K,
+               total == 0 ? 0.0 : 100.0 * (total - MAX2(largest, tail)) / total);
+  for (int i = 0; i < buckets; i++) {
+    if (count[i] == 0) {
+      continue;
+    }
+    if (i < buckets - 1) {
+      st->print("   < " SIZE_FORMAT_W(5) "Kb", (size_t)(1) << (2 * i));
+    } else {
+      st->print("  >= " SIZE_FORMAT_W(5) "Kb", (size_t)(1) << (2 * (i - 1)));
+    }
+    st->print_cr(": " SIZE_FORMAT_W(6) " blocks, " SIZE_FORMAT_W(7) "Kb", count[i], bytes[i] / K);
+  }
+}
+
 // Free list management
 
 FreeBlock *CodeHeap::following_block(FreeBlock *b) {
@@ -470,7 +511,7 @@ FreeBlock* CodeHeap::search_freelist(size_t length, bool is_critical) {
 #ifndef PRODUCT
 
 void CodeHeap::print() {
-  tty->print_cr("The Heap");
+  tty->print_cr("The Heap %s", _name);
 }
 
 #endif
@@ -28,10 +28,13 @@
 #include "memory/genCollectedHeap.hpp"
 #include "memory/heapInspection.hpp"
 #include "memory/resourceArea.hpp"
+#include "runtime/mutexLocker.hpp"
 #include "runtime/os.hpp"
 #include "utilities/globalDefinitions.hpp"
 #include "utilities/macros.hpp"
+#include "utilities/workgroup.hpp"
 #if INCLUDE_ALL_GCS
+#include "gc_implementation/g1/g1CollectedHeap.hpp"
 #include "gc_implementation/parallelScavenge/parallelScavengeHeap.hpp"
 #endif // INCLUDE_ALL_GCS
 
@@ -200,6 +203,52 @@ size_t KlassInfoTable::size_of_instances_in_words() const {
   return _size_of_instances_in_words;
 }
 
+bool KlassInfoTable::merge_entry(const KlassInfoEntry* cie) {
+  Klass*          k = cie->klass();
+  KlassInfoEntry* elt = lookup(k);
+  // elt may be NULL if it's a new klass for which we
+  // could not allocate space for a new entry in the hashtable.
+  if (elt != NULL) {
+    elt->set_count(elt->count() + cie->count());
+    elt->set_words(elt->words() + cie->words());
+    _size_of_instances_in_words += cie->words();
+    return true;
+  }
+  return false;
+}
+
+class KlassInfoTableMergeClosure : public KlassInfoClosure {
+ private:
+  KlassInfoTable* _dest;
+  bool _success;
+ public:
+  KlassInfoTableMergeClosure(KlassInfoTable* table) : _dest(table), _success(true) {}
+  void do_cinfo(KlassInfoEntry* cie) {
+    _success &= _dest->merge_entry(cie);
+  }
+  bool success() { return _success; }
+};
+
+class KlassInfoClearClosure : public KlassInfoClosure {
+ public:
+  void do_cinfo(KlassInfoEntry* cie) {
+    cie->set_count(0);
+    cie->set_words(0);
+  }
+};
+
+void KlassInfoTable::clear_counts() {
+  KlassInfoClearClosure closure;
+  iterate(&closure);
+  _size_of_instances_in_words = 0;
+}
+
+bool KlassInfoTable::merge(KlassInfoTable* table) {
+  KlassInfoTableMergeClosure closure(this);
+  table->iterate(&closure);
+  return closure.success();
+}
+
 int KlassInfoHisto::sort_helper(KlassInfoEntry** e1, KlassInfoEntry** e2) {
   return (*e1)->compare(*e1,*e2);
 }
@@ -483,9 +532,100 @@ class RecordInstanceClosure : public ObjectClosure {
   }
 };
 
+#if INCLUDE_ALL_GCS
+// Walks a G1 heap with the GC worker threads. Each worker records the
+// objects of the regions it claims in a table of its own, and merges it
+// into the shared one when it is done.
+class ParHeapInspectTask : public AbstractGangTask {
+ private:
+  KlassInfoTable* _shared_cit;
+  Mutex*          _lock;
+  uint            _num_workers;
+  size_t          _missed_count;
+  bool            _success;
+
+ public:
+  ParHeapInspectTask(KlassInfoTable* shared_cit, uint num_workers) :
+    AbstractGangTask("Parallel Heap Inspection"),
+    _shared_cit(shared_cit),
+    _lock(new Mutex(Mutex::leaf, "HeapInspection_lock", true)),
+    _num_workers(num_workers),
+    _missed_count(0),
+    _success(true) { }
+
+  ~ParHeapInspectTask() {
+    delete _lock;
+  }
+
+  size_t missed_count() const { return _missed_count; }
+  bool success() const        { return _success; }
+
+  void work(uint worker_id) {
+    if (worker_id >= _num_workers) {
+      // any worker claims the regions left over by the others
+      return;
+    }
+    KlassInfoTable cit(false);
+    if (cit.allocation_failed()) {
+      // let the VM thread walk the heap instead
+      MutexLockerEx ml(_lock, Mutex::_no_safepoint_check_flag);
+      _success = false;
+      return;
+    }
+    RecordInstanceClosure ric(&cit, NULL);
+    G1CollectedHeap::heap()->object_par_iterate(&ric, worker_id, _num_workers);
+
+    MutexLockerEx ml(_lock, Mutex::_no_safepoint_check_flag);
+    _missed_count += ric.missed_count();
+    if (!_shared_cit->merge(&cit)) {
+      _success = false;
+    }
+  }
+};
+#endif // INCLUDE_ALL_GCS
+
+// The number of GC worker threads to walk the heap with, or 0 if the
+// VM thread walks it alone.
+uint HeapInspection::parallel_threads() const {
+#if INCLUDE_ALL_GCS
+  if (UseG1GC && _parallel_thread_num != 1 && SafepointSynchronize::is_at_safepoint()) {
+    FlexibleWorkGang* workers = G1CollectedHeap::heap()->workers();
+    if (workers != NULL) {
+      uint n = workers->active_workers();
+      if (_parallel_thread_num != 0) {
+        n = MIN2(n, _parallel_thread_num);
+      }
+      return n > 1 ? n : 0;
+    }
+  }
+#endif // INCLUDE_ALL_GCS
+  return 0;
+}
+
 size_t HeapInspection::populate_table(KlassInfoTable* cit, BoolObjectClosure *filter) {
   ResourceMark rm;
 
+#if INCLUDE_ALL_GCS
+  // A filter may not be safe to call from several threads.
+  uint n_threads = filter == NULL ? parallel_threads() : 0;
+  if (n_threads > 0) {
+    G1CollectedHeap* g1h = G1CollectedHeap::heap();
+    assert(g1h->check_heap_region_claim_values(HeapRegion::InitialClaimValue),
+           "sanity check");
+    ParHeapInspectTask task(cit, n_threads);
+    g1h->set_par_threads(g1h->workers()->active_workers());
+    g1h->workers()->run_task(&task);
+    g1h->set_par_threads(0);
+    g1h->reset_heap_region_claim_values();
+    if (task.success()) {
+      return task.missed_count();
+    }
+    // Out of C-heap in a worker. Start over, as the shared table may hold
+    // some of the objects already
+    cit->clear_counts();
+  }
+#endif // INCLUDE_ALL_GCS
+
   RecordInstanceClosure ric(cit, filter);
   Universe::heap()->object_iterate(&ric);
   return ric.missed_count();
@@ -254,6 +254,12 @@ class KlassInfoTable: public StackObj {
   void iterate(KlassInfoClosure* cic);
   bool allocation_failed() { return _buckets == NULL; }
   size_t size_of_instances_in_words() const;
+  // Adds the counts of table to this one. Returns false if an entry
+  // could not be allocated.
+  bool merge(KlassInfoTable* table);
+  bool merge_entry(const KlassInfoEntry* cie);
+  // Zeroes the counts, keeping the entries.
+  void clear_counts();
 
   friend class KlassInfoHisto;
 };
@@ -361,16 +367,20 @@ class HeapInspection : public StackObj {
   bool _print_help;
   bool _print_class_stats;
   const char* _columns;
+  uint _parallel_thread_num; // GC threads to walk the heap with, 0 for all
  public:
   HeapInspection(bool csv_format, bool print_help,
-                 bool print_class_stats, const char *columns) :
+                 bool print_class_stats, const char *columns,
+                 uint parallel_thread_num = 0) :
       _csv_format(csv_format), _print_help(print_help),
-      _print_class_stats(print_class_stats), _columns(columns) {}
+      _print_class_stats(print_class_stats), _columns(columns),
+      _parallel_thread_num(parallel_thread_num) {}
   void heap_inspection(outputStream* st) NOT_SERVICES_RETURN;
   size_t populate_table(KlassInfoTable* cit, BoolObjectClosure* filter = NULL) NOT_SERVICES_RETURN;
   static void find_instances_at_safepoint(Klass* k, GrowableArray<oop>* result) NOT_SERVICES_RETURN;
  private:
   void iterate_over_heap(KlassInfoTable* cit, BoolObjectClosure* filter = NULL);
+  uint parallel_threads() const;
 };
 
 #endif // SHARE_VM_MEMORY_HEAPINSPECTION_HPP
@@ -25,6 +25,7 @@
 #include "precompiled.hpp"
 #include "memory/allocation.hpp"
 #include "memory/metachunk.hpp"
+#include "runtime/atomic.inline.hpp"
 #include "utilities/copy.hpp"
 #include "utilities/debug.hpp"
 
@@ -70,13 +71,18 @@ Metachunk::Metachunk(size_t word_size,
 }
 
 MetaWord* Metachunk::allocate(size_t word_size) {
-  MetaWord* result = NULL;
-  // If available, bump the pointer to allocate.
-  if (free_word_size() >= word_size) {
-    result = _top;
-    _top = _top + word_size;
+  // If available, bump the pointer to allocate.  SpaceManager::allocate
+  // does this without holding the SpaceManager lock.
+  while (true) {
+    MetaWord* result = _top;
+    if (pointer_delta(end(), result, sizeof(MetaWord)) < word_size) {
+      return NULL;
+    }
+    MetaWord* new_top = result + word_size;
+    if (Atomic::cmpxchg_ptr(new_top, &_top, result) == result) {
+      return result;
+    }
   }
-  return result;
 }
 
 // _bottom points to the start of the chunk including the overhead.
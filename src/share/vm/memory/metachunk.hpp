@@ -99,8 +99,8 @@ class Metachunk : public Metabase<Metachunk> {
   // The VirtualSpaceNode containing this chunk.
   VirtualSpaceNode* _container;
 
-  // Current allocation top.
-  MetaWord* _top;
+  // Current allocation top.  Bumped with a CAS, see allocate().
+  MetaWord* volatile _top;
 
   DEBUG_ONLY(bool _is_tagged_free;)
 
@@ -122,6 +122,7 @@ class Metachunk : public Metabase<Metachunk> {
 
   Metachunk(size_t word_size , VirtualSpaceNode* container);
 
+  // Safe to call concurrently with other allocations from this chunk.
   MetaWord* allocate(size_t word_size);
 
   VirtualSpaceNode* container() const { return _container; }
@@ -164,6 +164,10 @@ class ChunkManager : public CHeapObj<mtInternal> {
   // of type index.
   void return_chunks(ChunkIndex index, Metachunk* chunks);
 
+  // Discard the contents of a chunk that is being freed, except for its
+  // header, so that its pages no longer count against the process RSS.
+  static void discard_chunk_pages(Metachunk* chunk);
+
   // Total of the space in the free chunks list
   size_t free_chunks_total_words();
   size_t free_chunks_total_bytes();
@@ -619,7 +623,7 @@ class SpaceManager : public CHeapObj<mtClass> {
   // are done from the current chunk.  The list is used for deallocating
   // chunks when the SpaceManager is freed.
   Metachunk* _chunks_in_use[NumberOfInUseLists];
-  Metachunk* _current_chunk;
+  Metachunk* volatile _current_chunk;
 
   // Number of small chunks to allocate to a manager
   // If class space manager, small chunks are unlimited
@@ -661,7 +665,8 @@ class SpaceManager : public CHeapObj<mtClass> {
 
   Metachunk* current_chunk() const { return _current_chunk; }
   void set_current_chunk(Metachunk* v) {
-    _current_chunk = v;
+    // Published to the lock-free path in allocate()
+    OrderAccess::release_store_ptr(&_current_chunk, v);
   }
 
   Metachunk* find_current_chunk(size_t word_size);
@@ -2228,10 +2233,27 @@ void SpaceManager::initialize() {
   }
 }
 
+void ChunkManager::discard_chunk_pages(Metachunk* chunk) {
+  // The free list links, and the tree links for humongous chunks, live at
+  // the start of the chunk and must survive. The rest reads as zeros once
+  // it is touched again, which is fine since metadata allocations are
+  // cleared anyway.
+  size_t page_size = os::vm_page_size();
+  char* start = (char*) align_ptr_up((char*) chunk + sizeof(TreeChunk<Metachunk, FreeList<Metachunk> >),
+                                     page_size);
+  char* end = (char*) align_ptr_down((char*) chunk->end(), page_size);
+  if (start < end) {
+    os::free_memory(start, pointer_delta(end, start, sizeof(char)), page_size);
+  }
+}
+
 void ChunkManager::return_chunks(ChunkIndex index, Metachunk* chunks) {
   if (chunks == NULL) {
     return;
   }
+  // Only medium chunks span enough pages to be worth the system calls.
+  bool discard = MetaspaceDiscardFreeChunks && !UseLargePagesInMetaspace &&
+                 index == MediumIndex;
   ChunkList* list = free_chunks(index);
   assert(list->size() == chunks->word_size(), "Mismatch in chunk sizes");
   assert_lock_strong(SpaceManager::expand_lock());
@@ -2248,6 +2270,9 @@ void ChunkManager::return_chunks(ChunkIndex index, Metachunk* chunks) {
     // by the call to return_chunk_at_head();
     Metachunk* next = cur->next();
     DEBUG_ONLY(cur->set_is_tagged_free(true);)
+    if (discard) {
+      discard_chunk_pages(cur);
+    }
     list->return_chunk_at_head(cur);
     cur = next;
   }
@@ -2334,6 +2359,9 @@ SpaceManager::~SpaceManager() {
                    humongous_chunks->word_size(), smallest_chunk_size()));
     Metachunk* next_humongous_chunks = humongous_chunks->next();
     humongous_chunks->container()->dec_container_count();
+    if (MetaspaceDiscardFreeChunks && !UseLargePagesInMetaspace) {
+      ChunkManager::discard_chunk_pages(humongous_chunks);
+    }
     chunk_manager()->humongous_dictionary()->return_chunk(humongous_chunks);
     humongous_chunks = next_humongous_chunks;
   }
@@ -2434,10 +2462,18 @@ void SpaceManager::add_chunk(Metachunk* new_chunk, bool make_current) {
 
 void SpaceManager::retire_current_chunk() {
   if (current_chunk() != NULL) {
-    size_t remaining_words = current_chunk()->free_word_size();
-    if (remaining_words >= TreeChunk<Metablock, FreeList<Metablock> >::min_size()) {
-      block_freelists()->return_block(current_chunk()->allocate(remaining_words), remaining_words);
-      inc_used_metrics(remaining_words);
+    // Lock-free allocations may still shrink the remainder under us.
+    while (true) {
+      size_t remaining_words = current_chunk()->free_word_size();
+      if (remaining_words < TreeChunk<Metablock, FreeList<Metablock> >::min_size()) {
+        break;
+      }
+      MetaWord* remainder = current_chunk()->allocate(remaining_words);
+      if (remainder != NULL) {
+        block_freelists()->return_block(remainder, remaining_words);
+        inc_used_metrics(remaining_words);
+        break;
+      }
     }
   }
 }
@@ -2461,10 +2497,29 @@ Metachunk* SpaceManager::get_new_chunk(size_t chunk_word_size) {
 }
 
 MetaWord* SpaceManager::allocate(size_t word_size) {
-  MutexLockerEx cl(lock(), Mutex::_no_safepoint_check_flag);
-
   size_t raw_word_size = get_raw_word_size(word_size);
   BlockFreelist* fl =  block_freelists();
+
+  // Fast path: bump the top of the current chunk without taking the lock,
+  // so that threads defining classes in parallel in one loader (lambda
+  // forms, reflection accessors) do not serialize here.  The chunk stays
+  // in use until this SpaceManager goes away, so a stale current chunk
+  // is harmless: allocate() fails once it is retired.  The unlocked read
+  // of the freelist size is only a heuristic.
+  if (!DumpSharedSpaces && !MetadataAllocationFailALot &&
+      fl->total_size() <= allocation_from_dictionary_limit) {
+    Metachunk* chunk = (Metachunk*) OrderAccess::load_ptr_acquire(&_current_chunk);
+    if (chunk != NULL) {
+      MetaWord* result = chunk->allocate(raw_word_size);
+      if (result != NULL) {
+        inc_used_metrics(raw_word_size);
+        return result;
+      }
+    }
+  }
+
+  MutexLockerEx cl(lock(), Mutex::_no_safepoint_check_flag);
+
   MetaWord* p = NULL;
   // Allocation from the dictionary is expensive in the sense that
   // the dictionary has to be searched for a size.  Don't allocate
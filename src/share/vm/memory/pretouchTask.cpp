@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "memory/pretouchTask.hpp"
+#include "runtime/atomic.inline.hpp"
+#include "runtime/orderAccess.inline.hpp"
+#include "runtime/globals.hpp"
+#include "runtime/os.hpp"
+#include "runtime/vm_version.hpp"
+
+WorkGang*     PretouchTask::_gang   = NULL;
+volatile jint PretouchTask::_in_use = 0;
+
+PretouchTask::PretouchTask(char* start, char* end, size_t page_size, size_t chunk_size) :
+  AbstractGangTask("Pretouch"),
+  _cur(start), _end(end), _page_size(page_size), _chunk_size(chunk_size) {}
+
+void PretouchTask::work(uint worker_id) {
+  while (true) {
+    char* touch_start = (char*)Atomic::add_ptr((intptr_t)_chunk_size, (volatile intptr_t*)&_cur) - _chunk_size;
+    if (touch_start >= _end) {
+      return;
+    }
+    char* touch_end = MIN2(touch_start + _chunk_size, _end);
+    for (volatile char* p = touch_start; p < touch_end; p += _page_size) {
+      *p = 0;
+    }
+  }
+}
+
+WorkGang* PretouchTask::gang() {
+  if (_gang == NULL) {
+    uint workers = ParallelGCThreads > 0 ? (uint)ParallelGCThreads :
+                                           Abstract_VM_Version::parallel_worker_threads();
+    if (workers <= 1) {
+      return NULL;
+    }
+    WorkGang* gang = new WorkGang("Pretouch Thread", workers, false, false);
+    if (gang == NULL || !gang->initialize_workers()) {
+      return NULL;
+    }
+    _gang = gang;
+  }
+  return _gang;
+}
+
+void PretouchTask::pretouch(char* start, char* end, size_t page_size) {
+  assert(is_size_aligned(page_size, os::vm_page_size()), "invalid page size");
+  assert(start <= end, "invalid range");
+
+  page_size = MAX2(page_size, (size_t)os::vm_page_size());
+  size_t chunk_size = align_size_up(MAX2((size_t)PreTouchParallelChunkSize, page_size), page_size);
+  size_t total = pointer_delta(end, start, sizeof(char));
+
+  if (total >= 2 * chunk_size && Atomic::cmpxchg(1, &_in_use, 0) == 0) {
+    WorkGang* workers = gang();
+    if (workers != NULL) {
+      PretouchTask task(start, end, page_size, chunk_size);
+      // Workers that find no chunk left to claim return right away.
+      workers->run_task(&task);
+      OrderAccess::release_store(&_in_use, 0);
+      return;
+    }
+    OrderAccess::release_store(&_in_use, 0);
+  }
+
+  for (volatile char* p = start; p < end; p += page_size) {
+    *p = 0;
+  }
+}
@@ -0,0 +1,59 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_MEMORY_PRETOUCHTASK_HPP
+#define SHARE_VM_MEMORY_PRETOUCHTASK_HPP
+
+#include "utilities/workgroup.hpp"
+
+// Pre-touches a freshly committed range of memory, splitting it into
+// page aligned chunks of PreTouchParallelChunkSize bytes that are
+// claimed by the workers of a dedicated gang. Ranges smaller than two
+// chunks, and calls made while the gang is already busy, are touched
+// by the calling thread.
+//
+// With UseNUMA the pages of a NUMA space are bound to their locality
+// group before they are touched, so the touching thread does not
+// influence page placement.
+class PretouchTask : public AbstractGangTask {
+  char* volatile _cur;
+  char* const    _end;
+  const size_t   _page_size;
+  const size_t   _chunk_size;
+
+  static WorkGang*     _gang;
+  static volatile jint _in_use;
+
+  static WorkGang* gang();
+
+  PretouchTask(char* start, char* end, size_t page_size, size_t chunk_size);
+
+ public:
+  virtual void work(uint worker_id);
+
+  // Touch every page_size page of [start, end).
+  static void pretouch(char* start, char* end, size_t page_size);
+};
+
+#endif // SHARE_VM_MEMORY_PRETOUCHTASK_HPP
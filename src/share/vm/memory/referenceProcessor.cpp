@@ -34,6 +34,7 @@
 #include "oops/oop.inline.hpp"
 #include "runtime/java.hpp"
 #include "runtime/jniHandles.hpp"
+#include "utilities/ticks.inline.hpp"
 
 PRAGMA_FORMAT_MUTE_WARNINGS_FOR_GCC
 
@@ -213,37 +214,48 @@ ReferenceProcessorStats ReferenceProcessor::process_discovered_references(
 
   // Soft references
   size_t soft_count = 0;
+  Tickspan soft_time;
   {
     GCTraceTime tt("SoftReference", trace_time, false, gc_timer, gc_id);
+    Ticks start = Ticks::now();
     soft_count =
       process_discovered_reflist(_discoveredSoftRefs, _current_soft_ref_policy, true,
                                  is_alive, keep_alive, complete_gc, task_executor);
+    soft_time = Ticks::now() - start;
   }
 
   update_soft_ref_master_clock();
 
   // Weak references
   size_t weak_count = 0;
+  Tickspan weak_time;
   {
     GCTraceTime tt("WeakReference", trace_time, false, gc_timer, gc_id);
+    Ticks start = Ticks::now();
     weak_count =
       process_discovered_reflist(_discoveredWeakRefs, NULL, true,
                                  is_alive, keep_alive, complete_gc, task_executor);
+    weak_time = Ticks::now() - start;
   }
 
   // Final references
   size_t final_count = 0;
+  Tickspan final_time;
   {
     GCTraceTime tt("FinalReference", trace_time, false, gc_timer, gc_id);
+    Ticks start = Ticks::now();
     final_count =
       process_discovered_reflist(_discoveredFinalRefs, NULL, false,
                                  is_alive, keep_alive, complete_gc, task_executor);
+    final_time = Ticks::now() - start;
   }
 
   // Phantom references
   size_t phantom_count = 0;
+  Tickspan phantom_time;
   {
     GCTraceTime tt("PhantomReference", trace_time, false, gc_timer, gc_id);
+    Ticks start = Ticks::now();
     phantom_count =
       process_discovered_reflist(_discoveredPhantomRefs, NULL, false,
                                  is_alive, keep_alive, complete_gc, task_executor);
@@ -254,6 +266,7 @@ ReferenceProcessorStats ReferenceProcessor::process_discovered_references(
     phantom_count +=
       process_discovered_reflist(_discoveredCleanerRefs, NULL, true,
                                  is_alive, keep_alive, complete_gc, task_executor);
+    phantom_time = Ticks::now() - start;
   }
 
   // Weak global JNI references. It would make more sense (semantically) to
@@ -263,13 +276,11 @@ ReferenceProcessorStats ReferenceProcessor::process_discovered_references(
   // resurrect a "post-mortem" object.
   {
     GCTraceTime tt("JNI Weak Reference", trace_time, false, gc_timer, gc_id);
-    if (task_executor != NULL) {
-      task_executor->set_single_threaded_mode();
-    }
-    process_phaseJNI(is_alive, keep_alive, complete_gc);
+    process_phaseJNI(is_alive, keep_alive, complete_gc, task_executor);
   }
 
-  return ReferenceProcessorStats(soft_count, weak_count, final_count, phantom_count);
+  return ReferenceProcessorStats(soft_count, weak_count, final_count, phantom_count,
+                                 soft_time, weak_time, final_time, phantom_time);
 }
 
 #ifndef PRODUCT
@@ -296,17 +307,48 @@ uint ReferenceProcessor::count_jni_refs() {
 }
 #endif
 
-void ReferenceProcessor::process_phaseJNI(BoolObjectClosure* is_alive,
-                                          OopClosure*        keep_alive,
-                                          VoidClosure*       complete_gc) {
+// Weak global JNI handles are processed with one task per worker, the
+// workers claim handle blocks from the shared JNIWeakHandlesParState.
+// The referents kept here are already live, so no new marking work is
+// expected; complete_gc is still applied by every worker.
+class RefProcPhaseJNITask: public AbstractRefProcTaskExecutor::ProcessTask {
+public:
+  RefProcPhaseJNITask(ReferenceProcessor& ref_processor)
+    : ProcessTask(ref_processor, NULL, false)
+  { }
+  virtual void work(unsigned int i, BoolObjectClosure& is_alive,
+                    OopClosure& keep_alive,
+                    VoidClosure& complete_gc)
+  {
+    _par_state.weak_oops_do(&is_alive, &keep_alive);
+    complete_gc.do_void();
+  }
+private:
+  JNIWeakHandlesParState _par_state;
+};
+
+void ReferenceProcessor::process_phaseJNI(BoolObjectClosure*           is_alive,
+                                          OopClosure*                  keep_alive,
+                                          VoidClosure*                 complete_gc,
+                                          AbstractRefProcTaskExecutor* task_executor) {
 #ifndef PRODUCT
   if (PrintGCDetails && PrintReferenceGC) {
     unsigned int count = count_jni_refs();
     gclog_or_tty->print(", %u refs", count);
   }
 #endif
-  JNIHandles::weak_oops_do(is_alive, keep_alive);
-  complete_gc->do_void();
+  if (_processing_is_mt && task_executor != NULL) {
+    RefProcPhaseJNITask phase_jni(*this);
+    task_executor->execute(phase_jni);
+    // This is the last parallel phase, let the executor finish up.
+    task_executor->set_single_threaded_mode();
+  } else {
+    if (task_executor != NULL) {
+      task_executor->set_single_threaded_mode();
+    }
+    JNIHandles::weak_oops_do(is_alive, keep_alive);
+    complete_gc->do_void();
+  }
 }
 
 
@@ -905,25 +947,41 @@ ReferenceProcessor::process_discovered_reflist(
   AbstractRefProcTaskExecutor* task_executor)
 {
   bool mt_processing = task_executor != NULL && _processing_is_mt;
+
+  size_t total_list_count = total_count(refs_lists);
+
+  if (PrintReferenceGC && PrintGCDetails) {
+    gclog_or_tty->print(", %u refs", total_list_count);
+  }
+
+  // Nothing was discovered for this type; skip its phases and, when
+  // processing in parallel, the work gang start-ups they would cost.
+  if (total_list_count == 0) {
+    return 0;
+  }
+
+  // Spread the references over no more queues than there are
+  // multiples of ReferencesPerThread, so that few references do not
+  // keep every worker busy walking near-empty lists.
+  uint saved_num_q = _num_q;
+  if (mt_processing && ReferencesPerThread > 0) {
+    size_t wanted_q = (total_list_count + ReferencesPerThread - 1) / ReferencesPerThread;
+    _num_q = (uint)MIN2(wanted_q, (size_t)_num_q);
+  }
+
   // If discovery used MT and a dynamic number of GC threads, then
   // the queues must be balanced for correctness if fewer than the
   // maximum number of queues were used.  The number of queue used
   // during discovery may be different than the number to be used
   // for processing so don't depend of _num_q < _max_num_q as part
   // of the test.
-  bool must_balance = _discovery_is_mt;
+  bool must_balance = _discovery_is_mt || _num_q < saved_num_q;
 
   if ((mt_processing && ParallelRefProcBalancingEnabled) ||
       must_balance) {
     balance_queues(refs_lists);
   }
 
-  size_t total_list_count = total_count(refs_lists);
-
-  if (PrintReferenceGC && PrintGCDetails) {
-    gclog_or_tty->print(", %u refs", total_list_count);
-  }
-
   // Phase 1 (soft refs only):
   // . Traverse the list and remove any SoftReferences whose
   //   referents are not alive, but that should be kept alive for
@@ -967,6 +1025,7 @@ ReferenceProcessor::process_discovered_reflist(
     }
   }
 
+  _num_q = saved_num_q;
   return total_list_count;
 }
 
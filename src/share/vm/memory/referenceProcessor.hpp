@@ -291,9 +291,10 @@ class ReferenceProcessor : public CHeapObj<mtGC> {
                                     VoidClosure*                 complete_gc,
                                     AbstractRefProcTaskExecutor* task_executor);
 
-  void process_phaseJNI(BoolObjectClosure* is_alive,
-                        OopClosure*        keep_alive,
-                        VoidClosure*       complete_gc);
+  void process_phaseJNI(BoolObjectClosure*           is_alive,
+                        OopClosure*                  keep_alive,
+                        VoidClosure*                 complete_gc,
+                        AbstractRefProcTaskExecutor* task_executor);
 
   // Work methods used by the method process_discovered_reflist
   // Phase1: keep alive all those referents that are otherwise
@@ -26,6 +26,7 @@
 #define SHARE_VM_MEMORY_REFERENCEPROCESSORSTATS_HPP
 
 #include "utilities/globalDefinitions.hpp"
+#include "utilities/ticks.hpp"
 
 class ReferenceProcessor;
 
@@ -37,6 +38,12 @@ class ReferenceProcessorStats {
   size_t _final_count;
   size_t _phantom_count;
 
+  // Time spent processing each type of reference.
+  Tickspan _soft_time;
+  Tickspan _weak_time;
+  Tickspan _final_time;
+  Tickspan _phantom_time;
+
  public:
   ReferenceProcessorStats() :
     _soft_count(0),
@@ -47,11 +54,19 @@ class ReferenceProcessorStats {
   ReferenceProcessorStats(size_t soft_count,
                           size_t weak_count,
                           size_t final_count,
-                          size_t phantom_count) :
+                          size_t phantom_count,
+                          const Tickspan& soft_time,
+                          const Tickspan& weak_time,
+                          const Tickspan& final_time,
+                          const Tickspan& phantom_time) :
     _soft_count(soft_count),
     _weak_count(weak_count),
     _final_count(final_count),
-    _phantom_count(phantom_count)
+    _phantom_count(phantom_count),
+    _soft_time(soft_time),
+    _weak_time(weak_time),
+    _final_time(final_time),
+    _phantom_time(phantom_time)
   {}
 
   size_t soft_count() const {
@@ -69,5 +84,21 @@ class ReferenceProcessorStats {
   size_t phantom_count() const {
     return _phantom_count;
   }
+
+  const Tickspan& soft_time() const {
+    return _soft_time;
+  }
+
+  const Tickspan& weak_time() const {
+    return _weak_time;
+  }
+
+  const Tickspan& final_time() const {
+    return _final_time;
+  }
+
+  const Tickspan& phantom_time() const {
+    return _phantom_time;
+  }
 };
 #endif
@@ -50,7 +50,8 @@ SharedHeap::SharedHeap(CollectorPolicy* policy_) :
   if ((UseParNewGC ||
       (UseConcMarkSweepGC && (CMSParallelInitialMarkEnabled ||
                               CMSParallelRemarkEnabled)) ||
-       UseG1GC) &&
+       UseG1GC ||
+       DefNewParallelScanThreads > 1) &&
       ParallelGCThreads > 0) {
     _workers = new FlexibleWorkGang("Parallel GC Threads", ParallelGCThreads,
                             /* are_GC_task_threads */true,
@@ -71,7 +72,8 @@ bool SharedHeap::heap_lock_held_for_gc() {
 }
 
 void SharedHeap::set_par_threads(uint t) {
-  assert(t == 0 || !UseSerialGC, "Cannot have parallel threads");
+  assert(t == 0 || !UseSerialGC || DefNewParallelScanThreads > 1,
+         "Cannot have parallel threads");
   _n_par_threads = t;
 }
 
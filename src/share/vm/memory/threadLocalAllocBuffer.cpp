@@ -29,6 +29,7 @@
 #include "memory/universe.inline.hpp"
 #include "oops/oop.inline.hpp"
 #include "runtime/thread.inline.hpp"
+#include "runtime/threadHeapSampler.hpp"
 #include "utilities/copy.hpp"
 
 PRAGMA_FORMAT_MUTE_WARNINGS_FOR_GCC
@@ -42,6 +43,10 @@ GlobalTLABStats* ThreadLocalAllocBuffer::_global_stats   = NULL;
 
 void ThreadLocalAllocBuffer::clear_before_allocation() {
   _slow_refill_waste += (unsigned)remaining();
+  if (TLABAdaptiveRefillWaste && end() != NULL) {
+    // Remember how far the limit had to grow before this tlab was given up.
+    _discard_waste_limit.sample((float)refill_waste_limit());
+  }
   make_parsable(true);   // also retire the TLAB
 }
 
@@ -102,6 +107,13 @@ void ThreadLocalAllocBuffer::accumulate_statistics() {
     assert(_number_of_refills == 0 && _fast_refill_waste == 0 &&
            _slow_refill_waste == 0 && _gc_waste          == 0,
            "tlab stats == 0");
+    // A thread that did not refill since the last GC still gets its
+    // allocation history updated, so that a once busy but now idle thread
+    // does not keep asking for tlabs sized for its old allocation rate.
+    if (TLABAdaptiveRefillWaste && used > 0.5 * capacity) {
+      double alloc_frac = MIN2(1.0, (double) allocated_since_last_gc / used);
+      _allocation_fraction.sample(alloc_frac);
+    }
   }
   global_stats()->update_slow_allocations(_slow_allocations);
 }
@@ -161,6 +173,18 @@ void ThreadLocalAllocBuffer::resize() {
   set_refill_waste_limit(initial_refill_waste_limit());
 }
 
+size_t ThreadLocalAllocBuffer::initial_refill_waste_limit() {
+  size_t limit = desired_size() / TLABRefillWasteFraction;
+  if (TLABAdaptiveRefillWaste) {
+    // Threads that repeatedly allocate outside their tlab before discarding
+    // it start with the limit they typically end up at, but never waste
+    // more than a quarter of a tlab this way.
+    size_t learned = (size_t)_discard_waste_limit.average();
+    limit = MAX2(limit, MIN2(learned, desired_size() / 4));
+  }
+  return limit;
+}
+
 void ThreadLocalAllocBuffer::initialize_statistics() {
     _number_of_refills = 0;
     _fast_refill_waste = 0;
@@ -179,10 +203,28 @@ void ThreadLocalAllocBuffer::fill(HeapWord* start,
   assert(top <= start + new_size - alignment_reserve(), "size too small");
   initialize(start, top, start + new_size - alignment_reserve());
 
+  if (ThreadHeapSampler::enabled()) {
+    Thread* thread = myThread();
+    set_sample_end(thread->heap_sampler().bytes_until_sample(thread->cooked_allocated_bytes()));
+  }
+
   // Reset amount of internal fragmentation
   set_refill_waste_limit(initial_refill_waste_limit());
 }
 
+void ThreadLocalAllocBuffer::set_sample_end(size_t bytes_until_sample) {
+  if (end() == NULL) {
+    return;
+  }
+  size_t words = bytes_until_sample / HeapWordSize;
+  if (words < pointer_delta(allocation_end(), top())) {
+    _end = top() + words;
+  } else {
+    _end = allocation_end();
+  }
+  invariants();
+}
+
 void ThreadLocalAllocBuffer::initialize(HeapWord* start,
                                         HeapWord* top,
                                         HeapWord* end) {
@@ -42,7 +42,8 @@ private:
   HeapWord* _start;                              // address of TLAB
   HeapWord* _top;                                // address after last allocation
   HeapWord* _pf_top;                             // allocation prefetch watermark
-  HeapWord* _end;                                // allocation end (excluding alignment_reserve)
+  HeapWord* _end;                                // allocation end, possibly lowered for sampling (excluding alignment_reserve)
+  HeapWord* _allocation_end;                     // real allocation end (excluding alignment_reserve)
   size_t    _desired_size;                       // desired size   (including alignment_reserve)
   size_t    _refill_waste_limit;                 // hold onto tlab if free() is larger than this
   size_t    _allocated_before_last_gc;           // total bytes allocated up until the last gc
@@ -57,18 +58,19 @@ private:
   unsigned  _slow_allocations;
 
   AdaptiveWeightedAverage _allocation_fraction;  // fraction of eden allocated in tlabs
+  AdaptiveWeightedAverage _discard_waste_limit;  // refill waste limit at which tlabs got discarded
 
   void accumulate_statistics();
   void initialize_statistics();
 
   void set_start(HeapWord* start)                { _start = start; }
-  void set_end(HeapWord* end)                    { _end = end; }
+  void set_end(HeapWord* end)                    { _end = end; _allocation_end = end; }
   void set_top(HeapWord* top)                    { _top = top; }
   void set_pf_top(HeapWord* pf_top)              { _pf_top = pf_top; }
   void set_desired_size(size_t desired_size)     { _desired_size = desired_size; }
   void set_refill_waste_limit(size_t waste)      { _refill_waste_limit = waste;  }
 
-  size_t initial_refill_waste_limit()            { return desired_size() / TLABRefillWasteFraction; }
+  size_t initial_refill_waste_limit();
 
   static int    target_refills()                 { return _target_refills; }
   size_t initial_desired_size();
@@ -81,7 +83,7 @@ private:
   // Resize based on amount of allocation, etc.
   void resize();
 
-  void invariants() const { assert(top() >= start() && top() <= end(), "invalid tlab"); }
+  void invariants() const { assert(top() >= start() && top() <= end() && end() <= allocation_end(), "invalid tlab"); }
 
   void initialize(HeapWord* start, HeapWord* top, HeapWord* end);
 
@@ -101,7 +103,9 @@ private:
   static GlobalTLABStats* global_stats() { return _global_stats; }
 
 public:
-  ThreadLocalAllocBuffer() : _allocation_fraction(TLABAllocationWeight), _allocated_before_last_gc(0) {
+  ThreadLocalAllocBuffer() : _allocation_fraction(TLABAllocationWeight),
+                             _discard_waste_limit(TLABAllocationWeight),
+                             _allocated_before_last_gc(0) {
     // do nothing.  tlabs must be inited by initialize() calls
   }
 
@@ -111,13 +115,14 @@ public:
 
   HeapWord* start() const                        { return _start; }
   HeapWord* end() const                          { return _end; }
-  HeapWord* hard_end() const                     { return _end + alignment_reserve(); }
+  HeapWord* allocation_end() const               { return _allocation_end; }
+  HeapWord* hard_end() const                     { return _allocation_end + alignment_reserve(); }
   HeapWord* top() const                          { return _top; }
   HeapWord* pf_top() const                       { return _pf_top; }
   size_t desired_size() const                    { return _desired_size; }
   size_t used() const                            { return pointer_delta(top(), start()); }
   size_t used_bytes() const                      { return pointer_delta(top(), start(), 1); }
-  size_t free() const                            { return pointer_delta(end(), top()); }
+  size_t free() const                            { return pointer_delta(allocation_end(), top()); }
   // Don't discard tlab if remaining space is larger than this.
   size_t refill_waste_limit() const              { return _refill_waste_limit; }
 
@@ -143,6 +148,11 @@ public:
   // Initialization at startup
   static void startup_initialization();
 
+  // Heap sampling support: lower end() so that the allocation crossing the
+  // next sampling point takes the slow path, and undo that again there.
+  void set_sample_end(size_t bytes_until_sample);
+  void set_back_allocation_end()                 { _end = _allocation_end; }
+
   // Make an in-use tlab parsable, optionally also retiring it.
   void make_parsable(bool retire);
 
@@ -77,6 +77,7 @@
 #if INCLUDE_ALL_GCS
 #include "gc_implementation/concurrentMarkSweep/cmsAdaptiveSizePolicy.hpp"
 #include "gc_implementation/concurrentMarkSweep/cmsCollectorPolicy.hpp"
+#include "gc_implementation/epsilon/epsilonHeap.hpp"
 #include "gc_implementation/g1/g1CollectedHeap.inline.hpp"
 #include "gc_implementation/g1/g1CollectorPolicy_ext.hpp"
 #include "gc_implementation/parallelScavenge/parallelScavengeHeap.hpp"
@@ -815,6 +816,13 @@ jint Universe::initialize_heap() {
     fatal("UseG1GC not supported in java kernel vm.");
 #endif // INCLUDE_ALL_GCS
 
+  } else if (UseEpsilonGC) {
+#if INCLUDE_ALL_GCS
+    Universe::_collectedHeap = new EpsilonHeap(new EpsilonCollectorPolicy());
+#else  // INCLUDE_ALL_GCS
+    fatal("UseEpsilonGC not supported in this VM.");
+#endif // INCLUDE_ALL_GCS
+
   } else {
     GenCollectorPolicy *gc_policy;
 
@@ -29,6 +29,7 @@
 #include "classfile/verifier.hpp"
 #include "classfile/vmSymbols.hpp"
 #include "compiler/compileBroker.hpp"
+#include "compiler/hotMethods.hpp"
 #include "gc_implementation/shared/markSweep.inline.hpp"
 #include "gc_interface/collectedHeap.inline.hpp"
 #include "interpreter/oopMapCache.hpp"
@@ -938,6 +939,9 @@ void InstanceKlass::initialize_impl(instanceKlassHandle this_oop, TRAPS) {
     { ResourceMark rm(THREAD);
       debug_only(this_oop->vtable()->verify(tty, true);)
     }
+    if (HotMethods::has_methods()) {
+      HotMethods::class_initialized(this_oop, THREAD);
+    }
   }
   else {
     // Step 10 and 11
@@ -1131,6 +1135,11 @@ instanceOop InstanceKlass::register_finalizer(instanceOop i, TRAPS) {
     tty->print_cr(" (" INTPTR_FORMAT ") as finalizable", (address)i);
   }
   instanceHandle h_i(THREAD, i);
+  if (UseFastFinalizerRegistration && java_lang_ref_Finalizer::is_supported() &&
+      InstanceKlass::cast(SystemDictionary::Finalizer_klass())->is_initialized()) {
+    java_lang_ref_Finalizer::register_finalizee(h_i, CHECK_NULL);
+    return h_i();
+  }
   // Pass the handle as argument, JavaCalls::call expects oop as jobjects
   JavaValue result(T_VOID);
   JavaCallArguments args(h_i);
@@ -2884,6 +2893,21 @@ Method* InstanceKlass::method_at_itable(Klass* holder, int index, TRAPS) {
   return m;
 }
 
+Method* InstanceKlass::method_at_itable_or_null(Klass* holder, int index) {
+  itableOffsetEntry* ioe = (itableOffsetEntry*)start_of_itable();
+  int method_table_offset_in_words = ioe->offset()/wordSize;
+  int nof_interfaces = (method_table_offset_in_words - itable_offset_in_words())
+                       / itableOffsetEntry::size();
+
+  for (int cnt = 0; cnt < nof_interfaces; cnt++, ioe++) {
+    if (ioe->interface_klass() == holder) {
+      itableMethodEntry* ime = ioe->first_method_entry(this);
+      return ime[index].method();
+    }
+  }
+  return NULL;
+}
+
 
 #if INCLUDE_JVMTI
 // update default_methods for redefineclasses for methods that are
@@ -2930,8 +2954,25 @@ void InstanceKlass::add_osr_nmethod(nmethod* n) {
   // This is a short non-blocking critical region, so the no safepoint check is ok.
   OsrList_lock->lock_without_safepoint_check();
   assert(n->is_osr_method(), "wrong kind of nmethod");
-  n->set_osr_link(osr_nmethods_head());
-  set_osr_nmethods_head(n);
+  // Keep the osr nmethods of a method next to each other, so that
+  // lookup_osr_nmethod() can stop at the end of that run.
+  nmethod* prev = NULL;
+  nmethod* cur = osr_nmethods_head();
+  while (cur != NULL && cur->method() != n->method()) {
+    prev = cur;
+    cur = cur->osr_link();
+  }
+  if (cur == NULL) {
+    n->set_osr_link(osr_nmethods_head());
+    set_osr_nmethods_head(n);
+  } else {
+    n->set_osr_link(cur);
+    if (prev == NULL) {
+      set_osr_nmethods_head(n);
+    } else {
+      prev->set_osr_link(n);
+    }
+  }
   // Raise the highest osr level if necessary
   if (TieredCompilation) {
     Method* m = n->method();
@@ -3005,6 +3046,8 @@ int InstanceKlass::mark_osr_nmethods(const Method* m) {
     if (osr->method() == m) {
       osr->mark_for_deoptimization();
       found++;
+    } else if (found > 0) {
+      break;  // past the osr nmethods of m
     }
     osr = osr->osr_link();
   }
@@ -3012,10 +3055,20 @@ int InstanceKlass::mark_osr_nmethods(const Method* m) {
 }
 
 nmethod* InstanceKlass::lookup_osr_nmethod(const Method* m, int bci, int comp_level, bool match_level) const {
+  // With tiered compilation the highest level of the osr nmethods of m is
+  // kept up to date in its MethodCounters, which rules out most lookups,
+  // e.g. those from the interpreter's backedge overflows, without the lock.
+  if (TieredCompilation && m->method_counters() != NULL) {
+    int highest = m->highest_osr_comp_level();
+    if (highest == CompLevel_none || comp_level > highest) {
+      return NULL;
+    }
+  }
   // This is a short non-blocking critical region, so the no safepoint check is ok.
   OsrList_lock->lock_without_safepoint_check();
   nmethod* osr = osr_nmethods_head();
   nmethod* best = NULL;
+  bool seen = false;
   while (osr != NULL) {
     assert(osr->is_osr_method(), "wrong kind of nmethod found in chain");
     // There can be a time when a c1 osr method exists but we are waiting
@@ -3024,8 +3077,15 @@ nmethod* InstanceKlass::lookup_osr_nmethod(const Method* m, int bci, int comp_le
     // while we overflow in the c1 code at back branches we don't want to
     // try and switch to the same code as we are already running
 
-    if (osr->method() == m &&
-        (bci == InvocationEntryBci || osr->osr_entry_bci() == bci)) {
+    if (osr->method() != m) {
+      if (seen) {
+        break;  // past the osr nmethods of m
+      }
+      osr = osr->osr_link();
+      continue;
+    }
+    seen = true;
+    if (bci == InvocationEntryBci || osr->osr_entry_bci() == bci) {
       if (match_level) {
         if (osr->comp_level() == comp_level) {
           // Found a match - return it.
@@ -997,6 +997,9 @@ class InstanceKlass: public Klass {
   inline Method* method_at_vtable(int index);
   klassItable* itable() const;        // return new klassItable wrapper
   Method* method_at_itable(Klass* holder, int index, TRAPS);
+  // Like method_at_itable, but returns NULL instead of throwing when the
+  // receiver does not implement holder or the itable entry is empty.
+  Method* method_at_itable_or_null(Klass* holder, int index);
 
 #if INCLUDE_JVMTI
   void adjust_default_methods(InstanceKlass* holder, bool* trace_name_printed);
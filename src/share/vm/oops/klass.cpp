@@ -206,6 +206,7 @@ Klass::Klass() {
   // The klass doesn't have any references at this point.
   clear_modified_oops();
   clear_accumulated_modified_oops();
+  clear_pretenure_info();
   _shared_class_path_index = -1;
 }
 
@@ -528,6 +529,7 @@ void Klass::remove_unshareable_info() {
 
   set_subklass(NULL);
   set_next_sibling(NULL);
+  clear_pretenure_info();
   // Clear the java mirror
   set_java_mirror(NULL);
   set_next_link(NULL);
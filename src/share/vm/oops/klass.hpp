@@ -80,6 +80,9 @@
 //    [biased_lock_revocation_count]
 //    [_modified_oops]
 //    [_accumulated_modified_oops]
+//    [_survivor_copied_words]
+//    [_survivor_recopied_words]
+//    [_should_pretenure]
 //    [trace_id]
 
 
@@ -176,6 +179,13 @@ class Klass : public Metadata {
   jbyte _modified_oops;             // Card Table Equivalent (YC/CMS support)
   jbyte _accumulated_modified_oops; // Mod Union Equivalent (CMS support)
 
+  // Survivor copying statistics for PretenureLongLivedClasses. The young
+  // collectors update them without synchronization; a lost update only
+  // delays a decision.
+  juint _survivor_copied_words;     // Words copied since the last decision
+  juint _survivor_recopied_words;   // ... of which already had survived a GC
+  bool  _should_pretenure;          // Promote instances at their first survival
+
 private:
   // This is an index into FileMapHeader::_classpath_entry_table[], to
   // associate this class with the JAR file where it's loaded from during
@@ -295,6 +305,19 @@ protected:
   void clear_accumulated_modified_oops() { _accumulated_modified_oops = 0; }
   bool has_accumulated_modified_oops()   { return _accumulated_modified_oops == 1; }
 
+  // Pretenuring of long-lived classes (PretenureLongLivedClasses). The
+  // young collectors record every copy of an instance into a survivor
+  // space; once PretenureSampleWords have been copied, the class is
+  // pretenured if at least PretenureSurvivalPercent of them were copies of
+  // objects that had survived before.
+  bool should_pretenure() const          { return _should_pretenure; }
+  inline void record_survivor_copy(uint age, size_t words);
+  void clear_pretenure_info() {
+    _survivor_copied_words = 0;
+    _survivor_recopied_words = 0;
+    _should_pretenure = false;
+  }
+
   int shared_classpath_index() const   {
     return _shared_class_path_index;
   };
@@ -34,6 +34,19 @@ inline void Klass::set_prototype_header(markOop header) {
   _prototype_header = header;
 }
 
+inline void Klass::record_survivor_copy(uint age, size_t words) {
+  juint copied = _survivor_copied_words + (juint)words;
+  juint recopied = _survivor_recopied_words + (age > 0 ? (juint)words : 0);
+  if (copied < PretenureSampleWords) {
+    _survivor_copied_words = copied;
+    _survivor_recopied_words = recopied;
+  } else {
+    _should_pretenure = (julong)recopied * 100 >= (julong)copied * PretenureSurvivalPercent;
+    _survivor_copied_words = 0;
+    _survivor_recopied_words = 0;
+  }
+}
+
 inline bool Klass::is_null(Klass* obj)  { return obj == NULL; }
 inline bool Klass::is_null(narrowKlass obj) { return obj == 0; }
 
@@ -162,6 +162,50 @@ int klassVtable::initialize_from_super(KlassHandle super) {
 
 //
 // Revised lookup semantics   introduced 1.3 (Kestrel beta)
+// Chains the super vtable entries by a hash of their name and signature,
+// so that looking for the entries a method may override does not scan
+// the entire super vtable for every method of the class.  Overriding
+// keeps name and signature, so the chains stay valid while the vtable
+// is being filled in.  Each chain is in increasing vtable index order.
+class SuperVtableIndex : public ResourceObj {
+ private:
+  int  _mask;
+  int* _buckets;
+  int* _next;
+
+  static int hash(Symbol* name, Symbol* signature) {
+    return name->identity_hash() ^ (signature->identity_hash() * 31);
+  }
+
+ public:
+  SuperVtableIndex(klassVtable* super_vtable, int super_vtable_len) {
+    int size = 16;
+    while (size < super_vtable_len) {
+      size <<= 1;
+    }
+    _mask = size - 1;
+    _buckets = NEW_RESOURCE_ARRAY(int, size);
+    _next = NEW_RESOURCE_ARRAY(int, super_vtable_len);
+    for (int i = 0; i < size; i++) {
+      _buckets[i] = -1;
+    }
+    // Insert in reverse so that each chain is in increasing index order
+    for (int i = super_vtable_len - 1; i >= 0; i--) {
+      Method* m = super_vtable->method_at(i);
+      int b = hash(m->name(), m->signature()) & _mask;
+      _next[i] = _buckets[b];
+      _buckets[b] = i;
+    }
+  }
+
+  // First candidate index for name/signature, or -1.  Candidates may
+  // have a different name or signature; the caller has to check.
+  int first(Symbol* name, Symbol* signature) const {
+    return _buckets[hash(name, signature) & _mask];
+  }
+  int next(int index) const { return _next[index]; }
+};
+
 void klassVtable::initialize_vtable(bool checkconstraints, TRAPS) {
 
   // Note:  Arrays can have intermediate array supers.  Use java_super to skip them.
@@ -194,6 +238,12 @@ void klassVtable::initialize_vtable(bool checkconstraints, TRAPS) {
   } else {
     assert(_klass->oop_is_instance(), "must be InstanceKlass");
 
+    ResourceMark rm(THREAD);
+    SuperVtableIndex* super_index = NULL;
+    if (super_vtable_len > 0) {
+      super_index = new SuperVtableIndex(super->vtable(), super_vtable_len);
+    }
+
     Array<Method*>* methods = ik()->methods();
     int len = methods->length();
     int initialized = super_vtable_len;
@@ -206,7 +256,8 @@ void klassVtable::initialize_vtable(bool checkconstraints, TRAPS) {
       assert(methods->at(i)->is_method(), "must be a Method*");
       methodHandle mh(THREAD, methods->at(i));
 
-      bool needs_new_entry = update_inherited_vtable(ik(), mh, super_vtable_len, -1, checkconstraints, CHECK);
+      bool needs_new_entry = update_inherited_vtable(ik(), mh, super_vtable_len, -1, checkconstraints,
+                                                     super_index, CHECK);
 
       if (needs_new_entry) {
         put_method_at(mh(), initialized);
@@ -232,7 +283,8 @@ void klassVtable::initialize_vtable(bool checkconstraints, TRAPS) {
           assert(default_methods->at(i)->is_method(), "must be a Method*");
           methodHandle mh(THREAD, default_methods->at(i));
 
-          bool needs_new_entry = update_inherited_vtable(ik(), mh, super_vtable_len, i, checkconstraints, CHECK);
+          bool needs_new_entry = update_inherited_vtable(ik(), mh, super_vtable_len, i, checkconstraints,
+                                                         super_index, CHECK);
 
           // needs new entry
           if (needs_new_entry) {
@@ -337,7 +389,8 @@ InstanceKlass* klassVtable::find_transitive_override(InstanceKlass* initialsuper
 // If that changed, could not use _klass as handle for klass
 bool klassVtable::update_inherited_vtable(InstanceKlass* klass, methodHandle target_method,
                                           int super_vtable_len, int default_index,
-                                          bool checkconstraints, TRAPS) {
+                                          bool checkconstraints,
+                                          const SuperVtableIndex* super_index, TRAPS) {
   ResourceMark rm;
   bool allocate_new = true;
   assert(klass->oop_is_instance(), "must be InstanceKlass");
@@ -417,7 +470,10 @@ bool klassVtable::update_inherited_vtable(InstanceKlass* klass, methodHandle tar
   Handle target_loader(THREAD, target_klass->class_loader());
 
   Symbol* target_classname = target_klass->name();
-  for(int i = 0; i < super_vtable_len; i++) {
+  if (super_index == NULL) {
+    return allocate_new;
+  }
+  for (int i = super_index->first(name, signature); i >= 0; i = super_index->next(i)) {
     Method* super_method;
     if (is_preinitialized_vtable()) {
       // If this is a shared class, the vtable is already in the final state (fully
@@ -40,6 +40,7 @@
 // not preserved across GCs.
 
 class vtableEntry;
+class SuperVtableIndex;
 
 class klassVtable : public ResourceObj {
   KlassHandle  _klass;            // my klass
@@ -118,7 +119,8 @@ class klassVtable : public ResourceObj {
   void put_method_at(Method* m, int index);
   static bool needs_new_vtable_entry(methodHandle m, Klass* super, Handle classloader, Symbol* classname, AccessFlags access_flags, TRAPS);
 
-  bool update_inherited_vtable(InstanceKlass* klass, methodHandle target_method, int super_vtable_len, int default_index, bool checkconstraints, TRAPS);
+  bool update_inherited_vtable(InstanceKlass* klass, methodHandle target_method, int super_vtable_len, int default_index, bool checkconstraints,
+                               const SuperVtableIndex* super_index, TRAPS);
  InstanceKlass* find_transitive_override(InstanceKlass* initialsuper, methodHandle target_method, int vtable_index,
                                          Handle target_loader, Symbol* target_classname, Thread* THREAD);
 
@@ -284,8 +284,9 @@ address Method::bcp_from(int bci) const {
 
 
 int Method::size(bool is_native) {
-  // If native, then include pointers for native_function and signature_handler
-  int extra_bytes = (is_native) ? 2*sizeof(address*) : 0;
+  // If native, then include pointers for native_function, signature_handler
+  // and critical_native_function
+  int extra_bytes = (is_native) ? 3*sizeof(address*) : 0;
   int extra_words = align_size_up(extra_bytes, BytesPerWord) / BytesPerWord;
   return align_object_size(header_size() + extra_words);
 }
@@ -724,14 +725,29 @@ void Method::clear_native_function() {
   set_native_function(
     SharedRuntime::native_method_throw_unsatisfied_link_error_entry(),
     !native_bind_event_is_interesting);
+  *critical_native_function_addr() = NULL;
   clear_code();
 }
 
 address Method::critical_native_function() {
+  address registered = *critical_native_function_addr();
+  if (registered != NULL) {
+    return CriticalJNINatives ? registered : NULL;
+  }
   methodHandle mh(this);
   return NativeLookup::lookup_critical_entry(mh);
 }
 
+void Method::set_critical_native_function(address function) {
+  *critical_native_function_addr() = function;
+  // The native wrapper picks the critical entry when it is generated, so
+  // an existing wrapper has to be regenerated.
+  nmethod* nm = code();
+  if (nm != NULL) {
+    nm->make_not_entrant();
+  }
+}
+
 
 void Method::set_signature_handler(address handler) {
   address* signature_handler =  signature_handler_addr();
@@ -870,6 +886,7 @@ void Method::unlink_method() {
   if (is_native()) {
     *native_function_addr() = NULL;
     set_signature_handler(NULL);
+    *critical_native_function_addr() = NULL;
   }
   NOT_PRODUCT(set_compiled_invocation_count(0);)
   _adapter = NULL;
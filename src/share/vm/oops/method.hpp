@@ -490,6 +490,8 @@ class Method : public Metadata {
   };
   address native_function() const                { return *(native_function_addr()); }
   address critical_native_function();
+  // Set by RegisterNatives; takes precedence over JavaCritical_ lookup.
+  void set_critical_native_function(address function);
 
   // Must specify a real function (not NULL).
   // Use clear_native_function() to unregister.
@@ -916,6 +918,7 @@ class Method : public Metadata {
   // Inlined elements
   address* native_function_addr() const          { assert(is_native(), "must be native"); return (address*) (this+1); }
   address* signature_handler_addr() const        { return native_function_addr() + 1; }
+  address* critical_native_function_addr() const { return native_function_addr() + 2; }
 };
 
 
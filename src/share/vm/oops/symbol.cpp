@@ -35,7 +35,8 @@
 Symbol::Symbol(const u1* name, int length, int refcount) {
   _refcount = refcount;
   _length = length;
-  _identity_hash = os::random();
+  _identity_hash = (os::random() & ~ascii_bit) |
+                   (UTF8::is_ascii((const char*)name, length) ? ascii_bit : 0);
   for (int i = 0; i < _length; i++) {
     byte_at_put(i, name[i]);
   }
@@ -170,7 +171,7 @@ char* Symbol::as_quoted_ascii() const {
 
 jchar* Symbol::as_unicode(int& length) const {
   Symbol* this_ptr = (Symbol*)this;
-  length = UTF8::unicode_length((char*)this_ptr->bytes(), utf8_length());
+  length = is_ascii() ? utf8_length() : UTF8::unicode_length((char*)this_ptr->bytes(), utf8_length());
   jchar* result = NEW_RESOURCE_ARRAY(jchar, length);
   if (length > 0) {
     UTF8::convert_to_unicode((char*)this_ptr->bytes(), result, length);
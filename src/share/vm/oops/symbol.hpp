@@ -122,7 +122,10 @@ class Symbol : private SymbolBase {
 
   enum {
     // max_symbol_length is constrained by type of _length
-    max_symbol_length = (1 << 16) -1
+    max_symbol_length = (1 << 16) -1,
+    // the low bit of _identity_hash is set for symbols without
+    // multibyte characters
+    ascii_bit = 1
   };
 
   static int size(int length) {
@@ -170,6 +173,10 @@ class Symbol : private SymbolBase {
 
   int utf8_length() const { return _length; }
 
+  // True if every utf8 byte is a character, so that the unicode length
+  // is the utf8 length and conversion is a widening copy.
+  bool is_ascii() const { return (_identity_hash & ascii_bit) != 0; }
+
   // Compares the symbol with a string.
   bool equals(const char* str, int len) const;
   bool equals(const char* str) const { return equals(str, (int) strlen(str)); }
@@ -1386,6 +1386,11 @@ extern "C" int trace_frequency_order(const void *p0, const void *p1) {
     return b1->is_connector() ? -1 : 1;
   }
 
+  // Cold traces go after all the code that is expected to run
+  if (tr0->is_cold() != tr1->is_cold()) {
+    return tr1->is_cold() ? -1 : 1;
+  }
+
   // Pull more frequently executed blocks to the beginning
   float freq0 = b0->_freq;
   float freq1 = b1->_freq;
@@ -1625,6 +1630,12 @@ void PhaseBlockLayout::reorder_traces(int count) {
   Trace *tr = trace(_cfg.get_root_block());
   assert(tr == new_traces[0], "entry trace misplaced");
 
+  if (BlockLayoutSplitCold) {
+    for (int i = 1; i < new_count; i++) {
+      new_traces[i]->compute_cold(_cfg);
+    }
+  }
+
   // Sort the new trace list by frequency
   qsort(new_traces + 1, new_count - 1, sizeof(new_traces[0]), trace_frequency_order);
 
@@ -1638,6 +1649,21 @@ void PhaseBlockLayout::reorder_traces(int count) {
   }
 }
 
+// A trace is cold when none of its blocks is expected to execute, so it
+// can be moved away from the hot code without lengthening any hot path.
+void Trace::compute_cold(PhaseCFG &cfg) {
+  _cold = false;
+  if (first_block()->is_connector()) {
+    return;
+  }
+  for (Block *b = first_block(); b != NULL; b = next(b)) {
+    if (!b->is_connector() && !cfg.is_uncommon(b)) {
+      return;
+    }
+  }
+  _cold = true;
+}
+
 // Order basic blocks based on frequency
 PhaseBlockLayout::PhaseBlockLayout(PhaseCFG &cfg)
 : Phase(BlockLayout)
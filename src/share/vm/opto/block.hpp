@@ -770,6 +770,7 @@ class Trace : public ResourceObj {
   Block ** _prev_list;  // Array mapping index to previous block
   Block * _first;       // First block in the trace
   Block * _last;        // Last block in the trace
+  bool _cold;           // Every block in the trace is uncommon
 
   // Return the block that follows "b" in the trace.
   Block * next(Block *b) const { return _next_list[b->_pre_order]; }
@@ -795,6 +796,7 @@ class Trace : public ResourceObj {
     _last(b),
     _next_list(next_list),
     _prev_list(prev_list),
+    _cold(false),
     _id(b->_pre_order) {
     set_next(b, NULL);
     set_prev(b, NULL);
@@ -810,6 +812,10 @@ class Trace : public ResourceObj {
   // Return the last block in the trace
   Block * last_block() const { return _last; }
 
+  // Cold traces are laid out after all the others
+  bool is_cold() const { return _cold; }
+  void compute_cold(PhaseCFG &cfg);
+
   // Insert a trace in the middle of this one after b
   void insert_after(Block *b, Trace *tr) {
     set_next(tr->last_block(), next(b));
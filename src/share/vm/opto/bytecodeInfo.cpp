@@ -102,6 +102,17 @@ static bool is_unboxing_method(ciMethod* callee_method, Compile* C) {
   return C->eliminate_boxing() && callee_method->is_unboxing_method();
 }
 
+/**
+ *  Return true when the profile says the call site is executed often,
+ *  either relative to the invocations of the caller or in absolute terms.
+ */
+static bool is_frequent_call_site(ciMethod* caller_method, ciCallProfile& profile) {
+  int call_site_count = caller_method->scale_count(profile.count());
+  int invoke_count    = caller_method->interpreter_invocation_count();
+  int freq = (invoke_count > 0) ? call_site_count / invoke_count : 0;
+  return (freq >= InlineFrequencyRatio) || (call_site_count >= InlineFrequencyCount);
+}
+
 // positive filter: should callee be inlined?
 bool InlineTree::should_inline(ciMethod* callee_method, ciMethod* caller_method,
                                int caller_bci, ciCallProfile& profile,
@@ -158,8 +169,7 @@ bool InlineTree::should_inline(ciMethod* callee_method, ciMethod* caller_method,
   int freq = call_site_count / invoke_count;
 
   // bump the max size if the call is frequent
-  if ((freq >= InlineFrequencyRatio) ||
-      (call_site_count >= InlineFrequencyCount) ||
+  if (is_frequent_call_site(method(), profile) ||
       is_unboxing_method(callee_method, C) ||
       is_init_with_ea(callee_method, caller_method, C)) {
 
@@ -430,6 +440,19 @@ bool InlineTree::try_to_inline(ciMethod* callee_method, ciMethod* caller_method,
     }
   }
 
+  // Call sites are visited in parse order, not in order of hotness, so
+  // keep part of the DesiredMethodLimit budget for frequent call sites
+  // that may come later and stop inlining infrequent ones past that point.
+  if (ClipInlining && ColdCallSiteInlineBudget < 100 &&
+      callee_method->code_size() > MaxTrivialSize &&
+      !forced_inline() && !callee_method->force_inline() &&
+      !is_frequent_call_site(method(), profile) &&
+      (int)C->ilt()->count_inline_bcs() + size >=
+        DesiredMethodLimit * ColdCallSiteInlineBudget / 100) {
+    set_msg("cold call site over inlining budget");
+    return false;
+  }
+
   // ok, inline this method
   return true;
 }
@@ -208,6 +208,15 @@
   product(bool, UseCountedLoopSafepoints, false,                            \
           "Force counted loops to keep a safepoint")                        \
                                                                             \
+  product(uintx, LoopStripMiningIter, 0,                                    \
+          "Number of iterations of a counted loop between safepoint polls " \
+          "when UseCountedLoopSafepoints is on (0 or 1: poll every "        \
+          "iteration)")                                                     \
+                                                                            \
+  product(bool, ConvertLongLoopsToInt, true,                                \
+          "Turn loops with a long trip counter that provably stays in int " \
+          "range into int counted loops")                                   \
+                                                                            \
   product(bool, UseLoopPredicate, true,                                     \
           "Generate a predicate to select fast/slow loop versions")         \
                                                                             \
@@ -242,6 +251,11 @@
   develop(bool, OptoCoalesce, true,                                         \
           "Use Conservative Copy Coalescing in the Register Allocator")     \
                                                                             \
+  product(intx, RegAllocCheapNodeLimit, 40000,                              \
+          "Skip conservative coalescing in the split-recycle rounds of "    \
+          "the register allocator for methods with more live nodes "        \
+          "than this; 0 disables")                                          \
+                                                                            \
   develop(bool, UseUniqueSubclasses, true,                                  \
           "Narrow an abstract reference to the unique concrete subclass")   \
                                                                             \
@@ -321,6 +335,10 @@
   product(bool, UseSuperWord, true,                                         \
           "Transform scalar operations into superword operations")          \
                                                                             \
+  product(bool, SuperWordReductions, true,                                  \
+          "Vectorize reductions (sum, product, and, or, xor) carried "      \
+          "around the loop back edge")                                      \
+                                                                            \
   develop(bool, SuperWordRTDepCheck, false,                                 \
           "Enable runtime dependency checks.")                              \
                                                                             \
@@ -369,6 +387,14 @@
   product(bool, UseOnlyInlinedBimorphic, true,                              \
           "Don't use BimorphicInlining if can't inline a second method")    \
                                                                             \
+  product(bool, UsePolymorphicInlining, true,                               \
+          "Profiling based inlining for more than two receivers "           \
+          "using a tree of type checks")                                    \
+                                                                            \
+  product(intx, PolymorphicInlineLimit, 4,                                  \
+          "Max number of profiled receivers dispatched by type checks "     \
+          "at a call site (needs TypeProfileWidth at least as large)")      \
+                                                                            \
   product(bool, InsertMemBarAfterArraycopy, true,                           \
           "Insert memory barrier after arraycopy call")                     \
                                                                             \
@@ -446,6 +472,11 @@
   product(bool, EliminateNestedLocks, true,                                 \
           "Eliminate nested locks of the same object when possible")        \
                                                                             \
+  product(intx, LockCoarseningUnrollLimit, 4,                               \
+          "Max factor a loop locking a loop invariant object is unrolled "  \
+          "by so that lock coarsening can merge adjacent iterations; "      \
+          "bounds the iterations run under one lock. 0 disables")           \
+                                                                            \
   notproduct(bool, PrintLockStatistics, false,                              \
           "Print precise statistics on the dynamic lock usage")             \
                                                                             \
@@ -488,6 +519,10 @@
   product(bool, EliminateAllocations, true,                                 \
           "Use escape analysis to eliminate allocations")                   \
                                                                             \
+  product(bool, PartialEscapeAnalysis, true,                                \
+          "Move allocations which escape only through a call on an "        \
+          "unlikely path next to that call")                                \
+                                                                            \
   notproduct(bool, PrintEliminateAllocations, false,                        \
           "Print out when allocations are eliminated")                      \
                                                                             \
@@ -531,6 +566,10 @@
   product(bool, BlockLayoutRotateLoops, true,                               \
           "Allow back branches to be fall throughs in the block layour")    \
                                                                             \
+  product(bool, BlockLayoutSplitCold, true,                                 \
+          "Place traces made only of uncommon blocks (traps, slow paths, "  \
+          "exception paths) after all other code of the method")            \
+                                                                            \
   develop(bool, InlineReflectionGetCallerClass, true,                       \
           "inline sun.reflect.Reflection.getCallerClass(), known to be part "\
           "of base library DLL")                                            \
@@ -653,6 +692,11 @@
   product(intx, LiveNodeCountInliningCutoff, 40000,                         \
           "max number of live nodes in a method")                           \
                                                                             \
+  product(intx, ColdCallSiteInlineBudget, 75,                               \
+          "Percentage of DesiredMethodLimit that inlining at infrequent "   \
+          "call sites may use; the rest is kept for frequent call sites "   \
+          "(100 disables the reservation)")                                 \
+                                                                            \
   diagnostic(bool, OptimizeExpensiveOps, true,                              \
           "Find best control for expensive operations")                     \
                                                                             \
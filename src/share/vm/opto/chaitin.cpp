@@ -338,6 +338,14 @@ void PhaseChaitin::Register_Allocate() {
   _alternate = 0;
   _matcher._allocation_started = true;
 
+  // For huge methods most of the allocation time goes into rebuilding
+  // the IFG and coalescing it again on every split-recycle round.  Trade
+  // a few extra copies for compile time there and only coalesce once.
+  bool cheap_recycle = RegAllocCheapNodeLimit > 0 && C->live_nodes() > (uint)RegAllocCheapNodeLimit;
+  if (cheap_recycle && C->log() != NULL) {
+    C->log()->elem("regalloc_cheap_recycle live_nodes='%d'", C->live_nodes());
+  }
+
   ResourceArea split_arena(mtCompiler);     // Arena for Split local resources
   ResourceArea live_arena(mtCompiler);      // Arena for liveness & IFG info
   ResourceMark rm(&live_arena);
@@ -547,7 +555,7 @@ void PhaseChaitin::Register_Allocate() {
     _ifg->Compute_Effective_Degree();
 
     // Only do conservative coalescing if requested
-    if (OptoCoalesce) {
+    if (OptoCoalesce && !cheap_recycle) {
       // Conservative (and pessimistic) copy coalescing
       PhaseConservativeCoalesce coalesce(*this);
       // Check for few live ranges determines how aggressive coalesce is.
@@ -300,6 +300,17 @@ macro(URShiftVL)
 macro(AndV)
 macro(OrV)
 macro(XorV)
+macro(VectorCastI2F)
+macro(AddReductionVI)
+macro(AddReductionVL)
+macro(AddReductionVF)
+macro(AddReductionVD)
+macro(MulReductionVI)
+macro(MulReductionVF)
+macro(MulReductionVD)
+macro(AndReductionV)
+macro(OrReductionV)
+macro(XorReductionV)
 macro(LoadVector)
 macro(StoreVector)
 macro(Pack)
@@ -1059,6 +1059,7 @@ Compile::Compile( ciEnv* ci_env,
 // Prepare for a single compilation
 void Compile::Init(int aliaslevel) {
   _unique  = 0;
+  clear_free_node_storage();
   _regalloc = NULL;
 
   _tf      = NULL;  // filled in later
@@ -2151,11 +2152,37 @@ void Compile::Optimize() {
   // Perform escape analysis
   if (_do_escape_analysis && ConnectionGraph::has_candidates(this)) {
     if (has_loops()) {
-      // Cleanup graph (remove dead nodes).
+      // Cleanup graph (remove dead nodes). With EliminateAllocations also
+      // fully unroll small loops first: allocations accessed at the trip
+      // counter get constant indices and become scalar replaceable.
       TracePhase t2("idealLoop", &_t_idealLoop, true);
-      PhaseIdealLoop ideal_loop( igvn, false, true );
+      // Each pass doubles the bodies; policy_maximally_unroll caps the
+      // trip count at 4 * LoopUnrollLimit.
+      bool max_unroll = EliminateAllocations && (num_loop_opts() > 0);
+      int max_passes = max_unroll ? log2_intptr(LoopUnrollLimit * 4) + 1 : 1;
+      for (int pass = 1; ; pass++) {
+        PhaseIdealLoop ideal_loop( igvn, false, true, max_unroll );
+        if (failing())  return;
+        if (ideal_loop.max_unrolled_loops() == 0 || pass >= max_passes) {
+          break;
+        }
+      }
       if (major_progress()) print_method(PHASE_PHASEIDEAL_BEFORE_EA, 2);
-      if (failing())  return;
+    }
+    if (PartialEscapeAnalysis && EliminateAllocations) {
+      for_igvn()->clear();
+      initial_gvn()->replace_with(&igvn);
+
+      if (ConnectionGraph::sink_partial_escapes(this)) {
+        if (failing())  return;
+        {
+          ResourceMark rm;
+          PhaseRemoveUseless pru(initial_gvn(), for_igvn());
+        }
+        igvn = PhaseIterGVN(initial_gvn());
+        igvn.optimize();
+        if (failing())  return;
+      }
     }
     ConnectionGraph::do_analysis(this, &igvn);
 
@@ -3379,6 +3406,12 @@ bool Compile::too_many_traps(ciMethod* method,
                   Deoptimization::trap_reason_name(reason),
                   md->trap_count(reason));
     return true;
+  } else if (PerBytecodeTrapHistory &&
+             Deoptimization::reason_recorded_per_bytecode_if_any(reason) != Deoptimization::Reason_none) {
+    // The per-BCI record proves that this site never trapped for this
+    // reason; traps elsewhere in the method must not disable the
+    // optimization here.
+    return false;
   } else {
     // Ignore method/bci and see if there have been too many globally.
     return too_many_traps(reason, md);
@@ -3601,6 +3634,23 @@ void Compile::record_failure(const char* reason) {
   _root = NULL;  // flush the graph, too
 }
 
+// Give back the storage of a destructed Node. Storage at the top of the
+// node arena is returned to it, other Node sized blocks are kept for reuse
+// by alloc_node_storage(). Old-space Nodes are ignored, the matcher frees
+// them with the old arena.
+void Compile::free_node_storage(void* p, size_t x) {
+  if ((char*)p + x == _node_arena.hwm()) {
+    _node_arena.Afree(p, x);
+    return;
+  }
+  size_t words = x / BytesPerWord;
+  if (words > 0 && words <= max_free_node_words &&
+      words * BytesPerWord == x && _node_arena.contains(p)) {
+    *(void**)p = _free_nodes[words];
+    _free_nodes[words] = p;
+  }
+}
+
 Compile::TracePhase::TracePhase(const char* name, elapsedTimer* accumulator, bool dolog)
   : TraceTime(NULL, accumulator, false NOT_PRODUCT( || TimeCompiler ), false),
     _phase_name(name), _dolog(dolog)
@@ -3614,11 +3664,20 @@ Compile::TracePhase::TracePhase(const char* name, elapsedTimer* accumulator, boo
   }
   if (_log != NULL) {
     _log->begin_head("phase name='%s' nodes='%d' live='%d'", _phase_name, C->unique(), C->live_nodes());
+    log_arena_sizes();
     _log->stamp();
     _log->end_head();
   }
 }
 
+// Memory held by the compilation, so that LogCompilation output shows
+// which phases grow the arenas.
+void Compile::TracePhase::log_arena_sizes() {
+  _log->print(" node_arena='" SIZE_FORMAT "' comp_arena='" SIZE_FORMAT "' resource_area='" SIZE_FORMAT "'",
+              C->node_arena()->size_in_bytes(), C->comp_arena()->size_in_bytes(),
+              Thread::current()->resource_area()->size_in_bytes());
+}
+
 Compile::TracePhase::~TracePhase() {
 
   C = Compile::current();
@@ -3640,7 +3699,11 @@ Compile::TracePhase::~TracePhase() {
 #endif
 
   if (_log != NULL) {
-    _log->done("phase name='%s' nodes='%d' live='%d'", _phase_name, C->unique(), C->live_nodes());
+    _log->begin_elem("phase_done name='%s' nodes='%d' live='%d'", _phase_name, C->unique(), C->live_nodes());
+    log_arena_sizes();
+    _log->stamp();
+    _log->end_elem();
+    _log->tail("phase");
   }
 }
 
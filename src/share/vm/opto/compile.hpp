@@ -109,6 +109,7 @@ class Compile : public Phase {
     CompileLog* _log;
     const char* _phase_name;
     bool _dolog;
+    void log_arena_sizes();
    public:
     TracePhase(const char* name, elapsedTimer* accumulator, bool dolog);
     ~TracePhase();
@@ -352,6 +353,8 @@ class Compile : public Phase {
   debug_only(static int _debug_idx;)            // Monotonic counter (not reset), use -XX:BreakAtNode=<idx>
   Arena                 _node_arena;            // Arena for new-space Nodes
   Arena                 _old_arena;             // Arena for old-space Nodes, lifetime during xform
+  enum { max_free_node_words = 32 };
+  void*                 _free_nodes[max_free_node_words + 1]; // Destructed Node storage, listed by size in words
   RootNode*             _root;                  // Unique root of compilation, or NULL after bail-out.
   Node*                 _top;                   // Unique top node.  (Reset by various phases.)
 
@@ -760,6 +763,20 @@ class Compile : public Phase {
   static void  set_debug_idx(int i)        { debug_only(_debug_idx = i); }
   Arena*       node_arena()                { return &_node_arena; }
   Arena*       old_arena()                 { return &_old_arena; }
+
+  // Storage for a new Node, reusing that of a destructed Node of the same size.
+  void*        alloc_node_storage(size_t x) {
+    size_t words = x / BytesPerWord;
+    if (words <= max_free_node_words && _free_nodes[words] != NULL) {
+      void* p = _free_nodes[words];
+      _free_nodes[words] = *(void**)p;
+      return p;
+    }
+    return _node_arena.Amalloc_D(x);
+  }
+  void         free_node_storage(void* p, size_t x);
+  // Must be called when the contents of the node arena are moved or freed.
+  void         clear_free_node_storage()   { memset(_free_nodes, 0, sizeof(_free_nodes)); }
   RootNode*    root() const                { return _root; }
   void         set_root(RootNode* r)       { _root = r; }
   StartNode*   start() const;              // (Derived from root.)
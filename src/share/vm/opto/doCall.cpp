@@ -61,6 +61,59 @@ void trace_type_profile(Compile* C, ciMethod *method, int depth, int bci, ciMeth
   }
 }
 
+// Build a tree of type checks for a call site whose profile recorded every
+// receiver seen and more than two of them.  Receivers are checked in order
+// of decreasing frequency so the common ones are found first.  The miss path
+// is an uncommon trap; once it has trapped too often the site is recompiled
+// with a virtual call on the miss path instead.
+static CallGenerator* polymorphic_call_generator(Compile* C, ciMethod* callee, int vtable_index,
+                                                 JVMState* jvms, bool allow_inline, float prof_factor,
+                                                 ciCallProfile& profile, int morphism) {
+  assert(morphism > 2 && morphism <= ciCallProfile::MorphismLimit, "not a polymorphic profile");
+  ciMethod* caller = jvms->method();
+  int       bci    = jvms->bci();
+  CallGenerator* hit_cg[ciCallProfile::MorphismLimit];
+  ciMethod*      receiver_method[ciCallProfile::MorphismLimit];
+  int inlined = 0;
+  for (int i = 0; i < morphism; i++) {
+    receiver_method[i] = callee->resolve_invoke(caller->holder(), profile.receiver(i));
+    if (receiver_method[i] == NULL) {
+      return NULL;
+    }
+    hit_cg[i] = C->call_generator(receiver_method[i], vtable_index, false, jvms,
+                                  allow_inline, prof_factor);
+    if (hit_cg[i] == NULL) {
+      return NULL;
+    }
+    if (hit_cg[i]->is_inline()) {
+      inlined++;
+    }
+  }
+  if (inlined == 0) {
+    // Nothing to gain over a plain virtual call.
+    return NULL;
+  }
+
+  CallGenerator* cg;
+  if (!C->too_many_traps(caller, bci, Deoptimization::Reason_bimorphic)) {
+    cg = CallGenerator::for_uncommon_trap(callee, Deoptimization::Reason_bimorphic,
+                                          Deoptimization::Action_maybe_recompile);
+  } else {
+    cg = CallGenerator::for_virtual_call(callee, vtable_index);
+  }
+  // Build the tree bottom-up: the least frequent receiver is checked last.
+  int remaining_count = 0;
+  for (int i = morphism - 1; i >= 0 && cg != NULL; i--) {
+    int receiver_count = profile.receiver_count(i);
+    remaining_count += receiver_count;
+    float hit_prob = MIN2((float)receiver_count / remaining_count, PROB_MAX);
+    trace_type_profile(C, caller, jvms->depth() - 1, bci, receiver_method[i], profile.receiver(i),
+                       profile.count(), receiver_count);
+    cg = CallGenerator::for_predicted_call(profile.receiver(i), cg, hit_cg[i], hit_prob);
+  }
+  return cg;
+}
+
 CallGenerator* Compile::call_generator(ciMethod* callee, int vtable_index, bool call_does_dispatch,
                                        JVMState* jvms, bool allow_inline,
                                        float prof_factor, ciKlass* speculative_receiver_type,
@@ -223,6 +276,13 @@ CallGenerator* Compile::call_generator(ciMethod* callee, int vtable_index, bool
           speculative_receiver_type = NULL;
         }
       }
+      if (receiver_method == NULL && !have_major_receiver &&
+          morphism > 2 && UsePolymorphicInlining &&
+          morphism <= MIN2((int)PolymorphicInlineLimit, (int)ciCallProfile::MorphismLimit)) {
+        CallGenerator* cg = polymorphic_call_generator(this, callee, vtable_index, jvms,
+                                                       allow_inline, prof_factor, profile, morphism);
+        if (cg != NULL)  return cg;
+      }
       if (receiver_method == NULL &&
           (have_major_receiver || morphism == 1 ||
            (morphism == 2 && UseBimorphicInlining))) {
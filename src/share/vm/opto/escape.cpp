@@ -32,6 +32,7 @@
 #include "opto/cfgnode.hpp"
 #include "opto/compile.hpp"
 #include "opto/escape.hpp"
+#include "opto/graphKit.hpp"
 #include "opto/phaseX.hpp"
 #include "opto/rootnode.hpp"
 
@@ -103,6 +104,329 @@ void ConnectionGraph::do_analysis(Compile *C, PhaseIterGVN *igvn) {
     igvn->hash_delete(noop_null);
 }
 
+//----------------------------Partial escape analysis-------------------------
+// An allocation which escapes only as an argument of a single call on an
+// unlikely path is rematerialized right before that call.  The original
+// object is left with field loads and debug uses only, so the analysis
+// below can scalar replace it on the common path.  A deoptimization between
+// the branch and the call rebuilds it from SafePointScalarObjectNode debug
+// info like any other eliminated allocation.  Fields must not be written
+// after initialization so that both copies agree.
+
+// Position of a control or memory node relative to the escaping call.
+enum {
+  PEA_none   = 0,
+  PEA_before = 1, // every path reaches the allocation first
+  PEA_after  = 2, // every path reaches the escaping call first
+  PEA_fail   = 4  // the method entry or an unexpected node was reached
+};
+
+// Walk the control graph up from 'ctrl' until the allocation or the call.
+static int pea_classify_control(Node* ctrl, Node* alloc, Node* call) {
+  ResourceMark rm;
+  VectorSet visited(Thread::current()->resource_area());
+  Node_List stack;
+  int result = PEA_none;
+  stack.push(ctrl);
+  while (stack.size() > 0) {
+    Node* n = stack.pop();
+    if (n == NULL || n->is_top() || visited.test_set(n->_idx)) {
+      continue;
+    }
+    if (n == alloc) {
+      result |= PEA_before;
+    } else if (n == call) {
+      result |= PEA_after;
+    } else if (n->is_Start() || n->is_Root() || !n->is_CFG()) {
+      return PEA_fail;
+    } else if (n->is_Region()) {
+      for (uint i = 1; i < n->req(); i++) {
+        stack.push(n->in(i));
+      }
+    } else {
+      stack.push(n->in(0));
+    }
+  }
+  return result;
+}
+
+// Walk the memory slice 'alias_idx' up from 'mem' until the initialization
+// of the allocation or the call.
+static int pea_classify_memory(Node* mem, int alias_idx, Node* init, Node* call) {
+  ResourceMark rm;
+  VectorSet visited(Thread::current()->resource_area());
+  Node_List stack;
+  int result = PEA_none;
+  stack.push(mem);
+  while (stack.size() > 0) {
+    Node* n = stack.pop();
+    if (n == NULL || n->is_top() || visited.test_set(n->_idx)) {
+      continue;
+    }
+    if (n->is_MergeMem()) {
+      stack.push(n->as_MergeMem()->memory_at(alias_idx));
+    } else if (n->is_Phi()) {
+      for (uint i = 1; i < n->req(); i++) {
+        stack.push(n->in(i));
+      }
+    } else if (n->is_Proj()) {
+      Node* m = n->in(0);
+      if (m == init) {
+        result |= PEA_before;
+      } else if (m == call) {
+        result |= PEA_after;
+      } else if (m->is_Call() || m->is_MemBar()) {
+        stack.push(m->in(TypeFunc::Memory));
+      } else if (m->is_LoadStore()) {
+        stack.push(m->in(MemNode::Memory));
+      } else {
+        return PEA_fail;
+      }
+    } else if (n->is_Mem() || n->is_LoadStore()) {
+      stack.push(n->in(MemNode::Memory));
+    } else {
+      return PEA_fail;
+    }
+  }
+  return result;
+}
+
+// Is 'ctrl' below a branch that is taken less often than its alternative?
+// Only the straight-line part of the path is considered.
+static bool pea_unlikely_path(Node* ctrl, Node* alloc) {
+  for (Node* n = ctrl; n != NULL && n != alloc; n = n->in(0)) {
+    if (n->is_Region() || n->is_Start() || n->is_top()) {
+      return false;
+    }
+    if (n->is_IfTrue() || n->is_IfFalse()) {
+      float prob = n->in(0)->as_If()->_prob;
+      if (n->is_IfFalse()) {
+        prob = 1.0f - prob;
+      }
+      if (prob < PROB_FAIR) {
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+static bool sink_partial_escape(Compile* C, AllocateNode* alloc) {
+  ResourceMark rm;
+  PhaseGVN* gvn = C->initial_gvn();
+  Node* res = alloc->result_cast();
+  if (res == NULL || !res->is_CheckCastPP()) {
+    return false;
+  }
+  const TypeInstPtr* res_type = gvn->type(res)->isa_instptr();
+  if (res_type == NULL || !res_type->klass_is_exact() || !res_type->klass()->is_loaded()) {
+    return false;
+  }
+  ciInstanceKlass* ik = res_type->klass()->as_instance_klass();
+  InitializeNode* init = alloc->initialization();
+  if (ik->has_finalizer() || init == NULL || init->is_complete_with_arraycopy()) {
+    return false;
+  }
+
+  // Only field loads, debug info and publication barriers may use the
+  // object, except for the arguments of one Java call.
+  CallJavaNode* call = NULL;
+  Unique_Node_List others;
+  Unique_Node_List loads;
+  for (DUIterator_Fast imax, i = res->fast_outs(imax); i < imax; i++) {
+    Node* use = res->fast_out(i);
+    if (use->is_AddP()) {
+      if (use->in(AddPNode::Base) != res) {
+        return false;
+      }
+      for (DUIterator_Fast jmax, j = use->fast_outs(jmax); j < jmax; j++) {
+        Node* n = use->fast_out(j);
+        if (!n->is_Load()) {
+          return false;       // store or atomic update of a field
+        }
+        loads.push(n);
+      }
+    } else if (use->is_MemBar() && use->req() > MemBarNode::Precedent &&
+               use->in(MemBarNode::Precedent) == res) {
+      others.push(use);
+    } else if (use->is_SafePoint()) {
+      if (use->is_Call() && use->as_Call()->has_non_debug_use(res)) {
+        if (!use->is_CallJava() || (call != NULL && call != use)) {
+          return false;
+        }
+        call = use->as_CallJava();
+      } else {
+        others.push(use);
+      }
+    } else {
+      return false;
+    }
+  }
+  if (call == NULL || call->method() == NULL || call->is_method_handle_invoke() ||
+      call->jvms() == NULL || call->in(TypeFunc::Memory)->is_top() ||
+      !Bytecodes::is_invoke(call->jvms()->method()->java_code_at_bci(call->jvms()->bci())) ||
+      (call->is_CallStaticJava() && call->as_CallStaticJava()->is_boxing_method())) {
+    return false;
+  }
+
+  // The call must sit on an unlikely path and execute at most once per
+  // allocation: every path up from it reaches the allocation first.
+  if (!pea_unlikely_path(call->in(0), alloc) ||
+      pea_classify_control(call->in(0), alloc, call) != PEA_before) {
+    return false;
+  }
+
+  // Uses which follow the call must see the copy, since the callee may
+  // have stored or modified it.  Uses on paths merging with the call's
+  // path would need a phi and prevent scalar replacement.
+  Node_List after;
+  for (uint i = 0; i < others.size(); i++) {
+    Node* use = others.at(i);
+    int pos = pea_classify_control(use->in(0), alloc, call);
+    if (pos == PEA_after && use->is_SafePoint()) {
+      after.push(use);
+    } else if (pos != PEA_before) {
+      return false;
+    }
+  }
+  Node_List after_loads;
+  for (uint i = 0; i < loads.size(); i++) {
+    Node* load = loads.at(i);
+    int alias_idx = C->get_alias_index(load->adr_type());
+    int pos = pea_classify_memory(load->in(MemNode::Memory), alias_idx, init, call);
+    if (pos == PEA_after) {
+      after_loads.push(load);
+    } else if (pos != PEA_before) {
+      return false;
+    }
+  }
+
+  // Collect the initial field values captured by the initialization.
+  int nfields = ik->nof_nonstatic_fields();
+  GrowableArray<Node*> values(nfields, nfields, NULL);
+  for (int j = 0; j < nfields; j++) {
+    ciField* field = ik->nonstatic_field_at(j);
+    BasicType bt = field->layout_type();
+    bool is_oop = (bt == T_OBJECT || bt == T_ARRAY);
+    int size = is_oop ? heapOopSize : type2aelembytes(bt);
+    Node* st = init->find_captured_store(field->offset(), size, gvn);
+    if (st == NULL) {
+      return false;
+    }
+    if (st == init->zero_memory()) {
+      continue;
+    }
+    if (!st->is_Store() || st->as_Store()->memory_size() != size) {
+      return false;
+    }
+    Node* val = st->in(MemNode::ValueIn);
+    if (is_oop && gvn->type(val)->isa_narrowoop()) {
+      if (val->Opcode() == Op_EncodeP) {
+        val = val->in(1);
+      } else if (val->is_Con()) {
+        val = gvn->makecon(gvn->type(val)->make_ptr());
+      } else {
+        return false;
+      }
+    }
+    values.at_put(j, val);
+  }
+
+#ifndef PRODUCT
+  if (PrintEscapeAnalysis) {
+    tty->print_cr("=== Sinking allocation %d into the path of call %d", alloc->_idx, call->_idx);
+  }
+#endif
+
+  // Build a state at the call with its arguments back on the expression
+  // stack, so a deoptimization in the new allocation re-executes the invoke.
+  JVMState* jvms = call->jvms()->clone_shallow(C);
+  uint size = call->req();
+  SafePointNode* map = new (C) SafePointNode(size, jvms);
+  for (uint i1 = 0; i1 < size; i1++) {
+    map->init_req(i1, call->in(i1));
+  }
+  if (!map->in(TypeFunc::Memory)->is_MergeMem()) {
+    Node* mem = MergeMemNode::make(C, map->in(TypeFunc::Memory));
+    gvn->set_type_bottom(mem);
+    map->set_req(TypeFunc::Memory, mem);
+  }
+  uint nargs = call->method()->arg_size();
+  Node* top = C->top();
+  for (uint i1 = 0; i1 < nargs; i1++) {
+    map->set_req(TypeFunc::Parms + i1, top);
+  }
+  jvms->set_map(map);
+  map->ensure_stack(jvms, jvms->method()->max_stack());
+  for (uint i1 = 0; i1 < nargs; i1++) {
+    map->set_argument(jvms, i1, call->in(TypeFunc::Parms + i1));
+  }
+  jvms->set_sp(jvms->sp() + nargs);
+
+  GraphKit kit(jvms);
+  Node* obj = NULL;
+  {
+    PreserveReexecuteState preexecs(&kit);
+    kit.jvms()->set_should_reexecute(true);
+    obj = kit.new_instance(alloc->in(AllocateNode::KlassNode));
+  }
+  for (int j = 0; j < nfields; j++) {
+    Node* val = values.at(j);
+    if (val == NULL) {
+      continue;
+    }
+    ciField* field = ik->nonstatic_field_at(j);
+    BasicType bt = field->layout_type();
+    Node* adr = kit.basic_plus_adr(obj, field->offset());
+    const TypePtr* adr_type = C->alias_type(field)->adr_type();
+    if (bt == T_OBJECT || bt == T_ARRAY) {
+      const TypeOopPtr* val_type = field->type()->is_loaded()
+                                 ? TypeOopPtr::make_from_klass(field->type()->as_klass())
+                                 : TypeInstPtr::BOTTOM;
+      kit.store_oop_to_object(kit.control(), obj, adr, adr_type, val, val_type, bt, MemNode::unordered);
+    } else {
+      kit.store_to_memory(kit.control(), adr, val, bt, adr_type, MemNode::unordered);
+    }
+  }
+  // Publish the copy the way a constructor with final fields does.
+  kit.insert_mem_bar(Op_MemBarRelease, obj);
+
+  // Hook the call up to the copy.
+  call->set_req(TypeFunc::Control, kit.control());
+  call->set_req(TypeFunc::I_O, kit.i_o());
+  call->set_req(TypeFunc::Memory, kit.reset_memory());
+  call->replace_edge(res, obj);
+  C->record_for_igvn(call);
+  for (uint i = 0; i < after.size(); i++) {
+    after.at(i)->replace_edge(res, obj);
+    C->record_for_igvn(after.at(i));
+  }
+  for (uint i = 0; i < after_loads.size(); i++) {
+    Node* load = after_loads.at(i);
+    Node* addp = load->in(MemNode::Address);
+    Node* adr = gvn->transform(new (C) AddPNode(obj, obj, addp->in(AddPNode::Offset)));
+    gvn->hash_delete(load);
+    load->set_req(MemNode::Address, adr);
+    C->record_for_igvn(load);
+  }
+  return true;
+}
+
+bool ConnectionGraph::sink_partial_escapes(Compile* C) {
+  bool progress = false;
+  // New allocations are appended to the macro list and are not visited.
+  for (int i = C->macro_count() - 1; i >= 0; i--) {
+    Node* n = C->macro_node(i);
+    if (n->Opcode() == Op_Allocate && sink_partial_escape(C, n->as_Allocate())) {
+      progress = true;
+    }
+    if (C->failing()) {
+      return progress;
+    }
+  }
+  return progress;
+}
+
 bool ConnectionGraph::compute_escape() {
   Compile* C = _compile;
   PhaseGVN* igvn = _igvn;
@@ -838,7 +1162,7 @@ void ConnectionGraph::add_call_node(CallNode* call) {
       // Returns boxing object
       PointsToNode::EscapeState es;
       vmIntrinsics::ID intr = meth->intrinsic_id();
-      if (intr == vmIntrinsics::_floatValue || intr == vmIntrinsics::_doubleValue) {
+      if (intr == vmIntrinsics::_Float_valueOf || intr == vmIntrinsics::_Double_valueOf) {
         // It does not escape if object is always allocated.
         es = PointsToNode::NoEscape;
       } else {
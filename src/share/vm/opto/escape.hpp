@@ -591,6 +591,10 @@ public:
   // Perform escape analysis
   static void do_analysis(Compile *C, PhaseIterGVN *igvn);
 
+  // Move allocations which escape only through a call on an unlikely
+  // path next to that call (partial escape analysis)
+  static bool sink_partial_escapes(Compile *C);
+
   bool not_global_escape(Node *n);
 
 #ifndef PRODUCT
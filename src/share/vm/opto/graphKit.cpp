@@ -3863,6 +3863,143 @@ void GraphKit::write_barrier_post(Node* oop_store,
   final_sync(ideal);
 }
 
+/*
+ * Determine if the G1 pre-barrier can be removed. The pre-barrier is
+ * required by SATB to make sure all objects live at the start of the
+ * marking are kept alive, all reference updates need to record any previous
+ * reference stored before writing.
+ *
+ * If the previous value is NULL there is no need to save the old value.
+ * This is the case for the fields of a newly allocated object, up to the
+ * first store into them. Walk the memory chain of the field back to the
+ * initialization of the allocation, stepping over stores that provably
+ * do not write the field. Safepoints do not matter here since a GC never
+ * replaces NULL by something else.
+ */
+bool GraphKit::g1_can_remove_pre_barrier(PhaseTransform* phase, Node* adr,
+                                         BasicType bt, uint adr_idx) {
+  intptr_t offset = 0;
+  Node* base = AddPNode::Ideal_base_and_offset(adr, phase, offset);
+  AllocateNode* alloc = AllocateNode::Ideal_allocation(base, phase);
+
+  if (offset == Type::OffsetBot) {
+    return false; // cannot unalias unless there are precise offsets
+  }
+
+  if (alloc == NULL) {
+    return false; // No allocation found
+  }
+
+  intptr_t size_in_bytes = type2aelembytes(bt);
+
+  Node* mem = memory(adr_idx); // start searching here...
+
+  for (int cnt = 0; cnt < 50; cnt++) {
+
+    if (mem->is_Store()) {
+
+      Node* st_adr = mem->in(MemNode::Address);
+      intptr_t st_offset = 0;
+      Node* st_base = AddPNode::Ideal_base_and_offset(st_adr, phase, st_offset);
+
+      if (st_base == NULL) {
+        break; // inscrutable pointer
+      }
+
+      // We have found a store with same base and offset as ours.
+      if (st_base == base && st_offset == offset) {
+        break;
+      }
+
+      if (st_offset != offset && st_offset != Type::OffsetBot) {
+        const int MAX_STORE = BytesPerLong;
+        if (st_offset >= offset + size_in_bytes ||
+            st_offset <= offset - MAX_STORE ||
+            st_offset <= offset - mem->as_Store()->memory_size()) {
+          // Success:  The offsets are provably independent.
+          // (You may ask, why not just test st_offset != offset and be done?
+          // The answer is that stores of different sizes can co-exist
+          // in the same sequence of RawMem effects.  We sometimes initialize
+          // a whole 'tile' of array elements with a single jint or jlong.)
+          mem = mem->in(MemNode::Memory);
+          continue; // advance through independent store memory
+        }
+      }
+
+      if (st_base != base
+          && MemNode::detect_ptr_independence(base, alloc, st_base,
+                                              AllocateNode::Ideal_allocation(st_base, phase),
+                                              phase)) {
+        // Success:  The bases are provably independent.
+        mem = mem->in(MemNode::Memory);
+        continue; // advance through independent store memory
+      }
+    } else if (mem->is_Proj() && mem->in(0)->is_Initialize()) {
+
+      InitializeNode* st_init = mem->in(0)->as_Initialize();
+      AllocateNode* st_alloc = st_init->allocation();
+
+      // Make sure that we are looking at the same allocation site.
+      // The alloc variable is guaranteed to not be null here from earlier check.
+      if (alloc == st_alloc) {
+        // Check that the initialization is storing NULL so that no previous store
+        // has been moved up and directly write a reference
+        Node* captured_store = st_init->find_captured_store(offset,
+                                                            type2aelembytes(T_OBJECT),
+                                                            phase);
+        if (captured_store == NULL || captured_store == st_init->zero_memory()) {
+          return true;
+        }
+      }
+    }
+
+    // Unless there is an explicit 'continue', we must bail out here,
+    // because 'mem' is an inscrutable memory state (e.g., a call).
+    break;
+  }
+
+  return false;
+}
+
+/*
+ * Determine if the G1 post-barrier can be removed. With
+ * ReduceInitialCardMarks a newly allocated object is either young, for
+ * which G1 needs no card marks, or new_store_pre_barrier() has deferred
+ * a card mark covering the whole object until the next safepoint or
+ * slow-path allocation. Both remain true as long as no safepoint or call
+ * has happened since the allocation.
+ *
+ * Unlike just_allocated_object(), which only recognizes the control
+ * right after the allocation, walk the dominating control back to the
+ * initialization of the allocation. Branches are fine, but merges,
+ * safepoints and calls (including other allocations) are not.
+ */
+bool GraphKit::g1_can_remove_post_barrier(PhaseTransform* phase, Node* obj,
+                                          Node* ctl) {
+  AllocateNode* alloc = AllocateNode::Ideal_allocation(obj, phase);
+  if (alloc == NULL) {
+    return false; // No allocation found
+  }
+
+  for (int cnt = 0; cnt < 50 && ctl != NULL; cnt++) {
+    if (!ctl->is_Proj()) {
+      break; // a merge, safepoint or some other control we do not know
+    }
+    Node* in = ctl->in(0);
+    if (in->is_Initialize()) {
+      return in->as_Initialize()->allocation() == alloc;
+    }
+    if (in->is_If() || in->is_MemBar()) {
+      // Taking one side of a branch or passing an ordering barrier.
+      ctl = in->in(0);
+      continue;
+    }
+    break;
+  }
+
+  return false;
+}
+
 // G1 pre/post barriers
 void GraphKit::g1_write_barrier_pre(bool do_load,
                                     Node* obj,
@@ -3882,6 +4019,11 @@ void GraphKit::g1_write_barrier_pre(bool do_load,
     assert(adr != NULL, "where are loading from?");
     assert(pre_val == NULL, "loaded already?");
     assert(val_type != NULL, "need a type");
+
+    if (use_ReduceInitialCardMarks()
+        && g1_can_remove_pre_barrier(&_gvn, adr, bt, alias_idx)) {
+      return;
+    }
   } else {
     // In this case both val_type and alias_idx are unused.
     assert(pre_val != NULL, "must be loaded already");
@@ -4015,6 +4157,16 @@ void GraphKit::g1_write_barrier_post(Node* oop_store,
     return;
   }
 
+  if (use_ReduceInitialCardMarks()
+      && g1_can_remove_post_barrier(&_gvn, obj, control())) {
+    // We can skip marks on a freshly-allocated object.
+    // Keep this code in sync with new_store_pre_barrier() in runtime.cpp.
+    // That routine informs GC to take appropriate compensating steps,
+    // upon a slow-path allocation, so as to make this card-mark
+    // elision safe.
+    return;
+  }
+
   if (!use_precise) {
     // All card marks for a (non-array) instance are in one place:
     adr = obj;
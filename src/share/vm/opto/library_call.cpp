@@ -202,6 +202,9 @@ class LibraryCallKit : public GraphKit {
   bool inline_string_indexOf();
   Node* string_indexOf(Node* string_object, ciTypeArray* target_array, jint offset, jint cache_i, jint md2_i);
   bool inline_string_equals();
+  Node* make_vectorized_hashCode(BasicType elem_type, Node* start, Node* length, Node* init);
+  bool inline_string_hashCode();
+  bool inline_array_hashCode(BasicType elem_type);
   Node* round_double_node(Node* n);
   bool runtime_math(const TypeFunc* call_type, address funcAddr, const char* funcName);
   bool inline_math_native(vmIntrinsics::ID id);
@@ -235,6 +238,7 @@ class LibraryCallKit : public GraphKit {
   static bool klass_needs_init_guard(Node* kls);
   bool inline_unsafe_allocate();
   bool inline_unsafe_copyMemory();
+  bool inline_unsafe_setMemory();
   bool inline_native_currentThread();
 #ifdef TRACE_HAVE_INTRINSICS
   bool inline_native_classID();
@@ -248,7 +252,8 @@ class LibraryCallKit : public GraphKit {
   bool inline_native_newArray();
   bool inline_native_getLength();
   bool inline_array_copyOf(bool is_copyOfRange);
-  bool inline_array_equals();
+  bool inline_array_equals(bool is_byte);
+  bool inline_array_equals_mismatch(BasicType elem_type);
   void copy_to_clone(Node* obj, Node* alloc_obj, Node* obj_size, bool is_array, bool card_mark);
   bool inline_native_clone(bool is_virtual);
   bool inline_native_Reflection_getCallerClass();
@@ -323,6 +328,10 @@ class LibraryCallKit : public GraphKit {
   bool inline_updateCRC32();
   bool inline_updateBytesCRC32();
   bool inline_updateByteBufferCRC32();
+  bool inline_updateBytesAdler32();
+  bool inline_ghash_processBlocks();
+  bool inline_updateByteBufferAdler32();
+  Node* make_adler32_call(Node* adler, Node* src_start, Node* length);
   bool inline_multiplyToLen();
   bool inline_squareToLen();
   bool inline_mulAdd();
@@ -409,6 +418,27 @@ CallGenerator* Compile::make_vm_intrinsic(ciMethod* m, bool is_virtual) {
     if (!SpecialArraysEquals)  return NULL;
     if (!Matcher::match_rule_supported(Op_AryEq))  return NULL;
     break;
+  case vmIntrinsics::_equalsB:
+    if (!SpecialArraysEquals)  return NULL;
+    if (!Matcher::match_rule_supported(Op_AryEq))  return NULL;
+    if (!Matcher::byte_array_equals_supported())  return NULL;
+    break;
+  case vmIntrinsics::_equalsS:
+  case vmIntrinsics::_equalsI:
+  case vmIntrinsics::_equalsJ:
+    if (!SpecialArraysEquals)  return NULL;
+    if (!UseVectorizedMismatchIntrinsic)  return NULL;
+    if (StubRoutines::vectorizedMismatch() == NULL)  return NULL;
+    break;
+  case vmIntrinsics::_hashCodeString:
+  case vmIntrinsics::_hashCodeC:
+    if (!UseVectorizedHashCodeIntrinsic)  return NULL;
+    if (StubRoutines::charArrayHashCode() == NULL)  return NULL;
+    break;
+  case vmIntrinsics::_hashCodeB:
+    if (!UseVectorizedHashCodeIntrinsic)  return NULL;
+    if (StubRoutines::byteArrayHashCode() == NULL)  return NULL;
+    break;
   case vmIntrinsics::_arraycopy:
     if (!InlineArrayCopy)  return NULL;
     break;
@@ -416,6 +446,9 @@ CallGenerator* Compile::make_vm_intrinsic(ciMethod* m, bool is_virtual) {
     if (StubRoutines::unsafe_arraycopy() == NULL)  return NULL;
     if (!InlineArrayCopy)  return NULL;
     break;
+  case vmIntrinsics::_setMemory:
+    if (!InlineArrayCopy)  return NULL;
+    break;
   case vmIntrinsics::_hashCode:
     if (!InlineObjectHash)  return NULL;
     does_virtual_dispatch = true;
@@ -576,6 +609,15 @@ CallGenerator* Compile::make_vm_intrinsic(ciMethod* m, bool is_virtual) {
     if (!UseCRC32Intrinsics) return NULL;
     break;
 
+  case vmIntrinsics::_updateBytesAdler32:
+  case vmIntrinsics::_updateByteBufferAdler32:
+    if (!UseAdler32Intrinsics) return NULL;
+    break;
+
+  case vmIntrinsics::_ghash_processBlocks:
+    if (!UseGHASHIntrinsics) return NULL;
+    break;
+
   case vmIntrinsics::_incrementExactI:
   case vmIntrinsics::_addExactI:
     if (!Matcher::match_rule_supported(Op_OverflowAddI) || !UseMathExactIntrinsics) return NULL;
@@ -794,6 +836,7 @@ bool LibraryCallKit::try_to_inline(int predicate) {
   case vmIntrinsics::_compareTo:                return inline_string_compareTo();
   case vmIntrinsics::_indexOf:                  return inline_string_indexOf();
   case vmIntrinsics::_equals:                   return inline_string_equals();
+  case vmIntrinsics::_hashCodeString:           return inline_string_hashCode();
 
   case vmIntrinsics::_getObject:                return inline_unsafe_access(!is_native_ptr, !is_store, T_OBJECT,  !is_volatile, false);
   case vmIntrinsics::_getBoolean:               return inline_unsafe_access(!is_native_ptr, !is_store, T_BOOLEAN, !is_volatile, false);
@@ -888,11 +931,18 @@ bool LibraryCallKit::try_to_inline(int predicate) {
   case vmIntrinsics::_nanoTime:                 return inline_native_time_funcs(CAST_FROM_FN_PTR(address, os::javaTimeNanos), "nanoTime");
   case vmIntrinsics::_allocateInstance:         return inline_unsafe_allocate();
   case vmIntrinsics::_copyMemory:               return inline_unsafe_copyMemory();
+  case vmIntrinsics::_setMemory:                return inline_unsafe_setMemory();
   case vmIntrinsics::_newArray:                 return inline_native_newArray();
   case vmIntrinsics::_getLength:                return inline_native_getLength();
   case vmIntrinsics::_copyOf:                   return inline_array_copyOf(false);
   case vmIntrinsics::_copyOfRange:              return inline_array_copyOf(true);
-  case vmIntrinsics::_equalsC:                  return inline_array_equals();
+  case vmIntrinsics::_equalsC:                  return inline_array_equals(false);
+  case vmIntrinsics::_equalsB:                  return inline_array_equals(true);
+  case vmIntrinsics::_equalsS:                  return inline_array_equals_mismatch(T_SHORT);
+  case vmIntrinsics::_equalsI:                  return inline_array_equals_mismatch(T_INT);
+  case vmIntrinsics::_equalsJ:                  return inline_array_equals_mismatch(T_LONG);
+  case vmIntrinsics::_hashCodeC:                return inline_array_hashCode(T_CHAR);
+  case vmIntrinsics::_hashCodeB:                return inline_array_hashCode(T_BYTE);
   case vmIntrinsics::_clone:                    return inline_native_clone(intrinsic()->is_virtual());
 
   case vmIntrinsics::_isAssignableFrom:         return inline_native_subtype_check();
@@ -966,6 +1016,13 @@ bool LibraryCallKit::try_to_inline(int predicate) {
     return inline_updateBytesCRC32();
   case vmIntrinsics::_updateByteBufferCRC32:
     return inline_updateByteBufferCRC32();
+  case vmIntrinsics::_updateBytesAdler32:
+    return inline_updateBytesAdler32();
+  case vmIntrinsics::_updateByteBufferAdler32:
+    return inline_updateByteBufferAdler32();
+
+  case vmIntrinsics::_ghash_processBlocks:
+    return inline_ghash_processBlocks();
 
   case vmIntrinsics::_profileBoolean:
     return inline_profileBoolean();
@@ -1342,10 +1399,205 @@ bool LibraryCallKit::inline_string_equals() {
 }
 
 //------------------------------inline_array_equals----------------------------
-bool LibraryCallKit::inline_array_equals() {
+bool LibraryCallKit::inline_array_equals(bool is_byte) {
   Node* arg1 = argument(0);
   Node* arg2 = argument(1);
-  set_result(_gvn.transform(new (C) AryEqNode(control(), memory(TypeAryPtr::CHARS), arg1, arg2)));
+  const TypeAryPtr* mtype = is_byte ? TypeAryPtr::BYTES : TypeAryPtr::CHARS;
+  set_result(_gvn.transform(new (C) AryEqNode(control(), memory(mtype), arg1, arg2, is_byte)));
+  return true;
+}
+
+//------------------------------inline_array_equals_mismatch-------------------
+// public static boolean java.util.Arrays.equals(short[] a, short[] a2)
+// public static boolean java.util.Arrays.equals(int[] a, int[] a2)
+// public static boolean java.util.Arrays.equals(long[] a, long[] a2)
+// Bitwise equality is element equality for these types, so the arrays
+// are compared as raw bytes by the vectorizedMismatch stub.
+bool LibraryCallKit::inline_array_equals_mismatch(BasicType elem_type) {
+  enum { _same_path = 1, _null_path, _length_path, _equal_path, _mismatch_path, PATH_LIMIT };
+
+  RegionNode* result_reg = new (C) RegionNode(PATH_LIMIT);
+  PhiNode*    result_val = new (C) PhiNode(result_reg, TypeInt::BOOL);
+  PhiNode*    result_mem = new (C) PhiNode(result_reg, Type::MEMORY, TypePtr::BOTTOM);
+  for (uint i = 1; i < PATH_LIMIT; i++) {
+    result_reg->init_req(i, top());
+  }
+  result_val->init_req(_same_path,     intcon(1));
+  result_val->init_req(_null_path,     intcon(0));
+  result_val->init_req(_length_path,   intcon(0));
+  result_val->init_req(_equal_path,    intcon(1));
+  result_val->init_req(_mismatch_path, intcon(0));
+
+  Node* init_mem = reset_memory();
+  for (uint i = 1; i < PATH_LIMIT; i++) {
+    result_mem->init_req(i, init_mem);
+  }
+  set_all_memory(init_mem);
+
+  Node* a = argument(0);
+  Node* b = argument(1);
+
+  // a == b, including both null
+  Node* cmp = _gvn.transform(new (C) CmpPNode(a, b));
+  Node* bol = _gvn.transform(new (C) BoolNode(cmp, BoolTest::eq));
+  Node* same_ctl = generate_guard(bol, NULL, PROB_FAIR);
+  if (same_ctl != NULL)  result_reg->init_req(_same_path, same_ctl);
+
+  // either one null
+  RegionNode* null_reg = new (C) RegionNode(3);
+  Node* null_ctl = top();
+  a = null_check_oop(a, &null_ctl);
+  null_reg->init_req(1, null_ctl);
+  null_ctl = top();
+  b = null_check_oop(b, &null_ctl);
+  null_reg->init_req(2, null_ctl);
+  result_reg->init_req(_null_path, _gvn.transform(null_reg));
+
+  if (!stopped()) {
+    Node* len_a = load_array_length(a);
+    Node* len_b = load_array_length(b);
+    cmp = _gvn.transform(new (C) CmpINode(len_a, len_b));
+    bol = _gvn.transform(new (C) BoolNode(cmp, BoolTest::ne));
+    Node* length_ctl = generate_guard(bol, NULL, PROB_FAIR);
+    if (length_ctl != NULL)  result_reg->init_req(_length_path, length_ctl);
+
+    if (!stopped()) {
+      Node* start_a = array_element_address(a, intcon(0), elem_type);
+      Node* start_b = array_element_address(b, intcon(0), elem_type);
+      int shift = exact_log2(type2aelembytes(elem_type));
+      Node* bytes = _gvn.transform(new (C) LShiftXNode(ConvI2X(len_a), intcon(shift)));
+      Node* call = make_runtime_call(RC_LEAF|RC_NO_FP, OptoRuntime::vectorizedMismatch_Type(),
+                                     StubRoutines::vectorizedMismatch(), "vectorizedMismatch",
+                                     TypePtr::BOTTOM, start_a, start_b, bytes
+#ifdef _LP64
+                                     , top() // other half of long length
+#endif
+                                     );
+      Node* mismatch = _gvn.transform(new (C) ProjNode(call, TypeFunc::Parms));
+      Node* call_mem = reset_memory();
+      result_mem->init_req(_equal_path,    call_mem);
+      result_mem->init_req(_mismatch_path, call_mem);
+
+      cmp = _gvn.transform(new (C) CmpLNode(mismatch, longcon(-1)));
+      bol = _gvn.transform(new (C) BoolNode(cmp, BoolTest::eq));
+      Node* equal_ctl = generate_guard(bol, NULL, PROB_FAIR);
+      if (equal_ctl != NULL)  result_reg->init_req(_equal_path, equal_ctl);
+      result_reg->init_req(_mismatch_path, control());
+    }
+  }
+
+  set_control(_gvn.transform(result_reg));
+  set_all_memory(_gvn.transform(result_mem));
+  set_result(_gvn.transform(result_val));
+  return true;
+}
+
+//------------------------------make_vectorized_hashCode---------------------
+// Call the SIMD stub computing init * 31^length + sum(a[i] * 31^(length-1-i))
+// over the char[] or byte[] elements starting at 'start'.
+Node* LibraryCallKit::make_vectorized_hashCode(BasicType elem_type, Node* start, Node* length, Node* init) {
+  assert(UseVectorizedHashCodeIntrinsic, "need AVX2 instructions support");
+  address stubAddr = (elem_type == T_CHAR) ? StubRoutines::charArrayHashCode()
+                                           : StubRoutines::byteArrayHashCode();
+  const char* stubName = (elem_type == T_CHAR) ? "charArrayHashCode" : "byteArrayHashCode";
+  assert(stubAddr != NULL, "stub is not generated");
+  Node* call = make_runtime_call(RC_LEAF|RC_NO_FP, OptoRuntime::vectorizedHashCode_Type(),
+                                 stubAddr, stubName, TypePtr::BOTTOM,
+                                 start, length, init);
+  return _gvn.transform(new (C) ProjNode(call, TypeFunc::Parms));
+}
+
+//------------------------------inline_string_hashCode-----------------------
+// public int java.lang.String.hashCode()
+bool LibraryCallKit::inline_string_hashCode() {
+  Node* receiver = null_check_receiver();
+  if (stopped())  return true;
+
+  enum { _cached_path = 1, _compute_path, PATH_LIMIT };
+
+  RegionNode* result_reg = new (C) RegionNode(PATH_LIMIT);
+  PhiNode*    result_val = new (C) PhiNode(result_reg, TypeInt::INT);
+  PhiNode*    result_mem = new (C) PhiNode(result_reg, Type::MEMORY, TypePtr::BOTTOM);
+
+  // Return the cached hash when it has already been computed.
+  int hash_offset = java_lang_String::hash_offset_in_bytes();
+  const TypeInstPtr* string_type = TypeInstPtr::make(TypePtr::NotNull, C->env()->String_klass(),
+                                                     false, NULL, 0);
+  const TypePtr* hash_field_type = string_type->add_offset(hash_offset);
+  Node* hash_adr = basic_plus_adr(receiver, receiver, hash_offset);
+  Node* hash = make_load(control(), hash_adr, TypeInt::INT, T_INT, hash_field_type, MemNode::unordered);
+
+  Node* cmp = _gvn.transform(new (C) CmpINode(hash, intcon(0)));
+  Node* bol = _gvn.transform(new (C) BoolNode(cmp, BoolTest::ne));
+  Node* cached_ctl = generate_guard(bol, NULL, PROB_LIKELY(0.9));
+  if (cached_ctl == NULL)  cached_ctl = top();
+
+  Node* init_mem = reset_memory();
+  result_reg->init_req(_cached_path, cached_ctl);
+  result_val->init_req(_cached_path, hash);
+  result_mem->init_req(_cached_path, init_mem);
+
+  set_all_memory(init_mem);
+  if (stopped()) {
+    result_reg->init_req(_compute_path, top());
+    result_val->init_req(_compute_path, top());
+    result_mem->init_req(_compute_path, top());
+  } else {
+    // Compute the hash over the value array and cache it, as String.hashCode() does.
+    Node* value  = load_String_value(NULL, receiver);
+    Node* offset = load_String_offset(NULL, receiver);
+    Node* count  = load_String_length(NULL, receiver);
+    Node* start  = array_element_address(value, offset, T_CHAR);
+    Node* h = make_vectorized_hashCode(T_CHAR, start, count, intcon(0));
+    store_to_memory(control(), hash_adr, h, T_INT, hash_field_type, MemNode::unordered);
+
+    result_reg->init_req(_compute_path, control());
+    result_val->init_req(_compute_path, h);
+    result_mem->init_req(_compute_path, reset_memory());
+  }
+
+  set_all_memory(_gvn.transform(result_mem));
+  set_result(result_reg, result_val);
+  return true;
+}
+
+//------------------------------inline_array_hashCode------------------------
+// public static int java.util.Arrays.hashCode(char[] a)
+// public static int java.util.Arrays.hashCode(byte[] a)
+bool LibraryCallKit::inline_array_hashCode(BasicType elem_type) {
+  enum { _null_path = 1, _compute_path, PATH_LIMIT };
+
+  RegionNode* result_reg = new (C) RegionNode(PATH_LIMIT);
+  PhiNode*    result_val = new (C) PhiNode(result_reg, TypeInt::INT);
+  PhiNode*    result_mem = new (C) PhiNode(result_reg, Type::MEMORY, TypePtr::BOTTOM);
+
+  // Arrays.hashCode(null) == 0
+  Node* ary = argument(0);
+  Node* null_ctl = top();
+  ary = null_check_oop(ary, &null_ctl);
+
+  Node* init_mem = reset_memory();
+  result_reg->init_req(_null_path, null_ctl);
+  result_val->init_req(_null_path, intcon(0));
+  result_mem->init_req(_null_path, init_mem);
+
+  set_all_memory(init_mem);
+  if (stopped()) {
+    result_reg->init_req(_compute_path, top());
+    result_val->init_req(_compute_path, top());
+    result_mem->init_req(_compute_path, top());
+  } else {
+    Node* length = load_array_length(ary);
+    Node* start  = array_element_address(ary, intcon(0), elem_type);
+    Node* h = make_vectorized_hashCode(elem_type, start, length, intcon(1));
+
+    result_reg->init_req(_compute_path, control());
+    result_val->init_req(_compute_path, h);
+    result_mem->init_req(_compute_path, reset_memory());
+  }
+
+  set_all_memory(_gvn.transform(result_mem));
+  set_result(result_reg, result_val);
   return true;
 }
 
@@ -4473,6 +4725,54 @@ bool LibraryCallKit::inline_unsafe_copyMemory() {
   return true;
 }
 
+//----------------------inline_unsafe_setMemory--------------------------
+// public native void sun.misc.Unsafe.setMemory(Object o, long offset, long bytes, byte value);
+bool LibraryCallKit::inline_unsafe_setMemory() {
+  if (callee()->is_static())  return false;  // caller must have the capability!
+  null_check_receiver();  // null-check receiver
+  if (stopped())  return true;
+
+  C->set_has_unsafe_access(true);  // Mark eventual nmethod as "unsafe".
+
+  Node* base    =         argument(1);   // type: oop
+  Node* offset  = ConvL2X(argument(2));  // type: long
+  Node* size    =         argument(4);   // type: long
+  Node* value   =         argument(6);   // type: byte
+
+  // A negative size throws IllegalArgumentException in the native
+  // version; let the interpreter handle it.
+  {
+    Node* cmp = _gvn.transform(new (C) CmpLNode(size, longcon(0)));
+    Node* bol = _gvn.transform(new (C) BoolNode(cmp, BoolTest::ge));
+    BuildCutout unless(this, bol, PROB_MAX);
+    uncommon_trap(Deoptimization::Reason_intrinsic,
+                  Deoptimization::Action_make_not_entrant);
+  }
+  if (stopped())  return true;
+
+  assert(Unsafe_field_offset_to_byte_offset(11) == 11,
+         "fieldOffset must be byte-scaled");
+
+  Node* dst = make_unsafe_address(base, offset);
+
+  // Conservatively insert a memory barrier on all memory slices.
+  // Do not let writes to the destination float below the fill.
+  insert_mem_bar(Op_MemBarCPUOrder);
+
+  make_runtime_call(RC_LEAF|RC_NO_FP,
+                    OptoRuntime::unsafe_setmemory_Type(),
+                    CAST_FROM_FN_PTR(address, SharedRuntime::unsafe_set_memory),
+                    "unsafe_set_memory",
+                    TypeRawPtr::BOTTOM,
+                    dst, ConvL2X(size) XTOP,
+                    ConvI2L(value), top());
+
+  // Do not let reads of the destination float above the fill.
+  insert_mem_bar(Op_MemBarCPUOrder);
+
+  return true;
+}
+
 //------------------------clone_coping-----------------------------------
 // Helper function for inline_native_clone.
 void LibraryCallKit::copy_to_clone(Node* obj, Node* alloc_obj, Node* obj_size, bool is_array, bool card_mark) {
@@ -6278,6 +6578,80 @@ bool LibraryCallKit::inline_updateByteBufferCRC32() {
   return true;
 }
 
+Node* LibraryCallKit::make_adler32_call(Node* adler, Node* src_start, Node* length) {
+  address stubAddr = CAST_FROM_FN_PTR(address, SharedRuntime::updateBytesAdler32);
+  const char *stubName = "updateBytesAdler32";
+  Node* call;
+  // Same signature as the CRC32 stub: (int, address, int) -> int
+  if (CCallingConventionRequiresIntsAsLongs) {
+    call = make_runtime_call(RC_LEAF|RC_NO_FP, OptoRuntime::updateBytesCRC32_Type(),
+                             stubAddr, stubName, TypePtr::BOTTOM,
+                             adler XTOP, src_start, length XTOP);
+  } else {
+    call = make_runtime_call(RC_LEAF|RC_NO_FP, OptoRuntime::updateBytesCRC32_Type(),
+                             stubAddr, stubName, TypePtr::BOTTOM,
+                             adler, src_start, length);
+  }
+  return _gvn.transform(new (C) ProjNode(call, TypeFunc::Parms));
+}
+
+/**
+ * Calculate Adler32 for byte[] array.
+ * int java.util.zip.Adler32.updateBytes(int adler, byte[] b, int off, int len)
+ */
+bool LibraryCallKit::inline_updateBytesAdler32() {
+  assert(UseAdler32Intrinsics, "Adler32 intrinsics are disabled");
+  assert(callee()->signature()->size() == 4, "updateBytes has 4 parameters");
+  // no receiver since it is static method
+  Node* adler   = argument(0); // type: int
+  Node* src     = argument(1); // type: oop
+  Node* offset  = argument(2); // type: int
+  Node* length  = argument(3); // type: int
+
+  const Type* src_type = src->Value(&_gvn);
+  const TypeAryPtr* top_src = src_type->isa_aryptr();
+  if (top_src  == NULL || top_src->klass()  == NULL) {
+    // failed array check
+    return false;
+  }
+
+  BasicType src_elem = src_type->isa_aryptr()->klass()->as_array_klass()->element_type()->basic_type();
+  if (src_elem != T_BYTE) {
+    return false;
+  }
+
+  // 'src_start' points to src array + scaled offset
+  Node* src_start = array_element_address(src, offset, src_elem);
+
+  // We assume that range check is done by caller.
+  set_result(make_adler32_call(adler, src_start, length));
+  return true;
+}
+
+/**
+ * Calculate Adler32 for ByteBuffer.
+ * int java.util.zip.Adler32.updateByteBuffer(int adler, long addr, int off, int len)
+ */
+bool LibraryCallKit::inline_updateByteBufferAdler32() {
+  assert(UseAdler32Intrinsics, "Adler32 intrinsics are disabled");
+  assert(callee()->signature()->size() == 5, "updateByteBuffer has 4 parameters and one is long");
+  // no receiver since it is static method
+  Node* adler   = argument(0); // type: int
+  Node* src     = argument(1); // type: long
+  Node* offset  = argument(3); // type: int
+  Node* length  = argument(4); // type: int
+
+  src = ConvL2X(src);  // adjust Java long to machine word
+  Node* base = _gvn.transform(new (C) CastX2PNode(src));
+  offset = ConvI2X(offset);
+
+  // 'src_start' points to src array + scaled offset
+  Node* src_start = basic_plus_adr(top(), base, offset);
+
+  set_result(make_adler32_call(adler, src_start, length));
+  return true;
+}
+
 //----------------------------inline_reference_get----------------------------
 // public T java.lang.ref.Reference.get();
 bool LibraryCallKit::inline_reference_get() {
@@ -6621,6 +6995,49 @@ Node* LibraryCallKit::inline_cipherBlockChaining_AESCrypt_predicate(bool decrypt
   return _gvn.transform(region);
 }
 
+//------------------------------inline_ghash_processBlocks-------------------
+//
+// Calculate GHASH for a run of 16-byte blocks.
+// static void com.sun.crypto.provider.GHASH.processBlocks(byte[] data, int inOfs, int blocks,
+//                                                         long[] st, long[] subH)
+//
+bool LibraryCallKit::inline_ghash_processBlocks() {
+  assert(UseGHASHIntrinsics, "need GHASH intrinsics support");
+  assert(callee()->signature()->size() == 5, "processBlocks has 5 parameters");
+
+  address stubAddr = StubRoutines::ghash_processBlocks();
+  const char *stubName = "ghash_processBlocks";
+  if (stubAddr == NULL) return false;
+
+  Node* data    = argument(0);
+  Node* offset  = argument(1);
+  Node* blocks  = argument(2);
+  Node* state   = argument(3);
+  Node* subkeyH = argument(4);
+
+  // The caller has checked the array bounds; only make sure we have the
+  // array types the stub expects.
+  const TypeAryPtr* data_type    = data->Value(&_gvn)->isa_aryptr();
+  const TypeAryPtr* state_type   = state->Value(&_gvn)->isa_aryptr();
+  const TypeAryPtr* subkeyH_type = subkeyH->Value(&_gvn)->isa_aryptr();
+  if (data_type == NULL || data_type->klass() == NULL ||
+      state_type == NULL || state_type->klass() == NULL ||
+      subkeyH_type == NULL || subkeyH_type->klass() == NULL) {
+    // failed array check
+    return false;
+  }
+
+  Node* state_start   = array_element_address(state, intcon(0), T_LONG);
+  Node* subkeyH_start = array_element_address(subkeyH, intcon(0), T_LONG);
+  Node* data_start    = array_element_address(data, offset, T_BYTE);
+
+  // Call the stub.
+  make_runtime_call(RC_LEAF|RC_NO_FP, OptoRuntime::ghash_processBlocks_Type(),
+                    stubAddr, stubName, TypePtr::BOTTOM,
+                    state_start, subkeyH_start, data_start, blocks);
+  return true;
+}
+
 //------------------------------inline_sha_implCompress-----------------------
 //
 // Calculate SHA (i.e., SHA-1) for single-block byte[] array.
@@ -34,6 +34,7 @@
 #include "opto/rootnode.hpp"
 #include "opto/runtime.hpp"
 #include "opto/subnode.hpp"
+#include "opto/vectornode.hpp"
 
 //------------------------------is_loop_exit-----------------------------------
 // Given an IfNode, return the loop-exiting projection or NULL if both
@@ -713,11 +714,18 @@ bool IdealLoopTree::policy_unroll( PhaseIdealLoop *phase ) const {
   uint body_size = _body.size();
   // Key test to unroll loop in CRC32 java code
   int xors_in_loop = 0;
+  // Locks of loop invariant objects, see below
+  int invariant_locks_in_loop = 0;
   // Also count ModL, DivL and MulL which expand mightly
   for (uint k = 0; k < _body.size(); k++) {
     Node* n = _body.at(k);
     switch (n->Opcode()) {
       case Op_XorI: xors_in_loop++; break; // CRC32 java code
+      case Op_Lock:
+        if (EliminateLocks && is_invariant(n->as_Lock()->obj_node()->uncast())) {
+          invariant_locks_in_loop++;
+        }
+        break;
       case Op_ModL: body_size += 30; break;
       case Op_DivL: body_size += 30; break;
       case Op_MulL: body_size += 10; break;
@@ -745,6 +753,14 @@ bool IdealLoopTree::policy_unroll( PhaseIdealLoop *phase ) const {
   // Check for being too big
   if (body_size > (uint)LoopUnrollLimit) {
     if (xors_in_loop >= 4 && body_size < (uint)LoopUnrollLimit*4) return true;
+    // Once unrolled, the unlock of one iteration directly precedes the
+    // lock of the next one and LockNode::Ideal coarsens them. Keep the
+    // unroll factor small so a coarsened region spans few iterations.
+    if (invariant_locks_in_loop > 0 &&
+        future_unroll_ct <= LockCoarseningUnrollLimit &&
+        body_size < (uint)(LoopUnrollLimit * LockCoarseningUnrollLimit)) {
+      return true;
+    }
     // Normal case: loop too big
     return false;
   }
@@ -1190,6 +1206,58 @@ bool IdealLoopTree::is_invariant(Node* n) const {
 }
 
 
+//------------------------------mark_reductions--------------------------------
+// A loop phi whose back edge value is computed from the phi itself by a
+// single associative operation, and which has no other use inside the loop,
+// is a reduction: after unrolling it forms a chain which SuperWord can fold
+// into one reduction of a vector.
+void PhaseIdealLoop::mark_reductions( IdealLoopTree *loop ) {
+  if (!SuperWordReductions) return;
+
+  CountedLoopNode* loop_head = loop->_head->as_CountedLoop();
+  if (loop_head->unrolled_count() > 1) return;
+
+  Node* trip_phi = loop_head->phi();
+  for (DUIterator_Fast imax, i = loop_head->fast_outs(imax); i < imax; i++) {
+    Node* phi = loop_head->fast_out(i);
+    if (!phi->is_Phi() || phi->outcnt() == 0 || phi == trip_phi) continue;
+    // For definitions which are loop inclusive and not tripcounts.
+    Node* def_node = phi->in(LoopNode::LoopBackControl);
+    if (def_node == NULL || def_node->is_CFG() || def_node->is_reduction()) continue;
+    if (!loop->is_member(get_loop(ctrl_or_self(def_node)))) continue;
+    int opc = def_node->Opcode();
+    if (ReductionNode::opcode(opc, def_node->bottom_type()->basic_type()) == opc) continue;
+
+    // The arithmetic node must consume the phi and feed it.
+    if (def_node->in(1) != phi && def_node->in(2) != phi) continue;
+
+    // Neither the phi nor the partial result may be used elsewhere in the
+    // loop, otherwise the intermediate values are observable.
+    bool ok = true;
+    for (DUIterator_Fast jmax, j = def_node->fast_outs(jmax); j < jmax && ok; j++) {
+      Node* u = def_node->fast_out(j);
+      if (u != phi && loop->is_member(get_loop(ctrl_or_self(u)))) {
+        ok = false;
+      }
+    }
+    for (DUIterator_Fast jmax, j = phi->fast_outs(jmax); j < jmax && ok; j++) {
+      Node* u = phi->fast_out(j);
+      if (u != def_node && loop->is_member(get_loop(ctrl_or_self(u)))) {
+        ok = false;
+      }
+    }
+    if (ok) {
+      def_node->add_flag(Node::Flag_is_reduction);
+#ifndef PRODUCT
+      if (TraceLoopOpts) {
+        tty->print("Reduction    ");
+        def_node->dump();
+      }
+#endif
+    }
+  }
+}
+
 //------------------------------do_unroll--------------------------------------
 // Unroll the loop body one step - make each trip do 2 iterations.
 void PhaseIdealLoop::do_unroll( IdealLoopTree *loop, Node_List &old_new, bool adjust_min_trip ) {
@@ -1215,6 +1283,10 @@ void PhaseIdealLoop::do_unroll( IdealLoopTree *loop, Node_List &old_new, bool ad
   // if rounds of unroll,optimize are making progress
   loop_head->set_node_count_before_unroll(loop->_body.size());
 
+  if (UseSuperWord && loop_head->is_main_loop()) {
+    mark_reductions(loop);
+  }
+
   Node *ctrl  = loop_head->in(LoopNode::EntryControl);
   Node *limit = loop_head->limit();
   Node *init  = loop_head->init_trip();
@@ -1527,6 +1599,32 @@ void PhaseIdealLoop::do_maximally_unroll( IdealLoopTree *loop, Node_List &old_ne
   }
 }
 
+//------------------------------max_unroll_loops-------------------------------
+// Peel and unroll small inner counted loops one maximal unrolling step
+// ahead of the regular loop opts. Run before escape analysis so that
+// array elements indexed by the trip counter get constant offsets and a
+// non-escaping array can be scalar replaced.
+void PhaseIdealLoop::max_unroll_loops(Node_List &old_new) {
+  for (LoopTreeIterator iter(_ltree_root); !iter.done(); iter.next()) {
+    IdealLoopTree* lpt = iter.current();
+    if (!lpt->is_inner() || !lpt->is_counted() || lpt->_irreducible ||
+        !lpt->_allow_optimizations || lpt->_has_call || lpt->tail()->is_top()) {
+      continue;
+    }
+    lpt->compute_exact_trip_count(this);
+    if (lpt->policy_do_one_iteration_loop(this) ||
+        lpt->policy_do_remove_empty_loop(this)) {
+      _max_unrolled_loops++;
+      continue;
+    }
+    CountedLoopNode* cl = lpt->_head->as_CountedLoop();
+    if (cl->is_normal_loop() && lpt->policy_maximally_unroll(this)) {
+      do_maximally_unroll(lpt, old_new);
+      _max_unrolled_loops++;
+    }
+  }
+}
+
 //------------------------------dominates_backedge---------------------------------
 // Returns true if ctrl is executed on every complete iteration
 bool IdealLoopTree::dominates_backedge(Node* ctrl) {
@@ -260,6 +260,151 @@ void PhaseIdealLoop::set_subtree_ctrl( Node *n ) {
   set_early_ctrl( n );
 }
 
+//------------------------------convert_long_loop_to_int-----------------------
+// Loops like
+//
+//   for (long i = init; i < limit; i += stride) { ... a[(int)i] ... }
+//
+// are never counted loops, so they get none of the range check or
+// unrolling optimizations.  When the types of init and limit show that the
+// trip counter and its increment can never leave int range, the long phi
+// and increment are replaced by an int phi and increment, the long uses
+// see a ConvI2L of them, and the exit test becomes a CmpI.  The loop is
+// then picked up as a counted loop on the next round of loop opts.
+bool PhaseIdealLoop::convert_long_loop_to_int( Node *x, IdealLoopTree *loop ) {
+  if (!ConvertLongLoopsToInt) {
+    return false;
+  }
+  if (x->in(LoopNode::Self) == NULL || x->req() != 3 || loop->_irreducible) {
+    return false;
+  }
+  Node *init_control = x->in(LoopNode::EntryControl);
+  Node *back_control = x->in(LoopNode::LoopBackControl);
+  if (init_control == NULL || back_control == NULL ||
+      init_control->is_top() || back_control->is_top()) {
+    return false;
+  }
+  if (back_control->Opcode() == Op_SafePoint) {
+    back_control = back_control->in(TypeFunc::Control);
+  }
+  if (back_control->Opcode() != Op_IfTrue && back_control->Opcode() != Op_IfFalse) {
+    return false;
+  }
+  Node *iff = back_control->in(0);
+  if (get_loop(iff) != loop || !iff->in(1)->is_Bool()) {
+    return false;
+  }
+  BoolNode *test = iff->in(1)->as_Bool();
+  BoolTest::mask bt = test->_test._test;
+  if (back_control->Opcode() == Op_IfFalse) {
+    bt = BoolTest(bt).negate();
+  }
+  Node *cmp = test->in(1);
+  if (cmp->Opcode() != Op_CmpL) {
+    return false;
+  }
+
+  // Find the trip counter (the phi or its increment) and the limit.
+  uint incr_idx = 1;
+  if (!is_member(loop, get_ctrl(cmp->in(1)))) {
+    incr_idx = 2;
+    bt = BoolTest(bt).commute();
+  }
+  Node *incr  = cmp->in(incr_idx);
+  Node *limit = cmp->in(3 - incr_idx);
+  if (is_member(loop, get_ctrl(limit)) || !is_member(loop, get_ctrl(incr))) {
+    return false;
+  }
+  Node *phi_incr = NULL;
+  if (incr->is_Phi()) {
+    phi_incr = incr;
+    incr = phi_incr->in(LoopNode::LoopBackControl);
+  }
+  if (incr == NULL || incr->Opcode() != Op_AddL) {
+    return false;
+  }
+  Node *phi    = incr->in(1);
+  Node *stride = incr->in(2);
+  if (!stride->is_Con()) {
+    phi    = incr->in(2);
+    stride = incr->in(1);
+  }
+  if (!stride->is_Con() || !phi->is_Phi() || phi->in(0) != x || phi->req() != 3 ||
+      phi->in(LoopNode::LoopBackControl) != incr ||
+      (phi_incr != NULL && phi_incr != phi)) {
+    return false;
+  }
+  jlong stride_con = stride->get_long();
+  if (stride_con == 0 || stride_con != (jlong)(jint)stride_con) {
+    return false;
+  }
+  if (bt == BoolTest::eq || bt == BoolTest::ne ||
+      ((bt == BoolTest::lt || bt == BoolTest::le) && stride_con < 0) ||
+      ((bt == BoolTest::gt || bt == BoolTest::ge) && stride_con > 0)) {
+    return false;
+  }
+
+  // The trip counter runs from init towards limit. Tested after the
+  // increment it never passes limit and the increment passes it by at most
+  // one stride; tested before the increment both may overshoot by one more.
+  Node *init = phi->in(LoopNode::EntryControl);
+  const TypeLong* init_t  = _igvn.type(init)->isa_long();
+  const TypeLong* limit_t = _igvn.type(limit)->isa_long();
+  if (init_t == NULL || limit_t == NULL ||
+      limit_t->_lo < min_jint || limit_t->_hi > max_jint ||
+      init_t->_lo  < min_jint || init_t->_hi  > max_jint) {
+    return false;
+  }
+  jlong overshoot = (phi_incr != NULL) ? 2 * stride_con : stride_con;
+  if (stride_con > 0) {
+    if (MAX2(init_t->_hi, limit_t->_hi) + overshoot > max_jint) {
+      return false;
+    }
+  } else {
+    if (MIN2(init_t->_lo, limit_t->_lo) + overshoot < min_jint) {
+      return false;
+    }
+  }
+
+  Node* init_i = new (C) ConvL2INode(init);
+  register_new_node(init_i, get_ctrl(init));
+  Node* limit_i = new (C) ConvL2INode(limit);
+  register_new_node(limit_i, get_ctrl(limit));
+  Node* stride_i = _igvn.intcon((jint)stride_con);
+  set_ctrl(stride_i, C->root());
+
+  PhiNode* phi_i = PhiNode::make(x, init_i, TypeInt::INT);
+  Node* incr_i = new (C) AddINode(phi_i, stride_i);
+  register_new_node(incr_i, get_ctrl(incr));
+  phi_i->set_req(LoopNode::LoopBackControl, incr_i);
+  register_new_node(phi_i, x);
+
+  Node* trip_i = (phi_incr != NULL) ? (Node*)phi_i : incr_i;
+  Node* cmp_i = (incr_idx == 1) ? new (C) CmpINode(trip_i, limit_i)
+                                : new (C) CmpINode(limit_i, trip_i);
+  register_new_node(cmp_i, get_ctrl(cmp));
+  Node* test_i = new (C) BoolNode(cmp_i, test->_test._test);
+  register_new_node(test_i, get_ctrl(test));
+  _igvn.replace_input_of(iff, 1, test_i);
+
+  // Remaining long uses of the trip counter see the widened int values.
+  Node* incr_l = new (C) ConvI2LNode(incr_i);
+  register_new_node(incr_l, get_ctrl(incr));
+  Node* phi_l = new (C) ConvI2LNode(phi_i);
+  register_new_node(phi_l, x);
+  _igvn.replace_node(incr, incr_l);
+  _igvn.replace_node(phi, phi_l);
+
+#ifndef PRODUCT
+  if (TraceLoopOpts) {
+    tty->print("LongToIntLoop ");
+    loop->dump_head();
+  }
+#endif
+  C->set_major_progress();
+  return true;
+}
+
 //------------------------------is_counted_loop--------------------------------
 bool PhaseIdealLoop::is_counted_loop( Node *x, IdealLoopTree *loop ) {
   PhaseGVN *gvn = &_igvn;
@@ -278,13 +423,19 @@ bool PhaseIdealLoop::is_counted_loop( Node *x, IdealLoopTree *loop ) {
     return false;
 
   // Allow funny placement of Safepoint
+  SafePointNode* strip_mine_sfpt = NULL;
   if (back_control->Opcode() == Op_SafePoint) {
     if (UseCountedLoopSafepoints) {
-      // Leaving the safepoint on the backedge and creating a
-      // CountedLoop will confuse optimizations. We can't move the
-      // safepoint around because its jvm state wouldn't match a new
-      // location. Give up on that loop.
-      return false;
+      if (LoopStripMiningIter <= 1 || back_control->in(TypeFunc::Control)->outcnt() != 1) {
+        // Leaving the safepoint on the backedge and creating a
+        // CountedLoop will confuse optimizations. We can't move the
+        // safepoint around because its jvm state wouldn't match a new
+        // location. Give up on that loop.
+        return false;
+      }
+      // The safepoint stays on the back edge of an outer loop, see
+      // strip_mine_counted_loop(), where its jvm state is still valid.
+      strip_mine_sfpt = back_control->as_SafePoint();
     }
     back_control = back_control->in(TypeFunc::Control);
   }
@@ -693,6 +844,11 @@ bool PhaseIdealLoop::is_counted_loop( Node *x, IdealLoopTree *loop ) {
 
   } // LoopLimitCheck
 
+  if (strip_mine_sfpt != NULL && bt == BoolTest::ne) {
+    // An inequality test may wrap around the strip limit. Keep the safepoint.
+    return false;
+  }
+
   if (!UseCountedLoopSafepoints) {
     // Check for SafePoint on backedge and remove
     Node *sfpt = x->in(LoopNode::LoopBackControl);
@@ -786,6 +942,12 @@ bool PhaseIdealLoop::is_counted_loop( Node *x, IdealLoopTree *loop ) {
   _igvn.register_new_node_with_optimizer(l);
   set_loop(l, loop);
   loop->_head = l;
+  // Keep the back edge safepoint alive while the old loop head dies.
+  Node* sfpt_hook = NULL;
+  if (strip_mine_sfpt != NULL) {
+    sfpt_hook = new (C) Node(1);
+    sfpt_hook->init_req(0, strip_mine_sfpt);
+  }
   // Fix all data nodes placed at the old loop head.
   // Uses the lazy-update mechanism of 'get_ctrl'.
   lazy_replace( x, l );
@@ -805,6 +967,11 @@ bool PhaseIdealLoop::is_counted_loop( Node *x, IdealLoopTree *loop ) {
   // Free up intermediate goo
   _igvn.remove_dead_node(hook);
 
+  if (strip_mine_sfpt != NULL) {
+    strip_mine_counted_loop(loop, strip_mine_sfpt);
+    sfpt_hook->disconnect_inputs(NULL, C);
+  }
+
 #ifdef ASSERT
   assert(l->is_valid_counted_loop(), "counted loop shape is messed up");
   assert(l == loop->_head && l->phi() == phi && l->loopexit() == lex, "" );
@@ -821,6 +988,144 @@ bool PhaseIdealLoop::is_counted_loop( Node *x, IdealLoopTree *loop ) {
   return true;
 }
 
+//------------------------------strip_mine_counted_loop------------------------
+// The back edge safepoint of a counted loop was kept for UseCountedLoopSafepoints.
+// Nest the loop in an outer loop which carries the safepoint, and limit the
+// inner loop, which then has no safepoint, to LoopStripMiningIter iterations
+// per outer iteration:
+//
+//   outer: io = phi(init, incr)
+//          inner_limit = (stride > 0) ? MIN(limit, io + stride*N)
+//                                     : MAX(limit, io + stride*N)
+//   inner: i = phi(io, incr)
+//          ...
+//          incr = i + stride
+//          if (incr < inner_limit) goto inner
+//          if (incr < limit) { safepoint; goto outer }
+//
+// The inner loop is a regular counted loop that can be unrolled, range check
+// eliminated and vectorized; the strip limit is computed in long arithmetic
+// so it cannot overflow.
+void PhaseIdealLoop::strip_mine_counted_loop(IdealLoopTree *loop, SafePointNode *sfpt) {
+  CountedLoopNode* cl = loop->_head->as_CountedLoop();
+  CountedLoopEndNode* cle = cl->loopexit();
+  Node* entry = cl->in(LoopNode::EntryControl);
+  Node* back = cl->in(LoopNode::LoopBackControl);
+  Node* exit = cle->proj_out(false);
+  Node* iv = cl->phi();
+  assert(sfpt->in(TypeFunc::Control) == back && sfpt->outcnt() == 1, "dangling back edge safepoint");
+
+  if (loop->_safepts != NULL) {
+    loop->_safepts->yank(sfpt);
+  }
+
+  // Make the outer loop and insert it in the loop tree.
+  LoopNode* outer = new (C) LoopNode(entry, sfpt);
+  _igvn.register_new_node_with_optimizer(outer);
+  set_created_loop_node();
+  IdealLoopTree* outer_loop = new IdealLoopTree(this, outer, sfpt);
+  IdealLoopTree* parent = loop->_parent;
+  IdealLoopTree** pp = &parent->_child;
+  while (*pp != loop) {
+    pp = &(*pp)->_next;
+  }
+  *pp = outer_loop;
+  outer_loop->_parent = parent;
+  outer_loop->_next = loop->_next;
+  outer_loop->_child = loop;
+  outer_loop->_has_call = loop->_has_call;
+  outer_loop->_has_sfpt = 1;
+  loop->_parent = outer_loop;
+  loop->_next = NULL;
+  loop->_tail = back;
+  loop->_has_sfpt = 1;  // the outer loop polls
+  outer_loop->_nest = loop->_nest;
+  loop->set_nest(loop->_nest + 1);
+  set_loop(outer, outer_loop);
+  set_loop(sfpt, outer_loop);
+  _igvn.replace_input_of(cl, LoopNode::EntryControl, outer);
+
+  // Split all the Phis up between the inner and the outer loop.
+  Node* outer_iv = NULL;
+  for (DUIterator_Fast jmax, j = cl->fast_outs(jmax); j < jmax; j++) {
+    Node* out = cl->fast_out(j);
+    if (out->is_Phi()) {
+      PhiNode* old_phi = out->as_Phi();
+      Node* phi = PhiNode::make_blank(outer, old_phi);
+      phi->init_req(LoopNode::EntryControl,    old_phi->in(LoopNode::EntryControl));
+      phi->init_req(LoopNode::LoopBackControl, old_phi->in(LoopNode::LoopBackControl));
+      register_new_node(phi, outer);
+      _igvn.replace_input_of(old_phi, LoopNode::EntryControl, phi);
+      if (old_phi == iv) {
+        outer_iv = phi;
+      }
+    }
+  }
+  assert(outer_iv != NULL, "no induction variable");
+
+  // Compute the strip limit at the head of the outer loop.
+  int stride_con = cl->stride_con();
+  jlong span = (jlong)stride_con * (jlong)LoopStripMiningIter;
+  Node* span_con = _igvn.longcon(span);
+  set_ctrl(span_con, C->root());
+  Node* outer_iv_l = new (C) ConvI2LNode(outer_iv);
+  register_new_node(outer_iv_l, outer);
+  Node* limit_l = new (C) ConvI2LNode(cl->limit());
+  register_new_node(limit_l, outer);
+  Node* strip = new (C) AddLNode(outer_iv_l, span_con);
+  register_new_node(strip, outer);
+  Node* strip_cmp = new (C) CmpLNode(strip, limit_l);
+  register_new_node(strip_cmp, outer);
+  Node* strip_bol = new (C) BoolNode(strip_cmp, stride_con > 0 ? BoolTest::lt : BoolTest::gt);
+  register_new_node(strip_bol, outer);
+  Node* strip_sel = CMoveNode::make(C, NULL, strip_bol, limit_l, strip, TypeLong::LONG);
+  register_new_node(strip_sel, outer);
+  Node* inner_limit = new (C) ConvL2INode(strip_sel);
+  register_new_node(inner_limit, outer);
+
+  // The inner loop exits to the original exit test, which now guards
+  // the back edge of the outer loop.
+  BoolNode* test = cle->in(CountedLoopEndNode::TestValue)->as_Bool();
+  Node* test_ctrl = get_ctrl(test);
+  Node* inner_cmp = test->in(1)->clone();
+  inner_cmp->set_req(2, inner_limit);
+  register_new_node(inner_cmp, test_ctrl);
+  Node* inner_test = test->clone();
+  inner_test->set_req(1, inner_cmp);
+  register_new_node(inner_test, test_ctrl);
+
+  Node* inner_exit = new (C) IfFalseNode(cle);
+  _igvn.register_new_node_with_optimizer(inner_exit);
+  IfNode* outer_end = new (C) IfNode(inner_exit, test, cle->_prob, cle->_fcnt);
+  _igvn.register_new_node_with_optimizer(outer_end);
+  Node* outer_back = new (C) IfTrueNode(outer_end);
+  _igvn.register_new_node_with_optimizer(outer_back);
+  _igvn.replace_input_of(cle, CountedLoopEndNode::TestValue, inner_test);
+  _igvn.replace_input_of(exit, 0, outer_end);
+  _igvn.replace_input_of(sfpt, TypeFunc::Control, outer_back);
+  set_loop(inner_exit, outer_loop);
+  set_loop(outer_end, outer_loop);
+  set_loop(outer_back, outer_loop);
+
+  // Fix the dominator tree.
+  uint dd = dom_depth(cl);
+  set_idom(outer, entry, dd);
+  set_idom(cl, outer, dd + 1);
+  set_idom(inner_exit, cle, dom_depth(cle) + 1);
+  set_idom(outer_end, inner_exit, dom_depth(cle) + 2);
+  set_idom(outer_back, outer_end, dom_depth(cle) + 3);
+  set_idom(sfpt, outer_back, dom_depth(cle) + 4);
+  set_idom(exit, outer_end, dom_depth(cle) + 3);
+  recompute_dom_depth();
+
+#ifndef PRODUCT
+  if (TraceLoopOpts) {
+    tty->print("StripMined   ");
+    loop->dump_head();
+  }
+#endif
+}
+
 //----------------------exact_limit-------------------------------------------
 Node* PhaseIdealLoop::exact_limit( IdealLoopTree *loop ) {
   assert(loop->_head->is_CountedLoop(), "");
@@ -1864,6 +2169,10 @@ void IdealLoopTree::counted_loop( PhaseIdealLoop *phase ) {
     if (_head->is_Loop()) _head->as_Loop()->set_inner_loop();
   }
 
+  // Strip mining may nest this loop in a new outer loop which takes
+  // over the siblings.
+  IdealLoopTree* next = _next;
+
   if (_head->is_CountedLoop() ||
       phase->is_counted_loop(_head, this)) {
 
@@ -1879,6 +2188,8 @@ void IdealLoopTree::counted_loop( PhaseIdealLoop *phase ) {
     // Look for induction variables
     phase->replace_parallel_iv(this);
 
+  } else if (phase->convert_long_loop_to_int(_head, this)) {
+    // Becomes a counted loop on the next round of loop opts.
   } else if (_parent != NULL && !_irreducible) {
     // Not a counted loop. Keep one safepoint.
     bool keep_one_sfpt = true;
@@ -1887,7 +2198,7 @@ void IdealLoopTree::counted_loop( PhaseIdealLoop *phase ) {
 
   // Recursively
   if (_child) _child->counted_loop( phase );
-  if (_next)  _next ->counted_loop( phase );
+  if (next)   next  ->counted_loop( phase );
 }
 
 #ifndef PRODUCT
@@ -2139,9 +2450,12 @@ bool PhaseIdealLoop::process_expensive_nodes() {
 //----------------------------build_and_optimize-------------------------------
 // Create a PhaseLoop.  Build the ideal Loop tree.  Map each Ideal Node to
 // its corresponding LoopNode.  If 'optimize' is true, do some loop cleanups.
-void PhaseIdealLoop::build_and_optimize(bool do_split_ifs, bool skip_loop_opts) {
+void PhaseIdealLoop::build_and_optimize(bool do_split_ifs, bool skip_loop_opts, bool max_unroll_only) {
+  assert(!max_unroll_only || skip_loop_opts, "max unrolling is the only loop opt done");
   ResourceMark rm;
 
+  _max_unrolled_loops = 0;
+
   int old_progress = C->major_progress();
   uint orig_worklist_size = _igvn._worklist.size();
 
@@ -2342,6 +2656,11 @@ void PhaseIdealLoop::build_and_optimize(bool do_split_ifs, bool skip_loop_opts)
 #endif
 
   if (skip_loop_opts) {
+    if (max_unroll_only && C->has_loops()) {
+      memset( worklist.adr(), 0, worklist.Size()*sizeof(Node*) );
+      max_unroll_loops(worklist);
+    }
+
     // restore major progress flag
     for (int i = 0; i < old_progress; i++) {
       C->set_major_progress();
@@ -527,6 +527,9 @@ class PhaseIdealLoop : public PhaseTransform {
   const PhaseIdealLoop* _verify_me;
   bool _verify_only;
 
+  // Loops maximally unrolled in a max_unroll_only pass
+  uint _max_unrolled_loops;
+
   // Allocate _preorders[] array
   void allocate_preorders() {
     _max_preorder = C->unique()+8;
@@ -780,7 +783,10 @@ private:
   }
 
   // build the loop tree and perform any requested optimizations
-  void build_and_optimize(bool do_split_if, bool skip_loop_opts);
+  void build_and_optimize(bool do_split_if, bool skip_loop_opts, bool max_unroll_only = false);
+
+  // Step towards fully unrolling small counted loops, used before escape analysis
+  void max_unroll_loops(Node_List &old_new);
 
 public:
   // Dominators for the sea of nodes
@@ -790,16 +796,22 @@ public:
   }
   Node *dom_lca_internal( Node *n1, Node *n2 ) const;
 
-  // Compute the Ideal Node to Loop mapping
-  PhaseIdealLoop( PhaseIterGVN &igvn, bool do_split_ifs, bool skip_loop_opts = false) :
+  // Compute the Ideal Node to Loop mapping. With max_unroll_only (which
+  // requires skip_loop_opts) the only loop transformation done is a step
+  // of maximal unrolling of small counted loops.
+  PhaseIdealLoop( PhaseIterGVN &igvn, bool do_split_ifs, bool skip_loop_opts = false,
+                  bool max_unroll_only = false) :
     PhaseTransform(Ideal_Loop),
     _igvn(igvn),
     _dom_lca_tags(arena()), // Thread::resource_area
     _verify_me(NULL),
     _verify_only(false) {
-    build_and_optimize(do_split_ifs, skip_loop_opts);
+    build_and_optimize(do_split_ifs, skip_loop_opts, max_unroll_only);
   }
 
+  // Number of loops the max_unroll_only pass peeled or unrolled
+  uint max_unrolled_loops() const { return _max_unrolled_loops; }
+
   // Verify that verify_me made the same decisions as a fresh run.
   PhaseIdealLoop( PhaseIterGVN &igvn, const PhaseIdealLoop *verify_me) :
     PhaseTransform(Ideal_Loop),
@@ -825,6 +837,10 @@ public:
   virtual Node *transform( Node *a_node ) { return 0; }
 
   bool is_counted_loop( Node *x, IdealLoopTree *loop );
+  // Rewrite a long trip counter that stays in int range as an int one
+  bool convert_long_loop_to_int( Node *x, IdealLoopTree *loop );
+  // Move the back edge safepoint of a counted loop to an outer loop
+  void strip_mine_counted_loop( IdealLoopTree *loop, SafePointNode *sfpt );
 
   Node* exact_limit( IdealLoopTree *loop );
 
@@ -883,6 +899,10 @@ public:
   // Unroll the loop body one step - make each trip do 2 iterations.
   void do_unroll( IdealLoopTree *loop, Node_List &old_new, bool adjust_min_trip );
 
+  // Mark the loop carried arithmetic which SuperWord may vectorize as
+  // a reduction.  Done once, before the first unroll, so clones inherit it.
+  void mark_reductions( IdealLoopTree *loop );
+
   // Return true if exp is a constant times an induction var
   bool is_scaled_iv(Node* exp, Node* iv, int* p_scale);
 
@@ -292,6 +292,9 @@ public:
   // Should original key array reference be passed to AES stubs
   static const bool pass_original_key_for_aes();
 
+  // Does the AryEq match rule also handle byte[] arguments
+  static const bool byte_array_equals_supported();
+
   // Used to determine a "low complexity" 64-bit constant.  (Zero is simple.)
   // The standard of comparison is one (StoreL ConL) vs. two (StoreI ConI).
   // Depends on the details of 64-bit constant generation on the CPU.
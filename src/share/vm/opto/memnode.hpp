@@ -1004,11 +1004,18 @@ public:
 
 //------------------------------AryEq---------------------------------------
 class AryEqNode: public StrIntrinsicNode {
+private:
+  bool _is_byte;                // compares byte[] instead of char[] arrays
+  virtual uint hash() const { return StrIntrinsicNode::hash() + _is_byte; }
+  virtual uint cmp(const Node& n) const { return _is_byte == ((AryEqNode&)n)._is_byte; }
+  virtual uint size_of() const { return sizeof(*this); }
 public:
-  AryEqNode(Node* control, Node* char_array_mem, Node* s1, Node* s2):
-    StrIntrinsicNode(control, char_array_mem, s1, s2) {};
+  AryEqNode(Node* control, Node* ary_mem, Node* s1, Node* s2, bool is_byte = false):
+    StrIntrinsicNode(control, ary_mem, s1, s2), _is_byte(is_byte) {};
   virtual int Opcode() const;
   virtual const Type* bottom_type() const { return TypeInt::BOOL; }
+  virtual const TypePtr* adr_type() const { return _is_byte ? TypeAryPtr::BYTES : TypeAryPtr::CHARS; }
+  bool is_byte() const { return _is_byte; }
 };
 
 
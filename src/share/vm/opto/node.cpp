@@ -645,7 +645,7 @@ void Node::destruct() {
     if( ((char*)this) + node_size == compile->node_arena()->hwm() )
       reclaim_node+= node_size;
 #else
-    compile->node_arena()->Afree(this,node_size);
+    compile->free_node_storage(this,node_size);
 #endif
   }
   if (is_macro()) {
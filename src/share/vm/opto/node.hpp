@@ -214,7 +214,7 @@ public:
   // New Operator that takes a Compile pointer, this will eventually
   // be the "new" New operator.
   inline void* operator new( size_t x, Compile* C) throw() {
-    Node* n = (Node*)C->node_arena()->Amalloc_D(x);
+    Node* n = (Node*)C->alloc_node_storage(x);
 #ifdef ASSERT
     n->_in = (Node**)n; // magic cookie for assertion check
 #endif
@@ -667,7 +667,8 @@ public:
     Flag_avoid_back_to_back_after    = Flag_avoid_back_to_back_before << 1,
     Flag_has_call                    = Flag_avoid_back_to_back_after << 1,
     Flag_is_expensive                = Flag_has_call << 1,
-    _max_flags = (Flag_is_expensive << 1) - 1 // allow flags combination
+    Flag_is_reduction                = Flag_is_expensive << 1,
+    _max_flags = (Flag_is_reduction << 1) - 1 // allow flags combination
   };
 
 private:
@@ -694,6 +695,10 @@ public:
 
   const jushort flags() const { return _flags; }
 
+  void add_flag(jushort fl) { init_flags(fl); }
+
+  void remove_flag(jushort fl) { clear_flag(fl); }
+
   // Return a dense integer opcode number
   virtual int Opcode() const;
 
@@ -844,6 +849,8 @@ public:
   bool is_macro() const { return (_flags & Flag_is_macro) != 0; }
   // The node is expensive: the best control is set during loop opts
   bool is_expensive() const { return (_flags & Flag_is_expensive) != 0 && in(0) != NULL; }
+  // An arithmetic node which accumulates a loop carried value
+  bool is_reduction() const { return (_flags & Flag_is_reduction) != 0; }
 
 //----------------- Optimization
 
@@ -1412,6 +1419,10 @@ public:
     return b;
   }
   void yank( Node *n ) { _in_worklist >>= n->_idx; Node_List::yank(n); }
+  // Drop membership without scanning the list for n. Its entry stays and
+  // pop() still returns it, so only use this for nodes that are harmless
+  // to visit again, such as dead nodes in IGVN.
+  void remove_lazily( Node *n ) { _in_worklist >>= n->_idx; }
   void  clear() {
     _in_worklist.Clear();        // Discards storage but grows automatically
     Node_List::clear();
@@ -1056,7 +1056,7 @@ void PhaseIterGVN::optimize() {
         verify_step((Node*) NULL);  // ignore n, it might be subsumed
       }
 #endif
-    } else if (!n->is_top()) {
+    } else if (!n->is_top() && !C->is_dead_node(n->_idx)) {
       remove_dead_node(n);
     }
   }
@@ -1325,8 +1325,10 @@ void PhaseIterGVN::remove_globally_dead_node( Node *dead ) {
     } else {
       // Finished disconnecting all input and output edges.
       _stack.pop();
-      // Remove dead node from iterative worklist
-      _worklist.remove(dead);
+      // Remove dead node from iterative worklist. A linear search for it
+      // makes removing many dead nodes quadratic in the worklist size;
+      // optimize() skips the dead node if it pops the stale entry.
+      _worklist.remove_lazily(dead);
       // Constant node that has no out-edges and has only one in-edge from
       // root is usually dead. However, sometimes reshaping walk makes
       // it reachable by adding use edges. So, we will NOT count Con nodes
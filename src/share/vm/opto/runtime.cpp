@@ -815,6 +815,27 @@ const TypeFunc* OptoRuntime::array_fill_Type() {
   return TypeFunc::make(domain, range);
 }
 
+// SharedRuntime::unsafe_set_memory(void* dst, size_t size, jlong value)
+const TypeFunc* OptoRuntime::unsafe_setmemory_Type() {
+  const Type** fields;
+  int argp = TypeFunc::Parms;
+  // create input type (domain): pointer, size_t, long
+  fields = TypeTuple::fields(4 LP64_ONLY( + 1));
+  fields[argp++] = TypePtr::NOTNULL;
+  fields[argp++] = TypeX_X;               // size in bytes (size_t)
+  LP64_ONLY(fields[argp++] = Type::HALF); // other half of long length
+  fields[argp++] = TypeLong::LONG;        // fill value, passed as a long
+  fields[argp++] = Type::HALF;            // so no int widening is needed
+  const TypeTuple *domain = TypeTuple::make(argp, fields);
+
+  // create result type
+  fields = TypeTuple::fields(1);
+  fields[TypeFunc::Parms+0] = NULL; // void
+  const TypeTuple *range = TypeTuple::make(TypeFunc::Parms, fields);
+
+  return TypeFunc::make(domain, range);
+}
+
 // for aescrypt encrypt/decrypt operations, just three pointers returning void (length is constant)
 const TypeFunc* OptoRuntime::aescrypt_block_Type() {
   // create input type (domain)
@@ -841,6 +862,26 @@ const TypeFunc* OptoRuntime::aescrypt_block_Type() {
   return TypeFunc::make(domain, range);
 }
 
+// void ghash_processBlocks(long* state, long* subkeyH, byte* data, int blocks)
+const TypeFunc* OptoRuntime::ghash_processBlocks_Type() {
+  int argcnt = 4;
+
+  const Type** fields = TypeTuple::fields(argcnt);
+  int argp = TypeFunc::Parms;
+  fields[argp++] = TypePtr::NOTNULL;    // state
+  fields[argp++] = TypePtr::NOTNULL;    // subkeyH
+  fields[argp++] = TypePtr::NOTNULL;    // data
+  fields[argp++] = TypeInt::INT;        // blocks
+  assert(argp == TypeFunc::Parms+argcnt, "correct decoding");
+  const TypeTuple* domain = TypeTuple::make(TypeFunc::Parms+argcnt, fields);
+
+  // result type needed
+  fields = TypeTuple::fields(1);
+  fields[TypeFunc::Parms+0] = NULL; // void
+  const TypeTuple* range = TypeTuple::make(TypeFunc::Parms, fields);
+  return TypeFunc::make(domain, range);
+}
+
 /**
  * int updateBytesCRC32(int crc, byte* b, int len)
  */
@@ -946,6 +987,55 @@ const TypeFunc* OptoRuntime::digestBase_implCompressMB_Type() {
   return TypeFunc::make(domain, range);
 }
 
+/**
+ * int charArrayHashCode(char* buf, int len, int init)
+ * int byteArrayHashCode(byte* buf, int len, int init)
+ */
+const TypeFunc* OptoRuntime::vectorizedHashCode_Type() {
+  // create input type (domain)
+  int num_args      = 3;
+  int argcnt = num_args;
+  const Type** fields = TypeTuple::fields(argcnt);
+  int argp = TypeFunc::Parms;
+  fields[argp++] = TypePtr::NOTNULL;    // buf
+  fields[argp++] = TypeInt::INT;        // len
+  fields[argp++] = TypeInt::INT;        // init
+  assert(argp == TypeFunc::Parms+argcnt, "correct decoding");
+  const TypeTuple* domain = TypeTuple::make(TypeFunc::Parms+argcnt, fields);
+
+  // result type needed
+  fields = TypeTuple::fields(1);
+  fields[TypeFunc::Parms+0] = TypeInt::INT; // hash result
+  const TypeTuple* range = TypeTuple::make(TypeFunc::Parms+1, fields);
+  return TypeFunc::make(domain, range);
+}
+
+/**
+ * long vectorizedMismatch(void* a, void* b, size_t length_in_bytes)
+ *
+ * Returns the byte offset of the first difference, or -1.
+ */
+const TypeFunc* OptoRuntime::vectorizedMismatch_Type() {
+  // create input type (domain)
+  int num_args      = 3;
+  int argcnt = num_args LP64_ONLY(+ 1);
+  const Type** fields = TypeTuple::fields(argcnt);
+  int argp = TypeFunc::Parms;
+  fields[argp++] = TypePtr::NOTNULL;    // a
+  fields[argp++] = TypePtr::NOTNULL;    // b
+  fields[argp++] = TypeX_X;             // length in bytes (size_t)
+  LP64_ONLY(fields[argp++] = Type::HALF); // other half of long length
+  assert(argp == TypeFunc::Parms+argcnt, "correct decoding");
+  const TypeTuple* domain = TypeTuple::make(TypeFunc::Parms+argcnt, fields);
+
+  // result type needed
+  fields = TypeTuple::fields(2);
+  fields[TypeFunc::Parms+0] = TypeLong::LONG; // mismatch offset
+  fields[TypeFunc::Parms+1] = Type::HALF;
+  const TypeTuple* range = TypeTuple::make(TypeFunc::Parms+2, fields);
+  return TypeFunc::make(domain, range);
+}
+
 const TypeFunc* OptoRuntime::multiplyToLen_Type() {
   // create input type (domain)
   int num_args      = 6;
@@ -296,9 +296,11 @@ private:
   static const TypeFunc* slow_arraycopy_Type();   // the full routine
 
   static const TypeFunc* array_fill_Type();
+  static const TypeFunc* unsafe_setmemory_Type();
 
   static const TypeFunc* aescrypt_block_Type();
   static const TypeFunc* cipherBlockChaining_aescrypt_Type();
+  static const TypeFunc* ghash_processBlocks_Type();
 
   static const TypeFunc* sha_implCompress_Type();
   static const TypeFunc* digestBase_implCompressMB_Type();
@@ -313,6 +315,9 @@ private:
 
   static const TypeFunc* updateBytesCRC32_Type();
 
+  static const TypeFunc* vectorizedHashCode_Type();
+  static const TypeFunc* vectorizedMismatch_Type();
+
   // leaf on stack replacement interpreter accessor types
   static const TypeFunc* osr_end_Type();
 
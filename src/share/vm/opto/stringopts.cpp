@@ -27,6 +27,7 @@
 #include "opto/addnode.hpp"
 #include "opto/callGenerator.hpp"
 #include "opto/callnode.hpp"
+#include "opto/connode.hpp"
 #include "opto/divnode.hpp"
 #include "opto/graphKit.hpp"
 #include "opto/idealKit.hpp"
@@ -61,7 +62,8 @@ class StringConcat : public ResourceObj {
     StringMode,
     IntMode,
     CharMode,
-    StringNullCheckMode
+    StringNullCheckMode,
+    BoolMode
   };
 
   StringConcat(PhaseStringOpts* stringopts, CallStaticJavaNode* end):
@@ -127,6 +129,9 @@ class StringConcat : public ResourceObj {
   void push_char(Node* value) {
     push(value, CharMode);
   }
+  void push_bool(Node* value) {
+    push(value, BoolMode);
+  }
 
   static bool is_SB_toString(Node* call) {
     if (call->is_CallStaticJava()) {
@@ -414,14 +419,17 @@ StringConcat* PhaseStringOpts::build_candidate(CallStaticJavaNode* call) {
   ciSymbol* string_sig;
   ciSymbol* int_sig;
   ciSymbol* char_sig;
+  ciSymbol* bool_sig;
   if (m->holder() == C->env()->StringBuilder_klass()) {
     string_sig = ciSymbol::String_StringBuilder_signature();
     int_sig = ciSymbol::int_StringBuilder_signature();
     char_sig = ciSymbol::char_StringBuilder_signature();
+    bool_sig = ciSymbol::bool_StringBuilder_signature();
   } else if (m->holder() == C->env()->StringBuffer_klass()) {
     string_sig = ciSymbol::String_StringBuffer_signature();
     int_sig = ciSymbol::int_StringBuffer_signature();
     char_sig = ciSymbol::char_StringBuffer_signature();
+    bool_sig = ciSymbol::bool_StringBuffer_signature();
   } else {
     return NULL;
   }
@@ -454,6 +462,7 @@ StringConcat* PhaseStringOpts::build_candidate(CallStaticJavaNode* call) {
       Node* result = alloc->result_cast();
       if (result == NULL || !result->is_CheckCastPP() || alloc->in(TypeFunc::Memory)->is_top()) {
         // strange looking allocation
+        log_bailout("strange_allocation", call);
 #ifndef PRODUCT
         if (PrintOptimizeStringConcat) {
           tty->print("giving up because allocation looks strange ");
@@ -481,6 +490,7 @@ StringConcat* PhaseStringOpts::build_candidate(CallStaticJavaNode* call) {
               const Type* type = _gvn->type(use->in(TypeFunc::Parms + 1));
               if (type == TypePtr::NULL_PTR) {
                 // StringBuilder(null) throws exception.
+                log_bailout("null_constructor_argument", call);
 #ifndef PRODUCT
                 if (PrintOptimizeStringConcat) {
                   tty->print("giving up because StringBuilder(null) throws exception");
@@ -507,6 +517,7 @@ StringConcat* PhaseStringOpts::build_candidate(CallStaticJavaNode* call) {
       }
       if (constructor == NULL) {
         // couldn't find constructor
+        log_bailout("no_constructor", call);
 #ifndef PRODUCT
         if (PrintOptimizeStringConcat) {
           tty->print("giving up because couldn't find constructor ");
@@ -535,13 +546,16 @@ StringConcat* PhaseStringOpts::build_candidate(CallStaticJavaNode* call) {
                cnode->method()->name() == ciSymbol::append_name() &&
                (cnode->method()->signature()->as_symbol() == string_sig ||
                 cnode->method()->signature()->as_symbol() == char_sig ||
-                cnode->method()->signature()->as_symbol() == int_sig)) {
+                cnode->method()->signature()->as_symbol() == int_sig ||
+                cnode->method()->signature()->as_symbol() == bool_sig)) {
       sc->add_control(cnode);
       Node* arg = cnode->in(TypeFunc::Parms + 1);
       if (cnode->method()->signature()->as_symbol() == int_sig) {
         sc->push_int(arg);
       } else if (cnode->method()->signature()->as_symbol() == char_sig) {
         sc->push_char(arg);
+      } else if (cnode->method()->signature()->as_symbol() == bool_sig) {
+        sc->push_bool(arg);
       } else {
         if (arg->is_Proj() && arg->in(0)->is_CallStaticJava()) {
           CallStaticJavaNode* csj = arg->in(0)->as_CallStaticJava();
@@ -567,6 +581,7 @@ StringConcat* PhaseStringOpts::build_candidate(CallStaticJavaNode* call) {
       continue;
     } else {
       // some unhandled signature
+      log_bailout("unexpected_signature", cnode);
 #ifndef PRODUCT
       if (PrintOptimizeStringConcat) {
         tty->print("giving up because encountered unexpected signature ");
@@ -742,6 +757,7 @@ bool StringConcat::validate_mem_flow() {
         while (mem->is_MergeMem()) {
           for (uint i = 1; i < mem->req(); i++) {
             if (i != Compile::AliasIdxBot && mem->in(i) != C->top()) {
+              _stringopts->log_bailout("memory_side_effects", _begin);
 #ifndef PRODUCT
               if (PrintOptimizeStringConcat) {
                 tty->print("fusion has incorrect memory flow (side effects) for ");
@@ -762,6 +778,7 @@ bool StringConcat::validate_mem_flow() {
           Node *prev = mem->in(0);
           NOT_PRODUCT(path.push(prev);)
           if (!prev->is_Call() || !_control.contains(prev)) {
+            _stringopts->log_bailout("memory_from_unknown_call", _begin);
 #ifndef PRODUCT
             if (PrintOptimizeStringConcat) {
               tty->print("fusion has incorrect memory flow (unknown call) for ");
@@ -773,6 +790,7 @@ bool StringConcat::validate_mem_flow() {
           }
         } else {
           assert(mem->is_Store() || mem->is_LoadStore(), err_msg_res("unexpected node type: %s", mem->Name()));
+          _stringopts->log_bailout("memory_from_store", _begin);
 #ifndef PRODUCT
           if (PrintOptimizeStringConcat) {
             tty->print("fusion has incorrect memory flow (unexpected source) for ");
@@ -861,6 +879,7 @@ bool StringConcat::validate_control_flow() {
   // Check to see if this resulted in too many uncommon traps previously
   if (Compile::current()->too_many_traps(_begin->jvms()->method(), _begin->jvms()->bci(),
                         Deoptimization::Reason_intrinsic)) {
+    _stringopts->log_bailout("too_many_traps", _begin);
     return false;
   }
 
@@ -1021,7 +1040,10 @@ bool StringConcat::validate_control_flow() {
     tty->cr();
   }
 #endif
-  if (fail) return !fail;
+  if (fail) {
+    _stringopts->log_bailout("control_flow", _begin);
+    return !fail;
+  }
 
   // Validate that all these results produced are contained within
   // this cluster of objects.  First collect all the results produced
@@ -1078,6 +1100,9 @@ bool StringConcat::validate_control_flow() {
       break;
     }
   }
+  if (fail) {
+    _stringopts->log_bailout("result_escapes", _begin);
+  }
 
 #ifndef PRODUCT
   if (PrintOptimizeStringConcat && !fail) {
@@ -1413,6 +1438,35 @@ Node* PhaseStringOpts::copy_string(GraphKit& kit, Node* str, Node* char_array, N
 }
 
 
+// Copy "true" or "false" without control flow: the first four chars are
+// selected with conditional moves and the trailing 'e', which ends both
+// words, is stored at the last position.
+Node* PhaseStringOpts::copy_boolean(GraphKit& kit, Node* value, Node* char_array, Node* start) {
+  static const char true_chars[]  = "true";
+  static const char false_chars[] = "false";
+  Node* is_false = __ Bool(__ CmpI(value, __ intcon(0)), BoolTest::eq);
+  for (int e = 0; e < 4; e++) {
+    Node* ch = kit.gvn().transform(new (C) CMoveINode(is_false, __ intcon(true_chars[e]), __ intcon(false_chars[e]), TypeInt::CHAR));
+    __ store_to_memory(kit.control(), kit.array_element_address(char_array, __ AddI(start, __ intcon(e)), T_CHAR),
+                       ch, T_CHAR, char_adr_idx, MemNode::unordered);
+  }
+  Node* end = __ AddI(start, kit.gvn().transform(new (C) CMoveINode(is_false, __ intcon(4), __ intcon(5), TypeInt::make(4, 5, Type::WidenMin))));
+  __ store_to_memory(kit.control(), kit.array_element_address(char_array, __ AddI(end, __ intcon(-1)), T_CHAR),
+                     __ intcon('e'), T_CHAR, char_adr_idx, MemNode::unordered);
+  return end;
+}
+
+void PhaseStringOpts::log_bailout(const char* reason, CallNode* call) {
+  CompileLog* log = C->log();
+  if (log != NULL) {
+    log->begin_elem("string_concat_bailout reason='%s'", reason);
+    if (call != NULL && call->jvms() != NULL) {
+      log->print(" bci='%d' method='%d'", call->jvms()->bci(), log->identify(call->jvms()->method()));
+    }
+    log->end_elem();
+  }
+}
+
 void PhaseStringOpts::replace_string_concat(StringConcat* sc) {
   // Log a little info about the transformation
   sc->maybe_log_transform();
@@ -1552,6 +1606,13 @@ void PhaseStringOpts::replace_string_concat(StringConcat* sc) {
         length = __ AddI(length, __ intcon(1));
         break;
       }
+      case StringConcat::BoolMode: {
+        // "true" or "false"
+        Node* is_false = __ Bool(__ CmpI(arg, __ intcon(0)), BoolTest::eq);
+        Node* bool_size = kit.gvn().transform(new (C) CMoveINode(is_false, __ intcon(4), __ intcon(5), TypeInt::make(4, 5, Type::WidenMin)));
+        length = __ AddI(length, bool_size);
+        break;
+      }
       default:
         ShouldNotReachHere();
     }
@@ -1619,6 +1680,10 @@ void PhaseStringOpts::replace_string_concat(StringConcat* sc) {
           start = __ AddI(start, __ intcon(1));
           break;
         }
+        case StringConcat::BoolMode: {
+          start = copy_boolean(kit, arg, char_array, start);
+          break;
+        }
         default:
           ShouldNotReachHere();
       }
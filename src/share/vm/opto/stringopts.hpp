@@ -70,6 +70,12 @@ class PhaseStringOpts : public Phase {
   // Copy of the contents of the String str into char_array starting at index start.
   Node* copy_string(GraphKit& kit, Node* str, Node* char_array, Node* start);
 
+  // Copy "true" or "false" into char_array starting at index start.
+  Node* copy_boolean(GraphKit& kit, Node* value, Node* char_array, Node* start);
+
+  // Record in the compile log why a candidate concatenation was not fused
+  void log_bailout(const char* reason, CallNode* call);
+
   // Clean up any leftover nodes
   void record_dead_node(Node* node);
   void remove_dead_nodes();
@@ -677,7 +677,7 @@ bool SuperWord::stmts_can_pack(Node* s1, Node* s2, int align) {
   }
 
   if (isomorphic(s1, s2)) {
-    if (independent(s1, s2)) {
+    if (independent(s1, s2) || reduction(s1, s2)) {
       if (!exists_at(s1, 0) && !exists_at(s2, 1)) {
         if (!s1->is_Mem() || are_adjacent_refs(s1, s2)) {
           int s1_align = alignment(s1);
@@ -776,6 +776,15 @@ bool SuperWord::independent_path(Node* shallow, Node* deep, uint dp) {
   return true;
 }
 
+//------------------------------reduction---------------------------
+// Is s1 the reduction which immediately precedes s2 in a chain?
+bool SuperWord::reduction(Node* s1, Node* s2) {
+  if (!s1->is_reduction() || !s2->is_reduction()) return false;
+  if (depth(s1) + 1 != depth(s2)) return false;
+  // This is an ordered set, so s1 should define s2
+  return s2->in(1) == s1 || s2->in(2) == s1;
+}
+
 //------------------------------set_alignment---------------------------
 void SuperWord::set_alignment(Node* s1, Node* s2, int align) {
   set_alignment(s1, align);
@@ -896,6 +905,19 @@ bool SuperWord::follow_def_uses(Node_List* p) {
 //---------------------------opnd_positions_match-------------------------
 // Is the use of d1 in u1 at the same operand position as d2 in u2?
 bool SuperWord::opnd_positions_match(Node* d1, Node* u1, Node* d2, Node* u2) {
+  // Reductions keep the loop carried value (the phi or the previous
+  // reduction in the chain) in the first operand, the vector in the second.
+  if (u1->is_reduction() && u2->is_reduction()) {
+    Node* first = u1->in(2);
+    if (first->is_Phi() || first->is_reduction()) {
+      u1->swap_edges(1, 2);
+    }
+    first = u2->in(2);
+    if (first->is_Phi() || first->is_reduction()) {
+      u2->swap_edges(1, 2);
+    }
+    return u1->in(2) == d1 && u2->in(2) == d2;
+  }
   uint ct = u1->req();
   if (ct != u2->req()) return false;
   uint i1 = 0;
@@ -1105,6 +1127,12 @@ void SuperWord::filter_packs() {
 // Can code be generated for pack p?
 bool SuperWord::implemented(Node_List* p) {
   Node* p0 = p->at(0);
+  if (p0->is_reduction()) {
+    BasicType bt = p0->bottom_type()->basic_type();
+    // Length 2 integer reductions cost more than the scalar code they replace
+    if ((bt == T_INT || bt == T_LONG) && p->size() == 2) return false;
+    return ReductionNode::implemented(p0->Opcode(), p->size(), bt);
+  }
   return VectorNode::implemented(p0->Opcode(), p->size(), velt_basic_type(p0));
 }
 
@@ -1139,6 +1167,29 @@ bool SuperWord::profitable(Node_List* p) {
     if (!is_vector_use(p0, i))
       return false;
   }
+  if (p0->is_reduction()) {
+    // The members must form one chain, entered from a scalar or from the
+    // end of the previous reduction pack, and the vector operand must be
+    // a pack of the same shape, otherwise there is no vector work to pay
+    // for the reduction.
+    Node_List* carried_pk = my_pack(p0->in(1));
+    if (carried_pk != NULL && carried_pk->at(carried_pk->size()-1) != p0->in(1)) {
+      return false;
+    }
+    for (uint i = 1; i < p->size(); i++) {
+      if (p->at(i)->in(1) != p->at(i-1)) return false;
+    }
+    Node_List* second_pk = my_pack(p0->in(2));
+    if (second_pk == NULL || second_pk->size() != p->size() ||
+        !same_velt_type(p0, second_pk->at(0))) {
+      return false;
+    }
+  }
+  if (VectorNode::is_conversion(p0) && my_pack(p0->in(1)) == NULL) {
+    // The input must be a pack: scalar promotion would replicate it
+    // with the result's element type.
+    return false;
+  }
   if (VectorNode::is_shift(p0)) {
     // For now, return false if shift count is vector or not scalar promotion
     // case (different shift counts) because it is not supported yet.
@@ -1160,6 +1211,13 @@ bool SuperWord::profitable(Node_List* p) {
         for (uint k = 0; k < use->req(); k++) {
           Node* n = use->in(k);
           if (def == n) {
+            // The last reduction of a chain feeds the loop phi and the
+            // code after the loop; it is replaced by the scalar result.
+            if (def->is_reduction() && i == p->size() - 1 &&
+                ((use->is_Phi() && use->in(0) == lp()) ||
+                 !lpt()->is_member(_phase->get_loop(_phase->ctrl_or_self(use))))) {
+              continue;
+            }
             if (!is_vector_use(use, k)) {
               return false;
             }
@@ -1442,6 +1500,13 @@ void SuperWord::output() {
         const TypePtr* atyp = n->adr_type();
         vn = StoreVectorNode::make(C, opc, ctl, mem, adr, atyp, val, vlen);
         vlen_in_bytes = vn->as_StoreVector()->memory_size();
+      } else if (n->is_reduction()) {
+        // The scalar input of the first reduction in the chain is retained
+        Node* in1 = low_adr->in(1);
+        Node* in2 = vector_opd(p, 2);
+        vn = ReductionNode::make(C, opc, NULL, in1, in2, n->bottom_type()->basic_type());
+        vlen_in_bytes = in2->is_LoadVector() ? in2->as_LoadVector()->memory_size()
+                                             : in2->as_Vector()->length_in_bytes();
       } else if (n->req() == 3) {
         // Promote operands to vector
         Node* in1 = vector_opd(p, 1);
@@ -1454,6 +1519,10 @@ void SuperWord::output() {
         }
         vn = VectorNode::make(C, opc, in1, in2, vlen, velt_basic_type(n));
         vlen_in_bytes = vn->as_Vector()->length_in_bytes();
+      } else if (VectorNode::is_conversion(n)) {
+        Node* in = vector_opd(p, 1);
+        vn = VectorNode::make(C, opc, in, NULL, vlen, velt_basic_type(n));
+        vlen_in_bytes = vn->as_Vector()->length_in_bytes();
       } else {
         ShouldNotReachHere();
       }
@@ -1567,6 +1636,8 @@ Node* SuperWord::vector_opd(Node_List* p, int opd_idx) {
 // use with an extract operation.
 void SuperWord::insert_extracts(Node_List* p) {
   if (p->at(0)->is_Store()) return;
+  // A reduction produces a scalar, profitable() checked its only uses.
+  if (p->at(0)->is_reduction()) return;
   assert(_n_idx_list.is_empty(), "empty (node,index) list");
 
   // Inspect each use of each pack member.  For each use that is
@@ -1613,6 +1684,8 @@ void SuperWord::insert_extracts(Node_List* p) {
 bool SuperWord::is_vector_use(Node* use, int u_idx) {
   Node_List* u_pk = my_pack(use);
   if (u_pk == NULL) return false;
+  // The loop carried operand of a reduction stays scalar
+  if (use->is_reduction() && u_idx == 1) return true;
   Node* def = use->in(u_idx);
   Node_List* d_pk = my_pack(def);
   if (d_pk == NULL) {
@@ -340,6 +340,8 @@ class SuperWord : public ResourceObj {
   bool independent(Node* s1, Node* s2);
   // Helper for independent
   bool independent_path(Node* shallow, Node* deep, uint dp=0);
+  // Is s1 the reduction which immediately precedes s2 in a chain?
+  bool reduction(Node* s1, Node* s2);
   void set_alignment(Node* s1, Node* s2, int align);
   int data_size(Node* s);
   // Extend packset by following use->def and def->use links from pack members.
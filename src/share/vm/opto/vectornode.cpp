@@ -138,6 +138,11 @@ int VectorNode::opcode(int sopc, BasicType bt) {
   case Op_XorI:
   case Op_XorL:
     return Op_XorV;
+  case Op_ConvI2F:
+    // Only conversions keeping the element size are supported: the
+    // input and result packs must have the same length and alignment.
+    assert(bt == T_FLOAT, "must be");
+    return Op_VectorCastI2F;
 
   case Op_LoadB:
   case Op_LoadUB:
@@ -185,6 +190,10 @@ bool VectorNode::is_shift(Node* n) {
   return false;
 }
 
+bool VectorNode::is_conversion(Node* n) {
+  return n->Opcode() == Op_ConvI2F;
+}
+
 // Check if input is loop invariant vector.
 bool VectorNode::is_invariant_vector(Node* n) {
   // Only Replicate vector nodes are loop invariant for now.
@@ -292,6 +301,8 @@ VectorNode* VectorNode::make(Compile* C, int opc, Node* n1, Node* n2, uint vlen,
   case Op_AndV: return new (C) AndVNode(n1, n2, vt);
   case Op_OrV:  return new (C) OrVNode (n1, n2, vt);
   case Op_XorV: return new (C) XorVNode(n1, n2, vt);
+
+  case Op_VectorCastI2F: return new (C) VectorCastI2FNode(n1, vt);
   }
   fatal(err_msg_res("Missed vector creation for '%s'", NodeClassNames[vopc]));
   return NULL;
@@ -442,3 +453,74 @@ Node* ExtractNode::make(Compile* C, Node* v, uint position, BasicType bt) {
   return NULL;
 }
 
+
+// Return the reduction operator for the specified scalar operation, or
+// the scalar operation itself if it can not be reduced.
+int ReductionNode::opcode(int opc, BasicType bt) {
+  int vopc = opc;
+  switch (opc) {
+  case Op_AddI:
+    if (bt == T_INT) vopc = Op_AddReductionVI;
+    break;
+  case Op_AddL:
+    if (bt == T_LONG) vopc = Op_AddReductionVL;
+    break;
+  case Op_AddF:
+    if (bt == T_FLOAT) vopc = Op_AddReductionVF;
+    break;
+  case Op_AddD:
+    if (bt == T_DOUBLE) vopc = Op_AddReductionVD;
+    break;
+  case Op_MulI:
+    if (bt == T_INT) vopc = Op_MulReductionVI;
+    break;
+  case Op_MulF:
+    if (bt == T_FLOAT) vopc = Op_MulReductionVF;
+    break;
+  case Op_MulD:
+    if (bt == T_DOUBLE) vopc = Op_MulReductionVD;
+    break;
+  case Op_AndI:
+    if (bt == T_INT) vopc = Op_AndReductionV;
+    break;
+  case Op_OrI:
+    if (bt == T_INT) vopc = Op_OrReductionV;
+    break;
+  case Op_XorI:
+    if (bt == T_INT) vopc = Op_XorReductionV;
+    break;
+  }
+  return vopc;
+}
+
+// Return the appropriate reduction node.
+ReductionNode* ReductionNode::make(Compile* C, int opc, Node* ctrl, Node* n1, Node* n2, BasicType bt) {
+  int vopc = opcode(opc, bt);
+
+  switch (vopc) {
+  case Op_AddReductionVI: return new (C) AddReductionVINode(ctrl, n1, n2);
+  case Op_AddReductionVL: return new (C) AddReductionVLNode(ctrl, n1, n2);
+  case Op_AddReductionVF: return new (C) AddReductionVFNode(ctrl, n1, n2);
+  case Op_AddReductionVD: return new (C) AddReductionVDNode(ctrl, n1, n2);
+  case Op_MulReductionVI: return new (C) MulReductionVINode(ctrl, n1, n2);
+  case Op_MulReductionVF: return new (C) MulReductionVFNode(ctrl, n1, n2);
+  case Op_MulReductionVD: return new (C) MulReductionVDNode(ctrl, n1, n2);
+  case Op_AndReductionV:  return new (C) AndReductionVNode(ctrl, n1, n2);
+  case Op_OrReductionV:   return new (C) OrReductionVNode(ctrl, n1, n2);
+  case Op_XorReductionV:  return new (C) XorReductionVNode(ctrl, n1, n2);
+  }
+  fatal(err_msg_res("Missed vector creation for '%s'", NodeClassNames[vopc]));
+  return NULL;
+}
+
+// Also used to check if the code generator
+// supports the reduction operation.
+bool ReductionNode::implemented(int opc, uint vlen, BasicType bt) {
+  if (is_java_primitive(bt) &&
+      (vlen > 1) && is_power_of_2(vlen) &&
+      Matcher::vector_size_supported(bt, vlen)) {
+    int vopc = ReductionNode::opcode(opc, bt);
+    return vopc != opc && Matcher::match_rule_supported(vopc);
+  }
+  return false;
+}
@@ -415,8 +415,17 @@ static bool find_initial_Java_frame(JavaThread* thread,
 
 }
 
+// The destination of a forte stack walk: the ASGCT_CallTrace of
+// AsyncGetCallTrace() or the Method* array of Forte::get_call_trace().
+class ForteCallTrace : public StackObj {
+ public:
+  jint num_frames;
+  // bci is -1 if not available and -3 for a native method
+  virtual void set_frame(int index, Method* method, int bci) = 0;
+};
+
 static void forte_fill_call_trace_given_top(JavaThread* thd,
-                                            ASGCT_CallTrace* trace,
+                                            ForteCallTrace* trace,
                                             int depth,
                                             frame top_frame) {
   NoHandleMark nhm;
@@ -428,7 +437,6 @@ static void forte_fill_call_trace_given_top(JavaThread* thd,
   int count;
 
   count = 0;
-  assert(trace->frames != NULL, "trace->frames must be non-NULL");
 
   // Walk the stack starting from 'top_frame' and search for an initial Java frame.
   find_initial_Java_frame(thd, &top_frame, &initial_Java_frame, &method, &bci);
@@ -454,18 +462,96 @@ static void forte_fill_call_trace_given_top(JavaThread* thd,
       return;
     }
 
-    trace->frames[count].method_id = method->find_jmethod_id_or_null();
-    if (!method->is_native()) {
-      trace->frames[count].lineno = bci;
-    } else {
-      trace->frames[count].lineno = -3;
-    }
+    trace->set_frame(count, method, method->is_native() ? -3 : bci);
   }
   trace->num_frames = count;
   return;
 }
 
 
+// Walks the stack of 'thread', which has been interrupted or suspended
+// with the register state in 'ucontext', into 'trace'.
+static void forte_get_call_trace(JavaThread* thread, ForteCallTrace* trace,
+                                 jint depth, void* ucontext) {
+  if (Universe::heap()->is_gc_active()) {
+    trace->num_frames = ticks_GC_active; // -2
+    return;
+  }
+
+  switch (thread->thread_state()) {
+  case _thread_new:
+  case _thread_uninitialized:
+  case _thread_new_trans:
+    // We found the thread on the threads list above, but it is too
+    // young to be useful so return that there are no Java frames.
+    trace->num_frames = 0;
+    break;
+  case _thread_in_native:
+  case _thread_in_native_trans:
+  case _thread_blocked:
+  case _thread_blocked_trans:
+  case _thread_in_vm:
+  case _thread_in_vm_trans:
+    {
+      frame fr;
+
+      // param isInJava == false - indicate we aren't in Java code
+      if (!thread->pd_get_top_frame_for_signal_handler(&fr, ucontext, false)) {
+        trace->num_frames = ticks_unknown_not_Java;  // -3 unknown frame
+      } else {
+        if (!thread->has_last_Java_frame()) {
+          trace->num_frames = 0; // No Java frames
+        } else {
+          trace->num_frames = ticks_not_walkable_not_Java;    // -4 non walkable frame by default
+          forte_fill_call_trace_given_top(thread, trace, depth, fr);
+
+          // This assert would seem to be valid but it is not.
+          // It would be valid if we weren't possibly racing a gc
+          // thread. A gc thread can make a valid interpreted frame
+          // look invalid. It's a small window but it does happen.
+          // The assert is left here commented out as a reminder.
+          // assert(trace->num_frames != ticks_not_walkable_not_Java, "should always be walkable");
+
+        }
+      }
+    }
+    break;
+  case _thread_in_Java:
+  case _thread_in_Java_trans:
+    {
+      frame fr;
+
+      // param isInJava == true - indicate we are in Java code
+      if (!thread->pd_get_top_frame_for_signal_handler(&fr, ucontext, true)) {
+        trace->num_frames = ticks_unknown_Java;  // -5 unknown frame
+      } else {
+        trace->num_frames = ticks_not_walkable_Java;  // -6, non walkable frame by default
+        forte_fill_call_trace_given_top(thread, trace, depth, fr);
+      }
+    }
+    break;
+  default:
+    // Unknown thread state
+    trace->num_frames = ticks_unknown_state; // -7
+    break;
+  }
+}
+
+
+class ASGCTCallTrace : public ForteCallTrace {
+ private:
+  ASGCT_CallTrace* _trace;
+ public:
+  ASGCTCallTrace(ASGCT_CallTrace* trace) : _trace(trace) {
+    assert(trace->frames != NULL, "trace->frames must be non-NULL");
+  }
+  void set_frame(int index, Method* method, int bci) {
+    _trace->frames[index].method_id = method->find_jmethod_id_or_null();
+    _trace->frames[index].lineno = bci;
+  }
+};
+
+
 // Forte Analyzer AsyncGetCallTrace() entry point. Currently supported
 // on Linux X86, Solaris SPARC and Solaris X86.
 //
@@ -548,71 +634,11 @@ void AsyncGetCallTrace(ASGCT_CallTrace *trace, jint depth, void* ucontext) {
     return;
   }
 
-  if (Universe::heap()->is_gc_active()) {
-    trace->num_frames = ticks_GC_active; // -2
-    return;
-  }
-
-  switch (thread->thread_state()) {
-  case _thread_new:
-  case _thread_uninitialized:
-  case _thread_new_trans:
-    // We found the thread on the threads list above, but it is too
-    // young to be useful so return that there are no Java frames.
-    trace->num_frames = 0;
-    break;
-  case _thread_in_native:
-  case _thread_in_native_trans:
-  case _thread_blocked:
-  case _thread_blocked_trans:
-  case _thread_in_vm:
-  case _thread_in_vm_trans:
-    {
-      frame fr;
-
-      // param isInJava == false - indicate we aren't in Java code
-      if (!thread->pd_get_top_frame_for_signal_handler(&fr, ucontext, false)) {
-        trace->num_frames = ticks_unknown_not_Java;  // -3 unknown frame
-      } else {
-        if (!thread->has_last_Java_frame()) {
-          trace->num_frames = 0; // No Java frames
-        } else {
-          trace->num_frames = ticks_not_walkable_not_Java;    // -4 non walkable frame by default
-          forte_fill_call_trace_given_top(thread, trace, depth, fr);
-
-          // This assert would seem to be valid but it is not.
-          // It would be valid if we weren't possibly racing a gc
-          // thread. A gc thread can make a valid interpreted frame
-          // look invalid. It's a small window but it does happen.
-          // The assert is left here commented out as a reminder.
-          // assert(trace->num_frames != ticks_not_walkable_not_Java, "should always be walkable");
-
-        }
-      }
-    }
-    break;
-  case _thread_in_Java:
-  case _thread_in_Java_trans:
-    {
-      frame fr;
-
-      // param isInJava == true - indicate we are in Java code
-      if (!thread->pd_get_top_frame_for_signal_handler(&fr, ucontext, true)) {
-        trace->num_frames = ticks_unknown_Java;  // -5 unknown frame
-      } else {
-        trace->num_frames = ticks_not_walkable_Java;  // -6, non walkable frame by default
-        forte_fill_call_trace_given_top(thread, trace, depth, fr);
-      }
-    }
-    break;
-  default:
-    // Unknown thread state
-    trace->num_frames = ticks_unknown_state; // -7
-    break;
-  }
+  ASGCTCallTrace asgct_trace(trace);
+  forte_get_call_trace(thread, &asgct_trace, depth, ucontext);
+  trace->num_frames = asgct_trace.num_frames;
 }
 
-
 #ifndef _WINDOWS
 // Support for the Forte(TM) Peformance Tools collector.
 //
@@ -653,6 +679,39 @@ void Forte::register_stub(const char* name, address start, address end) {
 #endif // !_WINDOWS && !IA64 && !PPC64
 }
 
+#if !defined(IA64) && !defined(PPC64)
+class MethodCallTrace : public ForteCallTrace {
+ private:
+  Method** _methods;
+  int*     _bcis;
+ public:
+  MethodCallTrace(Method** methods, int* bcis) : _methods(methods), _bcis(bcis) {}
+  void set_frame(int index, Method* method, int bci) {
+    _methods[index] = method;
+    if (_bcis != NULL) {
+      _bcis[index] = bci;
+    }
+  }
+};
+#endif // !IA64 && !PPC64
+
+int Forte::get_call_trace(JavaThread* thread, void* ucontext, int depth, Method** methods,
+                          int* bcis) {
+#if !defined(IA64) && !defined(PPC64)
+  if (thread->is_exiting()) {
+    return ticks_thread_exit;
+  }
+  if (thread->in_deopt_handler()) {
+    return ticks_deopt;
+  }
+  MethodCallTrace trace(methods, bcis);
+  forte_get_call_trace(thread, &trace, depth, ucontext);
+  return trace.num_frames;
+#else
+  return ticks_unknown_state;
+#endif // !IA64 && !PPC64
+}
+
 #else // INCLUDE_JVMTI
 extern "C" {
   JNIEXPORT
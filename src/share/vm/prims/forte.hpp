@@ -32,6 +32,17 @@ class Forte : AllStatic {
    static void register_stub(const char* name, address start, address end)
                                                  NOT_JVMTI_RETURN;
                                                  // register internal VM stub
+
+   // Walk the Java stack of 'thread', interrupted by a signal or suspended
+   // by an os::SuspendedThreadTask with the register state in 'ucontext',
+   // without taking locks. Up to 'depth' methods are stored callee first,
+   // and their bcis if 'bcis' is not NULL (-1 if not available, -3 for a
+   // native method). Returns the number of frames, or a value <= 0 if the
+   // stack could not be walked. The caller must keep the methods from
+   // being unloaded, for instance by holding the Threads_lock.
+   static int get_call_trace(JavaThread* thread, void* ucontext,
+                             int depth, Method** methods,
+                             int* bcis = NULL) NOT_JVMTI_RETURN_(0);
 };
 
 #endif // SHARE_VM_PRIMS_FORTE_HPP
@@ -60,6 +60,7 @@
 #include "prims/jvm_misc.hpp"
 #include "prims/jvmtiExport.hpp"
 #include "prims/jvmtiThreadState.hpp"
+#include "prims/nativeLookup.hpp"
 #include "runtime/compilationPolicy.hpp"
 #include "runtime/fieldDescriptor.hpp"
 #include "runtime/fprofiler.hpp"
@@ -4002,7 +4003,8 @@ static Method* find_prefixed_native(KlassHandle k,
   return NULL; // not found
 }
 
-static bool register_native(KlassHandle k, Symbol* name, Symbol* signature, address entry, TRAPS) {
+static bool register_native(KlassHandle k, Symbol* name, Symbol* signature, address entry,
+                            bool critical, TRAPS) {
   Method* method = k()->lookup_method(name, signature);
   if (method == NULL) {
     ResourceMark rm;
@@ -4023,7 +4025,19 @@ static bool register_native(KlassHandle k, Symbol* name, Symbol* signature, addr
     }
   }
 
-  if (entry != NULL) {
+  if (critical) {
+    // The critical entry is used by compiled callers only; the interpreter
+    // still needs the regular JNI entry registered separately.
+    methodHandle mh(THREAD, method);
+    if (!NativeLookup::can_be_critical_native(mh)) {
+      ResourceMark rm;
+      stringStream st;
+      st.print("Method %s cannot be a critical native",
+               Method::name_and_sig_as_C_string(k(), name, signature));
+      THROW_MSG_(vmSymbols::java_lang_NoSuchMethodError(), st.as_string(), false);
+    }
+    method->set_critical_native_function(entry);
+  } else if (entry != NULL) {
     method->set_native_function(entry,
       Method::native_bind_event_is_interesting);
   } else {
@@ -4031,7 +4045,8 @@ static bool register_native(KlassHandle k, Symbol* name, Symbol* signature, addr
   }
   if (PrintJNIResolving) {
     ResourceMark rm(THREAD);
-    tty->print_cr("[Registering JNI native method %s.%s]",
+    tty->print_cr("[Registering JNI %snative method %s.%s]",
+      critical ? "critical " : "",
       method->method_holder()->external_name(),
       method->name()->as_C_string());
   }
@@ -4065,6 +4080,14 @@ JNI_ENTRY(jint, jni_RegisterNatives(JNIEnv *env, jclass clazz,
     const char* meth_sig = methods[index].signature;
     int meth_name_len = (int)strlen(meth_name);
 
+    // A signature prefixed with '!' registers the JavaCritical_ style
+    // entry of the method instead of its JNI entry, like the critical
+    // entries found by name lookup.
+    bool critical = (meth_sig[0] == '!');
+    if (critical) {
+      meth_sig++;
+    }
+
     // The class should have been loaded (we have an instance of the class
     // passed in) so the method and signature should already be in the symbol
     // table.  If they're not there, the method doesn't exist.
@@ -4080,7 +4103,7 @@ JNI_ENTRY(jint, jni_RegisterNatives(JNIEnv *env, jclass clazz,
     }
 
     bool res = register_native(h_k, name, signature,
-                               (address) methods[index].fnPtr, THREAD);
+                               (address) methods[index].fnPtr, critical, THREAD);
     if (!res) {
       ret = -1;
       break;
@@ -4264,6 +4287,9 @@ JNI_ENTRY(void*, jni_GetPrimitiveArrayCritical(JNIEnv *env, jarray array, jboole
   }
   oop a = JNIHandles::resolve_non_null(array);
   assert(a->is_array(), "just checking");
+  if (Universe::heap()->supports_object_pinning()) {
+    Universe::heap()->pin_object(a);
+  }
   BasicType type;
   if (a->is_objArray()) {
     type = T_OBJECT;
@@ -4289,7 +4315,10 @@ JNI_ENTRY(void, jni_ReleasePrimitiveArrayCritical(JNIEnv *env, jarray array, voi
   HOTSPOT_JNI_RELEASEPRIMITIVEARRAYCRITICAL_ENTRY(
                                                   env, array, carray, mode);
 #endif /* USDT2 */
-  // The array, carray and mode arguments are ignored
+  // The carray and mode arguments are ignored
+  if (Universe::heap()->supports_object_pinning()) {
+    Universe::heap()->unpin_object(JNIHandles::resolve_non_null(array));
+  }
   GC_locker::unlock_critical(thread);
 #ifndef USDT2
   DTRACE_PROBE(hotspot_jni, ReleasePrimitiveArrayCritical__return);
@@ -4315,6 +4344,9 @@ JNI_ENTRY(const jchar*, jni_GetStringCritical(JNIEnv *env, jstring string, jbool
   oop s = JNIHandles::resolve_non_null(string);
   int s_len = java_lang_String::length(s);
   typeArrayOop s_value = java_lang_String::value(s);
+  if (Universe::heap()->supports_object_pinning()) {
+    Universe::heap()->pin_object(s_value);
+  }
   int s_offset = java_lang_String::offset(s);
   const jchar* ret;
   if (s_len > 0) {
@@ -4340,7 +4372,11 @@ JNI_ENTRY(void, jni_ReleaseStringCritical(JNIEnv *env, jstring str, const jchar
   HOTSPOT_JNI_RELEASESTRINGCRITICAL_ENTRY(
                                           env, str, (uint16_t *) chars);
 #endif /* USDT2 */
-  // The str and chars arguments are ignored
+  // The chars argument is ignored
+  if (Universe::heap()->supports_object_pinning()) {
+    oop s = JNIHandles::resolve_non_null(str);
+    Universe::heap()->unpin_object(java_lang_String::value(s));
+  }
   GC_locker::unlock_critical(thread);
 #ifndef USDT2
   DTRACE_PROBE(hotspot_jni, ReleaseStringCritical__return);
@@ -5101,6 +5137,7 @@ void TestNewSize_test();
 void TestKlass_test();
 void Test_linked_list();
 void TestChunkedList_test();
+void TestOpenHashtable_test();
 #if INCLUDE_ALL_GCS
 void TestOldFreeSpaceCalculation_test();
 void TestG1BiasedArray_test();
@@ -5133,6 +5170,7 @@ void execute_internal_vm_tests() {
     run_unit_test(TestKlass_test());
     run_unit_test(Test_linked_list());
     run_unit_test(TestChunkedList_test());
+    run_unit_test(TestOpenHashtable_test());
     run_unit_test(ObjectMonitor::sanity_checks());
 #if INCLUDE_VM_STRUCTS
     run_unit_test(VMStructs::test());
@@ -542,6 +542,93 @@ JVM_ENTRY(jobject, JVM_GetStackTraceElement(JNIEnv *env, jobject throwable, jint
 JVM_END
 
 
+// Partial stack walking ////////////////////////////////////////////////
+
+static int stack_frames_limit(objArrayHandle array, Klass* element_klass, int limit, TRAPS) {
+  if (array.is_null()) {
+    return limit;
+  }
+  Klass* k = ObjArrayKlass::cast(array->klass())->element_klass();
+  if (!element_klass->is_subtype_of(k)) {
+    THROW_MSG_0(vmSymbols::java_lang_ArrayStoreException(), "wrong array element type");
+  }
+  return MIN2(limit, array->length());
+}
+
+JVM_ENTRY(jint, JVM_GetStackFrames(JNIEnv *env, jint skip, jint flags,
+                                   jobjectArray classes, jobjectArray elements, jintArray bcis))
+  JVMWrapper("JVM_GetStackFrames");
+  JvmtiVMObjectAllocEventCollector oam;
+  if (skip < 0) {
+    THROW_MSG_0(vmSymbols::java_lang_IllegalArgumentException(), "negative skip");
+  }
+  if (classes == NULL && elements == NULL && bcis == NULL) {
+    THROW_0(vmSymbols::java_lang_NullPointerException());
+  }
+  objArrayHandle classes_h(THREAD, objArrayOop(JNIHandles::resolve(classes)));
+  objArrayHandle elements_h(THREAD, objArrayOop(JNIHandles::resolve(elements)));
+  typeArrayHandle bcis_h(THREAD, typeArrayOop(JNIHandles::resolve(bcis)));
+
+  int limit = max_jint;
+  limit = stack_frames_limit(classes_h, SystemDictionary::Class_klass(), limit, CHECK_0);
+  limit = stack_frames_limit(elements_h, SystemDictionary::StackTraceElement_klass(), limit, CHECK_0);
+  if (bcis_h.not_null()) {
+    if (bcis_h->klass() != Universe::intArrayKlassObj()) {
+      THROW_MSG_0(vmSymbols::java_lang_ArrayStoreException(), "wrong array element type");
+    }
+    limit = MIN2(limit, bcis_h->length());
+  }
+  if (limit == 0) {
+    return 0;
+  }
+
+  // Walk no further than the requested frames. Nothing is allocated during
+  // the walk, and the collected Method*s stay alive since their frames are
+  // still on this thread's stack when the StackTraceElements are created.
+  ResourceMark rm(THREAD);
+  GrowableArray<Method*> methods(MIN2(limit, 16));
+  GrowableArray<int> frame_bcis(MIN2(limit, 16));
+  bool skip_reflection = (flags & JVM_STACKWALK_SKIP_REFLECTION) != 0;
+  vframeStream vfst(thread);
+  // Frame 0 is the native method calling this function
+  if (!vfst.at_end()) {
+    vfst.next();
+  }
+  for (int n = 0; !vfst.at_end() && methods.length() < limit;
+       skip_reflection ? vfst.security_next() : vfst.next()) {
+    Method* m = vfst.method();
+    if (m->is_hidden() && !ShowHiddenFrames) {
+      continue;
+    }
+    if (skip_reflection && m->is_ignored_by_security_stack_walk()) {
+      continue;
+    }
+    if (n++ < skip) {
+      continue;
+    }
+    methods.append(m);
+    frame_bcis.append(vfst.bci());
+  }
+
+  int count = methods.length();
+  for (int i = 0; i < count; i++) {
+    Method* m = methods.at(i);
+    if (classes_h.not_null()) {
+      classes_h->obj_at_put(i, m->method_holder()->java_mirror());
+    }
+    if (bcis_h.not_null()) {
+      bcis_h->int_at_put(i, frame_bcis.at(i));
+    }
+    if (elements_h.not_null()) {
+      methodHandle mh(THREAD, m);
+      oop element = java_lang_StackTraceElement::create(mh, frame_bcis.at(i), CHECK_0);
+      elements_h->obj_at_put(i, element);
+    }
+  }
+  return count;
+JVM_END
+
+
 // java.lang.Object ///////////////////////////////////////////////
 
 
@@ -229,6 +229,22 @@ JVM_GetStackTraceDepth(JNIEnv *env, jobject throwable);
 JNIEXPORT jobject JNICALL
 JVM_GetStackTraceElement(JNIEnv *env, jobject throwable, jint index);
 
+/*
+ * Partial stack walk of the current thread
+ *
+ * Fills classes, elements and bcis, any of which may be NULL, with
+ * the holder class, the StackTraceElement and the bci of the frames
+ * starting skip frames above the caller of the native method calling
+ * this function (skip == 0 is that caller). Only as many frames are
+ * walked as fit the shortest non-NULL array. Returns the number of
+ * frames filled in.
+ */
+#define JVM_STACKWALK_SKIP_REFLECTION 0x1 /* skip reflection and method handle frames */
+
+JNIEXPORT jint JNICALL
+JVM_GetStackFrames(JNIEnv *env, jint skip, jint flags,
+                   jobjectArray classes, jobjectArray elements, jintArray bcis);
+
 /*
  * java.lang.Compiler
  */
@@ -31,6 +31,7 @@
 #include "prims/jvmtiExport.hpp"
 #include "prims/jvmtiImpl.hpp"
 #include "prims/jvmtiThreadState.inline.hpp"
+#include "runtime/deoptimization.hpp"
 #include "runtime/frame.hpp"
 #include "runtime/thread.hpp"
 #include "runtime/vframe.hpp"
@@ -87,6 +88,7 @@ static const jlong  VM_OBJECT_ALLOC_BIT = (((jlong)1) << (JVMTI_EVENT_VM_OBJECT_
 
 // bits for extension events
 static const jlong  CLASS_UNLOAD_BIT = (((jlong)1) << (EXT_EVENT_CLASS_UNLOAD - TOTAL_MIN_EVENT_TYPE_VAL));
+static const jlong  SAMPLED_OBJECT_ALLOC_BIT = (((jlong)1) << (EXT_EVENT_SAMPLED_OBJECT_ALLOC - TOTAL_MIN_EVENT_TYPE_VAL));
 
 
 static const jlong  MONITOR_BITS = MONITOR_CONTENDED_ENTER_BIT | MONITOR_CONTENDED_ENTERED_BIT |
@@ -199,11 +201,6 @@ public:
   bool allow_nested_vm_operations() const        { return true; }
   VMOp_Type type() const { return VMOp_EnterInterpOnlyMode; }
   void doit();
-
-  // to do: this same function is in jvmtiImpl - should be in one place
-  bool can_be_deoptimized(vframe* vf) {
-    return (vf->is_compiled_frame() && vf->fr().can_be_deoptimized());
-  }
 };
 
 VM_EnterInterpOnlyMode::VM_EnterInterpOnlyMode(JvmtiThreadState *state)
@@ -223,22 +220,19 @@ void VM_EnterInterpOnlyMode::doit() {
     // If running in fullspeed mode, single stepping is implemented
     // as follows: first, the interpreter does not dispatch to
     // compiled code for threads that have single stepping enabled;
-    // second, we deoptimize all methods on the thread's stack when
-    // interpreted-only mode is enabled the first time for a given
+    // second, we deoptimize all compiled frames on the thread's stack
+    // when interpreted-only mode is enabled the first time for a given
     // thread (nothing to do if no Java frames yet).
-    int num_marked = 0;
+    //
+    // Only the frames of this thread are deoptimized. The nmethods stay
+    // entrant, so other threads keep running compiled code and nothing
+    // has to be recompiled when the events are disabled again.
     ResourceMark resMark;
-    RegisterMap rm(thread, false);
-    for (vframe* vf = thread->last_java_vframe(&rm); vf; vf = vf->sender()) {
-      if (can_be_deoptimized(vf)) {
-        ((compiledVFrame*) vf)->code()->mark_for_deoptimization();
-        ++num_marked;
+    for (StackFrameStream fst(thread, UseBiasedLocking); !fst.is_done(); fst.next()) {
+      if (fst.current()->can_be_deoptimized()) {
+        Deoptimization::deoptimize(thread, *fst.current(), fst.register_map());
       }
     }
-    if (num_marked > 0) {
-      VM_Deoptimize op;
-      VMThread::execute(&op);
-    }
   }
 }
 
@@ -606,6 +600,7 @@ JvmtiEventControllerPrivate::recompute_enabled() {
     JvmtiExport::set_should_post_data_dump((any_env_thread_enabled & DATA_DUMP_BIT) != 0);
     JvmtiExport::set_should_post_class_prepare((any_env_thread_enabled & CLASS_PREPARE_BIT) != 0);
     JvmtiExport::set_should_post_class_unload((any_env_thread_enabled & CLASS_UNLOAD_BIT) != 0);
+    JvmtiExport::set_should_post_sampled_object_alloc((any_env_thread_enabled & SAMPLED_OBJECT_ALLOC_BIT) != 0);
     JvmtiExport::set_should_post_monitor_contended_enter((any_env_thread_enabled & MONITOR_CONTENDED_ENTER_BIT) != 0);
     JvmtiExport::set_should_post_monitor_contended_entered((any_env_thread_enabled & MONITOR_CONTENDED_ENTERED_BIT) != 0);
     JvmtiExport::set_should_post_monitor_wait((any_env_thread_enabled & MONITOR_WAIT_BIT) != 0);
@@ -732,6 +727,9 @@ JvmtiEventControllerPrivate::set_extension_event_callback(JvmtiEnvBase *env,
     case EXT_EVENT_CLASS_UNLOAD :
       ext_callbacks->ClassUnload = callback;
       break;
+    case EXT_EVENT_SAMPLED_OBJECT_ALLOC :
+      ext_callbacks->SampledObjectAlloc = callback;
+      break;
     default:
       ShouldNotReachHere();
   }
@@ -46,12 +46,14 @@ class JvmtiEnvBase;
 // Extension events start JVMTI_MIN_EVENT_TYPE_VAL-1 and work towards 0.
 typedef enum {
   EXT_EVENT_CLASS_UNLOAD = JVMTI_MIN_EVENT_TYPE_VAL-1,
-  EXT_MIN_EVENT_TYPE_VAL = EXT_EVENT_CLASS_UNLOAD,
+  EXT_EVENT_SAMPLED_OBJECT_ALLOC = JVMTI_MIN_EVENT_TYPE_VAL-2,
+  EXT_MIN_EVENT_TYPE_VAL = EXT_EVENT_SAMPLED_OBJECT_ALLOC,
   EXT_MAX_EVENT_TYPE_VAL = EXT_EVENT_CLASS_UNLOAD
 } jvmtiExtEvent;
 
 typedef struct {
   jvmtiExtensionEvent ClassUnload;
+  jvmtiExtensionEvent SampledObjectAlloc;
 } jvmtiExtEventCallbacks;
 
 
@@ -2151,6 +2151,32 @@ void JvmtiExport::post_vm_object_alloc(JavaThread *thread,  oop object) {
   }
 }
 
+void JvmtiExport::post_sampled_object_alloc(JavaThread *thread, oop object) {
+  EVT_TRIG_TRACE(EXT_EVENT_SAMPLED_OBJECT_ALLOC, ("JVMTI [%s] Trg sampled object alloc triggered",
+                      JvmtiTrace::safe_get_thread_name(thread)));
+  if (object == NULL) {
+    return;
+  }
+  HandleMark hm(thread);
+  Handle h(thread, object);
+  JvmtiEnvIterator it;
+  for (JvmtiEnv* env = it.first(); env != NULL; env = it.next(env)) {
+    if (env->is_enabled((jvmtiEvent)EXT_EVENT_SAMPLED_OBJECT_ALLOC)) {
+      EVT_TRACE(EXT_EVENT_SAMPLED_OBJECT_ALLOC, ("JVMTI [%s] Evt sampled object alloc sent %s",
+                                         JvmtiTrace::safe_get_thread_name(thread),
+                                         h()->klass()->external_name()));
+
+      JvmtiVMObjectAllocEventMark jem(thread, h());
+      JvmtiJavaThreadEventTransition jet(thread);
+      jvmtiExtensionEvent callback = env->ext_callbacks()->SampledObjectAlloc;
+      if (callback != NULL) {
+        (*callback)(env->jvmti_external(), jem.jni_env(), jem.jni_thread(),
+                    jem.jni_jobject(), jem.jni_class(), jem.size());
+      }
+    }
+  }
+}
+
 ////////////////////////////////////////////////////////////////////////////////////////////////
 
 void JvmtiExport::cleanup_thread(JavaThread* thread) {
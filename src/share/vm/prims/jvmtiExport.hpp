@@ -98,6 +98,7 @@ class JvmtiExport : public AllStatic {
   JVMTI_SUPPORT_FLAG(should_post_class_load)
   JVMTI_SUPPORT_FLAG(should_post_class_prepare)
   JVMTI_SUPPORT_FLAG(should_post_class_unload)
+  JVMTI_SUPPORT_FLAG(should_post_sampled_object_alloc)
   JVMTI_SUPPORT_FLAG(should_post_native_method_bind)
   JVMTI_SUPPORT_FLAG(should_post_compiled_method_load)
   JVMTI_SUPPORT_FLAG(should_post_compiled_method_unload)
@@ -349,6 +350,8 @@ class JvmtiExport : public AllStatic {
   static void record_vm_internal_object_allocation(oop object) NOT_JVMTI_RETURN;
   // Post objects collected by vm_object_alloc_event_collector.
   static void post_vm_object_alloc(JavaThread *thread, oop object) NOT_JVMTI_RETURN;
+  // Post an object picked by the allocation sampler (-XX:HeapSamplingInterval).
+  static void post_sampled_object_alloc(JavaThread *thread, oop object) NOT_JVMTI_RETURN;
   // Collects vm internal objects for later event posting.
   inline static void vm_object_alloc_event_collector(oop object) {
     if (should_post_vm_object_alloc()) {
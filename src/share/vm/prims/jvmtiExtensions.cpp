@@ -44,9 +44,11 @@ static jvmtiError JNICALL IsClassUnloadingEnabled(const jvmtiEnv* env, jboolean*
 
 // register extension functions and events. In this implementation we
 // have a single extension function (to prove the API) that tests if class
-// unloading is enabled or disabled. We also have a single extension event
+// unloading is enabled or disabled. We also have two extension events:
 // EXT_EVENT_CLASS_UNLOAD which is used to provide the JVMDI_EVENT_CLASS_UNLOAD
-// event. The function and the event are registered here.
+// event, and EXT_EVENT_SAMPLED_OBJECT_ALLOC which reports the objects picked
+// by the allocation sampler (-XX:HeapSamplingInterval). The function and the
+// events are registered here.
 //
 void JvmtiExtensions::register_extensions() {
   _ext_functions = new (ResourceObj::C_HEAP, mtInternal) GrowableArray<jvmtiExtensionFunctionInfo*>(1,true);
@@ -82,6 +84,22 @@ void JvmtiExtensions::register_extensions() {
     event_params
   };
   _ext_events->append(&ext_event);
+
+  static jvmtiParamInfo sampled_alloc_params[] = {
+    { (char*)"JNI Environment", JVMTI_KIND_IN, JVMTI_TYPE_JNIENV, JNI_FALSE },
+    { (char*)"Thread", JVMTI_KIND_IN, JVMTI_TYPE_JTHREAD, JNI_FALSE },
+    { (char*)"Object", JVMTI_KIND_IN, JVMTI_TYPE_JOBJECT, JNI_FALSE },
+    { (char*)"Class", JVMTI_KIND_IN, JVMTI_TYPE_JCLASS, JNI_FALSE },
+    { (char*)"Size", JVMTI_KIND_IN, JVMTI_TYPE_JLONG, JNI_FALSE }
+  };
+  static jvmtiExtensionEventInfo sampled_alloc_event = {
+    EXT_EVENT_SAMPLED_OBJECT_ALLOC,
+    (char*)"com.sun.hotspot.events.SampledObjectAlloc",
+    (char*)"SAMPLED_OBJECT_ALLOC event",
+    sizeof(sampled_alloc_params)/sizeof(sampled_alloc_params[0]),
+    sampled_alloc_params
+  };
+  _ext_events->append(&sampled_alloc_event);
 }
 
 
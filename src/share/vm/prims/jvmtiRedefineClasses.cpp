@@ -3747,7 +3747,7 @@ void VM_RedefineClasses::flush_dependent_code(instanceKlassHandle k_h, TRAPS) {
 
   // All dependencies have been recorded from startup or this is a second or
   // subsequent use of RedefineClasses
-  if (JvmtiExport::all_dependencies_are_recorded()) {
+  if (JvmtiExport::all_dependencies_are_recorded() || RecordEvolDependencies) {
     Universe::flush_evol_dependents_on(k_h);
   } else {
     CodeCache::mark_all_nmethods_for_deoptimization();
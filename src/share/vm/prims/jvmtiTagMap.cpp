@@ -128,6 +128,7 @@ class JvmtiTagHashmap : public CHeapObj<mtInternal> {
   float _load_factor;                   // load factor as a % of the size
   int _resize_threshold;                // computed threshold to trigger resizing.
   bool _resizing_enabled;               // indicates if hashmap can resize
+  bool _needs_rehash;                   // entries may be in stale buckets
 
   int _trace_threshold;                 // threshold for trace messages
 
@@ -151,6 +152,7 @@ class JvmtiTagHashmap : public CHeapObj<mtInternal> {
     _load_factor = load_factor;
     _resize_threshold = (int)(_load_factor * _size);
     _resizing_enabled = true;
+    _needs_rehash = false;
     size_t s = initial_size * sizeof(JvmtiTagHashmapEntry*);
     _table = (JvmtiTagHashmapEntry**)os::malloc(s, mtInternal);
     if (_table == NULL) {
@@ -232,8 +234,62 @@ class JvmtiTagHashmap : public CHeapObj<mtInternal> {
 
     // compute new resize threshold
     _resize_threshold = (int)(_load_factor * _size);
+    _needs_rehash = false;
   }
 
+  // move the entries of objects that were moved by the GC to the buckets
+  // for their new addresses.
+  void rehash() {
+    JvmtiTagHashmapEntry* delayed_add = NULL;
+    for (int pos = 0; pos < _size; ++pos) {
+      JvmtiTagHashmapEntry* entry = _table[pos];
+      JvmtiTagHashmapEntry* prev = NULL;
+      while (entry != NULL) {
+        JvmtiTagHashmapEntry* next = entry->next();
+        unsigned int new_pos = hash(entry->object());
+        if (new_pos != (unsigned int)pos) {
+          if (prev == NULL) {
+            _table[pos] = next;
+          } else {
+            prev->set_next(next);
+          }
+          if (new_pos < (unsigned int)pos) {
+            entry->set_next(_table[new_pos]);
+            _table[new_pos] = entry;
+          } else {
+            // Delay adding this entry to it's new position as we'd end up
+            // hitting it again during this iteration.
+            entry->set_next(delayed_add);
+            delayed_add = entry;
+          }
+        } else {
+          prev = entry;
+        }
+        entry = next;
+      }
+    }
+
+    // Re-add all the entries which were kept aside
+    while (delayed_add != NULL) {
+      JvmtiTagHashmapEntry* next = delayed_add->next();
+      unsigned int pos = hash(delayed_add->object());
+      delayed_add->set_next(_table[pos]);
+      _table[pos] = delayed_add;
+      delayed_add = next;
+    }
+    _needs_rehash = false;
+  }
+
+  // The GC only updates the entries in place (see JvmtiTagMap::do_weak_oops)
+  // and leaves the rehashing to the first lookup after it, which runs with
+  // the tag map lock held instead of in the pause.
+  void rehash_if_needed() {
+    if (_needs_rehash) {
+      rehash();
+    }
+  }
+  void set_needs_rehash()                   { _needs_rehash = true; }
+
 
   // internal remove function - remove an entry at a given position in the
   // table.
@@ -299,6 +355,7 @@ class JvmtiTagHashmap : public CHeapObj<mtInternal> {
 
   // find an entry in the hashmap, returns NULL if not found.
   inline JvmtiTagHashmapEntry* find(oop key) {
+    rehash_if_needed();
     unsigned int h = hash(key);
     JvmtiTagHashmapEntry* entry = _table[h];
     while (entry != NULL) {
@@ -314,6 +371,7 @@ class JvmtiTagHashmap : public CHeapObj<mtInternal> {
   // add a new entry to hashmap
   inline void add(oop key, JvmtiTagHashmapEntry* entry) {
     assert(key != NULL, "checking");
+    rehash_if_needed();
     assert(find(key) == NULL, "duplicate detected");
     unsigned int h = hash(key);
     JvmtiTagHashmapEntry* anchor = _table[h];
@@ -340,6 +398,7 @@ class JvmtiTagHashmap : public CHeapObj<mtInternal> {
 
   // remove an entry with the given key.
   inline JvmtiTagHashmapEntry* remove(oop key) {
+    rehash_if_needed();
     unsigned int h = hash(key);
     JvmtiTagHashmapEntry* entry = _table[h];
     JvmtiTagHashmapEntry* prev = NULL;
@@ -376,6 +435,8 @@ class JvmtiTagHashmapEntryClosure {
 
 // iterate over all entries in the hashmap
 void JvmtiTagHashmap::entry_iterate(JvmtiTagHashmapEntryClosure* closure) {
+  // do_entry may remove entries, which must not rehash the table under us
+  rehash_if_needed();
   for (int i=0; i<_size; i++) {
     JvmtiTagHashmapEntry* entry = _table[i];
     JvmtiTagHashmapEntry* prev = NULL;
@@ -3314,8 +3375,6 @@ void JvmtiTagMap::do_weak_oops(BoolObjectClosure* is_alive, OopClosure* f) {
   JvmtiTagHashmapEntry** table = hashmap->table();
   int size = hashmap->size();
 
-  JvmtiTagHashmapEntry* delayed_add = NULL;
-
   for (int pos = 0; pos < size; ++pos) {
     JvmtiTagHashmapEntry* entry = table[pos];
     JvmtiTagHashmapEntry* prev = NULL;
@@ -3344,44 +3403,21 @@ void JvmtiTagMap::do_weak_oops(BoolObjectClosure* is_alive, OopClosure* f) {
         ++freed;
       } else {
         f->do_oop(entry->object_addr());
-        oop new_oop = entry->object();
 
-        // if the object has moved then re-hash it and move its
-        // entry to its new location.
-        unsigned int new_pos = JvmtiTagHashmap::hash(new_oop, size);
-        if (new_pos != (unsigned int)pos) {
-          if (prev == NULL) {
-            table[pos] = next;
-          } else {
-            prev->set_next(next);
-          }
-          if (new_pos < (unsigned int)pos) {
-            entry->set_next(table[new_pos]);
-            table[new_pos] = entry;
-          } else {
-            // Delay adding this entry to it's new position as we'd end up
-            // hitting it again during this iteration.
-            entry->set_next(delayed_add);
-            delayed_add = entry;
-          }
+        // if the object has moved to another bucket leave the entry
+        // where it is; the table is rehashed on its next use.
+        if (JvmtiTagHashmap::hash(entry->object(), size) != (unsigned int)pos) {
           moved++;
-        } else {
-          // object didn't move
-          prev = entry;
         }
+        prev = entry;
       }
 
       entry = next;
     }
   }
 
-  // Re-add all the entries which were kept aside
-  while (delayed_add != NULL) {
-    JvmtiTagHashmapEntry* next = delayed_add->next();
-    unsigned int pos = JvmtiTagHashmap::hash(delayed_add->object(), size);
-    delayed_add->set_next(table[pos]);
-    table[pos] = delayed_add;
-    delayed_add = next;
+  if (moved > 0) {
+    hashmap->set_needs_rehash();
   }
 
   // stats
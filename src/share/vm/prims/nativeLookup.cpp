@@ -271,25 +271,32 @@ address NativeLookup::lookup_entry(methodHandle method, bool& in_base_library, T
 
 // Check all the formats of native implementation name to see if there is one
 // for the specified method.
-address NativeLookup::lookup_critical_entry(methodHandle method) {
-  if (!CriticalJNINatives) return NULL;
-
+bool NativeLookup::can_be_critical_native(methodHandle method) {
   if (method->is_synchronized() ||
       !method->is_static()) {
     // Only static non-synchronized methods are allowed
-    return NULL;
+    return false;
   }
 
-  ResourceMark rm;
-  address entry = NULL;
-
   Symbol* signature = method->signature();
   for (int end = 0; end < signature->utf8_length(); end++) {
     if (signature->byte_at(end) == 'L') {
       // Don't allow object types
-      return NULL;
+      return false;
     }
   }
+  return true;
+}
+
+address NativeLookup::lookup_critical_entry(methodHandle method) {
+  if (!CriticalJNINatives) return NULL;
+
+  if (!can_be_critical_native(method)) {
+    return NULL;
+  }
+
+  ResourceMark rm;
+  address entry = NULL;
 
   // Compute critical name
   char* critical_name = critical_jni_name(method);
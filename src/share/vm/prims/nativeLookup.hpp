@@ -48,6 +48,9 @@ class NativeLookup : AllStatic {
   // Lookup native function. May throw UnsatisfiedLinkError.
   static address lookup(methodHandle method, bool& in_base_library, TRAPS);
   static address lookup_critical_entry(methodHandle method);
+  // Critical natives must be static, non-synchronized and take only
+  // primitives and primitive arrays.
+  static bool can_be_critical_native(methodHandle method);
 
   // Lookup native functions in base library.
   static address base_library_lookup(const char* class_name, const char* method_name, const char* signature);
@@ -38,10 +38,12 @@
 #include "runtime/arguments.hpp"
 #include "runtime/interfaceSupport.hpp"
 #include "runtime/os.hpp"
+#include "runtime/synchronizer.hpp"
 #include "utilities/array.hpp"
 #include "utilities/debug.hpp"
 #include "utilities/macros.hpp"
 #include "utilities/exceptions.hpp"
+#include "utilities/taskqueue.hpp"
 
 #if INCLUDE_ALL_GCS
 #include "gc_implementation/parallelScavenge/parallelScavengeHeap.inline.hpp"
@@ -327,6 +329,12 @@ WB_ENTRY(jlong, WB_G1NumFreeRegions(JNIEnv* env, jobject o))
   return (jlong)nr;
 WB_END
 
+WB_ENTRY(jlong, WB_G1HumongousWasteBytes(JNIEnv* env, jobject o))
+  G1CollectedHeap* g1 = G1CollectedHeap::heap();
+  MutexLockerEx x(Heap_lock);
+  return (jlong)g1->humongous_waste_bytes();
+WB_END
+
 WB_ENTRY(jboolean, WB_G1InConcurrentMark(JNIEnv* env, jobject o))
   G1CollectedHeap* g1 = G1CollectedHeap::heap();
   return g1->concurrent_mark()->cmThread()->during_cycle();
@@ -933,6 +941,59 @@ WB_ENTRY(void, WB_ForceSafepoint(JNIEnv* env, jobject wb))
   VMThread::execute(&force_safepoint_op);
 WB_END
 
+// Microbenchmarks of VM-internal operations. Each one runs its operation
+// "iterations" times and returns the elapsed time in nanoseconds.
+
+// One iteration pushes a batch of tasks, pops half of them locally and
+// steals the other half, as the owner and a thief of a GC work queue do.
+WB_ENTRY(jlong, WB_BenchmarkTaskQueue(JNIEnv* env, jobject o, jint iterations))
+  const int batch = 64;
+  OopTaskQueue* queue = new OopTaskQueue();
+  queue->initialize();
+  jlong start = os::javaTimeNanos();
+  for (jint i = 0; i < iterations; i++) {
+    for (int j = 0; j < batch; j++) {
+      queue->push(oop(NULL));
+    }
+    oop t;
+    for (int j = 0; j < batch / 2; j++) {
+      queue->pop_local(t);
+    }
+    for (int j = 0; j < batch / 2; j++) {
+      queue->pop_global(t);
+    }
+  }
+  jlong elapsed = os::javaTimeNanos() - start;
+  assert(queue->is_empty(), "all tasks should have been taken");
+  delete queue;
+  return elapsed;
+WB_END
+
+WB_ENTRY(jlong, WB_BenchmarkSymbolLookup(JNIEnv* env, jobject o, jstring name, jint iterations))
+  ResourceMark rm(THREAD);
+  const char* str = java_lang_String::as_utf8_string(JNIHandles::resolve_non_null(name));
+  int len = (int)strlen(str);
+  jlong start = os::javaTimeNanos();
+  for (jint i = 0; i < iterations; i++) {
+    Symbol* sym = SymbolTable::probe(str, len);
+    if (sym != NULL) {
+      sym->decrement_refcount();
+    }
+  }
+  return os::javaTimeNanos() - start;
+WB_END
+
+// Enters and exits the monitor of obj through ObjectSynchronizer, the
+// path taken by the runtime, JNI MonitorEnter and interpreter slow paths.
+WB_ENTRY(jlong, WB_BenchmarkMonitorEnterExit(JNIEnv* env, jobject o, jobject obj, jint iterations))
+  Handle h_obj(THREAD, JNIHandles::resolve_non_null(obj));
+  jlong start = os::javaTimeNanos();
+  for (jint i = 0; i < iterations; i++) {
+    ObjectLocker ol(h_obj, THREAD);
+  }
+  return os::javaTimeNanos() - start;
+WB_END
+
 //Some convenience methods to deal with objects from java
 int WhiteBox::offset_for_field(const char* field_name, oop object,
     Symbol* signature_symbol) {
@@ -1038,6 +1099,12 @@ WB_ENTRY(void, WB_PrintOsInfo(JNIEnv* env, jobject o))
   os::print_os_info(tty);
 WB_END
 
+WB_ENTRY(jint, WB_GetStackFrames(JNIEnv* env, jobject o, jint skip, jint flags,
+                                 jobjectArray classes, jobjectArray elements, jintArray bcis))
+  ThreadToNativeFromVM ttnfv(thread);   // can't be in VM when we call JNI
+  return JVM_GetStackFrames(env, skip, flags, classes, elements, bcis);
+WB_END
+
 #define CC (char*)
 
 static JNINativeMethod methods[] = {
@@ -1074,6 +1141,7 @@ static JNINativeMethod methods[] = {
   {CC"g1NumMaxRegions",    CC"()J",                   (void*)&WB_G1NumMaxRegions  },
   {CC"g1NumFreeRegions",   CC"()J",                   (void*)&WB_G1NumFreeRegions  },
   {CC"g1RegionSize",       CC"()I",                   (void*)&WB_G1RegionSize      },
+  {CC"g1HumongousWasteBytes", CC"()J",                (void*)&WB_G1HumongousWasteBytes},
   {CC"g1StartConcMarkCycle",       CC"()Z",           (void*)&WB_G1StartMarkCycle  },
   {CC"g1AuxiliaryMemoryUsage", CC"()Ljava/lang/management/MemoryUsage;",
                                                       (void*)&WB_G1AuxiliaryMemoryUsage  },
@@ -1149,10 +1217,18 @@ static JNINativeMethod methods[] = {
                                                       (void*)&WB_GetNMethod         },
   {CC"isMonitorInflated",  CC"(Ljava/lang/Object;)Z", (void*)&WB_IsMonitorInflated  },
   {CC"forceSafepoint",     CC"()V",                   (void*)&WB_ForceSafepoint     },
+  {CC"benchmarkTaskQueue", CC"(I)J",                  (void*)&WB_BenchmarkTaskQueue },
+  {CC"benchmarkSymbolLookup", CC"(Ljava/lang/String;I)J",
+                                                      (void*)&WB_BenchmarkSymbolLookup},
+  {CC"benchmarkMonitorEnterExit", CC"(Ljava/lang/Object;I)J",
+                                                      (void*)&WB_BenchmarkMonitorEnterExit},
   {CC"checkLibSpecifiesNoexecstack", CC"(Ljava/lang/String;)Z",
                                                       (void*)&WB_CheckLibSpecifiesNoexecstack},
   {CC"isContainerized",           CC"()Z",            (void*)&WB_IsContainerized },
   {CC"printOsInfo",               CC"()V",            (void*)&WB_PrintOsInfo },
+  {CC"getStackFrames",
+      CC"(II[Ljava/lang/Class;[Ljava/lang/StackTraceElement;[I)I",
+                                                      (void*)&WB_GetStackFrames },
 };
 
 #undef CC
@@ -164,33 +164,87 @@ CompileTask* AdvancedThresholdPolicy::select_task(CompileQueue* compile_queue) {
   CompileTask *max_task = NULL;
   Method* max_method = NULL;
   jlong t = os::javaTimeMillis();
-  // Iterate through the queue and find a method with a maximum rate.
-  for (CompileTask* task = compile_queue->first(); task != NULL;) {
-    CompileTask* next_task = task->next();
-    Method* method = task->method();
-    update_rate(t, method);
-    if (max_task == NULL) {
-      max_task = task;
-      max_method = method;
-    } else {
-      // If a method has been stale for some time, remove it from the queue.
-      if (is_stale(t, TieredCompileTaskTimeout, method) && !is_old(method)) {
+  int batch_size = MIN2((int)TieredCompileQueueBatch, (int)CompileQueue::max_batch_size);
+
+  // If a recent scan of a long queue ranked several tasks, take the next one.
+  // The ranking expires after TieredRateUpdateMaxTime, like the rates it
+  // is based on.
+  if (batch_size > 1) {
+    while ((max_task = compile_queue->next_batched_task(t, TieredRateUpdateMaxTime)) != NULL) {
+      max_method = max_task->method();
+      update_rate(t, max_method);
+      if (compile_queue->size() > 1 &&
+          is_stale(t, TieredCompileTaskTimeout, max_method) && !is_old(max_method)) {
         if (PrintTieredEvents) {
-          print_event(REMOVE_FROM_QUEUE, method, method, task->osr_bci(), (CompLevel)task->comp_level());
+          print_event(REMOVE_FROM_QUEUE, max_method, max_method, max_task->osr_bci(), (CompLevel)max_task->comp_level());
         }
-        compile_queue->remove_and_mark_stale(task);
-        method->clear_queued_for_compilation();
-        task = next_task;
+        compile_queue->remove_and_mark_stale(max_task);
+        max_method->clear_queued_for_compilation();
+        max_task = NULL;
         continue;
       }
+      break;
+    }
+  }
+
+  if (max_task == NULL) {
+    // Rank the best tasks while scanning a long queue anyway.
+    CompileTask* batch[CompileQueue::max_batch_size];
+    int batch_length = 0;
+    if (compile_queue->size() <= batch_size) {
+      batch_size = 0;
+    }
 
-      // Select a method with a higher rate
-      if (compare_methods(method, max_method)) {
+    // Iterate through the queue and find a method with a maximum rate.
+    for (CompileTask* task = compile_queue->first(); task != NULL;) {
+      CompileTask* next_task = task->next();
+      Method* method = task->method();
+      update_rate(t, method);
+      if (max_task == NULL) {
         max_task = task;
         max_method = method;
+      } else {
+        // If a method has been stale for some time, remove it from the queue.
+        if (is_stale(t, TieredCompileTaskTimeout, method) && !is_old(method)) {
+          if (PrintTieredEvents) {
+            print_event(REMOVE_FROM_QUEUE, method, method, task->osr_bci(), (CompLevel)task->comp_level());
+          }
+          compile_queue->remove_and_mark_stale(task);
+          method->clear_queued_for_compilation();
+          task = next_task;
+          continue;
+        }
+
+        // Select a method with a higher rate
+        if (compare_methods(method, max_method)) {
+          max_task = task;
+          max_method = method;
+        }
+      }
+
+      if (batch_size > 1) {
+        // Insertion into the ranking; ties keep queue order.
+        int i = batch_length;
+        while (i > 0 && compare_methods(method, batch[i - 1]->method())) {
+          if (i < batch_size) {
+            batch[i] = batch[i - 1];
+          }
+          i--;
+        }
+        if (i < batch_size) {
+          batch[i] = task;
+          if (batch_length < batch_size) {
+            batch_length++;
+          }
+        }
       }
+      task = next_task;
+    }
+
+    if (batch_length > 1) {
+      assert(batch[0] == max_task, "ranking must agree with the scan");
+      compile_queue->set_batch(&batch[1], batch_length - 1, t);
     }
-    task = next_task;
   }
 
   if (max_task->comp_level() == CompLevel_full_profile && TieredStopAtLevel > CompLevel_full_profile
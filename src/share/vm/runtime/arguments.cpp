@@ -61,6 +61,7 @@
 #endif
 #if INCLUDE_ALL_GCS
 #include "gc_implementation/concurrentMarkSweep/compactibleFreeListSpace.hpp"
+#include "gc_implementation/epsilon/epsilonHeap.hpp"
 #include "gc_implementation/g1/g1CollectedHeap.inline.hpp"
 #include "gc_implementation/parallelScavenge/parallelScavengeHeap.hpp"
 #endif // INCLUDE_ALL_GCS
@@ -1143,6 +1144,10 @@ void Arguments::set_tiered_flags() {
   if (FLAG_IS_DEFAULT(ReservedCodeCacheSize)) {
     FLAG_SET_DEFAULT(ReservedCodeCacheSize, ReservedCodeCacheSize * 5);
   }
+  // Keep profiled and optimized code apart when the code cache is large enough.
+  if (FLAG_IS_DEFAULT(SegmentedCodeCache) && ReservedCodeCacheSize >= 240*M) {
+    FLAG_SET_ERGO(bool, SegmentedCodeCache, true);
+  }
   if (!UseInterpreter) { // -Xcomp
     Tier3InvokeNotifyFreqLog = 0;
     Tier4InvocationThreshold = 0;
@@ -1186,6 +1191,15 @@ static void disable_adaptive_size_policy(const char* collector_name) {
   }
 }
 
+// Adjust some sizes to suit the serial collector.
+void Arguments::set_serial_gc_flags() {
+  // The young collector scans the card table with a work gang of
+  // DefNewParallelScanThreads threads, unless a size was given for it.
+  if (DefNewParallelScanThreads > 1 && FLAG_IS_DEFAULT(ParallelGCThreads)) {
+    FLAG_SET_ERGO(uintx, ParallelGCThreads, DefNewParallelScanThreads);
+  }
+}
+
 void Arguments::set_parnew_gc_flags() {
   assert(!UseSerialGC && !UseParallelOldGC && !UseParallelGC && !UseG1GC,
          "control point invariant");
@@ -1254,6 +1268,14 @@ void Arguments::set_cms_and_parnew_gc_flags() {
     set_parnew_gc_flags();
   }
 
+  // With parallel remark the reference processing would be the only
+  // serial part of the remark pause, so unless explicitly requested
+  // otherwise process the references with the parallel GC threads too.
+  if (FLAG_IS_DEFAULT(ParallelRefProcEnabled) && CMSParallelRemarkEnabled &&
+      ParallelGCThreads > 1) {
+    FLAG_SET_ERGO(bool, ParallelRefProcEnabled, true);
+  }
+
   size_t max_heap = align_size_down(MaxHeapSize,
                                     CardTableRS::ct_max_alignment_constraint());
 
@@ -1436,6 +1458,17 @@ bool verify_object_alignment() {
                 (int)ObjectAlignmentInBytes, os::vm_page_size());
     return false;
   }
+  if (ObjectAlignmentErgonomics &&
+      (!is_power_of_2(MaxErgoObjectAlignmentInBytes) ||
+       MaxErgoObjectAlignmentInBytes < ObjectAlignmentInBytes ||
+       MaxErgoObjectAlignmentInBytes > 256 ||
+       (int)MaxErgoObjectAlignmentInBytes >= os::vm_page_size())) {
+    jio_fprintf(defaultStream::error_stream(),
+                "error: MaxErgoObjectAlignmentInBytes=%d must be a power of 2 between "
+                "ObjectAlignmentInBytes and 256, and less than page size %d\n",
+                (int)MaxErgoObjectAlignmentInBytes, os::vm_page_size());
+    return false;
+  }
   if(SurvivorAlignmentInBytes == 0) {
     SurvivorAlignmentInBytes = ObjectAlignmentInBytes;
   } else {
@@ -1483,6 +1516,43 @@ bool Arguments::should_auto_select_low_pause_collector() {
   return false;
 }
 
+// Double the object alignment until a heap of max_heap_size can be
+// addressed with compressed oops. Each doubling of the alignment doubles
+// the reach of a 32-bit narrow oop (32G at 8 bytes, 64G at 16, 128G at
+// 32), at the cost of more padding per object.
+void Arguments::select_object_alignment_for_compressed_oops(size_t max_heap_size) {
+#ifdef _LP64
+  if (!ObjectAlignmentErgonomics ||
+      !FLAG_IS_DEFAULT(ObjectAlignmentInBytes) ||
+      (!UseCompressedOops && !FLAG_IS_DEFAULT(UseCompressedOops))) {
+    return;
+  }
+  intx alignment = ObjectAlignmentInBytes;
+  while (alignment < MaxErgoObjectAlignmentInBytes &&
+         max_heap_size > max_heap_for_compressed_oops()) {
+    alignment *= 2;
+    ObjectAlignmentInBytes = alignment;
+    set_object_alignment();
+  }
+  if (max_heap_size > max_heap_for_compressed_oops()) {
+    // Not reachable within the allowed alignment; keep the default.
+    ObjectAlignmentInBytes = 8;
+    set_object_alignment();
+    return;
+  }
+  if (alignment != 8) {
+    FLAG_SET_ERGO(intx, ObjectAlignmentInBytes, alignment);
+    if (SurvivorAlignmentInBytes < ObjectAlignmentInBytes) {
+      SurvivorAlignmentInBytes = ObjectAlignmentInBytes;
+    }
+    if (PrintCompressedOopsMode) {
+      tty->print_cr("ObjectAlignmentInBytes set to " INTX_FORMAT " for a maximum heap of " SIZE_FORMAT "M",
+                    ObjectAlignmentInBytes, max_heap_size / M);
+    }
+  }
+#endif // _LP64
+}
+
 void Arguments::set_use_compressed_oops() {
 #ifndef ZERO
 #ifdef _LP64
@@ -1491,6 +1561,10 @@ void Arguments::set_use_compressed_oops() {
   // to use UseCompressedOops is InitialHeapSize.
   size_t max_heap_size = MAX2(MaxHeapSize, InitialHeapSize);
 
+  if (max_heap_size > max_heap_for_compressed_oops()) {
+    select_object_alignment_for_compressed_oops(max_heap_size);
+  }
+
   if (max_heap_size <= max_heap_for_compressed_oops()) {
 #if !defined(COMPILER1) || defined(TIERED)
     if (FLAG_IS_DEFAULT(UseCompressedOops)) {
@@ -1557,6 +1631,8 @@ void Arguments::set_conservative_max_heap_alignment() {
     heap_alignment = ParallelScavengeHeap::conservative_max_heap_alignment();
   } else if (UseG1GC) {
     heap_alignment = G1CollectedHeap::conservative_max_heap_alignment();
+  } else if (UseEpsilonGC) {
+    heap_alignment = EpsilonHeap::conservative_max_heap_alignment();
   }
 #endif // INCLUDE_ALL_GCS
   _conservative_max_heap_alignment = MAX4(heap_alignment,
@@ -1681,6 +1757,12 @@ void Arguments::set_g1_gc_flags() {
   if (G1ConcRefinementThreads == 0) {
     FLAG_SET_DEFAULT(G1ConcRefinementThreads, ParallelGCThreads);
   }
+
+  if (G1PinRegionsForJNICritical) {
+    // Critical natives are only protected by the GC_locker, which no
+    // longer holds off evacuation pauses when regions are pinned.
+    FLAG_SET_DEFAULT(CriticalJNINatives, false);
+  }
 #endif
 
   // MarkStackSize will be set (if it hasn't been set by the user)
@@ -1729,6 +1811,39 @@ void Arguments::set_gc_specific_flags() {
     set_parnew_gc_flags();
   } else if (UseG1GC) {
     set_g1_gc_flags();
+  } else if (UseEpsilonGC) {
+    // Epsilon has neither generations nor collector threads to size.
+  } else {
+    set_serial_gc_flags();
+  }
+  // Reference processing phases with few references are spread over
+  // fewer queues (see ReferencesPerThread) and empty ones are skipped,
+  // so processing in parallel costs little when there is little to do.
+  if (FLAG_IS_DEFAULT(ParallelRefProcEnabled) && ParallelGCThreads > 1 &&
+      (UseParallelGC || UseParNewGC || UseG1GC)) {
+    FLAG_SET_ERGO(bool, ParallelRefProcEnabled, true);
+  }
+  // Eden is pre-zeroed only for the contiguous eden of the Serial and
+  // ParNew young collectors, whose TLABs then follow ZeroTLAB semantics.
+  if (ZeroEdenConcurrently) {
+    if (UseParallelGC || UseG1GC || UseEpsilonGC || CMSIncrementalMode || !UseTLAB ||
+        (!FLAG_IS_DEFAULT(ZeroTLAB) && !ZeroTLAB)) {
+      warning("ZeroEdenConcurrently requires the Serial or ParNew young "
+              "collector, UseTLAB and ZeroTLAB; disabling it");
+      FLAG_SET_DEFAULT(ZeroEdenConcurrently, false);
+    } else if (FLAG_IS_DEFAULT(ZeroTLAB)) {
+      FLAG_SET_ERGO(bool, ZeroTLAB, true);
+    }
+  }
+  // Sampling points are set by lowering the end of the TLAB.
+  if (HeapSamplingInterval > 0) {
+    if (!UseTLAB) {
+      warning("HeapSamplingInterval requires UseTLAB; disabling heap sampling");
+      FLAG_SET_DEFAULT(HeapSamplingInterval, 0);
+    } else {
+      // The C1 refill stubs would retire a TLAB at its lowered end.
+      FLAG_SET_DEFAULT(FastTLABRefill, false);
+    }
   }
   check_deprecated_gcs();
   check_deprecated_gc_flags();
@@ -1752,6 +1867,10 @@ void Arguments::set_gc_specific_flags() {
   }
 #else // INCLUDE_ALL_GCS
   assert(verify_serial_gc_flags(), "SerialGC unset");
+  if (ZeroEdenConcurrently) {
+    warning("ZeroEdenConcurrently is not supported in this VM; disabling it");
+    FLAG_SET_DEFAULT(ZeroEdenConcurrently, false);
+  }
 #endif // INCLUDE_ALL_GCS
 }
 
@@ -2002,6 +2121,10 @@ void Arguments::set_bytecode_flags() {
 // Aggressive optimization flags  -XX:+AggressiveOpts
 void Arguments::set_aggressive_opts_flags() {
 #ifdef COMPILER2
+  if (AggressiveOpts && FLAG_IS_DEFAULT(AggressiveUnboxing)) {
+    // Split unboxing loads through merges of Long/Double/... boxes.
+    FLAG_SET_DEFAULT(AggressiveUnboxing, true);
+  }
   if (AggressiveUnboxing) {
     if (FLAG_IS_DEFAULT(EliminateAutoBox)) {
       FLAG_SET_DEFAULT(EliminateAutoBox, true);
@@ -2129,6 +2252,12 @@ void check_gclog_consistency() {
     jio_fprintf(defaultStream::output_stream(),
                 "GCLogFileSize changed to minimum 8K\n");
   }
+
+  if (AsyncGCLogging && AsyncGCLogBufferSize < 8*K) {
+    FLAG_SET_CMDLINE(uintx, AsyncGCLogBufferSize, 8*K);
+    jio_fprintf(defaultStream::output_stream(),
+                "AsyncGCLogBufferSize changed to minimum 8K\n");
+  }
 }
 
 // This function is called for -Xloggc:<filename>, it can be used
@@ -2208,6 +2337,16 @@ bool Arguments::verify_MaxHeapFreeRatio(FormatBuffer<80>& err_msg, uintx max_hea
   return true;
 }
 
+bool Arguments::verify_SoftMaxHeapSize(FormatBuffer<80>& err_msg, uintx soft_max_heap_size) {
+  if (soft_max_heap_size > MaxHeapSize) {
+    err_msg.print("SoftMaxHeapSize (" UINTX_FORMAT ") must be less than or "
+                  "equal to MaxHeapSize (" UINTX_FORMAT ")", soft_max_heap_size,
+                  MaxHeapSize);
+    return false;
+  }
+  return true;
+}
+
 // Check consistency of GC selection
 bool Arguments::check_gc_consistency() {
   check_gclog_consistency();
@@ -2224,6 +2363,7 @@ bool Arguments::check_gc_consistency() {
   if (UseConcMarkSweepGC || UseParNewGC) i++;
   if (UseParallelGC || UseParallelOldGC) i++;
   if (UseG1GC)                           i++;
+  if (UseEpsilonGC)                      i++;
   if (i > 1) {
     jio_fprintf(defaultStream::error_stream(),
                 "Conflicting collector combinations in option list; "
@@ -2313,6 +2453,9 @@ bool Arguments::check_vm_args_consistency() {
   status = status && verify_interval(AdaptiveSizePolicyWeight, 0, 100,
                               "AdaptiveSizePolicyWeight");
   status = status && verify_percentage(ThresholdTolerance, "ThresholdTolerance");
+  status = status && verify_percentage(PretenureSurvivalPercent, "PretenureSurvivalPercent");
+  status = status && verify_interval(PretenureSampleWords, 1, max_jint,
+                                     "PretenureSampleWords");
 
   // Divide by bucket size to prevent a large size from causing rollover when
   // calculating amount of memory needed to be allocated for the String table.
@@ -2437,6 +2580,8 @@ bool Arguments::check_vm_args_consistency() {
   }
 
   status = status && verify_min_value(ParGCArrayScanChunk, 1, "ParGCArrayScanChunk");
+  status = status && verify_min_value(OopMapCacheSize, 1, "OopMapCacheSize");
+  status = status && verify_min_value(MonitorDeflationInterval, 0, "MonitorDeflationInterval");
 
 #if INCLUDE_ALL_GCS
   if (UseG1GC) {
@@ -2487,6 +2632,7 @@ bool Arguments::check_vm_args_consistency() {
     status = status && verify_min_value(CMSBitMapYieldQuantum, 1, "CMSBitMapYieldQuantum");
     status = status && verify_percentage(CMSTriggerRatio, "CMSTriggerRatio");
     status = status && verify_percentage(CMSIsTooFullPercentage, "CMSIsTooFullPercentage");
+    status = status && verify_percentage(CMSFragmentationThreshold, "CMSFragmentationThreshold");
   }
 
   if (UseParallelGC || UseParallelOldGC) {
@@ -2561,6 +2707,9 @@ bool Arguments::check_vm_args_consistency() {
 #ifdef COMPILER1
   status = status && verify_min_value(ValueMapInitialSize, 1, "ValueMapInitialSize");
 #endif
+#ifdef COMPILER2
+  status = status && verify_percentage(ColdCallSiteInlineBudget, "ColdCallSiteInlineBudget");
+#endif
 
   if (PrintNMTStatistics) {
 #if INCLUDE_NMT
@@ -3822,6 +3971,7 @@ static void force_serial_gc() {
   UNSUPPORTED_GC_OPTION(UseParallelOldGC);
   UNSUPPORTED_GC_OPTION(UseConcMarkSweepGC);
   UNSUPPORTED_GC_OPTION(UseParNewGC);
+  UNSUPPORTED_GC_OPTION(UseEpsilonGC);
 }
 #endif // INCLUDE_ALL_GCS
 
@@ -4112,6 +4262,10 @@ jint Arguments::apply_ergo() {
       vm_exit_during_initialization(
         "Incompatible compilation policy selected", NULL);
     }
+    if (SegmentedCodeCache) {
+      warning("SegmentedCodeCache requires TieredCompilation and is disabled");
+      FLAG_SET_DEFAULT(SegmentedCodeCache, false);
+    }
   }
   // Set NmethodSweepFraction after the size of the code cache is adapted (in case of tiered)
   if (FLAG_IS_DEFAULT(NmethodSweepFraction)) {
@@ -4133,6 +4287,12 @@ jint Arguments::apply_ergo() {
   // Set flags if Aggressive optimization flags (-XX:+AggressiveOpts) enabled.
   set_aggressive_opts_flags();
 
+  // Make room for the histogram buckets, so they don't push the
+  // counters created after them out of the PerfData memory.
+  if (PerfDataHistograms && FLAG_IS_DEFAULT(PerfDataMemorySize)) {
+    FLAG_SET_DEFAULT(PerfDataMemorySize, PerfDataMemorySize + 16*K);
+  }
+
   // Turn off biased locking for locking debug mode flags,
   // which are subtlely different from each other but neither works with
   // biased locking.
@@ -4178,6 +4338,13 @@ jint Arguments::apply_ergo() {
     // nothing to use the profiling, turn if off
     FLAG_SET_DEFAULT(TypeProfileLevel, 0);
   }
+  if (UseCountedLoopSafepoints && FLAG_IS_DEFAULT(LoopStripMiningIter)) {
+    // keep the safepoint out of the inner loop
+    FLAG_SET_DEFAULT(LoopStripMiningIter, 1000);
+  } else if (LoopStripMiningIter > 1 && FLAG_IS_DEFAULT(UseCountedLoopSafepoints)) {
+    // strip mining only makes sense if counted loops keep a safepoint
+    FLAG_SET_DEFAULT(UseCountedLoopSafepoints, true);
+  }
 #endif
 
   if (PrintAssembly && FLAG_IS_DEFAULT(DebugNonSafepoints)) {
@@ -4240,6 +4407,13 @@ jint Arguments::apply_ergo() {
 }
 
 jint Arguments::adjust_after_os() {
+  if (AllocateHeapAt != NULL && UseNUMA) {
+    // NUMA placement and freeing of heap pages assume anonymous memory.
+    if (!FLAG_IS_DEFAULT(UseNUMA)) {
+      warning("UseNUMA is not supported with AllocateHeapAt and is disabled");
+    }
+    FLAG_SET_DEFAULT(UseNUMA, false);
+  }
   if (UseNUMA) {
     if (UseParallelGC || UseParallelOldGC) {
       if (FLAG_IS_DEFAULT(MinHeapDeltaBytes)) {
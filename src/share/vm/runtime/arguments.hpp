@@ -335,9 +335,12 @@ class Arguments : AllStatic {
   static void set_parallel_gc_flags();
   // Garbage-First (UseG1GC)
   static void set_g1_gc_flags();
+  // DefNew with the serial old collector
+  static void set_serial_gc_flags();
   // GC ergonomics
   static void set_conservative_max_heap_alignment();
   static void set_use_compressed_oops();
+  static void select_object_alignment_for_compressed_oops(size_t max_heap_size);
   static void set_use_compressed_klass_ptrs();
   static void select_gc();
   static void set_ergonomics_flags();
@@ -466,6 +469,7 @@ class Arguments : AllStatic {
   // Verifies that the given value will fit as a MaxHeapFreeRatio. If not, an error
   // message is returned in the provided buffer.
   static bool verify_MaxHeapFreeRatio(FormatBuffer<80>& err_msg, uintx max_heap_free_ratio);
+  static bool verify_SoftMaxHeapSize(FormatBuffer<80>& err_msg, uintx soft_max_heap_size);
 
   // Check for consistency in the selection of the garbage collector.
   static bool check_gc_consistency();        // Check user-selected gc
@@ -613,7 +617,7 @@ class Arguments : AllStatic {
 
 bool Arguments::gc_selected() {
   return UseConcMarkSweepGC || UseG1GC || UseParallelGC || UseParallelOldGC ||
-    UseParNewGC || UseSerialGC;
+    UseParNewGC || UseSerialGC || UseEpsilonGC;
 }
 
 #endif // SHARE_VM_RUNTIME_ARGUMENTS_HPP
@@ -0,0 +1,241 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "runtime/asyncLogWriter.hpp"
+#include "runtime/atomic.inline.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/orderAccess.inline.hpp"
+#include "runtime/os.hpp"
+#include "runtime/threadLocalStorage.hpp"
+#include "utilities/ostream.hpp"
+
+AsyncLogWriter* AsyncLogWriter::_instance = NULL;
+
+AsyncLogWriter::AsyncLogWriter(gcLogFileStream* stream) :
+  NamedThread(),
+  _stream(stream),
+  _reserved(0),
+  _committed(0),
+  _released(0),
+  _drainer(NULL),
+  _dropped(0),
+  _wakeup_pending(0),
+  _active(false),
+  _should_terminate(false),
+  _has_terminated(false) {
+  set_name("GC Log Writer");
+  size_t capacity = 1;
+  while (capacity < AsyncGCLogBufferSize) {
+    capacity <<= 1;
+  }
+  _capacity = capacity;
+  _mask = capacity - 1;
+  _buffer = NEW_C_HEAP_ARRAY(char, capacity, mtInternal);
+}
+
+void AsyncLogWriter::create(gcLogFileStream* stream) {
+  assert(_instance == NULL, "only one writer");
+  AsyncLogWriter* writer = new AsyncLogWriter(stream);
+  if (!os::create_thread(writer, os::pgc_thread)) {
+    warning("Cannot create the GC log writer thread; GC logging is synchronous");
+    return;
+  }
+  _instance = writer;
+  writer->_active = true;
+  OrderAccess::fence();
+  stream->set_async_writer(writer);
+  os::start_thread(writer);
+}
+
+void AsyncLogWriter::run() {
+  this->record_stack_base_and_size();
+  this->initialize_thread_local_storage();
+  this->set_native_thread_name(this->name());
+  this->set_active_handles(JNIHandleBlock::allocate_block());
+
+  while (!_should_terminate) {
+    _ParkEvent->park(flush_interval_ms);
+    _wakeup_pending = 0;
+    OrderAccess::fence();
+    drain(this);
+  }
+
+  // Signal that it is terminated
+  {
+    MutexLockerEx mu(Terminator_lock, Mutex::_no_safepoint_check_flag);
+    _has_terminated = true;
+    Terminator_lock->notify();
+  }
+
+  // Thread destructor usually does this..
+  ThreadLocalStorage::set_thread(NULL);
+}
+
+void AsyncLogWriter::stop() {
+  AsyncLogWriter* writer = _instance;
+  if (writer == NULL) {
+    return;
+  }
+  // New output goes straight to the file from here on.
+  writer->_active = false;
+  writer->_should_terminate = true;
+  OrderAccess::fence();
+  writer->_ParkEvent->unpark();
+
+  {
+    MutexLocker mu(Terminator_lock);
+    while (!writer->_has_terminated) {
+      Terminator_lock->wait();
+    }
+  }
+
+  // Write out whatever the writer had not seen yet.
+  Thread* thread = Thread::current();
+  while (!writer->drain(thread)) {
+    os::naked_short_sleep(1);
+  }
+}
+
+bool AsyncLogWriter::claim(Thread* thread) {
+  if (thread == NULL) {
+    return false;
+  }
+  return Atomic::cmpxchg_ptr(thread, &_drainer, NULL) == NULL;
+}
+
+void AsyncLogWriter::release_claim() {
+  OrderAccess::release_store_ptr(&_drainer, NULL);
+}
+
+void AsyncLogWriter::wakeup() {
+  if (_wakeup_pending == 0 && Atomic::cmpxchg(1, &_wakeup_pending, 0) == 0) {
+    _ParkEvent->unpark();
+  }
+}
+
+void AsyncLogWriter::enqueue(Thread* thread, const char* s, size_t len) {
+  if (len == 0) {
+    return;
+  }
+  if (len > _capacity) {
+    Atomic::inc(&_dropped);
+    return;
+  }
+
+  size_t start;
+  for (;;) {
+    start = (size_t)_reserved;
+    size_t used = start - (size_t)OrderAccess::load_ptr_acquire(&_released);
+    if (used + len <= _capacity) {
+      if (Atomic::cmpxchg_ptr((intptr_t)(start + len), &_reserved, (intptr_t)start) == (intptr_t)start) {
+        break;
+      }
+      continue;
+    }
+    if (!AsyncGCLogBlockOnOverflow) {
+      Atomic::inc(&_dropped);
+      wakeup();
+      return;
+    }
+    // Make room ourselves rather than wait for the writer to be scheduled.
+    if (!drain(thread)) {
+      wakeup();
+      os::naked_short_sleep(1);
+    }
+  }
+
+  size_t index = start & _mask;
+  size_t first = MIN2(len, _capacity - index);
+  memcpy(_buffer + index, s, first);
+  if (first < len) {
+    memcpy(_buffer, s + first, len - first);
+  }
+
+  // Publish in reservation order. Earlier producers are at most a memcpy
+  // away from publishing their own bytes.
+  while ((size_t)OrderAccess::load_ptr_acquire(&_committed) != start) {
+    SpinPause();
+  }
+  OrderAccess::release_store_ptr(&_committed, (intptr_t)(start + len));
+
+  if (start + len - (size_t)_released >= _capacity / 2) {
+    wakeup();
+  }
+}
+
+bool AsyncLogWriter::drain(Thread* thread) {
+  if (!claim(thread)) {
+    return false;
+  }
+  write_pending();
+  release_claim();
+  return true;
+}
+
+void AsyncLogWriter::rotate(Thread* thread, outputStream* out) {
+  while (!claim(thread)) {
+    os::naked_short_sleep(1);
+  }
+  write_pending();
+  _stream->rotate_log(true, out);
+  release_claim();
+}
+
+void AsyncLogWriter::write_pending() {
+  assert(is_drainer(ThreadLocalStorage::thread()), "must hold the drainer claim");
+  size_t released = (size_t)_released;
+  size_t committed = (size_t)OrderAccess::load_ptr_acquire(&_committed);
+  if (released == committed && _dropped == 0) {
+    return;
+  }
+  while (released != committed) {
+    size_t index = released & _mask;
+    size_t chunk = MIN2(committed - released, _capacity - index);
+    _stream->write_to_file(_buffer + index, chunk);
+    released += chunk;
+    OrderAccess::release_store_ptr(&_released, (intptr_t)released);
+  }
+
+  jint dropped = _dropped;
+  if (dropped > 0) {
+    Atomic::add(-dropped, &_dropped);
+    char msg[80];
+    jio_snprintf(msg, sizeof(msg),
+                 "\n[%d GC log messages dropped: AsyncGCLogBufferSize is too small]\n",
+                 dropped);
+    _stream->write_to_file(msg, strlen(msg));
+  }
+  _stream->flush_file();
+
+  if (UseGCLogFileRotation) {
+    _stream->rotate_log(false);
+  }
+}
+
+void AsyncLogWriter::print_on(outputStream* st) const {
+  st->print("\"%s\" ", name());
+  Thread::print_on(st);
+  st->cr();
+}
@@ -0,0 +1,107 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_RUNTIME_ASYNCLOGWRITER_HPP
+#define SHARE_VM_RUNTIME_ASYNCLOGWRITER_HPP
+
+#include "runtime/thread.hpp"
+
+class gcLogFileStream;
+
+// With -XX:+AsyncGCLogging the -Xloggc stream does not write to its file
+// from the thread that prints. The text is copied into a byte ring buffer
+// and the AsyncLogWriter thread writes it out, so a GC pause never waits
+// for the disk.
+//
+// Printing threads reserve space by advancing _reserved with a CAS, copy
+// their bytes, and then publish them by advancing _committed in
+// reservation order. Whoever holds the drainer claim writes out the bytes
+// in [_released, _committed) and then advances _released. Usually that is
+// the writer thread. A blocked producer, a forced rotation, or the error
+// handler may take the claim too. Bytes written by the claim holder go
+// straight to the file, which keeps rotation messages and log headers in
+// order with the buffered text.
+class AsyncLogWriter : public NamedThread {
+ private:
+  enum {
+    flush_interval_ms = 100      // longest a line stays in the buffer
+  };
+
+  static AsyncLogWriter* _instance;
+
+  gcLogFileStream* const _stream;
+  char*            _buffer;
+  size_t           _capacity;    // power of 2
+  size_t           _mask;
+
+  volatile intptr_t _reserved;   // end of the space handed to producers
+  volatile intptr_t _committed;  // end of the bytes producers have copied in
+  volatile intptr_t _released;   // end of the bytes written to the file
+
+  Thread* volatile _drainer;     // thread that owns the file, or NULL
+  volatile jint    _dropped;     // messages lost since the last drain
+  volatile jint    _wakeup_pending;
+  volatile bool    _active;
+  volatile bool    _should_terminate;
+  volatile bool    _has_terminated;
+
+  AsyncLogWriter(gcLogFileStream* stream);
+
+  bool claim(Thread* thread);
+  void release_claim();
+  // Called by the claim holder.
+  void write_pending();
+  void wakeup();
+
+ public:
+  virtual void run();
+
+  // Start the writer for the given stream, or stop it during VM exit.
+  // Output printed after stop() is written synchronously again.
+  static void create(gcLogFileStream* stream);
+  static void stop();
+
+  bool is_active() const            { return _active; }
+  bool is_drainer(Thread* t) const  { return t != NULL && _drainer == t; }
+
+  // Copy the text into the buffer. When the buffer is full, the text is
+  // dropped or, with AsyncGCLogBlockOnOverflow, the caller waits for
+  // space or drains the buffer itself.
+  void enqueue(Thread* thread, const char* s, size_t len);
+
+  // Write out everything committed so far, on the calling thread. Returns
+  // false if another thread holds the drainer claim.
+  bool drain(Thread* thread);
+
+  // A forced rotation: drain the buffer and rotate the file on the
+  // calling thread, waiting for the writer to finish its current drain.
+  void rotate(Thread* thread, outputStream* out);
+
+  // Printing
+  void print_on(outputStream* st) const;
+
+  static AsyncLogWriter* instance() { return _instance; }
+};
+
+#endif // SHARE_VM_RUNTIME_ASYNCLOGWRITER_HPP
@@ -526,6 +526,37 @@ public:
 };
 
 
+// Objects biased toward a thread that has since exited can be revoked
+// without a safepoint: while Threads_lock is held no thread can be added
+// to or removed from the thread list, so if the bias owner is not on it,
+// no thread can be executing Java code as that owner, and a CAS of the
+// mark word only races with other revoking or rebiasing threads.
+static bool revoke_bias_of_exited_thread(Handle obj, JavaThread* requesting_thread) {
+  MutexLocker ml(Threads_lock, requesting_thread);
+  markOop mark = obj->mark();
+  if (!mark->has_bias_pattern()) {
+    return false;
+  }
+  JavaThread* biased_thread = mark->biased_locker();
+  if (biased_thread == NULL || biased_thread == requesting_thread) {
+    return false;
+  }
+  for (JavaThread* cur_thread = Threads::first(); cur_thread != NULL; cur_thread = cur_thread->next()) {
+    if (cur_thread == biased_thread) {
+      return false;
+    }
+  }
+  markOop unbiased_prototype = markOopDesc::prototype()->set_age(mark->age());
+  if ((markOop) Atomic::cmpxchg_ptr(unbiased_prototype, obj->mark_addr(), mark) != mark) {
+    return false;
+  }
+  if (TraceBiasedLocking) {
+    tty->print_cr("Revoked bias of object biased toward dead thread without a safepoint");
+  }
+  return true;
+}
+
+
 BiasedLocking::Condition BiasedLocking::revoke_and_rebias(Handle obj, bool attempt_rebias, TRAPS) {
   assert(!SafepointSynchronize::is_at_safepoint(), "must not be called while at safepoint");
 
@@ -613,6 +644,8 @@ BiasedLocking::Condition BiasedLocking::revoke_and_rebias(Handle obj, bool attem
       ((JavaThread*) THREAD)->set_cached_monitor_info(NULL);
       assert(cond == BIAS_REVOKED, "why not?");
       return cond;
+    } else if (revoke_bias_of_exited_thread(obj, (JavaThread*) THREAD)) {
+      return BIAS_REVOKED;
     } else {
       VM_RevokeBias revoke(&obj, (JavaThread*) THREAD);
       VMThread::execute(&revoke);
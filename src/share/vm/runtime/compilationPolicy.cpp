@@ -36,6 +36,7 @@
 #include "runtime/compilationPolicy.hpp"
 #include "runtime/frame.hpp"
 #include "runtime/handles.inline.hpp"
+#include "runtime/mutexLocker.hpp"
 #include "runtime/rframe.hpp"
 #include "runtime/simpleThresholdPolicy.hpp"
 #include "runtime/stubRoutines.hpp"
@@ -253,7 +254,10 @@ void NonTieredCompPolicy::reset_counter_for_back_branch_event(methodHandle m) {
 // CounterDecay
 //
 // Interates through invocation counters and decrements them. This
-// is done at each safepoint.
+// is done at each safepoint, or by the service thread with
+// -XX:+ConcurrentCounterDecay.  In the latter case the updates race with
+// the (unsynchronized) counter increments of the mutators, which at
+// worst loses a few increments or one decay step.
 //
 class CounterDecay : public AllStatic {
   static jlong _last_timestamp;
@@ -275,10 +279,15 @@ jlong CounterDecay::_last_timestamp = 0;
 void CounterDecay::decay() {
   _last_timestamp = os::javaTimeMillis();
 
-  // This operation is going to be performed only at the end of a safepoint
-  // and hence GC's will not be going on, all Java mutators are suspended
-  // at this point and hence SystemDictionary_lock is also not needed.
-  assert(SafepointSynchronize::is_at_safepoint(), "can only be executed at a safepoint");
+  // At the end of a safepoint GC's will not be going on, all Java mutators
+  // are suspended and hence SystemDictionary_lock is not needed.  The
+  // service thread takes the lock to keep the dictionary stable, and since
+  // it stays in the VM no class can be unloaded while it walks the methods.
+  assert(SafepointSynchronize::is_at_safepoint() ||
+         (ConcurrentCounterDecay && Thread::current()->is_Java_thread() &&
+          ((JavaThread*)Thread::current())->thread_state() == _thread_in_vm),
+         "can only be executed at a safepoint or by a thread in the VM");
+  MutexLockerEx ml(SafepointSynchronize::is_at_safepoint() ? NULL : SystemDictionary_lock);
   int nclasses = SystemDictionary::number_of_classes();
   double classes_per_tick = nclasses * (CounterDecayMinIntervalLength * 1e-3 /
                                         CounterHalfLifeTime);
@@ -292,7 +301,18 @@ void CounterDecay::decay() {
 
 // Called at the end of the safepoint
 void NonTieredCompPolicy::do_safepoint_work() {
-  if(UseCounterDecay && CounterDecay::is_decay_needed()) {
+  if(UseCounterDecay && !ConcurrentCounterDecay && CounterDecay::is_decay_needed()) {
+    CounterDecay::decay();
+  }
+}
+
+// Polled by the service thread
+bool NonTieredCompPolicy::needs_concurrent_work() {
+  return UseCounterDecay && ConcurrentCounterDecay && CounterDecay::is_decay_needed();
+}
+
+void NonTieredCompPolicy::do_concurrent_work() {
+  if (needs_concurrent_work()) {
     CounterDecay::decay();
   }
 }
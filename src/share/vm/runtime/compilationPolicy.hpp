@@ -69,6 +69,10 @@ public:
   virtual nmethod* event(methodHandle method, methodHandle inlinee, int branch_bci, int bci, CompLevel comp_level, nmethod* nm, JavaThread* thread) = 0;
   // safepoint() is called at the end of the safepoint
   virtual void do_safepoint_work() = 0;
+  // Periodic work that does not need a safepoint, done by the service
+  // thread whenever needs_concurrent_work() returns true
+  virtual bool needs_concurrent_work() { return false; }
+  virtual void do_concurrent_work() {}
   // reprofile request
   virtual void reprofile(ScopeDesc* trap_scope, bool is_osr) = 0;
   // delay_compilation(method) can be called by any component of the runtime to notify the policy
@@ -101,6 +105,8 @@ public:
   virtual CompLevel initial_compile_level() { return CompLevel_highest_tier; }
   virtual int compiler_count(CompLevel comp_level);
   virtual void do_safepoint_work();
+  virtual bool needs_concurrent_work();
+  virtual void do_concurrent_work();
   virtual void reprofile(ScopeDesc* trap_scope, bool is_osr);
   virtual void delay_compilation(Method* method);
   virtual void disable_compilation(Method* method);
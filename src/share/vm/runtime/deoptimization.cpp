@@ -48,6 +48,7 @@
 #include "runtime/vframe.hpp"
 #include "runtime/vframeArray.hpp"
 #include "runtime/vframe_hp.hpp"
+#include "trace/tracing.hpp"
 #include "utilities/events.hpp"
 #include "utilities/xmlstream.hpp"
 #ifdef TARGET_ARCH_x86
@@ -1626,6 +1627,20 @@ JRT_ENTRY(void, Deoptimization::uncommon_trap_inner(JavaThread* thread, jint tra
 
     }
 
+    EventDeoptimization event;
+    if (event.should_commit()) {
+      event.set_compileID(nm->compile_id());
+      event.set_compileLevel(nm->comp_level());
+      event.set_method(trap_method());
+      event.set_bci(trap_bci);
+      event.set_reason(trap_reason_name(reason));
+      event.set_action(trap_action_name(action));
+      event.set_trapCount(trap_mdo != NULL ? trap_mdo->trap_count(reason) : 0);
+      event.set_makeNotEntrant(make_not_entrant);
+      event.set_reprofile(reprofile);
+      event.commit();
+    }
+
     // Take requested actions on the method:
 
     // Recompile
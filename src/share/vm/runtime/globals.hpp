@@ -518,6 +518,14 @@ class CommandLineFlags {
   lp64_product(intx, ObjectAlignmentInBytes, 8,                             \
           "Default object alignment in bytes, 8 is minimum")                \
                                                                             \
+  lp64_product(bool, ObjectAlignmentErgonomics, false,                      \
+          "Increase ObjectAlignmentInBytes, up to "                         \
+          "MaxErgoObjectAlignmentInBytes, so that compressed oops can "     \
+          "be used with the requested maximum heap size")                   \
+                                                                            \
+  lp64_product(intx, MaxErgoObjectAlignmentInBytes, 32,                     \
+          "Largest object alignment chosen by ObjectAlignmentErgonomics")   \
+                                                                            \
   product(bool, AssumeMP, false,                                            \
           "Instruct the VM to assume multiple processors are available")    \
                                                                             \
@@ -590,6 +598,14 @@ class CommandLineFlags {
   product(uintx, NUMAPageScanRate, 256,                                     \
           "Maximum number of pages to include in the page scan procedure")  \
                                                                             \
+  product(bool, UseNUMAPromotion, true,                                     \
+          "Promote objects into old gen memory local to the NUMA node "     \
+          "of the copying GC thread. Only with UseNUMA and ParallelGC")     \
+                                                                            \
+  product(uintx, NUMAPromotionChunkSize, 64*K,                              \
+          "Size in words of the per-node old gen chunks that promotion "    \
+          "labs are carved from with UseNUMAPromotion")                     \
+                                                                            \
   product_pd(bool, NeedsDeoptSuspend,                                       \
           "True for register window machines (sparc/ia64)")                 \
                                                                             \
@@ -638,12 +654,21 @@ class CommandLineFlags {
   product(bool, PrintVMQWaitTime, false,                                    \
           "Print out the waiting time in VM operation queue")               \
                                                                             \
+  product(bool, PrintVMOperationStatistics, false,                          \
+          "Print per type counts, queue latencies and execution times of "  \
+          "VM operations, and how they were batched into safepoints, "      \
+          "at VM exit")                                                     \
+                                                                            \
   develop(bool, NoYieldsInMicrolock, false,                                 \
           "Disable yields in microlock")                                    \
                                                                             \
   develop(bool, TraceOopMapGeneration, false,                               \
           "Show OopMapGeneration")                                          \
                                                                             \
+  product(uintx, OopMapCacheSize, 32,                                       \
+          "Number of entries in the per-class cache of interpreter oop "    \
+          "maps used when scanning interpreted frames")                     \
+                                                                            \
   product(bool, MethodFlushing, true,                                       \
           "Reclamation of zombie and not-entrant methods")                  \
                                                                             \
@@ -708,6 +733,9 @@ class CommandLineFlags {
   product(bool, UseAESIntrinsics, false,                                    \
           "Use intrinsics for AES versions of crypto")                      \
                                                                             \
+  product(bool, UseGHASHIntrinsics, false,                                  \
+          "Use intrinsics for GHASH versions of crypto")                    \
+                                                                            \
   product(bool, UseSHA1Intrinsics, false,                                   \
           "Use intrinsics for SHA-1 crypto hash function")                  \
                                                                             \
@@ -720,6 +748,17 @@ class CommandLineFlags {
   product(bool, UseCRC32Intrinsics, false,                                  \
           "use intrinsics for java.util.zip.CRC32")                         \
                                                                             \
+  product(bool, UseAdler32Intrinsics, false,                                \
+          "use intrinsics for java.util.zip.Adler32")                       \
+                                                                            \
+  product(bool, UseVectorizedHashCodeIntrinsic, false,                      \
+          "use SIMD intrinsics for String.hashCode and "                    \
+          "Arrays.hashCode(char[]/byte[])")                                 \
+                                                                            \
+  product(bool, UseVectorizedMismatchIntrinsic, false,                      \
+          "use a SIMD mismatch stub for Arrays.equals of short[], int[] "   \
+          "and long[]")                                                     \
+                                                                            \
   develop(bool, TraceCallFixup, false,                                      \
           "Trace all call fixups")                                          \
                                                                             \
@@ -942,6 +981,10 @@ class CommandLineFlags {
   product(ccstr, NativeMemoryTracking, "off",                               \
           "Native memory tracking options")                                 \
                                                                             \
+  product(uintx, NativeMemoryTrackingSampleInterval, 0,                     \
+          "With NativeMemoryTracking=detail, record the call site of "      \
+          "one malloc about every this many bytes. 0 records them all")     \
+                                                                            \
   diagnostic(bool, PrintNMTStatistics, false,                               \
           "Print native memory tracking summary data if it is on")          \
                                                                             \
@@ -1015,6 +1058,11 @@ class CommandLineFlags {
           "Print the code cache memory usage each time a method is "        \
           "compiled")                                                       \
                                                                             \
+  product(bool, WritePerfMap, false,                                        \
+          "Write the symbols of compiled code and stubs to "                \
+          "/tmp/perf-<pid>.map for the Linux perf tool as they are "        \
+          "generated")                                                      \
+                                                                            \
   diagnostic(bool, PrintStubCode, false,                                    \
           "Print generated stub code")                                      \
                                                                             \
@@ -1053,6 +1101,10 @@ class CommandLineFlags {
           "Register finalizable objects at end of Object.<init> or "        \
           "after allocation")                                               \
                                                                             \
+  product(bool, UseFastFinalizerRegistration, true,                         \
+          "Register finalizable objects in the VM rather than by calling "  \
+          "Finalizer.register")                                             \
+                                                                            \
   develop(bool, RegisterReferences, true,                                   \
           "Tell whether the VM should register soft/weak/final/phantom "    \
           "references")                                                     \
@@ -1143,6 +1195,15 @@ class CommandLineFlags {
                                                                             \
   product(bool, MonitorInUseLists, false, "Track Monitors for Deflation")   \
                                                                             \
+  diagnostic(bool, MutexContentionStatistics, false,                        \
+          "Record acquisitions, contention, wait and hold times of VM "     \
+          "mutexes; printed by the VM.mutex_statistics diagnostic command") \
+                                                                            \
+  product(intx, MonitorDeflationInterval, 0,                                \
+          "Minimum time in ms between deflations of idle monitors at "      \
+          "safepoints; 0 deflates at every safepoint. A pending monitor "   \
+          "scavenge always deflates")                                       \
+                                                                            \
   product(intx, SyncFlags, 0, "(Unsafe, Unstable) Experimental Sync flags") \
                                                                             \
   product(intx, SyncVerbose, 0, "(Unstable)")                               \
@@ -1240,6 +1301,11 @@ class CommandLineFlags {
   product(bool, LazyBootClassLoader, true,                                  \
           "Enable/disable lazy opening of boot class path entries")         \
                                                                             \
+  product(intx, BootClassPathIndexThreshold, 16,                            \
+          "Number of failed class lookups in a boot class path jar after "  \
+          "which an index of its packages is built to answer further "      \
+          "misses, 0 means never")                                          \
+                                                                            \
   product(bool, UseXMMForArrayCopy, false,                                  \
           "Use SSE2 MOVQ instruction for Arraycopy")                        \
                                                                             \
@@ -1250,6 +1316,10 @@ class CommandLineFlags {
   product(bool, CompactFields, true,                                        \
           "Allocate nonstatic fields in gaps between previous fields")      \
                                                                             \
+  product(bool, CompactFieldsIntoSuperclassGap, false,                      \
+          "With CompactFields, also allocate int, short and byte fields "   \
+          "in the alignment gap after the last superclass field")           \
+                                                                            \
   notproduct(bool, PrintFieldLayout, false,                                 \
           "Print field layout for each class")                              \
                                                                             \
@@ -1283,6 +1353,10 @@ class CommandLineFlags {
           "Decay time (in milliseconds) to re-enable bulk rebiasing of a "  \
           "type after previous bulk rebias")                                \
                                                                             \
+  product(bool, BiasedLockingInheritRevocation, true,                       \
+          "Do not bias instances of a newly defined class whose "           \
+          "superclass (other than Object) had biasing revoked in bulk")     \
+                                                                            \
   product(bool, ExitOnOutOfMemoryError, false,                              \
           "JVM exits on the first occurrence of an out-of-memory error")    \
                                                                             \
@@ -1316,6 +1390,11 @@ class CommandLineFlags {
   product(intx, TraceRedefineClasses, 0,                                    \
           "Trace level for JVMTI RedefineClasses")                          \
                                                                             \
+  product(bool, RecordEvolDependencies, true,                               \
+          "Record evol_method dependencies in all compiled code so that"    \
+          " RedefineClasses only deoptimizes the nmethods that depend on"   \
+          " the redefined classes")                                         \
+                                                                            \
   develop(bool, StressMethodComparator, false,                              \
           "Run the MethodComparator on all loaded methods")                 \
                                                                             \
@@ -1415,6 +1494,15 @@ class CommandLineFlags {
   product(bool, UseParallelOldGC, false,                                    \
           "Use the Parallel Old garbage collector")                         \
                                                                             \
+  experimental(bool, UseEpsilonGC, false,                                   \
+          "Use the Epsilon collector, which only allocates and never "      \
+          "reclaims memory; allocation fails with OutOfMemoryError "        \
+          "once the heap is exhausted")                                     \
+                                                                            \
+  experimental(uintx, EpsilonMinHeapExpand, 128 * M,                        \
+          "Minimum number of bytes the Epsilon heap is committed by "       \
+          "when it runs out of committed space")                            \
+                                                                            \
   product(uintx, HeapMaximumCompactionInterval, 20,                         \
           "How often should we maximally compact the heap (not allowing "   \
           "any dead space)")                                                \
@@ -1439,7 +1527,8 @@ class CommandLineFlags {
                                                                             \
   product(bool, UseDynamicNumberOfGCThreads, false,                         \
           "Dynamically choose the number of parallel threads "              \
-          "parallel gc will use")                                           \
+          "parallel gc will use; the work gang threads are created "        \
+          "when they are first needed")                                     \
                                                                             \
   diagnostic(bool, ForceDynamicNumberOfGCThreads, false,                    \
           "Force dynamic selection of the number of "                       \
@@ -1527,6 +1616,10 @@ class CommandLineFlags {
   product(bool, UseParNewGC, false,                                         \
           "Use parallel threads in the new generation")                     \
                                                                             \
+  product(uintx, DefNewParallelScanThreads, 0,                              \
+          "Number of threads the serial young collector uses to scan the "  \
+          "old generation card table; 0 or 1 scans it serially")            \
+                                                                            \
   product(bool, ParallelGCVerbose, false,                                   \
           "Verbose output for parallel gc")                                 \
                                                                             \
@@ -1556,6 +1649,10 @@ class CommandLineFlags {
           "Scan a subset of object array and push remainder, if array is "  \
           "bigger than this")                                               \
                                                                             \
+  product(uintx, ParGCDeepStackThreshold, 256*K,                            \
+          "Java threads using more stack than this (in bytes) are claimed " \
+          "first by parallel GC root scanning. 0 disables")                 \
+                                                                            \
   product(bool, ParGCUseLocalOverflow, false,                               \
           "Instead of a global overflow list, use local overflow stacks")   \
                                                                             \
@@ -1585,6 +1682,11 @@ class CommandLineFlags {
           "Number of blocks to attempt to claim when refilling CMS LAB's "  \
           "for parallel GC")                                                \
                                                                             \
+  product(uintx, CMSParPromoteLargeBufferSize, 16*K,                        \
+          "Size in words of the per-worker buffer that large blocks are "   \
+          "carved from when promoting into the CMS generation; 0 takes "    \
+          "every large block from the dictionary")                          \
+                                                                            \
   product(uintx, OldPLABWeight, 50,                                         \
           "Percentage (0-100) used to weight the current sample when "      \
           "computing exponentially decaying average for resizing "          \
@@ -1620,9 +1722,18 @@ class CommandLineFlags {
           "The gain in the feedback loop for on-the-fly PLAB resizing "     \
           "during a scavenge")                                              \
                                                                             \
+  product(ccstr, AllocateHeapAt, NULL,                                      \
+          "Path to a directory, e.g. a tmpfs or DAX mount, in which an "    \
+          "unlinked temporary file is created to back the Java heap "       \
+          "instead of anonymous memory")                                    \
+                                                                            \
   product(bool, AlwaysPreTouch, false,                                      \
           "Force all freshly committed pages to be pre-touched")            \
                                                                             \
+  product(uintx, PreTouchParallelChunkSize, 1 * G,                          \
+          "Per-thread chunk size for parallel memory pre-touch; ranges "    \
+          "smaller than two chunks are pre-touched by a single thread")     \
+                                                                            \
   product_pd(uintx, CMSYoungGenPerWorker,                                   \
           "The maximum size of young gen chosen by default per GC worker "  \
           "thread available")                                               \
@@ -1668,6 +1779,15 @@ class CommandLineFlags {
           "CMS: aggressiveness level for coalescing, increasing "           \
           "from 0 to 4")                                                    \
                                                                             \
+  product(bool, CMSReduceFragmentation, false,                              \
+          "Coalesce all adjacent free blocks in a sweep that starts with "  \
+          "the CMS free space fragmented beyond CMSFragmentationThreshold"  \
+          ", regardless of FLSCoalescePolicy")                              \
+                                                                            \
+  product(uintx, CMSFragmentationThreshold, 50,                             \
+          "Percentage (0-100) fragmentation of the CMS free space above "   \
+          "which CMSReduceFragmentation coalesces all free blocks")         \
+                                                                            \
   product(bool, FLSAlwaysCoalesceLarge, false,                              \
           "CMS: larger free blocks are always available for coalescing")    \
                                                                             \
@@ -1784,6 +1904,11 @@ class CommandLineFlags {
           "Time that we sleep between iterations when not given "           \
           "enough work per iteration")                                      \
                                                                             \
+  product(uintx, CMSAbortablePrecleanDirtyRatio, 100,                       \
+          "Abort the abortable preclean phase once the estimated rate at "  \
+          "which mutators dirty cards reaches this percentage of the "      \
+          "rate at which precleaning cleans them; 0 disables it")           \
+                                                                            \
   product(uintx, CMSRescanMultiple, 32,                                     \
           "Size (in cards) of CMS parallel rescan task")                    \
                                                                             \
@@ -1932,11 +2057,17 @@ class CommandLineFlags {
           "reference-based(0) or referent-based(1)")                        \
                                                                             \
   product(bool, ParallelRefProcEnabled, false,                              \
-          "Enable parallel reference processing whenever possible")         \
+          "Enable parallel reference processing whenever possible; "        \
+          "enabled ergonomically for multi-threaded collectors")            \
                                                                             \
   product(bool, ParallelRefProcBalancingEnabled, true,                      \
           "Enable balancing of reference processing queues")                \
                                                                             \
+  product(uintx, ReferencesPerThread, 1000,                                 \
+          "In parallel reference processing, the number of references "     \
+          "of a type to give each queue; limits the queues used for a "     \
+          "type with few references. 0 uses all queues")                    \
+                                                                            \
   product(uintx, CMSTriggerRatio, 80,                                       \
           "Percentage of MinHeapFreeRatio in CMS generation that is "       \
           "allocated before a CMS collection cycle commences")              \
@@ -2015,6 +2146,11 @@ class CommandLineFlags {
   experimental(uintx, WorkStealingSpinToYieldRatio, 10,                     \
           "Ratio of hard spins to calls to yield")                          \
                                                                             \
+  product(bool, UseOWSTTaskTerminator, false,                               \
+          "Use the optimized work stealing task termination protocol: "     \
+          "one thread spins looking for work while the others wait, "       \
+          "and it wakes as many as there are tasks to steal")               \
+                                                                            \
   develop(uintx, ObjArrayMarkingStride, 512,                                \
           "Number of object array elements to push onto the marking stack " \
           "before pushing a continuation entry")                            \
@@ -2049,9 +2185,20 @@ class CommandLineFlags {
   product(bool, ZeroTLAB, false,                                            \
           "Zero out the newly created TLAB")                                \
                                                                             \
+  product(bool, ZeroEdenConcurrently, false,                                \
+          "Zero the free part of eden in a background thread, so that "     \
+          "ZeroTLAB refills find it zeroed already (Serial and ParNew "     \
+          "young collectors only)")                                         \
+                                                                            \
   product(bool, FastTLABRefill, true,                                       \
           "Use fast TLAB refill code")                                      \
                                                                             \
+  product(uintx, HeapSamplingInterval, 0,                                   \
+          "Sample, on average, one object allocation every this many "      \
+          "bytes allocated by each thread and report it to the "            \
+          "SampledObjectAlloc JVMTI extension event and the tracing "       \
+          "framework; 0 disables sampling. Requires UseTLAB")               \
+                                                                            \
   product(bool, PrintTLAB, false,                                           \
           "Print various TLAB related information")                         \
                                                                             \
@@ -2332,6 +2479,10 @@ class CommandLineFlags {
   product(bool, UseGCTaskAffinity, false,                                   \
           "Use worker affinity when asking for GCTasks")                    \
                                                                             \
+  experimental(bool, UseGCTaskStealing, false,                              \
+          "Hand out GCTasks through per worker deques with work stealing "  \
+          "instead of one at a time from the GCTaskManager queue")          \
+                                                                            \
   product(uintx, ProcessDistributionStride, 4,                              \
           "Stride through processors when distributing processes")          \
                                                                             \
@@ -2362,6 +2513,11 @@ class CommandLineFlags {
   product(bool, PrintGCTaskTimeStamps, false,                               \
           "Print timestamps for individual gc worker thread tasks")         \
                                                                             \
+  manageable(bool, PrintGCWorkerPhaseTimes, false,                          \
+          "Print per-worker phase times, CPU time, steals and termination " \
+          "attempts after each parallel pause of ParallelGC, ParNew and "   \
+          "CMS")                                                            \
+                                                                            \
   develop(intx, ConcGCYieldTimeout, 0,                                      \
           "If non-zero, assert that GC threads yield within this "          \
           "number of milliseconds")                                         \
@@ -2497,6 +2653,20 @@ class CommandLineFlags {
           "GC log file size, requires UseGCLogFileRotation. "               \
           "Set to 0 to only trigger rotation via jcmd")                     \
                                                                             \
+  /* Asynchronous GC logging */                                             \
+                                                                            \
+  product(bool, AsyncGCLogging, false,                                      \
+          "Buffer -Xloggc output in memory and write it to the file "       \
+          "from a dedicated thread, so that pauses do not wait for I/O")    \
+                                                                            \
+  product(uintx, AsyncGCLogBufferSize, 2*M,                                 \
+          "Size in bytes of the AsyncGCLogging buffer, rounded up to a "    \
+          "power of 2")                                                     \
+                                                                            \
+  product(bool, AsyncGCLogBlockOnOverflow, false,                           \
+          "Make a thread wait for space when the AsyncGCLogging buffer is " \
+          "full instead of dropping its output")                            \
+                                                                            \
   /* JVMTI heap profiling */                                                \
                                                                             \
   diagnostic(bool, TraceJVMTIObjectTagging, false,                          \
@@ -2550,6 +2720,17 @@ class CommandLineFlags {
   product(intx, CICompilerCount, CI_COMPILER_COUNT,                         \
           "Number of compiler threads to run")                              \
                                                                             \
+  product(bool, UseDynamicNumberOfCompilerThreads, true,                    \
+          "Dynamically choose the number of parallel compiler threads, "    \
+          "up to CICompilerCount, based on queue length and free memory")   \
+                                                                            \
+  diagnostic(bool, ReduceNumberOfCompilerThreads, true,                     \
+          "Reduce the number of parallel compiler threads when they "       \
+          "are not used")                                                   \
+                                                                            \
+  diagnostic(bool, TraceCompilerThreads, false,                             \
+          "Trace creation and removal of compiler threads")                 \
+                                                                            \
   product(intx, CompilationPolicyChoice, 0,                                 \
           "which compilation policy (0/1)")                                 \
                                                                             \
@@ -2595,6 +2776,18 @@ class CommandLineFlags {
           "Print the break down of clean up tasks performed during "        \
           "safepoint")                                                      \
                                                                             \
+  product(bool, ParallelSafepointCleanup, true,                             \
+          "Run the independent safepoint cleanup tasks in parallel on "     \
+          "the GC worker threads, if the collector has any")                \
+                                                                            \
+  product(bool, PrintSafepointStraggler, false,                             \
+          "Print the thread that was the last to reach each safepoint "     \
+          "and the Java method it stopped in")                              \
+                                                                            \
+  product(bool, PrintGuaranteedSafepoints, false,                           \
+          "Print the cleanup task that made the VM thread force a "         \
+          "safepoint after GuaranteedSafepointInterval")                    \
+                                                                            \
   product(bool, Inline, true,                                               \
           "Enable inlining")                                                \
                                                                             \
@@ -2638,6 +2831,10 @@ class CommandLineFlags {
           "Generate extra debugging information for non-safepoints in "     \
           "nmethods")                                                       \
                                                                             \
+  diagnostic(bool, ShareScopeDebugInfo, true,                               \
+          "Share identical scope, value and monitor descriptions in the "   \
+          "debug info of an nmethod also at safepoints")                    \
+                                                                            \
   product(bool, PrintVMOptions, false,                                      \
           "Print flags that appeared on the command line")                  \
                                                                             \
@@ -2653,6 +2850,10 @@ class CommandLineFlags {
   product(bool, PrintFlagsFinal, false,                                     \
           "Print all VM flags after argument and ergonomic processing")     \
                                                                             \
+  product(bool, PrintStartupPhases, false,                                  \
+          "Print the time spent in each VM initialization phase; "          \
+          "also kept in the sun.rt.init.* PerfData counters")               \
+                                                                            \
   notproduct(bool, PrintFlagsWithComments, false,                           \
           "Print all VM flags with default values and descriptions and "    \
           "exit")                                                           \
@@ -2929,6 +3130,10 @@ class CommandLineFlags {
   product(bool, UseCounterDecay, true,                                      \
           "Adjust recompilation counters")                                  \
                                                                             \
+  product(bool, ConcurrentCounterDecay, true,                               \
+          "Decay the recompilation counters on the service thread "         \
+          "instead of at safepoints")                                       \
+                                                                            \
   develop(intx, CounterHalfLifeTime,    30,                                 \
           "Half-life time of invocation counters (in seconds)")             \
                                                                             \
@@ -2956,6 +3161,10 @@ class CommandLineFlags {
   product(intx, MaxBCEAEstimateSize, 150,                                   \
           "Maximum bytecode size of a method to be analyzed by BC EA")      \
                                                                             \
+  product(intx, MaxBCEASummarySize, 1000,                                   \
+          "Maximum bytecode size of a method whose BC EA summary is "       \
+          "computed for a compiled caller and cached in its MethodData")    \
+                                                                            \
   product(intx,  AllocatePrefetchStyle, 1,                                  \
           "0 = no prefetch, "                                               \
           "1 = prefetch instructions for each allocation, "                 \
@@ -3158,6 +3367,10 @@ class CommandLineFlags {
   product(intx, PerBytecodeTrapLimit,  4,                                   \
           "Limit on traps (of one kind) at a particular BCI")               \
                                                                             \
+  product(bool, PerBytecodeTrapHistory, false,                              \
+          "Do not apply PerMethodTrapLimit to a BCI whose trap history "    \
+          "shows it has not trapped for the same reason")                   \
+                                                                            \
   experimental(intx, SpecTrapLimitExtraEntries,  3,                         \
           "Extra method data trap entries for speculation")                 \
                                                                             \
@@ -3201,6 +3414,22 @@ class CommandLineFlags {
           "Maximum size in bytes of objects allocated in DefNew "           \
           "generation; zero means no maximum")                              \
                                                                             \
+  product(bool, PretenureLongLivedClasses, false,                           \
+          "Promote instances of classes whose objects mostly survive "      \
+          "several young collections at their first survival instead of "   \
+          "copying them between survivor spaces; decisions are cleared "    \
+          "at each full collection. Serial and ParNew young collectors "    \
+          "only")                                                           \
+                                                                            \
+  product(uintx, PretenureSurvivalPercent, 80,                              \
+          "Percentage of a class's survivor copies that must be of "        \
+          "objects that had already survived a young collection for "       \
+          "PretenureLongLivedClasses to pretenure the class")               \
+                                                                            \
+  product(uintx, PretenureSampleWords, 64*K,                                \
+          "Words of survivor copies of a class after which "                \
+          "PretenureLongLivedClasses decides whether to pretenure it")      \
+                                                                            \
   product(uintx, TLABSize, 0,                                               \
           "Starting TLAB size (in bytes); zero means set ergonomically")    \
                                                                             \
@@ -3219,6 +3448,11 @@ class CommandLineFlags {
   product(uintx, TLABWasteIncrement,    4,                                  \
           "Increment allowed waste at slow allocation")                     \
                                                                             \
+  product(bool, TLABAdaptiveRefillWaste, false,                             \
+          "Learn the refill waste limit and allocation fraction of each "   \
+          "thread's TLAB from the thread's own refills and allocation "     \
+          "since the last GC")                                              \
+                                                                            \
   product(uintx, SurvivorRatio, 8,                                          \
           "Ratio of eden/survivor space size")                              \
                                                                             \
@@ -3249,6 +3483,12 @@ class CommandLineFlags {
           " For most GCs this applies to the old generation. In G1 and"     \
           " ParallelGC it applies to the whole heap.")                      \
                                                                             \
+  manageable(uintx, SoftMaxHeapSize, 0,                                     \
+          "Soft limit for the committed Java heap (in bytes) that G1 and "  \
+          "ParallelGC try to stay below by shrinking the heap after "       \
+          "young collections. The heap may still grow up to MaxHeapSize "   \
+          "to avoid an OutOfMemoryError. 0 means MaxHeapSize")              \
+                                                                            \
   product(intx, SoftRefLRUPolicyMSPerMB, 1000,                              \
           "Number of milliseconds per MB of free space in the heap")        \
                                                                             \
@@ -3266,6 +3506,10 @@ class CommandLineFlags {
           "The maximum percentage of Metaspace free after GC to avoid "     \
           "shrinking")                                                      \
                                                                             \
+  product(bool, MetaspaceDiscardFreeChunks, true,                           \
+          "Return the pages of free medium and humongous Metaspace "        \
+          "chunks to the operating system, they stay committed")            \
+                                                                            \
   product(uintx, MaxMetaspaceExpansion, ScaleForWordSize(4*M),              \
           "The maximum expansion of Metaspace without full GC (in bytes)")  \
                                                                             \
@@ -3392,6 +3636,25 @@ class CommandLineFlags {
   product_pd(uintx, CodeCacheExpansionSize,                                 \
           "Code cache expansion size (in bytes)")                           \
                                                                             \
+  product(bool, SegmentedCodeCache, false,                                  \
+          "Use separate code heaps for non-nmethods, profiled and "         \
+          "non-profiled nmethods (tiered compilation only)")                \
+                                                                            \
+  product(uintx, NonNMethodCodeHeapSize, 8*M,                               \
+          "Size of code heap with non-nmethods (in bytes)")                 \
+                                                                            \
+  product(uintx, ProfiledCodeHeapSize, 0,                                   \
+          "Size of code heap with profiled methods (in bytes); "            \
+          "by default half of what the non-nmethods leave")                 \
+                                                                            \
+  product(uintx, NonProfiledCodeHeapSize, 0,                                \
+          "Size of code heap with non-profiled methods (in bytes); "        \
+          "by default half of what the non-nmethods leave")                 \
+                                                                            \
+  product(uintx, InlineCacheBufferSize, 10*K,                               \
+          "Size of the buffer for inline cache transition stubs (in "       \
+          "bytes); a full buffer forces a safepoint")                       \
+                                                                            \
   develop_pd(uintx, CodeCacheMinBlockLength,                                \
           "Minimum number of segments in a code cache block")               \
                                                                             \
@@ -3442,6 +3705,19 @@ class CommandLineFlags {
   product(ccstrlist, CompileCommand, "",                                    \
           "Prepend to .hotspot_compiler; e.g. log,java/lang/String.<init>") \
                                                                             \
+  product(ccstr, HotMethodsFile, NULL,                                      \
+          "Methods listed in this file are compiled as soon as their "      \
+          "class is initialized (see DumpHotMethodsAtExit)")                \
+                                                                            \
+  product(bool, DumpHotMethodsAtExit, false,                                \
+          "Write the methods with compiled code to HotMethodsFile "         \
+          "at exit")                                                        \
+                                                                            \
+  product(bool, HotMethodsUseRecordedLevel, false,                          \
+          "Compile methods from HotMethodsFile directly at their recorded " \
+          "level instead of profiling them first. Reduces compilation "     \
+          "work of short running VMs at the cost of peak performance")      \
+                                                                            \
   develop(bool, ReplayCompiles, false,                                      \
           "Enable replay of compilations from ReplayDataFile")              \
                                                                             \
@@ -3672,6 +3948,11 @@ class CommandLineFlags {
           "Kill compile task if method was not used within "                \
           "given timeout in milliseconds")                                  \
                                                                             \
+  product(intx, TieredCompileQueueBatch, 16,                                \
+          "Number of tasks ranked by one scan of a long compile queue "     \
+          "and handed out in order by later selections (at most 64, "       \
+          "0 or 1 scans the queue on every selection)")                     \
+                                                                            \
   product(intx, TieredStopAtLevel, 4,                                       \
           "Stop at given compilation level")                                \
                                                                             \
@@ -3785,6 +4066,10 @@ class CommandLineFlags {
           "Size of performance data memory region. Will be rounded "        \
           "up to a multiple of the native os page size.")                   \
                                                                             \
+  product(bool, PerfDataHistograms, false,                                  \
+          "Keep histograms of GC pause, safepoint and compilation times "   \
+          "in the performance data memory region")                          \
+                                                                            \
   product(intx, PerfMaxStringConstLength, 1024,                             \
           "Maximum PerfStringConstant string length before truncation")     \
                                                                             \
@@ -3812,6 +4097,11 @@ class CommandLineFlags {
   manageable(bool, PrintConcurrentLocks, false,                             \
           "Print java.util.concurrent locks in thread dump")                \
                                                                             \
+  manageable(intx, MonitorContentionSampleInterval, 0,                      \
+          "Record the stacks and blocked time of one in this many "         \
+          "contended monitor enters for Monitor.contention; "               \
+          "0 disables the recording")                                       \
+                                                                            \
   product(bool, TransmitErrorReport, false,                                 \
           "Enable error report transmission on erroneous termination")      \
                                                                             \
@@ -3865,6 +4155,12 @@ class CommandLineFlags {
           "support JSR 292 (method handles, invokedynamic, "                \
           "anonymous classes")                                              \
                                                                             \
+  product(bool, ShareLambdaCallSites, false,                                \
+          "Link an invokedynamic call site bootstrapped by "                \
+          "LambdaMetafactory.metafactory like an already linked call "      \
+          "site of the same constant pool entry, instead of running the "   \
+          "bootstrap method again")                                         \
+                                                                            \
   diagnostic(bool, IgnoreUnverifiableClassesDuringDump, false,              \
           "Do not quit -Xshare:dump even if we encounter unverifiable "     \
           "classes. Just exclude them from the shared dictionary.")         \
@@ -3925,6 +4221,10 @@ class CommandLineFlags {
   experimental(uintx, SymbolTableSize, defaultSymbolTableSize,              \
           "Number of buckets in the JVM internal Symbol table")             \
                                                                             \
+  product(bool, ResizeSymbolAndStringTables, true,                          \
+          "Grow the symbol and string tables at a safepoint when their "    \
+          "average bucket length gets too long")                            \
+                                                                            \
   product(bool, UseStringDeduplication, false,                              \
           "Use string deduplication")                                       \
                                                                             \
@@ -3939,7 +4239,7 @@ class CommandLineFlags {
           "Force table resize every time the table is scanned")             \
                                                                             \
   diagnostic(bool, StringDeduplicationRehashALot, false,                    \
-          "Force table rehash every time the table is scanned")             \
+          "Force table rehash every time the deduplication thread runs")    \
                                                                             \
   develop(bool, TraceDefaultMethods, false,                                 \
           "Trace the default method processing steps")                      \
@@ -3988,6 +4288,17 @@ class CommandLineFlags {
   product(bool, UseLockedTracing, false,                                    \
           "Use locked-tracing when doing event-based tracing")              \
                                                                             \
+  product(ccstr, TraceRecordingFile, NULL,                                  \
+          "Record the trace events into this binary file from startup; "    \
+          "see the Trace.start diagnostic command")                         \
+                                                                            \
+  product(uintx, TraceBufferSize, 64*K,                                     \
+          "Size of each thread-local buffer of the trace recorder")         \
+                                                                            \
+  product(uintx, TraceFlushInterval, 1000,                                  \
+          "Milliseconds between writes of the trace buffers to the "        \
+          "recording file, rounded to a multiple of 10")                    \
+                                                                            \
   product_pd(bool, PreserveFramePointer,                                    \
              "Use the FP register for holding the frame pointer "           \
              "and not as a general purpose register.")
@@ -25,15 +25,20 @@
 #include "precompiled.hpp"
 #include "classfile/symbolTable.hpp"
 #include "code/icBuffer.hpp"
+#include "code/perfMap.hpp"
 #include "gc_interface/collectedHeap.hpp"
 #include "interpreter/bytecodes.hpp"
+#include "memory/resourceArea.hpp"
 #include "memory/universe.hpp"
 #include "prims/methodHandles.hpp"
 #include "runtime/handles.inline.hpp"
 #include "runtime/icache.hpp"
 #include "runtime/init.hpp"
+#include "runtime/perfData.hpp"
 #include "runtime/safepoint.hpp"
 #include "runtime/sharedRuntime.hpp"
+#include "runtime/timer.hpp"
+#include "runtime/vmThread.hpp"
 #include "services/memTracker.hpp"
 #include "utilities/macros.hpp"
 
@@ -92,28 +97,58 @@ void vm_init_globals() {
 }
 
 
+// Times one initialization phase for PrintStartupPhases and records it
+// in the sun.rt.init.<name> PerfData tick counter.
+class InitPhaseTimer : public StackObj {
+ private:
+  const char*  _name;
+  elapsedTimer _timer;
+
+ public:
+  InitPhaseTimer(const char* name) : _name(name) {
+    _timer.start();
+  }
+
+  ~InitPhaseTimer() {
+    _timer.stop();
+    if (PrintStartupPhases) {
+      tty->print_cr("[Startup phase %s: %.3f ms]", _name, _timer.seconds() * MILLIUNITS);
+    }
+    if (UsePerfData) {
+      EXCEPTION_MARK;
+      ResourceMark rm;
+      PerfDataManager::create_counter(SUN_RT, PerfDataManager::counter_name("init", _name),
+                                      PerfData::U_Ticks, _timer.ticks(), THREAD);
+    }
+  }
+};
+
 jint init_globals() {
   HandleMark hm;
   management_init();
   bytecodes_init();
-  classLoader_init();
-  codeCache_init();
+  { InitPhaseTimer t("classLoader");     classLoader_init(); }
+  { InitPhaseTimer t("codeCache");       codeCache_init(); }
+  PerfMap::initialize();   // before any code is generated
   VM_Version_init();
   os_init_globals();
-  stubRoutines_init1();
-  jint status = universe_init();  // dependent on codeCache_init and
-                                  // stubRoutines_init1 and metaspace_init.
+  { InitPhaseTimer t("stubRoutines1");   stubRoutines_init1(); }
+  jint status;
+  { InitPhaseTimer t("universe");
+    status = universe_init();  // dependent on codeCache_init and
+                               // stubRoutines_init1 and metaspace_init.
+  }
   if (status != JNI_OK)
     return status;
 
-  interpreter_init();  // before any methods loaded
+  { InitPhaseTimer t("interpreter");     interpreter_init(); }  // before any methods loaded
   invocationCounter_init();  // before any methods loaded
   marksweep_init();
   accessFlags_init();
-  templateTable_init();
+  { InitPhaseTimer t("templateTable");   templateTable_init(); }
   InterfaceSupport_init();
-  SharedRuntime::generate_stubs();
-  universe2_init();  // dependent on codeCache_init and stubRoutines_init1
+  { InitPhaseTimer t("sharedRuntime");   SharedRuntime::generate_stubs(); }
+  { InitPhaseTimer t("universe2");       universe2_init(); }  // dependent on codeCache_init and stubRoutines_init1
   referenceProcessor_init();
   jni_handles_init();
 #if INCLUDE_VM_STRUCTS
@@ -124,14 +159,16 @@ jint init_globals() {
   InlineCacheBuffer_init();
   compilerOracle_init();
   compilationPolicy_init();
-  compileBroker_init();
+  { InitPhaseTimer t("compileBroker");   compileBroker_init(); }
   VMRegImpl::set_regName();
 
-  if (!universe_post_init()) {
+  bool post_init_ok;
+  { InitPhaseTimer t("universePostInit"); post_init_ok = universe_post_init(); }
+  if (!post_init_ok) {
     return JNI_ERR;
   }
-  javaClasses_init();   // must happen after vtable initialization
-  stubRoutines_init2(); // note: StubRoutines need 2-phase init
+  { InitPhaseTimer t("javaClasses");     javaClasses_init(); }  // must happen after vtable initialization
+  { InitPhaseTimer t("stubRoutines2");   stubRoutines_init2(); } // note: StubRoutines need 2-phase init
 
 #if INCLUDE_NMT
   // Solaris stack is walkable only after stubRoutines are set up.
@@ -158,6 +195,9 @@ void exit_globals() {
       // Print the collected safepoint statistics.
       SafepointSynchronize::print_stat_on_exit();
     }
+    if (PrintVMOperationStatistics) {
+      VMThread::print_statistics_on(tty);
+    }
     if (PrintStringTableStatistics) {
       SymbolTable::dump(tty);
       StringTable::dump(tty);
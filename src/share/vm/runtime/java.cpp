@@ -29,6 +29,7 @@
 #include "code/codeCache.hpp"
 #include "compiler/compileBroker.hpp"
 #include "compiler/compilerOracle.hpp"
+#include "compiler/hotMethods.hpp"
 #include "interpreter/bytecodeHistogram.hpp"
 #include "memory/genCollectedHeap.hpp"
 #include "memory/oopFactory.hpp"
@@ -43,6 +44,7 @@
 #include "oops/symbol.hpp"
 #include "prims/jvmtiExport.hpp"
 #include "runtime/arguments.hpp"
+#include "runtime/asyncLogWriter.hpp"
 #include "runtime/biasedLocking.hpp"
 #include "runtime/compilationPolicy.hpp"
 #include "runtime/fprofiler.hpp"
@@ -58,6 +60,7 @@
 #include "runtime/timer.hpp"
 #include "runtime/vm_operations.hpp"
 #include "services/memTracker.hpp"
+#include "trace/traceRecorder.hpp"
 #include "trace/tracing.hpp"
 #include "utilities/dtrace.hpp"
 #include "utilities/globalDefinitions.hpp"
@@ -496,6 +499,20 @@ void before_exit(JavaThread * thread) {
     FlatProfiler::print(10);
   }
 
+  // Record the compiled methods for the next run
+  if (DumpHotMethodsAtExit) {
+    if (HotMethodsFile == NULL) {
+      warning("DumpHotMethodsAtExit requires HotMethodsFile");
+    } else if (HotMethods::dump(HotMethodsFile) < 0) {
+      warning("Cannot open hot methods file %s", HotMethodsFile);
+    }
+  }
+
+#if INCLUDE_TRACE
+  // Write the rest of the trace recording
+  TraceRecorder::stop();
+#endif
+
   // shut down the StatSampler task
   StatSampler::disengage();
   StatSampler::destroy();
@@ -512,6 +529,9 @@ void before_exit(JavaThread * thread) {
     }
   }
 
+  // Write out the buffered GC log; later output is written synchronously
+  AsyncLogWriter::stop();
+
   if (PrintBytecodeHistogram) {
     BytecodeHistogram::print();
   }
@@ -26,6 +26,7 @@
 #include "classfile/systemDictionary.hpp"
 #include "oops/oop.inline.hpp"
 #include "prims/jvmtiExport.hpp"
+#include "runtime/atomic.inline.hpp"
 #include "runtime/jniHandles.hpp"
 #include "runtime/mutexLocker.hpp"
 #include "runtime/thread.inline.hpp"
@@ -380,32 +381,34 @@ void JNIHandleBlock::oops_do(OopClosure* f) {
 }
 
 
-void JNIHandleBlock::weak_oops_do(BoolObjectClosure* is_alive,
-                                  OopClosure* f) {
-  for (JNIHandleBlock* current = this; current != NULL; current = current->_next) {
-    assert(current->pop_frame_link() == NULL,
-      "blocks holding weak global JNI handles should not have pop frame link set");
-    for (int index = 0; index < current->_top; index++) {
-      oop* root = &(current->_handles)[index];
-      oop value = *root;
-      // traverse heap pointers only, not deleted handles or free list pointers
-      if (value != NULL && Universe::heap()->is_in_reserved(value)) {
-        if (is_alive->do_object_b(value)) {
-          // The weakly referenced object is alive, update pointer
-          f->do_oop(root);
-        } else {
-          // The weakly referenced object is not alive, clear the reference by storing NULL
-          if (TraceReferenceGC) {
-            tty->print_cr("Clearing JNI weak reference (" INTPTR_FORMAT ")", root);
-          }
-          *root = NULL;
+void JNIHandleBlock::weak_oops_do_in_block(BoolObjectClosure* is_alive,
+                                           OopClosure* f) {
+  assert(pop_frame_link() == NULL,
+    "blocks holding weak global JNI handles should not have pop frame link set");
+  for (int index = 0; index < _top; index++) {
+    oop* root = &_handles[index];
+    oop value = *root;
+    // traverse heap pointers only, not deleted handles or free list pointers
+    if (value != NULL && Universe::heap()->is_in_reserved(value)) {
+      if (is_alive->do_object_b(value)) {
+        // The weakly referenced object is alive, update pointer
+        f->do_oop(root);
+      } else {
+        // The weakly referenced object is not alive, clear the reference by storing NULL
+        if (TraceReferenceGC) {
+          tty->print_cr("Clearing JNI weak reference (" INTPTR_FORMAT ")", root);
         }
+        *root = NULL;
       }
     }
-    // the next handle block is valid only if current block is full
-    if (current->_top < block_size_in_oops) {
-      break;
-    }
+  }
+}
+
+
+void JNIHandleBlock::weak_oops_do(BoolObjectClosure* is_alive,
+                                  OopClosure* f) {
+  for (JNIHandleBlock* current = this; current != NULL; current = current->next_weak_block()) {
+    current->weak_oops_do_in_block(is_alive, f);
   }
 
   /*
@@ -416,6 +419,38 @@ void JNIHandleBlock::weak_oops_do(BoolObjectClosure* is_alive,
 }
 
 
+JNIWeakHandlesParState::JNIWeakHandlesParState() :
+  _next_block(JNIHandles::weak_global_handles()), _jvmti_claimed(0) {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
+}
+
+JNIHandleBlock* JNIWeakHandlesParState::claim_block() {
+  JNIHandleBlock* block = _next_block;
+  while (block != NULL) {
+    JNIHandleBlock* next = block->next_weak_block();
+    JNIHandleBlock* res =
+      (JNIHandleBlock*)Atomic::cmpxchg_ptr(next, &_next_block, block);
+    if (res == block) {
+      return block;
+    }
+    block = res;
+  }
+  return NULL;
+}
+
+void JNIWeakHandlesParState::weak_oops_do(BoolObjectClosure* is_alive,
+                                          OopClosure* f) {
+  JNIHandleBlock* block;
+  while ((block = claim_block()) != NULL) {
+    block->weak_oops_do_in_block(is_alive, f);
+  }
+  // See JNIHandleBlock::weak_oops_do().
+  if (_jvmti_claimed == 0 && Atomic::cmpxchg(1, &_jvmti_claimed, 0) == 0) {
+    JvmtiExport::weak_oops_do(is_alive, f);
+  }
+}
+
+
 jobject JNIHandleBlock::allocate_handle(oop obj) {
   assert(Universe::heap()->is_in_reserved(obj), "sanity check");
   if (_top == 0) {
@@ -86,6 +86,21 @@ class JNIHandles : AllStatic {
   static void oops_do(OopClosure* f);
   // Traversal of weak global handles. Unreachable oops are cleared.
   static void weak_oops_do(BoolObjectClosure* is_alive, OopClosure* f);
+  static JNIHandleBlock* weak_global_handles()  { return _weak_global_handles; }
+};
+
+// Shared state for parallel traversal of the weak global handles. Each
+// worker calling weak_oops_do() claims whole handle blocks until the chain
+// is exhausted; the JVMTI weak oops are processed by the first worker only.
+class JNIWeakHandlesParState : public StackObj {
+  JNIHandleBlock* volatile _next_block;
+  volatile jint            _jvmti_claimed;
+
+  JNIHandleBlock* claim_block();
+ public:
+  JNIWeakHandlesParState();
+
+  void weak_oops_do(BoolObjectClosure* is_alive, OopClosure* f);
 };
 
 
@@ -154,6 +169,13 @@ class JNIHandleBlock : public CHeapObj<mtInternal> {
   void oops_do(OopClosure* f);
   // Traversal of weak handles. Unreachable oops are cleared.
   void weak_oops_do(BoolObjectClosure* is_alive, OopClosure* f);
+  // Same as above, but for the handles of this block only.
+  void weak_oops_do_in_block(BoolObjectClosure* is_alive, OopClosure* f);
+  // The next block of a weak handle chain, NULL if this is the last one.
+  // The next handle block is valid only if this block is full.
+  JNIHandleBlock* next_weak_block() const {
+    return _top < block_size_in_oops ? NULL : _next;
+  }
 
   // Checked JNI support
   void set_planned_capacity(size_t planned_capacity) { _planned_capacity = planned_capacity; }
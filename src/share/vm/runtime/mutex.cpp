@@ -909,15 +909,22 @@ void Monitor::lock (Thread * Self) {
   assert (_owner != Self              , "invariant") ;
   assert (_OnDeck != Self->_MutexEvent, "invariant") ;
 
+  jlong contended_start = 0;
   if (TryFast()) {
  Exeunt:
     assert (ILocked(), "invariant") ;
     assert (owner() == NULL, "invariant");
     set_owner (Self);
+    if (MutexContentionStatistics && !_snuck) {
+      record_acquire(contended_start);
+    }
     return ;
   }
 
   // The lock is contended ...
+  if (MutexContentionStatistics) {
+    contended_start = os::javaTimeNanos();
+  }
 
   bool can_sneak = Self->is_VM_thread() && SafepointSynchronize::is_at_safepoint();
   if (can_sneak && _owner == NULL) {
@@ -959,6 +966,9 @@ void Monitor::lock_without_safepoint_check (Thread * Self) {
   ILock (Self) ;
   assert (_owner == NULL, "invariant");
   set_owner (Self);
+  if (MutexContentionStatistics) {
+    record_acquire(0);
+  }
 }
 
 void Monitor::lock_without_safepoint_check () {
@@ -988,6 +998,9 @@ bool Monitor::try_lock() {
     // We got the lock
     assert (_owner == NULL, "invariant");
     set_owner (Self);
+    if (MutexContentionStatistics) {
+      record_acquire(0);
+    }
     return true;
   }
   return false;
@@ -1002,9 +1015,40 @@ void Monitor::unlock() {
     _snuck = false;
     return ;
   }
+  if (MutexContentionStatistics) {
+    record_release();
+  }
   IUnlock (false) ;
 }
 
+void Monitor::record_acquire(jlong contended_start) {
+  jlong now = os::javaTimeNanos();
+  _acquire_count++;
+  if (contended_start != 0) {
+    _contended_count++;
+    _contended_wait_nanos += now - contended_start;
+  }
+  _acquired_at = now;
+}
+
+void Monitor::record_release() {
+  // The flag may have been turned on while the lock was held
+  if (_acquired_at != 0) {
+    _hold_nanos += os::javaTimeNanos() - _acquired_at;
+    _acquired_at = 0;
+  }
+}
+
+void Monitor::print_statistics_on(outputStream* st) const {
+  if (_acquire_count == 0) {
+    return;
+  }
+  st->print_cr("%-32s %12ld %12ld %12.3f %12.3f", _name,
+               (long)_acquire_count, (long)_contended_count,
+               (double)_contended_wait_nanos / NANOSECS_PER_MILLISEC,
+               (double)_hold_nanos / NANOSECS_PER_MILLISEC);
+}
+
 // Yet another degenerate version of Monitor::lock() or lock_without_safepoint_check()
 // jvm_raw_lock() and _unlock() can be called by non-Java threads via JVM_RawMonitorEnter.
 //
@@ -1104,6 +1148,10 @@ bool Monitor::wait(bool no_safepoint_check, long timeout, bool as_suspend_equiva
   #endif // ASSERT
 
   int wait_status ;
+  // The time spent waiting does not count as hold time
+  if (MutexContentionStatistics) {
+    record_release();
+  }
   // conceptually set the owner to NULL in anticipation of
   // abdicating the lock in wait
   set_owner(NULL);
@@ -1144,6 +1192,9 @@ bool Monitor::wait(bool no_safepoint_check, long timeout, bool as_suspend_equiva
   assert (ILocked(), "invariant") ;
   assert (_owner == NULL, "invariant") ;
   set_owner (Self) ;
+  if (MutexContentionStatistics) {
+    _acquired_at = os::javaTimeNanos();
+  }
   return wait_status != 0 ;          // return true IFF timeout
 }
 
@@ -1165,6 +1216,11 @@ void Monitor::ClearMonitor (Monitor * m, const char *name) {
   m->_OnDeck            = NULL ;
   m->_WaitSet           = NULL ;
   m->_WaitLock[0]       = 0 ;
+  m->_acquire_count        = 0 ;
+  m->_contended_count      = 0 ;
+  m->_contended_wait_nanos = 0 ;
+  m->_hold_nanos           = 0 ;
+  m->_acquired_at          = 0 ;
 }
 
 Monitor::Monitor() { ClearMonitor(this); }
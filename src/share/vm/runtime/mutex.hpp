@@ -131,6 +131,17 @@ class Monitor : public CHeapObj<mtInternal> {
   int NotifyCount ;                      // diagnostic assist
   char _name[MONITOR_NAME_LEN];          // Name of mutex
 
+  // Contention statistics, see MutexContentionStatistics. Only updated
+  // by the owner while it holds the lock.
+  jlong _acquire_count;
+  jlong _contended_count;                // acquisitions that had to wait
+  jlong _contended_wait_nanos;
+  jlong _hold_nanos;
+  jlong _acquired_at;                    // os::javaTimeNanos() of acquisition, or 0
+
+  void record_acquire(jlong contended_start);
+  void record_release();
+
   // Debugging fields for naming, deadlock detection, etc. (some only used in debug mode)
 #ifndef PRODUCT
   bool      _allow_vm_block;
@@ -213,6 +224,8 @@ class Monitor : public CHeapObj<mtInternal> {
   const char *name() const                  { return _name; }
 
   void print_on_error(outputStream* st) const;
+  // Prints the contention statistics if the lock has been acquired
+  void print_statistics_on(outputStream* st) const;
 
   #ifndef PRODUCT
     void print_on(outputStream* st) const;
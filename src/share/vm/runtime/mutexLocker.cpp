@@ -47,6 +47,8 @@ Mutex*   JNIGlobalHandle_lock         = NULL;
 Mutex*   JNIHandleBlockFreeList_lock  = NULL;
 Mutex*   MemberNameTable_lock         = NULL;
 Mutex*   JmethodIdCreation_lock       = NULL;
+Mutex*   CPUProfiler_lock             = NULL;
+Mutex*   ContentionProfiler_lock      = NULL;
 Mutex*   JfieldIdCreation_lock        = NULL;
 Monitor* JNICritical_lock             = NULL;
 Mutex*   JvmtiThreadState_lock        = NULL;
@@ -132,6 +134,7 @@ Monitor* JfrMsg_lock                  = NULL;
 Mutex*   JfrBuffer_lock               = NULL;
 Mutex*   JfrStream_lock               = NULL;
 Mutex*   JfrThreadGroups_lock         = NULL;
+Mutex*   TraceRecorder_lock           = NULL;
 #endif
 
 #ifndef SUPPORTS_NATIVE_CX8
@@ -215,6 +218,8 @@ void mutex_init() {
   def(ObjAllocPost_lock            , Monitor, special,     false);
   def(Service_lock                 , Monitor, special,     true ); // used for service thread operations
   def(JmethodIdCreation_lock       , Mutex  , leaf,        true ); // used for creating jmethodIDs.
+  def(CPUProfiler_lock             , Mutex  , leaf,        true ); // used for CPU profiler samples
+  def(ContentionProfiler_lock      , Mutex  , leaf,        true ); // used for monitor contention samples
 
   def(SystemDictionary_lock        , Monitor, leaf,        true ); // lookups done by VM thread
   def(PackageTable_lock            , Mutex  , leaf,        false);
@@ -286,6 +291,7 @@ void mutex_init() {
   def(JfrThreadGroups_lock         , Mutex,   leaf,        true);
   def(JfrStream_lock               , Mutex,   nonleaf,     true);
   def(JfrStacktrace_lock           , Mutex,   special,     true);
+  def(TraceRecorder_lock           , Mutex,   leaf,        true);
 #endif
 
 #ifndef SUPPORTS_NATIVE_CX8
@@ -322,3 +328,15 @@ void print_owned_locks_on_error(outputStream* st) {
   }
   if (none) st->print_cr("None");
 }
+
+void print_mutex_statistics(outputStream* st) {
+  if (!MutexContentionStatistics) {
+    st->print_cr("Mutex statistics are not recorded, use -XX:+UnlockDiagnosticVMOptions -XX:+MutexContentionStatistics");
+    return;
+  }
+  st->print_cr("%-32s %12s %12s %12s %12s", "Mutex", "Acquired", "Contended",
+               "Wait (ms)", "Hold (ms)");
+  for (int i = 0; i < _num_mutex; i++) {
+    _mutex_array[i]->print_statistics_on(st);
+  }
+}
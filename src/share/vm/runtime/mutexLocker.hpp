@@ -55,6 +55,8 @@ extern Mutex*   JNIGlobalHandle_lock;            // a lock on creating JNI globa
 extern Mutex*   JNIHandleBlockFreeList_lock;     // a lock on the JNI handle block free list
 extern Mutex*   MemberNameTable_lock;            // a lock on the MemberNameTable updates
 extern Mutex*   JmethodIdCreation_lock;          // a lock on creating JNI method identifiers
+extern Mutex*   CPUProfiler_lock;                // a lock on the CPU profiler buffers and stack table
+extern Mutex*   ContentionProfiler_lock;         // a lock on the monitor contention tables
 extern Mutex*   JfieldIdCreation_lock;           // a lock on creating JNI static field identifiers
 extern Monitor* JNICritical_lock;                // a lock used while entering and exiting JNI critical regions, allows GC to sometimes get in
 extern Mutex*   JvmtiThreadState_lock;           // a lock on modification of JVMTI thread data
@@ -148,6 +150,7 @@ extern Monitor* JfrMsg_lock;                     // protects JFR messaging
 extern Mutex*   JfrBuffer_lock;                  // protects JFR buffer operations
 extern Mutex*   JfrStream_lock;                  // protects JFR stream access
 extern Mutex*   JfrThreadGroups_lock;            // protects JFR access to Thread Groups
+extern Mutex*   TraceRecorder_lock;              // protects the trace recording file
 #endif
 
 #ifndef SUPPORTS_NATIVE_CX8
@@ -172,6 +175,10 @@ extern Mutex*   UnsafeJlong_lock;                // provides Unsafe atomic updat
 // by fatal error handler.
 void print_owned_locks_on_error(outputStream* st);
 
+// Print the contention statistics of all named mutexes/monitors; see
+// MutexContentionStatistics.
+void print_mutex_statistics(outputStream* st);
+
 char *lock_name(Mutex *mutex);
 
 class MutexLocker: StackObj {
@@ -36,6 +36,7 @@
 #include "runtime/osThread.hpp"
 #include "runtime/stubRoutines.hpp"
 #include "runtime/thread.inline.hpp"
+#include "services/contentionProfiler.hpp"
 #include "services/threadService.hpp"
 #include "trace/tracing.hpp"
 #include "trace/traceMacros.hpp"
@@ -378,6 +379,15 @@ void ATTR ObjectMonitor::enter(TRAPS) {
 
   EventJavaMonitorEnter event;
 
+  ContentionStack* sampled_stack = NULL;
+  jlong blocked_start = 0;
+  if (ContentionProfiler::should_sample()) {
+    sampled_stack = new ContentionStack();
+    sampled_stack->fill(jt);
+    _contention_sampled = 1;
+    blocked_start = os::javaTimeNanos();
+  }
+
   { // Change java thread status to indicate blocked on monitor enter.
     JavaThreadBlockedOnMonitorEnterState jtbmes(jt, this);
 
@@ -431,6 +441,11 @@ void ATTR ObjectMonitor::enter(TRAPS) {
     // acquire it.
   }
 
+  if (sampled_stack != NULL) {
+    ContentionProfiler::record_enter(this, sampled_stack, os::javaTimeNanos() - blocked_start);
+    delete sampled_stack;
+  }
+
   Atomic::dec_ptr(&_count);
   assert (_count >= 0, "invariant") ;
   Self->_Stalled = 0 ;
@@ -996,6 +1011,11 @@ void ATTR ObjectMonitor::exit(bool not_suspended, TRAPS) {
    }
 #endif
 
+   if (_contention_sampled != 0 && not_suspended && Self->is_Java_thread()) {
+     _contention_sampled = 0;
+     ContentionProfiler::record_exit(this, (JavaThread*)Self);
+   }
+
    for (;;) {
       assert (THREAD == _owner, "invariant") ;
 
@@ -1695,6 +1715,7 @@ void ObjectMonitor::notify(TRAPS) {
   CHECK_OWNER();
   if (_WaitSet == NULL) {
      TEVENT (Empty-Notify) ;
+     OM_PERFDATA_OP(EmptyNotifications, inc());
      return ;
   }
   DTRACE_MONITOR_PROBE(notify, this, object(), THREAD);
@@ -1815,6 +1836,7 @@ void ObjectMonitor::notifyAll(TRAPS) {
   ObjectWaiter* iterator;
   if (_WaitSet == NULL) {
       TEVENT (Empty-NotifyAll) ;
+      OM_PERFDATA_OP(EmptyNotifications, inc());
       return ;
   }
   DTRACE_MONITOR_PROBE(notifyAll, this, object(), THREAD);
@@ -2017,6 +2039,7 @@ int ObjectMonitor::TrySpin_VaryDuration (Thread * Self) {
            if (x < Knob_Poverty) x = Knob_Poverty ;
            _SpinDuration = x + Knob_BonusB ;
         }
+        OM_PERFDATA_OP(SuccessfulSpins, inc());
         return 1 ;
       }
       SpinPause () ;
@@ -2155,6 +2178,7 @@ int ObjectMonitor::TrySpin_VaryDuration (Thread * Self) {
                 if (x < Knob_Poverty) x = Knob_Poverty ;
                 _SpinDuration = x + Knob_Bonus ;
             }
+            OM_PERFDATA_OP(SuccessfulSpins, inc());
             return 1 ;
          }
 
@@ -2195,6 +2219,7 @@ int ObjectMonitor::TrySpin_VaryDuration (Thread * Self) {
    // TODO: Use an AIMD-like policy to adjust _SpinDuration.
    // AIMD is globally stable.
    TEVENT (Spin failure) ;
+   OM_PERFDATA_OP(FailedSpins, inc());
    {
      int x = _SpinDuration ;
      if (x > 0) {
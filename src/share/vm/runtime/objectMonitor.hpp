@@ -159,6 +159,7 @@ class ObjectMonitor {
     _SpinClock    = 0 ;
     OwnerIsThread = 0 ;
     _previous_owner_tid = 0;
+    _contention_sampled = 0;
   }
 
   ~ObjectMonitor() {
@@ -182,6 +183,7 @@ private:
     _SpinFreq      = 0 ;
     _SpinClock     = 0 ;
     OwnerIsThread  = 0 ;
+    _contention_sampled = 0 ;
   }
 
 public:
@@ -253,6 +255,7 @@ public:
  protected:                         // protected for jvmtiRawMonitor
   void *  volatile _owner;          // pointer to owning thread OR BasicLock
   volatile jlong _previous_owner_tid; // thread id of the previous owner of the monitor
+  volatile jint  _contention_sampled; // a waiter sampled by the ContentionProfiler blocks
   volatile intptr_t  _recursions;   // recursion count, 0 for first entry
  private:
   int OwnerIsThread ;               // _owner is (Thread *) vs SP/BasicLock
@@ -333,6 +333,13 @@ class os: AllStatic {
   static bool   uncommit_memory(char* addr, size_t bytes);
   static bool   release_memory(char* addr, size_t bytes);
 
+  // Create an unlinked temporary file in dir to back the Java heap.
+  // Returns the file descriptor, or -1 on failure.
+  static int    create_file_for_heap(const char* dir);
+  // Replace the reserved range [base, base + size) with a shared mapping
+  // of fd, allocating file space for all of it. Returns base, or NULL.
+  static char*  replace_existing_mapping_with_file_mapping(char* base, size_t size, int fd);
+
   // Touch memory pages that cover the memory range from start to end (exclusive)
   // to make the OS back the memory range with actual memory.
   // Current implementation may not touch the last page if unaligned addresses
@@ -359,6 +366,11 @@ class os: AllStatic {
   static void   free_memory(char *addr, size_t bytes, size_t alignment_hint);
   static void   realign_memory(char *addr, size_t bytes, size_t alignment_hint);
 
+  // Sets resident to the number of bytes of the committed, page aligned
+  // range that are backed by physical memory. Returns false if that is
+  // not known on this platform.
+  static bool   resident_memory_size(char* addr, size_t bytes, size_t* resident);
+
   // NUMA-specific interface
   static bool   numa_has_static_binding();
   static bool   numa_has_group_homing();
@@ -386,6 +398,8 @@ class os: AllStatic {
   static size_t large_page_size();
   static bool   can_commit_large_page_memory();
   static bool   can_execute_large_page_memory();
+  // Huge page size backing the code cache independently of UseLargePages, or 0
+  static size_t code_cache_large_page_size();
 
   // OS interface to polling page
   static address get_polling_page()             { return _polling_page; }
@@ -24,6 +24,7 @@
 
 #include "precompiled.hpp"
 #include "classfile/vmSymbols.hpp"
+#include "memory/resourceArea.hpp"
 #include "oops/oop.inline.hpp"
 #include "runtime/handles.inline.hpp"
 #include "runtime/java.hpp"
@@ -273,6 +274,17 @@ PerfStringConstant::PerfStringConstant(CounterNS ns, const char* namep,
 }
 
 
+PerfHistogram::PerfHistogram(jlong unit, int num_buckets)
+  : _unit(unit), _num_buckets(num_buckets), _count(NULL), _sum(NULL) {
+  for (int i = 0; i < max_buckets; i++) {
+    _buckets[i] = NULL;
+  }
+}
+
+jlong PerfHistogram::ticks_unit(jlong micros) {
+  return MAX2((jlong)1, os::elapsed_frequency() * micros / 1000000);
+}
+
 void PerfDataManager::destroy() {
 
   if (_all == NULL)
@@ -622,3 +634,29 @@ PerfDataList* PerfDataList::clone() {
 
   return copy;
 }
+
+PerfHistogram* PerfDataManager::create_histogram(CounterNS ns,
+                                                 const char* name,
+                                                 PerfData::Units u,
+                                                 jlong unit, int num_buckets,
+                                                 TRAPS) {
+  assert(unit > 0, "must have a unit");
+  assert(num_buckets >= 2 && num_buckets <= PerfHistogram::max_buckets,
+         "bad number of buckets");
+  ResourceMark rm;
+  PerfHistogram* h = new PerfHistogram(unit, num_buckets);
+
+  create_long_constant(ns, counter_name(name, "unit"), u, unit, CHECK_NULL);
+  h->_count = create_long_counter(ns, counter_name(name, "count"),
+                                  PerfData::U_Events, (jlong)0, CHECK_NULL);
+  h->_sum = create_long_counter(ns, counter_name(name, "sum"), u,
+                                (jlong)0, CHECK_NULL);
+  for (int i = 0; i < num_buckets; i++) {
+    char bucket[16];
+    jio_snprintf(bucket, sizeof(bucket), "bucket.%d", i);
+    h->_buckets[i] = create_long_counter(ns, counter_name(name, bucket),
+                                         PerfData::U_Events, (jlong)0,
+                                         CHECK_NULL);
+  }
+  return h;
+}
@@ -105,6 +105,9 @@ enum CounterNS {
  *             - PerfStringVariable
  *             - PerfStringConstant
  *
+ * Distributions are kept by the PerfHistogram class, which is not a
+ * PerfData subtype but a group of PerfLongCounter buckets.
+ *
  *
  * As seen in the class hierarchy, the initially supported types are:
  *
@@ -654,6 +657,8 @@ class PerfDataList : public CHeapObj<mtInternal> {
 };
 
 
+class PerfHistogram;
+
 /*
  * The PerfDataManager class is responsible for creating PerfData
  * subtypes via a set a factory methods and for managing lists
@@ -869,6 +874,11 @@ class PerfDataManager : AllStatic {
       return create_long_counter(ns, name, u, sh, CHECK_NULL);
     }
 
+    // Histogram of values in u, with num_buckets buckets starting at unit
+    static PerfHistogram* create_histogram(CounterNS ns, const char* name,
+                                           PerfData::Units u, jlong unit,
+                                           int num_buckets, TRAPS);
+
     static void destroy();
     static bool has_PerfData() { return _has_PerfData; }
 };
@@ -886,6 +896,54 @@ class PerfDataManager : AllStatic {
   {counter = PerfDataManager::create_counter(counter_ns, counter_name, \
                                              PerfData::U_Bytes,CHECK);}
 
+/*
+ * The PerfHistogram class keeps a distribution of values, such as pause
+ * times, in the PerfData memory region. The buckets grow by powers of two
+ * in the fashion of HdrHistogram: bucket 0 counts the values below the
+ * unit, bucket i the values in [unit << (i - 1), unit << i) and the last
+ * bucket everything above. Each bucket is a counter of its own, named
+ * <name>.bucket.<i>, next to <name>.unit, <name>.count and <name>.sum, so
+ * external readers of the PerfData file see the histogram without the VM
+ * serializing anything. Like the other counters, the buckets are not
+ * updated atomically, so concurrent recorders may lose an update.
+ *
+ * The histograms are only created with -XX:+PerfDataHistograms.
+ */
+class PerfHistogram : public CHeapObj<mtInternal> {
+
+  friend class PerfDataManager; // for access to protected constructor
+
+  public:
+    enum { max_buckets = 32 };
+
+  private:
+    jlong            _unit;
+    int              _num_buckets;
+    PerfLongCounter* _count;
+    PerfLongCounter* _sum;
+    PerfLongCounter* _buckets[max_buckets];
+
+  protected:
+    PerfHistogram(jlong unit, int num_buckets);
+
+  public:
+    // The unit for a histogram of elapsed ticks with the given resolution
+    static jlong ticks_unit(jlong micros);
+
+    int bucket_for(jlong value) const {
+      if (value < _unit) {
+        return 0;
+      }
+      return MIN2(log2_long(value / _unit) + 1, _num_buckets - 1);
+    }
+
+    void record(jlong value) {
+      _buckets[bucket_for(value)]->inc();
+      _count->inc();
+      _sum->inc(value);
+    }
+};
+
 // Utility Classes
 
 /*
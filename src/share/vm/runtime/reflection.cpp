@@ -933,28 +933,40 @@ oop Reflection::invoke(instanceKlassHandle klass, methodHandle reflected_method,
     } else {
       // resolve based on the receiver
       if (reflected_method->method_holder()->is_interface()) {
-        // resolve interface call
-        if (ReflectionWrapResolutionErrors) {
-          // new default: 6531596
-          // Match resolution errors with those thrown due to reflection inlining
-          // Linktime resolution & IllegalAccessCheck already done by Class.getMethod()
-          method = resolve_interface_call(klass, reflected_method, target_klass, receiver, THREAD);
-          if (HAS_PENDING_EXCEPTION) {
-          // Method resolution threw an exception; wrap it in an InvocationTargetException
-            oop resolution_exception = PENDING_EXCEPTION;
-            CLEAR_PENDING_EXCEPTION;
-            // JVMTI has already reported the pending exception
-            // JVMTI internal flag reset is needed in order to report InvocationTargetException
-            if (THREAD->is_Java_thread()) {
-              JvmtiExport::clear_detected_exception((JavaThread*) THREAD);
+        // Fast path: select straight from the receiver's itable, the same
+        // way invokeinterface does. Empty, non-public (IllegalAccessError
+        // stub) or abstract entries fall through to the full resolution
+        // below so that the resulting exceptions are unchanged.
+        if (reflected_method->has_itable_index() && target_klass->oop_is_instance()) {
+          Method* selected = InstanceKlass::cast(target_klass())->method_at_itable_or_null(
+                               reflected_method->method_holder(), reflected_method->itable_index());
+          if (selected != NULL && selected->is_public() && !selected->is_abstract()) {
+            method = methodHandle(THREAD, selected);
+          }
+        }
+        if (method.is_null()) {
+          if (ReflectionWrapResolutionErrors) {
+            // new default: 6531596
+            // Match resolution errors with those thrown due to reflection inlining
+            // Linktime resolution & IllegalAccessCheck already done by Class.getMethod()
+            method = resolve_interface_call(klass, reflected_method, target_klass, receiver, THREAD);
+            if (HAS_PENDING_EXCEPTION) {
+            // Method resolution threw an exception; wrap it in an InvocationTargetException
+              oop resolution_exception = PENDING_EXCEPTION;
+              CLEAR_PENDING_EXCEPTION;
+              // JVMTI has already reported the pending exception
+              // JVMTI internal flag reset is needed in order to report InvocationTargetException
+              if (THREAD->is_Java_thread()) {
+                JvmtiExport::clear_detected_exception((JavaThread*) THREAD);
+              }
+              JavaCallArguments args(Handle(THREAD, resolution_exception));
+              THROW_ARG_0(vmSymbols::java_lang_reflect_InvocationTargetException(),
+                  vmSymbols::throwable_void_signature(),
+                  &args);
             }
-            JavaCallArguments args(Handle(THREAD, resolution_exception));
-            THROW_ARG_0(vmSymbols::java_lang_reflect_InvocationTargetException(),
-                vmSymbols::throwable_void_signature(),
-                &args);
+          } else {
+            method = resolve_interface_call(klass, reflected_method, target_klass, receiver, CHECK_(NULL));
           }
-        } else {
-          method = resolve_interface_call(klass, reflected_method, target_klass, receiver, CHECK_(NULL));
         }
       }  else {
         // if the method can be overridden, we resolve using the vtable index.
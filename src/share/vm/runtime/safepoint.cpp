@@ -33,6 +33,7 @@
 #include "gc_interface/collectedHeap.hpp"
 #include "interpreter/interpreter.hpp"
 #include "memory/resourceArea.hpp"
+#include "memory/sharedHeap.hpp"
 #include "memory/universe.inline.hpp"
 #include "oops/oop.inline.hpp"
 #include "oops/symbol.hpp"
@@ -50,9 +51,12 @@
 #include "runtime/sweeper.hpp"
 #include "runtime/synchronizer.hpp"
 #include "runtime/thread.inline.hpp"
+#include "runtime/vframe.hpp"
 #include "services/runtimeService.hpp"
+#include "trace/tracing.hpp"
 #include "utilities/events.hpp"
 #include "utilities/macros.hpp"
+#include "utilities/workgroup.hpp"
 #ifdef TARGET_ARCH_x86
 # include "nativeInst_x86.hpp"
 # include "vmreg_x86.inline.hpp"
@@ -88,6 +92,8 @@ PRAGMA_FORMAT_MUTE_WARNINGS_FOR_GCC
 
 SafepointSynchronize::SynchronizeState volatile SafepointSynchronize::_state = SafepointSynchronize::_not_synchronized;
 volatile int  SafepointSynchronize::_waiting_to_block = 0;
+JavaThread*   SafepointSynchronize::_last_to_block = NULL;
+const char*   SafepointSynchronize::_guaranteed_cause = NULL;
 volatile int SafepointSynchronize::_safepoint_counter = 0;
 int SafepointSynchronize::_current_jni_active_count = 0;
 long  SafepointSynchronize::_end_of_last_safepoint = 0;
@@ -137,8 +143,10 @@ void SafepointSynchronize::begin() {
 
   // Set number of threads to wait for, before we initiate the callbacks
   _waiting_to_block = nof_threads;
+  _last_to_block    = NULL;
   TryingToBlock     = 0 ;
   int still_running = nof_threads;
+  jlong sync_start_time = os::javaTimeNanos();
 
   // Save the starting time, so that it can be compared to see if this has taken
   // too long to complete.
@@ -385,14 +393,14 @@ void SafepointSynchronize::begin() {
   GC_locker::set_jni_lock_count(_current_jni_active_count);
 
   if (TraceSafepoint) {
-    VM_Operation *op = VMThread::vm_operation();
-    tty->print_cr("Entering safepoint region: %s", (op != NULL) ? op->name() : "no vm operation");
+    tty->print_cr("Entering safepoint region: %s", safepoint_name());
   }
 
   RuntimeService::record_safepoint_synchronized();
   if (PrintSafepointStatistics) {
     update_statistics_on_sync_end(os::javaTimeNanos());
   }
+  report_last_to_block(os::javaTimeNanos() - sync_start_time);
 
   // Call stuff that needs to be run when a safepoint is just about to be completed
   do_cleanup_tasks();
@@ -496,45 +504,195 @@ void SafepointSynchronize::end() {
   _end_of_last_safepoint = os::javaTimeMillis();
 }
 
-bool SafepointSynchronize::is_cleanup_needed() {
+// Each cleanup task answers for itself.  Tasks that can be done without a
+// safepoint (counter decay with -XX:+ConcurrentCounterDecay) or that can
+// wait for whatever VM operation comes next (monitor deflation, counter
+// decay at safepoints) do not force one.
+const char* SafepointSynchronize::cleanup_needed_cause() {
   // Need a safepoint if some inline cache buffers is non-empty
-  if (!InlineCacheBuffer::is_empty()) return true;
-  return false;
+  if (!InlineCacheBuffer::is_empty()) return "updating inline caches";
+  if (SymbolTable::needs_rehashing()) return "rehashing symbol table";
+  if (StringTable::needs_rehashing()) return "rehashing string table";
+  if (SymbolTable::needs_resizing())  return "resizing symbol table";
+  if (StringTable::needs_resizing())  return "resizing string table";
+  if (ClassLoaderDataGraph::should_purge()) return "purging class loader data graph";
+  return NULL;
 }
 
+void SafepointSynchronize::guaranteed_safepoint(const char* cause) {
+  assert(Thread::current()->is_VM_thread(), "only VM thread may force a safepoint");
+  if (PrintGuaranteedSafepoints) {
+    tty->print_cr("Guaranteed safepoint after %ld ms without one, requested by: %s",
+                  last_non_safepoint_interval(), cause);
+  }
+  _guaranteed_cause = cause;
+  begin();
+#ifdef ASSERT
+  if (GCALotAtAllSafepoints) InterfaceSupport::check_gc_alot();
+#endif
+  end();
+  _guaranteed_cause = NULL;
+}
+
+const char* SafepointSynchronize::safepoint_name() {
+  VM_Operation* op = VMThread::vm_operation();
+  if (op != NULL) {
+    return op->name();
+  }
+  return _guaranteed_cause != NULL ? _guaranteed_cause : "no vm operation";
+}
 
 
-// Various cleaning tasks that should be done periodically at safepoints
-void SafepointSynchronize::do_cleanup_tasks() {
-  {
-    TraceTime t1("deflating idle monitors", TraceSafepointCleanupTime);
-    ObjectSynchronizer::deflate_idle_monitors();
+
+// The cleanup subtasks that are independent of each other.  They are
+// claimed one at a time by the workers of the GC gang, or all run on the
+// VM thread when no gang is available.  Each subtask is timed separately
+// and the timings are printed by the VM thread once all of them are done,
+// so that the -XX:+TraceSafepointCleanupTime output does not interleave.
+class SafepointCleanupTask : public AbstractGangTask {
+ public:
+  enum SafepointCleanupTasks {
+    SAFEPOINT_CLEANUP_DEFLATE_MONITORS,
+    SAFEPOINT_CLEANUP_UPDATE_INLINE_CACHES,
+    SAFEPOINT_CLEANUP_COMPILATION_POLICY,
+    SAFEPOINT_CLEANUP_SYMBOL_TABLE,
+    SAFEPOINT_CLEANUP_STRING_TABLE,
+    // Leave this one last.
+    SAFEPOINT_CLEANUP_NUM_TASKS
+  };
+
+ private:
+  SubTasksDone _subtasks;
+  bool         _deflate_monitors;
+  elapsedTimer _timers[SAFEPOINT_CLEANUP_NUM_TASKS];
+  bool         _done[SAFEPOINT_CLEANUP_NUM_TASKS];
+
+  static const char* task_name(uint t) {
+    switch (t) {
+      case SAFEPOINT_CLEANUP_DEFLATE_MONITORS:      return "deflating idle monitors";
+      case SAFEPOINT_CLEANUP_UPDATE_INLINE_CACHES:  return "updating inline caches";
+      case SAFEPOINT_CLEANUP_COMPILATION_POLICY:    return "compilation policy safepoint handler";
+      case SAFEPOINT_CLEANUP_SYMBOL_TABLE:          return "rehashing/resizing symbol table";
+      case SAFEPOINT_CLEANUP_STRING_TABLE:          return "rehashing/resizing string table";
+      default: ShouldNotReachHere();                return NULL;
+    }
   }
 
-  {
-    TraceTime t2("updating inline caches", TraceSafepointCleanupTime);
-    InlineCacheBuffer::update_inline_caches();
+  // Returns true if the subtask did any work.
+  bool do_task(uint t) {
+    switch (t) {
+      case SAFEPOINT_CLEANUP_DEFLATE_MONITORS:
+        if (!_deflate_monitors) return false;
+        ObjectSynchronizer::deflate_idle_monitors();
+        return true;
+      case SAFEPOINT_CLEANUP_UPDATE_INLINE_CACHES:
+        InlineCacheBuffer::update_inline_caches();
+        return true;
+      case SAFEPOINT_CLEANUP_COMPILATION_POLICY:
+        CompilationPolicy::policy()->do_safepoint_work();
+        return true;
+      case SAFEPOINT_CLEANUP_SYMBOL_TABLE: {
+        bool worked = false;
+        if (SymbolTable::needs_rehashing()) {
+          SymbolTable::rehash_table();
+          worked = true;
+        }
+        if (SymbolTable::needs_resizing()) {
+          SymbolTable::resize_table();
+          worked = true;
+        }
+        return worked;
+      }
+      case SAFEPOINT_CLEANUP_STRING_TABLE: {
+        bool worked = false;
+        if (StringTable::needs_rehashing()) {
+          StringTable::rehash_table();
+          worked = true;
+        }
+        if (StringTable::needs_resizing()) {
+          StringTable::resize_table();
+          worked = true;
+        }
+        return worked;
+      }
+      default:
+        ShouldNotReachHere();
+        return false;
+    }
   }
-  {
-    TraceTime t3("compilation policy safepoint handler", TraceSafepointCleanupTime);
-    CompilationPolicy::policy()->do_safepoint_work();
+
+ public:
+  SafepointCleanupTask(uint n_workers) :
+    AbstractGangTask("Safepoint Cleanup"),
+    _subtasks(SAFEPOINT_CLEANUP_NUM_TASKS),
+    // Decided once, on the VM thread, since the check updates the
+    // time of the last deflation.
+    _deflate_monitors(ObjectSynchronizer::should_deflate_idle_monitors()) {
+    _subtasks.set_n_threads(n_workers);
+    for (uint t = 0; t < SAFEPOINT_CLEANUP_NUM_TASKS; t++) {
+      _done[t] = false;
+    }
   }
 
-  {
-    TraceTime t4("mark nmethods", TraceSafepointCleanupTime);
-    NMethodSweeper::mark_active_nmethods();
+  void work(uint worker_id) {
+    for (uint t = 0; t < SAFEPOINT_CLEANUP_NUM_TASKS; t++) {
+      if (!_subtasks.is_task_claimed(t)) {
+        _timers[t].start();
+        _done[t] = do_task(t);
+        _timers[t].stop();
+      }
+    }
+    _subtasks.all_tasks_completed();
+  }
+
+  void print_timings_on(outputStream* st) const {
+    for (uint t = 0; t < SAFEPOINT_CLEANUP_NUM_TASKS; t++) {
+      if (_done[t]) {
+        st->stamp(PrintGCTimeStamps);
+        st->print_cr("[%s, %3.7f secs]", task_name(t), _timers[t].seconds());
+      }
+    }
   }
+};
 
-  if (SymbolTable::needs_rehashing()) {
-    TraceTime t5("rehashing symbol table", TraceSafepointCleanupTime);
-    SymbolTable::rehash_table();
+// The gang used to run the safepoint cleanup subtasks in parallel, or
+// NULL if they should run on the VM thread.  Only the heaps built on
+// SharedHeap have a work gang that is idle at this point.
+static FlexibleWorkGang* safepoint_cleanup_workers() {
+  if (!ParallelSafepointCleanup) {
+    return NULL;
+  }
+  CollectedHeap* heap = Universe::heap();
+  if (heap == NULL || heap->kind() == CollectedHeap::ParallelScavengeHeap ||
+      heap->kind() == CollectedHeap::EpsilonHeap) {
+    return NULL;
   }
+  FlexibleWorkGang* workers = SharedHeap::heap()->workers();
+  if (workers == NULL || workers->active_workers() <= 1) {
+    return NULL;
+  }
+  return workers;
+}
 
-  if (StringTable::needs_rehashing()) {
-    TraceTime t6("rehashing string table", TraceSafepointCleanupTime);
-    StringTable::rehash_table();
+// Various cleaning tasks that should be done periodically at safepoints
+void SafepointSynchronize::do_cleanup_tasks() {
+  FlexibleWorkGang* workers = safepoint_cleanup_workers();
+  {
+    SafepointCleanupTask cleanup(workers != NULL ? workers->active_workers() : 1);
+    if (workers != NULL) {
+      workers->run_task(&cleanup);
+    } else {
+      cleanup.work(0);
+    }
+    if (TraceSafepointCleanupTime) {
+      cleanup.print_timings_on(tty);
+    }
   }
 
+  // The remaining tasks stay on the VM thread: purging the class loader
+  // data graph frees metadata that the compilation policy handler may be
+  // walking, and log rotation must not race with the timings above.
+
   // rotate log files?
   if (UseGCLogFileRotation) {
     gclog_or_tty->rotate_log(false);
@@ -646,6 +804,7 @@ void SafepointSynchronize::block(JavaThread *thread) {
         // Decrement the number of threads to wait for and signal vm thread
         assert(_waiting_to_block > 0, "sanity check");
         _waiting_to_block--;
+        _last_to_block = thread;
         thread->safepoint_state()->set_has_called_back(true);
 
         DEBUG_ONLY(thread->set_visited_for_critical_count(true));
@@ -759,6 +918,56 @@ void SafepointSynchronize::handle_polling_page_exception(JavaThread *thread) {
 }
 
 
+void SafepointSynchronize::report_last_to_block(jlong sync_time_nanos) {
+  EventSafepointStraggler event;
+  JavaThread* thread = _last_to_block;
+  if (thread == NULL || !(PrintSafepointStraggler || event.should_commit())) {
+    return;
+  }
+
+  // All threads are stopped, so the stack of the straggler can be walked.
+  // Its top frame is where it noticed the safepoint: a poll in compiled
+  // code (e.g. a loop back branch), the interpreter, or a native method
+  // it returned from.
+  ResourceMark rm;
+  Method* method = NULL;
+  int bci = -1;
+  bool compiled = false;
+  if (thread->has_last_Java_frame()) {
+    vframeStream vfst(thread);
+    if (!vfst.at_end()) {
+      method = vfst.method();
+      bci = vfst.bci();
+      compiled = !vfst.is_interpreted_frame() && !method->is_native();
+    }
+  }
+
+  if (PrintSafepointStraggler) {
+    tty->print("Safepoint \"%s\", time to safepoint %.3f ms, last thread to arrive \"%s\"",
+               safepoint_name(),
+               (double)sync_time_nanos / NANOSECS_PER_MILLISEC,
+               thread->get_thread_name());
+    if (method != NULL) {
+      tty->print(" in %s", method->name_and_sig_as_C_string());
+      if (method->is_native()) {
+        tty->print(" (native)");
+      } else {
+        tty->print(" at bci %d (%s)", bci, compiled ? "compiled" : "interpreted");
+      }
+    }
+    tty->cr();
+  }
+
+  if (event.should_commit()) {
+    event.set_straggler(thread->osthread()->thread_id());
+    event.set_method(method);
+    event.set_bci(bci);
+    event.set_compiled(compiled);
+    event.set_timeToSafepoint(sync_time_nanos);
+    event.commit();
+  }
+}
+
 void SafepointSynchronize::print_safepoint_timeout(SafepointTimeoutReason reason) {
   if (!timeout_error_printed) {
     timeout_error_printed = true;
@@ -794,10 +1003,9 @@ void SafepointSynchronize::print_safepoint_timeout(SafepointTimeoutReason reason
   // ShowMessageBoxOnError.
   if (AbortVMOnSafepointTimeout) {
     char msg[1024];
-    VM_Operation *op = VMThread::vm_operation();
     sprintf(msg, "Safepoint sync time longer than " INTX_FORMAT "ms detected when executing %s.",
             SafepointTimeoutDelay,
-            op != NULL ? op->name() : "no vm operation");
+            safepoint_name());
     fatal(msg);
   }
 }
@@ -888,7 +1096,7 @@ void ThreadSafepointState::roll_forward(suspend_type type) {
 
   switch(_type) {
     case _at_safepoint:
-      SafepointSynchronize::signal_thread_at_safepoint();
+      SafepointSynchronize::signal_thread_at_safepoint(_thread);
       DEBUG_ONLY(_thread->set_visited_for_critical_count(true));
       if (_thread->in_critical()) {
         // Notice that this thread is in a critical section
@@ -93,6 +93,8 @@ class SafepointSynchronize : AllStatic {
  private:
   static volatile SynchronizeState _state;     // Threads might read this flag directly, without acquireing the Threads_lock
   static volatile int _waiting_to_block;       // number of threads we are waiting for to block
+  static JavaThread* _last_to_block;           // thread whose arrival completed the synchronization
+  static const char* _guaranteed_cause;        // cleanup task a safepoint without a VM operation was forced for
   static int _current_jni_active_count;        // Counts the number of active critical natives during the safepoint
 
   // This counter is used for fast versions of jni_Get<Primitive>Field.
@@ -129,6 +131,12 @@ private:
   // For debug long safepoint
   static void print_safepoint_timeout(SafepointTimeoutReason timeout_reason);
 
+  // Report the thread that was the last to reach the safepoint,
+  // see PrintSafepointStraggler and the SafepointStraggler event
+  static void report_last_to_block(jlong sync_time_nanos);
+  // The VM operation, or the reason for a guaranteed safepoint
+  static const char* safepoint_name();
+
 public:
 
   // Main entry points
@@ -157,7 +165,10 @@ public:
 
   // Called when a thread volantary blocks
   static void   block(JavaThread *thread);
-  static void   signal_thread_at_safepoint()              { _waiting_to_block--; }
+  static void   signal_thread_at_safepoint(JavaThread* thread) {
+    _waiting_to_block--;
+    _last_to_block = thread;
+  }
 
   // Exception handling for page polling
   static void handle_polling_page_exception(JavaThread *thread);
@@ -169,7 +180,12 @@ public:
   static long end_of_last_safepoint() {
     return _end_of_last_safepoint;
   }
-  static bool is_cleanup_needed();
+  // Returns the name of a cleanup task that cannot wait for the next VM
+  // operation, or NULL if no task needs a safepoint.
+  static const char* cleanup_needed_cause();
+  static bool is_cleanup_needed()                { return cleanup_needed_cause() != NULL; }
+  // Forces a safepoint without a VM operation on behalf of cause.
+  static void guaranteed_safepoint(const char* cause);
   static void do_cleanup_tasks();
 
   // debugging
@@ -23,12 +23,16 @@
  */
 
 #include "precompiled.hpp"
+#include "gc_interface/collectedHeap.hpp"
+#include "memory/universe.hpp"
+#include "runtime/compilationPolicy.hpp"
 #include "runtime/interfaceSupport.hpp"
 #include "runtime/javaCalls.hpp"
 #include "runtime/serviceThread.hpp"
 #include "runtime/mutexLocker.hpp"
 #include "prims/jvmtiImpl.hpp"
 #include "services/allocationContextService.hpp"
+#include "services/cpuProfiler.hpp"
 #include "services/gcNotifier.hpp"
 #include "services/diagnosticArgument.hpp"
 #include "services/diagnosticFramework.hpp"
@@ -88,6 +92,9 @@ void ServiceThread::service_thread_entry(JavaThread* jt, TRAPS) {
     bool has_gc_notification_event = false;
     bool has_dcmd_notification_event = false;
     bool acs_notify = false;
+    bool has_compilation_policy_work = false;
+    bool has_cpu_profiler_samples = false;
+    bool has_periodic_gc_work = false;
     JvmtiDeferredEvent jvmti_event;
     {
       // Need state transition ThreadBlockInVM so that this thread
@@ -105,10 +112,20 @@ void ServiceThread::service_thread_entry(JavaThread* jt, TRAPS) {
              !(has_jvmti_events = JvmtiDeferredEventQueue::has_events()) &&
               !(has_gc_notification_event = GCNotifier::has_event()) &&
               !(has_dcmd_notification_event = DCmdFactory::has_pending_jmx_notification()) &&
-             !(acs_notify = AllocationContextService::should_notify())) {
+             !(acs_notify = AllocationContextService::should_notify()) &&
+             !(has_compilation_policy_work = CompilationPolicy::policy()->needs_concurrent_work()) &&
+             !(has_cpu_profiler_samples = CPUProfiler::has_samples()) &&
+             !(has_periodic_gc_work = Universe::heap()->needs_periodic_collection())) {
         // wait until one of the sensors has pending requests, or there is a
-        // pending JVMTI event or JMX GC notification to post
-        Service_lock->wait(Mutex::_no_safepoint_check_flag);
+        // pending JVMTI event or JMX GC notification to post.  Periodic
+        // compilation policy work (counter decay) and periodic collections
+        // are polled.
+        jlong wait_ms = Universe::heap()->periodic_collection_interval_ms();
+        if (UseCounterDecay && ConcurrentCounterDecay) {
+          wait_ms = (wait_ms == 0) ? (jlong) CounterDecayMinIntervalLength
+                                   : MIN2(wait_ms, (jlong) CounterDecayMinIntervalLength);
+        }
+        Service_lock->wait(Mutex::_no_safepoint_check_flag, (long) wait_ms);
       }
 
       if (has_jvmti_events) {
@@ -135,6 +152,18 @@ void ServiceThread::service_thread_entry(JavaThread* jt, TRAPS) {
     if (acs_notify) {
       AllocationContextService::notify(CHECK);
     }
+
+    if (has_compilation_policy_work) {
+      CompilationPolicy::policy()->do_concurrent_work();
+    }
+
+    if (has_cpu_profiler_samples) {
+      CPUProfiler::process_samples();
+    }
+
+    if (has_periodic_gc_work) {
+      Universe::heap()->do_periodic_collection();
+    }
   }
 }
 
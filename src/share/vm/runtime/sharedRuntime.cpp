@@ -26,6 +26,7 @@
 #include "classfile/systemDictionary.hpp"
 #include "classfile/vmSymbols.hpp"
 #include "code/compiledIC.hpp"
+#include "code/perfMap.hpp"
 #include "code/scopeDesc.hpp"
 #include "code/vtableStubs.hpp"
 #include "compiler/abstractCompiler.hpp"
@@ -1816,6 +1817,42 @@ JRT_ENTRY(void, SharedRuntime::slow_arraycopy_C(oopDesc* src,  jint src_pos,
 }
 JRT_END
 
+// same as Unsafe_SetMemory2, but called directly from compiled code; the
+// compiled caller has already checked that size is not negative.
+JRT_LEAF(void, SharedRuntime::unsafe_set_memory(void* dst, size_t size, jlong value))
+  Copy::fill_to_memory_atomic(dst, size, (jbyte)value);
+JRT_END
+
+// Same algorithm as zlib's adler32(): NMAX is the largest n such that
+// 255n(n+1)/2 + (n+1)(BASE-1) <= 2^32-1, so the modulo reductions can be
+// deferred to once per NMAX bytes.
+JRT_LEAF(jint, SharedRuntime::updateBytesAdler32(jint adler, address buf, jint len))
+  const juint BASE = 65521;
+  const jint  NMAX = 5552;
+  juint s1 = (juint)adler & 0xffff;
+  juint s2 = ((juint)adler >> 16) & 0xffff;
+  while (len > 0) {
+    jint n = MIN2(len, NMAX);
+    len -= n;
+    for (; n >= 8; n -= 8, buf += 8) {
+      s1 += buf[0]; s2 += s1;
+      s1 += buf[1]; s2 += s1;
+      s1 += buf[2]; s2 += s1;
+      s1 += buf[3]; s2 += s1;
+      s1 += buf[4]; s2 += s1;
+      s1 += buf[5]; s2 += s1;
+      s1 += buf[6]; s2 += s1;
+      s1 += buf[7]; s2 += s1;
+    }
+    for (; n > 0; n--, buf++) {
+      s1 += buf[0]; s2 += s1;
+    }
+    s1 %= BASE;
+    s2 %= BASE;
+  }
+  return (jint)((s2 << 16) | s1);
+JRT_END
+
 char* SharedRuntime::generate_class_cast_message(
     JavaThread* thread, const char* objName) {
 
@@ -2531,6 +2568,7 @@ AdapterHandlerEntry* AdapterHandlerLibrary::get_adapter(methodHandle method) {
                  fingerprint->as_string(),
                  new_adapter->content_begin());
     Forte::register_stub(blob_id, new_adapter->content_begin(),new_adapter->content_end());
+    PerfMap::register_stub(blob_id, new_adapter->content_begin(), new_adapter->content_end());
 
     if (JvmtiExport::should_post_dynamic_code_generated()) {
       JvmtiExport::post_dynamic_code_generated(blob_id, new_adapter->content_begin(), new_adapter->content_end());
@@ -508,6 +508,12 @@ class SharedRuntime: AllStatic {
                                oopDesc* dest, jint dest_pos,
                                jint length, JavaThread* thread);
 
+  // Unsafe.setMemory, called directly from compiled code
+  static void unsafe_set_memory(void* dst, size_t size, jlong value);
+
+  // Adler32.updateBytes/updateByteBuffer, called directly from compiled code
+  static jint updateBytesAdler32(jint adler, address buf, jint len);
+
   // handle ic miss with caller being compiled code
   // wrong method handling (inline cache misses, zombie methods)
   static address handle_wrong_method(JavaThread* thread);
@@ -37,6 +37,7 @@
 #include "runtime/os.hpp"
 #include "runtime/sweeper.hpp"
 #include "runtime/thread.inline.hpp"
+#include "runtime/vmThread.hpp"
 #include "runtime/vm_operations.hpp"
 #include "trace/tracing.hpp"
 #include "utilities/events.hpp"
@@ -175,17 +176,6 @@ public:
 };
 static MarkActivationClosure mark_activation_closure;
 
-class SetHotnessClosure: public CodeBlobClosure {
-public:
-  virtual void do_code_blob(CodeBlob* cb) {
-    if (cb->is_nmethod()) {
-      nmethod* nm = (nmethod*)cb;
-      nm->set_hotness_counter(NMethodSweeper::hotness_counter_reset_val());
-    }
-  }
-};
-static SetHotnessClosure set_hotness_closure;
-
 
 int NMethodSweeper::hotness_counter_reset_val() {
   if (_hotness_counter_reset_val == 0) {
@@ -199,7 +189,8 @@ bool NMethodSweeper::sweep_in_progress() {
 
 // Scans the stacks of all Java threads and marks activations of not-entrant methods.
 // No need to synchronize access, since 'mark_active_nmethods' is always executed at a
-// safepoint.
+// safepoint. The sweeper requests the scan (VM_MarkActiveNMethods) once at the start
+// of each sweep rather than having it run as part of every safepoint's cleanup.
 void NMethodSweeper::mark_active_nmethods() {
   assert(SafepointSynchronize::is_at_safepoint(), "must be executed at a safepoint");
   // If we do not want to reclaim not-entrant or zombie methods there is no need
@@ -208,9 +199,6 @@ void NMethodSweeper::mark_active_nmethods() {
     return;
   }
 
-  // Increase time so that we can estimate when to invoke the sweeper again.
-  _time_counter++;
-
   // Check for restart
   assert(CodeCache::find_blob_unsafe(_current) == _current, "Sweeper nmethod cached state invalid");
   if (!sweep_in_progress()) {
@@ -224,14 +212,19 @@ void NMethodSweeper::mark_active_nmethods() {
       tty->print_cr("### Sweep: stack traversal %d", _traversals);
     }
     Threads::nmethods_do(&mark_activation_closure);
-
-  } else {
-    // Only set hotness counter
-    Threads::nmethods_do(&set_hotness_closure);
   }
 
   OrderAccess::storestore();
 }
+
+// Requests a stack scan from the VM thread unless a sweep is already in progress.
+void NMethodSweeper::do_stack_scanning() {
+  assert(!CodeCache_lock->owned_by_self(), "just checking");
+  if (!sweep_in_progress()) {
+    VM_MarkActiveNMethods op;
+    VMThread::execute(&op);
+  }
+}
 /**
  * This function invokes the sweeper if at least one of the three conditions is met:
  *    (1) The code cache is getting full
@@ -241,10 +234,14 @@ void NMethodSweeper::mark_active_nmethods() {
 void NMethodSweeper::possibly_sweep() {
   assert(JavaThread::current()->thread_state() == _thread_in_vm, "must run in vm mode");
   // Only compiler threads are allowed to sweep
-  if (!MethodFlushing || !sweep_in_progress() || !Thread::current()->is_Compiler_thread()) {
+  if (!MethodFlushing || !Thread::current()->is_Compiler_thread()) {
     return;
   }
 
+  // Increase time so that we can estimate when to invoke the sweeper again.
+  // Races between compiler threads only make the estimate less precise.
+  _time_counter++;
+
   // If there was no state change while nmethod sweeping, 'should_sweep' will be false.
   // This is one of the two places where should_sweep can be set to true. The general
   // idea is as follows: If there is enough free space in the code cache, there is no
@@ -261,7 +258,7 @@ void NMethodSweeper::possibly_sweep() {
   // Large ReservedCodeCacheSize :  (e.g., 256M + code cache is 10% full). The formula
   //                                              computes: (256 / 16) - 1 = 15
   //                                              As a result, we invoke the sweeper after
-  //                                              15 invocations of 'mark_active_nmethods.
+  //                                              15 invocations of 'possibly_sweep'.
   // Large ReservedCodeCacheSize:   (e.g., 256M + code Cache is 90% full). The formula
   //                                              computes: (256 / 16) - 10 = 6.
   if (!_should_sweep) {
@@ -279,7 +276,7 @@ void NMethodSweeper::possibly_sweep() {
     }
   }
 
-  if (_should_sweep && _sweep_fractions_left > 0) {
+  if (_should_sweep) {
     // Only one thread at a time will sweep
     jint old = Atomic::cmpxchg( 1, &_sweep_started, 0 );
     if (old != 0) {
@@ -293,6 +290,10 @@ void NMethodSweeper::possibly_sweep() {
     }
 #endif
 
+    // A new sweep starts with a scan of all thread stacks. Only the sweeping
+    // thread requests it, so safepoints do not pay for it.
+    do_stack_scanning();
+
     if (_sweep_fractions_left > 0) {
       sweep_code_cache();
       _sweep_fractions_left--;
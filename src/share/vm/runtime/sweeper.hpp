@@ -33,6 +33,8 @@
 //  1) mark active nmethods
 //     Is done in 'mark_active_nmethods()'. This function is called at a
 //     safepoint and marks all nmethods that are active on a thread's stack.
+//     The sweeper requests it with a VM operation once per sweep, so it is
+//     not part of the regular safepoint cleanup work.
 //  2) sweep nmethods
 //     Is done in sweep_code_cache(). This function is the only place in the
 //     sweeper where memory is reclaimed. Note that sweep_code_cache() is not
@@ -87,6 +89,7 @@ class NMethodSweeper : public AllStatic {
 
   static bool sweep_in_progress();
   static void sweep_code_cache();
+  static void do_stack_scanning();
 
  public:
   static long traversal_count()              { return _traversals; }
@@ -105,7 +108,7 @@ class NMethodSweeper : public AllStatic {
   static void report_events();
 #endif
 
-  static void mark_active_nmethods();      // Invoked at the end of each safepoint
+  static void mark_active_nmethods();      // Invoked by VM_MarkActiveNMethods at the start of each sweep
   static void possibly_sweep();            // Compiler threads call this to sweep
 
   static int hotness_counter_reset_val();
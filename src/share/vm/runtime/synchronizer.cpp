@@ -156,6 +156,7 @@ int ObjectSynchronizer::gOmInUseCount = 0;
 static volatile intptr_t ListLock = 0 ;      // protects global monitor free-list cache
 static volatile int MonitorFreeCount  = 0 ;      // # on gFreeList
 static volatile int MonitorPopulation = 0 ;      // # Extant -- in circulation
+static jlong LastDeflationNanos = 0 ;            // os::javaTimeNanos() of last deflation
 #define CHAINMARKER (cast_to_oop<intptr_t>(-1))
 
 // -----------------------------------------------------------------------------
@@ -1500,6 +1501,21 @@ int ObjectSynchronizer::walk_monitor_list(ObjectMonitor** listheadp,
   return deflatedcount;
 }
 
+// Deflating walks every extant (or, with MonitorInUseLists, every in-use)
+// monitor, so with a large monitor population it dominates the cost of
+// otherwise cheap safepoints.  MonitorDeflationInterval lets those
+// safepoints skip it.  Idle monitors keep their objects reachable until
+// they are deflated, so a nonzero interval trades some floating garbage
+// for shorter safepoints.
+bool ObjectSynchronizer::should_deflate_idle_monitors() {
+  assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
+  if (MonitorDeflationInterval == 0 || ForceMonitorScavenge != 0) {
+    return true;
+  }
+  jlong elapsed_ms = (os::javaTimeNanos() - LastDeflationNanos) / NANOSECS_PER_MILLISEC;
+  return elapsed_ms >= MonitorDeflationInterval;
+}
+
 void ObjectSynchronizer::deflate_idle_monitors() {
   assert(SafepointSynchronize::is_at_safepoint(), "must be at safepoint");
   int nInuse = 0 ;              // currently associated with objects
@@ -1593,6 +1609,7 @@ void ObjectSynchronizer::deflate_idle_monitors() {
   // Audit/inventory the objectMonitors -- make sure they're all accounted for.
   GVars.stwRandom = os::random() ;
   GVars.stwCycle ++ ;
+  LastDeflationNanos = os::javaTimeNanos() ;
 }
 
 // Monitor cleanup on JavaThread::exit
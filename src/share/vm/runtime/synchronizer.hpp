@@ -113,6 +113,8 @@ class ObjectSynchronizer : AllStatic {
   // Basically we deflate all monitors that are not busy.
   // An adaptive profile-based deflation policy could be used if needed
   static void deflate_idle_monitors();
+  // Whether this safepoint should deflate, see MonitorDeflationInterval
+  static bool should_deflate_idle_monitors();
   static int walk_monitor_list(ObjectMonitor** listheadp,
                                ObjectMonitor** FreeHeadp,
                                ObjectMonitor** FreeTailp);
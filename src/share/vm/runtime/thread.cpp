@@ -46,6 +46,7 @@
 #include "prims/jvmtiThreadState.hpp"
 #include "prims/privilegedStack.hpp"
 #include "runtime/arguments.hpp"
+#include "runtime/asyncLogWriter.hpp"
 #include "runtime/biasedLocking.hpp"
 #include "runtime/deoptimization.hpp"
 #include "runtime/fprofiler.hpp"
@@ -74,15 +75,18 @@
 #include "runtime/vmThread.hpp"
 #include "runtime/vm_operations.hpp"
 #include "services/attachListener.hpp"
+#include "services/cpuProfiler.hpp"
 #include "services/management.hpp"
 #include "services/memTracker.hpp"
 #include "services/threadService.hpp"
+#include "trace/traceRecorder.hpp"
 #include "trace/tracing.hpp"
 #include "trace/traceMacros.hpp"
 #include "utilities/defaultStream.hpp"
 #include "utilities/dtrace.hpp"
 #include "utilities/events.hpp"
 #include "utilities/preserveException.hpp"
+#include "utilities/quickSort.hpp"
 #include "utilities/macros.hpp"
 #ifdef TARGET_OS_FAMILY_linux
 # include "os_linux.inline.hpp"
@@ -223,6 +227,9 @@ Thread::Thread() {
 
   // allocated data structures
   set_osthread(NULL);
+  for (int i = 0; i < Chunk::thread_cached_sizes; i++) {
+    _chunk_cache[i] = NULL;
+  }
   set_resource_area(new (mtThread)ResourceArea());
   DEBUG_ONLY(_current_resource_mark = NULL;)
   set_handle_area(new (mtThread) HandleArea(NULL));
@@ -390,6 +397,10 @@ Thread::~Thread() {
     // thread that was destroyed, and gets stale information.
     ThreadLocalStorage::invalidate_all();
   }
+
+  // No more chunks can be cached for this thread now
+  Chunk::flush_thread_cache(this);
+
   CHECK_UNHANDLED_OOPS_ONLY(if (CheckUnhandledOops) delete unhandled_oops();)
 }
 
@@ -1457,6 +1468,7 @@ void JavaThread::initialize() {
   _is_method_handle_return = 0;
   _jvmti_thread_state= NULL;
   _should_post_on_exceptions_flag = JNI_FALSE;
+  _profile_sample_countdown = 0;
   _jvmti_get_loaded_classes_closure = NULL;
   _interp_only_mode    = 0;
   _special_runtime_exit_condition = _no_async_condition;
@@ -1478,6 +1490,7 @@ void JavaThread::initialize() {
 #endif /* PRODUCT */
 
   set_thread_profiler(NULL);
+  _cpu_profiler_buffer = NULL;
   if (FlatProfiler::is_active()) {
     // This is where we would decide to either give each thread it's own profiler
     // or use one global one from FlatProfiler,
@@ -1630,6 +1643,7 @@ JavaThread::~JavaThread() {
   ThreadSafepointState::destroy(this);
   if (_thread_profiler != NULL) delete _thread_profiler;
   if (_thread_stat != NULL) delete _thread_stat;
+  if (_cpu_profiler_buffer != NULL) CPUProfiler::thread_exit(this);
 }
 
 
@@ -2869,6 +2883,11 @@ void JavaThread::print_on(outputStream *st) const {
   if (thread_oop != NULL && JDK_Version::is_gte_jdk15x_version()) {
     st->print_cr("   java.lang.Thread.State: %s", java_lang_Thread::thread_status_name(thread_oop));
   }
+#ifdef LINUX
+  if (UseFutexParker && PrintParkerStatistics && _parker != NULL) {
+    _parker->print_statistics_on(st);
+  }
+#endif // LINUX
 #ifndef PRODUCT
   print_thread_state_on(st);
   _safepoint_state->print_on(st);
@@ -3249,6 +3268,7 @@ CompilerThread::CompilerThread(CompileQueue* queue, CompilerCounters* counters)
   _buffer_blob = NULL;
   _scanned_nmethod = NULL;
   _compiler = NULL;
+  _idle_start = os::javaTimeMillis();
 
   // Compiler uses resource area for compilation, let's bias it to mtCompiler
   resource_area()->bias_to(mtCompiler);
@@ -3311,6 +3331,10 @@ void Threads::threads_do(ThreadClosure* tc) {
   if (wt != NULL)
     tc->do_thread(wt);
 
+  AsyncLogWriter* lw = AsyncLogWriter::instance();
+  if (lw != NULL)
+    tc->do_thread(lw);
+
   // If CompilerThreads ever become non-JavaThreads, add them here
 }
 
@@ -3469,6 +3493,9 @@ jint Threads::create_vm(JavaVMInitArgs* args, bool* canTryAgain) {
     }
   }
 
+  // Move -Xloggc file I/O off the logging threads if asked to
+  ostream_init_async_log();
+
   assert (Universe::is_fully_initialized(), "not initialized");
   if (VerifyDuringStartup) {
     // Make sure we're starting with a clean slate.
@@ -3675,6 +3702,9 @@ jint Threads::create_vm(JavaVMInitArgs* args, bool* canTryAgain) {
   if (MemProfiling)                   MemProfiler::engage();
   StatSampler::engage();
   if (CheckJNICalls)                  JniPeriodicChecker::engage();
+#if INCLUDE_TRACE
+  if (TraceRecordingFile != NULL)     TraceRecorder::start(TraceRecordingFile, tty);
+#endif
 
   BiasedLocking::init();
 
@@ -3894,6 +3924,60 @@ void Threads::create_vm_init_libraries() {
   }
 }
 
+class ThreadIdEntry VALUE_OBJ_CLASS_SPEC {
+ public:
+  jlong       _tid;
+  JavaThread* _thread;
+
+  static int compare(ThreadIdEntry a, ThreadIdEntry b) {
+    return a._tid < b._tid ? -1 : (a._tid > b._tid ? 1 : 0);
+  }
+};
+
+void Threads::find_java_threads_from_java_tids(typeArrayOop ids, JavaThread** threads) {
+  assert(Threads_lock->owned_by_self(), "Must hold Threads_lock");
+  int num_ids = ids->length();
+  // For a few ids the sequential search is cheaper than building the index
+  if (num_ids <= 4) {
+    for (int i = 0; i < num_ids; i++) {
+      threads[i] = find_java_thread_from_java_tid(ids->long_at(i));
+    }
+    return;
+  }
+
+  ResourceMark rm;
+  ThreadIdEntry* entries = NEW_RESOURCE_ARRAY(ThreadIdEntry, number_of_threads());
+  int num_entries = 0;
+  for (JavaThread* thread = Threads::first(); thread != NULL; thread = thread->next()) {
+    oop tobj = thread->threadObj();
+    if (!thread->is_exiting() && tobj != NULL) {
+      assert(num_entries < number_of_threads(), "thread list and count disagree");
+      entries[num_entries]._tid = java_lang_Thread::thread_id(tobj);
+      entries[num_entries]._thread = thread;
+      num_entries++;
+    }
+  }
+  QuickSort::sort<ThreadIdEntry>(entries, num_entries, ThreadIdEntry::compare, false);
+
+  for (int i = 0; i < num_ids; i++) {
+    jlong tid = ids->long_at(i);
+    threads[i] = NULL;
+    int low = 0;
+    int high = num_entries - 1;
+    while (low <= high) {
+      int mid = low + (high - low) / 2;
+      if (entries[mid]._tid < tid) {
+        low = mid + 1;
+      } else if (entries[mid]._tid > tid) {
+        high = mid - 1;
+      } else {
+        threads[i] = entries[mid]._thread;
+        break;
+      }
+    }
+  }
+}
+
 JavaThread* Threads::find_java_thread_from_java_tid(jlong java_tid) {
   assert(Threads_lock->owned_by_self(), "Must hold Threads_lock");
 
@@ -4178,6 +4262,17 @@ void Threads::oops_do(OopClosure* f, CLDClosure* cld_f, CodeBlobClosure* cf) {
   VMThread::vm_thread()->oops_do(f, cld_f, cf);
 }
 
+// Parallel root scanning hands out whole threads, so the pause is at least
+// as long as the scan of the deepest stack. Scanning deep stacks first lets
+// the remaining workers balance the shallow ones around them.
+static bool has_deep_stack(JavaThread* p) {
+  if (ParGCDeepStackThreshold == 0 || !p->has_last_Java_frame()) {
+    return false;
+  }
+  size_t used = pointer_delta(p->stack_base(), (address)p->last_Java_sp(), sizeof(char));
+  return used >= ParGCDeepStackThreshold;
+}
+
 void Threads::possibly_parallel_oops_do(OopClosure* f, CLDClosure* cld_f, CodeBlobClosure* cf) {
   // Introduce a mechanism allowing parallel threads to claim threads as
   // root groups.  Overhead should be small enough to use all the time,
@@ -4193,6 +4288,13 @@ void Threads::possibly_parallel_oops_do(OopClosure* f, CLDClosure* cld_f, CodeBl
          (SharedHeap::heap()->n_par_threads() ==
           SharedHeap::heap()->workers()->active_workers()), "Mismatch");
   int cp = SharedHeap::heap()->strong_roots_parity();
+  if (is_par) {
+    ALL_JAVA_THREADS(p) {
+      if (has_deep_stack(p) && p->claim_oops_do(is_par, cp)) {
+        p->oops_do(f, cld_f, cf);
+      }
+    }
+  }
   ALL_JAVA_THREADS(p) {
     if (p->claim_oops_do(is_par, cp)) {
       p->oops_do(f, cld_f, cf);
@@ -4207,8 +4309,16 @@ void Threads::possibly_parallel_oops_do(OopClosure* f, CLDClosure* cld_f, CodeBl
 #if INCLUDE_ALL_GCS
 // Used by ParallelScavenge
 void Threads::create_thread_roots_tasks(GCTaskQueue* q) {
+  // Deep stacks first, see has_deep_stack().
+  ALL_JAVA_THREADS(p) {
+    if (has_deep_stack(p)) {
+      q->enqueue(new ThreadRootsTask(p));
+    }
+  }
   ALL_JAVA_THREADS(p) {
-    q->enqueue(new ThreadRootsTask(p));
+    if (!has_deep_stack(p)) {
+      q->enqueue(new ThreadRootsTask(p));
+    }
   }
   q->enqueue(new ThreadRootsTask(VMThread::vm_thread()));
 }
@@ -4364,6 +4474,11 @@ void Threads::print_on(outputStream* st, bool print_stacks, bool internal_format
     wt->print_on(st);
     st->cr();
   }
+  AsyncLogWriter* lw = AsyncLogWriter::instance();
+  if (lw != NULL) {
+    lw->print_on(st);
+    st->cr();
+  }
   CompileBroker::print_compiler_threads_on(st);
   st->flush();
 }
@@ -39,6 +39,7 @@
 #include "runtime/park.hpp"
 #include "runtime/safepoint.hpp"
 #include "runtime/stubRoutines.hpp"
+#include "runtime/threadHeapSampler.hpp"
 #include "runtime/threadLocalStorage.hpp"
 #include "runtime/thread_ext.hpp"
 #include "runtime/unhandledOops.hpp"
@@ -57,6 +58,7 @@
 
 class ThreadSafepointState;
 class ThreadProfiler;
+class CPUProfilerBuffer;
 
 class JvmtiThreadState;
 class JvmtiGetLoadedClassesClosure;
@@ -256,6 +258,7 @@ class Thread: public ThreadShadow {
   ThreadLocalAllocBuffer _tlab;                 // Thread-local eden
   jlong _allocated_bytes;                       // Cumulative number of bytes allocated on
                                                 // the Java heap
+  ThreadHeapSampler _heap_sampler;              // For use when sampling allocations
 
   // Thread-local buffer used by MetadataOnStackMark.
   MetadataOnStackBuffer* _metadata_on_stack_buffer;
@@ -412,6 +415,8 @@ class Thread: public ThreadShadow {
   ResourceArea* resource_area() const            { return _resource_area; }
   void set_resource_area(ResourceArea* area)     { _resource_area = area; }
 
+  Chunk** chunk_cache_slot(int index)            { return &_chunk_cache[index]; }
+
   OSThread* osthread() const                     { return _osthread;   }
   void set_osthread(OSThread* thread)            { _osthread = thread; }
 
@@ -441,6 +446,8 @@ class Thread: public ThreadShadow {
   void incr_allocated_bytes(jlong size) { _allocated_bytes += size; }
   inline jlong cooked_allocated_bytes();
 
+  ThreadHeapSampler& heap_sampler()     { return _heap_sampler; }
+
   TRACE_DATA* trace_data()              { return &_trace_data; }
 
   const ThreadExt& ext() const          { return _ext; }
@@ -531,6 +538,9 @@ protected:
   // Thread local resource area for temporary allocation within the VM
   ResourceArea* _resource_area;
 
+  // Arena chunks kept for reuse by this thread without going to the ChunkPools
+  Chunk* _chunk_cache[Chunk::thread_cached_sizes];
+
   DEBUG_ONLY(ResourceMark* _current_resource_mark;)
 
   // Thread local handle area for allocation of handles within the VM
@@ -1375,6 +1385,9 @@ class JavaThread: public Thread {
   static ByteSize should_post_on_exceptions_flag_offset() {
     return byte_offset_of(JavaThread, _should_post_on_exceptions_flag);
   }
+  static ByteSize profile_sample_countdown_offset() {
+    return byte_offset_of(JavaThread, _profile_sample_countdown);
+  }
 
 #if INCLUDE_ALL_GCS
   static ByteSize satb_mark_queue_offset()       { return byte_offset_of(JavaThread, _satb_mark_queue); }
@@ -1526,6 +1539,13 @@ public:
      return result;
    }
 
+  // Samples of the CPU profiler (see cpuProfiler.cpp)
+ private:
+   CPUProfilerBuffer* _cpu_profiler_buffer;
+ public:
+   CPUProfilerBuffer* cpu_profiler_buffer() const { return _cpu_profiler_buffer; }
+   void set_cpu_profiler_buffer(CPUProfilerBuffer* b) { _cpu_profiler_buffer = b; }
+
  public:
   // Returns the running thread as a JavaThread
   static inline JavaThread* current();
@@ -1645,6 +1665,11 @@ public:
   int   should_post_on_exceptions_flag()  { return _should_post_on_exceptions_flag; }
   void  set_should_post_on_exceptions_flag(int val)  { _should_post_on_exceptions_flag = val; }
 
+ private:
+  // Executions of sampled profiling sites in C1 code until the next
+  // profile update (see C1ProfileSamplingPeriod)
+  int    _profile_sample_countdown;
+
  private:
   ThreadStatistics *_thread_stat;
 
@@ -1832,6 +1857,7 @@ class CompilerThread : public JavaThread {
 
   nmethod*          _scanned_nmethod;  // nmethod being scanned by the sweeper
   AbstractCompiler* _compiler;
+  jlong             _idle_start;       // time (ms) the thread last ran out of work
 
  public:
 
@@ -1856,6 +1882,10 @@ class CompilerThread : public JavaThread {
   BufferBlob*   get_buffer_blob() const          { return _buffer_blob; }
   void          set_buffer_blob(BufferBlob* b)   { _buffer_blob = b; };
 
+  // Idle time, used to decide whether a dynamic compiler thread may exit
+  void          reset_idle_time()                { _idle_start = os::javaTimeMillis(); }
+  jlong         idle_time_millis() const         { return os::javaTimeMillis() - _idle_start; }
+
   // Get/set the thread's logging information
   CompileLog*   log()                            { return _log; }
   void          init_log(CompileLog* log) {
@@ -1991,6 +2021,10 @@ class Threads: AllStatic {
   static void deoptimized_wrt_marked_nmethods();
 
   static JavaThread* find_java_thread_from_java_tid(jlong java_tid);
+  // Looks up the threads for all ids with one walk over the thread list,
+  // so that Threads_lock is held for O(threads + ids) rather than
+  // O(threads * ids). threads[i] is set to NULL if ids[i] has no live thread.
+  static void find_java_threads_from_java_tids(typeArrayOop ids, JavaThread** threads);
 
 };
 
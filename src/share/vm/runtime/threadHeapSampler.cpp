@@ -0,0 +1,77 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/os.hpp"
+#include "runtime/thread.hpp"
+#include "runtime/threadHeapSampler.hpp"
+
+uint64_t ThreadHeapSampler::next_random() {
+  uint64_t x = _rnd;
+  if (x == 0) {
+    // Seed lazily; the address keeps threads started together apart.
+    x = (uint64_t)os::javaTimeNanos() ^ (uint64_t)(uintptr_t)this;
+    if (x == 0) {
+      x = 1;
+    }
+  }
+  x ^= x << 13;
+  x ^= x >> 7;
+  x ^= x << 17;
+  _rnd = x;
+  return x;
+}
+
+void ThreadHeapSampler::pick_next_sample(jlong allocated) {
+  // Uniform in (0, 1] from the top 53 bits, then inverse transform to an
+  // exponential distribution with the requested mean.
+  double u = ((next_random() >> 11) + 1) * (1.0 / 9007199254740992.0);
+  double distance = -log(u) * (double)HeapSamplingInterval;
+  _next_sample_at = allocated + MAX2((jlong)distance, (jlong)1);
+}
+
+jlong ThreadHeapSampler::check_for_sampling(jlong allocated) {
+  if (_next_sample_at == 0) {
+    // First allocation seen by this thread.
+    _last_sample_at = allocated;
+    pick_next_sample(allocated);
+    return 0;
+  }
+  if (allocated < _next_sample_at) {
+    return 0;
+  }
+  jlong weight = allocated - _last_sample_at;
+  _last_sample_at = allocated;
+  pick_next_sample(allocated);
+  return weight;
+}
+
+bool ThreadHeapSampler::is_safe_to_sample(Thread* thread) {
+  return thread->is_Java_thread() &&
+         !thread->is_Compiler_thread() &&
+         ((JavaThread*)thread)->thread_state() == _thread_in_vm &&
+         !Compile_lock->owned_by_self() &&
+         !MultiArray_lock->owned_by_self();
+}
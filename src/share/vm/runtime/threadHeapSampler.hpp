@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_RUNTIME_THREADHEAPSAMPLER_HPP
+#define SHARE_VM_RUNTIME_THREADHEAPSAMPLER_HPP
+
+#include "memory/allocation.hpp"
+#include "runtime/globals.hpp"
+
+class Thread;
+
+// ThreadHeapSampler picks, for one thread, the points in its allocation
+// stream at which an allocated object is sampled (-XX:HeapSamplingInterval).
+// The distance between two sampling points is drawn from an exponential
+// distribution with a mean of HeapSamplingInterval bytes, so that every
+// allocated byte has the same chance of being sampled whatever the object
+// sizes are.  Positions are expressed in Thread::cooked_allocated_bytes().
+//
+// Allocations are intercepted by lowering the end of the thread's TLAB to
+// the next sampling point, which sends the allocation crossing it into the
+// slow path (see ThreadLocalAllocBuffer::set_sample_end()).
+class ThreadHeapSampler VALUE_OBJ_CLASS_SPEC {
+ private:
+  jlong    _next_sample_at;   // allocated bytes at which the next sample is taken
+  jlong    _last_sample_at;   // allocated bytes at which the last sample was taken
+  uint64_t _rnd;              // xorshift state; 0 until first used
+  bool     _posting;          // a sample of this thread is being reported
+
+  uint64_t next_random();
+  void pick_next_sample(jlong allocated);
+
+ public:
+  ThreadHeapSampler() : _next_sample_at(0), _last_sample_at(0), _rnd(0), _posting(false) {}
+
+  static bool enabled()                    { return HeapSamplingInterval > 0; }
+
+  // Called after an allocation has brought the thread's allocated bytes
+  // to 'allocated'.  If a sampling point has been crossed, picks the next
+  // one and returns the number of bytes the sample stands for; otherwise
+  // returns 0.
+  jlong check_for_sampling(jlong allocated);
+
+  // Distance from 'allocated' to the next sampling point.
+  size_t bytes_until_sample(jlong allocated) const {
+    return _next_sample_at > allocated ? (size_t)(_next_sample_at - allocated) : 0;
+  }
+
+  // Allocations made while a sample is reported are not sampled themselves.
+  bool is_posting() const                  { return _posting; }
+  void set_posting(bool value)             { _posting = value; }
+
+  // Whether a sampled allocation by this thread may be reported.  Posting
+  // calls out to agent code, which compiler threads and threads holding
+  // locks taken during class linking and multi-array allocation must not do.
+  static bool is_safe_to_sample(Thread* thread);
+};
+
+#endif // SHARE_VM_RUNTIME_THREADHEAPSAMPLER_HPP
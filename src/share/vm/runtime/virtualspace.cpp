@@ -23,6 +23,7 @@
  */
 
 #include "precompiled.hpp"
+#include "memory/pretouchTask.hpp"
 #include "oops/markOop.hpp"
 #include "oops/oop.inline.hpp"
 #include "runtime/virtualspace.hpp"
@@ -335,15 +336,40 @@ void ReservedSpace::protect_noaccess_prefix(const size_t size) {
          "must be exactly of required size and alignment");
 }
 
+void ReservedSpace::map_to_file(const char* dir) {
+  assert(is_reserved() && !special(), "must be an anonymous reservation");
+  int fd = os::create_file_for_heap(dir);
+  if (fd == -1) {
+    vm_exit_during_initialization(
+      err_msg("Could not create file for heap at location %s", dir));
+  }
+  char* base = os::replace_existing_mapping_with_file_mapping(_base, _size, fd);
+  // The mapping keeps the unlinked file alive.
+  os::close(fd);
+  if (base == NULL) {
+    vm_exit_during_initialization(
+      err_msg("Could not map " SIZE_FORMAT "K heap to a file at location %s",
+              _size / K, dir));
+  }
+  assert(base == _base, "must map in place");
+  // The file backs every page, so the space is committed from the start.
+  _special = true;
+  MemTracker::record_virtual_memory_commit((address)_base, _size, CALLER_PC);
+}
+
 ReservedHeapSpace::ReservedHeapSpace(size_t size, size_t alignment,
                                      bool large, char* requested_address) :
-  ReservedSpace(size, alignment, large,
+  // Large pages are up to the filesystem when the heap is file backed.
+  ReservedSpace(size, alignment, large && AllocateHeapAt == NULL,
                 requested_address,
                 (UseCompressedOops && (Universe::narrow_oop_base() != NULL) &&
                  Universe::narrow_oop_use_implicit_null_checks()) ?
                   lcm(os::vm_page_size(), alignment) : 0) {
   if (base() != NULL) {
     MemTracker::record_virtual_memory_type((address)base(), mtJavaHeap);
+    if (AllocateHeapAt != NULL) {
+      map_to_file(AllocateHeapAt);
+    }
   }
 
   // Only reserved space for the java heap should have a noaccess_prefix
@@ -640,7 +666,7 @@ bool VirtualSpace::expand_by(size_t bytes, bool pre_touch) {
   }
 
   if (pre_touch || AlwaysPreTouch) {
-    os::pretouch_memory(previous_high, unaligned_new_high);
+    PretouchTask::pretouch(previous_high, unaligned_new_high, os::vm_page_size());
   }
 
   _high += bytes;
@@ -50,6 +50,8 @@ class ReservedSpace VALUE_OBJ_CLASS_SPEC {
  protected:
   // Create protection page at the beginning of the space.
   void protect_noaccess_prefix(const size_t size);
+  // Back the whole reservation with a file created in dir.
+  void map_to_file(const char* dir);
 
  public:
   // Constructor
@@ -215,6 +215,9 @@ VMThread*         VMThread::_vm_thread          = NULL;
 VM_Operation*     VMThread::_cur_vm_operation   = NULL;
 VMOperationQueue* VMThread::_vm_queue           = NULL;
 PerfCounter*      VMThread::_perf_accumulated_vm_operation_time = NULL;
+VMThread::VMOperationStats VMThread::_op_stats[VM_Operation::VMOp_Terminating];
+julong            VMThread::_safepoint_batches  = 0;
+julong            VMThread::_max_batch_size     = 0;
 
 
 void VMThread::create() {
@@ -358,8 +361,9 @@ void VMThread::print_on(outputStream* st) const {
   st->cr();
 }
 
-void VMThread::evaluate_operation(VM_Operation* op) {
+void VMThread::evaluate_operation(VM_Operation* op, bool coalesced) {
   ResourceMark rm;
+  jlong start_time = PrintVMOperationStatistics ? os::javaTimeNanos() : 0;
 
   {
     PerfTraceTime vm_op_timer(perf_accumulated_vm_operation_time());
@@ -398,6 +402,20 @@ void VMThread::evaluate_operation(VM_Operation* op) {
 #endif /* USDT2 */
   }
 
+  if (PrintVMOperationStatistics) {
+    jlong exec_time = os::javaTimeNanos() - start_time;
+    jlong queue_time = op->enqueue_time() != 0 ? start_time - op->enqueue_time() : 0;
+    VMOperationStats* s = &_op_stats[op->type()];
+    s->_count++;
+    if (coalesced) {
+      s->_coalesced++;
+    }
+    s->_total_queue_time += queue_time;
+    s->_max_queue_time = MAX2(s->_max_queue_time, queue_time);
+    s->_total_exec_time += exec_time;
+    s->_max_exec_time = MAX2(s->_max_exec_time, exec_time);
+  }
+
   // Last access of info in _cur_vm_operation!
   bool c_heap_allocated = op->is_cheap_allocated();
 
@@ -412,6 +430,45 @@ void VMThread::evaluate_operation(VM_Operation* op) {
   }
 }
 
+void VMThread::note_batch_size(julong ops) {
+  if (PrintVMOperationStatistics) {
+    _safepoint_batches++;
+    _max_batch_size = MAX2(_max_batch_size, ops);
+  }
+}
+
+static jlong nanos_to_micros(jlong nanos) {
+  return nanos / (NANOUNITS / MICROUNITS);
+}
+
+void VMThread::print_statistics_on(outputStream* st) {
+  julong total = 0;
+  julong coalesced = 0;
+  st->print_cr("VM operation statistics:");
+  st->print_cr("  %-26s %10s %10s %12s %12s %12s %12s",
+               "vmop", "count", "coalesced",
+               "queue avg", "queue max", "exec avg", "exec max");
+  for (int i = 0; i < VM_Operation::VMOp_Terminating; i++) {
+    const VMOperationStats* s = &_op_stats[i];
+    if (s->_count == 0) {
+      continue;
+    }
+    total += s->_count;
+    coalesced += s->_coalesced;
+    st->print_cr("  %-26s " UINT64_FORMAT_W(10) " " UINT64_FORMAT_W(10) " "
+                 INT64_FORMAT_W(10) "us " INT64_FORMAT_W(10) "us "
+                 INT64_FORMAT_W(10) "us " INT64_FORMAT_W(10) "us",
+                 VM_Operation::name(i), s->_count, s->_coalesced,
+                 nanos_to_micros(s->_total_queue_time / (jlong)s->_count),
+                 nanos_to_micros(s->_max_queue_time),
+                 nanos_to_micros(s->_total_exec_time / (jlong)s->_count),
+                 nanos_to_micros(s->_max_exec_time));
+  }
+  st->print_cr("  " UINT64_FORMAT " VM operations, " UINT64_FORMAT " safepoints begun for them, "
+               UINT64_FORMAT " coalesced, at most " UINT64_FORMAT " in one safepoint",
+               total, _safepoint_batches, coalesced, _max_batch_size);
+}
+
 
 void VMThread::loop() {
   assert(_cur_vm_operation == NULL, "no current one should be executing");
@@ -450,31 +507,32 @@ void VMThread::loop() {
           exit(-1);
         }
 
-        if (timedout && (SafepointALot ||
-                         SafepointSynchronize::is_cleanup_needed())) {
+        const char* cause = NULL;
+        if (timedout) {
+          cause = SafepointALot ? "SafepointALot" : SafepointSynchronize::cleanup_needed_cause();
+        }
+        if (cause != NULL) {
           MutexUnlockerEx mul(VMOperationQueue_lock,
                               Mutex::_no_safepoint_check_flag);
           // Force a safepoint since we have not had one for at least
           // 'GuaranteedSafepointInterval' milliseconds.  This will run all
           // the clean-up processing that needs to be done regularly at a
           // safepoint
-          SafepointSynchronize::begin();
-          #ifdef ASSERT
-            if (GCALotAtAllSafepoints) InterfaceSupport::check_gc_alot();
-          #endif
-          SafepointSynchronize::end();
+          SafepointSynchronize::guaranteed_safepoint(cause);
         }
         _cur_vm_operation = _vm_queue->remove_next();
-
-        // If we are at a safepoint we will evaluate all the operations that
-        // follow that also require a safepoint
-        if (_cur_vm_operation != NULL &&
-            _cur_vm_operation->evaluate_at_safepoint()) {
-          safepoint_ops = _vm_queue->drain_at_safepoint_priority();
-        }
       }
 
       if (should_terminate()) break;
+
+      // If we are going to a safepoint we will evaluate all the operations
+      // that follow that also require a safepoint. This is done whether the
+      // operation was found right away or after waiting, so a burst of
+      // requests that arrived while the previous one was being evaluated
+      // shares a single safepoint.
+      if (_cur_vm_operation->evaluate_at_safepoint()) {
+        safepoint_ops = _vm_queue->drain_at_safepoint_priority();
+      }
     } // Release mu_queue_lock
 
     //
@@ -498,6 +556,7 @@ void VMThread::loop() {
 
         _vm_queue->set_drain_list(safepoint_ops); // ensure ops can be scanned
 
+        julong batch_size = 1;
         SafepointSynchronize::begin();
         evaluate_operation(_cur_vm_operation);
         // now process all queued safepoint ops, iteratively draining
@@ -510,8 +569,9 @@ void VMThread::loop() {
               // to grab the next op now
               VM_Operation* next = _cur_vm_operation->next();
               _vm_queue->set_drain_list(next);
-              evaluate_operation(_cur_vm_operation);
+              evaluate_operation(_cur_vm_operation, true /* coalesced */);
               _cur_vm_operation = next;
+              batch_size++;
               if (PrintSafepointStatistics) {
                 SafepointSynchronize::inc_vmop_coalesced_count();
               }
@@ -541,6 +601,7 @@ void VMThread::loop() {
 
         // Complete safepoint synchronization
         SafepointSynchronize::end();
+        note_batch_size(batch_size);
 
       } else {  // not a safepoint operation
         if (TraceLongCompiles) {
@@ -574,13 +635,13 @@ void VMThread::loop() {
     //
     // We want to make sure that we get to a safepoint regularly.
     //
-    if (SafepointALot || SafepointSynchronize::is_cleanup_needed()) {
+    const char* cause = SafepointALot ? "SafepointALot" : SafepointSynchronize::cleanup_needed_cause();
+    if (cause != NULL) {
       long interval          = SafepointSynchronize::last_non_safepoint_interval();
       bool max_time_exceeded = GuaranteedSafepointInterval != 0 && (interval > GuaranteedSafepointInterval);
       if (SafepointALot || max_time_exceeded) {
         HandleMark hm(VMThread::vm_thread());
-        SafepointSynchronize::begin();
-        SafepointSynchronize::end();
+        SafepointSynchronize::guaranteed_safepoint(cause);
       }
     }
   }
@@ -624,6 +685,9 @@ void VMThread::execute(VM_Operation* op) {
       VMOperationQueue_lock->lock_without_safepoint_check();
       bool ok = _vm_queue->add(op);
     op->set_timestamp(os::javaTimeMillis());
+      if (PrintVMOperationStatistics) {
+        op->set_enqueue_time(os::javaTimeNanos());
+      }
       VMOperationQueue_lock->notify();
       VMOperationQueue_lock->unlock();
       // VM_Operation got skipped
@@ -99,7 +99,22 @@ class VMThread: public NamedThread {
   static Monitor * _terminate_lock;
   static PerfCounter* _perf_accumulated_vm_operation_time;
 
-  void evaluate_operation(VM_Operation* op);
+  // Per VM operation type statistics, see PrintVMOperationStatistics.
+  // Only updated by the VM thread.
+  struct VMOperationStats {
+    julong _count;             // operations evaluated
+    julong _coalesced;         // evaluated in a safepoint begun for another op
+    jlong  _total_queue_time;  // nanos between enqueue and evaluation
+    jlong  _max_queue_time;
+    jlong  _total_exec_time;   // nanos spent in evaluate()
+    jlong  _max_exec_time;
+  };
+  static VMOperationStats _op_stats[VM_Operation::VMOp_Terminating];
+  static julong _safepoint_batches;      // safepoints begun for VM operations
+  static julong _max_batch_size;         // most operations evaluated in one of them
+
+  void evaluate_operation(VM_Operation* op, bool coalesced = false);
+  static void note_batch_size(julong ops);
  public:
   // Constructor
   VMThread();
@@ -135,6 +150,7 @@ class VMThread: public NamedThread {
 
   // Performance measurement
   static PerfCounter* perf_accumulated_vm_operation_time()               { return _perf_accumulated_vm_operation_time; }
+  static void print_statistics_on(outputStream* st);
 
   // Entry for starting vm thread
   virtual void run();
@@ -169,6 +169,10 @@ void VM_ZombieAll::doit() {
 
 #endif // !PRODUCT
 
+void VM_MarkActiveNMethods::doit() {
+  NMethodSweeper::mark_active_nmethods();
+}
+
 void VM_UnlinkSymbols::doit() {
   JavaThread *thread = (JavaThread *)calling_thread();
   assert(thread->is_Java_thread(), "must be a Java thread");
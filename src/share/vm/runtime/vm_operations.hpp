@@ -50,6 +50,7 @@
   template(DeoptimizeFrame)                       \
   template(DeoptimizeAll)                         \
   template(ZombieAll)                             \
+  template(MarkActiveNMethods)                    \
   template(UnlinkSymbols)                         \
   template(Verify)                                \
   template(PrintJNI)                              \
@@ -117,6 +118,7 @@ class VM_Operation: public CHeapObj<mtInternal> {
   Thread*         _calling_thread;
   ThreadPriority  _priority;
   long            _timestamp;
+  jlong           _enqueue_time;     // javaTimeNanos when queued, see PrintVMOperationStatistics
   VM_Operation*   _next;
   VM_Operation*   _prev;
 
@@ -124,7 +126,7 @@ class VM_Operation: public CHeapObj<mtInternal> {
   static const char* _names[];
 
  public:
-  VM_Operation()  { _calling_thread = NULL; _next = NULL; _prev = NULL; }
+  VM_Operation()  { _calling_thread = NULL; _next = NULL; _prev = NULL; _enqueue_time = 0; }
   virtual ~VM_Operation() {}
 
   // VM operation support (used by VM thread)
@@ -135,6 +137,9 @@ class VM_Operation: public CHeapObj<mtInternal> {
   long timestamp() const              { return _timestamp; }
   void set_timestamp(long timestamp)  { _timestamp = timestamp; }
 
+  jlong enqueue_time() const          { return _enqueue_time; }
+  void set_enqueue_time(jlong nanos)  { _enqueue_time = nanos; }
+
   // Called by VM thread - does in turn invoke doit(). Do not override this
   void evaluate();
 
@@ -285,6 +290,15 @@ class VM_ZombieAll: public VM_Operation {
 };
 #endif // PRODUCT
 
+// Scans the stacks of all Java threads for active nmethods. Requested by
+// the sweeper once at the start of each sweep.
+class VM_MarkActiveNMethods: public VM_Operation {
+ public:
+  VM_MarkActiveNMethods() {}
+  VMOp_Type type() const                         { return VMOp_MarkActiveNMethods; }
+  void doit();
+};
+
 class VM_UnlinkSymbols: public VM_Operation {
  public:
   VM_UnlinkSymbols() {}
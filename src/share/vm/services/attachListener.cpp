@@ -36,6 +36,7 @@
 #include "services/attachListener.hpp"
 #include "services/diagnosticCommand.hpp"
 #include "services/heapDumper.hpp"
+#include "services/threadService.hpp"
 
 volatile bool AttachListener::_initialized;
 
@@ -132,8 +133,24 @@ static jint data_dump(AttachOperation* op, outputStream* out) {
 //
 static jint thread_dump(AttachOperation* op, outputStream* out) {
   bool print_concurrent_locks = false;
-  if (op->arg(0) != NULL && strcmp(op->arg(0), "-l") == 0) {
-    print_concurrent_locks = true;
+  bool fast = false;
+  for (int i = 0; i < AttachOperation::arg_count_max; i++) {
+    if (op->arg(i) != NULL && strcmp(op->arg(i), "-l") == 0) {
+      print_concurrent_locks = true;
+    }
+    if (op->arg(i) != NULL && strcmp(op->arg(i), "-fast") == 0) {
+      fast = true;
+    }
+  }
+
+  // See ThreadDumpDCmd
+  if (fast) {
+    ThreadService::print_stacks_without_safepoint(out);
+    if (print_concurrent_locks) {
+      VM_FindDeadlocks op3(out);
+      VMThread::execute(&op3);
+    }
+    return JNI_OK;
   }
 
   // thread stacks
@@ -296,6 +313,12 @@ static jint set_uintx_flag(const char* name, AttachOperation* op, outputStream*
       out->print_cr("%s", err_msg.buffer());
       return JNI_ERR;
     }
+  } else if (strncmp(name, "SoftMaxHeapSize", 16) == 0) {
+    FormatBuffer<80> err_msg("%s", "");
+    if (!Arguments::verify_SoftMaxHeapSize(err_msg, value)) {
+      out->print_cr("%s", err_msg.buffer());
+      return JNI_ERR;
+    }
   }
   bool res = CommandLineFlags::uintxAtPut((char*)name, &value, Flag::ATTACH_ON_DEMAND);
   if (! res) {
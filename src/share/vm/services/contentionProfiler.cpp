@@ -0,0 +1,257 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "memory/resourceArea.hpp"
+#include "oops/method.hpp"
+#include "oops/oop.inline.hpp"
+#include "runtime/atomic.inline.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/objectMonitor.hpp"
+#include "runtime/thread.inline.hpp"
+#include "runtime/vframe.hpp"
+#include "services/contentionProfiler.hpp"
+#include "utilities/growableArray.hpp"
+
+// A class of locked objects and a stack, with what was recorded for them.
+class ContentionProfilerSite : public CHeapObj<mtInternal> {
+  friend class ContentionProfiler;
+ private:
+  ContentionProfilerSite* _next;
+  unsigned int            _hash;
+  Symbol*                 _klass_name;
+  int                     _num_frames;
+  jmethodID*              _methods;      // callee first
+  int*                    _bcis;
+  jlong                   _count;
+  jlong                   _total_nanos;
+  jlong                   _max_nanos;
+
+  ContentionProfilerSite(unsigned int hash, Symbol* klass_name, const ContentionStack* stack) :
+    _next(NULL), _hash(hash), _klass_name(klass_name), _num_frames(stack->_num_frames),
+    _count(0), _total_nanos(0), _max_nanos(0) {
+    _klass_name->increment_refcount();
+    _methods = NEW_C_HEAP_ARRAY(jmethodID, MAX2(_num_frames, 1), mtInternal);
+    _bcis = NEW_C_HEAP_ARRAY(int, MAX2(_num_frames, 1), mtInternal);
+    memcpy(_methods, stack->_methods, _num_frames * sizeof(jmethodID));
+    memcpy(_bcis, stack->_bcis, _num_frames * sizeof(int));
+  }
+  ~ContentionProfilerSite() {
+    _klass_name->decrement_refcount();
+    FREE_C_HEAP_ARRAY(jmethodID, _methods, mtInternal);
+    FREE_C_HEAP_ARRAY(int, _bcis, mtInternal);
+  }
+
+  bool matches(unsigned int hash, Symbol* klass_name, const ContentionStack* stack) const {
+    return _hash == hash && _klass_name == klass_name && _num_frames == stack->_num_frames &&
+           memcmp(_methods, stack->_methods, _num_frames * sizeof(jmethodID)) == 0 &&
+           memcmp(_bcis, stack->_bcis, _num_frames * sizeof(int)) == 0;
+  }
+
+  static int compare_blocked(ContentionProfilerSite** a, ContentionProfilerSite** b) {
+    jlong diff = (*b)->_total_nanos - (*a)->_total_nanos;
+    return diff > 0 ? 1 : (diff < 0 ? -1 : 0);
+  }
+  static int compare_count(ContentionProfilerSite** a, ContentionProfilerSite** b) {
+    jlong diff = (*b)->_count - (*a)->_count;
+    return diff > 0 ? 1 : (diff < 0 ? -1 : 0);
+  }
+};
+
+void ContentionStack::fill(JavaThread* thread) {
+  assert(thread == Thread::current(), "only the current thread");
+  assert(thread->thread_state() == _thread_in_vm, "may create jmethodIDs");
+  _num_frames = 0;
+  if (!thread->has_last_Java_frame()) {
+    return;
+  }
+  ResourceMark rm(thread);
+  for (vframeStream vfst(thread); !vfst.at_end() && _num_frames < max_frames; vfst.next()) {
+    _methods[_num_frames] = vfst.method()->jmethod_id();
+    _bcis[_num_frames] = vfst.bci();
+    _num_frames++;
+  }
+}
+
+ContentionProfilerSite** ContentionProfiler::_waiters           = NULL;
+ContentionProfilerSite** ContentionProfiler::_owners            = NULL;
+int                      ContentionProfiler::_num_sites         = 0;
+jlong                    ContentionProfiler::_samples           = 0;
+jlong                    ContentionProfiler::_lost_samples      = 0;
+volatile jint            ContentionProfiler::_unwalkable_owners = 0;
+volatile intx            ContentionProfiler::_countdown         = 0;
+
+bool ContentionProfiler::sample_next() {
+  // Racing threads may both see the same value; the interval is a rate,
+  // not an exact count.
+  intx n = Atomic::add_ptr(-1, &_countdown);
+  if (n > 0) {
+    return false;
+  }
+  _countdown = MonitorContentionSampleInterval;
+  return true;
+}
+
+void ContentionProfiler::add(ContentionProfilerSite** table, Symbol* klass_name,
+                             const ContentionStack* stack, jlong blocked_nanos) {
+  assert_lock_strong(ContentionProfiler_lock);
+  unsigned int hash = (unsigned int)((uintptr_t)klass_name >> LogBytesPerWord);
+  for (int i = 0; i < stack->_num_frames; i++) {
+    hash = 31 * hash + (unsigned int)((uintptr_t)stack->_methods[i] >> LogBytesPerWord);
+    hash = 31 * hash + (unsigned int)stack->_bcis[i];
+  }
+  ContentionProfilerSite** bucket = &table[hash % table_size];
+  ContentionProfilerSite* site = *bucket;
+  while (site != NULL && !site->matches(hash, klass_name, stack)) {
+    site = site->_next;
+  }
+  if (site == NULL) {
+    if (_num_sites >= max_sites) {
+      _lost_samples++;
+      return;
+    }
+    site = new ContentionProfilerSite(hash, klass_name, stack);
+    site->_next = *bucket;
+    *bucket = site;
+    _num_sites++;
+  }
+  site->_count++;
+  site->_total_nanos += blocked_nanos;
+  site->_max_nanos = MAX2(site->_max_nanos, blocked_nanos);
+}
+
+void ContentionProfiler::record_enter(ObjectMonitor* monitor, const ContentionStack* stack,
+                                      jlong blocked_nanos) {
+  // The caller owns the monitor, so the object cannot move meanwhile.
+  Symbol* klass_name = ((oop)monitor->object())->klass()->name();
+  MutexLockerEx ml(ContentionProfiler_lock, Mutex::_no_safepoint_check_flag);
+  if (_waiters == NULL) {
+    clear();
+  }
+  _samples++;
+  add(_waiters, klass_name, stack, blocked_nanos);
+}
+
+void ContentionProfiler::record_exit(ObjectMonitor* monitor, JavaThread* owner) {
+  // C1 and C2 unlock from leaf calls that leave the thread in Java, with
+  // no frame anchor to walk from and no way to create jmethodIDs.
+  if (owner->thread_state() != _thread_in_vm || !owner->has_last_Java_frame()) {
+    Atomic::inc(&_unwalkable_owners);
+    return;
+  }
+  ContentionStack* stack = new ContentionStack();
+  stack->fill(owner);
+  Symbol* klass_name = ((oop)monitor->object())->klass()->name();
+  {
+    MutexLockerEx ml(ContentionProfiler_lock, Mutex::_no_safepoint_check_flag);
+    if (_owners == NULL) {
+      clear();
+    }
+    add(_owners, klass_name, stack, 0);
+  }
+  delete stack;
+}
+
+void ContentionProfiler::clear() {
+  assert_lock_strong(ContentionProfiler_lock);
+  if (_waiters == NULL) {
+    _waiters = NEW_C_HEAP_ARRAY(ContentionProfilerSite*, table_size, mtInternal);
+    _owners = NEW_C_HEAP_ARRAY(ContentionProfilerSite*, table_size, mtInternal);
+  } else {
+    for (int i = 0; i < table_size; i++) {
+      ContentionProfilerSite* tables[] = { _waiters[i], _owners[i] };
+      for (int t = 0; t < 2; t++) {
+        ContentionProfilerSite* site = tables[t];
+        while (site != NULL) {
+          ContentionProfilerSite* next = site->_next;
+          delete site;
+          site = next;
+        }
+      }
+    }
+  }
+  memset(_waiters, 0, table_size * sizeof(ContentionProfilerSite*));
+  memset(_owners, 0, table_size * sizeof(ContentionProfilerSite*));
+  _num_sites = 0;
+  _samples = 0;
+  _lost_samples = 0;
+  _unwalkable_owners = 0;
+}
+
+void ContentionProfiler::reset() {
+  MutexLockerEx ml(ContentionProfiler_lock, Mutex::_no_safepoint_check_flag);
+  clear();
+}
+
+void ContentionProfiler::print_table(outputStream* out, ContentionProfilerSite** table,
+                                     bool waiters, int limit) {
+  ResourceMark rm;
+  GrowableArray<ContentionProfilerSite*> sites;
+  for (int i = 0; i < table_size; i++) {
+    for (ContentionProfilerSite* s = table[i]; s != NULL; s = s->_next) {
+      sites.append(s);
+    }
+  }
+  sites.sort(waiters ? ContentionProfilerSite::compare_blocked
+                     : ContentionProfilerSite::compare_count);
+  int n = (limit > 0) ? MIN2(limit, sites.length()) : sites.length();
+  for (int i = 0; i < n; i++) {
+    ContentionProfilerSite* s = sites.at(i);
+    if (waiters) {
+      out->print_cr("  " JLONG_FORMAT " enters blocked %.3f ms (max %.3f ms) on %s", s->_count,
+                    (double)s->_total_nanos / NANOSECS_PER_MILLISEC,
+                    (double)s->_max_nanos / NANOSECS_PER_MILLISEC,
+                    s->_klass_name->as_klass_external_name());
+    } else {
+      out->print_cr("  " JLONG_FORMAT " releases of %s", s->_count,
+                    s->_klass_name->as_klass_external_name());
+    }
+    for (int f = 0; f < s->_num_frames; f++) {
+      Method* m = Method::checked_resolve_jmethod_id(s->_methods[f]);
+      if (m == NULL) {
+        out->print_cr("    at <unloaded>");
+      } else {
+        out->print_cr("    at %s.%s(bci %d, line %d)", m->method_holder()->external_name(),
+                      m->name()->as_C_string(), s->_bcis[f], m->line_number_from_bci(s->_bcis[f]));
+      }
+    }
+    if (s->_num_frames == 0) {
+      out->print_cr("    <no Java frames>");
+    }
+  }
+}
+
+void ContentionProfiler::print_on(outputStream* out, int limit) {
+  MutexLockerEx ml(ContentionProfiler_lock, Mutex::_no_safepoint_check_flag);
+  out->print_cr("Monitor contention: " JLONG_FORMAT " sampled enters, one in " INTX_FORMAT
+                ", " JLONG_FORMAT " lost, %d owner stacks not walkable",
+                _samples, MonitorContentionSampleInterval, _lost_samples, _unwalkable_owners);
+  if (_waiters == NULL) {
+    return;
+  }
+  out->print_cr("Blocked waiters:");
+  print_table(out, _waiters, true, limit);
+  out->print_cr("Owners releasing to sampled waiters:");
+  print_table(out, _owners, false, limit);
+}
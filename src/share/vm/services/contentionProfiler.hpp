@@ -0,0 +1,104 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_SERVICES_CONTENTIONPROFILER_HPP
+#define SHARE_VM_SERVICES_CONTENTIONPROFILER_HPP
+
+#include "memory/allocation.hpp"
+#include "runtime/globals.hpp"
+#include "utilities/ostream.hpp"
+
+class ContentionProfilerSite;
+class JavaThread;
+class ObjectMonitor;
+
+// The stack of a thread, callee first, as jmethodIDs and bcis.
+class ContentionStack : public CHeapObj<mtInternal> {
+ public:
+  enum { max_frames = 32 };   // deeper stacks are truncated at the root
+
+  int       _num_frames;
+  jmethodID _methods[max_frames];
+  int       _bcis[max_frames];
+
+  // Walks the stack of the current thread, which must be in the VM and
+  // may block to create jmethodIDs.
+  void fill(JavaThread* thread);
+};
+
+// ContentionProfiler records a sample of the contended enters of Java
+// monitors, i.e. the ones that had to block in ObjectMonitor::EnterI,
+// when MonitorContentionSampleInterval is set, and aggregates them:
+//
+//  - per class of the locked object and stack of the blocked thread,
+//    how many enters there were and how long they were blocked;
+//  - per class and stack of the owning thread, how many times it
+//    released a monitor a sampled thread was blocked on.
+//
+// Monitor.contention prints both tables, longest total blocked time and
+// most releases first. Recording takes place only on the slow path of
+// the waiter, which is about to block anyway, and in exit() of an owner
+// that a sampled waiter blocked on.
+class ContentionProfiler : AllStatic {
+  friend class ContentionProfilerSite;
+ public:
+  enum {
+    table_size = 257,
+    max_sites  = 8192         // distinct sites kept in both tables
+  };
+
+ private:
+  static ContentionProfilerSite** _waiters;  // protected by ContentionProfiler_lock
+  static ContentionProfilerSite** _owners;   // protected by ContentionProfiler_lock
+  static int                      _num_sites;
+  static jlong                    _samples;
+  static jlong                    _lost_samples;   // too many sites
+  static volatile jint            _unwalkable_owners;
+  static volatile intx            _countdown;
+
+  static void add(ContentionProfilerSite** table, Symbol* klass_name,
+                  const ContentionStack* stack, jlong blocked_nanos);
+  static void clear();
+  static void print_table(outputStream* out, ContentionProfilerSite** table,
+                          bool waiters, int limit);
+
+ public:
+  // Counts down from MonitorContentionSampleInterval at each contended enter.
+  static bool should_sample() {
+    return MonitorContentionSampleInterval > 0 && sample_next();
+  }
+  static bool sample_next();
+
+  // A waiter acquired the monitor after blocking for blocked_nanos.
+  static void record_enter(ObjectMonitor* monitor, const ContentionStack* stack,
+                           jlong blocked_nanos);
+  // The current owner releases a monitor a sampled waiter blocks on.
+  static void record_exit(ObjectMonitor* monitor, JavaThread* owner);
+
+  // Print at most limit sites of each kind; limit <= 0 prints all.
+  static void print_on(outputStream* out, int limit);
+  static void reset();
+};
+
+#endif // SHARE_VM_SERVICES_CONTENTIONPROFILER_HPP
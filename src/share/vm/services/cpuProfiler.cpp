@@ -0,0 +1,331 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "memory/resourceArea.hpp"
+#include "oops/method.hpp"
+#include "prims/forte.hpp"
+#include "runtime/atomic.inline.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/orderAccess.inline.hpp"
+#include "runtime/os.hpp"
+#include "runtime/task.hpp"
+#include "runtime/thread.inline.hpp"
+#include "services/cpuProfiler.hpp"
+
+// The samples of one thread. The sampler is the only writer of _head and
+// the aggregator, serialized by CPUProfiler_lock, the only writer of _tail.
+class CPUProfilerBuffer : public CHeapObj<mtInternal> {
+  friend class CPUProfiler;
+ private:
+  struct Sample {
+    int       _num_frames;
+    jmethodID _frames[CPUProfiler::max_frames];   // callee first
+  };
+
+  CPUProfilerBuffer* _next;            // protected by CPUProfiler_lock
+  volatile jint      _exited;          // the thread is gone
+  volatile juint     _head;            // samples written
+  volatile juint     _tail;            // samples read
+  Sample             _samples[CPUProfiler::buffer_samples];
+
+  CPUProfilerBuffer() : _next(NULL), _exited(0), _head(0), _tail(0) {}
+
+  // Sampler side
+  Sample* next_free() {
+    if (_head - OrderAccess::load_acquire(&_tail) == CPUProfiler::buffer_samples) {
+      return NULL;
+    }
+    return &_samples[_head % CPUProfiler::buffer_samples];
+  }
+  void publish()      { OrderAccess::release_store(&_head, _head + 1); }
+
+  // Aggregator side
+  Sample* next_used() {
+    if (_tail == OrderAccess::load_acquire(&_head)) {
+      return NULL;
+    }
+    return &_samples[_tail % CPUProfiler::buffer_samples];
+  }
+  void release()      { OrderAccess::release_store(&_tail, _tail + 1); }
+};
+
+// A distinct stack and the number of times it was sampled.
+class CPUProfilerStack : public CHeapObj<mtInternal> {
+  friend class CPUProfiler;
+ private:
+  CPUProfilerStack* _next;
+  unsigned int      _hash;
+  int               _num_frames;
+  jlong             _count;
+  jmethodID*        _frames;           // callee first
+
+  CPUProfilerStack(unsigned int hash, int num_frames, jmethodID* frames) :
+    _next(NULL), _hash(hash), _num_frames(num_frames), _count(1) {
+    _frames = NEW_C_HEAP_ARRAY(jmethodID, num_frames, mtInternal);
+    memcpy(_frames, frames, num_frames * sizeof(jmethodID));
+  }
+  ~CPUProfilerStack() {
+    FREE_C_HEAP_ARRAY(jmethodID, _frames, mtInternal);
+  }
+};
+
+class CPUProfilerTask : public PeriodicTask {
+ public:
+  CPUProfilerTask(int interval_time) : PeriodicTask(interval_time) {}
+  void task() { CPUProfiler::sample_threads(); }
+};
+
+// Walks the stack of a thread while the thread is suspended.
+class CPUSampleTask : public os::SuspendedThreadTask {
+ private:
+  Method** _methods;
+  int      _num_frames;
+ public:
+  CPUSampleTask(JavaThread* thread, Method** methods) :
+    os::SuspendedThreadTask(thread), _methods(methods), _num_frames(0) {}
+  int num_frames() const { return _num_frames; }
+  void do_task(const os::SuspendedThreadTaskContext& context) {
+    if (context.ucontext() != NULL) {
+      _num_frames = Forte::get_call_trace((JavaThread*)context.thread(), context.ucontext(),
+                                          CPUProfiler::max_frames, _methods);
+    }
+  }
+};
+
+CPUProfilerTask*   CPUProfiler::_task         = NULL;
+CPUProfilerBuffer* CPUProfiler::_buffers      = NULL;
+CPUProfilerStack** CPUProfiler::_table        = NULL;
+volatile bool      CPUProfiler::_has_samples  = false;
+int                CPUProfiler::_num_stacks   = 0;
+jlong              CPUProfiler::_samples      = 0;
+volatile jint      CPUProfiler::_lost_samples = 0;
+jlong              CPUProfiler::_missed_ticks = 0;
+
+void CPUProfiler::sample_threads() {
+  // Holding the Threads_lock keeps the threads from exiting and, as no
+  // safepoint can begin, the sampled methods from being unloaded until
+  // their jmethodIDs are taken. Like the FlatProfiler, don't wait for it.
+  if (!Threads_lock->try_lock()) {
+    _missed_ticks++;
+    return;
+  }
+  bool sampled = false;
+  for (JavaThread* thread = Threads::first(); thread != NULL; thread = thread->next()) {
+    JavaThreadState state = thread->thread_state();
+    if ((state == _thread_in_Java || state == _thread_in_Java_trans || state == _thread_in_vm) &&
+        !thread->is_exiting()) {
+      sampled |= sample_thread(thread);
+    }
+  }
+  Threads_lock->unlock();
+
+  if (sampled) {
+    MutexLockerEx ml(Service_lock, Mutex::_no_safepoint_check_flag);
+    _has_samples = true;
+    Service_lock->notify_all();
+  }
+}
+
+bool CPUProfiler::sample_thread(JavaThread* thread) {
+  CPUProfilerBuffer* buffer = thread->cpu_profiler_buffer();
+  if (buffer == NULL) {
+    // Don't wait for the lock either: its owner may be stopped for a
+    // safepoint, which cannot begin while we hold the Threads_lock.
+    if (!CPUProfiler_lock->try_lock()) {
+      Atomic::inc(&_lost_samples);
+      return false;
+    }
+    buffer = new CPUProfilerBuffer();
+    buffer->_next = _buffers;
+    _buffers = buffer;
+    CPUProfiler_lock->unlock();
+    thread->set_cpu_profiler_buffer(buffer);
+  }
+
+  CPUProfilerBuffer::Sample* sample = buffer->next_free();
+  if (sample == NULL) {
+    Atomic::inc(&_lost_samples);
+    return false;
+  }
+
+  Method* methods[max_frames];
+  CPUSampleTask task(thread, methods);
+  task.run();
+  int num_frames = task.num_frames();
+  if (num_frames <= 0) {
+    if (num_frames < 0) {
+      Atomic::inc(&_lost_samples);
+    }
+    return false;
+  }
+
+  // The thread runs again, so taking locks to create jmethodIDs is safe.
+  for (int i = 0; i < num_frames; i++) {
+    sample->_frames[i] = methods[i]->jmethod_id();
+  }
+  sample->_num_frames = num_frames;
+  buffer->publish();
+  return true;
+}
+
+void CPUProfiler::drain_buffers(bool aggregate) {
+  assert_lock_strong(CPUProfiler_lock);
+  CPUProfilerBuffer** p = &_buffers;
+  while (*p != NULL) {
+    CPUProfilerBuffer* buffer = *p;
+    // Read before draining, so that no sample is left in a freed buffer.
+    bool exited = OrderAccess::load_acquire(&buffer->_exited) != 0;
+    CPUProfilerBuffer::Sample* sample;
+    while ((sample = buffer->next_used()) != NULL) {
+      if (aggregate) {
+        add_stack(sample->_num_frames, sample->_frames);
+      }
+      buffer->release();
+    }
+    if (exited) {
+      *p = buffer->_next;
+      delete buffer;
+    } else {
+      p = &buffer->_next;
+    }
+  }
+}
+
+void CPUProfiler::add_stack(int num_frames, jmethodID* frames) {
+  unsigned int hash = num_frames;
+  for (int i = 0; i < num_frames; i++) {
+    hash = 31 * hash + (unsigned int)((uintptr_t)frames[i] >> LogBytesPerWord);
+  }
+  CPUProfilerStack** bucket = &_table[hash % table_size];
+  for (CPUProfilerStack* s = *bucket; s != NULL; s = s->_next) {
+    if (s->_hash == hash && s->_num_frames == num_frames &&
+        memcmp(s->_frames, frames, num_frames * sizeof(jmethodID)) == 0) {
+      s->_count++;
+      _samples++;
+      return;
+    }
+  }
+  if (_num_stacks >= max_stacks) {
+    Atomic::inc(&_lost_samples);
+    return;
+  }
+  CPUProfilerStack* s = new CPUProfilerStack(hash, num_frames, frames);
+  s->_next = *bucket;
+  *bucket = s;
+  _num_stacks++;
+  _samples++;
+}
+
+void CPUProfiler::clear_table() {
+  assert_lock_strong(CPUProfiler_lock);
+  if (_table == NULL) {
+    _table = NEW_C_HEAP_ARRAY(CPUProfilerStack*, table_size, mtInternal);
+  } else {
+    for (int i = 0; i < table_size; i++) {
+      CPUProfilerStack* s = _table[i];
+      while (s != NULL) {
+        CPUProfilerStack* next = s->_next;
+        delete s;
+        s = next;
+      }
+    }
+  }
+  memset(_table, 0, table_size * sizeof(CPUProfilerStack*));
+  _num_stacks = 0;
+  _samples = 0;
+  _lost_samples = 0;
+}
+
+bool CPUProfiler::start(int interval_ms) {
+  // The PeriodicTask_lock also keeps the task from running meanwhile.
+  MutexLocker ml(PeriodicTask_lock);
+  if (_task != NULL) {
+    return false;
+  }
+  {
+    MutexLocker ml2(CPUProfiler_lock);
+    drain_buffers(false);
+    clear_table();
+  }
+  _missed_ticks = 0;
+  _task = new CPUProfilerTask(interval_ms);
+  _task->enroll();
+  return true;
+}
+
+bool CPUProfiler::stop() {
+  MutexLocker ml(PeriodicTask_lock);
+  if (_task == NULL) {
+    return false;
+  }
+  delete _task;   // disenrolls it
+  _task = NULL;
+  MutexLocker ml2(CPUProfiler_lock);
+  drain_buffers(true);
+  return true;
+}
+
+void CPUProfiler::process_samples() {
+  _has_samples = false;
+  MutexLocker ml(CPUProfiler_lock);
+  drain_buffers(_table != NULL);
+}
+
+void CPUProfiler::dump(outputStream* out) {
+  MutexLocker ml(CPUProfiler_lock);
+  if (_table == NULL) {
+    return;
+  }
+  drain_buffers(true);
+  for (int i = 0; i < table_size; i++) {
+    for (CPUProfilerStack* s = _table[i]; s != NULL; s = s->_next) {
+      ResourceMark rm;
+      for (int f = s->_num_frames - 1; f >= 0; f--) {
+        Method* m = Method::checked_resolve_jmethod_id(s->_frames[f]);
+        if (m == NULL) {
+          out->print("<unloaded>");
+        } else {
+          out->print("%s.%s", m->method_holder()->external_name(), m->name()->as_C_string());
+        }
+        out->print(f > 0 ? ";" : " ");
+      }
+      out->print_cr(JLONG_FORMAT, s->_count);
+    }
+  }
+}
+
+void CPUProfiler::print_summary(outputStream* out) {
+  MutexLocker ml(CPUProfiler_lock);
+  out->print_cr("%s, " JLONG_FORMAT " samples in %d stacks, %d samples lost, "
+                JLONG_FORMAT " ticks missed",
+                is_running() ? "running" : "stopped",
+                _samples, _num_stacks, _lost_samples, _missed_ticks);
+}
+
+void CPUProfiler::thread_exit(JavaThread* thread) {
+  CPUProfilerBuffer* buffer = thread->cpu_profiler_buffer();
+  thread->set_cpu_profiler_buffer(NULL);
+  OrderAccess::release_store(&buffer->_exited, 1);
+}
@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_SERVICES_CPUPROFILER_HPP
+#define SHARE_VM_SERVICES_CPUPROFILER_HPP
+
+#include "memory/allocation.hpp"
+#include "utilities/ostream.hpp"
+
+class CPUProfilerBuffer;
+class CPUProfilerStack;
+class CPUProfilerTask;
+class JavaThread;
+
+// CPUProfiler periodically samples the Java stacks of the threads that
+// run Java or VM code, without bringing them to a safepoint, and counts
+// how often each distinct stack was seen.
+//
+//  - On the WatcherThread, CPUProfilerTask suspends each running thread
+//    in turn with an os::SuspendedThreadTask and walks its stack from the
+//    interrupted register state with the walker behind AsyncGetCallTrace
+//    (Forte::get_call_trace()). The frames are stored as jmethodIDs in a
+//    ring buffer of the thread, written by the sampler and read by the
+//    aggregator without locking.
+//  - The ServiceThread drains the ring buffers into a table of stacks.
+//  - Profiler.dump prints the table in collapsed-stack format: one stack
+//    per line, outermost frame first, followed by its sample count:
+//      java.lang.Thread.run;Worker.run;Worker.hash 42
+//
+// Threads blocked or in native code are not sampled, so the counts
+// approximate where the CPU time of Java threads goes.
+class CPUProfiler : AllStatic {
+  friend class CPUProfilerTask;
+ public:
+  enum {
+    max_frames     = 64,      // deeper stacks are truncated at the root
+    buffer_samples = 32,      // samples per thread between two drains
+    table_size     = 1009,
+    max_stacks     = 65536    // distinct stacks kept
+  };
+
+ private:
+  static CPUProfilerTask*   _task;
+  static CPUProfilerBuffer* _buffers;        // protected by CPUProfiler_lock
+  static CPUProfilerStack** _table;          // protected by CPUProfiler_lock
+  static volatile bool      _has_samples;
+  static int                _num_stacks;
+  static jlong              _samples;        // aggregated
+  static volatile jint      _lost_samples;   // stack not walkable or buffer full
+  static jlong              _missed_ticks;   // Threads_lock was busy
+
+  static void sample_threads();
+  static bool sample_thread(JavaThread* thread);
+  static void drain_buffers(bool aggregate);
+  static void add_stack(int num_frames, jmethodID* frames);
+  static void clear_table();
+
+ public:
+  // Start sampling every interval_ms milliseconds, forgetting previous
+  // samples. Returns false if the profiler is already running.
+  static bool start(int interval_ms);
+  // Stop sampling, keeping the samples for dump(). Returns false if the
+  // profiler is not running.
+  static bool stop();
+  static bool is_running()   { return _task != NULL; }
+
+  // Print the stacks sampled since the last start().
+  static void dump(outputStream* out);
+  static void print_summary(outputStream* out);
+
+  // For the ServiceThread
+  static bool has_samples()  { return _has_samples; }
+  static void process_samples();
+
+  // The thread is gone; its buffer is freed once drained.
+  static void thread_exit(JavaThread* thread);
+};
+
+#endif // SHARE_VM_SERVICES_CPUPROFILER_HPP
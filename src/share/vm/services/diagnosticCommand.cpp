@@ -24,14 +24,24 @@
 
 #include "precompiled.hpp"
 #include "classfile/classLoaderStats.hpp"
+#include "classfile/symbolTable.hpp"
+#include "code/codeCache.hpp"
+#include "code/perfMap.hpp"
+#include "compiler/hotMethods.hpp"
 #include "gc_implementation/shared/vmGCOperations.hpp"
 #include "runtime/javaCalls.hpp"
+#include "runtime/mutexLocker.hpp"
 #include "runtime/os.hpp"
+#include "runtime/task.hpp"
+#include "services/contentionProfiler.hpp"
+#include "services/cpuProfiler.hpp"
 #include "services/diagnosticArgument.hpp"
 #include "services/diagnosticCommand.hpp"
 #include "services/diagnosticFramework.hpp"
 #include "services/heapDumper.hpp"
 #include "services/management.hpp"
+#include "services/threadService.hpp"
+#include "trace/traceRecorder.hpp"
 #include "utilities/macros.hpp"
 #include "oops/objArrayOop.hpp"
 
@@ -61,8 +71,23 @@ void DCmdRegistrant::register_dcmds(){
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<ClassStatsDCmd>(full_export, true, false));
 #endif // INCLUDE_SERVICES
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<ThreadDumpDCmd>(full_export, true, false));
+  DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<HotMethodsDCmd>(DCmd_Source_Internal | DCmd_Source_AttachAPI, true, false));
+  DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<CodeCacheDCmd>(full_export, true, false));
+  DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<PerfMapDCmd>(full_export, true, false));
+  DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<ProfilerStartDCmd>(full_export, true, false));
+  DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<ProfilerStopDCmd>(full_export, true, false));
+  DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<ProfilerDumpDCmd>(full_export, true, false));
+  DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<MonitorContentionDCmd>(full_export, true, false));
+#if INCLUDE_TRACE
+  DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<TraceStartDCmd>(full_export, true, false));
+  DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<TraceStopDCmd>(full_export, true, false));
+  DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<TraceConfigureDCmd>(full_export, true, false));
+#endif // INCLUDE_TRACE
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<RotateGCLogDCmd>(full_export, true, false));
   DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<ClassLoaderStatsDCmd>(full_export, true, false));
+  DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<StringtableDCmd>(full_export, true, false));
+  DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<SymboltableDCmd>(full_export, true, false));
+  DCmdFactory::register_DCmdFactory(new DCmdFactoryImpl<MutexStatisticsDCmd>(full_export, true, false));
 
   // Enhanced JMX Agent Support
   // These commands won't be exported via the DiagnosticCommandMBean until an
@@ -339,8 +364,11 @@ HeapDumpDCmd::HeapDumpDCmd(outputStream* output, bool heap) :
                            DCmdWithParser(output, heap),
   _filename("filename","Name of the dump file", "STRING",true),
   _all("-all", "Dump all objects, including unreachable objects",
-       "BOOLEAN", false, "false") {
+       "BOOLEAN", false, "false"),
+  _parallel("-parallel", "Number of GC threads to dump the objects with, "
+            "0 for all of them (G1 only)", "INT", false, "0") {
   _dcmdparser.add_dcmd_option(&_all);
+  _dcmdparser.add_dcmd_option(&_parallel);
   _dcmdparser.add_dcmd_argument(&_filename);
 }
 
@@ -348,8 +376,13 @@ void HeapDumpDCmd::execute(DCmdSource source, TRAPS) {
   // Request a full GC before heap dump if _all is false
   // This helps reduces the amount of unreachable objects in the dump
   // and makes it easier to browse.
+  if (_parallel.value() < 0) {
+    output()->print_cr("Invalid number of parallel dump threads: " JLONG_FORMAT,
+                       _parallel.value());
+    return;
+  }
   HeapDumper dumper(!_all.value() /* request GC if _all is false*/);
-  int res = dumper.dump(_filename.value());
+  int res = dumper.dump(_filename.value(), (uint)MIN2(_parallel.value(), (jlong)max_juint));
   if (res == 0) {
     output()->print_cr("Heap dump file created");
   } else {
@@ -378,13 +411,22 @@ int HeapDumpDCmd::num_arguments() {
 ClassHistogramDCmd::ClassHistogramDCmd(outputStream* output, bool heap) :
                                        DCmdWithParser(output, heap),
   _all("-all", "Inspect all objects, including unreachable objects",
-       "BOOLEAN", false, "false") {
+       "BOOLEAN", false, "false"),
+  _parallel("-parallel", "Number of GC threads to walk the heap with, "
+            "0 for all of them (G1 only)", "INT", false, "0") {
   _dcmdparser.add_dcmd_option(&_all);
+  _dcmdparser.add_dcmd_option(&_parallel);
 }
 
 void ClassHistogramDCmd::execute(DCmdSource source, TRAPS) {
+  if (_parallel.value() < 0) {
+    output()->print_cr("Invalid number of parallel threads: " JLONG_FORMAT,
+                       _parallel.value());
+    return;
+  }
   VM_GC_HeapInspection heapop(output(),
                               !_all.value() /* request full gc if false */);
+  heapop.set_parallel_thread_num((uint)MIN2(_parallel.value(), (jlong)max_juint));
   VMThread::execute(&heapop);
 }
 
@@ -457,13 +499,272 @@ int ClassStatsDCmd::num_arguments() {
 }
 #endif // INCLUDE_SERVICES
 
+HotMethodsDCmd::HotMethodsDCmd(outputStream* output, bool heap) :
+                               DCmdWithParser(output, heap),
+  _filename("filename", "Name of the file to write", "STRING", true) {
+  _dcmdparser.add_dcmd_argument(&_filename);
+}
+
+void HotMethodsDCmd::execute(DCmdSource source, TRAPS) {
+  int count = HotMethods::dump(_filename.value());
+  if (count < 0) {
+    output()->print_cr("Cannot create file %s", _filename.value());
+  } else {
+    output()->print_cr("%d hot methods written to %s", count, _filename.value());
+  }
+}
+
+int HotMethodsDCmd::num_arguments() {
+  ResourceMark rm;
+  HotMethodsDCmd* dcmd = new HotMethodsDCmd(NULL, false);
+  if (dcmd != NULL) {
+    DCmdMark mark(dcmd);
+    return dcmd->_dcmdparser.num_arguments();
+  } else {
+    return 0;
+  }
+}
+
+CodeCacheDCmd::CodeCacheDCmd(outputStream* output, bool heap) :
+                             DCmdWithParser(output, heap),
+  _top("-top", "Number of largest blobs to print", "INT", false, "10") {
+  _dcmdparser.add_dcmd_option(&_top);
+}
+
+void CodeCacheDCmd::execute(DCmdSource source, TRAPS) {
+  if (_top.value() < 0) {
+    output()->print_cr("Top must not be negative");
+    return;
+  }
+  CodeCache::print_analytics(output(), (int)MIN2(_top.value(), (jlong)1000));
+}
+
+int CodeCacheDCmd::num_arguments() {
+  ResourceMark rm;
+  CodeCacheDCmd* dcmd = new CodeCacheDCmd(NULL, false);
+  if (dcmd != NULL) {
+    DCmdMark mark(dcmd);
+    return dcmd->_dcmdparser.num_arguments();
+  } else {
+    return 0;
+  }
+}
+
+void PerfMapDCmd::execute(DCmdSource source, TRAPS) {
+  PerfMap::write_snapshot(output());
+}
+
+ProfilerStartDCmd::ProfilerStartDCmd(outputStream* output, bool heap) :
+                                     DCmdWithParser(output, heap),
+  _interval("-interval", "Sampling interval in milliseconds, a multiple of 10",
+            "INT", false, "10") {
+  _dcmdparser.add_dcmd_option(&_interval);
+}
+
+void ProfilerStartDCmd::execute(DCmdSource source, TRAPS) {
+  jlong interval = _interval.value();
+  if (interval < PeriodicTask::min_interval || interval >= PeriodicTask::max_interval ||
+      interval % PeriodicTask::interval_gran != 0) {
+    output()->print_cr("Interval must be a multiple of %d between %d and %d ms",
+                       PeriodicTask::interval_gran, PeriodicTask::min_interval,
+                       PeriodicTask::max_interval - 1);
+    return;
+  }
+  if (CPUProfiler::start((int)interval)) {
+    output()->print_cr("Profiler started, sampling every " JLONG_FORMAT " ms", interval);
+  } else {
+    output()->print_cr("Profiler is already running");
+  }
+}
+
+int ProfilerStartDCmd::num_arguments() {
+  ResourceMark rm;
+  ProfilerStartDCmd* dcmd = new ProfilerStartDCmd(NULL, false);
+  if (dcmd != NULL) {
+    DCmdMark mark(dcmd);
+    return dcmd->_dcmdparser.num_arguments();
+  } else {
+    return 0;
+  }
+}
+
+void ProfilerStopDCmd::execute(DCmdSource source, TRAPS) {
+  if (CPUProfiler::stop()) {
+    output()->print("Profiler stopped: ");
+  } else {
+    output()->print("Profiler is not running: ");
+  }
+  CPUProfiler::print_summary(output());
+}
+
+ProfilerDumpDCmd::ProfilerDumpDCmd(outputStream* output, bool heap) :
+                                   DCmdWithParser(output, heap),
+  _filename("filename", "Name of the file to write, instead of the command output",
+            "STRING", false) {
+  _dcmdparser.add_dcmd_argument(&_filename);
+}
+
+void ProfilerDumpDCmd::execute(DCmdSource source, TRAPS) {
+  if (_filename.is_set()) {
+    fileStream fs(_filename.value(), "w");
+    if (!fs.is_open()) {
+      output()->print_cr("Cannot create file %s", _filename.value());
+      return;
+    }
+    CPUProfiler::dump(&fs);
+    output()->print("Stacks written to %s: ", _filename.value());
+  } else {
+    CPUProfiler::dump(output());
+  }
+  CPUProfiler::print_summary(output());
+}
+
+int ProfilerDumpDCmd::num_arguments() {
+  ResourceMark rm;
+  ProfilerDumpDCmd* dcmd = new ProfilerDumpDCmd(NULL, false);
+  if (dcmd != NULL) {
+    DCmdMark mark(dcmd);
+    return dcmd->_dcmdparser.num_arguments();
+  } else {
+    return 0;
+  }
+}
+
+MonitorContentionDCmd::MonitorContentionDCmd(outputStream* output, bool heap) :
+                                             DCmdWithParser(output, heap),
+  _limit("-limit", "Number of sites of each kind to print, 0 for all",
+         "INT", false, "20"),
+  _reset("-reset", "Discard the samples after printing them", "BOOLEAN", false, "false") {
+  _dcmdparser.add_dcmd_option(&_limit);
+  _dcmdparser.add_dcmd_option(&_reset);
+}
+
+void MonitorContentionDCmd::execute(DCmdSource source, TRAPS) {
+  if (_limit.value() < 0) {
+    output()->print_cr("Limit must not be negative");
+    return;
+  }
+  ContentionProfiler::print_on(output(), (int)MIN2(_limit.value(), (jlong)max_jint));
+  if (_reset.value()) {
+    ContentionProfiler::reset();
+  }
+}
+
+int MonitorContentionDCmd::num_arguments() {
+  ResourceMark rm;
+  MonitorContentionDCmd* dcmd = new MonitorContentionDCmd(NULL, false);
+  if (dcmd != NULL) {
+    DCmdMark mark(dcmd);
+    return dcmd->_dcmdparser.num_arguments();
+  } else {
+    return 0;
+  }
+}
+
+#if INCLUDE_TRACE
+TraceStartDCmd::TraceStartDCmd(outputStream* output, bool heap) :
+                               DCmdWithParser(output, heap),
+  _filename("filename", "Name of the file to record to", "STRING", true) {
+  _dcmdparser.add_dcmd_argument(&_filename);
+}
+
+void TraceStartDCmd::execute(DCmdSource source, TRAPS) {
+  if (TraceRecorder::start(_filename.value(), output())) {
+    output()->print_cr("Trace recording started, writing to %s", _filename.value());
+  }
+}
+
+int TraceStartDCmd::num_arguments() {
+  ResourceMark rm;
+  TraceStartDCmd* dcmd = new TraceStartDCmd(NULL, false);
+  if (dcmd != NULL) {
+    DCmdMark mark(dcmd);
+    return dcmd->_dcmdparser.num_arguments();
+  } else {
+    return 0;
+  }
+}
+
+void TraceStopDCmd::execute(DCmdSource source, TRAPS) {
+  if (TraceRecorder::stop()) {
+    output()->print("Trace recording stopped: ");
+  } else {
+    output()->print("Not recording: ");
+  }
+  TraceRecorder::print_summary(output());
+}
+
+TraceConfigureDCmd::TraceConfigureDCmd(outputStream* output, bool heap) :
+                                       DCmdWithParser(output, heap),
+  _event("event", "Name of the event, or all", "STRING", false),
+  _enabled("-enabled", "Record the event", "BOOLEAN", false, "true"),
+  _threshold("-threshold", "Do not record the event if it took less time",
+             "NANOTIME", false) {
+  _dcmdparser.add_dcmd_argument(&_event);
+  _dcmdparser.add_dcmd_option(&_enabled);
+  _dcmdparser.add_dcmd_option(&_threshold);
+}
+
+void TraceConfigureDCmd::execute(DCmdSource source, TRAPS) {
+  if (!_event.is_set()) {
+    TraceRecorder::print_settings(output());
+    return;
+  }
+  jlong threshold = -1;
+  if (_threshold.is_set()) {
+    threshold = _threshold.value()._nanotime;
+    if (threshold < 0) {
+      output()->print_cr("Threshold must not be negative");
+      return;
+    }
+  }
+  const char* name = _event.value();
+  if (strcmp(name, "all") == 0) {
+    for (int id = NUM_RESERVED_EVENTS; id < MaxTraceEventId; id++) {
+      TraceRecorder::configure((TraceEventId)id, _enabled.value(), threshold);
+    }
+  } else {
+    TraceEventId id = TraceRecorder::find_event(name);
+    if (id == MaxTraceEventId) {
+      output()->print_cr("Unknown event %s", name);
+      return;
+    }
+    TraceRecorder::configure(id, _enabled.value(), threshold);
+  }
+  output()->print_cr("Configured %s", name);
+}
+
+int TraceConfigureDCmd::num_arguments() {
+  ResourceMark rm;
+  TraceConfigureDCmd* dcmd = new TraceConfigureDCmd(NULL, false);
+  if (dcmd != NULL) {
+    DCmdMark mark(dcmd);
+    return dcmd->_dcmdparser.num_arguments();
+  } else {
+    return 0;
+  }
+}
+#endif // INCLUDE_TRACE
+
 ThreadDumpDCmd::ThreadDumpDCmd(outputStream* output, bool heap) :
                                DCmdWithParser(output, heap),
-  _locks("-l", "print java.util.concurrent locks", "BOOLEAN", false, "false") {
+  _locks("-l", "print java.util.concurrent locks", "BOOLEAN", false, "false"),
+  _fast("-fast", "print the stacks without a safepoint, stopping one thread at a time; "
+        "locks and deadlocks are only analyzed with -l", "BOOLEAN", false, "false") {
   _dcmdparser.add_dcmd_option(&_locks);
+  _dcmdparser.add_dcmd_option(&_fast);
 }
 
 void ThreadDumpDCmd::execute(DCmdSource source, TRAPS) {
+  if (_fast.value()) {
+    ThreadService::print_stacks_without_safepoint(output());
+    if (_locks.value()) {
+      VM_FindDeadlocks op(output());
+      VMThread::execute(&op);
+    }
+    return;
+  }
+
   // thread stacks
   VM_PrintThreads op1(output(), _locks.value());
   VMThread::execute(&op1);
@@ -736,3 +1037,19 @@ void RotateGCLogDCmd::execute(DCmdSource source, TRAPS) {
     output()->print_cr("Target VM does not support GC log file rotation.");
   }
 }
+
+// The tables are only replaced at safepoints, which cannot happen while
+// this thread walks them in VM state. The locks keep out concurrent adds.
+void StringtableDCmd::execute(DCmdSource source, TRAPS) {
+  MutexLocker ml(StringTable_lock, THREAD);
+  StringTable::dump(output());
+}
+
+void SymboltableDCmd::execute(DCmdSource source, TRAPS) {
+  MutexLocker ml(SymbolTable_lock, THREAD);
+  SymbolTable::dump(output());
+}
+
+void MutexStatisticsDCmd::execute(DCmdSource source, TRAPS) {
+  print_mutex_statistics(output());
+}
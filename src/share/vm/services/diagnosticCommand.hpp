@@ -245,6 +245,7 @@ class HeapDumpDCmd : public DCmdWithParser {
 protected:
   DCmdArgument<char*> _filename;
   DCmdArgument<bool>  _all;
+  DCmdArgument<jlong> _parallel;
 public:
   HeapDumpDCmd(outputStream* output, bool heap);
   static const char* name() {
@@ -267,10 +268,253 @@ public:
 };
 #endif // INCLUDE_SERVICES
 
+class HotMethodsDCmd : public DCmdWithParser {
+protected:
+  DCmdArgument<char*> _filename;
+public:
+  HotMethodsDCmd(outputStream* output, bool heap);
+  static const char* name() {
+    return "Compiler.hot_methods";
+  }
+  static const char* description() {
+    return "Write the methods with compiled code to a file, "
+           "for use with -XX:HotMethodsFile.";
+  }
+  static const char* impact() {
+    return "Medium: Depends on the number of compiled methods.";
+  }
+  static const JavaPermission permission() {
+    JavaPermission p = {"java.lang.management.ManagementPermission",
+                        "monitor", NULL};
+    return p;
+  }
+  static int num_arguments();
+  virtual void execute(DCmdSource source, TRAPS);
+};
+
+class CodeCacheDCmd : public DCmdWithParser {
+protected:
+  DCmdArgument<jlong> _top;
+public:
+  CodeCacheDCmd(outputStream* output, bool heap);
+  static const char* name() {
+    return "Compiler.codecache";
+  }
+  static const char* description() {
+    return "Print the code cache usage: the free blocks by size, the "
+           "nmethods by tier and by how recently they were active, and "
+           "the largest blobs.";
+  }
+  static const char* impact() {
+    return "Low: Depends on the size of the code cache.";
+  }
+  static const JavaPermission permission() {
+    JavaPermission p = {"java.lang.management.ManagementPermission",
+                        "monitor", NULL};
+    return p;
+  }
+  static int num_arguments();
+  virtual void execute(DCmdSource source, TRAPS);
+};
+
+class PerfMapDCmd : public DCmd {
+public:
+  PerfMapDCmd(outputStream* output, bool heap) : DCmd(output, heap) { }
+  static const char* name() {
+    return "Compiler.perfmap";
+  }
+  static const char* description() {
+    return "Write the symbols of the code in the code cache to "
+           "/tmp/perf-<pid>.map for the Linux perf tool, replacing the "
+           "entries written with -XX:+WritePerfMap.";
+  }
+  static const char* impact() {
+    return "Low: Depends on the size of the code cache.";
+  }
+  static const JavaPermission permission() {
+    JavaPermission p = {"java.lang.management.ManagementPermission",
+                        "monitor", NULL};
+    return p;
+  }
+  static int num_arguments() { return 0; }
+  virtual void execute(DCmdSource source, TRAPS);
+};
+
+class ProfilerStartDCmd : public DCmdWithParser {
+protected:
+  DCmdArgument<jlong> _interval;
+public:
+  ProfilerStartDCmd(outputStream* output, bool heap);
+  static const char* name() {
+    return "Profiler.start";
+  }
+  static const char* description() {
+    return "Start sampling the stacks of the threads running Java or VM code, "
+           "without safepoints. Samples of an earlier run are discarded.";
+  }
+  static const char* impact() {
+    return "Low: Each sample briefly suspends a running thread.";
+  }
+  static const JavaPermission permission() {
+    JavaPermission p = {"java.lang.management.ManagementPermission",
+                        "control", NULL};
+    return p;
+  }
+  static int num_arguments();
+  virtual void execute(DCmdSource source, TRAPS);
+};
+
+class ProfilerStopDCmd : public DCmd {
+public:
+  ProfilerStopDCmd(outputStream* output, bool heap) : DCmd(output, heap) { }
+  static const char* name() {
+    return "Profiler.stop";
+  }
+  static const char* description() {
+    return "Stop the sampling started by Profiler.start, keeping the samples.";
+  }
+  static const char* impact() {
+    return "Low";
+  }
+  static const JavaPermission permission() {
+    JavaPermission p = {"java.lang.management.ManagementPermission",
+                        "control", NULL};
+    return p;
+  }
+  static int num_arguments() { return 0; }
+  virtual void execute(DCmdSource source, TRAPS);
+};
+
+class ProfilerDumpDCmd : public DCmdWithParser {
+protected:
+  DCmdArgument<char*> _filename;
+public:
+  ProfilerDumpDCmd(outputStream* output, bool heap);
+  static const char* name() {
+    return "Profiler.dump";
+  }
+  static const char* description() {
+    return "Print the stacks sampled since Profiler.start in collapsed-stack "
+           "format: frames from the outermost one, separated by ';', "
+           "followed by the number of samples.";
+  }
+  static const char* impact() {
+    return "Low: Depends on the number of distinct stacks.";
+  }
+  static const JavaPermission permission() {
+    JavaPermission p = {"java.lang.management.ManagementPermission",
+                        "monitor", NULL};
+    return p;
+  }
+  static int num_arguments();
+  virtual void execute(DCmdSource source, TRAPS);
+};
+
+class MonitorContentionDCmd : public DCmdWithParser {
+protected:
+  DCmdArgument<jlong> _limit;
+  DCmdArgument<bool>  _reset;
+public:
+  MonitorContentionDCmd(outputStream* output, bool heap);
+  static const char* name() {
+    return "Monitor.contention";
+  }
+  static const char* description() {
+    return "Print the contended monitor enters sampled with "
+           "-XX:MonitorContentionSampleInterval, per class of the locked "
+           "object and stack: the blocked time of the waiters and the "
+           "releases by the owners.";
+  }
+  static const char* impact() {
+    return "Low: Depends on the number of distinct sites.";
+  }
+  static const JavaPermission permission() {
+    JavaPermission p = {"java.lang.management.ManagementPermission",
+                        "monitor", NULL};
+    return p;
+  }
+  static int num_arguments();
+  virtual void execute(DCmdSource source, TRAPS);
+};
+
+#if INCLUDE_TRACE
+class TraceStartDCmd : public DCmdWithParser {
+protected:
+  DCmdArgument<char*> _filename;
+public:
+  TraceStartDCmd(outputStream* output, bool heap);
+  static const char* name() {
+    return "Trace.start";
+  }
+  static const char* description() {
+    return "Start recording the enabled trace events into a binary file.";
+  }
+  static const char* impact() {
+    return "Low: Depends on the events enabled with Trace.configure.";
+  }
+  static const JavaPermission permission() {
+    JavaPermission p = {"java.lang.management.ManagementPermission",
+                        "control", NULL};
+    return p;
+  }
+  static int num_arguments();
+  virtual void execute(DCmdSource source, TRAPS);
+};
+
+class TraceStopDCmd : public DCmd {
+public:
+  TraceStopDCmd(outputStream* output, bool heap) : DCmd(output, heap) { }
+  static const char* name() {
+    return "Trace.stop";
+  }
+  static const char* description() {
+    return "Stop the trace recording, writing the remaining events to its file.";
+  }
+  static const char* impact() {
+    return "Low";
+  }
+  static const JavaPermission permission() {
+    JavaPermission p = {"java.lang.management.ManagementPermission",
+                        "control", NULL};
+    return p;
+  }
+  static int num_arguments() { return 0; }
+  virtual void execute(DCmdSource source, TRAPS);
+};
+
+class TraceConfigureDCmd : public DCmdWithParser {
+protected:
+  DCmdArgument<char*>            _event;
+  DCmdArgument<bool>             _enabled;
+  DCmdArgument<NanoTimeArgument> _threshold;
+public:
+  TraceConfigureDCmd(outputStream* output, bool heap);
+  static const char* name() {
+    return "Trace.configure";
+  }
+  static const char* description() {
+    return "Enable or disable a trace event, or all of them, and set the "
+           "duration below which it is not written. Without an event, print "
+           "the settings of all events.";
+  }
+  static const char* impact() {
+    return "Low";
+  }
+  static const JavaPermission permission() {
+    JavaPermission p = {"java.lang.management.ManagementPermission",
+                        "control", NULL};
+    return p;
+  }
+  static int num_arguments();
+  virtual void execute(DCmdSource source, TRAPS);
+};
+#endif // INCLUDE_TRACE
+
 // See also: inspectheap in attachListener.cpp
 class ClassHistogramDCmd : public DCmdWithParser {
 protected:
   DCmdArgument<bool> _all;
+  DCmdArgument<jlong> _parallel;
 public:
   ClassHistogramDCmd(outputStream* output, bool heap);
   static const char* name() {
@@ -316,6 +560,7 @@ public:
 class ThreadDumpDCmd : public DCmdWithParser {
 protected:
   DCmdArgument<bool> _locks;
+  DCmdArgument<bool> _fast;
 public:
   ThreadDumpDCmd(outputStream* output, bool heap);
   static const char* name() { return "Thread.print"; }
@@ -441,4 +686,61 @@ public:
   }
 };
 
+class StringtableDCmd : public DCmd {
+public:
+  StringtableDCmd(outputStream* output, bool heap) : DCmd(output, heap) {}
+  static const char* name() { return "VM.stringtable"; }
+  static const char* description() {
+    return "Print statistics of the interned string table.";
+  }
+  static const char* impact() {
+    return "Medium: Depends on the number of interned strings.";
+  }
+  static int num_arguments() { return 0; }
+  static const JavaPermission permission() {
+    JavaPermission p = {"java.lang.management.ManagementPermission",
+                        "monitor", NULL};
+    return p;
+  }
+  virtual void execute(DCmdSource source, TRAPS);
+};
+
+class SymboltableDCmd : public DCmd {
+public:
+  SymboltableDCmd(outputStream* output, bool heap) : DCmd(output, heap) {}
+  static const char* name() { return "VM.symboltable"; }
+  static const char* description() {
+    return "Print statistics of the symbol table.";
+  }
+  static const char* impact() {
+    return "Medium: Depends on the number of symbols.";
+  }
+  static int num_arguments() { return 0; }
+  static const JavaPermission permission() {
+    JavaPermission p = {"java.lang.management.ManagementPermission",
+                        "monitor", NULL};
+    return p;
+  }
+  virtual void execute(DCmdSource source, TRAPS);
+};
+
+class MutexStatisticsDCmd : public DCmd {
+public:
+  MutexStatisticsDCmd(outputStream* output, bool heap) : DCmd(output, heap) {}
+  static const char* name() { return "VM.mutex_statistics"; }
+  static const char* description() {
+    return "Print acquisition, contention, wait and hold time statistics of VM mutexes.";
+  }
+  static const char* impact() {
+    return "Low";
+  }
+  static int num_arguments() { return 0; }
+  static const JavaPermission permission() {
+    JavaPermission p = {"java.lang.management.ManagementPermission",
+                        "monitor", NULL};
+    return p;
+  }
+  virtual void execute(DCmdSource source, TRAPS);
+};
+
 #endif // SHARE_VM_SERVICES_DIAGNOSTICCOMMAND_HPP
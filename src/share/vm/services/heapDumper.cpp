@@ -41,7 +41,9 @@
 #include "services/threadService.hpp"
 #include "utilities/ostream.hpp"
 #include "utilities/macros.hpp"
+#include "utilities/workgroup.hpp"
 #if INCLUDE_ALL_GCS
+#include "gc_implementation/g1/g1CollectedHeap.hpp"
 #include "gc_implementation/parallelScavenge/parallelScavengeHeap.hpp"
 #endif // INCLUDE_ALL_GCS
 
@@ -369,10 +371,16 @@ enum {
 
 // Supports I/O operations on a dump file
 
+// A DumpWriter either writes to the dump file, or, as a segment writer,
+// collects HPROF_GC_* sub-records in memory and appends them to the file
+// of its parent as complete HPROF_HEAP_DUMP_SEGMENT records.  The latter
+// lets several threads dump the heap objects at the same time.
+
 class DumpWriter : public StackObj {
  private:
   enum {
-    io_buffer_size  = 8*M
+    io_buffer_size      = 8*M,
+    segment_buffer_size = 1*M   // segment writers append a segment once they have this much
   };
 
   int _fd;              // file descriptor (-1 if dump file not open)
@@ -384,6 +392,9 @@ class DumpWriter : public StackObj {
 
   char* _error;   // error message when I/O fails
 
+  DumpWriter* _parent;  // the writer of the dump file, for a segment writer
+  Mutex* _lock;         // serializes the segment writers of _parent
+
   void set_file_descriptor(int fd)              { _fd = fd; }
   int file_descriptor() const                   { return _fd; }
 
@@ -397,14 +408,28 @@ class DumpWriter : public StackObj {
   // all I/O go through this function
   void write_internal(void* s, size_t len);
 
+  // buffers len bytes of a segment writer, growing the buffer if needed
+  void write_to_segment(void* s, size_t len);
+  bool is_segment_writer() const        { return _parent != NULL; }
+
  public:
   DumpWriter(const char* path);
+  DumpWriter(DumpWriter* parent, Mutex* lock);
   ~DumpWriter();
 
   void close();
-  bool is_open() const                  { return file_descriptor() >= 0; }
+  bool is_open() const {
+    return is_segment_writer() ? (_error == NULL && _parent->is_open()) : file_descriptor() >= 0;
+  }
   void flush();
 
+  // used by a segment writer on a sub-record boundary
+  void end_of_record() {
+    if (position() >= segment_buffer_size) {
+      flush();
+    }
+  }
+
   // total number of bytes written to the disk
   julong bytes_written() const          { return _bytes_written; }
 
@@ -446,6 +471,8 @@ DumpWriter::DumpWriter(const char* path) {
   _pos = 0;
   _error = NULL;
   _bytes_written = 0L;
+  _parent = NULL;
+  _lock = NULL;
   _fd = os::create_binary_file(path, false);    // don't replace existing file
 
   // if the open failed we record the error
@@ -454,9 +481,24 @@ DumpWriter::DumpWriter(const char* path) {
   }
 }
 
+DumpWriter::DumpWriter(DumpWriter* parent, Mutex* lock) {
+  assert(!parent->is_segment_writer(), "segments are appended to the dump file");
+  _size = segment_buffer_size;
+  _buffer = (char*)os::malloc(_size, mtInternal);
+  if (_buffer == NULL) {
+    _size = 0;
+  }
+  _pos = 0;
+  _error = NULL;
+  _bytes_written = 0L;
+  _fd = -1;
+  _parent = parent;
+  _lock = lock;
+}
+
 DumpWriter::~DumpWriter() {
   // flush and close dump file
-  if (is_open()) {
+  if (is_open() || is_segment_writer()) {
     close();
   }
   if (_buffer != NULL) os::free(_buffer);
@@ -465,6 +507,18 @@ DumpWriter::~DumpWriter() {
 
 // closes dump file (if open)
 void DumpWriter::close() {
+  if (is_segment_writer()) {
+    // append the remaining records, and pass on any error
+    flush();
+    if (_error != NULL) {
+      MutexLockerEx ml(_lock, Mutex::_no_safepoint_check_flag);
+      if (_parent->error() == NULL) {
+        _parent->set_error(_error);
+      }
+    }
+    return;
+  }
+
   // flush and close dump file
   if (is_open()) {
     flush();
@@ -498,6 +552,10 @@ void DumpWriter::write_internal(void* s, size_t len) {
 
 // write raw bytes
 void DumpWriter::write_raw(void* s, size_t len) {
+  if (is_segment_writer()) {
+    write_to_segment(s, len);
+    return;
+  }
   if (is_open()) {
     // flush buffer to make room
     if ((position() + len) >= buffer_size()) {
@@ -515,8 +573,43 @@ void DumpWriter::write_raw(void* s, size_t len) {
   }
 }
 
+// A segment can only be appended on a sub-record boundary, so the buffer
+// of a segment writer grows to hold records larger than itself.
+void DumpWriter::write_to_segment(void* s, size_t len) {
+  if (is_open()) {
+    if ((position() + len) > buffer_size()) {
+      size_t new_size = MAX2(buffer_size() * 2, position() + len);
+      char* new_buffer = (char*)os::realloc(buffer(), new_size, mtInternal);
+      if (new_buffer == NULL) {
+        set_error("Unable to allocate a heap dump segment buffer");
+        return;
+      }
+      _buffer = new_buffer;
+      _size = new_size;
+    }
+    memcpy(buffer() + position(), s, len);
+    set_position(position() + len);
+  }
+}
+
 // flush any buffered bytes to the file
 void DumpWriter::flush() {
+  if (is_segment_writer()) {
+    // append the buffered records as a HPROF_HEAP_DUMP_SEGMENT record
+    if (is_open() && position() > 0) {
+      // record length must fit in a u4
+      if (position() > max_juint) {
+        warning("record is too large");
+      }
+      MutexLockerEx ml(_lock, Mutex::_no_safepoint_check_flag);
+      _parent->write_u1(HPROF_HEAP_DUMP_SEGMENT);
+      _parent->write_u4(0); // current ticks
+      _parent->write_u4((u4)position());
+      _parent->write_raw(buffer(), position());
+    }
+    set_position(0);
+    return;
+  }
   if (is_open() && position() > 0) {
     write_internal(buffer(), position());
     set_position(0);
@@ -524,6 +617,7 @@ void DumpWriter::flush() {
 }
 
 jlong DumpWriter::current_offset() {
+  assert(!is_segment_writer(), "a segment writer has no file offset");
   if (is_open()) {
     // the offset is the file offset plus whatever we have buffered
     jlong offset = os::current_file_offset(file_descriptor());
@@ -536,6 +630,7 @@ jlong DumpWriter::current_offset() {
 
 void DumpWriter::seek_to_offset(jlong off) {
   assert(off >= 0, "bad offset");
+  assert(!is_segment_writer(), "a segment writer has no file offset");
 
   // need to flush before seeking
   flush();
@@ -1298,7 +1393,9 @@ class StickyClassDumper : public KlassClosure {
 
 class VM_HeapDumper;
 
-// Support class using when iterating over the heap.
+// Support class using when iterating over the heap.  The dumper is NULL
+// when the objects are dumped in parallel, each thread with its own
+// segment writer.
 
 class HeapObjectDumper : public ObjectClosure {
  private:
@@ -1356,6 +1453,7 @@ class VM_HeapDumper : public VM_GC_Operation {
   JavaThread*           _oome_thread;
   Method*               _oome_constructor;
   bool _gc_before_heap_dump;
+  uint _num_dump_threads;
   bool _is_segmented_dump;
   jlong _dump_start;
   GrowableArray<Klass*>* _klass_map;
@@ -1383,6 +1481,14 @@ class VM_HeapDumper : public VM_GC_Operation {
 
   bool skip_operation() const;
 
+  // the number of GC worker threads to dump the heap objects with, or 0
+  // if the VM thread dumps them
+  uint parallel_dump_threads() const;
+
+  // HPROF_GC_INSTANCE_DUMP, HPROF_GC_OBJ_ARRAY_DUMP and
+  // HPROF_GC_PRIM_ARRAY_DUMP records
+  void dump_heap_objects();
+
   // writes a HPROF_LOAD_CLASS record
   static void do_load_class(Klass* k);
 
@@ -1416,13 +1522,15 @@ class VM_HeapDumper : public VM_GC_Operation {
   void end_of_dump();
 
  public:
-  VM_HeapDumper(DumpWriter* writer, bool gc_before_heap_dump, bool oome) :
+  VM_HeapDumper(DumpWriter* writer, bool gc_before_heap_dump, bool oome,
+                uint num_dump_threads = 0) :
     VM_GC_Operation(0 /* total collections,      dummy, ignored */,
                     GCCause::_heap_dump /* GC Cause */,
                     0 /* total full collections, dummy, ignored */,
                     gc_before_heap_dump) {
     _local_writer = writer;
     _gc_before_heap_dump = gc_before_heap_dump;
+    _num_dump_threads = num_dump_threads;
     _is_segmented_dump = false;
     _dump_start = (jlong)-1;
     _klass_map = new (ResourceObj::C_HEAP, mtInternal) GrowableArray<Klass*>(INITIAL_CLASS_COUNT, true);
@@ -1550,7 +1658,92 @@ void VM_HeapDumper::end_of_dump() {
 
 // marks sub-record boundary
 void HeapObjectDumper::mark_end_of_record() {
-  dumper()->check_segment_length();
+  if (dumper() != NULL) {
+    dumper()->check_segment_length();
+  } else {
+    writer()->end_of_record();
+  }
+}
+
+#if INCLUDE_ALL_GCS
+// Dumps the objects of a G1 heap with the GC worker threads.  Each worker
+// collects the records of the regions it claims in its own segment writer.
+class ParHeapObjectDumpTask : public AbstractGangTask {
+ private:
+  DumpWriter* _writer;
+  Mutex*      _lock;
+  uint        _num_workers;
+
+ public:
+  ParHeapObjectDumpTask(DumpWriter* writer, uint num_workers) :
+    AbstractGangTask("Parallel Heap Dump"),
+    _writer(writer),
+    _lock(new Mutex(Mutex::leaf, "HeapDumpSegment_lock", true)),
+    _num_workers(num_workers) { }
+
+  ~ParHeapObjectDumpTask() {
+    delete _lock;
+  }
+
+  void work(uint worker_id) {
+    if (worker_id >= _num_workers) {
+      // any worker claims the regions left over by the others
+      return;
+    }
+    DumpWriter segment_writer(_writer, _lock);
+    HeapObjectDumper obj_dumper(NULL, &segment_writer);
+    G1CollectedHeap::heap()->object_par_iterate(&obj_dumper, worker_id, _num_workers);
+    segment_writer.close();
+  }
+};
+#endif // INCLUDE_ALL_GCS
+
+uint VM_HeapDumper::parallel_dump_threads() const {
+#if INCLUDE_ALL_GCS
+  if (UseG1GC && _num_dump_threads != 1) {
+    FlexibleWorkGang* workers = G1CollectedHeap::heap()->workers();
+    if (workers != NULL) {
+      uint n = workers->active_workers();
+      if (_num_dump_threads != 0) {
+        n = MIN2(n, _num_dump_threads);
+      }
+      return n > 1 ? n : 0;
+    }
+  }
+#endif // INCLUDE_ALL_GCS
+  return 0;
+}
+
+void VM_HeapDumper::dump_heap_objects() {
+  uint n_threads = parallel_dump_threads();
+#if INCLUDE_ALL_GCS
+  if (n_threads > 0) {
+    assert(is_segmented_dump(), "the workers write one segment each");
+    // the workers append complete segments, so close the current one
+    write_current_dump_record_length();
+
+    G1CollectedHeap* g1h = G1CollectedHeap::heap();
+    assert(g1h->check_heap_region_claim_values(HeapRegion::InitialClaimValue),
+           "sanity check");
+    ParHeapObjectDumpTask task(writer(), n_threads);
+    g1h->set_par_threads(g1h->workers()->active_workers());
+    g1h->workers()->run_task(&task);
+    g1h->set_par_threads(0);
+    assert(g1h->check_heap_region_claim_values(HeapRegion::ParObjectIterateClaimValue),
+           "sanity check");
+    g1h->reset_heap_region_claim_values();
+
+    // the roots go into a new segment
+    write_dump_header();
+    return;
+  }
+#endif // INCLUDE_ALL_GCS
+
+  // After each sub-record is written check_segment_length will be invoked. When
+  // generated a segmented heap dump this allows us to check if the current
+  // segment exceeds a threshold and if so, then a new segment is started.
+  HeapObjectDumper obj_dumper(this, writer());
+  Universe::heap()->safe_object_iterate(&obj_dumper);
 }
 
 // writes a HPROF_LOAD_CLASS record for the class (and each of its
@@ -1746,10 +1939,11 @@ void VM_HeapDumper::doit() {
   set_global_dumper();
   set_global_writer();
 
-  // Write the file header - use 1.0.2 for large heaps, otherwise 1.0.1
+  // Write the file header - use 1.0.2 for large heaps, otherwise 1.0.1.
+  // A parallel dump always has several segments.
   size_t used = ch->used();
   const char* header;
-  if (used > (size_t)SegmentedHeapDumpThreshold) {
+  if (used > (size_t)SegmentedHeapDumpThreshold || parallel_dump_threads() > 0) {
     set_segmented_dump();
     header = "JAVA PROFILE 1.0.2";
   } else {
@@ -1783,13 +1977,9 @@ void VM_HeapDumper::doit() {
   check_segment_length();
 
   // writes HPROF_GC_INSTANCE_DUMP records.
-  // After each sub-record is written check_segment_length will be invoked. When
-  // generated a segmented heap dump this allows us to check if the current
-  // segment exceeds a threshold and if so, then a new segment is started.
   // The HPROF_GC_CLASS_DUMP and HPROF_GC_INSTANCE_DUMP are the vast bulk
   // of the heap dump.
-  HeapObjectDumper obj_dumper(this, writer());
-  Universe::heap()->safe_object_iterate(&obj_dumper);
+  dump_heap_objects();
 
   // HPROF_GC_ROOT_THREAD_OBJ + frames + jni locals
   do_threads();
@@ -1876,7 +2066,7 @@ void VM_HeapDumper::dump_stack_traces() {
 
 // dump the heap to given path.
 PRAGMA_FORMAT_NONLITERAL_IGNORED_EXTERNAL
-int HeapDumper::dump(const char* path) {
+int HeapDumper::dump(const char* path, uint num_dump_threads) {
   assert(path != NULL && strlen(path) > 0, "path missing");
 
   // print message in interactive case
@@ -1897,7 +2087,7 @@ int HeapDumper::dump(const char* path) {
   }
 
   // generate the dump
-  VM_HeapDumper dumper(&writer, _gc_before_heap_dump, _oome);
+  VM_HeapDumper dumper(&writer, _gc_before_heap_dump, _oome, num_dump_threads);
   if (Thread::current()->is_VM_thread()) {
     assert(SafepointSynchronize::is_at_safepoint(), "Expected to be called at a safepoint");
     dumper.doit();
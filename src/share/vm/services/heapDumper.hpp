@@ -71,7 +71,9 @@ class HeapDumper : public StackObj {
   ~HeapDumper();
 
   // dumps the heap to the specified file, returns 0 if success.
-  int dump(const char* path);
+  // With G1 the heap objects are dumped by up to num_dump_threads GC
+  // worker threads, 0 meaning all of them and 1 the VM thread alone.
+  int dump(const char* path, uint num_dump_threads = 0);
 
   // returns error message (resource allocated), or NULL if no error
   char* error_as_C_string() const;
@@ -31,6 +31,26 @@
 #include "services/memTracker.hpp"
 
 size_t MallocMemorySummary::_snapshot[CALC_OBJ_SIZE_IN_TYPE(MallocMemorySnapshot, size_t)];
+volatile intptr_t MallocSiteSampler::_bytes_until_sample = 0;
+
+size_t MallocMemorySnapshot::malloc_header_count() const {
+  size_t count = 0;
+  for (int index = 0; index < mt_number_of_types; index ++) {
+    // The thread stack slot only counts the threads, nothing is malloc'd
+    if (index != NMTUtil::flag_to_index(mtThreadStack)) {
+      count += _malloc[index].malloc_count();
+    }
+  }
+  return count;
+}
+
+void MallocMemorySnapshot::copy_to(MallocMemorySnapshot* s) {
+  size_t headers = malloc_header_count();
+  s->_tracking_header = MemoryCounter(headers, headers * sizeof(MallocHeader));
+  for (int index = 0; index < mt_number_of_types; index ++) {
+    s->_malloc[index] = _malloc[index];
+  }
+}
 
 // Total malloc'd memory amount
 size_t MallocMemorySnapshot::total() const {
@@ -51,6 +71,10 @@ size_t MallocMemorySnapshot::total_arena() const {
   return amount;
 }
 
+size_t MallocMemorySummary::tracking_overhead() {
+  return as_snapshot()->malloc_header_count() * sizeof(MallocHeader);
+}
+
 // Make adjustment by subtracting chunks used by arenas
 // from total chunks to get total free chunck size
 void MallocMemorySnapshot::make_adjustment() {
@@ -71,9 +95,8 @@ void MallocHeader::release() const {
   if (MemTracker::tracking_level() <= NMT_minimal) return;
 
   MallocMemorySummary::record_free(size(), flags());
-  MallocMemorySummary::record_free_malloc_header(sizeof(MallocHeader));
-  if (MemTracker::tracking_level() == NMT_detail) {
-    MallocSiteTable::deallocation_at(size(), _bucket_idx, _pos_idx);
+  if (MemTracker::tracking_level() == NMT_detail && has_site()) {
+    MallocSiteTable::deallocation_at(MallocSiteSampler::site_size(size()), _bucket_idx, _pos_idx);
   }
 }
 
@@ -91,6 +114,9 @@ bool MallocHeader::record_malloc_site(const NativeCallStack& stack, size_t size,
 }
 
 bool MallocHeader::get_stack(NativeCallStack& stack) const {
+  if (!has_site()) {
+    return false;
+  }
   return MallocSiteTable::access_stack(stack, _bucket_idx, _pos_idx);
 }
 
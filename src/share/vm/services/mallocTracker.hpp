@@ -51,6 +51,11 @@ class MemoryCounter VALUE_OBJ_CLASS_SPEC {
     DEBUG_ONLY(_peak_size  = 0;)
   }
 
+  MemoryCounter(size_t count, size_t size) : _count(count), _size(size) {
+    DEBUG_ONLY(_peak_count = count;)
+    DEBUG_ONLY(_peak_size  = size;)
+  }
+
   inline void allocate(size_t sz) {
     Atomic::add(1, (volatile MemoryCounterType*)&_count);
     if (sz > 0) {
@@ -134,6 +139,7 @@ class MallocMemorySnapshot : public ResourceObj {
 
  private:
   MallocMemory      _malloc[mt_number_of_types];
+  // Only set in copies, see copy_to()
   MemoryCounter     _tracking_header;
 
 
@@ -163,12 +169,12 @@ class MallocMemorySnapshot : public ResourceObj {
     return s->by_type(mtThreadStack)->malloc_count();
   }
 
-  void copy_to(MallocMemorySnapshot* s) {
-    s->_tracking_header = _tracking_header;
-    for (int index = 0; index < mt_number_of_types; index ++) {
-      s->_malloc[index] = _malloc[index];
-    }
-  }
+  // Every malloc'd block carries one tracking header, so rather than
+  // updating a separate counter on each malloc and free, the headers are
+  // counted from the malloc counts.
+  size_t malloc_header_count() const;
+
+  void copy_to(MallocMemorySnapshot* s);
 
   // Make adjustment by subtracting chunks used by arenas
   // from total chunks to get total free chunk size
@@ -211,19 +217,8 @@ class MallocMemorySummary : AllStatic {
      s->make_adjustment();
    }
 
-   // Record memory used by malloc tracking header
-   static inline void record_new_malloc_header(size_t sz) {
-     as_snapshot()->malloc_overhead()->allocate(sz);
-   }
-
-   static inline void record_free_malloc_header(size_t sz) {
-     as_snapshot()->malloc_overhead()->deallocate(sz);
-   }
-
    // The memory used by malloc tracking headers
-   static inline size_t tracking_overhead() {
-     return as_snapshot()->malloc_overhead()->size();
-   }
+   static size_t tracking_overhead();
 
   static MallocMemorySnapshot* as_snapshot() {
     return (MallocMemorySnapshot*)_snapshot;
@@ -231,6 +226,43 @@ class MallocMemorySummary : AllStatic {
 };
 
 
+/*
+ * At detail level, the call site of every malloc is recorded by default.
+ * With NativeMemoryTrackingSampleInterval set, CALLER_PC and CURRENT_PC only
+ * walk the stack once that many bytes have been allocated since the last
+ * recorded site, and allocations without a walked stack are not added to the
+ * malloc site table. A recorded allocation stands for at least the interval,
+ * so the site amounts estimate the real ones.
+ */
+class MallocSiteSampler : AllStatic {
+ private:
+  // Updated without synchronization, a lost update only moves the next sample
+  static volatile intptr_t _bytes_until_sample;
+
+ public:
+  static inline bool should_walk_stack() {
+    return NativeMemoryTrackingSampleInterval == 0 || _bytes_until_sample <= 0;
+  }
+
+  // Returns true if the call site of the allocation should be recorded
+  static inline bool sample(size_t size, const NativeCallStack& stack) {
+    if (NativeMemoryTrackingSampleInterval == 0) {
+      return true;
+    }
+    if (stack.is_empty()) {
+      _bytes_until_sample -= (intptr_t)size;
+      return false;
+    }
+    _bytes_until_sample = (intptr_t)NativeMemoryTrackingSampleInterval;
+    return true;
+  }
+
+  // The amount a recorded allocation of size bytes adds to its malloc site
+  static inline size_t site_size(size_t size) {
+    return MAX2(size, (size_t)NativeMemoryTrackingSampleInterval);
+  }
+};
+
 /*
  * Malloc tracking header.
  * To satisfy malloc alignment requirement, NMT uses 2 machine words for tracking purpose,
@@ -268,8 +300,13 @@ class MallocHeader VALUE_OBJ_CLASS_SPEC {
     if (level == NMT_detail) {
       size_t bucket_idx;
       size_t pos_idx;
-      if (record_malloc_site(stack, size, &bucket_idx, &pos_idx, flags)) {
-        assert(bucket_idx <= MAX_MALLOCSITE_TABLE_SIZE, "Overflow bucket index");
+      if (!MallocSiteSampler::sample(size, stack)) {
+        // No bucket has this index
+        _bucket_idx = MAX_MALLOCSITE_TABLE_SIZE;
+        _pos_idx = 0;
+      } else if (record_malloc_site(stack, MallocSiteSampler::site_size(size),
+                                    &bucket_idx, &pos_idx, flags)) {
+        assert(bucket_idx < MAX_MALLOCSITE_TABLE_SIZE, "Overflow bucket index");
         assert(pos_idx <= MAX_BUCKET_LENGTH, "Overflow bucket position index");
         _bucket_idx = bucket_idx;
         _pos_idx = pos_idx;
@@ -277,11 +314,12 @@ class MallocHeader VALUE_OBJ_CLASS_SPEC {
     }
 
     MallocMemorySummary::record_malloc(size, flags);
-    MallocMemorySummary::record_new_malloc_header(sizeof(MallocHeader));
   }
 
   inline size_t   size()  const { return _size; }
   inline MEMFLAGS flags() const { return (MEMFLAGS)_flags; }
+  // Was the call site recorded at detail level?
+  inline bool has_site()  const { return _bucket_idx != MAX_MALLOCSITE_TABLE_SIZE; }
   bool get_stack(NativeCallStack& stack) const;
 
   // Cleanup tracking information before the memory is released.
@@ -1114,14 +1114,16 @@ static void do_thread_dump(ThreadDumpResult* dump_result,
   // A JavaThread may terminate before we get the stack trace.
   GrowableArray<instanceHandle>* thread_handle_array = new GrowableArray<instanceHandle>(num_threads);
   {
+    JavaThread** threads = NEW_C_HEAP_ARRAY(JavaThread*, num_threads, mtInternal);
     MutexLockerEx ml(Threads_lock);
+    Threads::find_java_threads_from_java_tids(ids_ah(), threads);
     for (int i = 0; i < num_threads; i++) {
-      jlong tid = ids_ah->long_at(i);
-      JavaThread* jt = Threads::find_java_thread_from_java_tid(tid);
+      JavaThread* jt = threads[i];
       oop thread_obj = (jt != NULL ? jt->threadObj() : (oop)NULL);
       instanceHandle threadObj_h(THREAD, (instanceOop) thread_obj);
       thread_handle_array->append(threadObj_h);
     }
+    FREE_C_HEAP_ARRAY(JavaThread*, threads, mtInternal);
   }
 
   // Obtain thread dumps and thread snapshot information
@@ -1193,10 +1195,11 @@ JVM_ENTRY(jint, jmm_GetThreadInfo(JNIEnv *env, jlongArray ids, jint maxDepth, jo
   if (maxDepth == 0) {
     // no stack trace dumped - do not need to stop the world
     {
+      JavaThread** threads = NEW_C_HEAP_ARRAY(JavaThread*, num_threads, mtInternal);
       MutexLockerEx ml(Threads_lock);
+      Threads::find_java_threads_from_java_tids(ids_ah(), threads);
       for (int i = 0; i < num_threads; i++) {
-        jlong tid = ids_ah->long_at(i);
-        JavaThread* jt = Threads::find_java_thread_from_java_tid(tid);
+        JavaThread* jt = threads[i];
         ThreadSnapshot* ts;
         if (jt == NULL) {
           // if the thread does not exist or now it is terminated,
@@ -1207,6 +1210,7 @@ JVM_ENTRY(jint, jmm_GetThreadInfo(JNIEnv *env, jlongArray ids, jint maxDepth, jo
         }
         dump_result.add_thread_snapshot(ts);
       }
+      FREE_C_HEAP_ARRAY(JavaThread*, threads, mtInternal);
     }
   } else {
     // obtain thread dump with the specific list of threads with stack trace
@@ -1725,6 +1729,11 @@ JVM_ENTRY(void, jmm_SetVMGlobal(JNIEnv *env, jstring flag_name, jvalue new_value
       if (!Arguments::verify_MinHeapFreeRatio(err_msg, uvalue)) {
         THROW_MSG(vmSymbols::java_lang_IllegalArgumentException(), err_msg.buffer());
       }
+    } else if (strncmp(name, "SoftMaxHeapSize", 16) == 0) {
+      FormatBuffer<80> err_msg("%s", "");
+      if (!Arguments::verify_SoftMaxHeapSize(err_msg, uvalue)) {
+        THROW_MSG(vmSymbols::java_lang_IllegalArgumentException(), err_msg.buffer());
+      }
     }
     succeed = CommandLineFlags::uintxAtPut(name, &uvalue, Flag::MANAGEMENT);
   } else if (flag->is_uint64_t()) {
@@ -2236,13 +2245,18 @@ JVM_ENTRY(void, jmm_GetThreadAllocatedMemory(JNIEnv *env, jlongArray ids,
               "the given array of thread IDs");
   }
 
-  MutexLockerEx ml(Threads_lock);
-  for (int i = 0; i < num_threads; i++) {
-    JavaThread* java_thread = Threads::find_java_thread_from_java_tid(ids_ah->long_at(i));
-    if (java_thread != NULL) {
-      sizeArray_h->long_at_put(i, java_thread->cooked_allocated_bytes());
+  JavaThread** threads = NEW_C_HEAP_ARRAY(JavaThread*, num_threads, mtInternal);
+  {
+    MutexLockerEx ml(Threads_lock);
+    Threads::find_java_threads_from_java_tids(ids_ah(), threads);
+    for (int i = 0; i < num_threads; i++) {
+      JavaThread* java_thread = threads[i];
+      if (java_thread != NULL) {
+        sizeArray_h->long_at_put(i, java_thread->cooked_allocated_bytes());
+      }
     }
   }
+  FREE_C_HEAP_ARRAY(JavaThread*, threads, mtInternal);
 JVM_END
 
 // Returns the CPU time consumed by a given thread (in nanoseconds).
@@ -2307,14 +2321,19 @@ JVM_ENTRY(void, jmm_GetThreadCpuTimesWithKind(JNIEnv *env, jlongArray ids,
               "the given array of thread IDs");
   }
 
-  MutexLockerEx ml(Threads_lock);
-  for (int i = 0; i < num_threads; i++) {
-    JavaThread* java_thread = Threads::find_java_thread_from_java_tid(ids_ah->long_at(i));
-    if (java_thread != NULL) {
-      timeArray_h->long_at_put(i, os::thread_cpu_time((Thread*)java_thread,
-                                                      user_sys_cpu_time != 0));
+  JavaThread** threads = NEW_C_HEAP_ARRAY(JavaThread*, num_threads, mtInternal);
+  {
+    MutexLockerEx ml(Threads_lock);
+    Threads::find_java_threads_from_java_tids(ids_ah(), threads);
+    for (int i = 0; i < num_threads; i++) {
+      JavaThread* java_thread = threads[i];
+      if (java_thread != NULL) {
+        timeArray_h->long_at_put(i, os::thread_cpu_time((Thread*)java_thread,
+                                                        user_sys_cpu_time != 0));
+      }
     }
   }
+  FREE_C_HEAP_ARRAY(JavaThread*, threads, mtInternal);
 JVM_END
 
 
@@ -82,9 +82,11 @@ class MemTracker : AllStatic {
 
 extern volatile bool NMT_stack_walkable;
 
-#define CURRENT_PC ((MemTracker::tracking_level() == NMT_detail && NMT_stack_walkable) ? \
+#define CURRENT_PC ((MemTracker::tracking_level() == NMT_detail && NMT_stack_walkable && \
+                     MallocSiteSampler::should_walk_stack()) ?                           \
                     NativeCallStack(0, true) : NativeCallStack::empty_stack())
-#define CALLER_PC  ((MemTracker::tracking_level() == NMT_detail && NMT_stack_walkable) ?  \
+#define CALLER_PC  ((MemTracker::tracking_level() == NMT_detail && NMT_stack_walkable && \
+                     MallocSiteSampler::should_walk_stack()) ?                           \
                     NativeCallStack(1, true) : NativeCallStack::empty_stack())
 
 class MemBaseline;
@@ -202,7 +204,8 @@ class MemTracker : AllStatic {
       ThreadCritical tc;
       // Recheck to avoid potential racing during NMT shutdown
       if (tracking_level() < NMT_summary) return;
-      VirtualMemoryTracker::add_reserved_region((address)addr, size, stack, flag);
+      VirtualMemoryTracker::add_reserved_region((address)addr, size,
+        virtual_memory_stack(stack), flag);
     }
   }
 
@@ -213,7 +216,7 @@ class MemTracker : AllStatic {
       ThreadCritical tc;
       if (tracking_level() < NMT_summary) return;
       VirtualMemoryTracker::add_reserved_region((address)addr, size,
-        stack, flag, true);
+        virtual_memory_stack(stack), flag, true);
     }
   }
 
@@ -223,7 +226,8 @@ class MemTracker : AllStatic {
     if (addr != NULL) {
       ThreadCritical tc;
       if (tracking_level() < NMT_summary) return;
-      VirtualMemoryTracker::add_committed_region((address)addr, size, stack);
+      VirtualMemoryTracker::add_committed_region((address)addr, size,
+        virtual_memory_stack(stack));
     }
   }
 
@@ -299,6 +303,17 @@ class MemTracker : AllStatic {
 
  private:
   static NMT_TrackingLevel init_tracking_level();
+
+  // Sampling the malloc sites may have skipped the stack walk in the
+  // caller. Virtual memory is reserved and committed rarely, so its
+  // call sites are always recorded.
+  static inline NativeCallStack virtual_memory_stack(const NativeCallStack& stack) {
+    if (stack.is_empty() && NativeMemoryTrackingSampleInterval > 0 &&
+        tracking_level() == NMT_detail && NMT_stack_walkable) {
+      return NativeCallStack(1, true);
+    }
+    return stack;
+  }
   static void report(bool summary_only, outputStream* output);
 
  private:
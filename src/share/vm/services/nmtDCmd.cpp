@@ -53,6 +53,10 @@ NMTDCmd::NMTDCmd(outputStream* output,
             "BOOLEAN", false, "false"),
   _statistics("statistics", "print tracker statistics for tuning purpose.", \
             "BOOLEAN", false, "false"),
+  _resident("resident", "request runtime to report how much of the " \
+            "committed virtual memory of each subsystem is resident in " \
+            "physical memory.",
+            "BOOLEAN", false, "false"),
   _scale("scale", "Memory usage in which scale, KB, MB or GB",
        "STRING", false, "KB") {
   _dcmdparser.add_dcmd_option(&_summary);
@@ -62,6 +66,7 @@ NMTDCmd::NMTDCmd(outputStream* output,
   _dcmdparser.add_dcmd_option(&_detail_diff);
   _dcmdparser.add_dcmd_option(&_shutdown);
   _dcmdparser.add_dcmd_option(&_statistics);
+  _dcmdparser.add_dcmd_option(&_resident);
   _dcmdparser.add_dcmd_option(&_scale);
 }
 
@@ -97,10 +102,11 @@ void NMTDCmd::execute(DCmdSource source, TRAPS) {
   if (_detail_diff.is_set() && _detail_diff.value()) { ++nopt; }
   if (_shutdown.is_set() && _shutdown.value()) { ++nopt; }
   if (_statistics.is_set() && _statistics.value()) { ++nopt; }
+  if (_resident.is_set() && _resident.value()) { ++nopt; }
 
   if (nopt > 1) {
       output()->print_cr("At most one of the following option can be specified: " \
-        "summary, detail, baseline, summary.diff, detail.diff, shutdown");
+        "summary, detail, baseline, summary.diff, detail.diff, shutdown, resident");
       return;
   } else if (nopt == 0) {
     if (_summary.is_set()) {
@@ -152,6 +158,8 @@ void NMTDCmd::execute(DCmdSource source, TRAPS) {
     if (check_detail_tracking_level(output())) {
       MemTracker::tuning_statistics(output());
     }
+  } else if (_resident.value()) {
+    report_resident(scale_unit);
   } else {
     ShouldNotReachHere();
     output()->print_cr("Unknown command");
@@ -201,6 +209,38 @@ void NMTDCmd::report_diff(bool summaryOnly, size_t scale_unit) {
   }
 }
 
+void NMTDCmd::report_resident(size_t scale_unit) {
+  size_t resident[mt_number_of_types];
+  if (!VirtualMemoryTracker::resident_memory(resident)) {
+    output()->print_cr("Resident memory is not available on this platform");
+    return;
+  }
+  VirtualMemorySnapshot snapshot;
+  VirtualMemorySummary::snapshot(&snapshot);
+
+  const char* scale = NMTUtil::scale_name(scale_unit);
+  size_t total_committed = 0;
+  size_t total_resident = 0;
+  output()->print_cr("Resident Memory:");
+  output()->cr();
+  for (int index = 0; index < mt_number_of_types; index ++) {
+    size_t committed = snapshot.by_index(index)->committed();
+    if (committed == 0) {
+      continue;
+    }
+    total_committed += committed;
+    total_resident += resident[index];
+    output()->print_cr("-%26s (committed=" SIZE_FORMAT "%s, resident=" SIZE_FORMAT "%s)",
+      NMTUtil::flag_to_name(NMTUtil::index_to_flag(index)),
+      NMTUtil::amount_in_scale(committed, scale_unit), scale,
+      NMTUtil::amount_in_scale(resident[index], scale_unit), scale);
+  }
+  output()->cr();
+  output()->print_cr("Total: committed=" SIZE_FORMAT "%s, resident=" SIZE_FORMAT "%s",
+    NMTUtil::amount_in_scale(total_committed, scale_unit), scale,
+    NMTUtil::amount_in_scale(total_resident, scale_unit), scale);
+}
+
 bool NMTDCmd::check_detail_tracking_level(outputStream* out) {
   if (MemTracker::tracking_level() == NMT_detail) {
     return true;
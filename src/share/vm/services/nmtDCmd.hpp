@@ -44,6 +44,7 @@ class NMTDCmd: public DCmdWithParser {
   DCmdArgument<bool>  _detail_diff;
   DCmdArgument<bool>  _shutdown;
   DCmdArgument<bool>  _statistics;
+  DCmdArgument<bool>  _resident;
   DCmdArgument<char*> _scale;
 
  public:
@@ -66,6 +67,7 @@ class NMTDCmd: public DCmdWithParser {
  private:
   void report(bool summaryOnly, size_t scale);
   void report_diff(bool summaryOnly, size_t scale);
+  void report_resident(size_t scale);
 
   size_t get_scale(const char* scale) const;
 
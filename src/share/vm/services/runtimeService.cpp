@@ -46,6 +46,8 @@ PerfCounter*  RuntimeService::_application_time_ticks = NULL;
 PerfCounter*  RuntimeService::_thread_interrupt_signaled_count = NULL;
 PerfCounter*  RuntimeService::_interrupted_before_count = NULL;
 PerfCounter*  RuntimeService::_interrupted_during_count = NULL;
+PerfHistogram* RuntimeService::_sync_time_histogram = NULL;
+PerfHistogram* RuntimeService::_safepoint_time_histogram = NULL;
 double RuntimeService::_last_safepoint_sync_time_sec = 0.0;
 
 void RuntimeService::init() {
@@ -71,6 +73,20 @@ void RuntimeService::init() {
               PerfDataManager::create_counter(SUN_RT, "applicationTime",
                                               PerfData::U_Ticks, CHECK);
 
+    if (PerfDataHistograms) {
+      // 10 us buckets for the time to safepoint, 100 us for the pauses
+      _sync_time_histogram =
+              PerfDataManager::create_histogram(SUN_RT, "safepointSyncTimeHistogram",
+                                                PerfData::U_Ticks,
+                                                PerfHistogram::ticks_unit(10),
+                                                20, CHECK);
+      _safepoint_time_histogram =
+              PerfDataManager::create_histogram(SUN_RT, "safepointTimeHistogram",
+                                                PerfData::U_Ticks,
+                                                PerfHistogram::ticks_unit(100),
+                                                20, CHECK);
+    }
+
 
     // create performance counters for jvm_version and its capabilities
     PerfDataManager::create_constant(SUN_RT, "jvmVersion", PerfData::U_None,
@@ -140,7 +156,11 @@ void RuntimeService::record_safepoint_begin() {
 
 void RuntimeService::record_safepoint_synchronized() {
   if (UsePerfData) {
-    _sync_time_ticks->inc(_safepoint_timer.ticks_since_update());
+    jlong sync_ticks = _safepoint_timer.ticks_since_update();
+    _sync_time_ticks->inc(sync_ticks);
+    if (_sync_time_histogram != NULL) {
+      _sync_time_histogram->record(sync_ticks);
+    }
   }
   if (PrintGCApplicationStoppedTime) {
     _last_safepoint_sync_time_sec = last_safepoint_time_sec();
@@ -169,7 +189,11 @@ void RuntimeService::record_safepoint_end() {
   // update the time stamp to begin recording app time
   _app_timer.update();
   if (UsePerfData) {
-    _safepoint_time_ticks->inc(_safepoint_timer.ticks_since_update());
+    jlong safepoint_ticks = _safepoint_timer.ticks_since_update();
+    _safepoint_time_ticks->inc(safepoint_ticks);
+    if (_safepoint_time_histogram != NULL) {
+      _safepoint_time_histogram->record(safepoint_ticks);
+    }
   }
 }
 
@@ -29,8 +29,11 @@
 #include "memory/oopFactory.hpp"
 #include "oops/instanceKlass.hpp"
 #include "oops/oop.inline.hpp"
+#include "prims/forte.hpp"
 #include "runtime/handles.inline.hpp"
 #include "runtime/init.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/os.hpp"
 #include "runtime/thread.hpp"
 #include "runtime/vframe.hpp"
 #include "runtime/thread.inline.hpp"
@@ -413,6 +416,70 @@ DeadlockCycle* ThreadService::find_deadlocks_at_safepoint(bool concurrent_locks)
   return deadlocks;
 }
 
+// Walks the stack of a thread while the thread is suspended.
+class StackWalkSuspendedTask : public os::SuspendedThreadTask {
+ private:
+  int      _max_depth;
+  Method** _methods;
+  int*     _bcis;
+  int      _num_frames;
+ public:
+  StackWalkSuspendedTask(JavaThread* thread, int max_depth, Method** methods, int* bcis) :
+    os::SuspendedThreadTask(thread), _max_depth(max_depth), _methods(methods), _bcis(bcis),
+    _num_frames(0) {}
+  int num_frames() const { return _num_frames; }
+  void do_task(const os::SuspendedThreadTaskContext& context) {
+    if (context.ucontext() != NULL) {
+      _num_frames = Forte::get_call_trace((JavaThread*)context.thread(), context.ucontext(),
+                                          _max_depth, _methods, _bcis);
+    }
+  }
+};
+
+void ThreadService::print_stacks_without_safepoint(outputStream* st) {
+  JavaThread* current = JavaThread::current();
+  const int max_depth = MaxJavaStackTraceDepth > 0 ? (int)MaxJavaStackTraceDepth : 1024;
+  ResourceMark rm(current);
+  Method** methods = NEW_RESOURCE_ARRAY(Method*, max_depth);
+  int* bcis = NEW_RESOURCE_ARRAY(int, max_depth);
+
+  char buf[32];
+  st->print_cr("%s", os::local_time_string(buf, sizeof(buf)));
+  st->print_cr("Thread dump without safepoint %s (%s %s):",
+               Abstract_VM_Version::vm_name(),
+               Abstract_VM_Version::vm_release(),
+               Abstract_VM_Version::vm_info_string());
+  st->cr();
+
+  // Holding the Threads_lock keeps the threads from exiting and, as no
+  // safepoint can begin, the methods and mirrors we print from being
+  // unloaded or moved. Only one thread at a time is stopped.
+  MutexLockerEx ml(Threads_lock);
+  for (JavaThread* thread = Threads::first(); thread != NULL; thread = thread->next()) {
+    ResourceMark rm(current);
+    HandleMark hm(current);
+    thread->print_on(st);
+    if (thread == current) {
+      int depth = 0;
+      for (vframeStream vfst(current); !vfst.at_end() && depth < max_depth; vfst.next(), depth++) {
+        java_lang_Throwable::print_stack_element(st, vfst.method(), vfst.bci());
+      }
+    } else if (thread->thread_state() != _thread_new && !thread->is_exiting()) {
+      StackWalkSuspendedTask task(thread, max_depth, methods, bcis);
+      task.run();
+      int num_frames = task.num_frames();
+      if (num_frames < 0) {
+        st->print_cr("\t<stack not walkable>");
+      }
+      for (int i = 0; i < num_frames; i++) {
+        methodHandle m(current, methods[i]);
+        java_lang_Throwable::print_stack_element(st, m, bcis[i] == -3 ? 0 : bcis[i]);
+      }
+    }
+    st->cr();
+  }
+}
+
 ThreadDumpResult::ThreadDumpResult() : _num_threads(0), _num_snapshots(0), _snapshots(NULL), _next(NULL), _last(NULL) {
 
   // Create a new ThreadDumpResult object and append to the list.
@@ -111,6 +111,11 @@ public:
 
   static DeadlockCycle*       find_deadlocks_at_safepoint(bool object_monitors_only);
 
+  // Print the Java stacks of all threads without a safepoint: each thread
+  // is suspended in turn while its stack is walked, so the stacks are not
+  // a consistent snapshot, and no lock information is printed.
+  static void   print_stacks_without_safepoint(outputStream* st);
+
   // GC support
   static void   oops_do(OopClosure* f);
   static void   metadata_do(void f(Metadata*));
@@ -23,6 +23,7 @@
  */
 #include "precompiled.hpp"
 
+#include "runtime/os.hpp"
 #include "runtime/threadCritical.hpp"
 #include "services/virtualMemoryTracker.hpp"
 
@@ -474,4 +475,33 @@ bool VirtualMemoryTracker::transition(NMT_TrackingLevel from, NMT_TrackingLevel
   return true;
 }
 
+// Sums up the resident part of the committed regions by memory type
+class ResidentMemoryWalker : public VirtualMemoryWalker {
+ private:
+  size_t* _resident;
+
+ public:
+  ResidentMemoryWalker(size_t* resident) : _resident(resident) { }
+
+  bool do_allocation_site(const ReservedMemoryRegion* rgn) {
+    int index = NMTUtil::flag_to_index(rgn->flag());
+    CommittedRegionIterator itr = rgn->iterate_committed_regions();
+    const CommittedMemoryRegion* committed_rgn;
+    while ((committed_rgn = itr.next()) != NULL) {
+      size_t resident;
+      if (!os::resident_memory_size((char*)committed_rgn->base(), committed_rgn->size(), &resident)) {
+        return false;
+      }
+      _resident[index] += resident;
+    }
+    return true;
+  }
+};
 
+bool VirtualMemoryTracker::resident_memory(size_t resident[mt_number_of_types]) {
+  for (int index = 0; index < mt_number_of_types; index ++) {
+    resident[index] = 0;
+  }
+  ResidentMemoryWalker walker(resident);
+  return walk_virtual_memory(&walker);
+}
@@ -413,6 +413,10 @@ class VirtualMemoryTracker : AllStatic {
   // Walk virtual memory data structure for creating baseline, etc.
   static bool walk_virtual_memory(VirtualMemoryWalker* walker);
 
+  // Fills in the resident part of the committed memory of each type.
+  // Returns false if the platform can not tell.
+  static bool resident_memory(size_t resident[mt_number_of_types]);
+
   static bool transition(NMT_TrackingLevel from, NMT_TrackingLevel to);
 
  private:
@@ -28,17 +28,22 @@
 #if INCLUDE_TRACE
 #include "runtime/globals.hpp"
 #include "runtime/os.hpp"
+#include "trace/traceRecorder.hpp"
 #include "trace/traceTime.hpp"
 #include "tracefiles/traceEventIds.hpp"
 
 class TraceBackend {
 public:
   static bool enabled(void) {
-    return EnableTracing;
+    return EnableTracing || TraceRecorder::is_recording();
   }
 
   static bool is_event_enabled(TraceEventId id) {
-    return enabled();
+    return enabled() && TraceRecorder::is_event_enabled(id);
+  }
+
+  static bool should_write(TraceEventId id, jlong duration) {
+    return TraceRecorder::should_write(id, duration);
   }
 
   static TracingTime time() {
@@ -50,8 +55,13 @@ public:
 };
 
 class TraceThreadData {
+  friend class TraceRecorder;
+private:
+  TraceBuffer* _buffer;   // the trace buffer this thread writes into
+  jint         _owned;    // its state while owned by this thread
 public:
-    TraceThreadData() {}
+    TraceThreadData() : _buffer(NULL), _owned(0) {}
+    ~TraceThreadData();
 };
 
 typedef TraceBackend Tracing;
@@ -73,7 +73,8 @@ private:
 public:
 <xsl:apply-templates select="value" mode="write-setters"/>
 
-  void writeStruct(TraceStream&amp; ts) {
+  template &lt;typename STREAM&gt;
+  void writeStruct(STREAM&amp; ts) {
 <xsl:apply-templates select="value" mode="write-data"/>
   }
 };
@@ -116,10 +117,17 @@ public:
  private:
 <xsl:apply-templates select="value|structvalue|transition_value|relation" mode="write-fields"/>
 
+  // Written by both the text format of TraceStream and the binary
+  // format of TraceRecordStream, which ignores the labels.
+  template &lt;typename STREAM&gt;
+  void writeData(STREAM&amp; ts) {
+<xsl:apply-templates select="value|structvalue" mode="write-data"/>
+  }
+
   void writeEventContent(void) {
     TraceStream ts(*tty);
     ts.print("<xsl:value-of select="@label"/>: [");
-<xsl:apply-templates select="value|structvalue" mode="write-data"/>
+    writeData(ts);
     ts.print("]\n");
   }
 
@@ -127,18 +135,24 @@ public:
 <xsl:apply-templates select="value|structvalue|transition_value|relation" mode="write-setters"/>
 
   bool should_write(void) {
-    return true;
+    return Tracing::should_write(eventId, isInstant ? 0 : _endTime - _startTime);
   }
 <xsl:text>
 
 </xsl:text>
   <xsl:value-of select="concat('  Event', @id, '(EventStartTime timing=TIMED) : TraceEvent&lt;Event', @id, '&gt;(timing) {}', $newline)"/>
   void writeEvent(void) {
-    if (UseLockedTracing) {
-      ttyLocker lock;
-      writeEventContent();
-    } else {
-      writeEventContent();
+    if (TraceRecorder::is_recording()) {
+      TraceRecordStream ts(eventId, _startTime, _endTime);
+      writeData(ts);
+    }
+    if (EnableTracing) {
+      if (UseLockedTracing) {
+        ttyLocker lock;
+        writeEventContent();
+      } else {
+        writeEventContent();
+      }
     }
   }
 };
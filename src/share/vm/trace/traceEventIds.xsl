@@ -62,6 +62,15 @@ enum TraceStructId {
   MaxTraceStructId
 };
 
+/**
+ * Applies f to the name of each event type, in the order of the enum
+ */
+#define TRACE_EVENTS_DO(f) \
+<xsl:for-each select="trace/events/event">
+  <xsl:value-of select="concat('  f(', @id, ') \', $newline)"/>
+</xsl:for-each>
+  /* end of TRACE_EVENTS_DO */
+
 typedef enum TraceEventId  TraceEventId;
 typedef enum TraceStructId TraceStructId;
 
@@ -0,0 +1,472 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "memory/resourceArea.hpp"
+#include "oops/klass.hpp"
+#include "oops/method.hpp"
+#include "runtime/atomic.inline.hpp"
+#include "runtime/mutexLocker.hpp"
+#include "runtime/orderAccess.inline.hpp"
+#include "runtime/os.hpp"
+#include "runtime/task.hpp"
+#include "runtime/thread.inline.hpp"
+#include "runtime/threadLocalStorage.hpp"
+#include "trace/traceBackend.hpp"
+#include "trace/traceRecorder.hpp"
+#include "trace/traceStream.hpp"
+#include "utilities/ostream.hpp"
+
+#if INCLUDE_TRACE
+
+volatile bool         TraceRecorder::_recording = false;
+TraceFlushTask*       TraceRecorder::_task = NULL;
+int                   TraceRecorder::_fd = -1;
+char*                 TraceRecorder::_path = NULL;
+TraceBuffer* volatile TraceRecorder::_all_buffers = NULL;
+TraceBuffer* volatile TraceRecorder::_full_buffers = NULL;
+bool                  TraceRecorder::_disabled[MaxTraceEventId];
+jlong                 TraceRecorder::_threshold[MaxTraceEventId];
+volatile jint         TraceRecorder::_lost_events = 0;
+jlong                 TraceRecorder::_written_events = 0;
+jlong                 TraceRecorder::_written_bytes = 0;
+
+class TraceFlushTask : public PeriodicTask {
+ public:
+  TraceFlushTask(int interval_time) : PeriodicTask(interval_time) {}
+  void task() { TraceRecorder::flush(); }
+};
+
+static jint state_of(jint state) {
+  return state & TraceBuffer::state_mask;
+}
+
+static jint with_state(jint state, jint new_state) {
+  return (state & ~TraceBuffer::state_mask) | new_state;
+}
+
+static u1* put_u8(u1* pos, u8 val, size_t size) {
+  for (size_t i = size; i > 0; i--) {
+    *pos++ = (u1)(val >> ((i - 1) * BitsPerByte));
+  }
+  return pos;
+}
+
+// Returns a new buffer or a recycled one, in writing_state, or NULL if
+// there is no memory for one.
+TraceBuffer* TraceRecorder::acquire_buffer(TraceThreadData* data) {
+  for (TraceBuffer* b = _all_buffers; b != NULL; b = b->_next_all) {
+    jint state = b->_state;
+    if (state_of(state) == TraceBuffer::free_state &&
+        Atomic::cmpxchg(with_state(state, TraceBuffer::writing_state), &b->_state, state) == state) {
+      b->_pos = b->_start;
+      b->_events = 0;
+      b->_thread_id = os::current_thread_id();
+      data->_owned = with_state(state, TraceBuffer::owned_state);
+      return b;
+    }
+  }
+
+  size_t size = MAX2(TraceBufferSize, (uintx)K);
+  u1* start = NEW_C_HEAP_ARRAY_RETURN_NULL(u1, size, mtTracing);
+  if (start == NULL) {
+    return NULL;
+  }
+  TraceBuffer* b = new (std::nothrow) TraceBuffer(start, size);
+  if (b == NULL) {
+    FREE_C_HEAP_ARRAY(u1, start, mtTracing);
+    return NULL;
+  }
+  b->_thread_id = os::current_thread_id();
+  data->_owned = TraceBuffer::owned_state;
+  TraceBuffer* head;
+  do {
+    head = _all_buffers;
+    b->_next_all = head;
+  } while (Atomic::cmpxchg_ptr(b, &_all_buffers, head) != head);
+  return b;
+}
+
+void TraceRecorder::push_full(TraceBuffer* buffer) {
+  TraceBuffer* head;
+  do {
+    head = _full_buffers;
+    buffer->_next_full = head;
+  } while (Atomic::cmpxchg_ptr(buffer, &_full_buffers, head) != head);
+}
+
+// The buffer is free for any thread again. The new generation keeps its
+// previous owner from claiming it.
+void TraceRecorder::recycle(TraceBuffer* buffer) {
+  juint state = (juint)buffer->_state + TraceBuffer::generation_unit;
+  OrderAccess::release_store(&buffer->_state, with_state((jint)state, TraceBuffer::free_state));
+}
+
+TraceBuffer* TraceRecorder::begin_event(TraceThreadData* data) {
+  TraceBuffer* buffer = data->_buffer;
+  if (buffer != NULL) {
+    jint owned = data->_owned;
+    if (Atomic::cmpxchg(with_state(owned, TraceBuffer::writing_state), &buffer->_state, owned) == owned) {
+      if (_recording) {
+        return buffer;
+      }
+      // Stopped meanwhile. stop() waits for us and takes the buffer.
+      OrderAccess::release_store(&buffer->_state, owned);
+      return NULL;
+    }
+    // The buffer was flushed; it may even belong to another thread now.
+    data->_buffer = NULL;
+  }
+  if (!_recording) {
+    return NULL;
+  }
+  buffer = acquire_buffer(data);
+  if (buffer == NULL) {
+    return NULL;
+  }
+  // The CAS that claimed the buffer orders this check. Either stop()
+  // finds the buffer in writing_state and waits for it, or we see that
+  // the recording was stopped.
+  if (!_recording) {
+    recycle(buffer);
+    return NULL;
+  }
+  data->_buffer = buffer;
+  return buffer;
+}
+
+// Hand the full buffer over and move the used bytes of the event being
+// written, starting at event, to a new buffer.
+TraceBuffer* TraceRecorder::replace_buffer(TraceThreadData* data, TraceBuffer* full,
+                                           u1* event, size_t used) {
+  data->_buffer = NULL;
+  TraceBuffer* buffer = begin_event(data);
+  if (buffer != NULL) {
+    memcpy(buffer->_start, event, used);
+  }
+  full->_pos = event;
+  OrderAccess::release_store(&full->_state, with_state(full->_state, TraceBuffer::full_state));
+  push_full(full);
+  return buffer;
+}
+
+void TraceRecorder::end_event(TraceThreadData* data, TraceBuffer* buffer, u1* pos) {
+  buffer->_pos = pos;
+  buffer->_events++;
+  OrderAccess::release_store(&buffer->_state, data->_owned);
+}
+
+void TraceRecorder::cancel_event(TraceThreadData* data, TraceBuffer* buffer) {
+  Atomic::inc(&_lost_events);
+  if (buffer != NULL) {
+    OrderAccess::release_store(&buffer->_state, data->_owned);
+  }
+}
+
+void TraceRecorder::thread_exit(TraceThreadData* data) {
+  TraceBuffer* buffer = data->_buffer;
+  if (buffer == NULL) {
+    return;
+  }
+  data->_buffer = NULL;
+  jint owned = data->_owned;
+  if (Atomic::cmpxchg(with_state(owned, TraceBuffer::full_state), &buffer->_state, owned) == owned) {
+    if (buffer->_events > 0) {
+      push_full(buffer);
+    } else {
+      recycle(buffer);
+    }
+  }
+}
+
+TraceThreadData::~TraceThreadData() {
+  TraceRecorder::thread_exit(this);
+}
+
+// Take the buffers holding events from their owners. With wait, also
+// wait for the events being written, so that none is left behind.
+void TraceRecorder::retire_buffers(bool wait) {
+  for (TraceBuffer* b = _all_buffers; b != NULL; b = b->_next_all) {
+    while (true) {
+      jint state = b->_state;
+      if (state_of(state) == TraceBuffer::owned_state) {
+        if (b->_events == 0) {
+          break;
+        }
+        if (Atomic::cmpxchg(with_state(state, TraceBuffer::full_state), &b->_state, state) == state) {
+          push_full(b);
+          break;
+        }
+      } else if (state_of(state) == TraceBuffer::writing_state && wait) {
+        os::yield();
+      } else {
+        break;
+      }
+    }
+  }
+}
+
+void TraceRecorder::write(const u1* data, size_t size) {
+  if (_fd < 0) {
+    return;
+  }
+  while (size > 0) {
+    size_t n = os::write(_fd, data, (unsigned int)MIN2(size, (size_t)max_jint));
+    if (n == 0 || n == (size_t)-1) {
+      warning("Cannot write trace recording to %s, stopped writing it", _path);
+      os::close(_fd);
+      _fd = -1;
+      return;
+    }
+    data += n;
+    size -= n;
+    _written_bytes += n;
+  }
+}
+
+void TraceRecorder::write_full_buffers() {
+  assert_lock_strong(TraceRecorder_lock);
+  TraceBuffer* b = (TraceBuffer*)Atomic::xchg_ptr(NULL, &_full_buffers);
+  while (b != NULL) {
+    TraceBuffer* next = b->_next_full;
+    OrderAccess::acquire();
+    size_t size = b->_pos - b->_start;
+    if (size > 0) {
+      u1 header[chunk_header_size];
+      u1* pos = put_u8(header, chunk_header_size + size, 4);
+      pos = put_u8(pos, b->_events, 4);
+      put_u8(pos, b->_thread_id, 8);
+      write(header, chunk_header_size);
+      write(b->_start, size);
+      _written_events += b->_events;
+    }
+    recycle(b);
+    b = next;
+  }
+}
+
+void TraceRecorder::write_header() {
+  ResourceMark rm;
+  size_t size = 32;
+  for (int id = NUM_RESERVED_EVENTS; id < MaxTraceEventId; id++) {
+    size += 4 + 2 + strlen(event_name((TraceEventId)id));
+  }
+  u1* header = NEW_RESOURCE_ARRAY(u1, size);
+  u1* pos = header;
+  memcpy(pos, "HSTR", 4);
+  pos += 4;
+  pos = put_u8(pos, major_version, 2);
+  pos = put_u8(pos, minor_version, 2);
+  pos = put_u8(pos, os::elapsed_frequency(), 8);
+  pos = put_u8(pos, os::elapsed_counter(), 8);
+  pos = put_u8(pos, os::javaTimeMillis(), 8);
+  pos = put_u8(pos, MaxTraceEventId - NUM_RESERVED_EVENTS, 4);
+  for (int id = NUM_RESERVED_EVENTS; id < MaxTraceEventId; id++) {
+    const char* name = event_name((TraceEventId)id);
+    size_t len = strlen(name);
+    pos = put_u8(pos, id, 4);
+    pos = put_u8(pos, len, 2);
+    memcpy(pos, name, len);
+    pos += len;
+  }
+  assert(pos == header + size, "header size");
+  write(header, size);
+}
+
+bool TraceRecorder::start(const char* path, outputStream* out) {
+  // The PeriodicTask_lock also keeps the flush task from running meanwhile.
+  MutexLocker ml(PeriodicTask_lock);
+  if (_task != NULL) {
+    out->print_cr("Already recording to %s", _path);
+    return false;
+  }
+  int fd = os::open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    out->print_cr("Cannot create %s: %s", path, strerror(errno));
+    return false;
+  }
+
+  MutexLockerEx ml2(TraceRecorder_lock, Mutex::_no_safepoint_check_flag);
+  // Drop what exiting threads left after the last recording.
+  write_full_buffers();
+  if (_path != NULL) {
+    os::free(_path, mtTracing);
+  }
+  _path = os::strdup(path, mtTracing);
+  _fd = fd;
+  _lost_events = 0;
+  _written_events = 0;
+  _written_bytes = 0;
+  write_header();
+  _recording = true;
+  OrderAccess::fence();
+
+  int interval = (int)MIN2(TraceFlushInterval, (uintx)PeriodicTask::max_interval - 1);
+  interval = MAX2(interval - interval % PeriodicTask::interval_gran, (int)PeriodicTask::min_interval);
+  _task = new TraceFlushTask(interval);
+  _task->enroll();
+  return true;
+}
+
+bool TraceRecorder::stop() {
+  MutexLocker ml(PeriodicTask_lock);
+  if (_task == NULL) {
+    return false;
+  }
+  delete _task;   // disenrolls it
+  _task = NULL;
+
+  MutexLockerEx ml2(TraceRecorder_lock, Mutex::_no_safepoint_check_flag);
+  _recording = false;
+  OrderAccess::fence();
+  retire_buffers(true);
+  write_full_buffers();
+  if (_fd >= 0) {
+    os::close(_fd);
+    _fd = -1;
+  }
+  return true;
+}
+
+void TraceRecorder::flush() {
+  MutexLockerEx ml(TraceRecorder_lock, Mutex::_no_safepoint_check_flag);
+  if (_recording) {
+    retire_buffers(false);
+    write_full_buffers();
+  }
+}
+
+void TraceRecorder::print_summary(outputStream* out) {
+  MutexLockerEx ml(TraceRecorder_lock, Mutex::_no_safepoint_check_flag);
+  if (_path == NULL) {
+    out->print_cr("no recording");
+    return;
+  }
+  out->print_cr(JLONG_FORMAT " events, " JLONG_FORMAT " bytes written to %s, %d events lost",
+                _written_events, _written_bytes, _path, _lost_events);
+}
+
+const char* TraceRecorder::event_name(TraceEventId id) {
+  switch (id) {
+#define TRACE_EVENT_NAME_CASE(name) case Trace##name##Event: return #name;
+    TRACE_EVENTS_DO(TRACE_EVENT_NAME_CASE)
+#undef TRACE_EVENT_NAME_CASE
+    default: return NULL;
+  }
+}
+
+TraceEventId TraceRecorder::find_event(const char* name) {
+  for (int id = NUM_RESERVED_EVENTS; id < MaxTraceEventId; id++) {
+    if (strcmp(name, event_name((TraceEventId)id)) == 0) {
+      return (TraceEventId)id;
+    }
+  }
+  return MaxTraceEventId;
+}
+
+void TraceRecorder::configure(TraceEventId id, bool enabled, jlong threshold_nanos) {
+  assert(id >= NUM_RESERVED_EVENTS && id < MaxTraceEventId, "invalid event");
+  _disabled[id] = !enabled;
+  if (threshold_nanos >= 0) {
+    _threshold[id] = (jlong)((double)threshold_nanos * os::elapsed_frequency() / NANOSECS_PER_SEC);
+  }
+}
+
+void TraceRecorder::print_settings(outputStream* out) {
+  for (int id = NUM_RESERVED_EVENTS; id < MaxTraceEventId; id++) {
+    double threshold_ms = (double)_threshold[id] * MILLIUNITS / os::elapsed_frequency();
+    out->print_cr("%-32s %-8s threshold: %.3f ms", event_name((TraceEventId)id),
+                  _disabled[id] ? "disabled" : "enabled", threshold_ms);
+  }
+}
+
+TraceRecordStream::TraceRecordStream(TraceEventId id, jlong start_time, jlong end_time) :
+  _data(NULL), _buffer(NULL), _event(NULL), _pos(NULL) {
+  Thread* thread = ThreadLocalStorage::thread();
+  if (thread == NULL) {
+    TraceRecorder::cancel_event(NULL, NULL);
+    return;
+  }
+  _data = thread->trace_data();
+  _buffer = TraceRecorder::begin_event(_data);
+  if (_buffer == NULL) {
+    if (TraceRecorder::is_recording()) {
+      TraceRecorder::cancel_event(_data, NULL);
+    }
+    return;
+  }
+  _event = _pos = _buffer->_pos;
+  put(0, 4);     // the size, set when committed
+  put(id, 4);
+  put(start_time, 8);
+  put(end_time, 8);
+}
+
+TraceRecordStream::~TraceRecordStream() {
+  if (_buffer != NULL) {
+    put_u8(_event, _pos - _event, 4);
+    TraceRecorder::end_event(_data, _buffer, _pos);
+  }
+}
+
+void TraceRecordStream::overflow(size_t size) {
+  size_t used = _pos - _event;
+  if (_buffer->start() + used + size > _buffer->end()) {
+    // Does not fit into an empty buffer either.
+    TraceRecorder::cancel_event(_data, _buffer);
+    _buffer = NULL;
+    return;
+  }
+  _buffer = TraceRecorder::replace_buffer(_data, _buffer, _event, used);
+  if (_buffer == NULL) {
+    TraceRecorder::cancel_event(_data, NULL);
+    return;
+  }
+  _event = _buffer->start();
+  _pos = _event + used;
+}
+
+void TraceRecordStream::put_string(const char* val) {
+  size_t len = val != NULL ? MIN2(strlen(val), (size_t)max_jushort) : 0;
+  put(len, 2);
+  if (_buffer != NULL && _pos + len > _buffer->end()) {
+    overflow(len);
+  }
+  if (_buffer != NULL) {
+    memcpy(_pos, val, len);
+    _pos += len;
+  }
+}
+
+void TraceRecordStream::print_val(const char* label, const Klass* const val) {
+  ResourceMark rm;
+  put_string(val != NULL && val->name() != NULL ? val->name()->as_C_string() : NULL);
+}
+
+void TraceRecordStream::print_val(const char* label, const Method* const val) {
+  ResourceMark rm;
+  put_string(val != NULL ? val->name_and_sig_as_C_string() : NULL);
+}
+
+#endif // INCLUDE_TRACE
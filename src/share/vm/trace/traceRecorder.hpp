@@ -0,0 +1,170 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+#ifndef SHARE_VM_TRACE_TRACERECORDER_HPP
+#define SHARE_VM_TRACE_TRACERECORDER_HPP
+
+#include "utilities/macros.hpp"
+#if INCLUDE_TRACE
+#include "memory/allocation.hpp"
+#include "tracefiles/traceEventIds.hpp"
+
+class TraceFlushTask;
+class TraceThreadData;
+class outputStream;
+
+// A buffer of recorded events. Each thread writes the events it commits
+// into a buffer of its own; see TraceRecorder.
+class TraceBuffer : public CHeapObj<mtTracing> {
+  friend class TraceRecorder;
+  friend class TraceRecordStream;
+ public:
+  // The low bits of _state are the state below. The bits above them
+  // count the times the buffer was recycled, so that a thread which
+  // lost its buffer to a flush cannot take it back once it is reused.
+  enum {
+    free_state       = 0,    // not owned by any thread
+    owned_state      = 1,    // owned by a thread, between two events
+    writing_state    = 2,    // the owner is writing an event
+    full_state       = 3,    // waiting to be written to the file
+    state_mask       = 3,
+    generation_unit  = 4
+  };
+
+ private:
+  TraceBuffer*          _next_all;    // all buffers, never unlinked
+  TraceBuffer* volatile _next_full;
+  volatile jint         _state;
+  u1*                   _start;
+  u1*                   _pos;
+  u1*                   _end;
+  jint                  _events;
+  intx                  _thread_id;   // os id of the owner
+
+  TraceBuffer(u1* start, size_t size) :
+    _next_all(NULL), _next_full(NULL), _state(writing_state),
+    _start(start), _pos(start), _end(start + size), _events(0), _thread_id(0) {}
+
+ public:
+  u1* start() const { return _start; }
+  u1* end() const   { return _end; }
+};
+
+// TraceRecorder writes the trace events into a binary file while a
+// recording runs, started with -XX:TraceRecordingFile or Trace.start.
+//
+//  - Each thread writes its events into its own TraceBuffer. The writer
+//    claims the buffer with one uncontended CAS per event, which stops a
+//    flush from taking it in the middle of an event. Buffers are found,
+//    handed over and recycled with CAS as well, so writing an event never
+//    takes a lock.
+//  - Every TraceFlushInterval ms a PeriodicTask takes the buffers holding
+//    events and appends them to the file as chunks, then recycles them.
+//  - Each event type can be disabled and given a duration threshold with
+//    Trace.configure; this applies to -XX:+EnableTracing too.
+//
+// The file is big-endian. Strings are a u2 length and that many bytes
+// of modified UTF-8:
+//    header: "HSTR", u2 major, u2 minor, u8 ticks per second,
+//            u8 start ticks, u8 start time in ms since the epoch,
+//            u4 event types, and for each type u4 id and its name
+//    chunk:  u4 size including this header, u4 events, u8 os thread id,
+//            then the events of one thread in commit order
+//    event:  u4 size, u4 id, u8 start ticks, u8 end ticks, then the
+//            fields of the event in the order of trace.xml. Classes and
+//            methods are written as their names.
+// Chunks of different threads are not ordered by time.
+class TraceRecorder : AllStatic {
+  friend class TraceFlushTask;
+  friend class TraceRecordStream;
+  friend class TraceThreadData;
+ public:
+  enum {
+    major_version = 1,
+    minor_version = 0,
+    header_size   = 24,    // of an event
+    chunk_header_size = 16
+  };
+
+ private:
+  static volatile bool         _recording;
+  static TraceFlushTask*       _task;        // protected by PeriodicTask_lock
+  static int                   _fd;          // protected by TraceRecorder_lock
+  static char*                 _path;
+  static TraceBuffer* volatile _all_buffers;
+  static TraceBuffer* volatile _full_buffers;
+  static bool                  _disabled[MaxTraceEventId];
+  static jlong                 _threshold[MaxTraceEventId];   // in ticks
+  static volatile jint         _lost_events;
+  static jlong                 _written_events;
+  static jlong                 _written_bytes;
+
+  static TraceBuffer* acquire_buffer(TraceThreadData* data);
+  static void push_full(TraceBuffer* buffer);
+  static void recycle(TraceBuffer* buffer);
+  static void retire_buffers(bool wait);
+  static void write_full_buffers();
+  static void write_header();
+  static void write(const u1* data, size_t size);
+  static void flush();
+
+  // For TraceRecordStream: claim the buffer of the current thread for
+  // one event, hand a full one over for a new one, give the buffer back.
+  static TraceBuffer* begin_event(TraceThreadData* data);
+  static TraceBuffer* replace_buffer(TraceThreadData* data, TraceBuffer* full,
+                                     u1* event, size_t used);
+  static void end_event(TraceThreadData* data, TraceBuffer* buffer, u1* pos);
+  static void cancel_event(TraceThreadData* data, TraceBuffer* buffer);
+
+  static void thread_exit(TraceThreadData* data);
+
+ public:
+  static bool is_recording() { return _recording; }
+
+  static bool is_event_enabled(TraceEventId id) {
+    return !_disabled[id];
+  }
+
+  static bool should_write(TraceEventId id, jlong duration) {
+    return duration >= _threshold[id];
+  }
+
+  // Start recording into the file at path. Returns false, with the
+  // reason printed on out, if already recording or the file can't be
+  // created.
+  static bool start(const char* path, outputStream* out);
+  // Write the remaining events and close the file. Returns false if not
+  // recording.
+  static bool stop();
+  static void print_summary(outputStream* out);
+
+  // Event types by name, MaxTraceEventId if there is none.
+  static TraceEventId find_event(const char* name);
+  static const char* event_name(TraceEventId id);
+  // A negative threshold keeps the current one.
+  static void configure(TraceEventId id, bool enabled, jlong threshold_nanos);
+  static void print_settings(outputStream* out);
+};
+
+#endif // INCLUDE_TRACE
+#endif // SHARE_VM_TRACE_TRACERECORDER_HPP
@@ -31,6 +31,8 @@
 #include "oops/klass.hpp"
 #include "oops/method.hpp"
 #include "oops/symbol.hpp"
+#include "trace/traceBackend.hpp"
+#include "trace/traceRecorder.hpp"
 #include "utilities/ostream.hpp"
 
 class TraceStream : public StackObj {
@@ -110,5 +112,51 @@ class TraceStream : public StackObj {
   }
 };
 
+// Writes an event in the binary format of TraceRecorder into the trace
+// buffer of the current thread; the event is committed by the destructor.
+// Takes the same values as TraceStream, ignoring the labels.
+class TraceRecordStream : public StackObj {
+ private:
+  TraceThreadData* _data;
+  TraceBuffer*     _buffer;   // NULL once the event is dropped
+  u1*              _event;
+  u1*              _pos;
+
+  void overflow(size_t size);
+
+  void put(u8 val, size_t size) {
+    if (_buffer != NULL && _pos + size > _buffer->end()) {
+      overflow(size);
+    }
+    if (_buffer != NULL) {
+      for (size_t i = size; i > 0; i--) {
+        *_pos++ = (u1)(val >> ((i - 1) * BitsPerByte));
+      }
+    }
+  }
+
+  void put_string(const char* val);
+
+ public:
+  TraceRecordStream(TraceEventId id, jlong start_time, jlong end_time);
+  ~TraceRecordStream();
+
+  void print_val(const char* label, u1 val)     { put(val, 1); }
+  void print_val(const char* label, u2 val)     { put(val, 2); }
+  void print_val(const char* label, s2 val)     { put((u2)val, 2); }
+  void print_val(const char* label, u4 val)     { put(val, 4); }
+  void print_val(const char* label, s4 val)     { put((u4)val, 4); }
+  void print_val(const char* label, u8 val)     { put(val, 8); }
+  void print_val(const char* label, s8 val)     { put((u8)val, 8); }
+  void print_val(const char* label, bool val)   { put(val ? 1 : 0, 1); }
+  void print_val(const char* label, float val)  { put((u4)jint_cast(val), 4); }
+  void print_val(const char* label, double val) { put((u8)jlong_cast(val), 8); }
+  void print_val(const char* label, const Klass* const val);
+  void print_val(const char* label, const Method* const val);
+  void print_val(const char* label, const char* val) { put_string(val); }
+
+  void print(const char* val) {}
+};
+
 #endif // INCLUDE_TRACE
 #endif // SHARE_VM_TRACE_TRACESTREAM_HPP
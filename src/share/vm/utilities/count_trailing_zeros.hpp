@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_UTILITIES_COUNT_TRAILING_ZEROS_HPP
+#define SHARE_VM_UTILITIES_COUNT_TRAILING_ZEROS_HPP
+
+#include "utilities/globalDefinitions.hpp"
+
+#if defined(TARGET_COMPILER_visCPP)
+#include <intrin.h>
+#ifdef _LP64
+#pragma intrinsic(_BitScanForward64)
+#else
+#pragma intrinsic(_BitScanForward)
+#endif
+#endif
+
+// unsigned count_trailing_zeros(uintx x)
+// Return the number of trailing zeros in x, e.g. the zero-based index
+// of the least significant set bit in x.
+// Precondition: x != 0.
+//
+// unsigned population_count(uintx x)
+// Return the number of set bits in x.
+//
+// Both map to single instructions (bsf/tzcnt and popcnt on x86) when the
+// compiler provides a suitable builtin; the fallbacks are branch-light
+// portable versions.
+
+inline unsigned count_trailing_zeros(uintx x) {
+  assert(x != 0, "precondition");
+#if defined(TARGET_COMPILER_gcc) || defined(TARGET_COMPILER_xlc)
+  return __builtin_ctzl(x);
+#elif defined(TARGET_COMPILER_visCPP)
+  unsigned long index;
+#ifdef _LP64
+  _BitScanForward64(&index, x);
+#else
+  _BitScanForward(&index, x);
+#endif
+  return index;
+#else
+  // Binary search; at most log2(BitsPerWord) steps.
+  unsigned n = 0;
+#ifdef _LP64
+  if ((x & 0xFFFFFFFF) == 0) { n += 32; x >>= 32; }
+#endif
+  if ((x & 0xFFFF) == 0) { n += 16; x >>= 16; }
+  if ((x & 0xFF) == 0)   { n += 8;  x >>= 8;  }
+  if ((x & 0xF) == 0)    { n += 4;  x >>= 4;  }
+  if ((x & 0x3) == 0)    { n += 2;  x >>= 2;  }
+  if ((x & 0x1) == 0)    { n += 1; }
+  return n;
+#endif
+}
+
+inline unsigned population_count(uintx x) {
+#if defined(TARGET_COMPILER_gcc) || defined(TARGET_COMPILER_xlc)
+  return __builtin_popcountl(x);
+#else
+  // SWAR reduction: sum adjacent bit pairs, nibbles, then bytes.
+  const uintx m1 = (uintx)CONST64(0x5555555555555555);
+  const uintx m2 = (uintx)CONST64(0x3333333333333333);
+  const uintx m4 = (uintx)CONST64(0x0F0F0F0F0F0F0F0F);
+  const uintx h1 = (uintx)CONST64(0x0101010101010101);
+  x = x - ((x >> 1) & m1);
+  x = (x & m2) + ((x >> 2) & m2);
+  x = (x + (x >> 4)) & m4;
+  return (unsigned)((x * h1) >> (BitsPerWord - 8));
+#endif
+}
+
+#endif // SHARE_VM_UTILITIES_COUNT_TRAILING_ZEROS_HPP
@@ -142,6 +142,29 @@ template <class T, MEMFLAGS F> void RehashableHashtable<T, F>::move_to(Rehashabl
   BasicHashtable<F>::free_buckets();
 }
 
+template <class T, MEMFLAGS F> void RehashableHashtable<T, F>::resize_to(RehashableHashtable<T, F>* new_table) {
+  int saved_entry_count = this->number_of_entries();
+
+  for (int i = 0; i < this->table_size(); ++i) {
+    for (HashtableEntry<T, F>* p = this->bucket(i); p != NULL; ) {
+      HashtableEntry<T, F>* next = p->next();
+      int index = new_table->hash_to_index(p->hash());
+      // See move_to() for the shared bit.
+      bool keep_shared = p->is_shared();
+      this->unlink_entry(p);
+      new_table->add_entry(index, p);
+      if (keep_shared) {
+        p->set_shared();
+      }
+      p = next;
+    }
+  }
+  new_table->copy_freelist(this);
+  assert(new_table->number_of_entries() == saved_entry_count, "lost entry on resize?");
+
+  BasicHashtable<F>::free_buckets();
+}
+
 template <MEMFLAGS F> void BasicHashtable<F>::free_buckets() {
   if (NULL != _buckets) {
     // Don't delete the buckets in the shared space.  They aren't
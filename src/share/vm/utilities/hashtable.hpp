@@ -297,12 +297,25 @@ template <class T, MEMFLAGS F> class RehashableHashtable : public Hashtable<T, F
 
   enum {
     rehash_count = 100,
-    rehash_multiple = 60
+    rehash_multiple = 60,
+    resize_load_factor = 2,           // average bucket length that triggers growth
+    max_resize_table_size = 16*M      // don't grow beyond this many buckets
   };
 
   // Check that the table is unbalanced
   bool check_rehash_table(int count);
 
+  // Check that the table has too many entries for its size
+  bool check_resize_table() const {
+    return this->number_of_entries() > this->table_size() * resize_load_factor &&
+           this->table_size() < max_resize_table_size;
+  }
+
+  // New table size when growing
+  int resized_table_size() const {
+    return MIN2(this->table_size() * 2 + 1, (int)max_resize_table_size);
+  }
+
  public:
   RehashableHashtable(int table_size, int entry_size)
     : Hashtable<T, F>(table_size, entry_size) { }
@@ -314,6 +327,9 @@ template <class T, MEMFLAGS F> class RehashableHashtable : public Hashtable<T, F
 
   // Function to move these elements into the new table.
   void move_to(RehashableHashtable<T, F>* new_table);
+  // Move these elements into a new table of a different size, keeping
+  // their hash values and the current hash algorithm.
+  void resize_to(RehashableHashtable<T, F>* new_table);
   static bool use_alternate_hashcode()  { return _seed != 0; }
   static juint seed()                    { return _seed; }
 
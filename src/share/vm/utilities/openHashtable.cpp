@@ -0,0 +1,138 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#include "precompiled.hpp"
+#include "memory/resourceArea.hpp"
+#include "runtime/os.hpp"
+#include "utilities/debug.hpp"
+#include "utilities/openHashtable.hpp"
+#include "utilities/ostream.hpp"
+
+/////////////// Unit tests ///////////////
+
+#ifndef PRODUCT
+
+class TestOpenHashtable : AllStatic {
+  typedef OpenHashtable<uintptr_t, uintptr_t> Table;
+
+  // Spreads consecutive keys over the table like real pointer keys.
+  static uintptr_t key(uintptr_t i) { return i * 8 + 1; }
+
+  class CountEntries {
+   public:
+    size_t _count;
+    uintptr_t _sum;
+    CountEntries() : _count(0), _sum(0) {}
+    bool do_entry(uintptr_t const& k, uintptr_t const& v) {
+      _count++;
+      _sum += v;
+      return true;
+    }
+  };
+
+ public:
+  static void test_put_get() {
+    Table t(4);
+    const uintptr_t n = 1000;
+    for (uintptr_t i = 0; i < n; i++) {
+      assert(t.put(key(i), i), "new key");
+    }
+    assert(t.number_of_entries() == n, "wrong count");
+    assert(t.capacity() * 3 >= n * 4, "load factor exceeded");
+    for (uintptr_t i = 0; i < n; i++) {
+      uintptr_t* v = t.get(key(i));
+      assert(v != NULL && *v == i, "lost entry");
+    }
+    assert(!t.contains(key(n)), "unexpected key");
+    assert(!t.put(key(0), 42), "existing key");
+    assert(*t.get(key(0)) == 42, "value not replaced");
+    assert(t.number_of_entries() == n, "replace changed count");
+  }
+
+  static void test_remove() {
+    Table t;
+    const uintptr_t n = 500;
+    for (uintptr_t i = 0; i < n; i++) {
+      t.put(key(i), i);
+    }
+    // Remove every other key and check that the rest are still found
+    // after the backward shifts.
+    for (uintptr_t i = 0; i < n; i += 2) {
+      assert(t.remove(key(i)), "key present");
+    }
+    assert(!t.remove(key(0)), "key already removed");
+    assert(t.number_of_entries() == n / 2, "wrong count");
+    for (uintptr_t i = 0; i < n; i++) {
+      assert(t.contains(key(i)) == ((i & 1) != 0), "wrong membership");
+    }
+    CountEntries counter;
+    t.iterate(&counter);
+    assert(counter._count == n / 2, "iterate missed entries");
+    assert(counter._sum == (n / 2) * (n / 2), "sum of odd numbers");
+  }
+
+  // Compares lookup speed against the chained ResourceHashtable.  The
+  // numbers are only printed with -XX:+Verbose.
+  static void test_lookup_speed() {
+    ResourceMark rm;
+    const uintptr_t n = 100000;
+    const int rounds = 10;
+    Table open;
+    ResourceHashtable<uintptr_t, uintptr_t, primitive_hash<uintptr_t>,
+                      primitive_equals<uintptr_t>, 1024> chained;
+    for (uintptr_t i = 0; i < n; i++) {
+      open.put(key(i), i);
+      chained.put(key(i), i);
+    }
+    uintptr_t sum_open = 0;
+    uintptr_t sum_chained = 0;
+    jlong start = os::javaTimeNanos();
+    for (int r = 0; r < rounds; r++) {
+      for (uintptr_t i = 0; i < n; i++) {
+        sum_open += *open.get(key(i));
+      }
+    }
+    jlong mid = os::javaTimeNanos();
+    for (int r = 0; r < rounds; r++) {
+      for (uintptr_t i = 0; i < n; i++) {
+        sum_chained += *chained.get(key(i));
+      }
+    }
+    jlong end = os::javaTimeNanos();
+    assert(sum_open == sum_chained, "tables disagree");
+    if (Verbose) {
+      tty->print_cr("OpenHashtable: " JLONG_FORMAT " ns, ResourceHashtable: "
+                    JLONG_FORMAT " ns for " UINTX_FORMAT " lookups",
+                    mid - start, end - mid, (uintx)(n * rounds));
+    }
+  }
+};
+
+void TestOpenHashtable_test() {
+  TestOpenHashtable::test_put_get();
+  TestOpenHashtable::test_remove();
+  TestOpenHashtable::test_lookup_speed();
+}
+
+#endif
@@ -0,0 +1,194 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+#ifndef SHARE_VM_UTILITIES_OPENHASHTABLE_HPP
+#define SHARE_VM_UTILITIES_OPENHASHTABLE_HPP
+
+#include "memory/allocation.inline.hpp"
+#include "utilities/resourceHash.hpp"
+
+// A resizable hash table using open addressing with linear probing.
+//
+// Keys, values and cached hash codes are stored inline in a single
+// power-of-two sized array, so a successful lookup usually touches one
+// cache line instead of following a chain of separately allocated
+// entries as BasicHashtable does.  The table doubles when it becomes
+// three quarters full.  Removal uses backward shift deletion, so no
+// tombstones are left behind and probe sequences stay short.
+//
+// The table is not thread safe; callers must provide their own locking.
+template<
+    typename K, typename V,
+    unsigned (*HASH)  (K const&)           = primitive_hash<K>,
+    bool     (*EQUALS)(K const&, K const&) = primitive_equals<K>,
+    MEMFLAGS F = mtInternal
+    >
+class OpenHashtable : public CHeapObj<F> {
+ private:
+  // A slot is empty iff _used is false.
+  struct Slot {
+    unsigned _hash;
+    bool     _used;
+    K        _key;
+    V        _value;
+  };
+
+  Slot*  _slots;
+  size_t _capacity;     // always a power of two
+  size_t _number_of_entries;
+
+  size_t mask() const            { return _capacity - 1; }
+  size_t home(unsigned hash) const { return (size_t)hash & mask(); }
+
+  static Slot* allocate_slots(size_t capacity) {
+    Slot* slots = NEW_C_HEAP_ARRAY(Slot, capacity, F);
+    for (size_t i = 0; i < capacity; i++) {
+      slots[i]._used = false;
+    }
+    return slots;
+  }
+
+  // Returns the index of the slot holding key, or of the empty slot
+  // where it would be inserted.
+  size_t find_slot(unsigned hash, K const& key) const {
+    size_t i = home(hash);
+    while (_slots[i]._used) {
+      if (_slots[i]._hash == hash && EQUALS(key, _slots[i]._key)) {
+        break;
+      }
+      i = (i + 1) & mask();
+    }
+    return i;
+  }
+
+  void grow() {
+    Slot*  old_slots    = _slots;
+    size_t old_capacity = _capacity;
+    _capacity *= 2;
+    _slots = allocate_slots(_capacity);
+    for (size_t i = 0; i < old_capacity; i++) {
+      if (old_slots[i]._used) {
+        size_t j = home(old_slots[i]._hash);
+        while (_slots[j]._used) {
+          j = (j + 1) & mask();
+        }
+        _slots[j] = old_slots[i];
+      }
+    }
+    FREE_C_HEAP_ARRAY(Slot, old_slots, F);
+  }
+
+ public:
+  OpenHashtable(size_t initial_capacity = 16) : _number_of_entries(0) {
+    _capacity = 1;
+    while (_capacity < MAX2(initial_capacity, (size_t)4)) {
+      _capacity <<= 1;
+    }
+    _slots = allocate_slots(_capacity);
+  }
+
+  ~OpenHashtable() {
+    FREE_C_HEAP_ARRAY(Slot, _slots, F);
+  }
+
+  size_t number_of_entries() const { return _number_of_entries; }
+  size_t capacity() const          { return _capacity; }
+
+  bool contains(K const& key) const {
+    return get(key) != NULL;
+  }
+
+  V* get(K const& key) const {
+    unsigned hash = HASH(key);
+    size_t i = find_slot(hash, key);
+    return _slots[i]._used ? &_slots[i]._value : NULL;
+  }
+
+  // Inserts or replaces a value in the table.  Returns true if the key
+  // was not present before.
+  bool put(K const& key, V const& value) {
+    unsigned hash = HASH(key);
+    size_t i = find_slot(hash, key);
+    if (_slots[i]._used) {
+      _slots[i]._value = value;
+      return false;
+    }
+    if ((_number_of_entries + 1) * 4 > _capacity * 3) {
+      grow();
+      i = find_slot(hash, key);
+    }
+    _slots[i]._hash  = hash;
+    _slots[i]._key   = key;
+    _slots[i]._value = value;
+    _slots[i]._used  = true;
+    _number_of_entries++;
+    return true;
+  }
+
+  // Removes key from the table.  Returns true if it was present.
+  bool remove(K const& key) {
+    unsigned hash = HASH(key);
+    size_t i = find_slot(hash, key);
+    if (!_slots[i]._used) {
+      return false;
+    }
+    // Backward shift: pull later entries of the same probe run into the
+    // hole as long as that does not move them before their home slot.
+    size_t hole = i;
+    size_t j = i;
+    while (true) {
+      j = (j + 1) & mask();
+      if (!_slots[j]._used) {
+        break;
+      }
+      size_t h = home(_slots[j]._hash);
+      // Move j into the hole iff h is not cyclically in (hole, j].
+      bool in_range = (hole <= j) ? (hole < h && h <= j)
+                                  : (hole < h || h <= j);
+      if (!in_range) {
+        _slots[hole] = _slots[j];
+        hole = j;
+      }
+    }
+    _slots[hole]._used = false;
+    _number_of_entries--;
+    return true;
+  }
+
+  // ITER contains bool do_entry(K const&, V const&), which will be
+  // called for each entry in the table.  If do_entry() returns false,
+  // the iteration is cancelled.
+  template<class ITER>
+  void iterate(ITER* iter) const {
+    for (size_t i = 0; i < _capacity; i++) {
+      if (_slots[i]._used) {
+        if (!iter->do_entry(_slots[i]._key, _slots[i]._value)) {
+          return;
+        }
+      }
+    }
+  }
+};
+
+#endif // SHARE_VM_UTILITIES_OPENHASHTABLE_HPP
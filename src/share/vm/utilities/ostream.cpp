@@ -27,7 +27,9 @@
 #include "gc_implementation/shared/gcId.hpp"
 #include "oops/oop.inline.hpp"
 #include "runtime/arguments.hpp"
+#include "runtime/asyncLogWriter.hpp"
 #include "runtime/os.hpp"
+#include "runtime/threadLocalStorage.hpp"
 #include "utilities/defaultStream.hpp"
 #include "utilities/ostream.hpp"
 #include "utilities/top.hpp"
@@ -786,6 +788,10 @@ void gcLogFileStream::dump_loggc_header() {
 }
 
 gcLogFileStream::~gcLogFileStream() {
+  if (_async_writer != NULL) {
+    // Pick up anything printed after the writer was stopped.
+    _async_writer->drain(ThreadLocalStorage::thread());
+  }
   if (_file != NULL) {
     if (_need_close) fclose(_file);
     _file = NULL;
@@ -799,6 +805,7 @@ gcLogFileStream::~gcLogFileStream() {
 gcLogFileStream::gcLogFileStream(const char* file_name) {
   _cur_file_num = 0;
   _bytes_written = 0L;
+  _async_writer = NULL;
   _file_name = make_log_name(file_name, NULL);
 
   if (_file_name == NULL) {
@@ -826,11 +833,40 @@ gcLogFileStream::gcLogFileStream(const char* file_name) {
 }
 
 void gcLogFileStream::write(const char* s, size_t len) {
+  AsyncLogWriter* writer = _async_writer;
+  if (writer != NULL && writer->is_active()) {
+    Thread* thread = ThreadLocalStorage::thread();
+    if (!writer->is_drainer(thread)) {
+      writer->enqueue(thread, s, len);
+      update_position(s, len);
+      return;
+    }
+  }
+  write_to_file(s, len);
+  update_position(s, len);
+}
+
+void gcLogFileStream::write_to_file(const char* s, size_t len) {
   if (_file != NULL) {
     size_t count = fwrite(s, 1, len, _file);
     _bytes_written += count;
   }
-  update_position(s, len);
+}
+
+void gcLogFileStream::flush() {
+  AsyncLogWriter* writer = _async_writer;
+  if (writer != NULL && writer->is_active()) {
+    Thread* thread = ThreadLocalStorage::thread();
+    if (!writer->is_drainer(thread)) {
+      // The writer flushes the file after every drain. Only the error
+      // handler cannot wait for that.
+      if (is_error_reported()) {
+        writer->drain(thread);
+      }
+      return;
+    }
+  }
+  fileStream::flush();
 }
 
 // rotate_log must be called from VMThread at safepoint. In case need change parameters
@@ -841,6 +877,8 @@ void gcLogFileStream::write(const char* s, size_t len) {
 // write to gc log file at safepoint. If in future, changes made for mutator threads or
 // concurrent GC threads to run parallel with VMThread at safepoint, write and rotate_log
 // must be synchronized.
+// With AsyncGCLogging the file belongs to whichever thread holds the writer's drainer
+// claim, and rotate_log is called from that thread.
 void gcLogFileStream::rotate_log(bool force, outputStream* out) {
   char time_msg[O_BUFLEN];
   char time_str[EXTRACHARLEN];
@@ -851,11 +889,25 @@ void gcLogFileStream::rotate_log(bool force, outputStream* out) {
     return;
   }
 
+  AsyncLogWriter* writer = _async_writer;
+  if (writer != NULL && writer->is_active()) {
+    Thread* thread = ThreadLocalStorage::thread();
+    if (!writer->is_drainer(thread)) {
+      // The writer checks the file size itself after each drain. A forced
+      // rotation has to write out the buffered text first.
+      if (force) {
+        writer->rotate(thread, out);
+      }
+      return;
+    }
+  }
+
 #ifdef ASSERT
   Thread *thread = Thread::current();
   assert(thread == NULL ||
-         (thread->is_VM_thread() && SafepointSynchronize::is_at_safepoint()),
-         "Must be VMThread at safepoint");
+         (thread->is_VM_thread() && SafepointSynchronize::is_at_safepoint()) ||
+         (writer != NULL && writer->is_drainer(thread)),
+         "Must be VMThread at safepoint or the GC log drainer");
 #endif
   if (NumberOfGCLogFiles == 1) {
     // rotate in same file
@@ -1334,6 +1386,17 @@ void ostream_init_log() {
   defaultStream::instance->has_log_file();
 }
 
+void ostream_init_async_log() {
+  // For -XX:+AsyncGCLogging option - called in runtime/thread.cpp once the
+  // VM can start threads. Output printed before this is written directly.
+  if (AsyncGCLogging && gclog_or_tty != tty) {
+    gcLogFileStream* gclog = (gcLogFileStream*)gclog_or_tty;
+    if (gclog->is_open()) {
+      AsyncLogWriter::create(gclog);
+    }
+  }
+}
+
 // ostream_exit() is called during normal VM exit to finish log files, flush
 // output and free resource.
 void ostream_exit() {
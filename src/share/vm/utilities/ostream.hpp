@@ -235,18 +235,27 @@ class fdStream : public outputStream {
   void flush() {};
 };
 
+class AsyncLogWriter;
+
 class gcLogFileStream : public fileStream {
  protected:
   const char*  _file_name;
   jlong  _bytes_written;
   uintx  _cur_file_num;             // current logfile rotation number, from 0 to NumberOfGCLogFiles-1
+  AsyncLogWriter* volatile _async_writer;  // set with -XX:+AsyncGCLogging
  public:
   gcLogFileStream(const char* file_name);
   ~gcLogFileStream();
   virtual void write(const char* c, size_t len);
+  virtual void flush();
   virtual void rotate_log(bool force, outputStream* out = NULL);
   void dump_loggc_header();
 
+  // Used by the AsyncLogWriter, which owns the file while it runs.
+  void write_to_file(const char* s, size_t len);
+  void flush_file()                              { fileStream::flush(); }
+  void set_async_writer(AsyncLogWriter* writer)  { _async_writer = writer; }
+
   /* If "force" sets true, force log file rotation from outside JVM */
   bool should_rotate(bool force) {
     return force ||
@@ -263,6 +272,7 @@ void test_snprintf();
 
 void ostream_init();
 void ostream_init_log();
+void ostream_init_async_log();
 void ostream_exit();
 void ostream_abort();
 
@@ -24,6 +24,7 @@
 
 #include "precompiled.hpp"
 #include "oops/oop.inline.hpp"
+#include "runtime/mutexLocker.hpp"
 #include "runtime/os.hpp"
 #include "runtime/thread.inline.hpp"
 #include "utilities/debug.hpp"
@@ -40,7 +41,7 @@ uint ParallelTaskTerminator::_total_peeks = 0;
 
 #if TASKQUEUE_STATS
 const char * const TaskQueueStats::_names[last_stat_id] = {
-  "qpush", "qpop", "qpop-s", "qattempt", "qsteal", "opush", "omax"
+  "qpush", "qpop", "qpop-s", "qattempt", "qsteal", "qsteal-r", "opush", "omax"
 };
 
 TaskQueueStats & TaskQueueStats::operator +=(const TaskQueueStats & addend)
@@ -101,6 +102,9 @@ void TaskQueueStats::verify() const
   assert(get(steal) <= get(steal_attempt),
          err_msg("steal=" SIZE_FORMAT " steal_attempt=" SIZE_FORMAT,
                  get(steal), get(steal_attempt)));
+  assert(get(steal_repeat) <= get(steal),
+         err_msg("steal_repeat=" SIZE_FORMAT " steal=" SIZE_FORMAT,
+                 get(steal_repeat), get(steal)));
   assert(get(overflow) == 0 || get(push) != 0,
          err_msg("overflow=" SIZE_FORMAT " push=" SIZE_FORMAT,
                  get(overflow), get(push)));
@@ -130,10 +134,24 @@ int TaskQueueSetSuper::randomParkAndMiller(int *seed0) {
 }
 
 ParallelTaskTerminator::
-ParallelTaskTerminator(int n_threads, TaskQueueSetSuper* queue_set) :
+ParallelTaskTerminator(int n_threads, TaskQueueSetSuper* queue_set,
+                       bool allow_spin_master) :
   _n_threads(n_threads),
   _queue_set(queue_set),
-  _offered_termination(0) {}
+  _offered_termination(0),
+  _blocker(NULL),
+  _spin_master(NULL) {
+  if (UseOWSTTaskTerminator && allow_spin_master) {
+    _blocker = new Monitor(Mutex::leaf, "ParallelTaskTerminator", false);
+  }
+}
+
+ParallelTaskTerminator::~ParallelTaskTerminator() {
+  assert(_spin_master == NULL, "Should have been reset");
+  if (_blocker != NULL) {
+    delete _blocker;
+  }
+}
 
 bool ParallelTaskTerminator::peek_in_queue_set() {
   return _queue_set->peek();
@@ -153,6 +171,9 @@ bool
 ParallelTaskTerminator::offer_termination(TerminatorTerminator* terminator) {
   assert(_n_threads > 0, "Initialization is incorrect");
   assert(_offered_termination < _n_threads, "Invariant");
+  if (_blocker != NULL) {
+    return offer_termination_owst(terminator);
+  }
   Atomic::inc(&_offered_termination);
 
   uint yield_count = 0;
@@ -239,6 +260,146 @@ ParallelTaskTerminator::offer_termination(TerminatorTerminator* terminator) {
   }
 }
 
+// Optimized work stealing termination: instead of every idle thread
+// spinning and peeking at all queues, one thread (the spin master) does
+// so while the others wait on _blocker. When the spin master sees tasks,
+// it wakes up to as many waiters as there are tasks and returns to work.
+bool ParallelTaskTerminator::offer_termination_owst(TerminatorTerminator* terminator) {
+  // Single worker, done
+  if (_n_threads == 1) {
+    _offered_termination = 1;
+    return true;
+  }
+
+  _blocker->lock_without_safepoint_check();
+  // All arrived, done
+  _offered_termination++;
+  if (_offered_termination == _n_threads) {
+    _blocker->notify_all();
+    _blocker->unlock();
+    return true;
+  }
+
+  Thread* the_thread = Thread::current();
+  while (true) {
+    if (_spin_master == NULL) {
+      _spin_master = the_thread;
+
+      _blocker->unlock();
+
+      if (do_spin_master_work(terminator)) {
+        assert(_offered_termination == _n_threads, "termination condition");
+        return true;
+      } else {
+        _blocker->lock_without_safepoint_check();
+      }
+    } else {
+      _blocker->wait(true, WorkStealingSleepMillis);
+
+      if (_offered_termination == _n_threads) {
+        _blocker->unlock();
+        return true;
+      }
+    }
+
+    size_t tasks = _queue_set->tasks();
+    if (exit_termination(tasks, terminator)) {
+      _offered_termination--;
+      _blocker->unlock();
+      return false;
+    }
+  }
+}
+
+bool ParallelTaskTerminator::do_spin_master_work(TerminatorTerminator* terminator) {
+  uint yield_count = 0;
+  // Number of hard spin loops done since last yield
+  uint hard_spin_count = 0;
+  // Number of iterations in the hard spin loop.
+  uint hard_spin_limit = WorkStealingHardSpins;
+
+  // Same spin/yield schedule as offer_termination().
+  if (WorkStealingSpinToYieldRatio > 0) {
+    hard_spin_limit = WorkStealingHardSpins >> WorkStealingSpinToYieldRatio;
+    hard_spin_limit = MAX2(hard_spin_limit, 1U);
+  }
+  // Remember the initial spin limit.
+  uint hard_spin_start = hard_spin_limit;
+
+  // Loop waiting for all threads to offer termination or
+  // more work.
+  while (true) {
+    // Look for more work.
+    // Periodically wait on _blocker instead of yield() so that the spin
+    // master role can move, and this core can run something else.
+    if (yield_count <= WorkStealingYieldsBeforeSleep) {
+      // Do a yield or hardspin.  For purposes of deciding whether
+      // to sleep, count this as a yield.
+      yield_count++;
+
+      // Periodically call yield() instead spinning
+      // After WorkStealingSpinToYieldRatio spins, do a yield() call
+      // and reset the counts and starting limit.
+      if (hard_spin_count > WorkStealingSpinToYieldRatio) {
+        yield();
+        hard_spin_count = 0;
+        hard_spin_limit = hard_spin_start;
+#ifdef TRACESPINNING
+        _total_yields++;
+#endif
+      } else {
+        // Hard spin this time
+        // Increase the hard spinning period but only up to a limit.
+        hard_spin_limit = MIN2(2*hard_spin_limit,
+                               (uint) WorkStealingHardSpins);
+        for (uint j = 0; j < hard_spin_limit; j++) {
+          SpinPause();
+        }
+        hard_spin_count++;
+#ifdef TRACESPINNING
+        _total_spins++;
+#endif
+      }
+    } else {
+      if (PrintGCDetails && Verbose) {
+        gclog_or_tty->print_cr("ParallelTaskTerminator::do_spin_master_work() "
+                               "thread " PTR_FORMAT " sleeps after %u yields",
+                               p2i(Thread::current()), yield_count);
+      }
+      yield_count = 0;
+
+      MonitorLockerEx locker(_blocker, Mutex::_no_safepoint_check_flag);
+      _spin_master = NULL;
+      locker.wait(Mutex::_no_safepoint_check_flag, WorkStealingSleepMillis);
+      if (_spin_master == NULL) {
+        _spin_master = Thread::current();
+      } else {
+        return false;
+      }
+    }
+
+#ifdef TRACESPINNING
+    _total_peeks++;
+#endif
+    size_t tasks = _queue_set->tasks();
+    if (exit_termination(tasks, terminator)) {
+      MonitorLockerEx locker(_blocker, Mutex::_no_safepoint_check_flag);
+      if (tasks >= (size_t)_offered_termination - 1) {
+        locker.notify_all();
+      } else {
+        for (; tasks > 1; tasks--) {
+          locker.notify();
+        }
+      }
+      _spin_master = NULL;
+      return false;
+    } else if (_offered_termination == _n_threads) {
+      _spin_master = NULL;
+      return true;
+    }
+  }
+}
+
 #ifdef TRACESPINNING
 void ParallelTaskTerminator::print_termination_counts() {
   gclog_or_tty->print_cr("ParallelTaskTerminator Total yields: " UINT32_FORMAT
@@ -250,6 +411,7 @@ void ParallelTaskTerminator::print_termination_counts() {
 #endif
 
 void ParallelTaskTerminator::reset_for_reuse() {
+  assert(_spin_master == NULL, "Should have been reset");
   if (_offered_termination != 0) {
     assert(_offered_termination == _n_threads,
            "Terminator may still be in use");
@@ -54,6 +54,7 @@ public:
     pop_slow,         // subset of taskqueue pops that were done slow-path
     steal_attempt,    // number of taskqueue steal attempts
     steal,            // number of taskqueue steals
+    steal_repeat,     // subset of steals taken from the last victim again
     overflow,         // number of overflow pushes
     overflow_max_len, // max length of overflow stack
     last_stat_id
@@ -66,6 +67,7 @@ public:
   inline void record_pop()      { ++_stats[pop]; }
   inline void record_pop_slow() { record_pop(); ++_stats[pop_slow]; }
   inline void record_steal(bool success);
+  inline void record_steal_repeat() { ++_stats[steal_repeat]; }
   inline void record_overflow(size_t new_length);
 
   TaskQueueStats & operator +=(const TaskQueueStats & addend);
@@ -287,6 +289,12 @@ public:
 
   void initialize();
 
+  // With UseNUMA, bind the element storage to the NUMA node of the calling
+  // thread the first time this is called. Called by the GC worker that owns
+  // the queue; pages of the storage that were already touched stay where
+  // they are.
+  void numa_make_local();
+
   // Push the task "t" on the queue.  Returns "false" iff the queue is full.
   inline bool push(E t);
 
@@ -305,13 +313,25 @@ public:
   // apply the closure to all elements in the task queue
   void oops_do(OopClosure* f);
 
+  // The queue most recently stolen from by the owner of this queue; only
+  // accessed by the owner.
+  bool is_last_stolen_queue_id_valid() const { return _last_stolen_queue_id != invalid_queue_id; }
+  uint last_stolen_queue_id() const          { return _last_stolen_queue_id; }
+  void set_last_stolen_queue_id(uint id)     { _last_stolen_queue_id = id; }
+  void invalidate_last_stolen_queue_id()     { _last_stolen_queue_id = invalid_queue_id; }
+
 private:
+  static const uint invalid_queue_id = max_juint;
+
   // Element array.
   volatile E* _elems;
+  bool _numa_local;
+  uint _last_stolen_queue_id;
 };
 
 template<class E, MEMFLAGS F, unsigned int N>
-GenericTaskQueue<E, F, N>::GenericTaskQueue() {
+GenericTaskQueue<E, F, N>::GenericTaskQueue() :
+  _elems(NULL), _numa_local(false), _last_stolen_queue_id(invalid_queue_id) {
   assert(sizeof(Age) == sizeof(size_t), "Depends on this.");
 }
 
@@ -320,6 +340,21 @@ void GenericTaskQueue<E, F, N>::initialize() {
   _elems = _array_allocator.allocate(N);
 }
 
+template<class E, MEMFLAGS F, unsigned int N>
+void GenericTaskQueue<E, F, N>::numa_make_local() {
+  if (!UseNUMA || _numa_local) {
+    return;
+  }
+  _numa_local = true;
+  int lgrp_id = os::numa_get_group_id();
+  // Only the pages lying entirely within the storage can be bound.
+  char* start = (char*)align_ptr_up((void*)_elems, os::vm_page_size());
+  char* end = (char*)align_ptr_down((void*)(_elems + N), os::vm_page_size());
+  if (lgrp_id != -1 && start < end) {
+    os::numa_make_local(start, pointer_delta(end, start, sizeof(char)), lgrp_id);
+  }
+}
+
 template<class E, MEMFLAGS F, unsigned int N>
 void GenericTaskQueue<E, F, N>::oops_do(OopClosure* f) {
   // tty->print_cr("START OopTaskQueue::oops_do");
@@ -499,6 +534,8 @@ protected:
 public:
   // Returns "true" if some TaskQueue in the set contains a task.
   virtual bool peek() = 0;
+  // Returns a snapshot of the number of tasks in all TaskQueues of the set.
+  virtual size_t tasks() = 0;
 };
 
 template <MEMFLAGS F> class TaskQueueSetSuperImpl: public CHeapObj<F>, public TaskQueueSetSuper {
@@ -535,6 +572,7 @@ public:
   bool steal(uint queue_num, int* seed, E& t);
 
   bool peek();
+  size_t tasks();
 };
 
 template<class T, MEMFLAGS F> void
@@ -563,15 +601,37 @@ GenericTaskQueueSet<T, F>::steal(uint queue_num, int* seed, E& t) {
 template<class T, MEMFLAGS F> bool
 GenericTaskQueueSet<T, F>::steal_best_of_2(uint queue_num, int* seed, E& t) {
   if (_n > 2) {
+    T* const local_queue = _queues[queue_num];
+    // Work is often concentrated on a few queues, so a queue that was
+    // successfully stolen from is likely to still have work: keep it as
+    // the first candidate instead of picking two random queues.
+    bool repeat = local_queue->is_last_stolen_queue_id_valid();
     uint k1 = queue_num;
-    while (k1 == queue_num) k1 = TaskQueueSetSuper::randomParkAndMiller(seed) % _n;
+    if (repeat) {
+      k1 = local_queue->last_stolen_queue_id();
+      assert(k1 != queue_num, "Should not be the same");
+    } else {
+      while (k1 == queue_num) k1 = TaskQueueSetSuper::randomParkAndMiller(seed) % _n;
+    }
     uint k2 = queue_num;
     while (k2 == queue_num || k2 == k1) k2 = TaskQueueSetSuper::randomParkAndMiller(seed) % _n;
     // Sample both and try the larger.
     uint sz1 = _queues[k1]->size();
     uint sz2 = _queues[k2]->size();
-    if (sz2 > sz1) return _queues[k2]->pop_global(t);
-    else return _queues[k1]->pop_global(t);
+    uint sel_k = k1;
+    if (sz2 > sz1) {
+      sel_k = k2;
+    } else if (sz1 == 0) {
+      local_queue->invalidate_last_stolen_queue_id();
+      return false;
+    }
+    if (_queues[sel_k]->pop_global(t)) {
+      TASKQUEUE_STATS_ONLY(if (repeat && sel_k == k1) local_queue->stats.record_steal_repeat());
+      local_queue->set_last_stolen_queue_id(sel_k);
+      return true;
+    }
+    local_queue->invalidate_last_stolen_queue_id();
+    return false;
   } else if (_n == 2) {
     // Just try the other one.
     uint k = (queue_num + 1) % 2;
@@ -592,6 +652,15 @@ bool GenericTaskQueueSet<T, F>::peek() {
   return false;
 }
 
+template<class T, MEMFLAGS F>
+size_t GenericTaskQueueSet<T, F>::tasks() {
+  size_t n = 0;
+  for (uint j = 0; j < _n; j++) {
+    n += _queues[j]->size();
+  }
+  return n;
+}
+
 // When to terminate from the termination protocol.
 class TerminatorTerminator: public CHeapObj<mtInternal> {
 public:
@@ -609,6 +678,11 @@ private:
   TaskQueueSetSuper* _queue_set;
   int _offered_termination;
 
+  // With UseOWSTTaskTerminator, threads offering termination wait on
+  // _blocker while a single _spin_master spins and peeks at the queues.
+  Monitor* _blocker;
+  Thread* volatile _spin_master;
+
 #ifdef TRACESPINNING
   static uint _total_yields;
   static uint _total_spins;
@@ -616,6 +690,19 @@ private:
 #endif
 
   bool peek_in_queue_set();
+
+  // Not copyable: _blocker is owned by the terminator.
+  ParallelTaskTerminator(const ParallelTaskTerminator&);
+  ParallelTaskTerminator& operator=(const ParallelTaskTerminator&);
+
+  bool offer_termination_owst(TerminatorTerminator* terminator);
+  // Returns true if all threads offered termination, false if the
+  // spin master role was given up because work was found or another
+  // thread took it over.
+  bool do_spin_master_work(TerminatorTerminator* terminator);
+  bool exit_termination(size_t tasks, TerminatorTerminator* terminator) {
+    return tasks > 0 || (terminator != NULL && terminator->should_exit_termination());
+  }
 protected:
   virtual void yield();
   void sleep(uint millis);
@@ -623,8 +710,11 @@ protected:
 public:
 
   // "n_threads" is the number of threads to be terminated.  "queue_set" is a
-  // queue sets of work queues of other threads.
-  ParallelTaskTerminator(int n_threads, TaskQueueSetSuper* queue_set);
+  // queue sets of work queues of other threads.  "allow_spin_master" is
+  // false for terminators whose yield() must be run by every waiting thread.
+  ParallelTaskTerminator(int n_threads, TaskQueueSetSuper* queue_set,
+                         bool allow_spin_master = true);
+  ~ParallelTaskTerminator();
 
   // The current thread has no work, and is ready to terminate if everyone
   // else is.  If returns "true", all threads are terminated.  If returns
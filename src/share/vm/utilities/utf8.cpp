@@ -25,6 +25,47 @@
 #include "precompiled.hpp"
 #include "utilities/utf8.hpp"
 
+// The ASCII fast paths below test a word at a time and then copy the
+// ASCII run with a plain loop the C++ compiler can vectorize.
+
+static inline julong load_word(const void* p) {
+  julong w;
+  memcpy(&w, p, sizeof(w));
+  return w;
+}
+
+// Returns the number of leading ASCII bytes of str
+static int ascii_prefix_length(const char* str, int len) {
+  const julong high_bits = CONST64(0x8080808080808080);
+  int i = 0;
+  for (; i + (int)sizeof(julong) <= len; i += sizeof(julong)) {
+    if ((load_word(str + i) & high_bits) != 0) break;
+  }
+  while (i < len && (str[i] & 0x80) == 0) {
+    i++;
+  }
+  return i;
+}
+
+// Returns the number of leading characters of base that are encoded
+// in a single utf8 byte, i.e. are in [0x01, 0x7F]
+static int ascii_prefix_length(const jchar* base, int len) {
+  const julong high_bits = CONST64(0xFF80FF80FF80FF80);
+  const julong low_ones  = CONST64(0x0001000100010001);
+  const julong top_bits  = CONST64(0x8000800080008000);
+  const int chars_per_word = sizeof(julong) / sizeof(jchar);
+  int i = 0;
+  for (; i + chars_per_word <= len; i += chars_per_word) {
+    julong w = load_word(base + i);
+    // Stop at a char above 0x7F or, once they are all below, at a 0
+    if ((w & high_bits) != 0 || ((w - low_ones) & ~w & top_bits) != 0) break;
+  }
+  while (i < len && (jchar)(base[i] - 1) < 0x7F) {
+    i++;
+  }
+  return i;
+}
+
 // Assume the utf8 string is in legal form and has been
 // checked in the class file parser/format checker.
 char* UTF8::next(const char* str, jchar* value) {
@@ -98,7 +139,7 @@ char* UTF8::next_character(const char* str, jint* value) {
 // legal form which has been verified in the format checker.
 int UTF8::unicode_length(const char* str, int len) {
   int num_chars = len;
-  for (int i = 0; i < len; i++) {
+  for (int i = ascii_prefix_length(str, len); i < len; i++) {
     if ((str[i] & 0xC0) == 0x80) {
       --num_chars;
     }
@@ -111,13 +152,11 @@ int UTF8::unicode_length(const char* str, int len) {
 // The utf8 string must be in legal form and has been
 // verified in the format checker.
 int UTF8::unicode_length(const char* str) {
-  int num_chars = 0;
-  for (const char* p = str; *p; p++) {
-    if (((*p) & 0xC0) != 0x80) {
-      num_chars++;
-    }
-  }
-  return num_chars;
+  return unicode_length(str, (int)strlen(str));
+}
+
+bool UTF8::is_ascii(const char* str, int len) {
+  return ascii_prefix_length(str, len) == len;
 }
 
 // Writes a jchar a utf8 and returns the end
@@ -146,18 +185,14 @@ static u_char* utf8_write(u_char* base, jchar ch) {
 }
 
 void UTF8::convert_to_unicode(const char* utf8_str, jchar* unicode_str, int unicode_length) {
-  unsigned char ch;
-  const char *ptr = utf8_str;
-  int index = 0;
-
-  /* ASCII case loop optimization */
-  for (; index < unicode_length; index++) {
-    if((ch = ptr[0]) > 0x7F) { break; }
-    unicode_str[index] = ch;
-    ptr = (const char *)(ptr + 1);
+  // An ASCII prefix of the utf8 string is at most unicode_length long
+  int ascii_length = ascii_prefix_length(utf8_str, unicode_length);
+  for (int i = 0; i < ascii_length; i++) {
+    unicode_str[i] = (unsigned char)utf8_str[i];
   }
 
-  for (; index < unicode_length; index++) {
+  const char *ptr = utf8_str + ascii_length;
+  for (int index = ascii_length; index < unicode_length; index++) {
     ptr = UTF8::next(ptr, &unicode_str[index]);
   }
 }
@@ -317,8 +352,8 @@ int UNICODE::utf8_size(jchar c) {
 }
 
 int UNICODE::utf8_length(jchar* base, int length) {
-  int result = 0;
-  for (int index = 0; index < length; index++) {
+  int result = ascii_prefix_length(base, length);
+  for (int index = result; index < length; index++) {
     jchar c = base[index];
     if ((0x0001 <= c) && (c <= 0x007F)) result += 1;
     else if (c <= 0x07FF) result += 2;
@@ -329,14 +364,10 @@ int UNICODE::utf8_length(jchar* base, int length) {
 
 char* UNICODE::as_utf8(jchar* base, int length) {
   int utf8_len = utf8_length(base, length);
-  u_char* result = NEW_RESOURCE_ARRAY(u_char, utf8_len + 1);
-  u_char* p = result;
-  for (int index = 0; index < length; index++) {
-    p = utf8_write(p, base[index]);
-  }
-  *p = '\0';
-  assert(p == &result[utf8_len], "length prediction must be correct");
-  return (char*) result;
+  char* result = NEW_RESOURCE_ARRAY(char, utf8_len + 1);
+  convert_to_utf8(base, length, result);
+  assert(strlen(result) == (size_t)utf8_len, "length prediction must be correct");
+  return result;
 }
 
 char* UNICODE::as_utf8(jchar* base, int length, char* buf, int buflen) {
@@ -352,7 +383,12 @@ char* UNICODE::as_utf8(jchar* base, int length, char* buf, int buflen) {
 }
 
 void UNICODE::convert_to_utf8(const jchar* base, int length, char* utf8_buffer) {
-  for(int index = 0; index < length; index++) {
+  int ascii_length = ascii_prefix_length(base, length);
+  for (int i = 0; i < ascii_length; i++) {
+    utf8_buffer[i] = (char)base[i];
+  }
+  utf8_buffer += ascii_length;
+  for (int index = ascii_length; index < length; index++) {
     utf8_buffer = (char*)utf8_write((u_char*)utf8_buffer, base[index]);
   }
   *utf8_buffer = '\0';
@@ -41,6 +41,9 @@ class UTF8 : AllStatic {
   // converts a utf8 string to a unicode string
   static void convert_to_unicode(const char* utf8_str, jchar* unicode_buffer, int unicode_length);
 
+  // returns true if the utf8 string has no multibyte characters
+  static bool is_ascii(const char* utf8_str, int len);
+
   // returns the quoted ascii length of a utf8 string
   static int quoted_ascii_length(const char* utf8_str, int utf8_length);
 
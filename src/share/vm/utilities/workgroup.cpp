@@ -52,6 +52,8 @@ AbstractWorkGang::AbstractWorkGang(const char* name,
   _sequence_number = 0;
   _started_workers = 0;
   _finished_workers = 0;
+  _created_workers = 0;
+  _gang_workers = NULL;
 }
 
 WorkGang::WorkGang(const char* name,
@@ -73,10 +75,14 @@ GangWorker* WorkGang::allocate_worker(uint which) {
 // initialization of the workers and report such to the
 // caller.
 bool WorkGang::initialize_workers() {
-
+  uint initial_workers = total_workers();
+  if (UseDynamicNumberOfGCThreads) {
+    initial_workers = MIN2(active_workers(), initial_workers);
+  }
   if (TraceWorkGang) {
-    tty->print_cr("Constructing work gang %s with %d threads",
+    tty->print_cr("Constructing work gang %s with %d of %d threads",
                   name(),
+                  initial_workers,
                   total_workers());
   }
   _gang_workers = NEW_C_HEAP_ARRAY(GangWorker*, total_workers(), mtInternal);
@@ -84,26 +90,44 @@ bool WorkGang::initialize_workers() {
     vm_exit_out_of_memory(0, OOM_MALLOC_ERROR, "Cannot create GangWorker array.");
     return false;
   }
+  for (uint worker = 0; worker < total_workers(); worker += 1) {
+    _gang_workers[worker] = NULL;
+  }
+  add_workers(initial_workers);
+  return true;
+}
+
+// Workers may be added while others run a task. A new worker only joins
+// a task once it polls the gang, and then only if the task still needs
+// more workers, so a task never sees a partly constructed worker.
+void WorkGang::add_workers(uint count) {
+  assert(gang_workers() != NULL, "workers not initialized");
   os::ThreadType worker_type;
   if (are_ConcurrentGC_threads()) {
     worker_type = os::cgc_thread;
   } else {
     worker_type = os::pgc_thread;
   }
-  for (uint worker = 0; worker < total_workers(); worker += 1) {
+  count = MIN2(count, total_workers());
+  for (uint worker = created_workers(); worker < count; worker += 1) {
     GangWorker* new_worker = allocate_worker(worker);
     assert(new_worker != NULL, "Failed to allocate GangWorker");
-    _gang_workers[worker] = new_worker;
     if (new_worker == NULL || !os::create_thread(new_worker, worker_type)) {
       vm_exit_out_of_memory(0, OOM_MALLOC_ERROR,
               "Cannot create worker GC thread. Out of system resources.");
-      return false;
+      return;
     }
+    _gang_workers[worker] = new_worker;
+    // Publish the worker before it can be seen by threads_do().
+    OrderAccess::release_store((volatile juint*)&_created_workers, worker + 1);
     if (!DisableStartThread) {
       os::start_thread(new_worker);
     }
   }
-  return true;
+  if (TraceWorkGang) {
+    tty->print_cr("Work gang %s has %d of %d threads",
+                  name(), created_workers(), total_workers());
+  }
 }
 
 AbstractWorkGang::~AbstractWorkGang() {
@@ -111,7 +135,7 @@ AbstractWorkGang::~AbstractWorkGang() {
     tty->print_cr("Destructing work gang %s", name());
   }
   stop();   // stop all the workers
-  for (uint worker = 0; worker < total_workers(); worker += 1) {
+  for (uint worker = 0; worker < created_workers(); worker += 1) {
     delete gang_worker(worker);
   }
   delete gang_workers();
@@ -122,7 +146,7 @@ GangWorker* AbstractWorkGang::gang_worker(uint i) const {
   // Array index bounds checking.
   GangWorker* result = NULL;
   assert(gang_workers() != NULL, "No workers for indexing");
-  assert(((i >= 0) && (i < total_workers())), "Worker index out of bounds");
+  assert(((i >= 0) && (i < created_workers())), "Worker index out of bounds");
   result = _gang_workers[i];
   assert(result != NULL, "Indexing to null worker");
   return result;
@@ -214,7 +238,7 @@ void AbstractWorkGang::internal_note_finish() {
 }
 
 void AbstractWorkGang::print_worker_threads_on(outputStream* st) const {
-  uint    num_thr = total_workers();
+  uint    num_thr = created_workers();
   for (uint i = 0; i < num_thr; i++) {
     gang_worker(i)->print_on(st);
     st->cr();
@@ -223,7 +247,7 @@ void AbstractWorkGang::print_worker_threads_on(outputStream* st) const {
 
 void AbstractWorkGang::threads_do(ThreadClosure* tc) const {
   assert(tc != NULL, "Null ThreadClosure");
-  uint num_thr = total_workers();
+  uint num_thr = created_workers();
   for (uint i = 0; i < num_thr; i++) {
     tc->do_thread(gang_worker(i));
   }
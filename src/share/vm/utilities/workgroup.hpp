@@ -139,6 +139,9 @@ protected:
   Monitor*  _monitor;
   // The count of the number of workers in the gang.
   uint _total_workers;
+  // The number of worker threads created so far. With
+  // UseDynamicNumberOfGCThreads they are created as they become active.
+  volatile uint _created_workers;
   // Whether the workers should terminate.
   bool _terminate;
   // The array of worker threads for this gang.
@@ -160,6 +163,9 @@ public:
   uint total_workers() const {
     return _total_workers;
   }
+  uint created_workers() const {
+    return OrderAccess::load_acquire((volatile juint*)&_created_workers);
+  }
   virtual uint active_workers() const {
     return _total_workers;
   }
@@ -254,7 +260,11 @@ public:
   // Initialize workers in the gang.  Return true if initialization
   // succeeded. The type of the worker can be overridden in a derived
   // class with the appropriate implementation of allocate_worker().
+  // With UseDynamicNumberOfGCThreads only the initially active workers
+  // are created; the others are created by add_workers().
   bool initialize_workers();
+  // Create worker threads until there are "count" of them.
+  void add_workers(uint count);
 };
 
 // Class GangWorker:
@@ -333,6 +343,9 @@ class FlexibleWorkGang: public WorkGang {
     _active_workers = MAX2(1U, _active_workers);
     assert(UseDynamicNumberOfGCThreads || _active_workers == _total_workers,
            "Unless dynamic should use total workers");
+    if (_active_workers > created_workers() && gang_workers() != NULL) {
+      add_workers(_active_workers);
+    }
   }
   virtual void run_task(AbstractGangTask* task);
   virtual bool needs_more_workers() const {
@@ -122,7 +122,7 @@ void YieldingFlexibleWorkGang::start_task(YieldingFlexibleGangTask* new_task) {
   uint requested_size = new_task->requested_size();
   assert(requested_size >= 0, "Should be non-negative");
   if (requested_size != 0) {
-    _active_workers = MIN2(requested_size, total_workers());
+    _active_workers = MIN2(requested_size, created_workers());
   } else {
     _active_workers = active_workers();
   }
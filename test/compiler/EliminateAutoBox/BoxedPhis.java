@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test
+ * @summary Unboxing of Long and Double boxes merged through phis must keep the boxed values
+ * @library /testlibrary
+ * @run main/othervm -Xbatch -XX:+IgnoreUnrecognizedVMOptions -XX:+EliminateAutoBox
+ *                   -XX:+UnlockExperimentalVMOptions -XX:+AggressiveUnboxing
+ *                   -XX:CompileCommand=dontinline,BoxedPhis::test*
+ *                   BoxedPhis
+ * @run main/othervm -Xbatch -XX:+IgnoreUnrecognizedVMOptions -XX:+EliminateAutoBox
+ *                   -XX:+AggressiveOpts -XX:-DoEscapeAnalysis
+ *                   BoxedPhis
+ */
+import static com.oracle.java.testlibrary.Asserts.assertEQ;
+
+public class BoxedPhis {
+    static long testLongLoop(long n) {
+        Long sum = 0L;
+        for (long i = 0; i < n; i++) {
+            sum += i;
+        }
+        return sum;
+    }
+
+    static double testDoubleLoop(int n) {
+        Double sum = 0.0;
+        for (int i = 0; i < n; i++) {
+            sum += 0.5;
+        }
+        return sum;
+    }
+
+    static long testLongMerge(boolean flag, long a, long b) {
+        Long box = flag ? Long.valueOf(a) : Long.valueOf(b);
+        return box.longValue() + 1;
+    }
+
+    static double testDoubleMerge(boolean flag, double a, double b) {
+        Double box;
+        if (flag) {
+            box = a;
+        } else {
+            box = b;
+        }
+        return box.doubleValue() * 2;
+    }
+
+    public static void main(String[] args) {
+        for (int i = 0; i < 20000; i++) {
+            assertEQ(testLongLoop(100), 4950L);
+            assertEQ(testDoubleLoop(100), 50.0);
+            assertEQ(testLongMerge((i & 1) == 0, i, 1000000L + i),
+                     ((i & 1) == 0 ? i : 1000000L + i) + 1);
+            assertEQ(testDoubleMerge((i & 1) == 0, i, -i), ((i & 1) == 0 ? i : -i) * 2.0);
+        }
+    }
+}
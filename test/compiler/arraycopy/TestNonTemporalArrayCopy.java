@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test
+ * @summary Check disjoint array copies large enough to use non-temporal stores
+ * @run main/othervm -XX:+IgnoreUnrecognizedVMOptions -XX:ArrayCopyNonTemporalThreshold=4096 -XX:+UseUnalignedLoadStores TestNonTemporalArrayCopy
+ */
+
+import java.util.Arrays;
+
+public class TestNonTemporalArrayCopy {
+    static final int LENGTH = 64 * 1024;
+
+    static void check(boolean ok, String what, int len, int srcPos, int dstPos) {
+        if (!ok) {
+            throw new RuntimeException(what + " copy failed: length " + len +
+                                       ", srcPos " + srcPos + ", dstPos " + dstPos);
+        }
+    }
+
+    public static void main(String[] args) {
+        byte[]   bsrc = new byte[LENGTH];
+        int[]    isrc = new int[LENGTH];
+        long[]   lsrc = new long[LENGTH];
+        Object[] osrc = new Object[LENGTH];
+        for (int i = 0; i < LENGTH; i++) {
+            bsrc[i] = (byte)i;
+            isrc[i] = i;
+            lsrc[i] = i;
+            osrc[i] = Integer.valueOf(i);
+        }
+
+        int[] lengths = { 4095, 4096, 4104, 8191, 20000, LENGTH - 64 };
+        for (int iter = 0; iter < 20; iter++) {
+            for (int len : lengths) {
+                for (int srcPos = 0; srcPos < 8; srcPos++) {
+                    for (int dstPos = 0; dstPos < 8; dstPos++) {
+                        byte[] bdst = new byte[LENGTH];
+                        System.arraycopy(bsrc, srcPos, bdst, dstPos, len);
+                        check(Arrays.equals(Arrays.copyOfRange(bsrc, srcPos, srcPos + len),
+                                            Arrays.copyOfRange(bdst, dstPos, dstPos + len)) &&
+                              bdst[dstPos + len] == 0, "byte", len, srcPos, dstPos);
+
+                        int[] idst = new int[LENGTH];
+                        System.arraycopy(isrc, srcPos, idst, dstPos, len);
+                        check(Arrays.equals(Arrays.copyOfRange(isrc, srcPos, srcPos + len),
+                                            Arrays.copyOfRange(idst, dstPos, dstPos + len)) &&
+                              idst[dstPos + len] == 0, "int", len, srcPos, dstPos);
+
+                        long[] ldst = new long[LENGTH];
+                        System.arraycopy(lsrc, srcPos, ldst, dstPos, len);
+                        check(Arrays.equals(Arrays.copyOfRange(lsrc, srcPos, srcPos + len),
+                                            Arrays.copyOfRange(ldst, dstPos, dstPos + len)) &&
+                              ldst[dstPos + len] == 0, "long", len, srcPos, dstPos);
+
+                        Object[] odst = new Object[LENGTH];
+                        System.arraycopy(osrc, srcPos, odst, dstPos, len);
+                        check(Arrays.equals(Arrays.copyOfRange(osrc, srcPos, srcPos + len),
+                                            Arrays.copyOfRange(odst, dstPos, dstPos + len)) &&
+                              odst[dstPos + len] == null, "Object", len, srcPos, dstPos);
+                    }
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test
+ * @summary C1 hoists loads of fields that are not stored to in a short loop
+ * @run main/othervm -XX:+TieredCompilation -XX:TieredStopAtLevel=1 -Xbatch
+ *                   -XX:CompileOnly=TestLoopInvariantFieldLoad::test TestLoopInvariantFieldLoad
+ */
+
+public class TestLoopInvariantFieldLoad {
+    int a;
+    int b;
+    int c;
+
+    // a is loop invariant, b and c are updated in the loop
+    static int test(TestLoopInvariantFieldLoad o, int n) {
+        int sum = 0;
+        for (int i = 0; i < n; i++) {
+            sum += o.a + o.b;
+            o.b = sum;
+            o.c = o.b + o.c;
+        }
+        return sum + o.c;
+    }
+
+    static int reference(int a, int b, int c, int n) {
+        int sum = 0;
+        for (int i = 0; i < n; i++) {
+            sum += a + b;
+            b = sum;
+            c = b + c;
+        }
+        return sum + c;
+    }
+
+    public static void main(String[] args) {
+        for (int i = 0; i < 20000; i++) {
+            TestLoopInvariantFieldLoad o = new TestLoopInvariantFieldLoad();
+            o.a = i;
+            o.b = 3;
+            o.c = 7;
+            int r = test(o, i % 17);
+            int expected = reference(i, 3, 7, i % 17);
+            if (r != expected) {
+                throw new RuntimeException("wrong result " + r + ", expected " + expected);
+            }
+        }
+    }
+}
@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test
+ * @summary Sampled branch profiling in tier 3 code
+ * @run main/othervm -XX:+TieredCompilation -XX:C1ProfileSamplingPeriod=16 -Xbatch
+ *                   TestSampledBranchProfiling
+ * @run main/othervm -XX:+TieredCompilation -XX:C1ProfileSamplingPeriod=3
+ *                   -XX:TieredStopAtLevel=3 TestSampledBranchProfiling
+ */
+
+public class TestSampledBranchProfiling {
+    static int test(int[] a, long l, double d) {
+        int r = 0;
+        for (int i = 0; i < a.length; i++) {
+            if (a[i] > 10) {
+                r += a[i];
+            } else if (a[i] == 3) {
+                r -= 7;
+            }
+            if (l > i) {
+                r++;
+            }
+            if (d < i) {
+                r ^= i;
+            }
+        }
+        return r;
+    }
+
+    static int reference(int[] a, long l, double d) {
+        int r = 0;
+        for (int i = 0; i < a.length; i++) {
+            int v = a[i];
+            r = v > 10 ? r + v : (v == 3 ? r - 7 : r);
+            r = l > i ? r + 1 : r;
+            r = d < i ? r ^ i : r;
+        }
+        return r;
+    }
+
+    public static void main(String[] args) {
+        int[] a = new int[100];
+        for (int i = 0; i < a.length; i++) {
+            a[i] = i % 20;
+        }
+        for (int i = 0; i < 20000; i++) {
+            long l = i % 150;
+            double d = (i % 130) + 0.5;
+            int r = test(a, l, d);
+            int expected = reference(a, l, d);
+            if (r != expected) {
+                throw new RuntimeException("wrong result " + r + ", expected " + expected);
+            }
+        }
+    }
+}
@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test
+ * @summary Locks of adjacent unrolled loop iterations are coarsened without losing mutual exclusion
+ * @run main/othervm -Xbatch -XX:-UseBiasedLocking LockCoarseningInLoops
+ * @run main/othervm -Xbatch -XX:-UseBiasedLocking -XX:LockCoarseningUnrollLimit=0 LockCoarseningInLoops
+ * @run main/othervm -Xbatch -XX:-UseBiasedLocking -XX:LockCoarseningUnrollLimit=16 LockCoarseningInLoops
+ */
+public class LockCoarseningInLoops {
+    static final int THREADS = 4;
+    static final int ITERATIONS = 2000;
+    static final int ROUNDS = 200;
+
+    long count;
+
+    synchronized void increment() {
+        count++;
+    }
+
+    static void incrementAll(LockCoarseningInLoops c, int n) {
+        for (int i = 0; i < n; i++) {
+            c.increment();
+        }
+    }
+
+    static int appendAll(StringBuffer sb, int n) {
+        for (int i = 0; i < n; i++) {
+            sb.append('x');
+        }
+        return sb.length();
+    }
+
+    public static void main(String[] args) throws Exception {
+        final LockCoarseningInLoops c = new LockCoarseningInLoops();
+        Thread[] threads = new Thread[THREADS];
+        for (int t = 0; t < THREADS; t++) {
+            threads[t] = new Thread() {
+                public void run() {
+                    for (int r = 0; r < ROUNDS; r++) {
+                        incrementAll(c, ITERATIONS);
+                    }
+                }
+            };
+            threads[t].start();
+        }
+        for (Thread t : threads) {
+            t.join();
+        }
+        long expected = (long) THREADS * ROUNDS * ITERATIONS;
+        if (c.count != expected) {
+            throw new RuntimeException("count = " + c.count + ", expected " + expected);
+        }
+
+        for (int r = 0; r < 10000; r++) {
+            int len = appendAll(new StringBuffer(), 100);
+            if (len != 100) {
+                throw new RuntimeException("length = " + len + ", expected 100");
+            }
+        }
+    }
+}
@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test
+ * @summary C2 phases logged with -XX:+LogCompilation report the sizes of the compiler arenas
+ * @library /testlibrary
+ * @run main TestPhaseArenaLogging
+ */
+
+import java.io.BufferedReader;
+import java.io.FileReader;
+
+import com.oracle.java.testlibrary.OutputAnalyzer;
+import com.oracle.java.testlibrary.ProcessTools;
+
+public class TestPhaseArenaLogging {
+  public static class Work {
+    static int sum(int[] a) {
+      int s = 0;
+      for (int i = 0; i < a.length; i++) {
+        s += a[i] * 31 + (a[i] >>> 3);
+      }
+      return s;
+    }
+
+    public static void main(String[] args) {
+      int[] a = new int[100];
+      int s = 0;
+      for (int i = 0; i < 20000; i++) {
+        s += sum(a);
+      }
+      System.out.println(s);
+    }
+  }
+
+  public static void main(String[] args) throws Exception {
+    String logFile = "phases.log";
+    ProcessBuilder pb =
+      ProcessTools.createJavaProcessBuilder("-XX:-TieredCompilation",
+                                            "-XX:+UnlockDiagnosticVMOptions",
+                                            "-XX:+LogCompilation",
+                                            "-XX:LogFile=" + logFile,
+                                            "-XX:CompileOnly=TestPhaseArenaLogging$Work::sum",
+                                            Work.class.getName());
+    OutputAnalyzer output = new OutputAnalyzer(pb.start());
+    output.shouldHaveExitValue(0);
+
+    int phases = 0;
+    BufferedReader in = new BufferedReader(new FileReader(logFile));
+    try {
+      String line;
+      while ((line = in.readLine()) != null) {
+        if (line.startsWith("<phase ") || line.startsWith("<phase_done ")) {
+          if (!line.contains(" node_arena='") || !line.contains(" comp_arena='") ||
+              !line.contains(" resource_area='")) {
+            throw new RuntimeException("Missing arena sizes: " + line);
+          }
+          phases++;
+        }
+      }
+    } finally {
+      in.close();
+    }
+    // A client VM has no C2 phases to check.
+    System.out.println("Checked " + phases + " phase elements");
+  }
+}
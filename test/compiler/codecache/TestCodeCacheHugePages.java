@@ -0,0 +1,54 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test
+ * @summary Back the code cache with transparent huge pages independently of UseLargePages
+ * @requires (os.family == "linux")
+ * @library /testlibrary
+ * @run main TestCodeCacheHugePages
+ */
+import com.oracle.java.testlibrary.*;
+
+public class TestCodeCacheHugePages {
+  public static void main(String[] args) throws Exception {
+    String[][] configs = {
+      { "-XX:-UseLargePages", "-XX:+UseTransparentHugePagesForCodeCache" },
+      { "-XX:-UseLargePages", "-XX:+UseTransparentHugePagesForCodeCache",
+        "-XX:+TieredCompilation", "-XX:+SegmentedCodeCache", "-XX:ReservedCodeCacheSize=240m" },
+      { "-XX:-UseLargePages", "-XX:+UseTransparentHugePagesForCodeCache",
+        "-XX:ReservedCodeCacheSize=1m" },
+    };
+    for (String[] config : configs) {
+      String[] command = new String[config.length + 2];
+      System.arraycopy(config, 0, command, 0, config.length);
+      command[config.length] = "-XX:+PrintCodeCache";
+      command[config.length + 1] = "-version";
+      ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(command);
+      OutputAnalyzer out = new OutputAnalyzer(pb.start());
+      out.shouldContain("CodeCache: size=");
+      out.shouldHaveExitValue(0);
+    }
+  }
+}
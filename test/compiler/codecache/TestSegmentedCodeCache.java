@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test
+ * @summary Test the code heaps and memory pools of the segmented code cache
+ * @library /testlibrary
+ *
+ */
+import java.lang.management.ManagementFactory;
+import java.lang.management.MemoryPoolMXBean;
+import java.util.ArrayList;
+import java.util.List;
+
+import com.oracle.java.testlibrary.*;
+
+public class TestSegmentedCodeCache {
+  private static final String[] SEGMENTS = {
+    "CodeHeap 'non-nmethods'",
+    "CodeHeap 'profiled nmethods'",
+    "CodeHeap 'non-profiled nmethods'"
+  };
+
+  public static void main(String[] args) throws Exception {
+    if (args.length > 0) {
+      checkPools(args[0].equals("segmented"));
+      return;
+    }
+    ProcessBuilder pb;
+    OutputAnalyzer out;
+
+    // Segmented: one memory pool per code heap
+    pb = ProcessTools.createJavaProcessBuilder("-XX:+TieredCompilation", "-XX:+SegmentedCodeCache",
+                                               "-XX:ReservedCodeCacheSize=240m",
+                                               "TestSegmentedCodeCache", "segmented");
+    out = new OutputAnalyzer(pb.start());
+    out.shouldHaveExitValue(0);
+
+    // Not segmented: a single "Code Cache" pool
+    pb = ProcessTools.createJavaProcessBuilder("-XX:-SegmentedCodeCache",
+                                               "TestSegmentedCodeCache", "single");
+    out = new OutputAnalyzer(pb.start());
+    out.shouldHaveExitValue(0);
+
+    // Requires tiered compilation
+    pb = ProcessTools.createJavaProcessBuilder("-XX:-TieredCompilation", "-XX:+SegmentedCodeCache",
+                                               "TestSegmentedCodeCache", "single");
+    out = new OutputAnalyzer(pb.start());
+    out.shouldContain("SegmentedCodeCache requires TieredCompilation");
+    out.shouldHaveExitValue(0);
+
+    // Explicit sizes must add up to ReservedCodeCacheSize
+    pb = ProcessTools.createJavaProcessBuilder("-XX:+TieredCompilation", "-XX:+SegmentedCodeCache",
+                                               "-XX:ReservedCodeCacheSize=240m",
+                                               "-XX:NonNMethodCodeHeapSize=8m",
+                                               "-XX:ProfiledCodeHeapSize=100m",
+                                               "-XX:NonProfiledCodeHeapSize=100m", "-version");
+    out = new OutputAnalyzer(pb.start());
+    out.shouldContain("Invalid code heap sizes");
+    out.shouldHaveExitValue(1);
+
+    // The segments show up in the code cache summary
+    pb = ProcessTools.createJavaProcessBuilder("-XX:+TieredCompilation", "-XX:+SegmentedCodeCache",
+                                               "-XX:ReservedCodeCacheSize=240m",
+                                               "-XX:+PrintCodeCache", "-version");
+    out = new OutputAnalyzer(pb.start());
+    for (String segment : SEGMENTS) {
+      out.shouldContain(segment);
+    }
+    out.shouldHaveExitValue(0);
+  }
+
+  private static void checkPools(boolean segmented) {
+    List<String> names = new ArrayList<String>();
+    for (MemoryPoolMXBean pool : ManagementFactory.getMemoryPoolMXBeans()) {
+      names.add(pool.getName());
+    }
+    if (segmented) {
+      for (String segment : SEGMENTS) {
+        if (!names.contains(segment)) {
+          throw new RuntimeException("Missing memory pool " + segment + " in " + names);
+        }
+      }
+      if (names.contains("Code Cache")) {
+        throw new RuntimeException("Unexpected memory pool Code Cache in " + names);
+      }
+    } else if (!names.contains("Code Cache")) {
+      throw new RuntimeException("Missing memory pool Code Cache in " + names);
+    }
+  }
+}
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/**
+ * @test
+ * @summary Array copy and fill stubs must produce correct results for all
+ *          lengths and offsets when the 512bit (EVEX) code paths are enabled.
+ * @run main/othervm -XX:+IgnoreUnrecognizedVMOptions -XX:UseAVX=3 -XX:+UseUnalignedLoadStores TestArrayCopyFillWide
+ * @run main/othervm -XX:+IgnoreUnrecognizedVMOptions -XX:UseAVX=2 TestArrayCopyFillWide
+ */
+public class TestArrayCopyFillWide {
+
+    static final int MAX = 300;
+
+    static void fill(byte[] a, int from, int to, byte v) {
+        for (int i = from; i < to; i++) {
+            a[i] = v;
+        }
+    }
+
+    static void fill(int[] a, int from, int to, int v) {
+        for (int i = from; i < to; i++) {
+            a[i] = v;
+        }
+    }
+
+    public static void main(String[] args) {
+        byte[] src = new byte[MAX];
+        for (int i = 0; i < MAX; i++) {
+            src[i] = (byte)(i * 7 + 1);
+        }
+        int[] isrc = new int[MAX];
+        for (int i = 0; i < MAX; i++) {
+            isrc[i] = i * 31 + 5;
+        }
+
+        for (int iter = 0; iter < 200; iter++) {
+            for (int len = 0; len < 260; len += (iter < 190 ? 37 : 1)) {
+                for (int off = 0; off < 8; off++) {
+                    checkCopy(src, len, off);
+                    checkCopy(isrc, len / 4, off);
+                    checkFill(len, off);
+                }
+            }
+        }
+    }
+
+    static void checkCopy(byte[] src, int len, int off) {
+        // Disjoint copy
+        byte[] dst = new byte[MAX];
+        System.arraycopy(src, off, dst, off + 3, len);
+        for (int i = 0; i < len; i++) {
+            if (dst[off + 3 + i] != src[off + i]) {
+                throw new RuntimeException("disjoint byte copy: len " + len + " off " + off + " index " + i);
+            }
+        }
+        // Conjoint copy, forward and backward
+        byte[] c = src.clone();
+        System.arraycopy(c, off, c, off + 5, len);
+        byte[] b = src.clone();
+        System.arraycopy(b, off + 5, b, off, len);
+        for (int i = 0; i < len; i++) {
+            if (c[off + 5 + i] != src[off + i] || b[off + i] != src[off + 5 + i]) {
+                throw new RuntimeException("conjoint byte copy: len " + len + " off " + off + " index " + i);
+            }
+        }
+    }
+
+    static void checkCopy(int[] src, int len, int off) {
+        int[] c = src.clone();
+        System.arraycopy(c, off, c, off + 1, len);
+        int[] b = src.clone();
+        System.arraycopy(b, off + 1, b, off, len);
+        for (int i = 0; i < len; i++) {
+            if (c[off + 1 + i] != src[off + i] || b[off + i] != src[off + 1 + i]) {
+                throw new RuntimeException("conjoint int copy: len " + len + " off " + off + " index " + i);
+            }
+        }
+    }
+
+    static void checkFill(int len, int off) {
+        byte[] a = new byte[MAX];
+        fill(a, off, off + len, (byte)0x5A);
+        int[] ia = new int[MAX];
+        fill(ia, off, off + len / 4, 0x12345678);
+        for (int i = 0; i < MAX; i++) {
+            boolean in = i >= off && i < off + len;
+            if (a[i] != (in ? (byte)0x5A : 0)) {
+                throw new RuntimeException("byte fill: len " + len + " off " + off + " index " + i);
+            }
+            in = i >= off && i < off + len / 4;
+            if (ia[i] != (in ? 0x12345678 : 0)) {
+                throw new RuntimeException("int fill: len " + len + " off " + off + " index " + i);
+            }
+        }
+    }
+}
@@ -0,0 +1,52 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+public class TestRegisterCriticalNative {
+    static {
+        System.loadLibrary("TestRegisterCriticalNative");
+    }
+
+    // Both entries are bound from JNI_OnLoad with RegisterNatives.
+    static native int sum(int[] a);
+    static native long criticalCalls();
+
+    public static void main(String[] args) {
+        int[] a = new int[100];
+        int expected = 0;
+        for (int i = 0; i < a.length; i++) {
+            a[i] = i;
+            expected += i;
+        }
+        // Warm up enough to get a compiled native wrapper.
+        for (int i = 0; i < 100000; i++) {
+            int s = sum(a);
+            if (s != expected) {
+                throw new RuntimeException("wrong sum " + s + ", expected " + expected);
+            }
+        }
+        if (criticalCalls() == 0) {
+            throw new RuntimeException("registered critical entry was never used");
+        }
+    }
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2016, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+#include "jni.h"
+
+static jlong critical_calls = 0;
+
+static jint JNICALL sum(JNIEnv* env, jclass cls, jintArray a) {
+  jint len = (*env)->GetArrayLength(env, a);
+  jint* body = (*env)->GetIntArrayElements(env, a, NULL);
+  jint s = 0;
+  jint i;
+  for (i = 0; i < len; i++) {
+    s += body[i];
+  }
+  (*env)->ReleaseIntArrayElements(env, a, body, JNI_ABORT);
+  return s;
+}
+
+// Critical entry: no JNIEnv or jclass, arrays are passed as length and body.
+static jint JNICALL critical_sum(jint len, jint* body) {
+  jint s = 0;
+  jint i;
+  critical_calls++;
+  for (i = 0; i < len; i++) {
+    s += body[i];
+  }
+  return s;
+}
+
+static jlong JNICALL get_critical_calls(JNIEnv* env, jclass cls) {
+  return critical_calls;
+}
+
+JNIEXPORT jint JNICALL JNI_OnLoad(JavaVM* vm, void* reserved) {
+  JNIEnv* env;
+  jclass cls;
+  JNINativeMethod methods[] = {
+    { "sum",           "([I)I",  (void*)sum },
+    { "sum",           "!([I)I", (void*)critical_sum },
+    { "criticalCalls", "()J",    (void*)get_critical_calls }
+  };
+  if ((*vm)->GetEnv(vm, (void**)&env, JNI_VERSION_1_6) != JNI_OK) {
+    return JNI_ERR;
+  }
+  cls = (*env)->FindClass(env, "TestRegisterCriticalNative");
+  if (cls == NULL ||
+      (*env)->RegisterNatives(env, cls, methods, 3) != 0) {
+    return JNI_ERR;
+  }
+  return JNI_VERSION_1_6;
+}
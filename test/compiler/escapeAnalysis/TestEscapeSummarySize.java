@@ -0,0 +1,115 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/**
+ * @test
+ * @summary Bytecode escape summaries of methods larger than
+ *          MaxBCEAEstimateSize are computed up to MaxBCEASummarySize
+ * @requires vm.flavor == "server"
+ * @library /testlibrary
+ * @run main TestEscapeSummarySize
+ */
+
+import com.oracle.java.testlibrary.*;
+
+public class TestEscapeSummarySize {
+    static final String HELPER = "TestEscapeSummarySize::helper";
+
+    static class Point {
+        int x;
+        int y;
+        Point(int x, int y) { this.x = x; this.y = y; }
+    }
+
+    // Well above MaxBCEAEstimateSize but below MaxBCEASummarySize.
+    static int helper(Point p) {
+        int s = 0;
+        s = s * 31 + p.x * 3 + p.y;
+        s = s * 31 + p.x * 4 + p.y;
+        s = s * 31 + p.x * 5 + p.y;
+        s = s * 31 + p.x * 6 + p.y;
+        s = s * 31 + p.x * 7 + p.y;
+        s = s * 31 + p.x * 8 + p.y;
+        s = s * 31 + p.x * 9 + p.y;
+        s = s * 31 + p.x * 10 + p.y;
+        s = s * 31 + p.x * 11 + p.y;
+        s = s * 31 + p.x * 12 + p.y;
+        s = s * 31 + p.x * 13 + p.y;
+        s = s * 31 + p.x * 14 + p.y;
+        s = s * 31 + p.x * 15 + p.y;
+        s = s * 31 + p.x * 16 + p.y;
+        s = s * 31 + p.x * 17 + p.y;
+        s = s * 31 + p.x * 18 + p.y;
+        s = s * 31 + p.x * 19 + p.y;
+        s = s * 31 + p.x * 20 + p.y;
+        s = s * 31 + p.x * 21 + p.y;
+        s = s * 31 + p.x * 22 + p.y;
+        s = s * 31 + p.x * 23 + p.y;
+        s = s * 31 + p.x * 24 + p.y;
+        s = s * 31 + p.x * 25 + p.y;
+        s = s * 31 + p.x * 26 + p.y;
+        return s;
+    }
+
+    static int test(int i) {
+        Point p = new Point(i, i + 1);
+        synchronized (p) {
+            return helper(p);
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        if (args.length > 0) {
+            int sum = 0;
+            for (int i = 0; i < 20_000; i++) {
+                sum += test(i);
+            }
+            System.out.println(sum);
+            return;
+        }
+        String[] common = {
+            "-XX:-TieredCompilation", "-Xbatch", "-XX:BCEATraceLevel=1",
+            "-XX:CompileCommand=compileonly,TestEscapeSummarySize::test",
+            "-XX:CompileCommand=dontinline,TestEscapeSummarySize::helper"
+        };
+
+        OutputAnalyzer out = run(common, "-XX:MaxBCEASummarySize=1000");
+        out.shouldContain("estimating escape information for " + HELPER);
+
+        out = run(common, "-XX:MaxBCEASummarySize=0");
+        out.shouldNotContain("estimating escape information for " + HELPER);
+        out.shouldContain("exceeds MaxBCEAEstimateSize");
+    }
+
+    static OutputAnalyzer run(String[] common, String limit) throws Exception {
+        String[] args = new String[common.length + 3];
+        System.arraycopy(common, 0, args, 0, common.length);
+        args[common.length] = limit;
+        args[common.length + 1] = "TestEscapeSummarySize";
+        args[common.length + 2] = "run";
+        OutputAnalyzer out = new OutputAnalyzer(ProcessTools.createJavaProcessBuilder(args).start());
+        out.shouldHaveExitValue(0);
+        return out;
+    }
+}
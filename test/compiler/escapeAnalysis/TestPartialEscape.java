@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/**
+ * @test
+ * @summary Allocations escaping only on an unlikely path are moved into that path
+ * @run main/othervm -XX:-TieredCompilation -Xbatch -XX:-UseOnStackReplacement
+ *                   -XX:CompileCommand=dontinline,TestPartialEscape::escape
+ *                   -XX:CompileCommand=dontinline,TestPartialEscape::change
+ *                   TestPartialEscape
+ */
+
+public class TestPartialEscape {
+    static class Result {
+        int value;
+        long extra;
+        Result(int value, long extra) {
+            this.value = value;
+            this.extra = extra;
+        }
+    }
+
+    static Result escaped;
+
+    static void escape(Result r) {
+        escaped = r;
+    }
+
+    static void change(Result r) {
+        r.value++;
+    }
+
+    // Escapes only when i is a multiple of 1000.
+    static long test1(int i) {
+        Result r = new Result(i, 2L * i);
+        if (i % 1000 == 0) {
+            escape(r);
+        }
+        return r.value + r.extra;
+    }
+
+    // The callee modifies the object; loads after the call must see it.
+    static int test2(int i) {
+        Result r = new Result(i, 0);
+        if (i % 1000 == 0) {
+            change(r);
+            return r.value;
+        }
+        return r.value - 1;
+    }
+
+    public static void main(String[] args) {
+        for (int i = 0; i < 100_000; i++) {
+            long v = test1(i);
+            if (v != 3L * i) {
+                throw new RuntimeException("test1: " + v + " != " + 3L * i);
+            }
+            if (i % 1000 == 0 && (escaped.value != i || escaped.extra != 2L * i)) {
+                throw new RuntimeException("test1: wrong escaped object at " + i);
+            }
+            int w = test2(i);
+            int expected = (i % 1000 == 0) ? i + 1 : i - 1;
+            if (w != expected) {
+                throw new RuntimeException("test2: " + w + " != " + expected);
+            }
+        }
+    }
+}
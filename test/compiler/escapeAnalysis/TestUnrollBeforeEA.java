@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test
+ * @summary Small loops over non-escaping arrays are fully unrolled before escape analysis
+ * @run main/othervm -Xbatch -XX:CompileCommand=dontinline,TestUnrollBeforeEA::test* TestUnrollBeforeEA
+ * @run main/othervm -Xbatch -XX:-EliminateAllocations TestUnrollBeforeEA
+ */
+public class TestUnrollBeforeEA {
+    static int testSum(int a, int b) {
+        int[] values = new int[8];
+        for (int i = 0; i < values.length; i++) {
+            values[i] = a * i + b;
+        }
+        int sum = 0;
+        for (int i = 0; i < values.length; i++) {
+            sum += values[i];
+        }
+        return sum;
+    }
+
+    static long testOddTrips(long x) {
+        long[] values = new long[5];
+        for (int i = 0; i < 5; i++) {
+            values[i] = x << i;
+        }
+        return values[0] ^ values[2] ^ values[4];
+    }
+
+    static Object[] sink;
+
+    static int testEscapes(int a) {
+        Integer[] boxes = new Integer[4];
+        for (int i = 0; i < boxes.length; i++) {
+            boxes[i] = a + i;
+        }
+        if (a == 12345) {
+            sink = boxes; // uncommon: deoptimization must rematerialize the array
+        }
+        return boxes[3];
+    }
+
+    public static void main(String[] args) {
+        for (int n = 0; n < 20000; n++) {
+            int expected = 0;
+            for (int i = 0; i < 8; i++) {
+                expected += n * i + 3;
+            }
+            if (testSum(n, 3) != expected) {
+                throw new RuntimeException("testSum(" + n + ", 3) = " + testSum(n, 3));
+            }
+            long x = n;
+            if (testOddTrips(x) != (x ^ (x << 2) ^ (x << 4))) {
+                throw new RuntimeException("testOddTrips(" + n + ")");
+            }
+            if (testEscapes(n) != n + 3) {
+                throw new RuntimeException("testEscapes(" + n + ")");
+            }
+        }
+        if (testEscapes(12345) != 12348 || sink.length != 4 || !sink[0].equals(12345)) {
+            throw new RuntimeException("wrong rematerialized array");
+        }
+    }
+}
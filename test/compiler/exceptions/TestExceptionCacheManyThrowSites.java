@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test
+ * @summary Exceptions of several types thrown from many call sites must reach the right handler
+ * @run main/othervm -Xbatch -XX:-UseOnStackReplacement TestExceptionCacheManyThrowSites
+ */
+public class TestExceptionCacheManyThrowSites {
+  static class E0 extends RuntimeException { }
+  static class E1 extends RuntimeException { }
+  static class E2 extends RuntimeException { }
+
+  static void thrower(int kind) {
+    switch (kind % 4) {
+      case 0: throw new E0();
+      case 1: throw new E1();
+      case 2: throw new E2();
+      default: throw new IllegalStateException();
+    }
+  }
+
+  static int site(int kind) {
+    int r = 0;
+    try { thrower(kind);     } catch (E0 e) { r += 1; } catch (E1 e) { r += 2; } catch (RuntimeException e) { r += 3; }
+    try { thrower(kind + 1); } catch (E0 e) { r += 10; } catch (E1 e) { r += 20; } catch (RuntimeException e) { r += 30; }
+    try { thrower(kind + 2); } catch (E2 e) { r += 100; } catch (RuntimeException e) { r += 200; }
+    try { thrower(kind + 3); } catch (IllegalStateException e) { r += 1000; } catch (RuntimeException e) { r += 2000; }
+    return r;
+  }
+
+  static int expected(int kind) {
+    int[] first  = { 1, 2, 3, 3 };
+    int[] second = { 10, 20, 30, 30 };
+    int[] third  = { 200, 200, 100, 200 };
+    int[] fourth = { 2000, 2000, 2000, 1000 };
+    return first[kind % 4] + second[(kind + 1) % 4] + third[(kind + 2) % 4] + fourth[(kind + 3) % 4];
+  }
+
+  public static void main(String[] args) {
+    for (int i = 0; i < 40000; i++) {
+      int kind = i % 4;
+      int r = site(kind);
+      if (r != expected(kind)) {
+        throw new RuntimeException("Wrong handler for kind " + kind + ": " + r + " != " + expected(kind));
+      }
+    }
+  }
+}
@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test
+ * @summary Monomorphic virtual calls that turn megamorphic must keep dispatching correctly
+ * @run main/othervm -Xbatch -XX:InlineCacheBufferSize=1024 TestMegamorphicTransition
+ * @run main/othervm -Xbatch -XX:TieredStopAtLevel=1 TestMegamorphicTransition
+ */
+public class TestMegamorphicTransition {
+  static abstract class A { abstract int value(); }
+  static class B0 extends A { int value() { return 0; } }
+  static class B1 extends A { int value() { return 1; } }
+  static class B2 extends A { int value() { return 2; } }
+  static class B3 extends A { int value() { return 3; } }
+  static class B4 extends A { int value() { return 4; } }
+
+  static int call(A a) {
+    return a.value();
+  }
+
+  public static void main(String[] args) throws Exception {
+    final A[] receivers = { new B0(), new B1(), new B2(), new B3(), new B4() };
+    // Warm up with a single receiver so that the call site is monomorphic.
+    for (int i = 0; i < 20000; i++) {
+      if (call(receivers[0]) != 0) {
+        throw new RuntimeException("wrong dispatch during warmup");
+      }
+    }
+    // Several threads race to make the call site megamorphic.
+    Thread[] threads = new Thread[4];
+    final Throwable[] failure = new Throwable[1];
+    for (int t = 0; t < threads.length; t++) {
+      threads[t] = new Thread() {
+        public void run() {
+          try {
+            for (int i = 0; i < 200000; i++) {
+              int k = i % receivers.length;
+              if (call(receivers[k]) != k) {
+                throw new RuntimeException("wrong dispatch for receiver " + k);
+              }
+            }
+          } catch (Throwable e) {
+            failure[0] = e;
+          }
+        }
+      };
+      threads[t].start();
+    }
+    for (Thread t : threads) {
+      t.join();
+    }
+    if (failure[0] != null) {
+      throw new RuntimeException(failure[0]);
+    }
+  }
+}
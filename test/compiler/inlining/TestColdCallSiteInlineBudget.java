@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/**
+ * @test
+ * @summary Infrequent call sites stop inlining once ColdCallSiteInlineBudget is used up
+ *
+ * @run main/othervm -Xbatch -XX:ColdCallSiteInlineBudget=0 TestColdCallSiteInlineBudget
+ * @run main/othervm -Xbatch -XX:ColdCallSiteInlineBudget=100 TestColdCallSiteInlineBudget
+ */
+public class TestColdCallSiteInlineBudget {
+    static int field;
+
+    static int hot(int i) {
+        int r = i;
+        for (int j = 0; j < 3; j++) {
+            r = r * 31 + j;
+        }
+        return r;
+    }
+
+    static int cold(int i) {
+        int r = i;
+        for (int j = 0; j < 5; j++) {
+            r = r ^ (r << 3) + j;
+        }
+        field = r;
+        return r;
+    }
+
+    static int test(int i) {
+        int r = hot(i);
+        if ((i & 1023) == 0) {
+            r += cold(i);
+        }
+        return r;
+    }
+
+    static int reference(int i) {
+        int r = i;
+        for (int j = 0; j < 3; j++) {
+            r = r * 31 + j;
+        }
+        if ((i & 1023) == 0) {
+            int c = i;
+            for (int j = 0; j < 5; j++) {
+                c = c ^ (c << 3) + j;
+            }
+            r += c;
+        }
+        return r;
+    }
+
+    public static void main(String[] args) {
+        for (int i = 0; i < 50000; i++) {
+            int expected = reference(i);
+            int actual = test(i);
+            if (actual != expected) {
+                throw new RuntimeException("Wrong result for " + i + ": " + actual + " != " + expected);
+            }
+        }
+    }
+}
@@ -0,0 +1,81 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/**
+ * @test
+ * @summary Call sites with more than two profiled receivers are dispatched with a tree of type checks
+ *
+ * @run main/othervm -Xbatch -XX:TypeProfileWidth=4 TestPolymorphicInlining
+ * @run main/othervm -Xbatch -XX:TypeProfileWidth=4 -XX:PolymorphicInlineLimit=3 TestPolymorphicInlining
+ * @run main/othervm -Xbatch -XX:TypeProfileWidth=4 -XX:-UsePolymorphicInlining TestPolymorphicInlining
+ */
+public class TestPolymorphicInlining {
+    interface Shape {
+        int id();
+    }
+
+    static class A implements Shape { public int id() { return 1; } }
+    static class B implements Shape { public int id() { return 2; } }
+    static class C implements Shape { public int id() { return 3; } }
+    static class D implements Shape { public int id() { return 4; } }
+    static class E implements Shape { public int id() { return 5; } }
+
+    static abstract class Base {
+        abstract int id();
+    }
+
+    static class P extends Base { int id() { return 1; } }
+    static class Q extends Base { int id() { return 2; } }
+    static class R extends Base { int id() { return 3; } }
+    static class S extends Base { int id() { return 4; } }
+
+    static int interfaceCall(Shape s) {
+        return s.id();
+    }
+
+    static int virtualCall(Base b) {
+        return b.id();
+    }
+
+    public static void main(String[] args) {
+        Shape[] shapes = { new A(), new B(), new C(), new D() };
+        Base[] bases = { new P(), new Q(), new R(), new S() };
+        for (int i = 0; i < 100000; i++) {
+            // skew the profile so the receivers have different frequencies
+            int k = (i % 10 < 5) ? 0 : (i % 10 < 8) ? 1 : (i % 10 < 9) ? 2 : 3;
+            if (interfaceCall(shapes[k]) != k + 1) {
+                throw new RuntimeException("wrong interface target for receiver " + k);
+            }
+            if (virtualCall(bases[k]) != k + 1) {
+                throw new RuntimeException("wrong virtual target for receiver " + k);
+            }
+        }
+        // A receiver that was never profiled must take the miss path.
+        for (int i = 0; i < 100; i++) {
+            if (interfaceCall(new E()) != 5) {
+                throw new RuntimeException("wrong interface target for unprofiled receiver");
+            }
+        }
+    }
+}
@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test
+ * @summary Check that the Adler32 intrinsics compute the same checksum as a reference implementation
+ * @run main/othervm -Xbatch -XX:+UseAdler32Intrinsics TestAdler32
+ * @run main/othervm -Xbatch -XX:-UseAdler32Intrinsics TestAdler32
+ */
+
+import java.nio.ByteBuffer;
+import java.util.Random;
+import java.util.zip.Adler32;
+
+public class TestAdler32 {
+    static final int BASE = 65521;
+
+    static long reference(byte[] b, int off, int len) {
+        long s1 = 1, s2 = 0;
+        for (int i = off; i < off + len; i++) {
+            s1 = (s1 + (b[i] & 0xff)) % BASE;
+            s2 = (s2 + s1) % BASE;
+        }
+        return (s2 << 16) | s1;
+    }
+
+    static long arrayChecksum(byte[] b, int off, int len) {
+        Adler32 a = new Adler32();
+        a.update(b, off, len);
+        return a.getValue();
+    }
+
+    static long bufferChecksum(ByteBuffer buf, int off, int len) {
+        Adler32 a = new Adler32();
+        buf.limit(off + len).position(off);
+        a.update(buf);
+        return a.getValue();
+    }
+
+    public static void main(String[] args) {
+        Random r = new Random(42);
+        byte[] data = new byte[20000];
+        ByteBuffer direct = ByteBuffer.allocateDirect(data.length);
+        for (int iter = 0; iter < 20000; iter++) {
+            if ((iter & 1023) == 0) {
+                r.nextBytes(data);
+                if (iter == 0) {
+                    // All ones maximizes the sums and exercises the NMAX bound.
+                    java.util.Arrays.fill(data, (byte)0xff);
+                }
+                direct.clear();
+                direct.put(data);
+            }
+            int off = r.nextInt(16);
+            int len = (iter < 10) ? data.length - off : r.nextInt(data.length - off);
+            long expected = reference(data, off, len);
+            long got = arrayChecksum(data, off, len);
+            if (got != expected) {
+                throw new RuntimeException("byte[] checksum mismatch at iteration " + iter +
+                                           ": " + got + " != " + expected);
+            }
+            got = bufferChecksum(direct, off, len);
+            if (got != expected) {
+                throw new RuntimeException("direct buffer checksum mismatch at iteration " + iter +
+                                           ": " + got + " != " + expected);
+            }
+        }
+    }
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test
+ * @summary Check that AES/GCM output does not change once GHASH.processBlocks is intrinsified
+ * @run main/othervm -Xbatch -XX:+UseGHASHIntrinsics TestGHASH
+ * @run main/othervm -Xbatch -XX:-UseGHASHIntrinsics TestGHASH
+ */
+
+import java.util.Arrays;
+import java.util.Random;
+import javax.crypto.Cipher;
+import javax.crypto.spec.GCMParameterSpec;
+import javax.crypto.spec.SecretKeySpec;
+
+public class TestGHASH {
+    static final int ITERATIONS = 20000;
+
+    public static void main(String[] args) throws Exception {
+        Random r = new Random(42);
+        byte[] key = new byte[16];
+        byte[] iv = new byte[12];
+        byte[] aad = new byte[37];
+        byte[] msg = new byte[1027];
+        r.nextBytes(key);
+        r.nextBytes(iv);
+        r.nextBytes(aad);
+        r.nextBytes(msg);
+        SecretKeySpec keySpec = new SecretKeySpec(key, "AES");
+
+        // The ciphertext and tag are computed before GHASH is compiled.
+        Cipher enc = Cipher.getInstance("AES/GCM/NoPadding");
+        enc.init(Cipher.ENCRYPT_MODE, keySpec, new GCMParameterSpec(128, iv));
+        enc.updateAAD(aad);
+        byte[] ct = enc.doFinal(msg);
+
+        // Decryption recomputes the tag and throws AEADBadTagException on
+        // a mismatch, so this also checks the compiled GHASH.
+        for (int i = 0; i < ITERATIONS; i++) {
+            Cipher dec = Cipher.getInstance("AES/GCM/NoPadding");
+            dec.init(Cipher.DECRYPT_MODE, keySpec, new GCMParameterSpec(128, iv));
+            dec.updateAAD(aad);
+            byte[] pt = dec.doFinal(ct);
+            if (!Arrays.equals(pt, msg)) {
+                throw new RuntimeException("decryption mismatch at iteration " + i);
+            }
+        }
+    }
+}
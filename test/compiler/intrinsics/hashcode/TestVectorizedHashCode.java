@@ -0,0 +1,91 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test
+ * @summary String.hashCode() and Arrays.hashCode(char[]/byte[]) intrinsics must match the Java code
+ * @run main/othervm -XX:-BackgroundCompilation -XX:-UseOnStackReplacement TestVectorizedHashCode
+ * @run main/othervm -XX:-BackgroundCompilation -XX:-UseOnStackReplacement
+ *                   -XX:-UseVectorizedHashCodeIntrinsic TestVectorizedHashCode
+ */
+
+import java.util.Arrays;
+
+public class TestVectorizedHashCode {
+
+    static int stringHash(String s) {
+        return s.hashCode();
+    }
+
+    static int charsHash(char[] a) {
+        return Arrays.hashCode(a);
+    }
+
+    static int bytesHash(byte[] a) {
+        return Arrays.hashCode(a);
+    }
+
+    static int expected(int init, char[] a) {
+        int h = init;
+        for (char c : a) {
+            h = 31 * h + c;
+        }
+        return h;
+    }
+
+    static int expected(byte[] a) {
+        int h = 1;
+        for (byte b : a) {
+            h = 31 * h + b;
+        }
+        return h;
+    }
+
+    public static void main(String[] args) {
+        for (int iter = 0; iter < 20000; iter++) {
+            int len = iter % 150;
+            char[] chars = new char[len];
+            byte[] bytes = new byte[len];
+            for (int i = 0; i < len; i++) {
+                chars[i] = (char)(iter * 0x9E37 + i * 131);
+                bytes[i] = (byte)(iter * 7 - i * 13);
+            }
+            String s = new String(chars);
+            int h = stringHash(s);
+            if (h != expected(0, chars) || stringHash(s) != h) {
+                throw new RuntimeException("String.hashCode() mismatch for length " + len);
+            }
+            if (charsHash(chars) != expected(1, chars)) {
+                throw new RuntimeException("Arrays.hashCode(char[]) mismatch for length " + len);
+            }
+            if (bytesHash(bytes) != expected(bytes)) {
+                throw new RuntimeException("Arrays.hashCode(byte[]) mismatch for length " + len);
+            }
+            if (charsHash(null) != 0 || bytesHash(null) != 0) {
+                throw new RuntimeException("Arrays.hashCode(null) must be 0");
+            }
+        }
+        System.out.println("TEST PASSED");
+    }
+}
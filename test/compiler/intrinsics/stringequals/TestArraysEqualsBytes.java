@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test
+ * @summary Arrays.equals(byte[], byte[]) intrinsic must handle all tail lengths
+ * @run main/othervm -XX:-BackgroundCompilation -XX:-UseOnStackReplacement TestArraysEqualsBytes
+ * @run main/othervm -XX:-BackgroundCompilation -XX:-UseOnStackReplacement -XX:UseAVX=0 TestArraysEqualsBytes
+ */
+
+import java.util.Arrays;
+
+public class TestArraysEqualsBytes {
+
+    static boolean equals(byte[] a, byte[] b) {
+        return Arrays.equals(a, b);
+    }
+
+    public static void main(String[] args) {
+        for (int iter = 0; iter < 20000; iter++) {
+            int len = iter % 100;
+            byte[] a = new byte[len];
+            for (int i = 0; i < len; i++) {
+                a[i] = (byte)(iter + i * 31);
+            }
+            byte[] b = a.clone();
+            if (!equals(a, b) || !equals(a, a)) {
+                throw new RuntimeException("equal arrays of length " + len + " compare unequal");
+            }
+            if (len > 0) {
+                int pos = iter % len;
+                b[pos] ^= 1;
+                if (equals(a, b)) {
+                    throw new RuntimeException("arrays differing at " + pos + " of " + len + " compare equal");
+                }
+            }
+            if (equals(a, new byte[len + 1]) || equals(a, null) || equals(null, a) || !equals(null, null)) {
+                throw new RuntimeException("length or null check failed");
+            }
+        }
+        System.out.println("TEST PASSED");
+    }
+}
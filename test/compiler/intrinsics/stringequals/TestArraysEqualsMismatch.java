@@ -0,0 +1,84 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test
+ * @summary Arrays.equals(short[]/int[]/long[]) mismatch intrinsic must handle all tail lengths
+ * @run main/othervm -XX:-BackgroundCompilation -XX:-UseOnStackReplacement TestArraysEqualsMismatch
+ * @run main/othervm -XX:-BackgroundCompilation -XX:-UseOnStackReplacement -XX:-UseVectorizedMismatchIntrinsic TestArraysEqualsMismatch
+ */
+
+import java.util.Arrays;
+
+public class TestArraysEqualsMismatch {
+
+    static boolean equals(short[] a, short[] b) { return Arrays.equals(a, b); }
+    static boolean equals(int[] a, int[] b)     { return Arrays.equals(a, b); }
+    static boolean equals(long[] a, long[] b)   { return Arrays.equals(a, b); }
+
+    static void check(boolean ok, String what, int len, int pos) {
+        if (!ok) {
+            throw new RuntimeException(what + " failed for length " + len + " at " + pos);
+        }
+    }
+
+    public static void main(String[] args) {
+        for (int iter = 0; iter < 20000; iter++) {
+            int len = iter % 70;
+            int pos = len > 0 ? iter % len : 0;
+
+            short[] s = new short[len];
+            int[] i = new int[len];
+            long[] l = new long[len];
+            for (int k = 0; k < len; k++) {
+                s[k] = (short)(iter + k * 31);
+                i[k] = iter * 17 + k * 31;
+                l[k] = ((long)iter << 33) + k * 31;
+            }
+            short[] s2 = s.clone();
+            int[] i2 = i.clone();
+            long[] l2 = l.clone();
+            check(equals(s, s2) && equals(s, s), "short[] equal", len, -1);
+            check(equals(i, i2) && equals(i, i), "int[] equal", len, -1);
+            check(equals(l, l2) && equals(l, l), "long[] equal", len, -1);
+            if (len > 0) {
+                // Flip the highest bit so the difference is in the last byte
+                // of the element.
+                s2[pos] ^= (short)0x8000;
+                i2[pos] ^= 0x80000000;
+                l2[pos] ^= 0x8000000000000000L;
+                check(!equals(s, s2), "short[] differ", len, pos);
+                check(!equals(i, i2), "int[] differ", len, pos);
+                check(!equals(l, l2), "long[] differ", len, pos);
+            }
+            check(!equals(s, new short[len + 1]) && !equals(s, null) && !equals(null, s) &&
+                  equals((short[])null, (short[])null), "short[] length/null", len, -1);
+            check(!equals(i, new int[len + 1]) && !equals(i, null) && !equals(null, i) &&
+                  equals((int[])null, (int[])null), "int[] length/null", len, -1);
+            check(!equals(l, new long[len + 1]) && !equals(l, null) && !equals(null, l) &&
+                  equals((long[])null, (long[])null), "long[] length/null", len, -1);
+        }
+        System.out.println("TEST PASSED");
+    }
+}
@@ -0,0 +1,112 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/**
+ * @test
+ * @summary Loops with a long trip counter in int range are converted to int counted loops
+ *
+ * @run main/othervm -Xbatch -XX:-TieredCompilation TestLongLoopToInt
+ * @run main/othervm -Xbatch -XX:-TieredCompilation -XX:-ConvertLongLoopsToInt TestLongLoopToInt
+ */
+public class TestLongLoopToInt {
+    static long sumUp(int[] a) {
+        long sum = 0;
+        for (long i = 0; i < a.length; i++) {
+            sum += a[(int)i] * i;
+        }
+        return sum;
+    }
+
+    static long sumDown(int[] a) {
+        long sum = 0;
+        long i;
+        for (i = a.length - 1; i >= 0; i -= 3) {
+            sum += a[(int)i];
+        }
+        return sum + i;
+    }
+
+    static long sumFrom(int[] a, int from) {
+        long sum = 0;
+        for (long i = (from & 0xffff) - 10; i < a.length; i++) {
+            sum += a[(int)i];
+        }
+        return sum;
+    }
+
+    static long bigLimit(long limit) {
+        // Not convertible: the limit does not fit in an int.
+        long count = 0;
+        for (long i = Integer.MAX_VALUE - 10L; i < limit; i++) {
+            count++;
+        }
+        return count;
+    }
+
+    static long total(int[] a) {
+        long sum = 0;
+        for (int i = 0; i < a.length; i++) {
+            sum += a[i];
+        }
+        return sum;
+    }
+
+    public static void main(String[] args) {
+        int[] a = new int[1000];
+        for (int i = 0; i < a.length; i++) {
+            a[i] = i + 1;
+        }
+        long up = 0;
+        for (int i = 0; i < a.length; i++) {
+            up += (long)a[i] * i;
+        }
+        long down = 0;
+        int last = 0;
+        for (int i = a.length - 1; i >= 0; i -= 3) {
+            down += a[i];
+            last = i;
+        }
+        down += last - 3;
+        for (int k = 0; k < 20000; k++) {
+            if (sumUp(a) != up) {
+                throw new RuntimeException("wrong sumUp: " + sumUp(a) + " != " + up);
+            }
+            if (sumDown(a) != down) {
+                throw new RuntimeException("wrong sumDown: " + sumDown(a) + " != " + down);
+            }
+            if (sumFrom(a, 10) != total(a)) {
+                throw new RuntimeException("wrong sumFrom");
+            }
+            if (bigLimit(Integer.MAX_VALUE + 10L) != 20) {
+                throw new RuntimeException("wrong bigLimit");
+            }
+        }
+        try {
+            sumFrom(a, 0);
+            throw new RuntimeException("missing AIOOBE");
+        } catch (ArrayIndexOutOfBoundsException e) {
+            // expected
+        }
+    }
+}
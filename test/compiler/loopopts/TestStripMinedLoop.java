@@ -0,0 +1,110 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/**
+ * @test
+ * @summary Counted loops keeping a safepoint are strip mined into a nest
+ * @requires vm.flavor == "server"
+ * @run main/othervm -XX:-TieredCompilation -Xbatch -XX:-UseOnStackReplacement
+ *                   -XX:+UseCountedLoopSafepoints -XX:LoopStripMiningIter=1000
+ *                   TestStripMinedLoop
+ * @run main/othervm -XX:-TieredCompilation -Xbatch -XX:-UseOnStackReplacement
+ *                   -XX:+UseCountedLoopSafepoints -XX:LoopStripMiningIter=7
+ *                   TestStripMinedLoop
+ */
+
+public class TestStripMinedLoop {
+    static volatile boolean done;
+
+    static long sumUp(int[] a, int from, int to) {
+        long s = 0;
+        for (int i = from; i < to; i++) {
+            s += a[i];
+        }
+        return s;
+    }
+
+    static long sumDown(int[] a, int from, int to) {
+        long s = 0;
+        for (int i = to; i >= from; i -= 3) {
+            s += a[i];
+        }
+        return s;
+    }
+
+    static void fill(int[] a, int v) {
+        for (int i = 0; i < a.length; i++) {
+            a[i] = v + i;
+        }
+    }
+
+    static int nearMax(int n) {
+        int c = 0;
+        for (int i = Integer.MAX_VALUE - n; i < Integer.MAX_VALUE; i++) {
+            c++;
+        }
+        return c;
+    }
+
+    public static void main(String[] args) throws Exception {
+        Thread gc = new Thread() {
+            public void run() {
+                while (!done) {
+                    System.gc();
+                }
+            }
+        };
+        gc.setDaemon(true);
+        gc.start();
+
+        int[] a = new int[10_007];
+        for (int iter = 0; iter < 20_000; iter++) {
+            fill(a, iter);
+            int from = iter % 17;
+            int to = a.length - (iter % 13);
+            long expected = 0;
+            for (int i = from; i < to; i++) {
+                expected += iter + i;
+            }
+            long up = sumUp(a, from, to);
+            if (up != expected) {
+                throw new RuntimeException("sumUp: " + up + " != " + expected);
+            }
+            expected = 0;
+            for (int i = to - 1; i >= from; i -= 3) {
+                expected += iter + i;
+            }
+            long down = sumDown(a, from, to - 1);
+            if (down != expected) {
+                throw new RuntimeException("sumDown: " + down + " != " + expected);
+            }
+            int n = iter % 3000;
+            int c = nearMax(n);
+            if (c != n) {
+                throw new RuntimeException("nearMax: " + c + " != " + n);
+            }
+        }
+        done = true;
+    }
+}
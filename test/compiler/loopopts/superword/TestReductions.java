@@ -0,0 +1,136 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/**
+ * @test
+ * @summary Vectorized reductions must compute the same values as the scalar loop,
+ *          including the strict evaluation order of floating point sums.
+ * @run main/othervm -XX:+IgnoreUnrecognizedVMOptions -XX:+SuperWordReductions TestReductions
+ * @run main/othervm -XX:+IgnoreUnrecognizedVMOptions -XX:-SuperWordReductions TestReductions
+ */
+public class TestReductions {
+
+    static final int LEN = 1003;
+
+    static int sumI(int[] a) {
+        int s = 0;
+        for (int i = 0; i < a.length; i++) {
+            s += a[i];
+        }
+        return s;
+    }
+
+    static int mulI(int[] a) {
+        int s = 1;
+        for (int i = 0; i < a.length; i++) {
+            s *= a[i];
+        }
+        return s;
+    }
+
+    static int xorI(int[] a, int[] b) {
+        int s = 0;
+        for (int i = 0; i < a.length; i++) {
+            s ^= a[i] & b[i];
+        }
+        return s;
+    }
+
+    static long sumL(long[] a) {
+        long s = 0;
+        for (int i = 0; i < a.length; i++) {
+            s += a[i];
+        }
+        return s;
+    }
+
+    static float sumF(float[] a, float[] b) {
+        float s = 0.0f;
+        for (int i = 0; i < a.length; i++) {
+            s += a[i] * b[i];
+        }
+        return s;
+    }
+
+    static double sumD(double[] a) {
+        double s = 0.0;
+        for (int i = 0; i < a.length; i++) {
+            s += a[i];
+        }
+        return s;
+    }
+
+    static double mulD(double[] a) {
+        double s = 1.0;
+        for (int i = 0; i < a.length; i++) {
+            s *= a[i];
+        }
+        return s;
+    }
+
+    public static void main(String[] args) {
+        int[] ia = new int[LEN];
+        int[] ib = new int[LEN];
+        long[] la = new long[LEN];
+        float[] fa = new float[LEN];
+        float[] fb = new float[LEN];
+        double[] da = new double[LEN];
+        double[] dm = new double[LEN];
+        for (int i = 0; i < LEN; i++) {
+            ia[i] = i * 31 + 7;
+            ib[i] = ~(i * 17);
+            la[i] = (long)i << 33 | i;
+            // Magnitudes far apart make the sum sensitive to the evaluation order.
+            fa[i] = (i % 3 == 0) ? 1.0e7f : 0.3f + i;
+            fb[i] = 1.0f / (i + 1);
+            da[i] = (i % 5 == 0) ? 1.0e17 * (i + 1) : 0.1 * i;
+            dm[i] = 1.0 + 1.0 / (i + 3);
+        }
+
+        // The first results come from the interpreter.
+        int    gSumI = sumI(ia);
+        int    gMulI = mulI(ia);
+        int    gXorI = xorI(ia, ib);
+        long   gSumL = sumL(la);
+        float  gSumF = sumF(fa, fb);
+        double gSumD = sumD(da);
+        double gMulD = mulD(dm);
+
+        for (int i = 0; i < 20_000; i++) {
+            check("sumI", sumI(ia) == gSumI);
+            check("mulI", mulI(ia) == gMulI);
+            check("xorI", xorI(ia, ib) == gXorI);
+            check("sumL", sumL(la) == gSumL);
+            check("sumF", Float.floatToRawIntBits(sumF(fa, fb)) == Float.floatToRawIntBits(gSumF));
+            check("sumD", Double.doubleToRawLongBits(sumD(da)) == Double.doubleToRawLongBits(gSumD));
+            check("mulD", Double.doubleToRawLongBits(mulD(dm)) == Double.doubleToRawLongBits(gMulD));
+        }
+    }
+
+    static void check(String name, boolean ok) {
+        if (!ok) {
+            throw new RuntimeException("Wrong result from " + name);
+        }
+    }
+}
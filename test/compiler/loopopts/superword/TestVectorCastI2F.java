@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/**
+ * @test
+ * @summary Vectorized int to float conversions must round like the scalar code.
+ * @run main/othervm -Xbatch -XX:CompileCommand=exclude,TestVectorCastI2F::verify TestVectorCastI2F
+ * @run main/othervm -Xbatch -XX:-UseSuperWord TestVectorCastI2F
+ */
+public class TestVectorCastI2F {
+
+    static final int LEN = 1003;
+
+    static void convert(int[] a, float[] b) {
+        for (int i = 0; i < a.length; i++) {
+            b[i] = (float)a[i];
+        }
+    }
+
+    static void convertScaled(int[] a, float[] b, float scale) {
+        for (int i = 0; i < a.length; i++) {
+            b[i] = (float)(a[i] + 1) * scale;
+        }
+    }
+
+    static void verify(int[] a, float[] b, float[] c, float scale) {
+        for (int i = 0; i < LEN; i++) {
+            float f = (float)a[i];
+            if (Float.floatToRawIntBits(b[i]) != Float.floatToRawIntBits(f)) {
+                throw new RuntimeException("convert: " + a[i] + " -> " + b[i] + ", expected " + f);
+            }
+            float g = (float)(a[i] + 1) * scale;
+            if (Float.floatToRawIntBits(c[i]) != Float.floatToRawIntBits(g)) {
+                throw new RuntimeException("convertScaled: " + a[i] + " -> " + c[i] + ", expected " + g);
+            }
+        }
+    }
+
+    public static void main(String[] args) {
+        int[] a = new int[LEN];
+        float[] b = new float[LEN];
+        float[] c = new float[LEN];
+        for (int i = 0; i < LEN; i++) {
+            // Values above 2^24 are not exactly representable and must round to nearest even.
+            a[i] = (i % 2 == 0) ? (i * 0x3FFFF1 + 0x1000001) : -i * 13;
+        }
+        a[0] = Integer.MAX_VALUE;
+        a[1] = Integer.MIN_VALUE;
+        for (int n = 0; n < 20000; n++) {
+            convert(a, b);
+            convertScaled(a, c, 0.5f);
+        }
+        verify(a, b, c, 0.5f);
+    }
+}
@@ -0,0 +1,61 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test
+ * @summary register allocation without conservative coalescing in split-recycle rounds must be correct
+ * @run main/othervm -XX:-BackgroundCompilation -XX:-UseOnStackReplacement -XX:RegAllocCheapNodeLimit=1 TestCheapRecycle
+ */
+public class TestCheapRecycle {
+
+    // Enough simultaneously live values to force spilling on every platform.
+    static long test(long[] a, int n) {
+        long v0 = a[0], v1 = a[1], v2 = a[2], v3 = a[3], v4 = a[4], v5 = a[5], v6 = a[6], v7 = a[7];
+        long v8 = a[8], v9 = a[9], v10 = a[10], v11 = a[11], v12 = a[12], v13 = a[13], v14 = a[14], v15 = a[15];
+        long v16 = a[16], v17 = a[17], v18 = a[18], v19 = a[19];
+        for (int i = 0; i < n; i++) {
+            v0 += v19 * i; v1 ^= v0;  v2 += v1 >> 3; v3 -= v2;  v4 += v3 * 7;
+            v5 ^= v4 << 1; v6 += v5;  v7 -= v6 ^ i;  v8 += v7;  v9 ^= v8 * 3;
+            v10 += v9;     v11 -= v10; v12 ^= v11;   v13 += v12; v14 -= v13 >> 1;
+            v15 ^= v14;    v16 += v15; v17 -= v16;   v18 ^= v17; v19 += v18 + 1;
+        }
+        return v0 + v1 + v2 + v3 + v4 + v5 + v6 + v7 + v8 + v9 +
+               v10 + v11 + v12 + v13 + v14 + v15 + v16 + v17 + v18 + v19;
+    }
+
+    public static void main(String[] args) {
+        long[] a = new long[20];
+        for (int i = 0; i < a.length; i++) {
+            a[i] = i * 0x9E3779B97F4A7C15L;
+        }
+        long expected = test(a, 100);
+        for (int i = 0; i < 20000; i++) {
+            long r = test(a, 100);
+            if (r != expected) {
+                throw new RuntimeException("expected " + expected + " but got " + r);
+            }
+        }
+        System.out.println("TEST PASSED");
+    }
+}
@@ -0,0 +1,68 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test
+ * @summary Stress starting and retiring compiler threads on demand
+ * @run main/othervm -Xbatch -XX:CICompilerCount=4 -XX:+UseDynamicNumberOfCompilerThreads
+ *                   -XX:+UnlockDiagnosticVMOptions -XX:+ReduceNumberOfCompilerThreads
+ *                   -XX:+TraceCompilerThreads TestDynamicCompilerThreads
+ * @run main/othervm -XX:CICompilerCount=4 -XX:+UseDynamicNumberOfCompilerThreads
+ *                   -XX:+UnlockDiagnosticVMOptions -XX:+ReduceNumberOfCompilerThreads
+ *                   TestDynamicCompilerThreads
+ */
+
+import java.lang.reflect.Method;
+
+public class TestDynamicCompilerThreads {
+    static int work(int x) {
+        int r = 0;
+        for (int i = 0; i < x; i++) {
+            r += i * x ^ (r >>> 3);
+        }
+        return r;
+    }
+
+    public static void main(String[] args) throws Exception {
+        Method m = TestDynamicCompilerThreads.class.getDeclaredMethod("work", int.class);
+        // Alternate bursts of compile work with idle periods, so that
+        // threads are added and removed several times.
+        for (int round = 0; round < 3; round++) {
+            ClassLoader[] loaders = new ClassLoader[50];
+            for (int i = 0; i < loaders.length; i++) {
+                loaders[i] = new java.net.URLClassLoader(
+                    ((java.net.URLClassLoader) TestDynamicCompilerThreads.class.getClassLoader()).getURLs(), null);
+                Class<?> c = loaders[i].loadClass("TestDynamicCompilerThreads");
+                Method w = c.getDeclaredMethod("work", int.class);
+                for (int j = 0; j < 20000; j++) {
+                    w.invoke(null, 10);
+                }
+            }
+            for (int j = 0; j < 20000; j++) {
+                m.invoke(null, 10);
+            }
+            Thread.sleep(1000);
+        }
+    }
+}
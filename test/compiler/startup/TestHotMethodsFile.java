@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test
+ * @summary Record compiled methods at exit and schedule them in the next run
+ * @library /testlibrary
+ * @run main TestHotMethodsFile
+ */
+
+import com.oracle.java.testlibrary.*;
+import java.io.File;
+import java.nio.file.Files;
+import java.util.List;
+
+public class TestHotMethodsFile {
+    public static class Workload {
+        static int work(int x) {
+            int r = 0;
+            for (int i = 0; i < x; i++) {
+                r += i * x ^ (r >>> 3);
+            }
+            return r;
+        }
+
+        public static void main(String[] args) {
+            int r = 0;
+            for (int i = 0; i < 100000; i++) {
+                r += work(10);
+            }
+            System.out.println(r);
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        File file = new File("hot_methods.txt");
+        file.delete();
+
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+            "-XX:HotMethodsFile=" + file.getPath(), "-XX:+DumpHotMethodsAtExit",
+            Workload.class.getName());
+        new OutputAnalyzer(pb.start()).shouldHaveExitValue(0);
+
+        List<String> lines = Files.readAllLines(file.toPath());
+        boolean found = false;
+        for (String line : lines) {
+            if (line.contains("TestHotMethodsFile$Workload work (I)I")) {
+                found = true;
+            }
+        }
+        if (!found) {
+            throw new RuntimeException("Workload.work not recorded in " + lines);
+        }
+
+        pb = ProcessTools.createJavaProcessBuilder(
+            "-XX:HotMethodsFile=" + file.getPath(), "-XX:+PrintCompilation",
+            Workload.class.getName());
+        OutputAnalyzer out = new OutputAnalyzer(pb.start());
+        out.shouldHaveExitValue(0);
+        out.shouldContain("hot methods from " + file.getPath());
+    }
+}
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test
+ * @summary string concatenation fusion must handle StringBuilder.append(boolean)
+ * @run main/othervm -XX:-BackgroundCompilation -XX:-UseOnStackReplacement TestConcatBoolean
+ */
+public class TestConcatBoolean {
+
+    static String concat(String s, boolean b, int i) {
+        return s + b + i + 'c' + !b;
+    }
+
+    static String buffer(boolean b) {
+        return new StringBuffer().append(b).append(b).toString();
+    }
+
+    public static void main(String[] args) {
+        for (int i = 0; i < 20000; i++) {
+            boolean b = (i & 1) == 0;
+            String expected = "x" + String.valueOf(b) + i + "c" + String.valueOf(!b);
+            String actual = concat("x", b, i);
+            if (!actual.equals(expected)) {
+                throw new RuntimeException("expected " + expected + " but got " + actual);
+            }
+            String twice = b ? "truetrue" : "falsefalse";
+            if (!buffer(b).equals(twice)) {
+                throw new RuntimeException("expected " + twice + " but got " + buffer(b));
+            }
+        }
+        System.out.println("TEST PASSED");
+    }
+}
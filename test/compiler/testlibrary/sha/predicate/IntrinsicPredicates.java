@@ -59,12 +59,18 @@ public class IntrinsicPredicates {
     };
 
     public static final BooleanSupplier SHA1_INSTRUCTION_AVAILABLE
-            = new CPUSpecificPredicate("sparc.*", new String[] { "sha1" },
-                    null);
+            = new OrPredicate(
+                    new CPUSpecificPredicate("sparc.*", new String[] { "sha1" },
+                            null),
+                    new CPUSpecificPredicate("amd64.*|x86_64.*",
+                            new String[] { "sha" }, null));
 
     public static final BooleanSupplier SHA256_INSTRUCTION_AVAILABLE
-            = new CPUSpecificPredicate("sparc.*", new String[] { "sha256" },
-                    null);
+            = new OrPredicate(
+                    new CPUSpecificPredicate("sparc.*", new String[] { "sha256" },
+                            null),
+                    new CPUSpecificPredicate("amd64.*|x86_64.*",
+                            new String[] { "sha" }, null));
 
     public static final BooleanSupplier SHA512_INSTRUCTION_AVAILABLE
             = new CPUSpecificPredicate("sparc.*", new String[] { "sha512" },
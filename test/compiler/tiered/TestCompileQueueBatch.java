@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test
+ * @summary Selection of several compile tasks per scan of a long tiered compile queue
+ * @run main/othervm -XX:+TieredCompilation -XX:CICompilerCount=2 -XX:TieredCompileQueueBatch=64
+ *                   TestCompileQueueBatch
+ * @run main/othervm -XX:+TieredCompilation -XX:CICompilerCount=2 -XX:TieredCompileQueueBatch=2
+ *                   -XX:TieredCompileTaskTimeout=1 TestCompileQueueBatch
+ * @run main/othervm -XX:+TieredCompilation -XX:TieredCompileQueueBatch=0 TestCompileQueueBatch
+ */
+
+import java.lang.reflect.Method;
+import java.net.URLClassLoader;
+
+public class TestCompileQueueBatch {
+    static int work(int x) {
+        int r = 0;
+        for (int i = 0; i < x; i++) {
+            r += i * x ^ (r >>> 3);
+        }
+        return r;
+    }
+
+    public static void main(String[] args) throws Exception {
+        URLClassLoader parent = (URLClassLoader) TestCompileQueueBatch.class.getClassLoader();
+        int expected = work(10);
+        // Every copy of the class queues its own compile tasks, so the
+        // queues grow long enough for batched selection.
+        for (int i = 0; i < 200; i++) {
+            ClassLoader loader = new URLClassLoader(parent.getURLs(), null);
+            Method w = loader.loadClass("TestCompileQueueBatch").getDeclaredMethod("work", int.class);
+            for (int j = 0; j < 5000; j++) {
+                int r = (Integer) w.invoke(null, 10);
+                if (r != expected) {
+                    throw new RuntimeException("wrong result " + r + ", expected " + expected);
+                }
+            }
+        }
+    }
+}
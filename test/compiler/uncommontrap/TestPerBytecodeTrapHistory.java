@@ -0,0 +1,66 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test
+ * @summary Trap decisions with PerBytecodeTrapHistory keep working when one
+ *          site of a method keeps trapping
+ * @run main/othervm -Xbatch -XX:+PerBytecodeTrapHistory -XX:PerMethodTrapLimit=2
+ *                   -XX:CompileCommand=dontinline,TestPerBytecodeTrapHistory::test
+ *                   TestPerBytecodeTrapHistory
+ */
+
+public class TestPerBytecodeTrapHistory {
+    static class A {
+        int f;
+    }
+
+    static int test(A hot, A cold, int[] a, int i) {
+        int r = 0;
+        if (hot != null) {
+            r += hot.f;
+        }
+        r += cold.f;
+        for (int j = 0; j < a.length; j++) {
+            r += a[j];
+        }
+        return r + (i > 0 ? 1 : 0);
+    }
+
+    public static void main(String[] args) {
+        A a = new A();
+        a.f = 1;
+        int[] arr = { 1, 2, 3 };
+        for (int i = 0; i < 100_000; i++) {
+            // Make the first site flip between taken and not taken so it
+            // keeps deoptimizing, while the other sites never trap.
+            A hot = (i % 3 == 0) ? null : a;
+            int expected = (hot != null ? 1 : 0) + 1 + 6 + (i > 0 ? 1 : 0);
+            int r = test(hot, a, arr, i);
+            if (r != expected) {
+                throw new RuntimeException("i = " + i + ": expected " + expected + ", got " + r);
+            }
+        }
+    }
+}
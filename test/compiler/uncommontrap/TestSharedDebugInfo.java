@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test
+ * @summary Deoptimization must restore the right values when safepoint debug info is shared
+ * @run main/othervm -Xbatch -XX:-TieredCompilation -XX:CompileCommand=compileonly,TestSharedDebugInfo::test TestSharedDebugInfo
+ * @run main/othervm -Xbatch -XX:-TieredCompilation -XX:+UnlockDiagnosticVMOptions -XX:-ShareScopeDebugInfo -XX:CompileCommand=compileonly,TestSharedDebugInfo::test TestSharedDebugInfo
+ */
+public class TestSharedDebugInfo {
+  static class Point {
+    int x, y;
+    Point(int x, int y) { this.x = x; this.y = y; }
+  }
+
+  static volatile boolean trap;
+
+  static int test(int a, int b) {
+    Point p = new Point(a, b);    // scalar replaced, described in the object pool
+    int s = a + b;
+    if (trap) { s += p.x * 3; }   // several traps with equal locals
+    if (trap) { s += p.y * 5; }
+    if (trap) { s += p.x * 7; }
+    return s + p.x - p.y;
+  }
+
+  public static void main(String[] args) {
+    for (int i = 0; i < 20000; i++) {
+      if (test(i, 2 * i) != 2 * i) {
+        throw new RuntimeException("wrong result during warmup");
+      }
+    }
+    trap = true;
+    for (int i = 0; i < 100; i++) {
+      int expected = i + 2 * i + i * 3 + 2 * i * 5 + i * 7 + i - 2 * i;
+      int r = test(i, 2 * i);
+      if (r != expected) {
+        throw new RuntimeException("wrong result after deoptimization: " + r + " != " + expected);
+      }
+    }
+  }
+}
@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test
+ * @summary C2 intrinsic for Unsafe.setMemory on heap and off-heap memory
+ * @library /testlibrary
+ * @run main/othervm -Xbatch -XX:-TieredCompilation UnsafeSetMemory
+ */
+
+import com.oracle.java.testlibrary.Utils;
+import sun.misc.Unsafe;
+
+public class UnsafeSetMemory {
+    static final Unsafe UNSAFE = Utils.getUnsafe();
+    static final long BASE = Unsafe.ARRAY_BYTE_BASE_OFFSET;
+
+    static void fillHeap(byte[] a, int from, int len, byte v) {
+        UNSAFE.setMemory(a, BASE + from, len, v);
+    }
+
+    static void fillRaw(long addr, long len, byte v) {
+        UNSAFE.setMemory(null, addr, len, v);
+    }
+
+    static void check(boolean ok, String msg) {
+        if (!ok) {
+            throw new RuntimeException(msg);
+        }
+    }
+
+    public static void main(String[] args) {
+        byte[] a = new byte[256];
+        long raw = UNSAFE.allocateMemory(256);
+        try {
+            for (int iter = 0; iter < 20000; iter++) {
+                int from = iter % 17;
+                int len = iter % 200;
+                byte v = (byte)iter;
+                java.util.Arrays.fill(a, (byte)0);
+                fillHeap(a, from, len, v);
+                for (int i = 0; i < a.length; i++) {
+                    byte expected = (i >= from && i < from + len) ? v : 0;
+                    check(a[i] == expected, "heap byte " + i + " at iteration " + iter);
+                }
+
+                UNSAFE.setMemory(raw, 256, (byte)0);
+                fillRaw(raw + from, len, v);
+                for (int i = 0; i < 256; i++) {
+                    byte expected = (i >= from && i < from + len) ? v : 0;
+                    check(UNSAFE.getByte(raw + i) == expected, "raw byte " + i + " at iteration " + iter);
+                }
+            }
+            // A negative length must still throw once the caller is compiled.
+            try {
+                fillRaw(raw, -1, (byte)1);
+                throw new RuntimeException("no IllegalArgumentException for negative size");
+            } catch (IllegalArgumentException e) {
+                // expected
+            }
+        } finally {
+            UNSAFE.freeMemory(raw);
+        }
+    }
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/* @test TestAllocateHeapAt.java
+ * @key gc
+ * @summary Run each collector with the Java heap backed by a file created through -XX:AllocateHeapAt
+ * @library /testlibrary
+ * @run main/othervm TestAllocateHeapAt
+ */
+
+import java.io.File;
+import java.util.ArrayList;
+
+import com.oracle.java.testlibrary.OutputAnalyzer;
+import com.oracle.java.testlibrary.ProcessTools;
+
+public class TestAllocateHeapAt {
+  public static class AllocateGarbage {
+    public static void main(String args[]) {
+      ArrayList<byte[]> live = new ArrayList<byte[]>();
+      for (int i = 0; i < 2000; i++) {
+        live.add(new byte[64 * 1024]);
+        if (live.size() > 200) {
+          live.remove(0);
+        }
+      }
+      System.gc();
+    }
+  }
+
+  private static void test(String gc, String dir) throws Exception {
+    ProcessBuilder pb =
+      ProcessTools.createJavaProcessBuilder(gc,
+                                            "-Xmx64m",
+                                            "-XX:AllocateHeapAt=" + dir,
+                                            AllocateGarbage.class.getName());
+    OutputAnalyzer output = new OutputAnalyzer(pb.start());
+    System.out.println("Output:\n" + output.getOutput());
+    output.shouldHaveExitValue(0);
+  }
+
+  public static void main(String args[]) throws Exception {
+    String dir = System.getProperty("user.dir");
+    test("-XX:+UseSerialGC", dir);
+    test("-XX:+UseParallelGC", dir);
+    test("-XX:+UseConcMarkSweepGC", dir);
+    test("-XX:+UseG1GC", dir);
+
+    // The heap file is unlinked right away, so nothing is left behind.
+    for (String name : new File(dir).list()) {
+      if (name.startsWith("jvmheap.")) {
+        throw new RuntimeException("Heap file " + name + " was not removed");
+      }
+    }
+
+    // A directory that does not exist must fail VM startup cleanly.
+    ProcessBuilder pb =
+      ProcessTools.createJavaProcessBuilder("-XX:AllocateHeapAt=" + dir + "/does-not-exist",
+                                            "-version");
+    OutputAnalyzer output = new OutputAnalyzer(pb.start());
+    output.shouldContain("Could not create file for heap");
+    if (output.getExitValue() == 0) {
+      throw new RuntimeException("VM started without a heap file");
+    }
+  }
+}
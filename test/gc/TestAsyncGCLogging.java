@@ -0,0 +1,86 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test TestAsyncGCLogging.java
+ * @summary GC log output written by the AsyncGCLogging thread reaches the file, also across rotations
+ * @library /testlibrary
+ * @run main/othervm TestAsyncGCLogging
+ */
+import com.oracle.java.testlibrary.*;
+import java.io.File;
+import java.io.FilenameFilter;
+import java.nio.file.Files;
+import java.nio.file.Paths;
+
+public class TestAsyncGCLogging {
+
+    static final int NUM_GCS = 200;
+
+    public static class GCLoop {
+        public static void main(String[] args) {
+            for (int i = 0; i < NUM_GCS; i++) {
+                System.gc();
+            }
+        }
+    }
+
+    static File[] logsNamed(final String prefix) {
+        return new File(".").listFiles(new FilenameFilter() {
+            @Override
+            public boolean accept(File dir, String name) {
+                return name.startsWith(prefix);
+            }
+        });
+    }
+
+    public static void main(String[] args) throws Exception {
+        // Every line printed during the run is in the file after exit
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+                "-Xloggc:async.log", "-XX:+AsyncGCLogging", "-XX:+PrintGC",
+                GCLoop.class.getName());
+        new OutputAnalyzer(pb.start()).shouldHaveExitValue(0);
+
+        String log = new String(Files.readAllBytes(Paths.get("async.log")));
+        int count = 0;
+        for (int i = log.indexOf("Full GC"); i >= 0; i = log.indexOf("Full GC", i + 1)) {
+            count++;
+        }
+        if (count != NUM_GCS) {
+            throw new RuntimeException("Expected " + NUM_GCS + " GCs in the log, found " + count);
+        }
+
+        // The writer thread rotates the files once they grow past GCLogFileSize
+        pb = ProcessTools.createJavaProcessBuilder(
+                "-Xloggc:async-rotate.log", "-XX:+AsyncGCLogging", "-XX:+PrintGCDetails",
+                "-XX:+UseGCLogFileRotation", "-XX:NumberOfGCLogFiles=3",
+                "-XX:GCLogFileSize=8K", GCLoop.class.getName());
+        new OutputAnalyzer(pb.start()).shouldHaveExitValue(0);
+
+        File[] logs = logsNamed("async-rotate.log");
+        if (logs.length != 3) {
+            throw new RuntimeException("There are " + logs.length + " logs instead of 3");
+        }
+    }
+}
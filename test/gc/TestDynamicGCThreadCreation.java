@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test TestDynamicGCThreadCreation
+ * @key gc
+ * @summary Work gang threads created on demand as the number of active
+ *          GC workers changes run collections correctly
+ * @run main/othervm -XX:+UseG1GC -XX:ParallelGCThreads=8 -XX:ConcGCThreads=4
+ *                   -XX:+UseDynamicNumberOfGCThreads -XX:+UnlockDiagnosticVMOptions
+ *                   -XX:+ForceDynamicNumberOfGCThreads -Xmx128m TestDynamicGCThreadCreation
+ * @run main/othervm -XX:+UseConcMarkSweepGC -XX:ParallelGCThreads=8 -XX:ConcGCThreads=4
+ *                   -XX:+UseDynamicNumberOfGCThreads -XX:+UnlockDiagnosticVMOptions
+ *                   -XX:+ForceDynamicNumberOfGCThreads -Xmx128m TestDynamicGCThreadCreation
+ */
+
+import java.util.ArrayList;
+import java.util.List;
+
+public class TestDynamicGCThreadCreation {
+    static final int THREADS = 4;
+
+    public static void main(String[] args) throws Exception {
+        Thread[] threads = new Thread[THREADS];
+        for (int t = 0; t < THREADS; t++) {
+            threads[t] = new Thread() {
+                public void run() {
+                    List<int[]> live = new ArrayList<>();
+                    for (int i = 0; i < 200_000; i++) {
+                        live.add(new int[16]);
+                        if (live.size() > 10_000) {
+                            live.subList(0, 5_000).clear();
+                        }
+                    }
+                    for (int[] a : live) {
+                        if (a.length != 16) {
+                            throw new RuntimeException("corrupted array");
+                        }
+                    }
+                }
+            };
+            threads[t].start();
+        }
+        for (int i = 0; i < 10; i++) {
+            System.gc();
+        }
+        for (Thread t : threads) {
+            t.join();
+        }
+    }
+}
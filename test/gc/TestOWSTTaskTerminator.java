@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test TestOWSTTaskTerminator
+ * @key gc
+ * @summary Run parallel collections with the spin master termination protocol
+ * @run main/othervm -XX:+UseOWSTTaskTerminator -XX:+UseParallelGC -XX:ParallelGCThreads=8 -Xmx128m TestOWSTTaskTerminator
+ * @run main/othervm -XX:+UseOWSTTaskTerminator -XX:+UseG1GC -XX:ParallelGCThreads=8 -XX:ConcGCThreads=4 -Xmx128m TestOWSTTaskTerminator
+ * @run main/othervm -XX:+UseOWSTTaskTerminator -XX:+UseConcMarkSweepGC -XX:ParallelGCThreads=8 -XX:ConcGCThreads=4 -Xmx128m TestOWSTTaskTerminator
+ * @run main/othervm -XX:+UseOWSTTaskTerminator -XX:+UseParallelGC -XX:ParallelGCThreads=1 -Xmx128m TestOWSTTaskTerminator
+ */
+
+import java.util.ArrayList;
+import java.util.List;
+
+public class TestOWSTTaskTerminator {
+    static class Node {
+        Node left, right;
+    }
+
+    static Node tree(int depth) {
+        Node n = new Node();
+        if (depth > 0) {
+            n.left = tree(depth - 1);
+            n.right = tree(depth - 1);
+        }
+        return n;
+    }
+
+    public static void main(String[] args) {
+        List<Node> live = new ArrayList<>();
+        for (int i = 0; i < 40; i++) {
+            live.add(tree(14));
+            if (live.size() > 8) {
+                live.remove(0);
+            }
+            if (i % 10 == 0) {
+                System.gc();
+            }
+        }
+        System.out.println("Live trees: " + live.size());
+    }
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test TestParallelDeepStackRoots
+ * @key gc
+ * @summary Deep thread stacks are scanned first by parallel root processing
+ *          and all their roots are still found
+ * @run main/othervm -XX:+UseParallelGC -XX:ParallelGCThreads=4 -XX:ParGCDeepStackThreshold=4096 TestParallelDeepStackRoots
+ * @run main/othervm -XX:+UseG1GC -XX:ParallelGCThreads=4 -XX:ParGCDeepStackThreshold=4096 TestParallelDeepStackRoots
+ * @run main/othervm -XX:+UseConcMarkSweepGC -XX:ParallelGCThreads=4 -XX:ParGCDeepStackThreshold=4096 TestParallelDeepStackRoots
+ */
+
+import java.util.concurrent.CountDownLatch;
+
+public class TestParallelDeepStackRoots {
+    static final int THREADS = 8;
+    static final int DEPTH = 2000;
+
+    static final CountDownLatch ready = new CountDownLatch(THREADS);
+    static final CountDownLatch done = new CountDownLatch(1);
+
+    static int recurse(int depth, Integer[] box) throws InterruptedException {
+        // Keep an object that is only reachable from this frame.
+        Integer local = new Integer(depth);
+        int r;
+        if (depth == 0) {
+            ready.countDown();
+            done.await();
+            r = 0;
+        } else {
+            r = recurse(depth - 1, box);
+        }
+        if (local.intValue() != depth) {
+            throw new RuntimeException("corrupted local at depth " + depth);
+        }
+        return r + 1;
+    }
+
+    public static void main(String[] args) throws Exception {
+        Thread[] threads = new Thread[THREADS];
+        final Throwable[] failure = new Throwable[1];
+        for (int i = 0; i < THREADS; i++) {
+            // Mix deep and shallow stacks.
+            final int depth = (i % 2 == 0) ? DEPTH : 10;
+            threads[i] = new Thread(new Runnable() {
+                public void run() {
+                    try {
+                        if (recurse(depth, new Integer[1]) != depth + 1) {
+                            throw new RuntimeException("wrong depth");
+                        }
+                    } catch (Throwable t) {
+                        failure[0] = t;
+                    }
+                }
+            });
+            threads[i].start();
+        }
+        ready.await();
+        for (int i = 0; i < 10; i++) {
+            System.gc();
+            byte[][] garbage = new byte[1000][];
+            for (int j = 0; j < garbage.length; j++) {
+                garbage[j] = new byte[1024];
+            }
+        }
+        done.countDown();
+        for (Thread t : threads) {
+            t.join();
+        }
+        if (failure[0] != null) {
+            throw new RuntimeException(failure[0]);
+        }
+    }
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+/*
+ * @test TestParallelJNIWeakHandles
+ * @key gc
+ * @summary Process weak JNI handles with the parallel reference processing workers
+ * @library /testlibrary
+ * @run main/othervm TestParallelJNIWeakHandles
+ */
+
+import com.oracle.java.testlibrary.*;
+
+public class TestParallelJNIWeakHandles {
+    public static void main(String[] args) throws Exception {
+        String[] gcs = { "-XX:+UseParallelGC", "-XX:+UseG1GC", "-XX:+UseConcMarkSweepGC" };
+        for (String gc : gcs) {
+            ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+                gc,
+                "-XX:ParallelGCThreads=4",
+                "-XX:+ParallelRefProcEnabled",
+                "-XX:+PrintGCDetails",
+                "-XX:+PrintReferenceGC",
+                "-XX:+UnlockDiagnosticVMOptions",
+                "-XX:+VerifyAfterGC",
+                "-Xmx64m",
+                "-Xmn8m",
+                TestParallelJNIWeakHandles.Allocate.class.getName());
+            OutputAnalyzer output = new OutputAnalyzer(pb.start());
+            output.shouldContain("[JNI Weak Reference");
+            output.shouldHaveExitValue(0);
+        }
+    }
+
+    static class Allocate {
+        public static Object sink;
+
+        public static void main(String[] args) throws Exception {
+            // Enough garbage for a number of young collections.
+            for (int i = 0; i < 200000; i++) {
+                sink = new byte[1024];
+            }
+        }
+    }
+}
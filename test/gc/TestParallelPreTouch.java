@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/* @test TestParallelPreTouch.java
+ * @key gc
+ * @summary Run each collector with -XX:+AlwaysPreTouch and a small PreTouchParallelChunkSize so the heap is pre-touched in parallel
+ * @library /testlibrary
+ * @run main/othervm TestParallelPreTouch
+ */
+
+import com.oracle.java.testlibrary.OutputAnalyzer;
+import com.oracle.java.testlibrary.ProcessTools;
+
+public class TestParallelPreTouch {
+  private static void test(String gc) throws Exception {
+    ProcessBuilder pb =
+      ProcessTools.createJavaProcessBuilder(gc,
+                                            "-Xms128m",
+                                            "-Xmx128m",
+                                            "-XX:ParallelGCThreads=4",
+                                            "-XX:+AlwaysPreTouch",
+                                            "-XX:PreTouchParallelChunkSize=1m",
+                                            "-version");
+    OutputAnalyzer output = new OutputAnalyzer(pb.start());
+    System.out.println("Output:\n" + output.getOutput());
+    output.shouldHaveExitValue(0);
+  }
+
+  public static void main(String args[]) throws Exception {
+    test("-XX:+UseSerialGC");
+    test("-XX:+UseParallelGC");
+    test("-XX:+UseConcMarkSweepGC");
+    test("-XX:+UseG1GC");
+  }
+}
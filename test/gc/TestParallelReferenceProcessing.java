@@ -0,0 +1,98 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test TestParallelReferenceProcessing
+ * @key gc
+ * @summary Check that parallel reference processing is enabled ergonomically and survives few and many references
+ * @library /testlibrary
+ * @run main/othervm TestParallelReferenceProcessing
+ */
+
+import java.lang.ref.*;
+import java.util.ArrayList;
+import java.util.List;
+import com.oracle.java.testlibrary.*;
+
+public class TestParallelReferenceProcessing {
+    public static void main(String[] args) throws Exception {
+        String[] gcs = { "-XX:+UseParallelGC", "-XX:+UseG1GC", "-XX:+UseConcMarkSweepGC" };
+        for (String gc : gcs) {
+            ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+                gc, "-XX:ParallelGCThreads=4", "-XX:+PrintFlagsFinal", "-version");
+            OutputAnalyzer output = new OutputAnalyzer(pb.start());
+            output.shouldMatch("ParallelRefProcEnabled\\s+:= true");
+            output.shouldHaveExitValue(0);
+
+            pb = ProcessTools.createJavaProcessBuilder(
+                gc, "-XX:ParallelGCThreads=1", "-XX:+PrintFlagsFinal", "-version");
+            output = new OutputAnalyzer(pb.start());
+            output.shouldMatch("ParallelRefProcEnabled\\s+= false");
+            output.shouldHaveExitValue(0);
+
+            for (String perThread : new String[] { "0", "1", "1000" }) {
+                pb = ProcessTools.createJavaProcessBuilder(
+                    gc,
+                    "-XX:ParallelGCThreads=4",
+                    "-XX:ReferencesPerThread=" + perThread,
+                    "-XX:+PrintGCDetails",
+                    "-XX:+PrintReferenceGC",
+                    "-XX:+UnlockDiagnosticVMOptions",
+                    "-XX:+VerifyAfterGC",
+                    "-Xmx64m",
+                    TestParallelReferenceProcessing.Refs.class.getName());
+                output = new OutputAnalyzer(pb.start());
+                output.shouldContain("[WeakReference");
+                output.shouldHaveExitValue(0);
+            }
+        }
+    }
+
+    static class Refs {
+        public static void main(String[] args) throws Exception {
+            ReferenceQueue<Object> queue = new ReferenceQueue<Object>();
+            List<Object> strong = new ArrayList<Object>();
+            List<Reference<Object>> refs = new ArrayList<Reference<Object>>();
+            for (int round = 0; round < 4; round++) {
+                // Alternate between a handful and many weak references,
+                // half of them with live referents.
+                int n = (round % 2 == 0) ? 5 : 50000;
+                for (int i = 0; i < n; i++) {
+                    Object o = new Object();
+                    if (i % 2 == 0) {
+                        strong.add(o);
+                    }
+                    refs.add(new WeakReference<Object>(o, queue));
+                }
+                System.gc();
+                for (int i = 0; i < refs.size(); i += 2) {
+                    if (refs.get(i).get() == null) {
+                        throw new RuntimeException("Live referent was cleared");
+                    }
+                }
+                refs.clear();
+                strong.clear();
+            }
+        }
+    }
+}
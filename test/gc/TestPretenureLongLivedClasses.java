@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test TestPretenureLongLivedClasses
+ * @key gc
+ * @summary Instances of a class whose objects keep surviving young
+ *          collections are promoted at their first survival
+ * @library /testlibrary /testlibrary/whitebox
+ * @build TestPretenureLongLivedClasses ClassFileInstaller sun.hotspot.WhiteBox
+ * @run main ClassFileInstaller sun.hotspot.WhiteBox
+ *                              sun.hotspot.WhiteBox$WhiteBoxPermission
+ * @run main/othervm -Xbootclasspath/a:. -XX:+UnlockDiagnosticVMOptions -XX:+WhiteBoxAPI
+ *                   -XX:+UseSerialGC -Xmn64m -XX:MaxTenuringThreshold=15
+ *                   -XX:+PretenureLongLivedClasses -XX:PretenureSampleWords=1024
+ *                   TestPretenureLongLivedClasses true
+ * @run main/othervm -Xbootclasspath/a:. -XX:+UnlockDiagnosticVMOptions -XX:+WhiteBoxAPI
+ *                   -XX:+UseParNewGC -Xmn64m -XX:MaxTenuringThreshold=15
+ *                   -XX:+PretenureLongLivedClasses -XX:PretenureSampleWords=1024
+ *                   TestPretenureLongLivedClasses true
+ * @run main/othervm -Xbootclasspath/a:. -XX:+UnlockDiagnosticVMOptions -XX:+WhiteBoxAPI
+ *                   -XX:+UseSerialGC -Xmn64m -XX:MaxTenuringThreshold=15
+ *                   -XX:-PretenureLongLivedClasses
+ *                   TestPretenureLongLivedClasses false
+ */
+
+import java.util.ArrayList;
+import sun.hotspot.WhiteBox;
+
+public class TestPretenureLongLivedClasses {
+    private static final WhiteBox WB = WhiteBox.getWhiteBox();
+
+    static class CacheEntry {
+        long a, b, c, d;
+    }
+
+    static final ArrayList<CacheEntry> cache = new ArrayList<>();
+
+    public static void main(String[] args) {
+        boolean expectPretenured = Boolean.parseBoolean(args[0]);
+
+        // Every batch survives all following young collections.
+        for (int round = 0; round < 10; round++) {
+            for (int i = 0; i < 2000; i++) {
+                cache.add(new CacheEntry());
+            }
+            WB.youngGC();
+        }
+
+        CacheEntry fresh = new CacheEntry();
+        WB.youngGC();
+        boolean inOld = WB.isObjectInOldGen(fresh);
+        if (inOld != expectPretenured) {
+            throw new RuntimeException("CacheEntry promoted at its first survival: " + inOld +
+                                       ", expected: " + expectPretenured);
+        }
+
+        // A full collection clears the decision, so the class is profiled again.
+        WB.fullGC();
+        fresh = new CacheEntry();
+        WB.youngGC();
+        if (WB.isObjectInOldGen(fresh)) {
+            throw new RuntimeException("Pretenuring decision should be cleared by a full GC");
+        }
+    }
+}
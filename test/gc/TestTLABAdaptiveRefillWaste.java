@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+/*
+ * @test TestTLABAdaptiveRefillWaste
+ * @key gc
+ * @summary Run busy and idle allocating threads with per-thread TLAB refill waste learning
+ * @library /testlibrary
+ * @run main/othervm TestTLABAdaptiveRefillWaste
+ */
+
+import com.oracle.java.testlibrary.*;
+
+public class TestTLABAdaptiveRefillWaste {
+    public static void main(String[] args) throws Exception {
+        String[] modes = { "-Xmixed", "-Xint" };
+        for (String mode : modes) {
+            ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+                mode,
+                "-XX:+UseTLAB",
+                "-XX:+ResizeTLAB",
+                "-XX:+TLABAdaptiveRefillWaste",
+                "-XX:+PrintTLAB",
+                "-XX:+UnlockDiagnosticVMOptions",
+                "-XX:+VerifyAfterGC",
+                "-Xmx64m",
+                "-Xmn8m",
+                TestTLABAdaptiveRefillWaste.Allocate.class.getName());
+            OutputAnalyzer output = new OutputAnalyzer(pb.start());
+            output.shouldContain("TLAB totals");
+            output.shouldHaveExitValue(0);
+        }
+    }
+
+    static class Allocate {
+        public static volatile Object sink;
+
+        public static void main(String[] args) throws Exception {
+            // An idle thread holding on to a TLAB next to a busy one
+            // allocating objects of mixed sizes.
+            Thread idle = new Thread() {
+                public void run() {
+                    for (int i = 0; i < 20; i++) {
+                        sink = new byte[64];
+                        try {
+                            Thread.sleep(10);
+                        } catch (InterruptedException e) {
+                            return;
+                        }
+                    }
+                }
+            };
+            idle.start();
+            for (int i = 0; i < 100000; i++) {
+                sink = new byte[(i % 7 == 0) ? 4096 : 32];
+            }
+            idle.join();
+        }
+    }
+}
@@ -29,7 +29,9 @@
  * @run main/othervm -Xmx64m TestG1HeapRegionSize 1048576
  * @run main/othervm -XX:G1HeapRegionSize=2m -Xmx64m TestG1HeapRegionSize 2097152
  * @run main/othervm -XX:G1HeapRegionSize=3m -Xmx64m TestG1HeapRegionSize 2097152
- * @run main/othervm -XX:G1HeapRegionSize=64m -Xmx256m TestG1HeapRegionSize 33554432
+ * @run main/othervm -XX:G1HeapRegionSize=64m -Xmx256m TestG1HeapRegionSize 67108864
+ * @run main/othervm -XX:G1HeapRegionSize=512m -Xmx1g TestG1HeapRegionSize 536870912
+ * @run main/othervm -XX:G1HeapRegionSize=1g -Xmx2g TestG1HeapRegionSize 536870912
  */
 
 import sun.management.ManagementFactoryHelper;
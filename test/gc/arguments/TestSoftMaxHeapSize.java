@@ -0,0 +1,94 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test TestSoftMaxHeapSize
+ * @summary Verify that lowering SoftMaxHeapSize at runtime shrinks the heap
+ * @key gc
+ * @library /testlibrary /testlibrary/whitebox
+ * @build TestSoftMaxHeapSize
+ * @run main ClassFileInstaller sun.hotspot.WhiteBox
+ *                              sun.hotspot.WhiteBox$WhiteBoxPermission
+ * @run main/othervm -Xbootclasspath/a:. -XX:+UseG1GC -Xms8m -Xmx256m -XX:G1HeapRegionSize=1m
+ *      -XX:+UnlockDiagnosticVMOptions -XX:+WhiteBoxAPI -XX:+PrintGC
+ *      TestSoftMaxHeapSize
+ * @run main/othervm -Xbootclasspath/a:. -XX:+UseParallelGC -Xms8m -Xmx256m
+ *      -XX:+UnlockDiagnosticVMOptions -XX:+WhiteBoxAPI -XX:+PrintGC
+ *      TestSoftMaxHeapSize
+ */
+
+import static com.oracle.java.testlibrary.Asserts.assertFalse;
+import static com.oracle.java.testlibrary.Asserts.assertTrue;
+
+import java.util.LinkedList;
+
+import com.oracle.java.testlibrary.DynamicVMOption;
+import sun.hotspot.WhiteBox;
+
+public class TestSoftMaxHeapSize {
+    private static final int MB = 1024 * 1024;
+    private static final long SOFT_MAX = 32 * MB;
+    // Survivors and region/space alignment may keep a little more committed.
+    private static final long SLACK = 8 * MB;
+
+    public static void main(String[] args) throws Exception {
+        WhiteBox wb = WhiteBox.getWhiteBox();
+        DynamicVMOption option = new DynamicVMOption("SoftMaxHeapSize");
+
+        assertTrue(option.isWriteable(), "Option " + option.name
+                + " is expected to be writable");
+        long maxHeapSize = Long.parseLong(DynamicVMOption.getString("MaxHeapSize"));
+        assertFalse(option.isValidValue(Long.toString(maxHeapSize + 1)),
+                "SoftMaxHeapSize larger than MaxHeapSize is expected to be illegal");
+
+        // Grow the heap well beyond the soft limit.
+        LinkedList<byte[]> holder = new LinkedList<byte[]>();
+        for (int i = 0; i < 96; i++) {
+            holder.add(new byte[MB]);
+        }
+        wb.fullGC();
+        long committedBefore = Runtime.getRuntime().totalMemory();
+        System.out.println("Committed after allocation: " + committedBefore);
+        assertTrue(committedBefore > SOFT_MAX + SLACK,
+                "Heap is expected to have grown beyond " + (SOFT_MAX + SLACK));
+
+        holder.clear();
+        option.setValue(Long.toString(SOFT_MAX));
+
+        // A full GC shrinks to the soft limit; young GCs must not grow
+        // the heap back, and G1 uncommits any remainder concurrently.
+        wb.fullGC();
+        long committedAfter = committedBefore;
+        for (int i = 0; i < 100 && committedAfter > SOFT_MAX + SLACK; i++) {
+            wb.youngGC();
+            Thread.sleep(100);
+            committedAfter = Runtime.getRuntime().totalMemory();
+        }
+        System.out.println("Committed after lowering SoftMaxHeapSize: " + committedAfter);
+
+        assertTrue(committedAfter <= SOFT_MAX + SLACK,
+                "Expected committed heap to shrink to about " + SOFT_MAX +
+                " but it is " + committedAfter);
+    }
+}
@@ -0,0 +1,127 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test
+ * @key gc
+ * @summary Classes are unloaded when the code cache, klass and string/symbol table cleaning runs in parallel
+ * @requires vm.gc == null
+ * @library  /testlibrary /testlibrary/whitebox
+ * @build sun.hotspot.WhiteBox
+ * @run main ClassFileInstaller sun.hotspot.WhiteBox
+ *                              sun.hotspot.WhiteBox$WhiteBoxPermission
+ *
+ * @run main/othervm -Xbootclasspath/a:. -XX:+UnlockDiagnosticVMOptions -XX:+WhiteBoxAPI
+ *                   -XX:+UseParallelGC -XX:+UseParallelOldGC -XX:ParallelGCThreads=4
+ *                   TestParallelClassUnloading
+ *
+ * @run main/othervm -Xbootclasspath/a:. -XX:+UnlockDiagnosticVMOptions -XX:+WhiteBoxAPI
+ *                   -XX:+UseConcMarkSweepGC -XX:+CMSClassUnloadingEnabled
+ *                   -XX:+ExplicitGCInvokesConcurrent -XX:ParallelGCThreads=4
+ *                   TestParallelClassUnloading
+ */
+
+import java.io.File;
+import java.io.IOException;
+import java.nio.file.Files;
+import java.nio.file.Path;
+import java.nio.file.Paths;
+
+import sun.hotspot.WhiteBox;
+
+import com.oracle.java.testlibrary.Asserts;
+
+public class TestParallelClassUnloading {
+    public static void main(String args[]) throws Exception {
+        final WhiteBox wb = WhiteBox.getWhiteBox();
+        // Fetch the dir where the test class and the class
+        // to be loaded resides.
+        String classDir = TestParallelClassUnloading.class.getProtectionDomain().getCodeSource().getLocation().getPath();
+        String className = "TestParallelClassUnloading$ParallelUnloadee";
+
+        Asserts.assertFalse(wb.isClassAlive(className), "Should not be loaded yet");
+
+        ParallelUnloadingLoader loader = new ParallelUnloadingLoader(classDir);
+        Class<?> c = loader.loadClass(className);
+
+        // Make sure there is compiled code and interned strings that
+        // need to be cleaned along with the class.
+        Object o = c.newInstance();
+        for (int i = 0; i < 20000; i++) {
+            o.hashCode();
+        }
+        o.toString().intern();
+
+        Asserts.assertTrue(wb.isClassAlive(className), "Class should be loaded");
+
+        // Clear the class-loader, class and object references to make
+        // class unloading possible.
+        loader = null;
+        c = null;
+        o = null;
+
+        System.gc();
+        Asserts.assertFalse(wb.isClassAlive(className), "Class should have been unloaded");
+    }
+
+    static class ParallelUnloadee {
+        private int count;
+
+        public int hashCode() {
+            return count++;
+        }
+
+        public String toString() {
+            return "ParallelUnloadee" + count;
+        }
+    }
+}
+
+class ParallelUnloadingLoader extends ClassLoader {
+    String path;
+
+    ParallelUnloadingLoader(String path) {
+        this.path = path;
+    }
+
+    public Class<?> loadClass(String name) throws ClassNotFoundException {
+        byte[] cls = null;
+        File f = new File(path, name + ".class");
+
+        // Delegate class loading if class not present in the given
+        // directory.
+        if (!f.exists()) {
+            return super.loadClass(name);
+        }
+
+        try {
+            Path path = Paths.get(f.getAbsolutePath());
+            cls = Files.readAllBytes(path);
+        } catch (IOException e) {
+            throw new ClassNotFoundException(name);
+        }
+
+        // Define class with no protection domain and resolve it.
+        return defineClass(name, cls, 0, cls.length, null);
+    }
+}
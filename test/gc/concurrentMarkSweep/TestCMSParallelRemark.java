@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test TestCMSParallelRemark
+ * @key gc
+ * @requires vm.gc=="ConcMarkSweep" | vm.gc=="null"
+ * @summary Check the CMS remark defaults to parallel reference processing and reports per-phase timings
+ * @library /testlibrary
+ * @run main/othervm TestCMSParallelRemark
+ */
+
+import com.oracle.java.testlibrary.*;
+
+public class TestCMSParallelRemark {
+    public static void main(String[] args) throws Exception {
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+            "-XX:+UseConcMarkSweepGC",
+            "-XX:ParallelGCThreads=4",
+            "-XX:+PrintFlagsFinal",
+            "-version");
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        output.shouldMatch("ParallelRefProcEnabled\\s+:= true");
+        output.shouldHaveExitValue(0);
+
+        pb = ProcessTools.createJavaProcessBuilder(
+            "-XX:+UseConcMarkSweepGC",
+            "-XX:ParallelGCThreads=4",
+            "-XX:-ParallelRefProcEnabled",
+            "-XX:+PrintFlagsFinal",
+            "-version");
+        output = new OutputAnalyzer(pb.start());
+        output.shouldMatch("ParallelRefProcEnabled\\s+:?= false");
+        output.shouldHaveExitValue(0);
+
+        // Explicit GCs run as concurrent cycles, whose remark prints the
+        // phase timings of the parallel remark task.
+        pb = ProcessTools.createJavaProcessBuilder(
+            "-XX:+UseConcMarkSweepGC",
+            "-XX:ParallelGCThreads=4",
+            "-XX:+ExplicitGCInvokesConcurrent",
+            "-XX:+CMSClassUnloadingEnabled",
+            "-XX:PrintCMSStatistics=1",
+            "-Xmx64m",
+            TestCMSParallelRemark.Collect.class.getName());
+        output = new OutputAnalyzer(pb.start());
+        output.shouldContain("[Dirty Klass Scan (ms):");
+        output.shouldHaveExitValue(0);
+    }
+
+    static class Collect {
+        public static void main(String[] args) throws Exception {
+            for (int i = 0; i < 5; i++) {
+                System.gc();
+                Thread.sleep(500);
+            }
+        }
+    }
+}
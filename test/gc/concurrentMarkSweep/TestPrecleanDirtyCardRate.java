@@ -0,0 +1,60 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test TestPrecleanDirtyCardRate
+ * @key gc
+ * @requires vm.gc=="ConcMarkSweep" | vm.gc=="null"
+ * @summary Run abortable preclean against a mutator dirtying old generation cards
+ * @run main/othervm -XX:+UseConcMarkSweepGC -XX:CMSScheduleRemarkEdenSizeThreshold=0
+ *                   -XX:CMSAbortablePrecleanDirtyRatio=1 -XX:CMSAbortablePrecleanMinWorkPerIteration=0
+ *                   -XX:+ExplicitGCInvokesConcurrent -XX:+PrintGCDetails
+ *                   -XX:+UnlockDiagnosticVMOptions -XX:+VerifyAfterGC
+ *                   -Xmn8m -Xmx64m TestPrecleanDirtyCardRate
+ * @run main/othervm -XX:+UseConcMarkSweepGC -XX:CMSScheduleRemarkEdenSizeThreshold=0
+ *                   -XX:CMSAbortablePrecleanDirtyRatio=0
+ *                   -XX:+ExplicitGCInvokesConcurrent
+ *                   -XX:+UnlockDiagnosticVMOptions -XX:+VerifyAfterGC
+ *                   -Xmn8m -Xmx64m TestPrecleanDirtyCardRate
+ */
+
+public class TestPrecleanDirtyCardRate {
+    public static void main(String[] args) throws Exception {
+        Object[] old = new Object[100000];
+        for (int i = 0; i < old.length; i++) {
+            old[i] = new Object[1];
+        }
+        System.gc();
+        for (int round = 0; round < 10; round++) {
+            // Keep storing young objects into old ones so that the
+            // concurrent phases always find freshly dirtied cards.
+            long deadline = System.currentTimeMillis() + 200;
+            int i = 0;
+            while (System.currentTimeMillis() < deadline) {
+                ((Object[])old[i])[0] = new byte[32];
+                i = (i + 127) % old.length;
+            }
+            System.gc();
+        }
+    }
+}
@@ -0,0 +1,56 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test TestPromoteLargeBuffer
+ * @key gc
+ * @requires vm.gc=="ConcMarkSweep" | vm.gc=="null"
+ * @summary Promote large objects into CMS through the per-worker large buffers and verify the old gen
+ * @run main/othervm -XX:+UseConcMarkSweepGC -XX:ParallelGCThreads=4 -XX:MaxTenuringThreshold=0
+ *                   -XX:+UnlockDiagnosticVMOptions -XX:+VerifyAfterGC
+ *                   -Xmn8m -Xmx128m TestPromoteLargeBuffer
+ * @run main/othervm -XX:+UseConcMarkSweepGC -XX:ParallelGCThreads=4 -XX:MaxTenuringThreshold=0
+ *                   -XX:CMSParPromoteLargeBufferSize=2k
+ *                   -XX:+UnlockDiagnosticVMOptions -XX:+VerifyAfterGC
+ *                   -Xmn8m -Xmx128m TestPromoteLargeBuffer
+ * @run main/othervm -XX:+UseConcMarkSweepGC -XX:ParallelGCThreads=4 -XX:MaxTenuringThreshold=0
+ *                   -XX:CMSParPromoteLargeBufferSize=0
+ *                   -XX:+UnlockDiagnosticVMOptions -XX:+VerifyAfterGC
+ *                   -Xmn8m -Xmx128m TestPromoteLargeBuffer
+ */
+
+public class TestPromoteLargeBuffer {
+    static Object sink;
+
+    public static void main(String[] args) {
+        Object[] live = new Object[2048];
+        for (int i = 0; i < 100000; i++) {
+            // Sizes on both sides of the indexed free list limit.
+            Object o = new long[200 + (i % 64) * 64];
+            if (i % 4 == 0) {
+                live[(i / 4) % live.length] = o;
+            }
+            sink = o;
+        }
+    }
+}
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test TestReduceFragmentation
+ * @key gc
+ * @requires vm.gc=="ConcMarkSweep" | vm.gc=="null"
+ * @summary Sweep a fragmented CMS generation with CMSReduceFragmentation and verify the free lists
+ * @run main/othervm -XX:+UseConcMarkSweepGC -XX:+CMSReduceFragmentation -XX:CMSFragmentationThreshold=0
+ *                   -XX:+ExplicitGCInvokesConcurrent -XX:MaxTenuringThreshold=0
+ *                   -XX:+UnlockDiagnosticVMOptions -XX:+VerifyAfterGC
+ *                   -Xmn4m -Xmx64m TestReduceFragmentation
+ * @run main/othervm -XX:+UseConcMarkSweepGC -XX:+CMSReduceFragmentation -XX:CMSFragmentationThreshold=100
+ *                   -XX:+ExplicitGCInvokesConcurrent -XX:MaxTenuringThreshold=0
+ *                   -XX:+UnlockDiagnosticVMOptions -XX:+VerifyAfterGC
+ *                   -Xmn4m -Xmx64m TestReduceFragmentation
+ */
+
+public class TestReduceFragmentation {
+    public static void main(String[] args) throws Exception {
+        Object[] live = new Object[20000];
+        for (int round = 0; round < 5; round++) {
+            // Promote objects of mixed sizes and free every other one to
+            // leave holes between the survivors.
+            for (int i = 0; i < live.length; i++) {
+                live[i] = new byte[16 + (i % 13) * 40];
+            }
+            System.gc();
+            for (int i = round % 2; i < live.length; i += 2) {
+                live[i] = null;
+            }
+            System.gc();
+        }
+    }
+}
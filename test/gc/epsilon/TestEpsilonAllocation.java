@@ -0,0 +1,100 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test TestEpsilonAllocation
+ * @key gc
+ * @summary The Epsilon heap expands on demand, exposes its pool, ignores
+ *          collection requests and fails with OutOfMemoryError once the
+ *          heap is exhausted
+ * @library /testlibrary
+ * @run main/othervm -XX:+UnlockExperimentalVMOptions -XX:+UseEpsilonGC
+ *                   -Xms16m -Xmx256m -XX:EpsilonMinHeapExpand=1m TestEpsilonAllocation
+ * @run main/othervm -XX:+UnlockExperimentalVMOptions -XX:+UseEpsilonGC
+ *                   -Xms16m -Xmx256m -XX:-UseTLAB TestEpsilonAllocation
+ */
+
+import com.oracle.java.testlibrary.OutputAnalyzer;
+import com.oracle.java.testlibrary.ProcessTools;
+import java.lang.management.GarbageCollectorMXBean;
+import java.lang.management.ManagementFactory;
+import java.lang.management.MemoryPoolMXBean;
+import java.lang.management.MemoryUsage;
+
+public class TestEpsilonAllocation {
+    static volatile Object sink;
+
+    static MemoryPoolMXBean epsilonPool() {
+        for (MemoryPoolMXBean pool : ManagementFactory.getMemoryPoolMXBeans()) {
+            if (pool.getName().equals("Epsilon Heap")) {
+                return pool;
+            }
+        }
+        throw new RuntimeException("Epsilon Heap memory pool not found");
+    }
+
+    static void allocate(long bytes) {
+        for (long i = 0; i < bytes; i += 4096) {
+            sink = new byte[4096];
+        }
+    }
+
+    // Allocates garbage until the heap is exhausted.
+    public static class Exhaust {
+        public static void main(String[] args) {
+            while (true) {
+                sink = new byte[4096];
+            }
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        MemoryPoolMXBean pool = epsilonPool();
+        MemoryUsage start = pool.getUsage();
+
+        // Garbage is never reclaimed, so the heap has to grow to hold it.
+        allocate(64 * 1024 * 1024);
+        System.gc();
+        MemoryUsage end = pool.getUsage();
+        System.out.println("Epsilon heap at start: " + start + ", at end: " + end);
+        if (end.getUsed() < start.getUsed() + 64 * 1024 * 1024) {
+            throw new RuntimeException("Allocated memory should not be reclaimed");
+        }
+        if (end.getCommitted() <= start.getCommitted()) {
+            throw new RuntimeException("Epsilon heap should have expanded");
+        }
+        for (GarbageCollectorMXBean gc : ManagementFactory.getGarbageCollectorMXBeans()) {
+            if (gc.getCollectionCount() != 0) {
+                throw new RuntimeException(gc.getName() + " should not have collected");
+            }
+        }
+
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+            "-XX:+UnlockExperimentalVMOptions", "-XX:+UseEpsilonGC",
+            "-Xmx32m", Exhaust.class.getName());
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        output.shouldContain("java.lang.OutOfMemoryError: Java heap space");
+        output.shouldNotHaveExitValue(0);
+    }
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test TestAdaptiveIHOP
+ * @summary G1: with G1UseAdaptiveIHOP marking cycles are still started and completed
+ * @key gc
+ * @library /testlibrary
+ */
+
+import java.util.LinkedList;
+
+import com.oracle.java.testlibrary.*;
+
+public class TestAdaptiveIHOP {
+
+    public static void main(String[] args) throws Exception {
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+            "-XX:+UseG1GC",
+            "-Xms64m",
+            "-Xmx64m",
+            "-Xmn8m",
+            "-XX:+G1UseAdaptiveIHOP",
+            "-XX:G1AdaptiveIHOPNumInitialSamples=1",
+            "-XX:InitiatingHeapOccupancyPercent=30",
+            "-XX:+PrintGC",
+            "-XX:+PrintAdaptiveSizePolicy",
+            OldGenAllocator.class.getName());
+
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        output.shouldContain("request concurrent cycle initiation");
+        output.shouldContain("GC concurrent-mark-end");
+        output.shouldNotContain("Full GC");
+        output.shouldHaveExitValue(0);
+    }
+
+    static class OldGenAllocator {
+        public static void main(String [] args) throws Exception {
+            LinkedList<byte[]> retained = new LinkedList<byte[]>();
+            long retainedBytes = 0;
+            // Promote a steady stream of objects into the old generation,
+            // releasing the oldest ones to keep the live set bounded.
+            for (int i = 0; i < 200000; i++) {
+                byte[] b = new byte[1024];
+                if (i % 4 == 0) {
+                    retained.addLast(b);
+                    retainedBytes += b.length;
+                    if (retainedBytes > 24 * 1024 * 1024) {
+                        retainedBytes -= retained.removeFirst().length;
+                    }
+                }
+            }
+            System.out.println(retained.size());
+        }
+    }
+}
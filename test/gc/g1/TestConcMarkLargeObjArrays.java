@@ -0,0 +1,92 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test TestConcMarkLargeObjArrays
+ * @summary G1: large object arrays scanned in slices during concurrent marking must be marked through
+ * @key gc
+ * @library /testlibrary /testlibrary/whitebox
+ * @build TestConcMarkLargeObjArrays
+ * @run main ClassFileInstaller sun.hotspot.WhiteBox
+ *                              sun.hotspot.WhiteBox$WhiteBoxPermission
+ * @run main TestConcMarkLargeObjArrays
+ */
+
+import com.oracle.java.testlibrary.*;
+import sun.hotspot.WhiteBox;
+
+public class TestConcMarkLargeObjArrays {
+
+    public static void main(String[] args) throws Exception {
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+            "-Xbootclasspath/a:.",
+            "-XX:+UseG1GC",
+            "-Xmx128m",
+            "-XX:G1HeapRegionSize=1m",
+            "-XX:ConcGCThreads=4",
+            "-XX:+UnlockDiagnosticVMOptions",
+            "-XX:+WhiteBoxAPI",
+            "-XX:+VerifyDuringGC",
+            "-XX:+PrintGC",
+            LargeArrays.class.getName());
+
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        output.shouldContain("GC remark");
+        output.shouldHaveExitValue(0);
+    }
+
+    static class LargeArrays {
+        private static final WhiteBox WB = WhiteBox.getWhiteBox();
+
+        static Object[] humongous = new Object[1024 * 1024];
+        static Object[] regular = new Object[32 * 1024];
+
+        public static void main(String [] args) throws Exception {
+            for (int i = 0; i < humongous.length; i += 7) {
+                humongous[i] = new Integer(i);
+            }
+            for (int i = 0; i < regular.length; i++) {
+                regular[i] = new int[] { i };
+            }
+            WB.fullGC();
+
+            for (int round = 0; round < 3; round++) {
+                WB.g1StartConcMarkCycle();
+                while (WB.g1InConcurrentMark()) {
+                    Thread.sleep(10);
+                }
+            }
+
+            for (int i = 0; i < humongous.length; i += 7) {
+                if (((Integer) humongous[i]).intValue() != i) {
+                    throw new RuntimeException("Corrupted humongous array at " + i);
+                }
+            }
+            for (int i = 0; i < regular.length; i++) {
+                if (((int[]) regular[i])[0] != i) {
+                    throw new RuntimeException("Corrupted array at " + i);
+                }
+            }
+        }
+    }
+}
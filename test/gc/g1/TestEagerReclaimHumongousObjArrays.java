@@ -0,0 +1,114 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test TestEagerReclaimHumongousObjArrays
+ * @summary Test that dead humongous object arrays are eagerly reclaimed at
+ * young GCs, and that live ones and the objects they reference survive.
+ * @key gc
+ * @library /testlibrary
+ */
+
+import java.util.regex.Pattern;
+import java.util.regex.Matcher;
+import java.util.LinkedList;
+
+import com.oracle.java.testlibrary.OutputAnalyzer;
+import com.oracle.java.testlibrary.ProcessTools;
+import static com.oracle.java.testlibrary.Asserts.*;
+
+class ReclaimObjArrays {
+
+    public static final int M = 1024*1024;
+
+    public static LinkedList<Object> garbageList = new LinkedList<Object>();
+
+    public static void genGarbage() {
+        for (int i = 0; i < 32*1024; i++) {
+            garbageList.add(new int[100]);
+        }
+        garbageList.clear();
+    }
+
+    static class Holder {
+        Object[] ref;
+    }
+
+    static Holder fromOld = new Holder();
+
+    public static void main(String[] args) {
+        Object[] survivor = new Object[M / 2];
+        for (int i = 0; i < survivor.length; i += 1024) {
+            survivor[i] = new Integer(i);
+        }
+
+        for (int i = 0; i < 100; i++) {
+            // A large reference array that becomes garbage quickly.
+            Object[] large = new Object[2 * M];
+            for (int j = 0; j < large.length; j += 4096) {
+                large[j] = new int[] { j };
+            }
+            fromOld.ref = large;
+            genGarbage();
+        }
+
+        for (int i = 0; i < survivor.length; i += 1024) {
+            if (((Integer) survivor[i]).intValue() != i) {
+                throw new RuntimeException("Live humongous array corrupted at " + i);
+            }
+        }
+    }
+}
+
+public class TestEagerReclaimHumongousObjArrays {
+
+    private static int countFullGCs(String flag) throws Exception {
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+            "-XX:+UseG1GC",
+            "-Xms128M",
+            "-Xmx128M",
+            "-Xmn16M",
+            "-XX:+UnlockExperimentalVMOptions",
+            flag,
+            "-XX:+PrintGC",
+            ReclaimObjArrays.class.getName());
+
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        output.shouldHaveExitValue(0);
+
+        Pattern p = Pattern.compile("Full GC");
+        int found = 0;
+        Matcher m = p.matcher(output.getStdout());
+        while (m.find()) {
+            found++;
+        }
+        System.out.println("Issued " + found + " Full GCs with " + flag);
+        return found;
+    }
+
+    public static void main(String[] args) throws Exception {
+        int found = countFullGCs("-XX:+G1EagerReclaimHumongousObjArrays");
+        assertLessThan(found, 10, "Found that " + found + " Full GCs were issued. This is larger than the bound. Eager reclaim of object arrays seems to not work at all");
+        countFullGCs("-XX:-G1EagerReclaimHumongousObjArrays");
+    }
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test TestEvacuationFailureRecovery
+ * @summary Verify the heap after G1 recovers from evacuation failures
+ * @requires vm.gc=="G1" | vm.gc=="null"
+ * @key gc
+ * @library /testlibrary
+ * @run main/othervm TestEvacuationFailureRecovery
+ */
+
+import com.oracle.java.testlibrary.OutputAnalyzer;
+import com.oracle.java.testlibrary.ProcessTools;
+
+public class TestEvacuationFailureRecovery {
+
+    public static void main(String[] args) throws Exception {
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+            "-XX:+UseG1GC", "-Xmx32m", "-Xmn16m", "-XX:G1HeapRegionSize=1m",
+            "-XX:+UnlockDiagnosticVMOptions", "-XX:+VerifyAfterGC",
+            "-XX:+PrintGCDetails",
+            Churn.class.getName());
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        output.shouldNotContain("Verification failed");
+        output.shouldHaveExitValue(0);
+        if (!output.getStdout().contains("to-space exhausted")) {
+            System.out.println("No evacuation failure happened in this run");
+        }
+    }
+
+    // Keeps most of the heap live so that young collections run out of
+    // space to copy into. Every few objects have an identity hash, so
+    // their marks must be preserved and restored by the recovery.
+    static class Churn {
+        static final int SLOTS = 24 * 1024;
+        static Object[] live = new Object[SLOTS];
+
+        public static void main(String[] args) {
+            long hashes = 0;
+            for (int i = 0; i < 40 * SLOTS; i++) {
+                Object o = new byte[1024];
+                if ((i % 7) == 0) {
+                    hashes += System.identityHashCode(o);
+                }
+                live[i % SLOTS] = o;
+            }
+            System.out.println("Done " + hashes);
+        }
+    }
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test TestHumongousWaste
+ * @summary Verify that G1 accounts for the unused tails of humongous regions
+ * @requires vm.gc=="G1" | vm.gc=="null"
+ * @key gc
+ * @library /testlibrary /testlibrary/whitebox
+ * @build TestHumongousWaste
+ * @run main ClassFileInstaller sun.hotspot.WhiteBox
+ *                              sun.hotspot.WhiteBox$WhiteBoxPermission
+ * @run main/othervm -Xbootclasspath/a:. -XX:+UseG1GC -Xmx128m -XX:G1HeapRegionSize=4m
+ *      -XX:+UnlockDiagnosticVMOptions -XX:+WhiteBoxAPI
+ *      TestHumongousWaste
+ */
+
+import sun.hotspot.WhiteBox;
+
+public class TestHumongousWaste {
+    private static final int MB = 1024 * 1024;
+    private static final int COUNT = 5;
+
+    public static void main(String[] args) throws Exception {
+        WhiteBox wb = WhiteBox.getWhiteBox();
+        int regionSize = wb.g1RegionSize();
+
+        long wasteBefore = wb.g1HumongousWasteBytes();
+
+        // Each array needs a little more than one region, so almost all of
+        // its second region is unused.
+        int length = regionSize + MB;
+        byte[][] holder = new byte[COUNT][];
+        for (int i = 0; i < COUNT; i++) {
+            holder[i] = new byte[length];
+            if (!wb.g1IsHumongous(holder[i])) {
+                throw new RuntimeException("Array of " + length + " bytes is expected to be humongous");
+            }
+        }
+
+        long waste = wb.g1HumongousWasteBytes() - wasteBefore;
+        long expectedPerObject = 2L * regionSize - wb.getObjectSize(holder[0]);
+        System.out.println("Humongous waste: " + waste + ", expected: " + COUNT * expectedPerObject);
+        if (waste != COUNT * expectedPerObject) {
+            throw new RuntimeException("Expected " + COUNT * expectedPerObject +
+                                       " bytes of humongous waste but got " + waste);
+        }
+
+        holder = null;
+        wb.fullGC();
+        if (wb.g1HumongousWasteBytes() > wasteBefore) {
+            throw new RuntimeException("Humongous waste is expected to go away with the objects");
+        }
+    }
+}
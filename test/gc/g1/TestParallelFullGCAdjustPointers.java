@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test TestParallelFullGCAdjustPointers
+ * @summary G1: pointers adjusted by parallel worker threads during a full GC must be correct
+ * @key gc
+ * @library /testlibrary
+ */
+
+import com.oracle.java.testlibrary.*;
+
+public class TestParallelFullGCAdjustPointers {
+
+    public static void main(String[] args) throws Exception {
+        runTest("-XX:+G1ParallelFullGCAdjustPointers");
+        runTest("-XX:-G1ParallelFullGCAdjustPointers");
+    }
+
+    private static void runTest(String flag) throws Exception {
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+            "-XX:+UseG1GC",
+            "-Xmx64m",
+            "-XX:G1HeapRegionSize=1m",
+            "-XX:ParallelGCThreads=4",
+            "-XX:+UnlockExperimentalVMOptions",
+            flag,
+            "-XX:+UnlockDiagnosticVMOptions",
+            "-XX:+VerifyAfterGC",
+            "-XX:+PrintGC",
+            ObjectGraphAllocator.class.getName());
+
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        output.shouldContain("Full GC");
+        output.shouldHaveExitValue(0);
+    }
+
+    static class ObjectGraphAllocator {
+        static class Node {
+            Node next;
+            Object[] payload;
+            int id;
+        }
+
+        public static void main(String [] args) throws Exception {
+            Node head = null;
+            int count = 0;
+            // Interleave live and dead objects so that the live ones are
+            // moved during compaction and their referents need adjusting.
+            for (int i = 0; i < 200000; i++) {
+                Node n = new Node();
+                n.id = i;
+                n.payload = new Object[i % 16];
+                if (i % 3 == 0) {
+                    n.next = head;
+                    head = n;
+                    count++;
+                }
+            }
+            System.gc();
+            int found = 0;
+            for (Node n = head; n != null; n = n.next) {
+                if (n.id % 3 != 0 || n.payload.length != n.id % 16) {
+                    throw new RuntimeException("Corrupted node " + n.id);
+                }
+                found++;
+            }
+            if (found != count) {
+                throw new RuntimeException("Expected " + count + " nodes but found " + found);
+            }
+        }
+    }
+}
@@ -0,0 +1,96 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test TestPeriodicCollection
+ * @summary Verify that an idle G1 heap is collected and shrunk by G1PeriodicGCInterval
+ * @requires vm.gc=="G1" | vm.gc=="null"
+ * @key gc
+ * @library /testlibrary
+ * @run main/othervm TestPeriodicCollection
+ */
+
+import java.util.LinkedList;
+
+import com.oracle.java.testlibrary.OutputAnalyzer;
+import com.oracle.java.testlibrary.ProcessTools;
+
+public class TestPeriodicCollection {
+  private static final int MB = 1024 * 1024;
+
+  public static class IdleApplication {
+    public static void main(String[] args) throws Exception {
+      // Grow the heap, then drop everything and go idle.
+      LinkedList<byte[]> holder = new LinkedList<byte[]>();
+      for (int i = 0; i < 64; i++) {
+        holder.add(new byte[2 * MB]);
+      }
+      long committedBefore = Runtime.getRuntime().totalMemory();
+      holder.clear();
+
+      long committedAfter = committedBefore;
+      for (int i = 0; i < 100 && committedAfter > committedBefore / 2; i++) {
+        Thread.sleep(100);
+        committedAfter = Runtime.getRuntime().totalMemory();
+      }
+      System.out.println("Committed before idling: " + committedBefore +
+                         ", after: " + committedAfter);
+      if (args.length > 0 && args[0].equals("shrink") &&
+          committedAfter > committedBefore / 2) {
+        throw new RuntimeException("Idle heap was not shrunk");
+      }
+    }
+  }
+
+  private static OutputAnalyzer run(String... flags) throws Exception {
+    String[] common = new String[] {
+      "-XX:+UseG1GC", "-Xms8m", "-Xmx256m", "-XX:G1HeapRegionSize=1m", "-XX:+PrintGC"
+    };
+    String[] args = new String[common.length + flags.length + 2];
+    System.arraycopy(common, 0, args, 0, common.length);
+    System.arraycopy(flags, 0, args, common.length, flags.length);
+    args[args.length - 2] = IdleApplication.class.getName();
+    args[args.length - 1] = flags.length > 0 && !flags[0].endsWith("=0") ? "shrink" : "";
+    ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(args);
+    OutputAnalyzer output = new OutputAnalyzer(pb.start());
+    System.out.println(output.getOutput());
+    output.shouldHaveExitValue(0);
+    return output;
+  }
+
+  public static void main(String[] args) throws Exception {
+    run("-XX:G1PeriodicGCInterval=0")
+      .shouldNotContain("G1 Periodic Collection");
+
+    run("-XX:G1PeriodicGCInterval=100")
+      .shouldContain("(G1 Periodic Collection) (young) (initial-mark)");
+
+    run("-XX:G1PeriodicGCInterval=100", "-XX:-G1PeriodicGCInvokesConcurrent")
+      .shouldContain("Full GC (G1 Periodic Collection)");
+
+    // A load threshold no machine reaches does not hold the collection off.
+    run("-XX:G1PeriodicGCInterval=100", "-XX:G1PeriodicGCSystemLoadThreshold=100000")
+      .shouldContain("G1 Periodic Collection");
+  }
+}
@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test TestPeriodicUncommit
+ * @summary Verify that G1 gives back memory of free regions without a full GC
+ * @requires vm.gc=="G1" | vm.gc=="null"
+ * @key gc
+ * @library /testlibrary /testlibrary/whitebox
+ * @build TestPeriodicUncommit
+ * @run main ClassFileInstaller sun.hotspot.WhiteBox
+ *                              sun.hotspot.WhiteBox$WhiteBoxPermission
+ * @run main/othervm -Xbootclasspath/a:. -XX:+UseG1GC -Xms8m -Xmx256m -XX:G1HeapRegionSize=1m
+ *      -XX:G1PeriodicUncommitInterval=100 -XX:G1UncommitDelay=0
+ *      -XX:+UnlockDiagnosticVMOptions -XX:+WhiteBoxAPI -XX:+PrintGC
+ *      TestPeriodicUncommit
+ */
+
+import java.util.LinkedList;
+
+import sun.hotspot.WhiteBox;
+
+public class TestPeriodicUncommit {
+    private static final int MB = 1024 * 1024;
+
+    public static void main(String[] args) throws Exception {
+        WhiteBox wb = WhiteBox.getWhiteBox();
+
+        // Grow the heap by allocating humongous objects and keeping them
+        // alive across a young GC.
+        LinkedList<byte[]> holder = new LinkedList<byte[]>();
+        for (int i = 0; i < 64; i++) {
+            holder.add(new byte[2 * MB]);
+        }
+        wb.youngGC();
+        long committedBefore = Runtime.getRuntime().totalMemory();
+        System.out.println("Committed after allocation: " + committedBefore);
+
+        // Drop them; eager reclaim frees the regions at the next young GC.
+        holder.clear();
+        wb.youngGC();
+
+        // Wait for the concurrent mark thread to uncommit the free regions.
+        long committedAfter = committedBefore;
+        for (int i = 0; i < 100 && committedAfter > committedBefore / 2; i++) {
+            Thread.sleep(100);
+            committedAfter = Runtime.getRuntime().totalMemory();
+        }
+        System.out.println("Committed after uncommit: " + committedAfter);
+
+        if (committedAfter > committedBefore / 2) {
+            throw new RuntimeException("Expected committed heap to shrink from " +
+                                       committedBefore + " but it is " + committedAfter);
+        }
+    }
+}
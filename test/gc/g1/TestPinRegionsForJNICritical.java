@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test TestPinRegionsForJNICritical
+ * @summary Test that pinning regions for JNI critical sections keeps
+ * the pinned arrays intact across evacuation pauses.
+ * @key gc
+ * @run main/othervm -XX:+UseG1GC -XX:+UnlockExperimentalVMOptions -XX:+G1PinRegionsForJNICritical -Xmx128m -XX:G1HeapRegionSize=1m TestPinRegionsForJNICritical
+ */
+
+import java.util.Arrays;
+import java.util.Random;
+import java.util.zip.DataFormatException;
+import java.util.zip.Deflater;
+import java.util.zip.Inflater;
+
+public class TestPinRegionsForJNICritical {
+
+    // Deflater and Inflater access their byte arrays through
+    // GetPrimitiveArrayCritical, so compressing data while another thread
+    // forces young GCs exercises region pinning.
+    static volatile boolean done = false;
+    static Object sink;
+
+    public static void main(String[] args) throws Exception {
+        Thread allocator = new Thread() {
+            public void run() {
+                while (!done) {
+                    sink = new byte[16 * 1024];
+                }
+            }
+        };
+        allocator.start();
+
+        Random random = new Random(42);
+        byte[] input = new byte[256 * 1024];
+        byte[] output = new byte[input.length * 2];
+        byte[] result = new byte[input.length];
+        try {
+            for (int i = 0; i < 500; i++) {
+                for (int j = 0; j < input.length; j++) {
+                    input[j] = (byte) random.nextInt(16);
+                }
+                int len = compress(input, output);
+                int n = decompress(output, len, result);
+                if (n != input.length || !Arrays.equals(input, result)) {
+                    throw new RuntimeException("Round trip mismatch in iteration " + i);
+                }
+            }
+        } finally {
+            done = true;
+            allocator.join();
+        }
+    }
+
+    static int compress(byte[] input, byte[] output) {
+        Deflater deflater = new Deflater();
+        deflater.setInput(input);
+        deflater.finish();
+        int len = deflater.deflate(output);
+        deflater.end();
+        return len;
+    }
+
+    static int decompress(byte[] input, int len, byte[] output) throws DataFormatException {
+        Inflater inflater = new Inflater();
+        inflater.setInput(input, 0, len);
+        int n = inflater.inflate(output);
+        inflater.end();
+        return n;
+    }
+}
@@ -0,0 +1,118 @@
+/*
+ * Copyright (c) 2018, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test TestRebuildRemSetsForCandidatesOnly
+ * @summary G1: remembered sets dropped after marking must be rebuilt correctly
+ * @key gc
+ * @library /testlibrary /testlibrary/whitebox
+ * @build TestRebuildRemSetsForCandidatesOnly
+ * @run main ClassFileInstaller sun.hotspot.WhiteBox
+ *                              sun.hotspot.WhiteBox$WhiteBoxPermission
+ * @run main TestRebuildRemSetsForCandidatesOnly
+ */
+
+import com.oracle.java.testlibrary.*;
+import sun.hotspot.WhiteBox;
+
+public class TestRebuildRemSetsForCandidatesOnly {
+
+    public static void main(String[] args) throws Exception {
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+            "-Xbootclasspath/a:.",
+            "-XX:+UseG1GC",
+            "-Xmx64m",
+            "-Xmn8m",
+            "-XX:G1HeapRegionSize=1m",
+            "-XX:+UnlockExperimentalVMOptions",
+            "-XX:+G1RebuildRemSetsForCandidatesOnly",
+            "-XX:+UnlockDiagnosticVMOptions",
+            "-XX:+WhiteBoxAPI",
+            "-XX:+VerifyBeforeGC",
+            "-XX:+VerifyAfterGC",
+            "-XX:+PrintGC",
+            CrossRegionReferences.class.getName());
+
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        output.shouldContain("GC cleanup");
+        output.shouldHaveExitValue(0);
+    }
+
+    static class CrossRegionReferences {
+        private static final WhiteBox WB = WhiteBox.getWhiteBox();
+
+        static class Node {
+            Node other;
+            byte[] payload = new byte[64];
+            int id;
+        }
+
+        static Node[] nodes = new Node[100000];
+
+        private static void runConcurrentCycle() throws Exception {
+            WB.g1StartConcMarkCycle();
+            while (WB.g1InConcurrentMark()) {
+                Thread.sleep(10);
+            }
+        }
+
+        public static void main(String [] args) throws Exception {
+            for (int i = 0; i < nodes.length; i++) {
+                nodes[i] = new Node();
+                nodes[i].id = i;
+            }
+            WB.fullGC();
+
+            for (int round = 0; round < 4; round++) {
+                // Let roughly half of the old objects die and link the
+                // survivors to old objects in other regions, so that some
+                // regions become candidates and others keep references into
+                // regions whose remembered sets have been dropped.
+                for (int i = round % 2; i < nodes.length; i += 2) {
+                    nodes[i] = null;
+                }
+                runConcurrentCycle();
+                for (int i = 0; i < nodes.length; i++) {
+                    if (nodes[i] == null) {
+                        nodes[i] = new Node();
+                        nodes[i].id = i;
+                    }
+                }
+                for (int i = 0; i < nodes.length; i++) {
+                    nodes[i].other = nodes[(i * 7919 + round) % nodes.length];
+                }
+                runConcurrentCycle();
+                for (int i = 0; i < 4; i++) {
+                    WB.youngGC();
+                }
+            }
+
+            for (int i = 0; i < nodes.length; i++) {
+                Node n = nodes[i];
+                if (n.id != i || n.other.id != (i * 7919 + 3) % nodes.length) {
+                    throw new RuntimeException("Object graph corrupted at " + i);
+                }
+            }
+        }
+    }
+}
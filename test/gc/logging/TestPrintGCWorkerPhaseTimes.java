@@ -0,0 +1,73 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test TestPrintGCWorkerPhaseTimes
+ * @summary -XX:+PrintGCWorkerPhaseTimes prints the per-worker phase times of the parallel collectors
+ * @key gc
+ * @library /testlibrary
+ * @run main/othervm TestPrintGCWorkerPhaseTimes
+ */
+import com.oracle.java.testlibrary.*;
+
+public class TestPrintGCWorkerPhaseTimes {
+
+    public static class GCLoop {
+        static Object sink;
+
+        public static void main(String[] args) {
+            for (int i = 0; i < 1024 * 64; i++) {
+                sink = new byte[1024];
+            }
+            for (int i = 0; i < 3; i++) {
+                System.gc();
+            }
+        }
+    }
+
+    static void verify(String[] flags, String... titles) throws Exception {
+        String[] args = new String[flags.length + 4];
+        System.arraycopy(flags, 0, args, 0, flags.length);
+        args[flags.length]     = "-Xmn8m";
+        args[flags.length + 1] = "-XX:+PrintGCDetails";
+        args[flags.length + 2] = "-XX:+PrintGCWorkerPhaseTimes";
+        args[flags.length + 3] = GCLoop.class.getName();
+
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(args);
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        output.shouldHaveExitValue(0);
+        for (String title : titles) {
+            output.shouldContain("[" + title + " Worker Phases, Workers: ");
+        }
+        output.shouldContain("Termination Attempts:");
+        output.shouldContain("GC Worker CPU");
+    }
+
+    public static void main(String[] args) throws Exception {
+        verify(new String[] { "-XX:+UseParallelGC", "-XX:+UseParallelOldGC" },
+               "PSScavenge", "PSParallelCompact");
+        verify(new String[] { "-XX:+UseConcMarkSweepGC", "-XX:+ExplicitGCInvokesConcurrent" },
+               "ParNew", "CMS Initial Mark", "CMS Remark");
+    }
+}
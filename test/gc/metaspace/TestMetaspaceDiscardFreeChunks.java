@@ -0,0 +1,65 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test TestMetaspaceDiscardFreeChunks
+ * @summary Metaspace chunks whose pages were discarded on free are reusable
+ * @run main/othervm -XX:+MetaspaceDiscardFreeChunks -Xmx64m TestMetaspaceDiscardFreeChunks
+ * @run main/othervm -XX:-MetaspaceDiscardFreeChunks -Xmx64m TestMetaspaceDiscardFreeChunks
+ */
+
+import java.io.File;
+import java.lang.reflect.Method;
+import java.net.URL;
+import java.net.URLClassLoader;
+
+public class TestMetaspaceDiscardFreeChunks {
+    public static class Payload {
+        public static int compute(int n) {
+            int sum = 0;
+            for (int i = 0; i < n; i++) {
+                sum += Integer.toString(i).hashCode();
+            }
+            return sum;
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        URL[] urls = { new File(System.getProperty("test.classes", ".")).toURI().toURL() };
+        int expected = Payload.compute(100);
+        for (int round = 0; round < 20; round++) {
+            for (int i = 0; i < 50; i++) {
+                // Parent null so that each loader defines its own Payload
+                URLClassLoader loader = new URLClassLoader(urls, null);
+                Class<?> c = loader.loadClass("TestMetaspaceDiscardFreeChunks$Payload");
+                Method m = c.getMethod("compute", int.class);
+                if ((Integer) m.invoke(null, 100) != expected) {
+                    throw new RuntimeException("Wrong result in round " + round);
+                }
+                loader.close();
+            }
+            System.gc();
+        }
+    }
+}
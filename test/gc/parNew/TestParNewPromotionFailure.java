@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test TestParNewPromotionFailure
+ * @key gc
+ * @requires vm.gc=="ConcMarkSweep" | vm.gc=="null"
+ * @summary Recover from ParNew promotion failures with per-worker preserved marks
+ * @library /testlibrary
+ * @run main/othervm TestParNewPromotionFailure
+ */
+
+import com.oracle.java.testlibrary.*;
+
+public class TestParNewPromotionFailure {
+    public static void main(String[] args) throws Exception {
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+            "-XX:+UseConcMarkSweepGC",
+            "-XX:ParallelGCThreads=4",
+            "-XX:MaxTenuringThreshold=0",
+            "-XX:CMSInitiatingOccupancyFraction=95",
+            "-XX:+UseCMSInitiatingOccupancyOnly",
+            "-XX:+PrintGCDetails",
+            "-XX:+PrintPromotionFailure",
+            "-XX:+UnlockDiagnosticVMOptions",
+            "-XX:+VerifyAfterGC",
+            "-Xmn16m",
+            "-Xmx40m",
+            TestParNewPromotionFailure.Allocate.class.getName());
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        output.shouldHaveExitValue(0);
+        if (output.getStdout().contains("(promotion failed)")) {
+            output.shouldContain("[Remove Forwarding Pointers");
+            output.shouldContain("[Restore Preserved Marks");
+        }
+    }
+
+    static class Allocate {
+        public static void main(String[] args) throws Exception {
+            Object[] live = new Object[4000];
+            for (int round = 0; round < 20; round++) {
+                for (int i = 0; i < live.length; i++) {
+                    Object o = new byte[1024 + (i % 7) * 512];
+                    // Give some objects marks that must be preserved
+                    // if they get forwarded to themselves.
+                    if (i % 3 == 0) {
+                        System.identityHashCode(o);
+                    }
+                    live[i] = o;
+                }
+            }
+        }
+    }
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test TestGCTaskStealing
+ * @key gc
+ * @summary Run young and full ParallelGC collections with the GC tasks handed out through work stealing
+ * @run main/othervm -XX:+UseParallelGC -XX:+UseParallelOldGC -XX:ParallelGCThreads=8
+ *                   -XX:+UnlockExperimentalVMOptions -XX:+UseGCTaskStealing
+ *                   -Xmn8m -Xmx64m TestGCTaskStealing
+ * @run main/othervm -XX:+UseParallelGC -XX:+UseParallelOldGC -XX:ParallelGCThreads=8
+ *                   -XX:+UseDynamicNumberOfGCThreads
+ *                   -XX:+UnlockExperimentalVMOptions -XX:+UseGCTaskStealing
+ *                   -Xmn8m -Xmx64m TestGCTaskStealing
+ * @run main/othervm -XX:+UseParallelGC -XX:-UseParallelOldGC -XX:ParallelGCThreads=1
+ *                   -XX:+UnlockExperimentalVMOptions -XX:+UseGCTaskStealing
+ *                   -Xmn8m -Xmx64m TestGCTaskStealing
+ */
+
+import java.util.ArrayList;
+import java.util.List;
+
+public class TestGCTaskStealing {
+    public static void main(String[] args) throws Exception {
+        // Many threads give many thread root tasks to each scavenge.
+        List<Thread> threads = new ArrayList<Thread>();
+        for (int i = 0; i < 32; i++) {
+            Thread t = new Thread() {
+                public void run() {
+                    allocate(200);
+                }
+            };
+            threads.add(t);
+            t.start();
+        }
+        for (int i = 0; i < 10; i++) {
+            allocate(20);
+            System.gc();
+        }
+        for (Thread t : threads) {
+            t.join();
+        }
+    }
+
+    static Object sink;
+
+    static void allocate(int rounds) {
+        List<byte[]> live = new ArrayList<byte[]>();
+        for (int r = 0; r < rounds; r++) {
+            for (int i = 0; i < 1000; i++) {
+                byte[] b = new byte[128];
+                if (i % 100 == 0) {
+                    live.add(b);
+                }
+                sink = b;
+            }
+            if (live.size() > 1000) {
+                live.clear();
+            }
+        }
+    }
+}
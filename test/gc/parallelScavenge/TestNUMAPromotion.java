@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test TestNUMAPromotion
+ * @key gc
+ * @summary Promote objects through the per-node old gen chunks and verify the heap afterwards
+ * @run main/othervm -XX:+UseParallelGC -XX:+UseNUMA -XX:+ForceNUMA -XX:+UseNUMAPromotion
+ *                   -XX:MaxTenuringThreshold=1 -XX:ParallelGCThreads=4
+ *                   -XX:+UnlockDiagnosticVMOptions -XX:+VerifyAfterGC
+ *                   -Xmn8m -Xmx64m TestNUMAPromotion
+ * @run main/othervm -XX:+UseParallelGC -XX:+UseNUMA -XX:+ForceNUMA -XX:+UseNUMAPromotion
+ *                   -XX:NUMAPromotionChunkSize=1 -XX:MaxTenuringThreshold=0
+ *                   -XX:+UnlockDiagnosticVMOptions -XX:+VerifyAfterGC
+ *                   -Xmn8m -Xmx64m TestNUMAPromotion
+ */
+
+import java.util.ArrayList;
+import java.util.List;
+
+public class TestNUMAPromotion {
+    static Object sink;
+
+    public static void main(String[] args) throws Exception {
+        List<Object> live = new ArrayList<Object>();
+        for (int r = 0; r < 100; r++) {
+            for (int i = 0; i < 1000; i++) {
+                Object o = new byte[64 + (i % 7) * 32];
+                if (i % 10 == 0) {
+                    live.add(o);
+                }
+                sink = o;
+            }
+            if (live.size() > 5000) {
+                live.clear();
+            }
+            if (r % 25 == 0) {
+                System.gc();
+            }
+        }
+    }
+}
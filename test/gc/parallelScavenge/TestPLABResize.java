@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test TestPLABResize
+ * @key gc
+ * @summary Check that ParallelGC resizes the promotion labs of its workers when ResizePLAB is set
+ * @library /testlibrary
+ * @run main/othervm TestPLABResize
+ */
+
+import com.oracle.java.testlibrary.*;
+
+public class TestPLABResize {
+    public static void main(String[] args) throws Exception {
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+            "-XX:+UseParallelGC",
+            "-XX:ParallelGCThreads=4",
+            "-XX:+ResizePLAB",
+            "-XX:+PrintPLAB",
+            "-XX:+UnlockDiagnosticVMOptions",
+            "-XX:+VerifyAfterGC",
+            "-Xmn8m",
+            "-Xmx64m",
+            TestPLABResize.Allocate.class.getName());
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        output.shouldContain("promotion manager 0: young plab");
+        output.shouldHaveExitValue(0);
+
+        pb = ProcessTools.createJavaProcessBuilder(
+            "-XX:+UseParallelGC",
+            "-XX:-ResizePLAB",
+            "-XX:+PrintPLAB",
+            "-Xmn8m",
+            "-Xmx64m",
+            TestPLABResize.Allocate.class.getName());
+        output = new OutputAnalyzer(pb.start());
+        output.shouldNotContain("promotion manager");
+        output.shouldHaveExitValue(0);
+    }
+
+    static class Allocate {
+        static Object sink;
+
+        public static void main(String[] args) {
+            Object[] live = new Object[4096];
+            for (int i = 0; i < 200000; i++) {
+                Object o = new byte[100 + i % 200];
+                live[i % live.length] = o;
+                sink = o;
+            }
+        }
+    }
+}
@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+
+/*
+ * @test TestDefNewParallelCardScan
+ * @key gc
+ * @requires vm.gc=="Serial" | vm.gc=="null"
+ * @summary Scan the old generation card table with a work gang in the serial young collector
+ * @library /testlibrary
+ * @run main/othervm TestDefNewParallelCardScan
+ */
+
+import com.oracle.java.testlibrary.*;
+
+public class TestDefNewParallelCardScan {
+    public static void main(String[] args) throws Exception {
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+            "-XX:+UseSerialGC",
+            "-XX:DefNewParallelScanThreads=3",
+            "-XX:+PrintFlagsFinal",
+            "-version");
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        output.shouldMatch("ParallelGCThreads\\s+:= 3");
+        output.shouldHaveExitValue(0);
+
+        pb = ProcessTools.createJavaProcessBuilder(
+            "-XX:+UseSerialGC",
+            "-XX:DefNewParallelScanThreads=2",
+            "-XX:+UnlockDiagnosticVMOptions",
+            "-XX:+VerifyBeforeGC",
+            "-XX:+VerifyAfterGC",
+            "-Xmn4m",
+            "-Xmx64m",
+            TestDefNewParallelCardScan.Mutate.class.getName());
+        output = new OutputAnalyzer(pb.start());
+        output.shouldHaveExitValue(0);
+    }
+
+    static class Mutate {
+        public static void main(String[] args) throws Exception {
+            // Promote the holders, then keep storing young objects into
+            // them so that every young collection has dirty cards to scan.
+            Object[][] old = new Object[20000][];
+            for (int i = 0; i < old.length; i++) {
+                old[i] = new Object[4];
+            }
+            System.gc();
+            for (int round = 0; round < 200000; round++) {
+                Object[] holder = old[(round * 31) % old.length];
+                holder[round % holder.length] = new byte[64];
+            }
+        }
+    }
+}
@@ -0,0 +1,85 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ */
+/*
+ * @test TestZeroEdenConcurrently
+ * @key gc
+ * @requires vm.gc=="null"
+ * @summary Pre-zero eden in a background thread for the Serial and ParNew young collectors
+ * @library /testlibrary
+ * @run main/othervm TestZeroEdenConcurrently
+ */
+
+import com.oracle.java.testlibrary.*;
+
+public class TestZeroEdenConcurrently {
+    public static void main(String[] args) throws Exception {
+        String[][] gcs = {
+            { "-XX:+UseSerialGC" },
+            { "-XX:+UseParNewGC" },
+            { "-XX:+UseConcMarkSweepGC" }
+        };
+        for (String[] gc : gcs) {
+            ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+                gc[0],
+                "-XX:+ZeroEdenConcurrently",
+                "-XX:+PrintFlagsFinal",
+                "-XX:+UnlockDiagnosticVMOptions",
+                "-XX:+VerifyBeforeGC",
+                "-XX:+VerifyAfterGC",
+                "-Xmx64m",
+                "-Xmn8m",
+                TestZeroEdenConcurrently.Allocate.class.getName());
+            OutputAnalyzer output = new OutputAnalyzer(pb.start());
+            output.shouldMatch("ZeroTLAB\\s+:= true");
+            output.shouldHaveExitValue(0);
+        }
+
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+            "-XX:+UseParallelGC", "-XX:+ZeroEdenConcurrently", "-version");
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        output.shouldContain("ZeroEdenConcurrently requires");
+        output.shouldHaveExitValue(0);
+    }
+
+    static class Allocate {
+        public static Object sink;
+
+        public static void main(String[] args) throws Exception {
+            Object[] live = new Object[1000];
+            for (int i = 0; i < 500000; i++) {
+                long[] a = new long[(i % 13) * 8];
+                for (int j = 0; j < a.length; j++) {
+                    if (a[j] != 0) {
+                        throw new RuntimeException("Not zeroed: " + i + "/" + j);
+                    }
+                    a[j] = i;
+                }
+                sink = a;
+                if (i % 100 == 0) {
+                    live[(i / 100) % live.length] = a;
+                }
+            }
+            System.gc();
+        }
+    }
+}
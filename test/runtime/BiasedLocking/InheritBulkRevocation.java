@@ -0,0 +1,89 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test
+ * @summary Subclasses of a class whose biasing was revoked in bulk start out unbiased
+ * @library /testlibrary
+ * @run main/othervm InheritBulkRevocation
+ */
+
+import com.oracle.java.testlibrary.OutputAnalyzer;
+import com.oracle.java.testlibrary.ProcessTools;
+
+public class InheritBulkRevocation {
+    public static class Base {
+    }
+
+    public static class Sub extends Base {
+    }
+
+    public static class Worker {
+        public static void main(String[] args) throws Exception {
+            // Bias instances of Base toward short lived threads and then
+            // revoke the biases from the main thread until the bulk
+            // revocation threshold is reached.
+            for (int round = 0; round < 4; round++) {
+                final Base[] objects = new Base[30];
+                for (int i = 0; i < objects.length; i++) {
+                    objects[i] = new Base();
+                }
+                Thread t = new Thread() {
+                    public void run() {
+                        for (Base b : objects) {
+                            synchronized (b) {
+                            }
+                        }
+                    }
+                };
+                t.start();
+                t.join();
+                for (Base b : objects) {
+                    System.identityHashCode(b);
+                }
+            }
+            Object o = new Sub();
+            synchronized (o) {
+            }
+        }
+    }
+
+    static OutputAnalyzer run(String flag) throws Exception {
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+            "-XX:+UseBiasedLocking",
+            "-XX:BiasedLockingStartupDelay=0",
+            "-XX:+TraceBiasedLocking",
+            flag,
+            Worker.class.getName());
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        output.shouldHaveExitValue(0);
+        return output;
+    }
+
+    public static void main(String[] args) throws Exception {
+        String message = "Not biasing InheritBulkRevocation$Sub";
+        run("-XX:+BiasedLockingInheritRevocation").shouldContain(message);
+        run("-XX:-BiasedLockingInheritRevocation").shouldNotContain(message);
+    }
+}
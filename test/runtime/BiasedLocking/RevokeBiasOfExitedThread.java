@@ -0,0 +1,74 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test
+ * @summary Revoking the bias of objects biased toward an exited thread does not need a safepoint
+ * @library /testlibrary
+ * @run main/othervm RevokeBiasOfExitedThread
+ */
+
+import com.oracle.java.testlibrary.OutputAnalyzer;
+import com.oracle.java.testlibrary.ProcessTools;
+
+public class RevokeBiasOfExitedThread {
+    static final int OBJECTS = 10;
+
+    public static class Worker {
+        public static void main(String[] args) throws Exception {
+            final Object[] objects = new Object[OBJECTS];
+            for (int i = 0; i < OBJECTS; i++) {
+                objects[i] = new Object();
+            }
+            Thread t = new Thread() {
+                public void run() {
+                    for (Object o : objects) {
+                        synchronized (o) {
+                            // bias o toward this thread
+                        }
+                    }
+                }
+            };
+            t.start();
+            t.join();
+            for (Object o : objects) {
+                // The identity hash requires revoking the bias of the dead thread
+                System.out.println(System.identityHashCode(o));
+                synchronized (o) {
+                }
+            }
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+            "-XX:+UseBiasedLocking",
+            "-XX:BiasedLockingStartupDelay=0",
+            "-XX:+TraceBiasedLocking",
+            Worker.class.getName());
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        output.shouldHaveExitValue(0);
+        output.shouldContain("Revoked bias of object biased toward dead thread without a safepoint");
+    }
+}
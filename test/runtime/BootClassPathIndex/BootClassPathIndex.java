@@ -0,0 +1,90 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test BootClassPathIndex
+ * @summary Classes are found behind boot class path jars that have built a package index
+ * @library /testlibrary
+ * @run main BootClassPathIndex
+ */
+
+import java.io.File;
+import java.io.FileWriter;
+import com.oracle.java.testlibrary.*;
+
+public class BootClassPathIndex {
+    public static class Target {
+        public static void main(String[] args) throws Exception {
+            if (Target.class.getClassLoader() != null) {
+                throw new RuntimeException("Target not loaded by the boot loader");
+            }
+            for (int i = 0; i < 8; i++) {
+                try {
+                    Class.forName("Missing" + i);
+                    throw new RuntimeException("Missing" + i + " unexpectedly found");
+                } catch (ClassNotFoundException e) {
+                    // expected
+                }
+            }
+            if (Class.forName("BootClassPathIndex$Helper").getClassLoader() != null) {
+                throw new RuntimeException("Helper not loaded by the boot loader");
+            }
+            System.out.println("Target done");
+        }
+    }
+
+    public static class Helper { }
+
+    static void jar(String... args) throws Exception {
+        String[] cmd = new String[args.length + 1];
+        cmd[0] = JDKToolFinder.getJDKTool("jar");
+        System.arraycopy(args, 0, cmd, 1, args.length);
+        new OutputAnalyzer(new ProcessBuilder(cmd).start()).shouldHaveExitValue(0);
+    }
+
+    public static void main(String[] args) throws Exception {
+        StringBuilder path = new StringBuilder();
+        for (int i = 0; i < 4; i++) {
+            File dir = new File("filler" + i + File.separator + "pkg" + i);
+            dir.mkdirs();
+            FileWriter w = new FileWriter(new File(dir, "readme.txt"));
+            w.write("filler");
+            w.close();
+            jar("cf", "filler" + i + ".jar", "-C", "filler" + i, ".");
+            path.append("filler" + i + ".jar" + File.pathSeparator);
+        }
+        String classes = System.getProperty("test.classes");
+        jar("cf", "target.jar", "-C", classes, "BootClassPathIndex$Target.class",
+            "-C", classes, "BootClassPathIndex$Helper.class");
+        path.append("target.jar");
+
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+            "-Xbootclasspath/a:" + path,
+            "-XX:BootClassPathIndexThreshold=1",
+            "BootClassPathIndex$Target");
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        output.shouldContain("Target done");
+        output.shouldHaveExitValue(0);
+    }
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test
+ * @summary ObjectAlignmentErgonomics raises the object alignment so that
+ *          compressed oops can be used with heaps above 32G
+ * @library /testlibrary
+ */
+
+import com.oracle.java.testlibrary.*;
+
+public class ObjectAlignmentErgonomics {
+
+    static OutputAnalyzer run(String... opts) throws Exception {
+        String[] args = new String[opts.length + 3];
+        args[0] = "-XX:+UnlockDiagnosticVMOptions";
+        args[1] = "-XX:+PrintCompressedOopsMode";
+        System.arraycopy(opts, 0, args, 2, opts.length);
+        args[args.length - 1] = "-version";
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(args);
+        return new OutputAnalyzer(pb.start());
+    }
+
+    public static void main(String[] args) throws Exception {
+        if (!Platform.is64bit()) {
+            System.out.println("Skipping test on 32bit");
+            return;
+        }
+
+        // Off by default: no compressed oops above 32G.
+        OutputAnalyzer output = run("-Xmx40g");
+        output.shouldNotContain("Compressed Oops mode");
+        output.shouldHaveExitValue(0);
+
+        output = run("-XX:+ObjectAlignmentErgonomics", "-Xmx40g");
+        output.shouldContain("ObjectAlignmentInBytes set to 16");
+        output.shouldContain("Oop shift amount: 4");
+        output.shouldHaveExitValue(0);
+
+        output = run("-XX:+ObjectAlignmentErgonomics", "-Xmx100g");
+        output.shouldContain("ObjectAlignmentInBytes set to 32");
+        output.shouldContain("Oop shift amount: 5");
+        output.shouldHaveExitValue(0);
+
+        // Small heaps keep the default alignment.
+        output = run("-XX:+ObjectAlignmentErgonomics", "-Xmx128m");
+        output.shouldNotContain("ObjectAlignmentInBytes set to");
+        output.shouldHaveExitValue(0);
+
+        // An explicit alignment is never changed.
+        output = run("-XX:+ObjectAlignmentErgonomics", "-XX:ObjectAlignmentInBytes=8", "-Xmx40g");
+        output.shouldNotContain("ObjectAlignmentInBytes set to");
+        output.shouldHaveExitValue(0);
+
+        // Beyond the reach of MaxErgoObjectAlignmentInBytes.
+        output = run("-XX:+ObjectAlignmentErgonomics", "-XX:MaxErgoObjectAlignmentInBytes=16", "-Xmx100g");
+        output.shouldNotContain("ObjectAlignmentInBytes set to");
+        output.shouldHaveExitValue(0);
+    }
+}
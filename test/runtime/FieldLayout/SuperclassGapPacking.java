@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+import java.lang.reflect.Field;
+import sun.misc.Unsafe;
+
+/*
+ * @test
+ * @summary Subclass fields are packed into the alignment gap after the
+ *          last superclass field with CompactFieldsIntoSuperclassGap
+ *
+ * @run main/othervm -XX:+CompactFieldsIntoSuperclassGap SuperclassGapPacking
+ */
+public class SuperclassGapPacking {
+
+    private static final Unsafe U;
+
+    static {
+        try {
+            Field unsafe = Unsafe.class.getDeclaredField("theUnsafe");
+            unsafe.setAccessible(true);
+            U = (Unsafe) unsafe.get(null);
+        } catch (NoSuchFieldException | IllegalAccessException e) {
+            throw new IllegalStateException(e);
+        }
+    }
+
+    static class B1 { byte a; }
+    static class B2 extends B1 { byte b; }
+    static class B3 extends B2 { boolean c; }
+
+    static class S1 { int pad; short s; }
+    static class S2 extends S1 { short t; }
+
+    static long offset(Class<?> c, String name) throws Exception {
+        return U.objectFieldOffset(c.getDeclaredField(name));
+    }
+
+    static void check(boolean cond, String msg) {
+        if (!cond) {
+            throw new RuntimeException(msg);
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        long a = offset(B1.class, "a");
+        long b = offset(B2.class, "b");
+        long c = offset(B3.class, "c");
+        check(b == a + 1, "B2.b at " + b + ", expected " + (a + 1));
+        check(c == a + 2, "B3.c at " + c + ", expected " + (a + 2));
+
+        long s = offset(S1.class, "s");
+        long t = offset(S2.class, "t");
+        if (s % 4 == 0) {
+            check(t == s + 2, "S2.t at " + t + ", expected " + (s + 2));
+        }
+
+        // Fields sharing a word must still be stored independently.
+        B3 o = new B3();
+        o.a = 1; o.b = 2; o.c = true;
+        check(o.a == 1 && o.b == 2 && o.c, "field values clobbered");
+        S2 p = new S2();
+        p.s = 0x1234; p.t = 0x5678;
+        check(p.s == 0x1234 && p.t == 0x5678, "field values clobbered");
+    }
+}
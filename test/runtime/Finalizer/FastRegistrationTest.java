@@ -0,0 +1,57 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test
+ * @summary Check that objects registered as finalizable by the VM are finalized
+ * @run main/othervm -XX:+UseFastFinalizerRegistration FastRegistrationTest
+ * @run main/othervm -XX:+UseFastFinalizerRegistration -XX:-RegisterFinalizersAtInit FastRegistrationTest
+ * @run main/othervm -XX:-UseFastFinalizerRegistration FastRegistrationTest
+ */
+
+import java.util.concurrent.atomic.AtomicInteger;
+
+public class FastRegistrationTest {
+    static final int COUNT = 100000;
+    static final AtomicInteger finalized = new AtomicInteger();
+
+    static class Finalizable {
+        protected void finalize() {
+            finalized.incrementAndGet();
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        for (int i = 0; i < COUNT; i++) {
+            new Finalizable();
+        }
+        for (int i = 0; i < 100 && finalized.get() < COUNT; i++) {
+            System.gc();
+            System.runFinalization();
+        }
+        if (finalized.get() != COUNT) {
+            throw new RuntimeException("Finalized " + finalized.get() + " of " + COUNT);
+        }
+    }
+}
@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test
+ * @summary Allocating with heap sampling enabled leaves a parsable heap
+ * @library /testlibrary
+ * @run main/othervm HeapSamplingInterval
+ */
+
+import com.oracle.java.testlibrary.OutputAnalyzer;
+import com.oracle.java.testlibrary.ProcessTools;
+
+public class HeapSamplingInterval {
+    public static class Worker {
+        static Object sink;
+
+        public static void main(String[] args) throws Exception {
+            for (int i = 0; i < 2000000; i++) {
+                sink = (i % 3 == 0) ? new int[i % 257] : new Object();
+                if (i % 1000 == 0) {
+                    sink = new Object[i % 4099];
+                }
+            }
+            System.gc();
+        }
+    }
+
+    private static void run(String... flags) throws Exception {
+        String[] args = new String[flags.length + 3];
+        args[0] = "-XX:HeapSamplingInterval=1024";
+        args[1] = "-XX:+UnlockDiagnosticVMOptions";
+        System.arraycopy(flags, 0, args, 2, flags.length);
+        args[args.length - 1] = Worker.class.getName();
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(args);
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        output.shouldHaveExitValue(0);
+    }
+
+    public static void main(String[] args) throws Exception {
+        run("-Xint", "-XX:+VerifyAfterGC");
+        run("-XX:+UseSerialGC", "-XX:+VerifyAfterGC");
+        run("-XX:+UseG1GC", "-XX:+VerifyAfterGC");
+        run("-XX:+UseParallelGC");
+    }
+}
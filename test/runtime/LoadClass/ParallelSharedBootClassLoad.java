@@ -0,0 +1,76 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test ParallelSharedBootClassLoad
+ * @summary Threads loading different shared boot classes at the same time all get consistent classes
+ * @run main/othervm -Xshare:auto ParallelSharedBootClassLoad
+ */
+
+import java.util.concurrent.CountDownLatch;
+
+public class ParallelSharedBootClassLoad {
+    static final String[] CLASSES = {
+        "java.util.concurrent.ConcurrentSkipListMap", "java.util.concurrent.ConcurrentSkipListSet",
+        "java.util.zip.Deflater", "java.util.zip.Inflater",
+        "java.text.SimpleDateFormat", "java.text.DecimalFormat",
+        "java.util.logging.Logger", "java.util.logging.Level",
+        "java.net.URLEncoder", "java.net.URLDecoder",
+        "java.util.regex.Pattern", "java.util.regex.Matcher",
+        "java.math.BigDecimal", "java.math.BigInteger",
+        "java.util.TreeMap", "java.util.TreeSet",
+    };
+
+    public static void main(String[] args) throws Exception {
+        final CountDownLatch start = new CountDownLatch(1);
+        final Class<?>[] loaded = new Class<?>[CLASSES.length * 2];
+        Thread[] threads = new Thread[loaded.length];
+        for (int i = 0; i < threads.length; i++) {
+            final int index = i;
+            threads[i] = new Thread() {
+                public void run() {
+                    try {
+                        start.await();
+                        loaded[index] = Class.forName(CLASSES[index % CLASSES.length]);
+                    } catch (Exception e) {
+                        throw new RuntimeException(e);
+                    }
+                }
+            };
+            threads[i].start();
+        }
+        start.countDown();
+        for (Thread t : threads) {
+            t.join();
+        }
+        for (int i = 0; i < CLASSES.length; i++) {
+            if (loaded[i] == null || loaded[i] != loaded[i + CLASSES.length]) {
+                throw new RuntimeException("Inconsistent load of " + CLASSES[i]);
+            }
+            if (loaded[i].getClassLoader() != null) {
+                throw new RuntimeException(CLASSES[i] + " not loaded by the boot loader");
+            }
+        }
+    }
+}
@@ -0,0 +1,83 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test ParallelDefineInOneLoader
+ * @summary Classes defined in parallel in one loader share its metaspace correctly
+ * @run main/othervm -Xverify:all ParallelDefineInOneLoader
+ */
+
+import java.io.File;
+import java.lang.reflect.Method;
+import java.net.URL;
+import java.net.URLClassLoader;
+import java.util.concurrent.CountDownLatch;
+
+public class ParallelDefineInOneLoader {
+    public static class C0 { public static String id() { return "C0"; } }
+    public static class C1 { public static String id() { return "C1"; } }
+    public static class C2 { public static String id() { return "C2"; } }
+    public static class C3 { public static String id() { return "C3"; } }
+    public static class C4 { public static String id() { return "C4"; } }
+    public static class C5 { public static String id() { return "C5"; } }
+    public static class C6 { public static String id() { return "C6"; } }
+    public static class C7 { public static String id() { return "C7"; } }
+
+    public static void main(String[] args) throws Exception {
+        URL[] urls = { new File(System.getProperty("test.classes", ".")).toURI().toURL() };
+        for (int round = 0; round < 20; round++) {
+            // URLClassLoader is parallel capable, so all threads define at once
+            final URLClassLoader loader = new URLClassLoader(urls, null);
+            final CountDownLatch start = new CountDownLatch(1);
+            final Throwable[] failure = new Throwable[1];
+            Thread[] threads = new Thread[8];
+            for (int i = 0; i < threads.length; i++) {
+                final String name = "C" + i;
+                threads[i] = new Thread() {
+                    public void run() {
+                        try {
+                            start.await();
+                            Class<?> c = loader.loadClass("ParallelDefineInOneLoader$" + name);
+                            Method m = c.getMethod("id");
+                            if (!name.equals(m.invoke(null))) {
+                                throw new RuntimeException("Wrong class for " + name);
+                            }
+                        } catch (Throwable t) {
+                            failure[0] = t;
+                        }
+                    }
+                };
+                threads[i].start();
+            }
+            start.countDown();
+            for (Thread t : threads) {
+                t.join();
+            }
+            if (failure[0] != null) {
+                throw new RuntimeException(failure[0]);
+            }
+            loader.close();
+        }
+    }
+}
@@ -0,0 +1,55 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test
+ * @summary Inflate and release many monitors with delayed deflation
+ * @run main/othervm -XX:MonitorDeflationInterval=200 MonitorDeflationIntervalTest
+ * @run main/othervm -XX:MonitorDeflationInterval=200 -XX:+MonitorInUseLists MonitorDeflationIntervalTest
+ * @run main/othervm -XX:MonitorDeflationInterval=200 -XX:MonitorBound=1000 MonitorDeflationIntervalTest
+ */
+
+public class MonitorDeflationIntervalTest {
+    private static final int OBJECTS = 20000;
+
+    public static void main(String[] args) throws Exception {
+        for (int round = 0; round < 5; round++) {
+            Object[] locks = new Object[OBJECTS];
+            for (int i = 0; i < OBJECTS; i++) {
+                locks[i] = new Object();
+                synchronized (locks[i]) {
+                    // wait() always inflates the monitor
+                    locks[i].wait(0, 1);
+                }
+            }
+            // Deflation of the idle monitors happens at some later safepoint
+            System.gc();
+            for (Object lock : locks) {
+                synchronized (lock) {
+                    lock.notify();
+                }
+            }
+        }
+    }
+}
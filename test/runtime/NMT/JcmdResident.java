@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test
+ * @key nmt jcmd
+ * @summary VM.native_memory resident reports the resident part of the committed memory
+ * @requires os.family == "linux"
+ * @library /testlibrary /testlibrary/whitebox
+ * @build JcmdResident
+ * @run main ClassFileInstaller sun.hotspot.WhiteBox
+ * @run main/othervm -Xbootclasspath/a:. -XX:+UnlockDiagnosticVMOptions -XX:+WhiteBoxAPI -XX:NativeMemoryTracking=summary JcmdResident
+ */
+
+import com.oracle.java.testlibrary.*;
+
+import sun.hotspot.WhiteBox;
+
+public class JcmdResident {
+
+    public static WhiteBox wb = WhiteBox.getWhiteBox();
+
+    public static void main(String args[]) throws Exception {
+        ProcessBuilder pb = new ProcessBuilder();
+        OutputAnalyzer output;
+        // Grab my own PID
+        String pid = Integer.toString(ProcessTools.getProcessId());
+
+        long addr = wb.NMTReserveMemory(256 * 1024);
+        // Committed but never touched, so nothing of it is resident
+        wb.NMTCommitMemory(addr, 128 * 1024);
+
+        // Run 'jcmd <pid> VM.native_memory resident scale=KB'
+        pb.command(new String[] { JDKToolFinder.getJDKTool("jcmd"), pid, "VM.native_memory", "resident", "scale=KB"});
+        output = new OutputAnalyzer(pb.start());
+        output.shouldContain("Resident Memory:");
+        output.shouldContain("Test (committed=128KB, resident=0KB)");
+        output.shouldMatch("Java Heap \\(committed=\\d+KB, resident=\\d+KB\\)");
+        output.shouldMatch("Total: committed=\\d+KB, resident=\\d+KB");
+
+        wb.NMTReleaseMemory(addr, 256 * 1024);
+    }
+}
@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test TestPerfDataHistograms
+ * @summary The PerfData histograms count every GC pause and safepoint
+ * @library /testlibrary
+ * @run main/othervm -XX:+UsePerfData -XX:+PerfDataHistograms -XX:+UseSerialGC TestPerfDataHistograms
+ */
+
+import com.oracle.java.testlibrary.*;
+import static com.oracle.java.testlibrary.Asserts.*;
+
+public class TestPerfDataHistograms {
+
+    // Returns the number of values in the buckets
+    static long checkHistogram(String name, int buckets) throws Exception {
+        assertGT(PerfCounters.findByName(name + ".unit").longValue(), 0L);
+        long sum = 0;
+        for (int i = 0; i < buckets; i++) {
+            sum += PerfCounters.findByName(name + ".bucket." + i).longValue();
+        }
+        return sum;
+    }
+
+    public static void main(String[] args) throws Exception {
+        for (int i = 0; i < 10; i++) {
+            System.gc();
+        }
+
+        // Nothing else collects, so the counts are stable
+        long fullGCs = checkHistogram("sun.gc.collector.1.pauseHistogram", 20);
+        assertGTE(fullGCs, 10L, "Full GCs not recorded");
+        assertEQ(fullGCs, PerfCounters.findByName("sun.gc.collector.1.pauseHistogram.count").longValue());
+        assertEQ(fullGCs, PerfCounters.findByName("sun.gc.collector.1.invocations").longValue());
+
+        assertGTE(checkHistogram("sun.rt.safepointTimeHistogram", 20), 10L);
+        assertGTE(checkHistogram("sun.rt.safepointSyncTimeHistogram", 20), 10L);
+        checkHistogram("sun.ci.compileTimeHistogram", 20);
+    }
+}
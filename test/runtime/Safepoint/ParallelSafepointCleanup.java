@@ -0,0 +1,63 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test
+ * @summary Safepoint cleanup tasks run and are timed with and without the GC worker gang
+ * @library /testlibrary
+ * @run main/othervm ParallelSafepointCleanup
+ */
+
+import com.oracle.java.testlibrary.OutputAnalyzer;
+import com.oracle.java.testlibrary.ProcessTools;
+
+public class ParallelSafepointCleanup {
+    public static class Worker {
+        public static void main(String[] args) throws Exception {
+            for (int i = 0; i < 5; i++) {
+                System.gc();
+            }
+        }
+    }
+
+    private static void test(String... flags) throws Exception {
+        String[] args = new String[flags.length + 2];
+        System.arraycopy(flags, 0, args, 0, flags.length);
+        args[flags.length] = "-XX:+TraceSafepointCleanupTime";
+        args[flags.length + 1] = Worker.class.getName();
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(args);
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        output.shouldHaveExitValue(0);
+        output.shouldMatch("\\[updating inline caches, [0-9.]+ secs\\]");
+        output.shouldMatch("\\[compilation policy safepoint handler, [0-9.]+ secs\\]");
+        output.shouldMatch("\\[purging class loader data graph, [0-9.]+ secs\\]");
+    }
+
+    public static void main(String[] args) throws Exception {
+        test("-XX:+UseG1GC", "-XX:ParallelGCThreads=4", "-XX:+ParallelSafepointCleanup");
+        test("-XX:+UseG1GC", "-XX:-ParallelSafepointCleanup");
+        test("-XX:+UseSerialGC", "-XX:+ParallelSafepointCleanup");
+        test("-XX:+UseParallelGC", "-XX:+ParallelSafepointCleanup");
+    }
+}
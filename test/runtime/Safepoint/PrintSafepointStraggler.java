@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test
+ * @summary PrintSafepointStraggler reports the last thread to reach a safepoint
+ * @library /testlibrary
+ * @run main/othervm PrintSafepointStraggler
+ */
+
+import com.oracle.java.testlibrary.OutputAnalyzer;
+import com.oracle.java.testlibrary.ProcessTools;
+
+public class PrintSafepointStraggler {
+    public static class Worker {
+        static volatile boolean done;
+        static long sink;
+
+        public static void main(String[] args) throws Exception {
+            Thread spinner = new Thread("StragglerSpinner") {
+                public void run() {
+                    long sum = 0;
+                    while (!done) {
+                        for (int i = 0; i < 100000; i++) {
+                            sum += i ^ sum;
+                        }
+                    }
+                    sink = sum;
+                }
+            };
+            spinner.start();
+            for (int i = 0; i < 10; i++) {
+                System.gc();
+                Thread.sleep(10);
+            }
+            done = true;
+            spinner.join();
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+            "-XX:+PrintSafepointStraggler",
+            Worker.class.getName());
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        output.shouldHaveExitValue(0);
+        output.shouldMatch("Safepoint \".*\", time to safepoint [0-9.]+ ms, last thread to arrive \".*\"");
+    }
+}
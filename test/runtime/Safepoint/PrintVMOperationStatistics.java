@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test
+ * @summary PrintVMOperationStatistics reports the evaluated VM operations at exit
+ * @library /testlibrary
+ * @run main/othervm PrintVMOperationStatistics
+ */
+
+import com.oracle.java.testlibrary.OutputAnalyzer;
+import com.oracle.java.testlibrary.ProcessTools;
+
+public class PrintVMOperationStatistics {
+    public static class Worker {
+        public static void main(String[] args) throws Exception {
+            // Several threads asking for thread dumps at the same time queue
+            // up safepoint operations that the VM thread can batch.
+            Thread[] threads = new Thread[8];
+            for (int i = 0; i < threads.length; i++) {
+                threads[i] = new Thread() {
+                    public void run() {
+                        for (int j = 0; j < 50; j++) {
+                            Thread.getAllStackTraces();
+                        }
+                    }
+                };
+                threads[i].start();
+            }
+            for (Thread t : threads) {
+                t.join();
+            }
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+            "-XX:+PrintVMOperationStatistics",
+            Worker.class.getName());
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        output.shouldHaveExitValue(0);
+        output.shouldContain("VM operation statistics:");
+        output.shouldMatch("ThreadDump +[0-9]+ +[0-9]+ +[0-9]+us");
+        output.shouldMatch("[0-9]+ VM operations, [0-9]+ safepoints begun for them, [0-9]+ coalesced, at most [0-9]+ in one safepoint");
+    }
+}
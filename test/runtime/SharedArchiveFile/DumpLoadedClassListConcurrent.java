@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test DumpLoadedClassListConcurrent
+ * @summary A class list recorded while classes load concurrently is usable for -Xshare:dump
+ * @library /testlibrary
+ * @run main DumpLoadedClassListConcurrent
+ */
+
+import java.nio.file.Files;
+import java.nio.file.Paths;
+import com.oracle.java.testlibrary.*;
+
+public class DumpLoadedClassListConcurrent {
+    static final String[] CLASSES = {
+        "java.util.concurrent.ConcurrentSkipListMap", "java.util.zip.Deflater",
+        "java.text.SimpleDateFormat", "java.util.logging.Logger",
+        "java.net.URLEncoder", "java.util.regex.Pattern",
+        "java.math.BigDecimal", "java.util.TreeMap",
+    };
+
+    public static class Loader {
+        public static void main(String[] args) throws Exception {
+            Thread[] threads = new Thread[CLASSES.length];
+            for (int i = 0; i < threads.length; i++) {
+                final String name = CLASSES[i];
+                threads[i] = new Thread() {
+                    public void run() {
+                        try {
+                            Class.forName(name);
+                        } catch (ClassNotFoundException e) {
+                            throw new RuntimeException(e);
+                        }
+                    }
+                };
+                threads[i].start();
+            }
+            for (Thread t : threads) {
+                t.join();
+            }
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        ProcessBuilder pb = ProcessTools.createJavaProcessBuilder(
+            "-XX:DumpLoadedClassList=./concurrent.classlist",
+            "-cp", System.getProperty("test.classes"),
+            Loader.class.getName());
+        new OutputAnalyzer(pb.start()).shouldHaveExitValue(0);
+
+        for (String line : Files.readAllLines(Paths.get("concurrent.classlist"))) {
+            if (!line.matches("[\\w/$]+")) {
+                throw new RuntimeException("Malformed class list entry: \"" + line + "\"");
+            }
+        }
+
+        pb = ProcessTools.createJavaProcessBuilder(
+            "-XX:+UnlockDiagnosticVMOptions",
+            "-XX:SharedArchiveFile=./concurrent.jsa",
+            "-XX:SharedClassListFile=./concurrent.classlist",
+            "-Xshare:dump");
+        OutputAnalyzer output = new OutputAnalyzer(pb.start());
+        output.shouldContain("Loading classes to share");
+        output.shouldHaveExitValue(0);
+    }
+}
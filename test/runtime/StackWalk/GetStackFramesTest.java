@@ -0,0 +1,111 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test
+ * @summary Test the partial stack walk of JVM_GetStackFrames
+ * @library /testlibrary /testlibrary/whitebox
+ * @build GetStackFramesTest
+ * @run main ClassFileInstaller sun.hotspot.WhiteBox
+ * @run main/othervm -Xbootclasspath/a:. -XX:+UnlockDiagnosticVMOptions -XX:+WhiteBoxAPI GetStackFramesTest
+ */
+
+import java.lang.reflect.Method;
+import sun.hotspot.WhiteBox;
+
+public class GetStackFramesTest {
+    static final WhiteBox WB = WhiteBox.getWhiteBox();
+
+    static void check(boolean condition, String message) {
+        if (!condition) {
+            throw new RuntimeException(message);
+        }
+    }
+
+    static class Callee {
+        // Frame 0 is this method, frame 1 its caller
+        static StackTraceElement[] walk(int skip, int flags, int count) {
+            Class<?>[] classes = new Class<?>[count];
+            StackTraceElement[] elements = new StackTraceElement[count];
+            int[] bcis = new int[count];
+            int n = WB.getStackFrames(skip, flags, classes, elements, bcis);
+            StackTraceElement[] result = new StackTraceElement[n];
+            for (int i = 0; i < n; i++) {
+                check(classes[i].getName().equals(elements[i].getClassName()),
+                      classes[i] + " does not match " + elements[i]);
+                check(bcis[i] >= 0, "bad bci " + bcis[i]);
+                result[i] = elements[i];
+            }
+            return result;
+        }
+    }
+
+    static StackTraceElement[] direct() {
+        return Callee.walk(1, 0, 2);
+    }
+
+    public static StackTraceElement[] reflective(int flags) throws Exception {
+        Method m = GetStackFramesTest.class.getMethod("reflected", int.class);
+        return (StackTraceElement[]) m.invoke(null, flags);
+    }
+
+    public static StackTraceElement[] reflected(int flags) {
+        return Callee.walk(1, flags, 2);
+    }
+
+    public static void main(String[] args) throws Exception {
+        StackTraceElement[] frames = Callee.walk(0, 0, 1);
+        check(frames.length == 1 && frames[0].getMethodName().equals("walk"),
+              "frame 0 should be walk");
+
+        frames = direct();
+        check(frames.length == 2, "expected 2 frames, got " + frames.length);
+        check(frames[0].getMethodName().equals("direct"), "frame 1 should be direct");
+        check(frames[1].getMethodName().equals("main"), "frame 2 should be main");
+
+        // Only as many frames as fit the arrays are returned
+        check(Callee.walk(0, 0, 0).length == 0, "expected no frames");
+        check(Callee.walk(1000000, 0, 4).length == 0, "expected no frames past the bottom");
+
+        frames = reflective(0);
+        check(frames[0].getMethodName().equals("reflected"), "frame 1 should be reflected");
+        check(!frames[1].getMethodName().equals("reflective"),
+              "reflection frames should not be skipped");
+        frames = reflective(WhiteBox.STACKWALK_SKIP_REFLECTION);
+        check(frames[0].getMethodName().equals("reflected"), "frame 1 should be reflected");
+        check(frames[1].getMethodName().equals("reflective"),
+              "reflection frames should be skipped, got " + frames[1]);
+
+        try {
+            WB.getStackFrames(-1, 0, null, null, new int[1]);
+            throw new RuntimeException("negative skip accepted");
+        } catch (IllegalArgumentException e) {
+        }
+        try {
+            WB.getStackFrames(0, 0, null, null, null);
+            throw new RuntimeException("no arrays accepted");
+        } catch (NullPointerException e) {
+        }
+    }
+}
@@ -0,0 +1,93 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test
+ * @summary Exercise park/unpark, timeouts and interrupts with the futex parker
+ * @requires os.family == "linux"
+ * @run main/othervm -XX:+UseFutexParker FutexParkerTest
+ * @run main/othervm -XX:+UseFutexParker -XX:FutexParkerSpinLimit=0 FutexParkerTest
+ */
+
+import java.util.concurrent.TimeUnit;
+import java.util.concurrent.atomic.AtomicInteger;
+import java.util.concurrent.locks.LockSupport;
+
+public class FutexParkerTest {
+    static final int ROUNDS = 100000;
+
+    // Two threads hand a token back and forth, parking while the other has it
+    static void pingPong() throws Exception {
+        final AtomicInteger turn = new AtomicInteger();
+        final Thread[] threads = new Thread[2];
+        for (int t = 0; t < 2; t++) {
+            final int me = t;
+            threads[t] = new Thread() {
+                public void run() {
+                    for (int i = 0; i < ROUNDS; i++) {
+                        while (turn.get() != me) {
+                            LockSupport.park();
+                        }
+                        turn.set(1 - me);
+                        LockSupport.unpark(threads[1 - me]);
+                    }
+                }
+            };
+        }
+        threads[0].start();
+        threads[1].start();
+        threads[0].join();
+        threads[1].join();
+    }
+
+    public static void main(String[] args) throws Exception {
+        pingPong();
+
+        // A permit given before park is consumed without blocking
+        LockSupport.unpark(Thread.currentThread());
+        long start = System.nanoTime();
+        LockSupport.parkNanos(TimeUnit.SECONDS.toNanos(60));
+        if (System.nanoTime() - start > TimeUnit.SECONDS.toNanos(30)) {
+            throw new RuntimeException("park did not consume the permit");
+        }
+
+        // Timed parks return, relative and absolute
+        LockSupport.parkNanos(TimeUnit.MILLISECONDS.toNanos(50));
+        LockSupport.parkUntil(System.currentTimeMillis() + 50);
+        LockSupport.parkUntil(System.currentTimeMillis() - 1000);
+
+        // An interrupt wakes a parked thread
+        Thread parked = new Thread() {
+            public void run() {
+                while (!Thread.currentThread().isInterrupted()) {
+                    LockSupport.park();
+                }
+            }
+        };
+        parked.start();
+        Thread.sleep(100);
+        parked.interrupt();
+        parked.join();
+    }
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test TestThreadStackCache
+ * @summary Threads that run on a reused stack must still get a StackOverflowError
+ * @requires os.family == "linux"
+ * @run main/othervm -XX:ThreadStackCacheSize=4 -Xss512k TestThreadStackCache
+ */
+
+public class TestThreadStackCache {
+    static volatile int depth;
+
+    static void recurse() {
+        depth++;
+        recurse();
+    }
+
+    public static void main(String[] args) throws Exception {
+        for (int i = 0; i < 200; i++) {
+            final boolean[] overflowed = new boolean[1];
+            Thread t = new Thread(new Runnable() {
+                public void run() {
+                    try {
+                        recurse();
+                    } catch (StackOverflowError e) {
+                        overflowed[0] = true;
+                    }
+                }
+            });
+            t.start();
+            t.join();
+            if (!overflowed[0]) {
+                throw new RuntimeException("No StackOverflowError in thread " + i);
+            }
+        }
+
+        // Many short-lived threads at once, more than the cache keeps.
+        Thread[] threads = new Thread[64];
+        for (int round = 0; round < 10; round++) {
+            for (int i = 0; i < threads.length; i++) {
+                threads[i] = new Thread();
+                threads[i].start();
+            }
+            for (int i = 0; i < threads.length; i++) {
+                threads[i].join();
+            }
+        }
+    }
+}
@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test
+ * @summary ThreadMXBean lookups of many thread ids return the right threads
+ * @run main/othervm ThreadInfoManyIds
+ */
+
+import java.lang.management.ManagementFactory;
+import java.lang.management.ThreadInfo;
+import java.util.concurrent.CountDownLatch;
+
+public class ThreadInfoManyIds {
+    static final int THREADS = 50;
+
+    public static void main(String[] args) throws Exception {
+        final CountDownLatch done = new CountDownLatch(1);
+        Thread[] threads = new Thread[THREADS];
+        long[] ids = new long[THREADS + 2];
+        for (int i = 0; i < THREADS; i++) {
+            threads[i] = new Thread("ThreadInfoManyIds-" + i) {
+                public void run() {
+                    try {
+                        done.await();
+                    } catch (InterruptedException e) {
+                    }
+                }
+            };
+            threads[i].start();
+        }
+        // Look the ids up in reverse order, with an exited and a bogus id
+        for (int i = 0; i < THREADS; i++) {
+            ids[i] = threads[THREADS - 1 - i].getId();
+        }
+        Thread exited = new Thread();
+        exited.start();
+        exited.join();
+        ids[THREADS] = exited.getId();
+        ids[THREADS + 1] = Long.MAX_VALUE;
+
+        com.sun.management.ThreadMXBean mbean =
+            (com.sun.management.ThreadMXBean) ManagementFactory.getThreadMXBean();
+        for (int depth : new int[] { 0, 1 }) {
+            ThreadInfo[] infos = mbean.getThreadInfo(ids, depth);
+            for (int i = 0; i < THREADS; i++) {
+                String expected = "ThreadInfoManyIds-" + (THREADS - 1 - i);
+                if (infos[i] == null || !infos[i].getThreadName().equals(expected)) {
+                    throw new RuntimeException("Wrong ThreadInfo for " + expected + ": " + infos[i]);
+                }
+            }
+            if (infos[THREADS] != null || infos[THREADS + 1] != null) {
+                throw new RuntimeException("ThreadInfo for a thread that is not alive");
+            }
+        }
+        long[] cpu = mbean.getThreadCpuTime(ids);
+        long[] allocated = mbean.getThreadAllocatedBytes(ids);
+        if (cpu[THREADS + 1] != -1 || allocated[THREADS + 1] != -1) {
+            throw new RuntimeException("Values for a thread that is not alive");
+        }
+        done.countDown();
+        for (Thread t : threads) {
+            t.join();
+        }
+    }
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test
+ * @summary Check that backtraces deeper and shallower than a backtrace
+ *          chunk are recorded completely and in order
+ * @run main/othervm -Xint StackTraceDepthTest
+ * @run main/othervm -Xcomp -XX:CompileCommand=exclude,StackTraceDepthTest.main StackTraceDepthTest
+ * @run main/othervm -XX:MaxJavaStackTraceDepth=40 StackTraceDepthTest 40
+ */
+
+public class StackTraceDepthTest {
+    static Throwable recurse(int n) {
+        if (n == 0) {
+            return new Throwable();
+        }
+        return recurse(n - 1);
+    }
+
+    static void check(int frames, int maxDepth) throws Exception {
+        // check and its callers
+        int callers = new Throwable().getStackTrace().length;
+        StackTraceElement[] trace = recurse(frames).getStackTrace();
+        int expected = Math.min(frames + 1 + callers, maxDepth);
+        if (trace.length != expected) {
+            throw new Exception("Expected " + expected + " frames, got " + trace.length);
+        }
+        for (int i = 0; i < Math.min(frames + 2, trace.length); i++) {
+            String name = i <= frames ? "recurse" : "check";
+            if (!trace[i].getMethodName().equals(name)) {
+                throw new Exception("Frame " + i + " is " + trace[i] + ", expected " + name);
+            }
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        int maxDepth = args.length > 0 ? Integer.parseInt(args[0]) : Integer.MAX_VALUE;
+        for (int frames : new int[] { 0, 5, 30, 31, 32, 100, 500 }) {
+            check(frames, maxDepth);
+        }
+    }
+}
@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test QuickenedFieldAccess
+ * @summary Repeated field accesses run through the quickened getfield/putfield bytecodes
+ * @run main/othervm -Xint QuickenedFieldAccess
+ * @run main/othervm -Xint -XX:-RewriteBytecodes QuickenedFieldAccess
+ */
+public class QuickenedFieldAccess {
+    boolean z;
+    byte b;
+    char c;
+    short s;
+    int i;
+    long l;
+    float f;
+    double d;
+    Object o;
+    volatile long vl;
+
+    static void check(boolean ok, String what) {
+        if (!ok) {
+            throw new RuntimeException("wrong value read back for " + what);
+        }
+    }
+
+    static void update(QuickenedFieldAccess a, int n) {
+        a.z = (n & 1) != 0;
+        a.b = (byte) n;
+        a.c = (char) n;
+        a.s = (short) n;
+        a.i = n;
+        a.l = 1L << 40 | n;
+        a.f = n * 0.5f;
+        a.d = n * 0.25;
+        a.o = a;
+        a.vl = n;
+    }
+
+    static void verify(QuickenedFieldAccess a, int n) {
+        check(a.z == ((n & 1) != 0), "boolean");
+        check(a.b == (byte) n, "byte");
+        check(a.c == (char) n, "char");
+        check(a.s == (short) n, "short");
+        check(a.i == n, "int");
+        check(a.l == (1L << 40 | n), "long");
+        check(a.f == n * 0.5f, "float");
+        check(a.d == n * 0.25, "double");
+        check(a.o == a, "Object");
+        check(a.vl == n, "volatile long");
+    }
+
+    public static void main(String[] args) {
+        QuickenedFieldAccess a = new QuickenedFieldAccess();
+        for (int n = 0; n < 1000; n++) {
+            update(a, n);
+            verify(a, n);
+        }
+        try {
+            verify(null, 0);
+            throw new RuntimeException("NullPointerException expected");
+        } catch (NullPointerException e) {
+            // expected
+        }
+    }
+}
@@ -0,0 +1,71 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test
+ * @summary The fused iload,iload,iadd interpreter template must compute the same results
+ * @run main/othervm -Xint TestFastIload2Iadd
+ * @run main/othervm -Xint -XX:-RewriteFrequentPairs TestFastIload2Iadd
+ */
+public class TestFastIload2Iadd {
+  // javac emits iload,iload,iadd for a + b with non-constant locals
+  static int add(int a, int b) {
+    int c = a + b;
+    int d = c + a;
+    int e = b + c;
+    return d + e;
+  }
+
+  // iload,iload followed by something else than iadd
+  static int sub(int a, int b) {
+    int c = a - b;
+    return c + b;
+  }
+
+  static int wideLocals(int a0, int a1, int a2, int a3, int a4, int a5, int a6, int a7) {
+    int x = a6 + a7;
+    int y = a0 + a5;
+    return x + y;
+  }
+
+  public static void main(String[] args) {
+    int[] values = { 0, 1, -1, 42, Integer.MAX_VALUE, Integer.MIN_VALUE, 123456789 };
+    for (int iter = 0; iter < 3; iter++) {   // first pass executes before the rewrite
+      for (int a : values) {
+        for (int b : values) {
+          int expected = 3 * a + 3 * b;
+          if (add(a, b) != expected) {
+            throw new RuntimeException("add(" + a + ", " + b + ") = " + add(a, b) + " != " + expected);
+          }
+          if (sub(a, b) != a) {
+            throw new RuntimeException("sub(" + a + ", " + b + ") = " + sub(a, b));
+          }
+          if (wideLocals(a, 0, 0, 0, 0, b, a, b) != a + b + a + b) {
+            throw new RuntimeException("wideLocals(" + a + ", " + b + ")");
+          }
+        }
+      }
+    }
+  }
+}
@@ -0,0 +1,64 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test
+ * @summary Interpreted invokeinterface must select the right method whether or not
+ *          the referenced interface declares it
+ * @run main/othervm -Xint TestInterpretedInvokeInterface
+ */
+public class TestInterpretedInvokeInterface {
+  interface Base { int base(); }
+  interface Derived extends Base { int derived(); }
+  interface Other { int other(); }
+
+  static class A implements Derived, Other {
+    public int base()    { return 1; }
+    public int derived() { return 2; }
+    public int other()   { return 3; }
+  }
+  static class B extends A {
+    public int base()    { return 10; }
+    public int derived() { return 20; }
+  }
+
+  public static void main(String[] args) {
+    Derived[] receivers = { new A(), new B() };
+    for (int i = 0; i < 100000; i++) {
+      Derived d = receivers[i & 1];
+      int expected = (i & 1) == 0 ? 1 : 10;
+      // REFC is Derived, the method is declared in Base
+      if (d.base() != expected) {
+        throw new RuntimeException("wrong method for base()");
+      }
+      // REFC is the declaring interface
+      if (d.derived() != 2 * expected) {
+        throw new RuntimeException("wrong method for derived()");
+      }
+      if (((Other) d).other() != 3) {
+        throw new RuntimeException("wrong method for other()");
+      }
+    }
+  }
+}
@@ -0,0 +1,58 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test TestOopMapCacheSize
+ * @summary Interpreted frames are scanned correctly with small and large oop map caches
+ * @library /testlibrary
+ * @run main/othervm -Xint -XX:OopMapCacheSize=1 TestOopMapCacheSize
+ * @run main/othervm -Xint -XX:OopMapCacheSize=4096 TestOopMapCacheSize
+ * @run main TestOopMapCacheSize launcher
+ */
+
+import com.oracle.java.testlibrary.*;
+
+public class TestOopMapCacheSize {
+    static int a(Object o, int i) { return i == 0 ? gc(o) : b(new Object[] { o }, i - 1); }
+    static int b(Object[] o, int i) { return i == 0 ? gc(o) : c(o.toString(), i - 1); }
+    static int c(String s, int i) { return i == 0 ? gc(s) : a(s, i - 1); }
+
+    static int gc(Object o) {
+        System.gc();
+        return o.hashCode() != 0 ? 1 : 0;
+    }
+
+    public static void main(String[] args) throws Exception {
+        if (args.length > 0) {
+            ProcessBuilder pb = ProcessTools.createJavaProcessBuilder("-XX:OopMapCacheSize=0", "-version");
+            OutputAnalyzer output = new OutputAnalyzer(pb.start());
+            output.shouldContain("OopMapCacheSize");
+            output.shouldHaveExitValue(1);
+            return;
+        }
+        for (int i = 0; i < 100; i++) {
+            a(new Object(), i);
+        }
+    }
+}
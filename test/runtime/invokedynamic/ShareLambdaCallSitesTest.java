@@ -0,0 +1,67 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test
+ * @summary Check lambda and method reference call sites linked with ShareLambdaCallSites
+ * @run main/othervm -XX:+ShareLambdaCallSites ShareLambdaCallSitesTest
+ * @run main/othervm -XX:-ShareLambdaCallSites ShareLambdaCallSitesTest
+ */
+
+import java.util.function.Function;
+import java.util.function.Supplier;
+
+public class ShareLambdaCallSitesTest {
+    static void check(boolean condition, String message) {
+        if (!condition) {
+            throw new RuntimeException(message);
+        }
+    }
+
+    public static void main(String[] args) {
+        // The same method reference twice may share a constant pool entry
+        Function<String, Integer> f1 = String::length;
+        Function<String, Integer> f2 = String::length;
+        check(f1.apply("abc") == 3 && f2.apply("abcd") == 4, "wrong String::length");
+
+        // Capturing method references must each keep their own receiver
+        String a = "a", b = "bb";
+        Supplier<Integer> s1 = a::length;
+        Supplier<Integer> s2 = b::length;
+        check(s1.get() == 1 && s2.get() == 2, "captured receivers mixed up");
+
+        // Distinct lambdas stay distinct
+        Supplier<String> l1 = () -> "one";
+        Supplier<String> l2 = () -> "two";
+        check(l1.get().equals("one") && l2.get().equals("two"), "lambdas mixed up");
+
+        // One site linked repeatedly from a loop
+        int sum = 0;
+        for (int i = 0; i < 10; i++) {
+            Function<String, Integer> f = String::length;
+            sum += f.apply("xy");
+        }
+        check(sum == 20, "wrong sum " + sum);
+    }
+}
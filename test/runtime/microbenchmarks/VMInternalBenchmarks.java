@@ -0,0 +1,88 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test VMInternalBenchmarks
+ * @summary Microbenchmarks of VM-internal operations, reporting one
+ *          "benchmark,<name>,<ns/op>" line per operation
+ * @library /testlibrary /testlibrary/whitebox
+ * @build VMInternalBenchmarks ClassFileInstaller sun.hotspot.WhiteBox
+ * @run main ClassFileInstaller sun.hotspot.WhiteBox
+ *                              sun.hotspot.WhiteBox$WhiteBoxPermission
+ * @run main/othervm -Xbootclasspath/a:. -XX:+UnlockDiagnosticVMOptions
+ *                   -XX:+WhiteBoxAPI -Xmx64m VMInternalBenchmarks
+ */
+
+import sun.hotspot.WhiteBox;
+
+public class VMInternalBenchmarks {
+    private static final WhiteBox WB = WhiteBox.getWhiteBox();
+
+    // Scale with -Dbenchmark.iterations=N when measuring rather than testing.
+    private static final int ITERATIONS = Integer.getInteger("benchmark.iterations", 100_000);
+
+    static volatile Object sink;
+
+    static void report(String name, long nanos, long ops) {
+        if (nanos <= 0) {
+            throw new RuntimeException(name + ": elapsed time should be positive, got " + nanos);
+        }
+        System.out.printf("benchmark,%s,%.2f%n", name, (double) nanos / ops);
+    }
+
+    static long safepoints(int count) {
+        long start = System.nanoTime();
+        for (int i = 0; i < count; i++) {
+            WB.forceSafepoint();
+        }
+        return System.nanoTime() - start;
+    }
+
+    // Allocates well past the TLAB size so the loop keeps refilling TLABs.
+    static long allocations(int count) {
+        long start = System.nanoTime();
+        for (int i = 0; i < count; i++) {
+            sink = new byte[1024];
+        }
+        return System.nanoTime() - start;
+    }
+
+    public static void main(String[] args) {
+        // The first round warms up the code paths, only the second is reported.
+        for (int round = 0; round < 2; round++) {
+            long queue = WB.benchmarkTaskQueue(ITERATIONS / 64);
+            long symbol = WB.benchmarkSymbolLookup("java/lang/Object", ITERATIONS);
+            long monitor = WB.benchmarkMonitorEnterExit(new Object(), ITERATIONS);
+            long alloc = allocations(ITERATIONS);
+            long safepoint = safepoints(ITERATIONS / 1000);
+            if (round == 1) {
+                report("taskqueue.push-pop-steal", queue, (ITERATIONS / 64) * 128L);
+                report("symboltable.probe", symbol, ITERATIONS);
+                report("monitor.enter-exit", monitor, ITERATIONS);
+                report("tlab.allocate-1k", alloc, ITERATIONS);
+                report("safepoint.sync", safepoint, ITERATIONS / 1000);
+            }
+        }
+    }
+}
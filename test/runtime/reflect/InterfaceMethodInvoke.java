@@ -0,0 +1,95 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test
+ * @summary Native reflective invocation of interface methods selects the
+ *          implementation from the receiver's itable
+ * @run main/othervm -Dsun.reflect.inflationThreshold=2147483647 InterfaceMethodInvoke
+ */
+
+import java.lang.reflect.InvocationTargetException;
+import java.lang.reflect.Method;
+
+public class InterfaceMethodInvoke {
+    interface I {
+        int m(int x);
+        default int d(int x) { return x + 100; }
+    }
+
+    interface J extends I {
+        default int d(int x) { return x + 200; }
+    }
+
+    public static class A implements I {
+        public int m(int x) { return x + 1; }
+    }
+
+    public static class B extends A {
+        public int m(int x) { return x + 2; }
+        public int d(int x) { return x + 300; }
+    }
+
+    public static class C extends A implements J {
+    }
+
+    public static class E implements I {
+        public int m(int x) { throw new IllegalStateException("E.m"); }
+    }
+
+    static void check(int expected, int actual) {
+        if (expected != actual) {
+            throw new RuntimeException("expected " + expected + ", got " + actual);
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        Method m = I.class.getMethod("m", int.class);
+        Method d = I.class.getMethod("d", int.class);
+        Object[] objs = { new A(), new B(), new C() };
+        int[] expectedM = { 1, 2, 1 };
+        int[] expectedD = { 100, 300, 200 };
+        for (int iter = 0; iter < 10000; iter++) {
+            for (int i = 0; i < objs.length; i++) {
+                check(expectedM[i] + iter, (Integer) m.invoke(objs[i], iter));
+                check(expectedD[i] + iter, (Integer) d.invoke(objs[i], iter));
+            }
+        }
+
+        try {
+            m.invoke(new Object(), 0);
+            throw new RuntimeException("IllegalArgumentException expected");
+        } catch (IllegalArgumentException expected) {
+        }
+
+        try {
+            m.invoke(new E(), 0);
+            throw new RuntimeException("InvocationTargetException expected");
+        } catch (InvocationTargetException expected) {
+            if (!(expected.getCause() instanceof IllegalStateException)) {
+                throw new RuntimeException("unexpected cause", expected.getCause());
+            }
+        }
+    }
+}
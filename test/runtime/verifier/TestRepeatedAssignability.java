@@ -0,0 +1,62 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test TestRepeatedAssignability
+ * @summary Repeated assignability checks against the same classes verify correctly
+ * @run main/othervm -Xverify:all TestRepeatedAssignability
+ */
+
+import java.util.ArrayList;
+import java.util.Collection;
+import java.util.List;
+
+public class TestRepeatedAssignability {
+    static class Base { }
+    static class Derived extends Base { }
+
+    static Base pick(boolean b, Derived d, Base other) {
+        Base r = b ? d : other;
+        Base s = b ? other : d;
+        return r == s ? d : other;
+    }
+
+    static Collection<Object> widen(ArrayList<Object> a, List<Object> l) {
+        Collection<Object> c = a;
+        c = l;
+        c = a;
+        return c;
+    }
+
+    public static void main(String[] args) {
+        Derived d = new Derived();
+        if (pick(true, d, new Base()) == null) {
+            throw new RuntimeException("unexpected null");
+        }
+        ArrayList<Object> a = new ArrayList<>();
+        if (widen(a, a) != a) {
+            throw new RuntimeException("unexpected result");
+        }
+    }
+}
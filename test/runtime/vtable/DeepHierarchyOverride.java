@@ -0,0 +1,78 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test
+ * @summary Virtual dispatch through a deep hierarchy with overloads and partial overrides
+ * @run main/othervm -Xint DeepHierarchyOverride
+ * @run main/othervm -Xcomp DeepHierarchyOverride
+ */
+
+public class DeepHierarchyOverride {
+    static class A {
+        int m()         { return 1; }
+        int m(int x)    { return 10; }
+        int m(long x)   { return 100; }
+        int n()         { return 1000; }
+        int o()         { return 10000; }
+    }
+    static class B extends A {
+        int m(int x)    { return 20; }
+    }
+    static class C extends B {
+        int m()         { return 3; }
+        int n()         { return 3000; }
+    }
+    static class D extends C {
+        int m(long x)   { return 400; }
+        int p()         { return 4; }
+    }
+    static class E extends D {
+        int o()         { return 50000; }
+        int p()         { return 5; }
+    }
+
+    static void check(int actual, int expected) {
+        if (actual != expected) {
+            throw new RuntimeException("expected " + expected + " but got " + actual);
+        }
+    }
+
+    public static void main(String[] args) {
+        A a = new E();
+        check(a.m(), 3);
+        check(a.m(1), 20);
+        check(a.m(1L), 400);
+        check(a.n(), 3000);
+        check(a.o(), 50000);
+        check(((D) a).p(), 5);
+
+        A b = new B();
+        check(b.m(), 1);
+        check(b.m(1), 20);
+        check(b.m(1L), 100);
+        check(b.n(), 1000);
+        check(b.o(), 10000);
+    }
+}
@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test
+ * @summary Test of diagnostic command Compiler.codecache
+ * @library /testlibrary
+ * @compile DcmdUtil.java
+ * @run main CodeCacheDCmdTest
+ */
+
+public class CodeCacheDCmdTest {
+    static void check(String output, String expected) throws Exception {
+        if (!output.contains(expected)) {
+            throw new Exception("Missing '" + expected + "' in:\n" + output);
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        String output = DcmdUtil.executeDcmd("Compiler.codecache", "-top=3");
+        check(output, "Free space:");
+        check(output, "NMethods in use by tier:");
+        check(output, "Largest 3 blobs:");
+
+        output = DcmdUtil.executeDcmd("Compiler.codecache", "-top=-1");
+        check(output, "Top must not be negative");
+    }
+}
@@ -0,0 +1,119 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+import java.io.DataInputStream;
+import java.io.EOFException;
+import java.io.File;
+import java.io.FileInputStream;
+import java.io.BufferedInputStream;
+import java.util.ArrayList;
+import java.util.List;
+
+/*
+ * @test
+ * @summary Test that GC.heap_dump -parallel writes a well formed segmented dump
+ * @library /testlibrary
+ * @compile DcmdUtil.java
+ * @run main/othervm -XX:+UseG1GC -XX:ParallelGCThreads=4 HeapDumpParallelTest
+ */
+
+public class HeapDumpParallelTest {
+    private static final int HPROF_HEAP_DUMP_SEGMENT = 0x1C;
+    private static final int HPROF_HEAP_DUMP_END     = 0x2C;
+
+    static List<Object> keep = new ArrayList<>();
+
+    // Walks the top level records and returns the number of heap dump segments.
+    private static int checkDump(File file) throws Exception {
+        try (DataInputStream in = new DataInputStream(
+                 new BufferedInputStream(new FileInputStream(file)))) {
+            StringBuilder header = new StringBuilder();
+            int c;
+            while ((c = in.read()) != 0) {
+                header.append((char)c);
+            }
+            if (!header.toString().equals("JAVA PROFILE 1.0.2")) {
+                throw new Exception("Unexpected header " + header);
+            }
+            in.readInt();   // identifier size
+            in.readLong();  // time stamp
+            int segments = 0;
+            boolean end = false;
+            while (true) {
+                int tag;
+                try {
+                    tag = in.readUnsignedByte();
+                } catch (EOFException e) {
+                    break;
+                }
+                if (end) {
+                    throw new Exception("Record after HPROF_HEAP_DUMP_END");
+                }
+                in.readInt();   // time stamp
+                long length = in.readInt() & 0xFFFFFFFFL;
+                long skipped = 0;
+                while (skipped < length) {
+                    long n = in.skip(length - skipped);
+                    if (n <= 0) {
+                        throw new Exception("Truncated record with tag " + tag);
+                    }
+                    skipped += n;
+                }
+                if (tag == HPROF_HEAP_DUMP_SEGMENT) {
+                    segments++;
+                } else if (tag == HPROF_HEAP_DUMP_END) {
+                    end = true;
+                }
+            }
+            if (!end) {
+                throw new Exception("Missing HPROF_HEAP_DUMP_END");
+            }
+            return segments;
+        }
+    }
+
+    private static void dump(String parallel) throws Exception {
+        File file = new File("parallel" + parallel.replace('=', '_') + ".hprof");
+        file.delete();
+        String result = DcmdUtil.executeDcmd("GC.heap_dump", parallel, file.getAbsolutePath());
+        if (!result.contains("Heap dump file created")) {
+            throw new Exception("GC.heap_dump " + parallel + " failed: " + result);
+        }
+        int segments = checkDump(file);
+        // the class dumps, at least one segment of objects and the roots
+        if (segments < 3) {
+            throw new Exception("Expected several heap dump segments, found " + segments);
+        }
+        file.delete();
+    }
+
+    public static void main(String[] args) throws Exception {
+        for (int i = 0; i < 200000; i++) {
+            keep.add(new int[i % 64]);
+            keep.add("HeapDumpParallelTest" + i);
+        }
+        dump("-parallel=4");
+        dump("-parallel=0");
+    }
+}
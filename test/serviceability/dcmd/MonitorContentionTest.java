@@ -0,0 +1,79 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test
+ * @summary Test that Monitor.contention reports the waiter and owner of a contended monitor
+ * @library /testlibrary
+ * @compile DcmdUtil.java
+ * @run main/othervm -Xint -XX:MonitorContentionSampleInterval=1 MonitorContentionTest
+ */
+
+public class MonitorContentionTest {
+    static class Lock { }
+
+    static final Lock lock = new Lock();
+
+    static void blockedEnter() {
+        synchronized (lock) {
+        }
+    }
+
+    static void holdAndRelease(Thread waiter) throws Exception {
+        synchronized (lock) {
+            waiter.start();
+            while (waiter.getState() != Thread.State.BLOCKED) {
+                Thread.sleep(10);
+            }
+            Thread.sleep(100);
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        Thread waiter = new Thread() {
+            public void run() {
+                blockedEnter();
+            }
+        };
+        holdAndRelease(waiter);
+        waiter.join();
+
+        String result = DcmdUtil.executeDcmd("Monitor.contention", "-limit=0");
+        System.out.println(result);
+        if (!result.matches("(?s).*enters blocked [0-9.]+ ms \\(max [0-9.]+ ms\\) on MonitorContentionTest\\$Lock\\s+" +
+                            "at MonitorContentionTest\\.blockedEnter.*")) {
+            throw new Exception("No blocked waiter in MonitorContentionTest.blockedEnter");
+        }
+        if (!result.matches("(?s).*releases of MonitorContentionTest\\$Lock\\s+" +
+                            "at MonitorContentionTest\\.holdAndRelease.*")) {
+            throw new Exception("No release in MonitorContentionTest.holdAndRelease");
+        }
+
+        DcmdUtil.executeDcmd("Monitor.contention", "-reset=true");
+        result = DcmdUtil.executeDcmd("Monitor.contention");
+        if (!result.contains(" 0 sampled enters")) {
+            throw new Exception("Samples not reset: " + result);
+        }
+    }
+}
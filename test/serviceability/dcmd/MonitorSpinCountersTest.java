@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+import java.util.regex.Matcher;
+import java.util.regex.Pattern;
+
+/*
+ * @test
+ * @summary Monitor spin counters are updated and reported by PerfCounter.print
+ * @library /testlibrary
+ * @compile DcmdUtil.java
+ * @run main/othervm -XX:-UseBiasedLocking MonitorSpinCountersTest
+ */
+
+public class MonitorSpinCountersTest {
+    static final Object lock = new Object();
+    static long counter;
+
+    static long value(String output, String name) throws Exception {
+        Matcher m = Pattern.compile(Pattern.quote(name) + "=(\\d+)").matcher(output);
+        if (!m.find()) {
+            throw new Exception("Missing counter " + name);
+        }
+        return Long.parseLong(m.group(1));
+    }
+
+    public static void main(String[] args) throws Exception {
+        Thread[] threads = new Thread[4];
+        for (int i = 0; i < threads.length; i++) {
+            threads[i] = new Thread() {
+                public void run() {
+                    for (int j = 0; j < 1000000; j++) {
+                        synchronized (lock) {
+                            counter++;
+                        }
+                    }
+                }
+            };
+            threads[i].start();
+        }
+        for (Thread t : threads) {
+            t.join();
+        }
+        synchronized (lock) {
+            lock.notify();
+        }
+
+        String result = DcmdUtil.executeDcmd("PerfCounter.print");
+        long spins = value(result, "sun.rt._sync_SuccessfulSpins") +
+                     value(result, "sun.rt._sync_FailedSpins");
+        long contended = value(result, "sun.rt._sync_ContendedLockAttempts");
+        if (Runtime.getRuntime().availableProcessors() > 1 && contended > 0 && spins == 0) {
+            throw new Exception("Contended monitors but no spins recorded");
+        }
+        if (value(result, "sun.rt._sync_EmptyNotifications") == 0) {
+            throw new Exception("Empty notification not recorded");
+        }
+    }
+}
@@ -0,0 +1,49 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test
+ * @summary Test of VM.mutex_statistics diagnostic command via MBean
+ * @library /testlibrary
+ * @compile DcmdUtil.java
+ * @run main/othervm -XX:+UnlockDiagnosticVMOptions -XX:+MutexContentionStatistics MutexStatisticsDCmdTest
+ */
+
+public class MutexStatisticsDCmdTest {
+    public static void main(String[] args) throws Exception {
+        // Starting and stopping threads takes Threads_lock
+        for (int i = 0; i < 20; i++) {
+            Thread t = new Thread();
+            t.start();
+            t.join();
+        }
+        String result = DcmdUtil.executeDcmd("VM.mutex_statistics");
+        if (!result.contains("Contended")) {
+            throw new Exception("Missing header in VM.mutex_statistics output");
+        }
+        if (!result.contains("Threads_lock")) {
+            throw new Exception("Threads_lock missing from VM.mutex_statistics output");
+        }
+    }
+}
@@ -0,0 +1,82 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test
+ * @summary Test that -XX:+WritePerfMap and Compiler.perfmap write the
+ *          symbols of stubs and compiled methods to /tmp/perf-<pid>.map
+ * @library /testlibrary
+ * @compile DcmdUtil.java
+ * @run main/othervm -Xbatch -XX:+WritePerfMap PerfMapTest
+ */
+
+import java.io.File;
+import java.lang.management.ManagementFactory;
+import java.nio.file.Files;
+import java.util.List;
+
+public class PerfMapTest {
+    static int sink;
+
+    static int hot(int x) {
+        return x * 31 + 7;
+    }
+
+    static void check(File map, String symbol) throws Exception {
+        List<String> lines = Files.readAllLines(map.toPath());
+        for (String line : lines) {
+            if (!line.matches("[0-9a-f]+ [0-9a-f]+ .+")) {
+                throw new Exception("Malformed line: " + line);
+            }
+        }
+        for (String line : lines) {
+            if (line.contains(symbol)) {
+                return;
+            }
+        }
+        throw new Exception("No " + symbol + " in " + map);
+    }
+
+    public static void main(String[] args) throws Exception {
+        String name = ManagementFactory.getRuntimeMXBean().getName();
+        String pid = name.substring(0, name.indexOf('@'));
+        File map = new File("/tmp/perf-" + pid + ".map");
+
+        for (int i = 0; i < 100000; i++) {
+            sink += hot(i);
+        }
+
+        check(map, "Interpreter");
+        check(map, "call_stub");
+        check(map, "PerfMapTest.hot(I)I [tier");
+
+        String result = DcmdUtil.executeDcmd("Compiler.perfmap");
+        if (!result.contains("Perf map written to")) {
+            throw new Exception("Compiler.perfmap failed: " + result);
+        }
+        check(map, "Interpreter");
+        check(map, "PerfMapTest.hot(I)I [tier");
+        map.delete();
+    }
+}
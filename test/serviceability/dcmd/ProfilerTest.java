@@ -0,0 +1,80 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test
+ * @summary Test that Profiler.start/stop/dump report the stack of a busy thread
+ * @library /testlibrary
+ * @compile DcmdUtil.java
+ * @run main/othervm ProfilerTest
+ */
+
+public class ProfilerTest {
+    static volatile long sink;
+
+    static void spin(long millis) {
+        long end = System.currentTimeMillis() + millis;
+        long x = 0;
+        while (System.currentTimeMillis() < end) {
+            for (int i = 0; i < 100000; i++) {
+                x = x * 31 + i;
+            }
+        }
+        sink = x;
+    }
+
+    public static void main(String[] args) throws Exception {
+        String result = DcmdUtil.executeDcmd("Profiler.start", "-interval=10");
+        if (!result.contains("Profiler started")) {
+            throw new Exception("Profiler.start failed: " + result);
+        }
+        result = DcmdUtil.executeDcmd("Profiler.start");
+        if (!result.contains("already running")) {
+            throw new Exception("Second Profiler.start should fail: " + result);
+        }
+
+        spin(2000);
+
+        result = DcmdUtil.executeDcmd("Profiler.stop");
+        if (!result.contains("Profiler stopped")) {
+            throw new Exception("Profiler.stop failed: " + result);
+        }
+        result = DcmdUtil.executeDcmd("Profiler.dump");
+        System.out.println(result);
+        boolean found = false;
+        for (String line : result.split("\n")) {
+            if (line.matches("(.*;)?ProfilerTest\\.main;ProfilerTest\\.spin(;.*)? [0-9]+")) {
+                found = true;
+            }
+        }
+        if (!found) {
+            throw new Exception("No sample of ProfilerTest.spin");
+        }
+
+        result = DcmdUtil.executeDcmd("Profiler.start", "-interval=15");
+        if (!result.contains("multiple of")) {
+            throw new Exception("Interval not rejected: " + result);
+        }
+    }
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+import java.util.ArrayList;
+import java.util.List;
+import java.util.regex.Matcher;
+import java.util.regex.Pattern;
+
+/*
+ * @test
+ * @summary Test that the string table grows and is reported by VM.stringtable
+ * @library /testlibrary
+ * @compile DcmdUtil.java
+ * @run main/othervm -XX:StringTableSize=1009 -XX:+ResizeSymbolAndStringTables StringtableDCmdTest
+ */
+
+public class StringtableDCmdTest {
+    private static final int INITIAL_SIZE = 1009;
+    private static final int STRINGS = 100000;
+
+    private static int buckets(String output) throws Exception {
+        Matcher m = Pattern.compile("Number of buckets\\s*:\\s*(\\d+)").matcher(output);
+        if (!m.find()) {
+            throw new Exception("Missing bucket count in output");
+        }
+        return Integer.parseInt(m.group(1));
+    }
+
+    public static void main(String[] args) throws Exception {
+        List<String> keep = new ArrayList<>();
+        for (int i = 0; i < STRINGS; i++) {
+            keep.add(("StringtableDCmdTest" + i).intern());
+        }
+        // Resizing happens during safepoint cleanup.
+        System.gc();
+
+        String result = DcmdUtil.executeDcmd("VM.stringtable");
+        if (!result.contains("StringTable statistics")) {
+            throw new Exception("VM.stringtable output did not contain 'StringTable statistics'");
+        }
+        if (buckets(result) <= INITIAL_SIZE) {
+            throw new Exception("StringTable was not resized: " + buckets(result) + " buckets");
+        }
+
+        result = DcmdUtil.executeDcmd("VM.symboltable");
+        if (!result.contains("SymbolTable statistics")) {
+            throw new Exception("VM.symboltable output did not contain 'SymbolTable statistics'");
+        }
+        System.out.println("Kept " + keep.size() + " strings");
+    }
+}
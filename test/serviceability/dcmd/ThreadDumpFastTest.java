@@ -0,0 +1,87 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test
+ * @summary Test that Thread.print -fast prints the stacks of running and sleeping threads
+ * @library /testlibrary
+ * @compile DcmdUtil.java
+ * @run main/othervm ThreadDumpFastTest
+ */
+
+import java.util.concurrent.CountDownLatch;
+
+public class ThreadDumpFastTest {
+    static volatile long sink;
+
+    static void sleeper(CountDownLatch started) throws InterruptedException {
+        started.countDown();
+        Thread.sleep(60 * 1000);
+    }
+
+    static void spinner(CountDownLatch started) {
+        started.countDown();
+        long x = 0;
+        while (true) {
+            x = x * 31 + 1;
+            sink = x;
+        }
+    }
+
+    public static void main(String[] args) throws Exception {
+        final CountDownLatch started = new CountDownLatch(2);
+        Thread sleeping = new Thread("Sleeping Thread") {
+            public void run() {
+                try {
+                    sleeper(started);
+                } catch (InterruptedException e) {
+                }
+            }
+        };
+        Thread spinning = new Thread("Spinning Thread") {
+            public void run() {
+                spinner(started);
+            }
+        };
+        sleeping.setDaemon(true);
+        spinning.setDaemon(true);
+        sleeping.start();
+        spinning.start();
+        started.await();
+        Thread.sleep(100);
+
+        String result = DcmdUtil.executeDcmd("Thread.print", "-fast");
+        System.out.println(result);
+        if (!result.contains("Thread dump without safepoint")) {
+            throw new Exception("No fast thread dump: " + result);
+        }
+        if (!result.matches("(?s).*\"Sleeping Thread\".*?at java\\.lang\\.Thread\\.sleep\\(Native Method\\)\\s+" +
+                            "at ThreadDumpFastTest\\.sleeper\\(ThreadDumpFastTest\\.java:[0-9]+\\).*")) {
+            throw new Exception("No stack of the sleeping thread");
+        }
+        if (!result.matches("(?s).*\"Spinning Thread\".*?at ThreadDumpFastTest\\.spinner\\(ThreadDumpFastTest\\.java:[0-9]+\\).*")) {
+            throw new Exception("No stack of the spinning thread");
+        }
+    }
+}
@@ -0,0 +1,142 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+/*
+ * @test
+ * @summary Test that Trace.start/stop record GC events into a binary file
+ *          and that Trace.configure filters them
+ * @library /testlibrary
+ * @compile DcmdUtil.java
+ * @run main/othervm -XX:+UseSerialGC TraceRecorderTest
+ */
+
+import java.io.DataInputStream;
+import java.io.File;
+import java.io.FileInputStream;
+
+public class TraceRecorderTest {
+    static int countEvents(File file, int wanted) throws Exception {
+        try (DataInputStream in = new DataInputStream(new FileInputStream(file))) {
+            byte[] magic = new byte[4];
+            in.readFully(magic);
+            if (!new String(magic, "US-ASCII").equals("HSTR")) {
+                throw new Exception("Bad magic");
+            }
+            in.readShort();     // major
+            in.readShort();     // minor
+            in.readLong();      // ticks per second
+            in.readLong();      // start ticks
+            in.readLong();      // start millis
+            int types = in.readInt();
+            for (int i = 0; i < types; i++) {
+                in.readInt();
+                in.readUTF();
+            }
+            int count = 0;
+            while (in.available() > 0) {
+                int chunkSize = in.readInt();
+                int events = in.readInt();
+                in.readLong();  // thread id
+                int left = chunkSize - 16;
+                for (int i = 0; i < events; i++) {
+                    int size = in.readInt();
+                    int id = in.readInt();
+                    if (id == wanted) {
+                        count++;
+                    }
+                    in.readFully(new byte[size - 8]);
+                    left -= size;
+                }
+                if (left != 0) {
+                    throw new Exception("Chunk size does not match its events");
+                }
+            }
+            return count;
+        }
+    }
+
+    static int findEventId(File file, String name) throws Exception {
+        try (DataInputStream in = new DataInputStream(new FileInputStream(file))) {
+            in.readFully(new byte[4 + 2 + 2 + 8 + 8 + 8]);
+            int types = in.readInt();
+            for (int i = 0; i < types; i++) {
+                int id = in.readInt();
+                if (in.readUTF().equals(name)) {
+                    return id;
+                }
+            }
+        }
+        throw new Exception("No event type " + name);
+    }
+
+    static File record(String name) throws Exception {
+        File file = new File(name);
+        String result = DcmdUtil.executeDcmd("Trace.start", file.getAbsolutePath());
+        if (!result.contains("Trace recording started")) {
+            throw new Exception("Trace.start failed: " + result);
+        }
+        result = DcmdUtil.executeDcmd("Trace.start", file.getAbsolutePath());
+        if (!result.contains("Already recording")) {
+            throw new Exception("Second Trace.start should fail: " + result);
+        }
+        for (int i = 0; i < 5; i++) {
+            System.gc();
+        }
+        result = DcmdUtil.executeDcmd("Trace.stop");
+        System.out.println(result);
+        if (!result.contains("Trace recording stopped")) {
+            throw new Exception("Trace.stop failed: " + result);
+        }
+        return file;
+    }
+
+    public static void main(String[] args) throws Exception {
+        String result = DcmdUtil.executeDcmd("Trace.configure");
+        if (!result.contains("GCGarbageCollection")) {
+            throw new Exception("GCGarbageCollection not listed: " + result);
+        }
+
+        File file = record("recording1.hstr");
+        int id = findEventId(file, "GCGarbageCollection");
+        int count = countEvents(file, id);
+        if (count < 5) {
+            throw new Exception("Expected at least 5 GCGarbageCollection events, got " + count);
+        }
+
+        result = DcmdUtil.executeDcmd("Trace.configure", "GCGarbageCollection", "-enabled=false");
+        if (!result.contains("Configured")) {
+            throw new Exception("Trace.configure failed: " + result);
+        }
+        file = record("recording2.hstr");
+        count = countEvents(file, id);
+        if (count != 0) {
+            throw new Exception("Disabled event recorded " + count + " times");
+        }
+
+        result = DcmdUtil.executeDcmd("Trace.configure", "NoSuchEvent");
+        if (!result.contains("Unknown event")) {
+            throw new Exception("Unknown event accepted: " + result);
+        }
+    }
+}
@@ -0,0 +1,70 @@
+/*
+ * Copyright (c) 2015, Oracle and/or its affiliates. All rights reserved.
+ * DO NOT ALTER OR REMOVE COPYRIGHT NOTICES OR THIS FILE HEADER.
+ *
+ * This code is free software; you can redistribute it and/or modify it
+ * under the terms of the GNU General Public License version 2 only, as
+ * published by the Free Software Foundation.
+ *
+ * This code is distributed in the hope that it will be useful, but WITHOUT
+ * ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+ * FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License
+ * version 2 for more details (a copy is included in the LICENSE file that
+ * accompanied this code).
+ *
+ * You should have received a copy of the GNU General Public License version
+ * 2 along with this work; if not, write to the Free Software Foundation,
+ * Inc., 51 Franklin St, Fifth Floor, Boston, MA 02110-1301 USA.
+ *
+ * Please contact Oracle, 500 Oracle Parkway, Redwood Shores, CA 94065 USA
+ * or visit www.oracle.com if you need additional information or have any
+ * questions.
+ *
+ */
+
+import java.util.ArrayList;
+import java.util.List;
+import java.util.regex.Matcher;
+import java.util.regex.Pattern;
+
+/*
+ * @test
+ * @summary Test that GC.class_histogram -parallel counts the same objects as a serial walk
+ * @library /testlibrary
+ * @compile ../DcmdUtil.java
+ * @run main/othervm -XX:+UseG1GC -XX:ParallelGCThreads=4 ClassHistogramParallelTest
+ */
+
+public class ClassHistogramParallelTest {
+    private static final int INSTANCES = 50000;
+
+    static class Counted {
+        long value;
+        Counted(long value) { this.value = value; }
+    }
+
+    static List<Counted> keep = new ArrayList<>();
+
+    private static long instances(String parallel) throws Exception {
+        String result = DcmdUtil.executeDcmd("GC.class_histogram", parallel);
+        Matcher m = Pattern.compile("\\s+(\\d+)\\s+\\d+\\s+ClassHistogramParallelTest\\$Counted\\s")
+                           .matcher(result);
+        if (!m.find()) {
+            throw new Exception("GC.class_histogram " + parallel + " did not report Counted");
+        }
+        return Long.parseLong(m.group(1));
+    }
+
+    public static void main(String[] args) throws Exception {
+        for (int i = 0; i < INSTANCES; i++) {
+            keep.add(new Counted(i));
+        }
+        long serial = instances("-parallel=1");
+        long parallel = instances("-parallel=4");
+        long all = instances("-parallel=0");
+        if (serial != INSTANCES || parallel != INSTANCES || all != INSTANCES) {
+            throw new Exception("Expected " + INSTANCES + " instances, got " + serial +
+                                " (serial), " + parallel + " (-parallel=4), " + all + " (-parallel=0)");
+        }
+    }
+}
@@ -91,6 +91,11 @@ public class WhiteBox {
   public native boolean isMonitorInflated(Object obj);
   public native void forceSafepoint();
 
+  // VM-internal microbenchmarks, returning the elapsed nanoseconds
+  public native long benchmarkTaskQueue(int iterations);
+  public native long benchmarkSymbolLookup(String name, int iterations);
+  public native long benchmarkMonitorEnterExit(Object obj, int iterations);
+
   // Resource/Class Lookup Cache
   public native boolean classKnownToNotExist(ClassLoader loader, String name);
   public native URL[] getLookupCacheURLs(ClassLoader loader);
@@ -106,6 +111,7 @@ public class WhiteBox {
   public native long    g1NumMaxRegions();
   public native long    g1NumFreeRegions();
   public native int     g1RegionSize();
+  public native long    g1HumongousWasteBytes();
   public native MemoryUsage g1AuxiliaryMemoryUsage();
   public native Object[]    parseCommandLine(String commandline, DiagnosticCommand[] args);
 
@@ -243,4 +249,9 @@ public class WhiteBox {
   public native boolean isContainerized();
   public native void printOsInfo();
 
+  // Partial stack walk, frame 0 being the caller of getStackFrames
+  public static final int STACKWALK_SKIP_REFLECTION = 0x1;
+  public native int getStackFrames(int skip, int flags, Class<?>[] classes,
+                                   StackTraceElement[] elements, int[] bcis);
+
 }